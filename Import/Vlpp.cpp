@@ -4192,133 +4192,288 @@ ThreadPoolLite
 
 	namespace threading_internal
 	{
-		struct ThreadPoolTask
+		struct ThreadPoolData;
+
+		struct ThreadPoolWorker
 		{
-			Func<void()>			task;
-			Ptr<ThreadPoolTask>		next;
+			SpinLock				lock;
+			Array<Func<void()>>		tasks;
+			vint					taskBegin = 0;
+			vint					taskCount = 0;
+			ThreadPoolData*			data = nullptr;
+			vint					index = -1;
+			Thread*					thread = nullptr;
+
+			void Push(const Func<void()>& proc)
+			{
+				// tasks is a ring buffer, slots are reused so that queuing a task does not allocate a node
+				if (taskCount == tasks.Count())
+				{
+					vint oldCapacity = tasks.Count();
+					tasks.Resize(oldCapacity == 0 ? 16 : oldCapacity * 2);
+					for (vint i = 0; i < taskBegin; i++)
+					{
+						tasks[oldCapacity + i] = tasks[i];
+						tasks[i] = Func<void()>();
+					}
+				}
+				tasks[(taskBegin + taskCount) % tasks.Count()] = proc;
+				taskCount++;
+			}
+
+			bool PopBack(Func<void()>& proc)
+			{
+				if (taskCount == 0) return false;
+				auto& slot = tasks[(taskBegin + taskCount - 1) % tasks.Count()];
+				proc = slot;
+				slot = Func<void()>();
+				taskCount--;
+				return true;
+			}
+
+			bool PopFront(Func<void()>& proc)
+			{
+				if (taskCount == 0) return false;
+				auto& slot = tasks[taskBegin];
+				proc = slot;
+				slot = Func<void()>();
+				taskBegin = (taskBegin + 1) % tasks.Count();
+				taskCount--;
+				return true;
+			}
 		};
 
 		struct ThreadPoolData
 		{
 			Semaphore				semaphore;
-			EventObject				taskFinishEvent;
-			Ptr<ThreadPoolTask>		taskBegin;
-			Ptr<ThreadPoolTask>*	taskEnd = nullptr;
+			Array<Ptr<ThreadPoolWorker>>	workers;
+			volatile vint			sleepingWorkers = 0;
+			volatile vint			nextWorker = 0;
 			volatile bool			stopping = false;
-			List<Thread*>			taskThreads;
 		};
 
 		SpinLock					threadPoolLock;
-		ThreadPoolData*				threadPoolData = nullptr;
+		ThreadPoolData* volatile	threadPoolData = nullptr;
+		// ThreadVariable is not used here, because ClearStorages runs after every task and DisposeStorages runs before the process exits
+		thread_local ThreadPoolWorker*	threadPoolCurrentWorker = nullptr;
+		volatile vint				threadPoolQueuingCount = 0;
+		vint						threadPoolWorkerCount = 0;
 
-		void ThreadPoolProc(Thread* thread, void* argument)
+		bool ThreadPoolTake(ThreadPoolData* data, vint index, Func<void()>& proc)
 		{
-			while (true)
 			{
-				Ptr<ThreadPoolTask> task;
+				auto worker = data->workers[index];
+				SPIN_LOCK(worker->lock)
+				{
+					// the owner takes the latest task, whose data is more likely to be still in the cache
+					if (worker->PopBack(proc)) return true;
+				}
+			}
 
-				threadPoolData->semaphore.Wait();
-				SPIN_LOCK(threadPoolLock)
+			vint count = data->workers.Count();
+			for (vint i = 1; i < count; i++)
+			{
+				auto victim = data->workers[(index + i) % count];
+				SPIN_LOCK(victim->lock)
 				{
-					if (threadPoolData->taskBegin)
-					{
-						task = threadPoolData->taskBegin;
-						threadPoolData->taskBegin = task->next;
-					}
+					// stealing takes the oldest task, which is on the other end of the deque
+					if (victim->PopFront(proc)) return true;
+				}
+			}
+			return false;
+		}
 
-					if (!threadPoolData->taskBegin)
+		void ThreadPoolProc(Thread* thread, void* argument)
+		{
+			auto worker = (ThreadPoolWorker*)argument;
+			auto data = worker->data;
+			vint index = worker->index;
+			threadPoolCurrentWorker = worker;
+
+			while (true)
+			{
+				Func<void()> task;
+				if (!ThreadPoolTake(data, index, task))
+				{
+					// announce sleeping before checking again, so that a task queued in between always wakes up a worker
+					INCRC(&data->sleepingWorkers);
+					bool found = ThreadPoolTake(data, index, task);
+					if (!found)
 					{
-						threadPoolData->taskEnd = &threadPoolData->taskBegin;
-						threadPoolData->taskFinishEvent.Signal();
+						if (data->stopping)
+						{
+							DECRC(&data->sleepingWorkers);
+							return;
+						}
+						data->semaphore.Wait();
 					}
+					DECRC(&data->sleepingWorkers);
+					if (!found) continue;
 				}
 
-				if (task)
+				ThreadLocalStorage::FixStorages();
+				try
 				{
-					ThreadLocalStorage::FixStorages();
-					try
-					{
-						task->task();
-						ThreadLocalStorage::ClearStorages();
-					}
-					catch (...)
-					{
-						ThreadLocalStorage::ClearStorages();
-					}
+					task();
+					ThreadLocalStorage::ClearStorages();
 				}
-				else if (threadPoolData->stopping)
+				catch (...)
 				{
-					return;
+					ThreadLocalStorage::ClearStorages();
 				}
 			}
 		}
 
+		ThreadPoolData* ThreadPoolCreate()
+		{
+			vint workerCount = threadPoolWorkerCount > 0 ? threadPoolWorkerCount : Thread::GetCPUCount() * 4;
+			auto data = new ThreadPoolData;
+			data->semaphore.Create(0, 65536);
+			data->workers.Resize(workerCount);
+			for (vint i = 0; i < workerCount; i++)
+			{
+				auto worker = MakePtr<ThreadPoolWorker>();
+				worker->data = data;
+				worker->index = i;
+				data->workers[i] = worker;
+			}
+			for (vint i = 0; i < workerCount; i++)
+			{
+				auto worker = data->workers[i];
+				worker->thread = Thread::CreateAndStart(&ThreadPoolProc, worker.Obj(), false);
+			}
+			return data;
+		}
+
 		bool ThreadPoolQueue(const Func<void()>& proc)
 		{
-			SPIN_LOCK(threadPoolLock)
+			INCRC(&threadPoolQueuingCount);
+			auto data = threadPoolData;
+			if (!data)
 			{
-				if (!threadPoolData)
+				SPIN_LOCK(threadPoolLock)
 				{
-					threadPoolData = new ThreadPoolData;
-					threadPoolData->semaphore.Create(0, 65536);
-					threadPoolData->taskFinishEvent.CreateManualUnsignal(false);
-					threadPoolData->taskEnd = &threadPoolData->taskBegin;
-
-					for (vint i = 0; i < Thread::GetCPUCount() * 4; i++)
+					if (!threadPoolData)
 					{
-						threadPoolData->taskThreads.Add(Thread::CreateAndStart(&ThreadPoolProc, nullptr, false));
+						threadPoolData = ThreadPoolCreate();
 					}
+					data = threadPoolData;
+				}
+			}
+
+			bool result = false;
+			if (!data->stopping)
+			{
+				// a task queued by a worker stays in its own deque, other threads distribute tasks in turn
+				vint count = data->workers.Count();
+				vint index = -1;
+				auto currentWorker = threadPoolCurrentWorker;
+				if (currentWorker && currentWorker->data == data)
+				{
+					index = currentWorker->index;
+				}
+				else
+				{
+					index = (vint)((vuint)INCRC(&data->nextWorker) % (vuint)count);
 				}
 
-				if (threadPoolData)
+				auto worker = data->workers[index];
+				SPIN_LOCK(worker->lock)
 				{
-					if (threadPoolData->stopping)
+					worker->Push(proc);
+					// Stop could begin after stopping is checked above, the task is taken back so that it is not accepted and then dropped
+					result = !data->stopping;
+					if (!result)
 					{
-						return false;
+						Func<void()> task;
+						worker->PopBack(task);
+					}
+				}
+				if (result)
+				{
+					__sync_synchronize();
+					if (data->sleepingWorkers > 0)
+					{
+						data->semaphore.Release();
 					}
-
-					auto task = MakePtr<ThreadPoolTask>();
-					task->task = proc;
-					*threadPoolData->taskEnd = task;
-					threadPoolData->taskEnd = &task->next;
-					threadPoolData->semaphore.Release();
-					threadPoolData->taskFinishEvent.Unsignal();
 				}
 			}
+			DECRC(&threadPoolQueuingCount);
+			return result;
+		}
+
+		bool ThreadPoolSetWorkerCount(vint count)
+		{
+			if (count < 0) return false;
+			SPIN_LOCK(threadPoolLock)
+			{
+				if (threadPoolData) return false;
+				threadPoolWorkerCount = count;
+			}
 			return true;
 		}
 
 		bool ThreadPoolStop(bool discardPendingTasks)
 		{
+			ThreadPoolData* data = nullptr;
 			SPIN_LOCK(threadPoolLock)
 			{
-				if (!threadPoolData) return false;
-				if (threadPoolData->stopping) return false;
+				data = threadPoolData;
+				if (!data) return false;
+				if (data->stopping) return false;
+				data->stopping = true;
+			}
 
-				threadPoolData->stopping = true;
-				if (discardPendingTasks)
+			if (discardPendingTasks)
+			{
+				for (vint i = 0; i < data->workers.Count(); i++)
 				{
-					threadPoolData->taskEnd = &threadPoolData->taskBegin;
-					threadPoolData->taskBegin = nullptr;
+					auto worker = data->workers[i];
+					SPIN_LOCK(worker->lock)
+					{
+						Func<void()> task;
+						while (worker->PopBack(task));
+					}
 				}
-
-				threadPoolData->semaphore.Release(threadPoolData->taskThreads.Count());
 			}
 
-			threadPoolData->taskFinishEvent.Wait();
-			for (vint i = 0; i < threadPoolData->taskThreads.Count(); i++)
+			data->semaphore.Release(data->workers.Count());
+			for (vint i = 0; i < data->workers.Count(); i++)
 			{
-				auto thread = threadPoolData->taskThreads[i];
+				auto thread = data->workers[i]->thread;
 				thread->Wait();
 				delete thread;
 			}
-			threadPoolData->taskThreads.Clear();
 
 			SPIN_LOCK(threadPoolLock)
 			{
-				delete threadPoolData;
 				threadPoolData = nullptr;
 			}
+			while (threadPoolQueuingCount > 0)
+			{
+				Thread::Sleep(0);
+			}
+
+			// workers could exit before seeing a task that is accepted right before stopping is set, these tasks are executed here
+			for (vint i = 0; i < data->workers.Count(); i++)
+			{
+				auto worker = data->workers[i];
+				Func<void()> task;
+				while (worker->PopFront(task))
+				{
+					if (!discardPendingTasks)
+					{
+						try
+						{
+							task();
+						}
+						catch (...)
+						{
+						}
+					}
+				}
+			}
+			delete data;
 			return true;
 		}
 	}
@@ -4341,6 +4496,11 @@ ThreadPoolLite
 		return ThreadPoolQueue(proc);
 	}
 
+	bool ThreadPoolLite::SetWorkerCount(vint count)
+	{
+		return ThreadPoolSetWorkerCount(count);
+	}
+
 	bool ThreadPoolLite::Stop(bool discardPendingTasks)
 	{
 		return ThreadPoolStop(discardPendingTasks);
@@ -15811,10 +15971,26 @@ description::Value
 
 		namespace description
 		{
+			// textState of a primitive value: the text is not created, the text is being created by a thread, the text is created and will not change
+			const long PrimitiveTextNotCreated=0;
+			const long PrimitiveTextCreating=1;
+			const long PrimitiveTextCreated=2;
+
+			long LoadPrimitiveTextState(const volatile long& state)
+			{
+#if defined VCZH_MSVC
+				return _InterlockedOr((volatile long*)&state, 0);
+#elif defined VCZH_GCC
+				return __atomic_load_n(&state, __ATOMIC_ACQUIRE);
+#endif
+			}
+
 			Value::Value(DescriptableObject* value)
 				:valueType(value ? RawPtr :Null)
 				,rawPtr(nullptr)
+				,textState(PrimitiveTextNotCreated)
 				,typeDescriptor(0)
+				,primitiveType(PrimitiveType::None)
 			{
 				if (value)
 				{
@@ -15825,7 +16001,9 @@ description::Value
 			Value::Value(Ptr<DescriptableObject> value)
 				:valueType(value ? SharedPtr : Null)
 				,rawPtr(nullptr)
+				,textState(PrimitiveTextNotCreated)
 				,typeDescriptor(0)
+				,primitiveType(PrimitiveType::None)
 			{
 				if (value)
 				{
@@ -15838,8 +16016,60 @@ description::Value
 				:valueType(Text)
 				,rawPtr(0)
 				,text(value)
+				,textState(PrimitiveTextCreated)
 				,typeDescriptor(associatedTypeDescriptor)
+				,primitiveType(PrimitiveType::None)
+			{
+			}
+
+			Value::Value(PrimitiveType type, PrimitiveStorage value, ITypeDescriptor* associatedTypeDescriptor)
+				:valueType(Text)
+				,rawPtr(0)
+				,textState(PrimitiveTextNotCreated)
+				,typeDescriptor(associatedTypeDescriptor)
+				,primitiveType(type)
+				,primitive(value)
+			{
+			}
+
+			void Value::CreatePrimitiveText()const
 			{
+				// only one thread formats the text, other threads wait until it is created
+#if defined VCZH_MSVC
+				if(_InterlockedCompareExchange(&textState, PrimitiveTextCreating, PrimitiveTextNotCreated)==PrimitiveTextNotCreated)
+#elif defined VCZH_GCC
+				if(__sync_val_compare_and_swap(&textState, PrimitiveTextNotCreated, PrimitiveTextCreating)==PrimitiveTextNotCreated)
+#endif
+				{
+					switch(primitiveType)
+					{
+					case PrimitiveType::SignedInteger:
+						text=i64tow(primitive.signedInteger);
+						break;
+					case PrimitiveType::UnsignedInteger:
+						text=u64tow(primitive.unsignedInteger);
+						break;
+					case PrimitiveType::Float:
+						text=ftow(primitive.floatingPoint);
+						break;
+					case PrimitiveType::Boolean:
+						text=primitive.boolean?L"true":L"false";
+						break;
+					default:;
+					}
+#if defined VCZH_MSVC
+					_InterlockedExchange(&textState, PrimitiveTextCreated);
+#elif defined VCZH_GCC
+					__atomic_store_n(&textState, PrimitiveTextCreated, __ATOMIC_RELEASE);
+#endif
+				}
+				else
+				{
+					while(LoadPrimitiveTextState(textState)!=PrimitiveTextCreated)
+					{
+						_mm_pause();
+					}
+				}
 			}
 
 			vint Value::Compare(const Value& a, const Value& b)const
@@ -15851,7 +16081,30 @@ description::Value
 					switch(va)
 					{
 					case Text:
-						return WString::Compare(a.text, b.text);
+						if(a.primitiveType!=PrimitiveType::None && a.primitiveType==b.primitiveType)
+						{
+							// the same primitive value is always formatted to the same text
+							bool equal=false;
+							switch(a.primitiveType)
+							{
+							case PrimitiveType::SignedInteger:
+								equal=a.primitive.signedInteger==b.primitive.signedInteger;
+								break;
+							case PrimitiveType::UnsignedInteger:
+								equal=a.primitive.unsignedInteger==b.primitive.unsignedInteger;
+								break;
+							case PrimitiveType::Float:
+								// 0.0 and -0.0 are equal but formatted differently, so floating point numbers are compared by bits
+								equal=a.primitive.unsignedInteger==b.primitive.unsignedInteger;
+								break;
+							case PrimitiveType::Boolean:
+								equal=a.primitive.boolean==b.primitive.boolean;
+								break;
+							default:;
+							}
+							if(equal) return 0;
+						}
+						return WString::Compare(a.GetText(), b.GetText());
 					case RawPtr:
 					case SharedPtr:
 						return (vint)a.rawPtr-(vint)b.rawPtr;
@@ -15868,7 +16121,9 @@ description::Value
 			Value::Value()
 				:valueType(Null)
 				,rawPtr(0)
+				,textState(PrimitiveTextNotCreated)
 				,typeDescriptor(0)
+				,primitiveType(PrimitiveType::None)
 			{
 			}
 
@@ -15876,18 +16131,40 @@ description::Value
 				:valueType(value.valueType)
 				,rawPtr(value.rawPtr)
 				,sharedPtr(value.sharedPtr)
-				,text(value.text)
+				,textState(PrimitiveTextNotCreated)
 				,typeDescriptor(value.typeDescriptor)
+				,primitiveType(value.primitiveType)
+				,primitive(value.primitive)
 			{
+				// the text of a primitive value is only copied after it is created, because another thread may be creating it in GetText
+				if(LoadPrimitiveTextState(value.textState)==PrimitiveTextCreated)
+				{
+					text=value.text;
+					textState=PrimitiveTextCreated;
+				}
 			}
 
 			Value& Value::operator=(const Value& value)
 			{
-				valueType=value.valueType;
-				rawPtr=value.rawPtr;
-				sharedPtr=value.sharedPtr;
-				text=value.text;
-				typeDescriptor=value.typeDescriptor;
+				if(this!=&value)
+				{
+					valueType=value.valueType;
+					rawPtr=value.rawPtr;
+					sharedPtr=value.sharedPtr;
+					typeDescriptor=value.typeDescriptor;
+					primitiveType=value.primitiveType;
+					primitive=value.primitive;
+					if(LoadPrimitiveTextState(value.textState)==PrimitiveTextCreated)
+					{
+						text=value.text;
+						textState=PrimitiveTextCreated;
+					}
+					else
+					{
+						text=WString::Empty;
+						textState=PrimitiveTextNotCreated;
+					}
+				}
 				return *this;
 			}
 
@@ -15908,9 +16185,39 @@ description::Value
 
 			const WString& Value::GetText()const
 			{
+				// a const value could be shared by multiple threads, the text is only read after it is created
+				if(LoadPrimitiveTextState(textState)!=PrimitiveTextCreated)
+				{
+					CreatePrimitiveText();
+				}
 				return text;
 			}
 
+			Value::PrimitiveType Value::GetPrimitiveType()const
+			{
+				return primitiveType;
+			}
+
+			vint64_t Value::GetSignedInteger()const
+			{
+				return primitiveType==PrimitiveType::SignedInteger?primitive.signedInteger:0;
+			}
+
+			vuint64_t Value::GetUnsignedInteger()const
+			{
+				return primitiveType==PrimitiveType::UnsignedInteger?primitive.unsignedInteger:0;
+			}
+
+			double Value::GetFloat()const
+			{
+				return primitiveType==PrimitiveType::Float?primitive.floatingPoint:0;
+			}
+
+			bool Value::GetBoolean()const
+			{
+				return primitiveType==PrimitiveType::Boolean?primitive.boolean:false;
+			}
+
 			ITypeDescriptor* Value::GetTypeDescriptor()const
 			{
 				switch(valueType)
@@ -16014,6 +16321,34 @@ description::Value
 				return Value(value, type);
 			}
 
+			Value Value::FromSignedInteger(vint64_t value, ITypeDescriptor* type)
+			{
+				PrimitiveStorage storage;
+				storage.signedInteger=value;
+				return Value(PrimitiveType::SignedInteger, storage, type);
+			}
+
+			Value Value::FromUnsignedInteger(vuint64_t value, ITypeDescriptor* type)
+			{
+				PrimitiveStorage storage;
+				storage.unsignedInteger=value;
+				return Value(PrimitiveType::UnsignedInteger, storage, type);
+			}
+
+			Value Value::FromFloat(double value, ITypeDescriptor* type)
+			{
+				PrimitiveStorage storage;
+				storage.floatingPoint=value;
+				return Value(PrimitiveType::Float, storage, type);
+			}
+
+			Value Value::FromBoolean(bool value, ITypeDescriptor* type)
+			{
+				PrimitiveStorage storage;
+				storage.boolean=value;
+				return Value(PrimitiveType::Boolean, storage, type);
+			}
+
 			IMethodInfo* Value::SelectMethod(IMethodGroupInfo* methodGroup, collections::Array<Value>& arguments)
 			{
 				if(methodGroup->GetMethodCount()==1)
@@ -16960,6 +17295,16 @@ MethodInfoImpl
 				return true;
 			}
 
+			const WString& MethodInfoImpl::GetCppInvokeTemplate()
+			{
+				return cppInvokeTemplate;
+			}
+
+			void MethodInfoImpl::SetCppInvokeTemplate(const WString& _cppInvokeTemplate)
+			{
+				cppInvokeTemplate=_cppInvokeTemplate;
+			}
+
 /***********************************************************************
 MethodGroupInfoImpl
 ***********************************************************************/
@@ -18228,6 +18573,25 @@ TypedValueSerializerProvider
 				return true;
 			}
 
+/***********************************************************************
+TypedValuePrimitiveProvider
+***********************************************************************/
+
+			bool TypedValuePrimitiveProvider<float>::Box(const float& input, ITypeDescriptor* type, Value& output)
+			{
+				output = Value::FromFloat(input, type);
+				return true;
+			}
+
+			bool TypedValuePrimitiveProvider<float>::Unbox(const Value& input, float& output)
+			{
+				if (input.GetPrimitiveType() != Value::PrimitiveType::Float) return false;
+				double value = input.GetFloat();
+				if (value < -FLT_MAX || value > FLT_MAX) return false;
+				output = (float)value;
+				return true;
+			}
+
 /***********************************************************************
 ObjectTypeDescriptor
 ***********************************************************************/
@@ -18254,6 +18618,20 @@ BoolValueSerializer
 					candidates.Add(L"true", true);
 					candidates.Add(L"false", false);
 				}
+
+				bool Serialize(const bool& input, Value& output)override
+				{
+					return TypedValuePrimitiveProvider<bool>::Box(input, ownedTypeDescriptor, output);
+				}
+
+				bool Deserialize(const Value& input, bool& output)override
+				{
+					if (TypedValuePrimitiveProvider<bool>::Unbox(input, output))
+					{
+						return true;
+					}
+					return GeneralValueSerializer<bool>::Deserialize(input, output);
+				}
 			};
 
 /***********************************************************************
@@ -21763,7 +22141,10 @@ PureInterpretor
 ***********************************************************************/
 
 		PureInterpretor::PureInterpretor(Automaton::Ref dfa, CharRange::List& subsets)
-			:transition(0)
+			:charBlocks(0)
+			,charBlockOffsets(0)
+			,charBlockCount(0)
+			,transition(0)
 			,finalState(0)
 			,relatedFinalState(0)
 		{
@@ -21772,18 +22153,67 @@ PureInterpretor
 			startState=dfa->states.IndexOf(dfa->startState);
 
 			//填充字符映射表
-			for(vint i=0;i<SupportedCharCount;i++)
+			//字符按块映射，只保存到最后一个出现在字符集中的块为止，内容相同的块只保存一份
+			vint maxChar=0;
+			for(vint i=0;i<subsets.Count();i++)
 			{
-				charMap[i]=charSetCount-1;
+				vint end=(vint)(vuint)subsets[i].end;
+				if(end>=SupportedCharCount) end=SupportedCharCount-1;
+				if(maxChar<end) maxChar=end;
 			}
-			for(vint i=0;i<subsets.Count();i++)
+			charBlockCount=(maxChar>>CharBlockBits)+1;
+			charBlockOffsets=new vint[charBlockCount];
+
+			collections::List<vint> blocks;
+			vint block[CharBlockSize];
+			vint rangeIndex=0;
+			for(vint i=0;i<charBlockCount;i++)
 			{
-				CharRange range=subsets[i];
-				for(vint j=range.begin;j<=range.end;j++)
+				vint first=i<<CharBlockBits;
+				vint last=first+CharBlockSize-1;
+				for(vint j=0;j<CharBlockSize;j++)
+				{
+					block[j]=charSetCount-1;
+				}
+				while(rangeIndex<subsets.Count() && (vint)(vuint)subsets[rangeIndex].end<first)
+				{
+					rangeIndex++;
+				}
+				for(vint j=rangeIndex;j<subsets.Count() && (vint)(vuint)subsets[j].begin<=last;j++)
+				{
+					vint begin=(vint)(vuint)subsets[j].begin;
+					vint end=(vint)(vuint)subsets[j].end;
+					if(begin<first) begin=first;
+					if(end>last) end=last;
+					for(vint k=begin;k<=end;k++)
+					{
+						block[k-first]=j;
+					}
+				}
+
+				vint offset=-1;
+				for(vint j=0;j<blocks.Count();j+=CharBlockSize)
+				{
+					if(memcmp(&blocks[j], block, sizeof(block))==0)
+					{
+						offset=j;
+						break;
+					}
+				}
+				if(offset==-1)
 				{
-					charMap[j]=i;
+					offset=blocks.Count();
+					for(vint j=0;j<CharBlockSize;j++)
+					{
+						blocks.Add(block[j]);
+					}
 				}
+				charBlockOffsets[i]=offset;
 			}
+
+			charBlocks=new vint[blocks.Count()];
+			memcpy(charBlocks, &blocks[0], sizeof(vint)*blocks.Count());
+			memcpy(charMap, charBlocks, sizeof(charMap));
 			
 			//构造状态转换表
 			transition=new vint*[stateCount];
@@ -21828,6 +22258,8 @@ PureInterpretor
 		PureInterpretor::~PureInterpretor()
 		{
 			if(relatedFinalState) delete[] relatedFinalState;
+			delete[] charBlockOffsets;
+			delete[] charBlocks;
 			delete[] finalState;
 			for(vint i=0;i<stateCount;i++)
 			{
@@ -21860,7 +22292,7 @@ PureInterpretor
 #ifdef VCZH_GCC
 				if(*read>=SupportedCharCount)break;
 #endif
-				vint charIndex=charMap[*read++];
+				vint charIndex=GetCharIndex(*read++);
 				currentState=transition[currentState][charIndex];
 			}
 
@@ -21902,7 +22334,7 @@ PureInterpretor
 		{
 			if(0<=state && state<stateCount)
 			{
-				vint charIndex=charMap[input];
+				vint charIndex=GetCharIndex(input);
 				vint nextState=transition[state][charIndex];
 				return nextState;
 			}
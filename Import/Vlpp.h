@@ -793,6 +793,10 @@ namespace vl
 		{
 			const T* bufA=strA.buffer+strA.start;
 			const T* bufB=strB.buffer+strB.start;
+			if(bufA==bufB)
+			{
+				return strA.length-strB.length;
+			}
 			vint length=strA.length<strB.length?strA.length:strB.length;
 			while(length--)
 			{
@@ -805,8 +809,48 @@ namespace vl
 			return strA.length-strB.length;
 		}
 
+		static bool Equals(const ObjectString<T>& strA, const ObjectString<T>& strB)
+		{
+			if(strA.length!=strB.length)
+			{
+				return false;
+			}
+			const T* bufA=strA.buffer+strA.start;
+			const T* bufB=strB.buffer+strB.start;
+			return bufA==bufB || memcmp(bufA, bufB, sizeof(T)*strA.length)==0;
+		}
+
 	private:
 
+		static const char* FindCharacter(const char* buffer, vint length, char c)
+		{
+			return (const char*)memchr(buffer, c, (size_t)length);
+		}
+
+		static const wchar_t* FindCharacter(const wchar_t* buffer, vint length, wchar_t c)
+		{
+			return wmemchr(buffer, c, (size_t)length);
+		}
+
+		static vint* AllocateBlock(vint _length)
+		{
+			// the reference counter and characters share the same memory block
+			vint* block=new vint[1+(sizeof(T)*(_length+1)+sizeof(vint)-1)/sizeof(vint)];
+			*block=1;
+			return block;
+		}
+
+		T* Allocate(vint _length)
+		{
+			vint* block=AllocateBlock(_length);
+			counter=block;
+			buffer=(T*)(block+1);
+			start=0;
+			length=_length;
+			realLength=_length;
+			return buffer;
+		}
+
 		void Inc()const
 		{
 			if(counter)
@@ -821,8 +865,7 @@ namespace vl
 			{
 				if(DECRC(counter)==0)
 				{
-					delete[] buffer;
-					delete counter;
+					delete[] (vint*)counter;
 				}
 			}
 		}
@@ -860,11 +903,7 @@ namespace vl
 			}
 			else
 			{
-				counter=new vint(1);
-				start=0;
-				length=dest.length-count+source.length;
-				realLength=length;
-				buffer=new T[length+1];
+				Allocate(dest.length-count+source.length);
 				memcpy(buffer, dest.buffer+dest.start, sizeof(T)*index);
 				memcpy(buffer+index, source.buffer+source.start, sizeof(T)*source.length);
 				memcpy(buffer+index+source.length, (dest.buffer+dest.start+index+count), sizeof(T)*(dest.length-index-count));
@@ -888,13 +927,9 @@ namespace vl
 		/// <param name="_char">The character.</param>
 		ObjectString(const T& _char)
 		{
-			counter=new vint(1);
-			start=0;
-			length=1;
-			buffer=new T[2];
+			Allocate(1);
 			buffer[0]=_char;
 			buffer[1]=0;
-			realLength=length;
 		}
 
 		/// <summary>Copy a string.</summary>
@@ -912,13 +947,9 @@ namespace vl
 			}
 			else
 			{
-				buffer=new T[_length+1];
+				Allocate(_length);
 				memcpy(buffer, _buffer, _length*sizeof(T));
 				buffer[_length]=0;
-				counter=new vint(1);
-				start=0;
-				length=_length;
-				realLength=_length;
 			}
 		}
 		
@@ -930,12 +961,9 @@ namespace vl
 			CHECK_ERROR(_buffer!=0, L"ObjectString<T>::ObjectString(const T*, bool)#Cannot construct a string from nullptr.");
 			if(copy)
 			{
-				counter=new vint(1);
-				start=0;
-				length=CalculateLength(_buffer);
-				buffer=new T[length+1];
-				memcpy(buffer, _buffer, sizeof(T)*(length+1));
-				realLength=length;
+				vint _length=CalculateLength(_buffer);
+				Allocate(_length);
+				memcpy(buffer, _buffer, sizeof(T)*(_length+1));
 			}
 			else
 			{
@@ -987,12 +1015,13 @@ namespace vl
 		{
 			if(start+length!=realLength)
 			{
-				T* newBuffer=new T[length+1];
+				vint* block=AllocateBlock(length);
+				T* newBuffer=(T*)(block+1);
 				memcpy(newBuffer, buffer+start, sizeof(T)*length);
 				newBuffer[length]=0;
 				Dec();
 				buffer=newBuffer;
-				counter=new vint(1);
+				counter=block;
 				start=0;
 				realLength=length;
 			}
@@ -1046,12 +1075,12 @@ namespace vl
 
 		bool operator==(const ObjectString<T>& string)const
 		{
-			return Compare(*this, string)==0;
+			return Equals(*this, string);
 		}
 
 		bool operator!=(const ObjectString<T>& string)const
 		{
-			return Compare(*this, string)!=0;
+			return !Equals(*this, string);
 		}
 
 		bool operator>(const ObjectString<T>& string)const
@@ -1123,12 +1152,8 @@ namespace vl
 		vint IndexOf(T c)const
 		{
 			const T* reading=buffer+start;
-			for(vint i=0;i<length;i++)
-			{
-				if(reading[i]==c)
-					return i;
-			}
-			return -1;
+			const T* result=FindCharacter(reading, length, c);
+			return result?result-reading:-1;
 		}
 
 		/// <summary>Copy the beginning of the string.</summary>
@@ -4056,1649 +4081,1786 @@ namespace vl
 #endif
 
 /***********************************************************************
-STREAM\INTERFACES.H
+COLLECTIONS\HASHDICTIONARY.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
-Stream::Interfaces
+Data Structure::HashDictionary
 
-Interfaces:
-	IStream							：流
+Classes:
+	KeyHash<T>									：键哈希
+	HashSet<T, K, H>							：哈希集合
+	HashDictionary<KT, VT, KK, VK, KH>			：哈希映射
+	HashGroup<KT, VT, KK, VK, KH>				：哈希多重映射
 ***********************************************************************/
 
-#ifndef VCZH_STREAM_INTERFACES
-#define VCZH_STREAM_INTERFACES
+#ifndef VCZH_COLLECTIONS_HASHDICTIONARY
+#define VCZH_COLLECTIONS_HASHDICTIONARY
 
 
 namespace vl
 {
-	namespace stream
+	namespace collections
 	{
-		/// <summary>
-		/// Interface for streams. Stream functions are grouped into 5 categories:
-		/// 1) Feature testing functions.
-		/// 2) Read functions, available only if [M:vl.stream.IStream.CanRead] returns true.
-		/// 3) Peek functions, available only if [M:vl.stream.IStream.CanPeek] returns true.
-		/// 4) Write functions, available only if [M:vl.stream.IStream.CanWrite] returns true.
-		/// 5) Seek functions, available only if [M:vl.stream.IStream.CanSeek] returns true.
-		/// 6) Size functions, available only if [M:vl.stream.IStream.IsLimited] returns true. But there are still some streams knows that the content is limited, but the size is unknown. In this case, [M:vl.stream.IStream.Size] will return -1.
-		/// </summary>
-		class IStream : public virtual Interface
+
+/***********************************************************************
+哈希函数
+***********************************************************************/
+
+		/// <summary>Get the hash code of a key for hash-based containers. The default implementation supports integers, characters, enums and pointers. Specialize this type to support more key types.</summary>
+		/// <typeparam name="T">Type of the key.</typeparam>
+		template<typename T>
+		struct KeyHash
 		{
-		public:
-			/// <summary>Test if the stream is readable.</summary>
-			/// <returns>Returns true if the stream is readable.</returns>
-			virtual bool					CanRead()const=0;
-			/// <summary>Test if the stream is writable.</summary>
-			/// <returns>Returns true if the stream is writable.</returns>
-			virtual bool					CanWrite()const=0;
-			/// <summary>Test if the stream is seekable.</summary>
-			/// <returns>Returns true if the stream is seekable.</returns>
-			virtual bool					CanSeek()const=0;
-			/// <summary>Test if the stream is peekable.</summary>
-			/// <returns>Returns true if the stream is peekable.</returns>
-			virtual bool					CanPeek()const=0;
-			/// <summary>Test if the content of the stream is limited. A writable stream can also be limited, it means that you can only write a limited content to the stream.</summary>
-			/// <returns>Returns true if the content of the stream is limited.</returns>
-			virtual bool					IsLimited()const=0;
-			/// <summary>Test if the stream is available. For example, if you create a readable [T:vl.stream.FileStream] giving a wrong file name, it will be unavailable.</summary>
-			/// <returns>Returns true if the stream is available.</returns>
-			virtual bool					IsAvailable()const=0;
-			/// <summary>Close the stream.</summary>
-			virtual void					Close()=0;
-			/// <summary>Get the current position in the stream.</summary>
-			/// <returns>The position in the stream. Returns -1 if the stream is not available.</returns>
-			virtual pos_t					Position()const=0;
-			/// <summary>Get the size of the content..</summary>
-			/// <returns>The size of the content. Returns -1 if the size is unknown or the stream is not available.</returns>
-			virtual pos_t					Size()const=0;
-			/// <summary>Step forward or backward from the current position. Will throw exception if the stream is not seekable or not available.</summary>
-			/// <param name="_size">The length of the step.</param>
-			virtual void					Seek(pos_t _size)=0;
-			/// <summary>Step fowward from the beginning. Will throw exception if the stream is not seekable or not available.</summary>
-			/// <param name="_size">The length of the step.</param>
-			virtual void					SeekFromBegin(pos_t _size)=0;
-			/// <summary>Step backward from the end. Will throw exception if the stream is not seekable or not available.</summary>
-			/// <param name="_size">The length of the step.</param>
-			virtual void					SeekFromEnd(pos_t _size)=0;
-			/// <summary>Read from the current position and step forward. Will throw exception if the stream is not readable or not available.</summary>
-			/// <returns>Returns the actual size of the content that is read. Returns 0 indicates that the stream reaches the end if the stream is limited.</returns>
-			/// <param name="_buffer">A buffer to store the content.</param>
-			/// <param name="_size">The size of the content that is expected to read.</param>
-			virtual vint					Read(void* _buffer, vint _size)=0;
-			/// <summary>Write to the current position and step forward. Will throw exception if the stream is not writable or not available.</summary>
-			/// <returns>Returns the actual size of the content that is written. Returns 0 indicates that the stream reaches the end if the stream is limited.</returns>
-			/// <param name="_buffer">A buffer storing the content to write.</param>
-			/// <param name="_size">The size of the content that is expected to write.</param>
-			virtual vint					Write(void* _buffer, vint _size)=0;
-			/// <summary>Read from the current position but not step forward. Will throw exception if the stream is not peekable or not available.</summary>
-			/// <returns>Returns the actual size of the content that is read. Returns 0 indicates that the stream reaches the end if the stream is limited.</returns>
-			/// <param name="_buffer">A buffer to store the content.</param>
-			/// <param name="_size">The size of the content that is expected to peek.</param>
-			virtual vint					Peek(void* _buffer, vint _size)=0;
+			/// <summary>Get the hash code of a key. Equal keys must have equal hash codes.</summary>
+			/// <returns>The hash code.</returns>
+			/// <param name="key">The key.</param>
+			static vuint64_t GetHashCode(const T& key)
+			{
+				return (vuint64_t)key;
+			}
 		};
 
-		/// <summary>Encoder interface. This interface defines a writable transformation from one stream to another stream. You can create a [T:vl.stream.EncoderStream] after you have an encoder.</summary>
-		class IEncoder : public Interface
+		template<typename T>
+		struct KeyHash<ObjectString<T>>
 		{
-		public:
-			/// <summary>Set a target writable stream. The <see cref="Write"/> function will transform the content and write to this tream.</summary>
-			/// <param name="_stream">The target writable stream.</param>
-			virtual void					Setup(IStream* _stream)=0;
-			/// <summary>Stop the transformation, ensuring all written content is transformed to the target stream.</summary>
-			virtual	void					Close()=0;
-			/// <summary>Transform content and write to the target stream. This function may cache something to increase performance, so it cannot expect that all transformed content will be written to the target stream immediately.</summary>
-			/// <returns>Returns the actual size of the content before transforming that is written. The content is treated as being written even it is cached and not actually write to the target stream.</returns>
-			/// <param name="_buffer">A buffer storing the content to write.</param>
-			/// <param name="_size">The size of the content that is expected to write.</param>
-			virtual vint					Write(void* _buffer, vint _size)=0;
+			static vuint64_t GetHashCode(const ObjectString<T>& key)
+			{
+				// read 8 bytes at a time, equal strings always have equal bytes
+				const char* reading=(const char*)key.Buffer();
+				vint size=key.Length()*sizeof(T);
+				vuint64_t hash=14695981039346656037ULL^(vuint64_t)size;
+				while(size>0)
+				{
+					vuint64_t word=0;
+					memcpy(&word, reading, size<8?size:8);
+					hash=(hash^word)*1099511628211ULL;
+					hash^=hash>>29;
+					reading+=8;
+					size-=8;
+				}
+				return hash;
+			}
 		};
-		
-		/// <summary>Decoder interface. This interface defines a readable transformation from one stream to another stream. You can create a [T:vl.stream.DecoderStream] after you have an decoder.</summary>
-		class IDecoder : public Interface
+
+		template<typename K, typename V>
+		struct KeyHash<Pair<K, V>>
 		{
-		public:
-			/// <summary>Set a target readable stream. The <see cref="Read"/> function will read from this tream and transform the content.</summary>
-			/// <param name="_stream">The target readable stream.</param>
-			virtual void					Setup(IStream* _stream)=0;
-			/// <summary>Stop the transformation.</summary>
-			virtual	void					Close()=0;
-			/// <summary>Read from the target stream and transform the content.</summary>
-			/// <returns>Returns the actual size of the content after transforming that is read.</returns>
-			/// <param name="_buffer">A buffer to store the content.</param>
-			/// <param name="_size">The size of the content that is expected to read.</param>
-			virtual vint					Read(void* _buffer, vint _size)=0;
+			static vuint64_t GetHashCode(const Pair<K, V>& key)
+			{
+				return KeyHash<K>::GetHashCode(key.key)*31+KeyHash<V>::GetHashCode(key.value);
+			}
 		};
-	}
-}
-
-#endif
 
 /***********************************************************************
-STREAM\MEMORYSTREAM.H
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Stream::MemoryStream
-
-Interfaces:
-	MemoryStream					：内存流
+HashSet
 ***********************************************************************/
 
-#ifndef VCZH_STREAM_MEMORYSTREAM
-#define VCZH_STREAM_MEMORYSTREAM
-
-
-namespace vl
-{
-	namespace stream
-	{
-		/// <summary>A readable, writable, seekable and peekable stream that stores everything in memory.</summary>
-		class MemoryStream : public Object, public virtual IStream
+		/// <summary>Unordered set using open addressing. Items are stored compactly in a list, so they can be accessed by position. Removing an item moves the last item to the position of the removed one.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="K">Type of the key type of elements.</typeparam>
+		/// <typeparam name="H">Type of the hash function of the key type.</typeparam>
+		template<
+			typename T,
+			typename K=typename KeyType<T>::Type,
+			typename H=KeyHash<K>
+		>
+		class HashSet : public Object, public virtual IEnumerable<T>
 		{
-		protected:
-			vint					block;
-			char*					buffer;
-			vint					size;
-			vint					position;
-			vint					capacity;
-
-			void					PrepareSpace(vint totalSpace);
 		public:
-			/// <summary>Create a stream.</summary>
-			/// <param name="_block">Size for each allocation. The stream will only allocate new memory of size "_block" when it reaches the end and has to extend.</param>
-			MemoryStream(vint _block=65536);
-			~MemoryStream();
+			typedef T							ElementType;
+		protected:
+			List<T, K>							items;
+			List<vuint64_t>						hashes;
+			Array<vint>							slots;
+			vint								slotBits;
 
-			bool					CanRead()const;
-			bool					CanWrite()const;
-			bool					CanSeek()const;
-			bool					CanPeek()const;
-			bool					IsLimited()const;
-			bool					IsAvailable()const;
-			void					Close();
-			pos_t					Position()const;
-			pos_t					Size()const;
-			void					Seek(pos_t _size);
-			void					SeekFromBegin(pos_t _size);
-			void					SeekFromEnd(pos_t _size);
-			vint					Read(void* _buffer, vint _size);
-			vint					Write(void* _buffer, vint _size);
-			vint					Peek(void* _buffer, vint _size);
-			void*					GetInternalBuffer();
-		};
-	}
-}
+			vint GetHomeSlot(vuint64_t hash)const
+			{
+				return (vint)((hash*11400714819323198485ULL)>>(64-slotBits));
+			}
 
-#endif
+			vint FindSlot(const K& item, vuint64_t hash)const
+			{
+				vint mask=slots.Count()-1;
+				vint slot=GetHomeSlot(hash);
+				while(true)
+				{
+					vint index=slots[slot];
+					if(index==-1 || (hashes[index]==hash && items[index]==item))
+					{
+						return slot;
+					}
+					slot=(slot+1)&mask;
+				}
+			}
 
-/***********************************************************************
-STREAM\MEMORYWRAPPERSTREAM.H
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Stream::MemoryWrapperStream
+			vint FindSlotByIndex(vint index)const
+			{
+				vint mask=slots.Count()-1;
+				vint slot=GetHomeSlot(hashes[index]);
+				while(slots[slot]!=index)
+				{
+					slot=(slot+1)&mask;
+				}
+				return slot;
+			}
 
-Interfaces:
-	MemoryWrapperStream				：内存代理流
-***********************************************************************/
+			void Rehash(vint bits)
+			{
+				slotBits=bits;
+				slots.Resize((vint)1<<bits);
+				for(vint i=0;i<slots.Count();i++)
+				{
+					slots[i]=-1;
+				}
 
-#ifndef VCZH_STREAM_MEMORYWRAPPERSTREAM
-#define VCZH_STREAM_MEMORYWRAPPERSTREAM
+				vint mask=slots.Count()-1;
+				for(vint i=0;i<items.Count();i++)
+				{
+					vint slot=GetHomeSlot(hashes[i]);
+					while(slots[slot]!=-1)
+					{
+						slot=(slot+1)&mask;
+					}
+					slots[slot]=i;
+				}
+			}
 
+			void RemoveSlot(vint slot)
+			{
+				// move following items in the same probe sequence backward, so that no tombstone is needed
+				vint mask=slots.Count()-1;
+				vint hole=slot;
+				slot=(slot+1)&mask;
+				while(slots[slot]!=-1)
+				{
+					vint home=GetHomeSlot(hashes[slots[slot]]);
+					if(((slot-home)&mask)>=((slot-hole)&mask))
+					{
+						slots[hole]=slots[slot];
+						hole=slot;
+					}
+					slot=(slot+1)&mask;
+				}
+				slots[hole]=-1;
+			}
+		public:
+			/// <summary>Create a set.</summary>
+			HashSet()
+				:slotBits(0)
+			{
+			}
 
-namespace vl
-{
-	namespace stream
-	{
-		/// <summary>A readable, writable, seekable and peekable stream that operates a buffer.</summary>
-		class MemoryWrapperStream : public Object, public virtual IStream
-		{
-		protected:
-			char*					buffer;
-			vint						size;
-			vint						position;
-		public:
-			/// <summary>Create a stream.</summary>
-			/// <param name="_buffer">The buffer to operate.</param>
-			/// <param name="_size">Size of the buffer.</param>
-			MemoryWrapperStream(void* _buffer, vint _size);
-			~MemoryWrapperStream();
-
-			bool					CanRead()const;
-			bool					CanWrite()const;
-			bool					CanSeek()const;
-			bool					CanPeek()const;
-			bool					IsLimited()const;
-			bool					IsAvailable()const;
-			void					Close();
-			pos_t					Position()const;
-			pos_t					Size()const;
-			void					Seek(pos_t _size);
-			void					SeekFromBegin(pos_t _size);
-			void					SeekFromEnd(pos_t _size);
-			vint					Read(void* _buffer, vint _size);
-			vint					Write(void* _buffer, vint _size);
-			vint					Peek(void* _buffer, vint _size);
-		};
-	}
-}
-
-#endif
-
-/***********************************************************************
-STREAM\CHARFORMAT.H
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Stream::CharFormat
+			IEnumerator<T>* CreateEnumerator()const
+			{
+				return items.CreateEnumerator();
+			}
+			
+			/// <summary>Set a preference of using memory.</summary>
+			/// <param name="mode">Set to true (by default) to let the container efficiently reduce memory usage when necessary.</param>
+			void SetLessMemoryMode(bool mode)
+			{
+				items.SetLessMemoryMode(mode);
+				hashes.SetLessMemoryMode(mode);
+			}
 
-Classes:
-	CharEncoder									：字符串编码器基类
-	CharDecoder									：字符串解码器基类
-	MbcsEncoder									：Mbcs编码器
-	MbcsDecoder									：Mbcs解码器
-	Utf16Encoder								：Utf16编码器
-	Utf16Decoder								：Utf16解码器
-	Utf16BEEncoder								：Utf16 Big Endian编码器
-	Utf16BEDecoder								：Utf16 Big Endian解码器
-	Utf8Encoder									：Utf8编码器
-	Utf8Decoder									：Utf8解码器
-	BomEncoder									：BOM相关编码器
-	BomDecoder									：BOM相关解码器
-***********************************************************************/
+			/// <summary>Get the number of elements.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return items.Count();
+			}
 
-#ifndef VCZH_STREAM_CHARFORMAT
-#define VCZH_STREAM_CHARFORMAT
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element.</returns>
+			/// <param name="index">The position of the element.</param>
+			const T& Get(vint index)const
+			{
+				return items.Get(index);
+			}
 
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element.</returns>
+			/// <param name="index">The position of the element.</param>
+			const T& operator[](vint index)const
+			{
+				return items.Get(index);
+			}
+			
+			/// <summary>Test does the set contain an item or not.</summary>
+			/// <returns>Returns true if the set contains the specified item.</returns>
+			/// <param name="item">The item to test.</param>
+			bool Contains(const K& item)const
+			{
+				return IndexOf(item)!=-1;
+			}
+			
+			/// <summary>Get the position of an item in this set.</summary>
+			/// <returns>Returns the position. Returns -1 if not exists</returns>
+			/// <param name="item">The item to find.</param>
+			vint IndexOf(const K& item)const
+			{
+				if(items.Count()==0) return -1;
+				return slots[FindSlot(item, H::GetHashCode(item))];
+			}
+			
+			/// <summary>Add an item if it does not exist.</summary>
+			/// <returns>The position of the item.</returns>
+			/// <param name="item">The item to add.</param>
+			vint Add(const T& item)
+			{
+				if((items.Count()+1)*4>slots.Count()*3)
+				{
+					Rehash(slotBits<3?3:slotBits+1);
+				}
 
-namespace vl
-{
-	namespace stream
-	{
+				K key=KeyType<T>::GetKeyValue(item);
+				vuint64_t hash=H::GetHashCode(key);
+				vint slot=FindSlot(key, hash);
+				if(slots[slot]==-1)
+				{
+					slots[slot]=items.Add(item);
+					hashes.Add(hash);
+				}
+				return slots[slot];
+			}
+			
+			/// <summary>Remove an item.</summary>
+			/// <returns>Returns true if the item is removed.</returns>
+			/// <param name="item">The item to remove.</param>
+			bool Remove(const K& item)
+			{
+				vint index=IndexOf(item);
+				if(index==-1) return false;
+				return RemoveAt(index);
+			}
+			
+			/// <summary>Remove an item at a specified position. The last item will be moved to this position.</summary>
+			/// <returns>Returns true if the item is removed.</returns>
+			/// <param name="index">The position of the item to remove.</param>
+			bool RemoveAt(vint index)
+			{
+				CHECK_ERROR(index>=0 && index<items.Count(), L"HashSet<T, K, H>::RemoveAt(vint)#Argument index not in range.");
+				RemoveSlot(FindSlotByIndex(index));
 
-		/*编码资料
-		UCS-4和UTF-8的对应关系:
-		U-00000000 - U-0000007F:  0xxxxxxx
-		U-00000080 - U-000007FF:  110xxxxx 10xxxxxx
-		U-00000800 - U-0000FFFF:  1110xxxx 10xxxxxx 10xxxxxx
-		U-00010000 - U-001FFFFF:  11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-		U-00200000 - U-03FFFFFF:  111110xx 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx
-		U-04000000 - U-7FFFFFFF:  1111110x 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx
-		BOM:
-		FFFE	=Unicode			(vceUtf16)
-		FEFF	=Unicode Big Endian	(vceUtf16_be)
-		EFBBBF	=UTF-8				(vceUtf8)
-		other	=MBCS(GBK)			(vceMbcs)
-		*/
+				vint last=items.Count()-1;
+				if(index!=last)
+				{
+					slots[FindSlotByIndex(last)]=index;
+					items.Set(index, items[last]);
+					hashes.Set(index, hashes[last]);
+				}
+				items.RemoveAt(last);
+				hashes.RemoveAt(last);
+				return true;
+			}
+			
+			/// <summary>Remove all items.</summary>
+			/// <returns>Returns true if all items are removed.</returns>
+			bool Clear()
+			{
+				items.Clear();
+				hashes.Clear();
+				slots.Resize(0);
+				slotBits=0;
+				return true;
+			}
+		};
 
 /***********************************************************************
-字符串编码解码基类
+HashDictionary
 ***********************************************************************/
 
-		/// <summary>Base type of all character encoder.</summary>
-		class CharEncoder : public Object, public IEncoder
+		/// <summary>Dictionary using open addressing. Unlike <see cref="Dictionary`4"/>, keys are not sorted, and removing a key moves the last key and value to the position of the removed ones.</summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="KK">Type of the key type of keys.</typeparam>
+		/// <typeparam name="VK">Type of the key type of values.</typeparam>
+		/// <typeparam name="KH">Type of the hash function of the key type of keys.</typeparam>
+		template<
+			typename KT,
+			typename VT,
+			typename KK=typename KeyType<KT>::Type, 
+			typename VK=typename KeyType<VT>::Type,
+			typename KH=KeyHash<KK>
+		>
+		class HashDictionary : public Object, public virtual IEnumerable<Pair<KT, VT>>
 		{
-		protected:
-			IStream*						stream;
-			vuint8_t						cacheBuffer[sizeof(wchar_t)];
-			vint							cacheSize;
-
-			virtual vint					WriteString(wchar_t* _buffer, vint chars)=0;
 		public:
-			CharEncoder();
-
-			void							Setup(IStream* _stream);
-			void							Close();
-			vint							Write(void* _buffer, vint _size);
-		};
-		
-		/// <summary>Base type of all character decoder.</summary>
-		class CharDecoder : public Object, public IDecoder
-		{
+			typedef HashSet<KT, KK, KH>			KeyContainer;
+			typedef List<VT, VK>				ValueContainer;
 		protected:
-			IStream*						stream;
-			vuint8_t						cacheBuffer[sizeof(wchar_t)];
-			vint							cacheSize;
+			class Enumerator : public Object, public virtual IEnumerator<Pair<KT, VT>>
+			{
+			private:
+				const HashDictionary<KT, VT, KK, VK, KH>*	container;
+				vint										index;
+				Pair<KT, VT>								current;
 
-			virtual vint					ReadString(wchar_t* _buffer, vint chars)=0;
-		public:
-			CharDecoder();
+				void UpdateCurrent()
+				{
+					if(index<container->Count())
+					{
+						current.key=container->Keys().Get(index);
+						current.value=container->Values().Get(index);
+					}
+				}
+			public:
+				Enumerator(const HashDictionary<KT, VT, KK, VK, KH>* _container, vint _index=-1)
+				{
+					container=_container;
+					index=_index;
+				}
+				
+				IEnumerator<Pair<KT, VT>>* Clone()const
+				{
+					return new Enumerator(container, index);
+				}
 
-			void							Setup(IStream* _stream);
-			void							Close();
-			vint							Read(void* _buffer, vint _size);
-		};
+				const Pair<KT, VT>& Current()const
+				{
+					return current;
+				}
 
-/***********************************************************************
-Mbcs
-***********************************************************************/
-		
-		/// <summary>Encoder to transform text in a local code page from wchar_t.</summary>
-		class MbcsEncoder : public CharEncoder
-		{
-		protected:
-			vint							WriteString(wchar_t* _buffer, vint chars);
-		};
-		
-		/// <summary>Encoder to transform text in a local code page to wchar_t.</summary>
-		class MbcsDecoder : public CharDecoder
-		{
-		protected:
-			vint							ReadString(wchar_t* _buffer, vint chars);
-		};
+				vint Index()const
+				{
+					return index;
+				}
 
-/***********************************************************************
-Utf-16
-***********************************************************************/
-		
-		/// <summary>Encoder to transform UTF-16 text from wchar_t.</summary>
-		class Utf16Encoder : public CharEncoder
-		{
-		protected:
-			vint							WriteString(wchar_t* _buffer, vint chars);
-		};
-		
-		/// <summary>Decoder to transform UTF-16 text to wchar_t.</summary>
-		class Utf16Decoder : public CharDecoder
-		{
-		protected:
-			vint							ReadString(wchar_t* _buffer, vint chars);
-		};
+				bool Next()
+				{
+					index++;
+					UpdateCurrent();
+					return index>=0 && index<container->Count();
+				}
 
-/***********************************************************************
-Utf-16-be
-***********************************************************************/
-		
-		/// <summary>Encoder to transform big endian UTF-16 text from wchar_t.</summary>
-		class Utf16BEEncoder : public CharEncoder
-		{
-		protected:
-			vint							WriteString(wchar_t* _buffer, vint chars);
-		};
-		
-		/// <summary>Decoder to transform big endian UTF-16 text to wchar_t.</summary>
-		class Utf16BEDecoder : public CharDecoder
-		{
-		protected:
-			vint							ReadString(wchar_t* _buffer, vint chars);
-		};
-
-/***********************************************************************
-Utf-8
-***********************************************************************/
-		
-		/// <summary>Encoder to transform UTF-8 text from wchar_t.</summary>
-		class Utf8Encoder : public CharEncoder
-		{
-		protected:
-			vint							WriteString(wchar_t* _buffer, vint chars);
-		};
-		
-		/// <summary>Decoder to transform UTF-8 text to wchar_t.</summary>
-		class Utf8Decoder : public CharDecoder
-		{
-		protected:
-#if defined VCZH_MSVC
-			wchar_t							cache;
-			bool							cacheAvailable;
-#endif
-			vint							ReadString(wchar_t* _buffer, vint chars);
-		public:
-			Utf8Decoder();
-		};
+				void Reset()
+				{
+					index=-1;
+					UpdateCurrent();
+				}
+			};
 
-/***********************************************************************
-Bom
-***********************************************************************/
-		
-		/// <summary>Encoder to transform text from wchar_t. A BOM will be added at the beginning.</summary>
-		class BomEncoder : public Object, public IEncoder
-		{
+			KeyContainer						keys;
+			ValueContainer						values;
 		public:
-			/// <summary>Text encoding.</summary>
-			enum Encoding
+			/// <summary>Create a dictionary.</summary>
+			HashDictionary()
 			{
-				/// <summary>Multi-bytes character string.</summary>
-				Mbcs,
-				/// <summary>UTF-8.</summary>
-				Utf8,
-				/// <summary>UTF-16.</summary>
-				Utf16,
-				/// <summary>Big endian UTF-16.</summary>
-				Utf16BE
-			};
-		protected:
-			Encoding						encoding;
-			IEncoder*						encoder;
-		public:
-			/// <summary>Create an encoder.</summary>
-			/// <param name="_encoding">Specified encoding.</param>
-			BomEncoder(Encoding _encoding);
-			~BomEncoder();
+			}
 
-			void							Setup(IStream* _stream);
-			void							Close();
-			vint							Write(void* _buffer, vint _size);
-		};
-		
-		/// <summary>Decoder to transform text to wchar_t. This decoder depends on the BOM information at the beginning to decide the format of the input.</summary>
-		class BomDecoder : public Object, public IDecoder
-		{
-		private:
-			class BomStream : public Object, public IStream
+			IEnumerator<Pair<KT, VT>>* CreateEnumerator()const
 			{
-			protected:
-				IStream*					stream;
-				char						bom[3];
-				vint						bomLength;
-				vint						bomPosition;
-			public:
-				BomStream(IStream* _stream, char* _bom, vint _bomLength);
-
-				bool						CanRead()const;
-				bool						CanWrite()const;
-				bool						CanSeek()const;
-				bool						CanPeek()const;
-				bool						IsLimited()const;
-				bool						IsAvailable()const;
-				void						Close();
-				pos_t						Position()const;
-				pos_t						Size()const;
-				void						Seek(pos_t _size);
-				void						SeekFromBegin(pos_t _size);
-				void						SeekFromEnd(pos_t _size);
-				vint						Read(void* _buffer, vint _size);
-				vint						Write(void* _buffer, vint _size);
-				vint						Peek(void* _buffer, vint _size);
-			};
-		protected:
-			IDecoder*						decoder;
-			IStream*						stream;
-
-		public:
-			/// <summary>Create an decoder.</summary>
-			BomDecoder();
-			~BomDecoder();
-
-			void							Setup(IStream* _stream);
-			void							Close();
-			vint							Read(void* _buffer, vint _size);
-		};
-
-/***********************************************************************
-Encoding Test
-***********************************************************************/
-
-		/// <summary>Guess the text encoding in a buffer.</summary>
-		/// <param name="buffer">The buffer to guess.</param>
-		/// <param name="size">Size of the buffer in bytes.</param>
-		/// <param name="encoding">Returns the most possible encoding.</param>
-		/// <param name="containsBom">Returns true if the BOM information is at the beginning of the buffer.</param>
-		extern void							TestEncoding(unsigned char* buffer, vint size, BomEncoder::Encoding& encoding, bool& containsBom);
-
-/***********************************************************************
-Serialization
-***********************************************************************/
-
-		namespace internal
-		{
-			template<typename T>
-			struct Reader
+				return new Enumerator(this);
+			}
+			
+			/// <summary>Set a preference of using memory.</summary>
+			/// <param name="mode">Set to true (by default) to let the container efficiently reduce memory usage when necessary.</param>
+			void SetLessMemoryMode(bool mode)
 			{
-				stream::IStream&			input;
-				T							context;
+				keys.SetLessMemoryMode(mode);
+				values.SetLessMemoryMode(mode);
+			}
 
-				Reader(stream::IStream& _input)
-					:input(_input)
-					, context(nullptr)
-				{
-				}
-			};
-				
-			template<typename T>
-			struct Writer
+			/// <summary>Get all keys.</summary>
+			/// <returns>All keys.</returns>
+			const KeyContainer& Keys()const
 			{
-				stream::IStream&			output;
-				T							context;
-
-				Writer(stream::IStream& _output)
-					:output(_output)
-					, context(nullptr)
-				{
-				}
-			};
-
-			using ContextFreeReader = Reader<void*>;
-			using ContextFreeWriter = Writer<void*>;
-
-			template<typename T>
-			struct Serialization
+				return keys;
+			}
+			
+			/// <summary>Get all values.</summary>
+			/// <returns>All values.</returns>
+			const ValueContainer& Values()const
 			{
-				template<typename TIO>
-				static void IO(TIO& io, T& value);
-			};
+				return values;
+			}
 
-			template<typename TValue, typename TContext>
-			Reader<TContext>& operator<<(Reader<TContext>& reader, TValue& value)
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
 			{
-				Serialization<TValue>::IO(reader, value);
-				return reader;
+				return keys.Count();
 			}
 
-			template<typename TValue, typename TContext>
-			Writer<TContext>& operator<<(Writer<TContext>& writer, TValue& value)
+			/// <summary>Get the reference to the value associated with a key.</summary>
+			/// <returns>The reference to the value.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& Get(const KK& key)const
 			{
-				Serialization<TValue>::IO(writer, value);
-				return writer;
+				return values.Get(keys.IndexOf(key));
+			}
+			
+			/// <summary>Get the reference to the value associated with a key.</summary>
+			/// <returns>The reference to the value.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& operator[](const KK& key)const
+			{
+				return values.Get(keys.IndexOf(key));
 			}
 
-			//---------------------------------------------
-
-			template<>
-			struct Serialization<vint64_t>
+			/// <summary>Test if a key exists in the dictionary or not.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, vint64_t& value)
+				return keys.Contains(key);
+			}
+			
+			/// <summary>Replace the value associated with a key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The key to replace.</param>
+			bool Set(const KT& key, const VT& value)
+			{
+				vint count=keys.Count();
+				vint index=keys.Add(key);
+				if(index==count)
 				{
-					if (reader.input.Read(&value, sizeof(value)) != sizeof(value))
-					{
-						CHECK_FAIL(L"Deserialization failed.");
-					}
+					values.Add(value);
 				}
-				
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, vint64_t& value)
+				else
 				{
-					if (writer.output.Write(&value, sizeof(value)) != sizeof(value))
-					{
-						CHECK_FAIL(L"Serialization failed.");
-					}
+					values[index]=value;
 				}
-			};
+				return true;
+			}
 
-			template<>
-			struct Serialization<vint32_t>
+			/// <summary>Add a key with an associated value. Exception will raise if the key already exists.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(const Pair<KT, VT>& value)
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, vint32_t& value)
-				{
-					vint64_t v = 0;
-					Serialization<vint64_t>::IO(reader, v);
-					value = (vint32_t)v;
-				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, vint32_t& value)
-				{
-					vint64_t v = (vint64_t)value;
-					Serialization<vint64_t>::IO(writer, v);
-				}
-			};
+				return Add(value.key, value.value);
+			}
+			
+			/// <summary>Add a key with an associated value. Exception will raise if the key already exists.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="key">The key.</param>
+			/// <param name="value">The value.</param>
+			bool Add(const KT& key, const VT& value)
+			{
+				vint count=keys.Count();
+				vint index=keys.Add(key);
+				CHECK_ERROR(index==count, L"HashDictionary<KT, VT, KK, VK, KH>::Add(const KT&, const VT&)#Key already exists.");
+				if(index!=count) return false;
+				values.Add(value);
+				return true;
+			}
 
-			template<>
-			struct Serialization<bool>
+			/// <summary>Remove a key with the associated value.</summary>
+			/// <returns>Returns true if the key and the value is removed.</returns>
+			/// <param name="key">The key.</param>
+			bool Remove(const KK& key)
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, bool& value)
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
 				{
-					vint8_t v = 0;
-					if (reader.input.Read(&v, sizeof(v)) != sizeof(v))
-					{
-						CHECK_FAIL(L"Deserialization failed.");
-					}
-					else
+					vint last=values.Count()-1;
+					keys.RemoveAt(index);
+					if(index!=last)
 					{
-						value = v == -1;
+						values[index]=values[last];
 					}
+					values.RemoveAt(last);
+					return true;
 				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, bool& value)
+				else
 				{
-					vint8_t v = value ? -1 : 0;
-					if (writer.output.Write(&v, sizeof(v)) != sizeof(v))
-					{
-						CHECK_FAIL(L"Serialization failed.");
-					}
+					return false;
 				}
-			};
+			}
 
-			template<typename T>
-			struct Serialization<Ptr<T>>
+			/// <summary>Remove everything.</summary>
+			/// <returns>Returns true if all keys and values are removed.</returns>
+			bool Clear()
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, Ptr<T>& value)
+				keys.Clear();
+				values.Clear();
+				return true;
+			}
+		};
+
+/***********************************************************************
+HashGroup
+***********************************************************************/
+		
+		/// <summary>Group using open addressing. Unlike <see cref="Group`4"/>, keys are not sorted, and removing a key moves the last key and its values to the position of the removed ones.</summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="KK">Type of the key type of keys.</typeparam>
+		/// <typeparam name="VK">Type of the key type of values.</typeparam>
+		/// <typeparam name="KH">Type of the hash function of the key type of keys.</typeparam>
+		template<
+			typename KT,
+			typename VT,
+			typename KK=typename KeyType<KT>::Type,
+			typename VK=typename KeyType<VT>::Type,
+			typename KH=KeyHash<KK>
+		>
+		class HashGroup : public Object, public virtual IEnumerable<Pair<KT, VT>>
+		{
+			typedef HashSet<KT, KK, KH>		KeyContainer;
+			typedef List<VT, VK>			ValueContainer;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<Pair<KT, VT>>
+			{
+			private:
+				const HashGroup<KT, VT, KK, VK, KH>*	container;
+				vint									keyIndex;
+				vint									valueIndex;
+				Pair<KT, VT>							current;
+
+				void UpdateCurrent()
 				{
-					bool notNull = false;
-					reader << notNull;
-					if (notNull)
-					{
-						value = new T;
-						Serialization<T>::IO(reader, *value.Obj());
-					}
-					else
+					if(keyIndex<container->Count())
 					{
-						value = 0;
+						const ValueContainer& values=container->GetByIndex(keyIndex);
+						if(valueIndex<values.Count())
+						{
+							current.key=container->Keys().Get(keyIndex);
+							current.value=values.Get(valueIndex);
+						}
 					}
 				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, Ptr<T>& value)
+			public:
+				Enumerator(const HashGroup<KT, VT, KK, VK, KH>* _container, vint _keyIndex=-1, vint _valueIndex=-1)
 				{
-					bool notNull = value;
-					writer << notNull;
-					if (notNull)
-					{
-						Serialization<T>::IO(writer, *value.Obj());
-					}
+					container=_container;
+					keyIndex=_keyIndex;
+					valueIndex=_valueIndex;
 				}
-			};
-
-			template<typename T>
-			struct Serialization<Nullable<T>>
-			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, Nullable<T>& value)
+				
+				IEnumerator<Pair<KT, VT>>* Clone()const
 				{
-					bool notNull = false;
-					reader << notNull;
-					if (notNull)
-					{
-						T data;
-						Serialization<T>::IO(reader, data);
-						value = Nullable<T>(data);
-					}
-					else
-					{
-						value = Nullable<T>();
-					}
+					return new Enumerator(container, keyIndex, valueIndex);
 				}
-				
-				template<typename TContext>	
-				static void IO(Writer<TContext>& writer, Nullable<T>& value)
+
+				const Pair<KT, VT>& Current()const
 				{
-					bool notNull = value;
-					writer << notNull;
-					if (notNull)
-					{
-						T data = value.Value();
-						Serialization<T>::IO(writer, data);
-					}
+					return current;
 				}
-			};
 
-			template<>
-			struct Serialization<WString>
-			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, WString& value)
+				vint Index()const
 				{
-					vint count = -1;
-					reader << count;
-					if (count > 0)
+					if(0<=keyIndex && keyIndex<container->Count())
 					{
-						MemoryStream stream;
-						reader << (IStream&)stream;
-						Utf8Decoder decoder;
-						decoder.Setup(&stream);
-
-						collections::Array<wchar_t> stringBuffer(count + 1);
-						vint stringSize = decoder.Read(&stringBuffer[0], count * sizeof(wchar_t));
-						stringBuffer[stringSize / sizeof(wchar_t)] = 0;
-
-						value = &stringBuffer[0];
+						vint index=0;
+						for(vint i=0;i<keyIndex;i++)
+						{
+							index+=container->GetByIndex(i).Count();
+						}
+						return index+valueIndex;
 					}
 					else
 					{
-						value = L"";
+						return -1;
 					}
 				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, WString& value)
+
+				bool Next()
 				{
-					vint count = value.Length();
-					writer << count;
-					if (count > 0)
+					if(keyIndex==-1)
 					{
-						MemoryStream stream;
+						keyIndex=0;
+					}
+					while(keyIndex<container->Count())
+					{
+						valueIndex++;
+						const ValueContainer& values=container->GetByIndex(keyIndex);
+						if(valueIndex<values.Count())
 						{
-							Utf8Encoder encoder;
-							encoder.Setup(&stream);
-							encoder.Write((void*)value.Buffer(), count * sizeof(wchar_t));
+							UpdateCurrent();
+							return true;
+						}
+						else
+						{
+							keyIndex++;
+							valueIndex=-1;
 						}
-						writer << (IStream&)stream;
 					}
+					return false;
 				}
-			};
 
-			template<typename T>
-			struct Serialization<collections::List<T>>
-			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, collections::List<T>& value)
-				{
-					vint32_t count = -1;
-					reader << count;
-					value.Clear();
-					for (vint i = 0; i < count; i++)
-					{
-						T t;
-						reader << t;
-						value.Add(t);
-					}
-				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, collections::List<T>& value)
+				void Reset()
 				{
-					vint32_t count = (vint32_t)value.Count();
-					writer << count;
-					for (vint i = 0; i < count; i++)
-					{
-						writer << value[i];
-					}
+					keyIndex=-1;
+					valueIndex=-1;
+					UpdateCurrent();
 				}
 			};
 
-			template<typename T>
-			struct Serialization<collections::Array<T>>
+			KeyContainer					keys;
+			List<ValueContainer*>			values;
+
+			void RemoveByIndex(vint index)
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, collections::Array<T>& value)
+				ValueContainer* target=values[index];
+				vint last=values.Count()-1;
+				keys.RemoveAt(index);
+				if(index!=last)
 				{
-					vint32_t count = -1;
-					reader << count;
-					value.Resize(count);
-					for (vint i = 0; i < count; i++)
-					{
-						reader << value[i];
-					}
+					values[index]=values[last];
 				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, collections::Array<T>& value)
+				values.RemoveAt(last);
+				delete target;
+			}
+		public:
+			HashGroup()
+			{
+			}
+
+			~HashGroup()
+			{
+				Clear();
+			}
+
+			IEnumerator<Pair<KT, VT>>* CreateEnumerator()const
+			{
+				return new Enumerator(this);
+			}
+			
+			/// <summary>Get all keys.</summary>
+			/// <returns>All keys.</returns>
+			const KeyContainer& Keys()const
+			{
+				return keys;
+			}
+			
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				return keys.Count();
+			}
+			
+			/// <summary>Get all values associated with a key.</summary>
+			/// <returns>All values.</returns>
+			/// <param name="key">The key to find.</param>
+			const ValueContainer& Get(const KK& key)const
+			{
+				return *values.Get(keys.IndexOf(key));
+			}
+			
+			/// <summary>Get all values associated with a key.</summary>
+			/// <returns>All values.</returns>
+			/// <param name="index">The position of a the key.</param>
+			const ValueContainer& GetByIndex(vint index)const
+			{
+				return *values.Get(index);
+			}
+			
+			/// <summary>Get all values associated with a key.</summary>
+			/// <returns>All values.</returns>
+			/// <param name="key">The key to find.</param>
+			const ValueContainer& operator[](const KK& key)const
+			{
+				return *values.Get(keys.IndexOf(key));
+			}
+
+			/// <summary>Test if a key exists in the group or not.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				return keys.Contains(key);
+			}
+			
+			/// <summary>Test if a key exists with an associated value in the group or not.</summary>
+			/// <returns>Returns true if the key exists with an associated value.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The value to find.</param>
+			bool Contains(const KK& key, const VK& value)const
+			{
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
 				{
-					vint32_t count = (vint32_t)value.Count();
-					writer << count;
-					for (vint i = 0; i < count; i++)
-					{
-						writer << value[i];
-					}
+					return values.Get(index)->Contains(value);
 				}
-			};
-
-			template<typename K, typename V>
-			struct Serialization<collections::Dictionary<K, V>>
+				else
+				{
+					return false;
+				}
+			}
+			
+			/// <summary>Add a key with an associated value. If the key already exists, the value will be associated with the key with other values.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(const Pair<KT, VT>& value)
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, collections::Dictionary<K, V>& value)
+				return Add(value.key, value.value);
+			}
+			
+			/// <summary>Add a key with an associated value. If the key already exists, the value will be associated with the key with other values.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="key">The key.</param>
+			/// <param name="value">The value.</param>
+			bool Add(const KT& key, const VT& value)
+			{
+				vint count=keys.Count();
+				vint index=keys.Add(key);
+				if(index==count)
 				{
-					vint32_t count = -1;
-					reader << count;
-					value.Clear();
-					for (vint i = 0; i < count; i++)
-					{
-						K k;
-						V v;
-						reader << k << v;
-						value.Add(k, v);
-					}
+					values.Add(new ValueContainer);
 				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, collections::Dictionary<K, V>& value)
+				values[index]->Add(value);
+				return true;
+			}
+			
+			/// <summary>Remove a key with all associated values.</summary>
+			/// <returns>Returns true if the key and all associated values are removed.</returns>
+			/// <param name="key">The key.</param>
+			bool Remove(const KK& key)
+			{
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
 				{
-					vint32_t count = (vint32_t)value.Count();
-					writer << count;
-					for (vint i = 0; i < count; i++)
-					{
-						K k = value.Keys()[i];
-						V v = value.Values()[i];
-						writer << k << v;
-					}
+					RemoveByIndex(index);
+					return true;
 				}
-			};
-
-			template<typename K, typename V>
-			struct Serialization<collections::Group<K, V>>
+				else
+				{
+					return false;
+				}
+			}
+			
+			/// <summary>Remove a key with the associated values.</summary>
+			/// <returns>Returns true if the key and the associated values are removed. If there are multiple values associated with the key, only the value will be removed.</returns>
+			/// <param name="key">The key.</param>
+			/// <param name="value">The value.</param>
+			bool Remove(const KK& key, const VK& value)
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, collections::Group<K, V>& value)
+				vint index=keys.IndexOf(key);
+				if(index!=-1)
 				{
-					vint32_t count = -1;
-					reader << count;
-					value.Clear();
-					for (vint i = 0; i < count; i++)
+					ValueContainer* target=values[index];
+					target->Remove(value);
+					if(target->Count()==0)
 					{
-						K k;
-						collections::List<V> v;
-						reader << k << v;
-						for (vint j = 0; j < v.Count(); j++)
-						{
-							value.Add(k, v[j]);
-						}
+						RemoveByIndex(index);
 					}
+					return true;
 				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, collections::Group<K, V>& value)
+				else
 				{
-					vint32_t count = (vint32_t)value.Count();
-					writer << count;
-					for (vint i = 0; i < count; i++)
-					{
-						K k = value.Keys()[i];
-						collections::List<V>& v = const_cast<collections::List<V>&>(value.GetByIndex(i));
-						writer << k << v;
-					}
+					return false;
+				}
+			}
+			
+			/// <summary>Remove everything.</summary>
+			/// <returns>Returns true if all keys and values are removed.</returns>
+			bool Clear()
+			{
+				for(vint i=0;i<values.Count();i++)
+				{
+					delete values[i];
 				}
+				keys.Clear();
+				values.Clear();
+				return true;
+			}
+		};
+
+/***********************************************************************
+随机访问
+***********************************************************************/
+		namespace randomaccess_internal
+		{
+			template<typename T, typename K, typename H>
+			struct RandomAccessable<HashSet<T, K, H>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
 			};
 
-			template<>
-			struct Serialization<stream::IStream>
+			template<typename KT, typename VT, typename KK, typename VK, typename KH>
+			struct RandomAccessable<HashDictionary<KT, VT, KK, VK, KH>>
 			{
-				template<typename TContext>
-				static void IO(Reader<TContext>& reader, stream::IStream& value)
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+		
+			template<typename KT, typename VT, typename KK, typename VK, typename KH>
+			struct RandomAccess<HashDictionary<KT, VT, KK, VK, KH>>
+			{
+				static vint GetCount(const HashDictionary<KT, VT, KK, VK, KH>& t)
 				{
-					vint32_t count = 0;
-					reader.input.Read(&count, sizeof(count));
+					return t.Count();
+				}
 
-					if (count > 0)
-					{
-						vint length = 0;
-						collections::Array<vuint8_t> buffer(count);
-						value.SeekFromBegin(0);
-						length = reader.input.Read(&buffer[0], count);
-						if (length != count)
-						{
-							CHECK_FAIL(L"Deserialization failed.");
-						}
-						length = value.Write(&buffer[0], count);
-						if (length != count)
-						{
-							CHECK_FAIL(L"Deserialization failed.");
-						}
-						value.SeekFromBegin(0);
-					}
+				static Pair<KT, VT> GetValue(const HashDictionary<KT, VT, KK, VK, KH>& t, vint index)
+				{
+					return Pair<KT, VT>(t.Keys().Get(index), t.Values().Get(index));
 				}
-					
-				template<typename TContext>
-				static void IO(Writer<TContext>& writer, stream::IStream& value)
+
+				static void AppendValue(HashDictionary<KT, VT, KK, VK, KH>& t, const Pair<KT, VT>& value)
 				{
-					vint32_t count = (vint32_t)value.Size();
-					writer.output.Write(&count, sizeof(count));
+					t.Set(value.key, value.value);
+				}
+			};
+		}
+	}
+}
 
-					if (count > 0)
-					{
-						vint length = 0;
-						collections::Array<vuint8_t> buffer(count);
-						value.SeekFromBegin(0);
-						length = value.Read(&buffer[0], count);
-						if (length != count)
-						{
-							CHECK_FAIL(L"Serialization failed.");
-						}
-						length = writer.output.Write(&buffer[0], count);
-						if (length != count)
-						{
-							CHECK_FAIL(L"Serialization failed.");
-						}
-						value.SeekFromBegin(0);
-					}
-				}
-			};
+#endif
 
-			//---------------------------------------------
+/***********************************************************************
+STREAM\INTERFACES.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Stream::Interfaces
 
-#define BEGIN_SERIALIZATION(TYPE)\
-				template<>\
-				struct Serialization<TYPE>\
-				{\
-					template<typename TIO>\
-					static void IO(TIO& op, TYPE& value)\
-					{\
-						op\
+Interfaces:
+	IStream							：流
+***********************************************************************/
 
-#define SERIALIZE(FIELD)\
-						<< value.FIELD\
+#ifndef VCZH_STREAM_INTERFACES
+#define VCZH_STREAM_INTERFACES
 
-#define END_SERIALIZATION\
-						;\
-					}\
-				};\
 
-#define SERIALIZE_ENUM(TYPE)\
-			template<>\
-			struct Serialization<TYPE>\
-			{\
-				template<typename TContext>\
-				static void IO(Reader<TContext>& reader, TYPE& value)\
-				{\
-					vint32_t v = 0;\
-					Serialization<vint32_t>::IO(reader, v);\
-					value = (TYPE)v;\
-				}\
-				template<typename TContext>\
-				static void IO(Writer<TContext>& writer, TYPE& value)\
-				{\
-					vint32_t v = (vint32_t)value;\
-					Serialization<vint32_t>::IO(writer, v);\
-				}\
-			};\
+namespace vl
+{
+	namespace stream
+	{
+		/// <summary>
+		/// Interface for streams. Stream functions are grouped into 5 categories:
+		/// 1) Feature testing functions.
+		/// 2) Read functions, available only if [M:vl.stream.IStream.CanRead] returns true.
+		/// 3) Peek functions, available only if [M:vl.stream.IStream.CanPeek] returns true.
+		/// 4) Write functions, available only if [M:vl.stream.IStream.CanWrite] returns true.
+		/// 5) Seek functions, available only if [M:vl.stream.IStream.CanSeek] returns true.
+		/// 6) Size functions, available only if [M:vl.stream.IStream.IsLimited] returns true. But there are still some streams knows that the content is limited, but the size is unknown. In this case, [M:vl.stream.IStream.Size] will return -1.
+		/// </summary>
+		class IStream : public virtual Interface
+		{
+		public:
+			/// <summary>Test if the stream is readable.</summary>
+			/// <returns>Returns true if the stream is readable.</returns>
+			virtual bool					CanRead()const=0;
+			/// <summary>Test if the stream is writable.</summary>
+			/// <returns>Returns true if the stream is writable.</returns>
+			virtual bool					CanWrite()const=0;
+			/// <summary>Test if the stream is seekable.</summary>
+			/// <returns>Returns true if the stream is seekable.</returns>
+			virtual bool					CanSeek()const=0;
+			/// <summary>Test if the stream is peekable.</summary>
+			/// <returns>Returns true if the stream is peekable.</returns>
+			virtual bool					CanPeek()const=0;
+			/// <summary>Test if the content of the stream is limited. A writable stream can also be limited, it means that you can only write a limited content to the stream.</summary>
+			/// <returns>Returns true if the content of the stream is limited.</returns>
+			virtual bool					IsLimited()const=0;
+			/// <summary>Test if the stream is available. For example, if you create a readable [T:vl.stream.FileStream] giving a wrong file name, it will be unavailable.</summary>
+			/// <returns>Returns true if the stream is available.</returns>
+			virtual bool					IsAvailable()const=0;
+			/// <summary>Close the stream.</summary>
+			virtual void					Close()=0;
+			/// <summary>Get the current position in the stream.</summary>
+			/// <returns>The position in the stream. Returns -1 if the stream is not available.</returns>
+			virtual pos_t					Position()const=0;
+			/// <summary>Get the size of the content..</summary>
+			/// <returns>The size of the content. Returns -1 if the size is unknown or the stream is not available.</returns>
+			virtual pos_t					Size()const=0;
+			/// <summary>Step forward or backward from the current position. Will throw exception if the stream is not seekable or not available.</summary>
+			/// <param name="_size">The length of the step.</param>
+			virtual void					Seek(pos_t _size)=0;
+			/// <summary>Step fowward from the beginning. Will throw exception if the stream is not seekable or not available.</summary>
+			/// <param name="_size">The length of the step.</param>
+			virtual void					SeekFromBegin(pos_t _size)=0;
+			/// <summary>Step backward from the end. Will throw exception if the stream is not seekable or not available.</summary>
+			/// <param name="_size">The length of the step.</param>
+			virtual void					SeekFromEnd(pos_t _size)=0;
+			/// <summary>Read from the current position and step forward. Will throw exception if the stream is not readable or not available.</summary>
+			/// <returns>Returns the actual size of the content that is read. Returns 0 indicates that the stream reaches the end if the stream is limited.</returns>
+			/// <param name="_buffer">A buffer to store the content.</param>
+			/// <param name="_size">The size of the content that is expected to read.</param>
+			virtual vint					Read(void* _buffer, vint _size)=0;
+			/// <summary>Write to the current position and step forward. Will throw exception if the stream is not writable or not available.</summary>
+			/// <returns>Returns the actual size of the content that is written. Returns 0 indicates that the stream reaches the end if the stream is limited.</returns>
+			/// <param name="_buffer">A buffer storing the content to write.</param>
+			/// <param name="_size">The size of the content that is expected to write.</param>
+			virtual vint					Write(void* _buffer, vint _size)=0;
+			/// <summary>Read from the current position but not step forward. Will throw exception if the stream is not peekable or not available.</summary>
+			/// <returns>Returns the actual size of the content that is read. Returns 0 indicates that the stream reaches the end if the stream is limited.</returns>
+			/// <param name="_buffer">A buffer to store the content.</param>
+			/// <param name="_size">The size of the content that is expected to peek.</param>
+			virtual vint					Peek(void* _buffer, vint _size)=0;
+		};
 
-		}
+		/// <summary>Encoder interface. This interface defines a writable transformation from one stream to another stream. You can create a [T:vl.stream.EncoderStream] after you have an encoder.</summary>
+		class IEncoder : public Interface
+		{
+		public:
+			/// <summary>Set a target writable stream. The <see cref="Write"/> function will transform the content and write to this tream.</summary>
+			/// <param name="_stream">The target writable stream.</param>
+			virtual void					Setup(IStream* _stream)=0;
+			/// <summary>Stop the transformation, ensuring all written content is transformed to the target stream.</summary>
+			virtual	void					Close()=0;
+			/// <summary>Transform content and write to the target stream. This function may cache something to increase performance, so it cannot expect that all transformed content will be written to the target stream immediately.</summary>
+			/// <returns>Returns the actual size of the content before transforming that is written. The content is treated as being written even it is cached and not actually write to the target stream.</returns>
+			/// <param name="_buffer">A buffer storing the content to write.</param>
+			/// <param name="_size">The size of the content that is expected to write.</param>
+			virtual vint					Write(void* _buffer, vint _size)=0;
+		};
+		
+		/// <summary>Decoder interface. This interface defines a readable transformation from one stream to another stream. You can create a [T:vl.stream.DecoderStream] after you have an decoder.</summary>
+		class IDecoder : public Interface
+		{
+		public:
+			/// <summary>Set a target readable stream. The <see cref="Read"/> function will read from this tream and transform the content.</summary>
+			/// <param name="_stream">The target readable stream.</param>
+			virtual void					Setup(IStream* _stream)=0;
+			/// <summary>Stop the transformation.</summary>
+			virtual	void					Close()=0;
+			/// <summary>Read from the target stream and transform the content.</summary>
+			/// <returns>Returns the actual size of the content after transforming that is read.</returns>
+			/// <param name="_buffer">A buffer to store the content.</param>
+			/// <param name="_size">The size of the content that is expected to read.</param>
+			virtual vint					Read(void* _buffer, vint _size)=0;
+		};
 	}
 }
 
 #endif
 
 /***********************************************************************
-COLLECTIONS\OPERATIONCOPYFROM.H
+STREAM\MEMORYSTREAM.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
-Data Structure::Operations
+Stream::MemoryStream
 
+Interfaces:
+	MemoryStream					：内存流
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_OPERATIONCOPYFROM
-#define VCZH_COLLECTIONS_OPERATIONCOPYFROM
+#ifndef VCZH_STREAM_MEMORYSTREAM
+#define VCZH_STREAM_MEMORYSTREAM
 
 
 namespace vl
 {
-	namespace collections
+	namespace stream
 	{
+		/// <summary>A readable, writable, seekable and peekable stream that stores everything in memory.</summary>
+		class MemoryStream : public Object, public virtual IStream
+		{
+		protected:
+			vint					block;
+			char*					buffer;
+			vint					size;
+			vint					position;
+			vint					capacity;
+
+			void					PrepareSpace(vint totalSpace);
+		public:
+			/// <summary>Create a stream.</summary>
+			/// <param name="_block">Size for each allocation. The stream will only allocate new memory of size "_block" when it reaches the end and has to extend.</param>
+			MemoryStream(vint _block=65536);
+			~MemoryStream();
+
+			bool					CanRead()const;
+			bool					CanWrite()const;
+			bool					CanSeek()const;
+			bool					CanPeek()const;
+			bool					IsLimited()const;
+			bool					IsAvailable()const;
+			void					Close();
+			pos_t					Position()const;
+			pos_t					Size()const;
+			void					Seek(pos_t _size);
+			void					SeekFromBegin(pos_t _size);
+			void					SeekFromEnd(pos_t _size);
+			vint					Read(void* _buffer, vint _size);
+			vint					Write(void* _buffer, vint _size);
+			vint					Peek(void* _buffer, vint _size);
+			void*					GetInternalBuffer();
+		};
+	}
+}
+
+#endif
 
 /***********************************************************************
-容器复制
+STREAM\MEMORYWRAPPERSTREAM.H
 ***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Stream::MemoryWrapperStream
 
-		namespace copyfrom_internal
-		{
-			using namespace randomaccess_internal;
+Interfaces:
+	MemoryWrapperStream				：内存代理流
+***********************************************************************/
 
-			template<typename Ds, typename Ss, bool DsRA, bool SsRA>
-			struct CopyFromAlgorithm
-			{
-			};
+#ifndef VCZH_STREAM_MEMORYWRAPPERSTREAM
+#define VCZH_STREAM_MEMORYWRAPPERSTREAM
 
-			template<typename Ds, typename Ss>
-			struct CopyFromAlgorithm<Ds, Ss, true, true>
-			{
-				static void Perform(Ds& ds, const Ss& ss, bool append)
-				{
-					vint copyCount=RandomAccess<Ss>::GetCount(ss);
-					vint index=(append?RandomAccess<Ds>::GetCount(ds):0);
-					vint resizeCount=index+copyCount;
-					RandomAccess<Ds>::SetCount(ds, resizeCount);
-					for(vint i=0;i<copyCount;i++)
-					{
-						RandomAccess<Ds>::SetValue(ds, index+i, RandomAccess<Ss>::GetValue(ss, i));
-					}
-				}
-			};
 
-			template<typename Ds, typename Ss>
-			struct CopyFromAlgorithm<Ds, Ss, false, true>
-			{
-				static void Perform(Ds& ds, const Ss& ss, bool append)
-				{
-					if(!append)
-					{
-						ds.Clear();
-					}
-					vint copyCount=RandomAccess<Ss>::GetCount(ss);
-					for(vint i=0;i<copyCount;i++)
-					{
-						RandomAccess<Ds>::AppendValue(ds, RandomAccess<Ss>::GetValue(ss, i));
-					}
-				}
-			};
-
-			template<typename Ds, typename Ss>
-			struct CopyFromAlgorithm<Ds, Ss, true, false>
-			{
-				static void Perform(Ds& ds, const Ss& ss, bool append)
-				{
-					Ptr<IEnumerator<typename Ss::ElementType>> enumerator;
-					vint copyCount=0;
-
-					enumerator=ss.CreateEnumerator();
-					while(enumerator->Next())
-					{
-						copyCount++;
-					}
-
-					vint index=(append?RandomAccess<Ds>::GetCount(ds):0);
-					vint resizeCount=index+copyCount;
-					RandomAccess<Ds>::SetCount(ds, resizeCount);
-
-					enumerator=ss.CreateEnumerator();
-					while(enumerator->Next())
-					{
-						RandomAccess<Ds>::SetValue(ds, index++, enumerator->Current());
-					}
-				}
-			};
-
-			template<typename Ds, typename Ss>
-			struct CopyFromAlgorithm<Ds, Ss, false, false>
-			{
-				static void Perform(Ds& ds, const Ss& ss, bool append)
-				{
-					if(!append)
-					{
-						ds.Clear();
-					}
-					Ptr<IEnumerator<typename Ss::ElementType>> enumerator=ss.CreateEnumerator();
-					while(enumerator->Next())
-					{
-						RandomAccess<Ds>::AppendValue(ds, enumerator->Current());
-					}
-				}
-			};
-
-			template<typename T>
-			struct Slice
-			{
-				const T*	items;
-				vint		count;
-			};
-		}
-
-		namespace randomaccess_internal
+namespace vl
+{
+	namespace stream
+	{
+		/// <summary>A readable, writable, seekable and peekable stream that operates a buffer.</summary>
+		class MemoryWrapperStream : public Object, public virtual IStream
 		{
-			template<typename T>
-			struct RandomAccessable<copyfrom_internal::Slice<T>>
-			{
-				static const bool							CanRead = true;
-				static const bool							CanResize = true;
-			};
-		
-			template<typename T>
-			struct RandomAccess<copyfrom_internal::Slice<T>>
-			{
-				static vint GetCount(const copyfrom_internal::Slice<T>& t)
-				{
-					return t.count;
-				}
-
-				static const T& GetValue(const copyfrom_internal::Slice<T>& t, vint index)
-				{
-					return t.items[index];
-				}
-			};
-		}
+		protected:
+			char*					buffer;
+			vint						size;
+			vint						position;
+		public:
+			/// <summary>Create a stream.</summary>
+			/// <param name="_buffer">The buffer to operate.</param>
+			/// <param name="_size">Size of the buffer.</param>
+			MemoryWrapperStream(void* _buffer, vint _size);
+			~MemoryWrapperStream();
 
-		/// <summary>Copy containers.</summary>
-		/// <typeparam name="Ds">Type of the destination container.</typeparam>
-		/// <typeparam name="Ss">Type of the source container.</typeparam>
-		/// <param name="ds">The destination container.</param>
-		/// <param name="ss">The source container.</param>
-		/// <param name="append">Set to false to delete everything in the destination container before copying.</param>
-		template<typename Ds, typename Ss>
-		void CopyFrom(Ds& ds, const Ss& ss, bool append=false)
-		{
-			copyfrom_internal::CopyFromAlgorithm<Ds, Ss, randomaccess_internal::RandomAccessable<Ds>::CanResize, randomaccess_internal::RandomAccessable<Ss>::CanRead>::Perform(ds, ss, append);
-		}
-		
-		/// <summary>Copy containers.</summary>
-		/// <typeparam name="Ds">Type of the destination container.</typeparam>
-		/// <typeparam name="S">Type of the elements in the source container.</typeparam>
-		/// <param name="ds">The destination container.</param>
-		/// <param name="buffer">Pointer to the source array.</param>
-		/// <param name="count">The number of elements to copy.</param>
-		/// <param name="append">Set to false to delete everything in the destination container before copying.</param>
-		template<typename Ds, typename S>
-		void CopyFrom(Ds& ds, const S* buffer, vint count, bool append=false)
-		{
-			copyfrom_internal::Slice<S> slice={buffer, count};
-			CopyFrom(ds, slice, append);
-		}
-		
-		/// <summary>Copy containers.</summary>
-		/// <typeparam name="Ds">Type of the destination container.</typeparam>
-		/// <typeparam name="S">Type of the elements in the source container.</typeparam>
-		/// <param name="ds">The destination container.</param>
-		/// <param name="begin">Pointer to the first element in the source array.</param>
-		/// <param name="end">Pointer to the element after the last element in the source array.</param>
-		/// <param name="append">Set to false to delete everything in the destination container before copying.</param>
-		template<typename Ds, typename S>
-		void CopyFrom(Ds& ds, const S* begin, const S* end, bool append=false)
-		{
-			copyfrom_internal::Slice<S> slice={begin, end-begin};
-			CopyFrom(ds, slice, append);
-		}
+			bool					CanRead()const;
+			bool					CanWrite()const;
+			bool					CanSeek()const;
+			bool					CanPeek()const;
+			bool					IsLimited()const;
+			bool					IsAvailable()const;
+			void					Close();
+			pos_t					Position()const;
+			pos_t					Size()const;
+			void					Seek(pos_t _size);
+			void					SeekFromBegin(pos_t _size);
+			void					SeekFromEnd(pos_t _size);
+			vint					Read(void* _buffer, vint _size);
+			vint					Write(void* _buffer, vint _size);
+			vint					Peek(void* _buffer, vint _size);
+		};
 	}
 }
 
 #endif
 
 /***********************************************************************
-COLLECTIONS\OPERATIONENUMERABLE.H
+STREAM\CHARFORMAT.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
-Data Structure::Operations
+Stream::CharFormat
 
+Classes:
+	CharEncoder									：字符串编码器基类
+	CharDecoder									：字符串解码器基类
+	MbcsEncoder									：Mbcs编码器
+	MbcsDecoder									：Mbcs解码器
+	Utf16Encoder								：Utf16编码器
+	Utf16Decoder								：Utf16解码器
+	Utf16BEEncoder								：Utf16 Big Endian编码器
+	Utf16BEDecoder								：Utf16 Big Endian解码器
+	Utf8Encoder									：Utf8编码器
+	Utf8Decoder									：Utf8解码器
+	BomEncoder									：BOM相关编码器
+	BomDecoder									：BOM相关解码器
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_OPERATIONENUMERABLE
-#define VCZH_COLLECTIONS_OPERATIONENUMERABLE
+#ifndef VCZH_STREAM_CHARFORMAT
+#define VCZH_STREAM_CHARFORMAT
 
 
 namespace vl
 {
-	namespace collections
+	namespace stream
 	{
 
+		/*编码资料
+		UCS-4和UTF-8的对应关系:
+		U-00000000 - U-0000007F:  0xxxxxxx
+		U-00000080 - U-000007FF:  110xxxxx 10xxxxxx
+		U-00000800 - U-0000FFFF:  1110xxxx 10xxxxxx 10xxxxxx
+		U-00010000 - U-001FFFFF:  11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+		U-00200000 - U-03FFFFFF:  111110xx 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx
+		U-04000000 - U-7FFFFFFF:  1111110x 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx
+		BOM:
+		FFFE	=Unicode			(vceUtf16)
+		FEFF	=Unicode Big Endian	(vceUtf16_be)
+		EFBBBF	=UTF-8				(vceUtf8)
+		other	=MBCS(GBK)			(vceMbcs)
+		*/
+
 /***********************************************************************
-空迭代器
+字符串编码解码基类
 ***********************************************************************/
 
-		template<typename T>
-		class EmptyEnumerable : public Object, public IEnumerable<T>
+		/// <summary>Base type of all character encoder.</summary>
+		class CharEncoder : public Object, public IEncoder
 		{
-		private:
-			class Enumerator : public Object, public virtual IEnumerator<T>
-			{
-				IEnumerator<T>* Clone()const override
-				{
-					return new Enumerator;
-				}
-
-				const T& Current()const override
-				{
-					return *(T*)0;
-				}
-
-				vint Index()const override
-				{
-					return -1;
-				}
+		protected:
+			IStream*						stream;
+			vuint8_t						cacheBuffer[sizeof(wchar_t)];
+			vint							cacheSize;
 
-				bool Next()override
-				{
-					return false;
-				}
+			virtual vint					WriteString(wchar_t* _buffer, vint chars)=0;
+		public:
+			CharEncoder();
 
-				void Reset()override
-				{
-				}
+			void							Setup(IStream* _stream);
+			void							Close();
+			vint							Write(void* _buffer, vint _size);
+		};
+		
+		/// <summary>Base type of all character decoder.</summary>
+		class CharDecoder : public Object, public IDecoder
+		{
+		protected:
+			IStream*						stream;
+			vuint8_t						cacheBuffer[sizeof(wchar_t)];
+			vint							cacheSize;
 
-				bool Evaluated()const override
-				{
-					return true;
-				}
-			};
+			virtual vint					ReadString(wchar_t* _buffer, vint chars)=0;
 		public:
-			IEnumerator<T>* CreateEnumerator()const
-			{
-				return new Enumerator;
-			}
+			CharDecoder();
+
+			void							Setup(IStream* _stream);
+			void							Close();
+			vint							Read(void* _buffer, vint _size);
 		};
 
 /***********************************************************************
-递增数组迭代器
+Mbcs
 ***********************************************************************/
-
-		template<typename T>
-		class RangeEnumerator : public Object, public virtual IEnumerator<T>
+		
+		/// <summary>Encoder to transform text in a local code page from wchar_t.</summary>
+		class MbcsEncoder : public CharEncoder
 		{
 		protected:
-			T			start;
-			T			count;
-			T			current;
-		public:
-			RangeEnumerator(T _start, T _count, T _current)
-				:start(_start)
-				,count(_count)
-				,current(_current)
-			{
-			}
-
-			RangeEnumerator(T _start, T _count)
-				:start(_start)
-				,count(_count)
-				,current(_start-1)
-			{
-			}
-
-			IEnumerator<T>* Clone()const override
-			{
-				return new RangeEnumerator(start, count, current);
-			}
-
-			const T& Current()const override
-			{
-				return current;
-			}
-
-			T Index()const override
-			{
-				return current-start;
-			}
-
-			bool Next()override
-			{
-				if(start-1<=current && current<start+count-1)
-				{
-					current++;
-					return true;
-				}
-				else
-				{
-					return false;
-				}
-			}
-
-			void Reset()override
-			{
-				current=start-1;
-			}
+			vint							WriteString(wchar_t* _buffer, vint chars);
+		};
+		
+		/// <summary>Encoder to transform text in a local code page to wchar_t.</summary>
+		class MbcsDecoder : public CharDecoder
+		{
+		protected:
+			vint							ReadString(wchar_t* _buffer, vint chars);
+		};
 
-			bool Evaluated()const override
-			{
-				return true;
-			}
+/***********************************************************************
+Utf-16
+***********************************************************************/
+		
+		/// <summary>Encoder to transform UTF-16 text from wchar_t.</summary>
+		class Utf16Encoder : public CharEncoder
+		{
+		protected:
+			vint							WriteString(wchar_t* _buffer, vint chars);
+		};
+		
+		/// <summary>Decoder to transform UTF-16 text to wchar_t.</summary>
+		class Utf16Decoder : public CharDecoder
+		{
+		protected:
+			vint							ReadString(wchar_t* _buffer, vint chars);
 		};
 
 /***********************************************************************
-自包含迭代器
+Utf-16-be
 ***********************************************************************/
+		
+		/// <summary>Encoder to transform big endian UTF-16 text from wchar_t.</summary>
+		class Utf16BEEncoder : public CharEncoder
+		{
+		protected:
+			vint							WriteString(wchar_t* _buffer, vint chars);
+		};
+		
+		/// <summary>Decoder to transform big endian UTF-16 text to wchar_t.</summary>
+		class Utf16BEDecoder : public CharDecoder
+		{
+		protected:
+			vint							ReadString(wchar_t* _buffer, vint chars);
+		};
 
-		template<typename T, typename TContainer>
-		class ContainerEnumerator : public Object, public virtual IEnumerator<T>
+/***********************************************************************
+Utf-8
+***********************************************************************/
+		
+		/// <summary>Encoder to transform UTF-8 text from wchar_t.</summary>
+		class Utf8Encoder : public CharEncoder
 		{
-		private:
-			Ptr<TContainer>					container;
-			vint							index;
+		protected:
+			vint							WriteString(wchar_t* _buffer, vint chars);
+		};
+		
+		/// <summary>Decoder to transform UTF-8 text to wchar_t.</summary>
+		class Utf8Decoder : public CharDecoder
+		{
+		protected:
+#if defined VCZH_MSVC
+			wchar_t							cache;
+			bool							cacheAvailable;
+#endif
+			vint							ReadString(wchar_t* _buffer, vint chars);
+		public:
+			Utf8Decoder();
+		};
 
+/***********************************************************************
+Bom
+***********************************************************************/
+		
+		/// <summary>Encoder to transform text from wchar_t. A BOM will be added at the beginning.</summary>
+		class BomEncoder : public Object, public IEncoder
+		{
 		public:
-			ContainerEnumerator(Ptr<TContainer> _container, vint _index=-1)
+			/// <summary>Text encoding.</summary>
+			enum Encoding
 			{
-				container=_container;
-				index=_index;
-			}
+				/// <summary>Multi-bytes character string.</summary>
+				Mbcs,
+				/// <summary>UTF-8.</summary>
+				Utf8,
+				/// <summary>UTF-16.</summary>
+				Utf16,
+				/// <summary>Big endian UTF-16.</summary>
+				Utf16BE
+			};
+		protected:
+			Encoding						encoding;
+			IEncoder*						encoder;
+		public:
+			/// <summary>Create an encoder.</summary>
+			/// <param name="_encoding">Specified encoding.</param>
+			BomEncoder(Encoding _encoding);
+			~BomEncoder();
 
-			IEnumerator<T>* Clone()const override
+			void							Setup(IStream* _stream);
+			void							Close();
+			vint							Write(void* _buffer, vint _size);
+		};
+		
+		/// <summary>Decoder to transform text to wchar_t. This decoder depends on the BOM information at the beginning to decide the format of the input.</summary>
+		class BomDecoder : public Object, public IDecoder
+		{
+		private:
+			class BomStream : public Object, public IStream
 			{
-				return new ContainerEnumerator(container, index);
-			}
+			protected:
+				IStream*					stream;
+				char						bom[3];
+				vint						bomLength;
+				vint						bomPosition;
+			public:
+				BomStream(IStream* _stream, char* _bom, vint _bomLength);
 
-			const T& Current()const override
-			{
-				return container->Get(index);
-			}
+				bool						CanRead()const;
+				bool						CanWrite()const;
+				bool						CanSeek()const;
+				bool						CanPeek()const;
+				bool						IsLimited()const;
+				bool						IsAvailable()const;
+				void						Close();
+				pos_t						Position()const;
+				pos_t						Size()const;
+				void						Seek(pos_t _size);
+				void						SeekFromBegin(pos_t _size);
+				void						SeekFromEnd(pos_t _size);
+				vint						Read(void* _buffer, vint _size);
+				vint						Write(void* _buffer, vint _size);
+				vint						Peek(void* _buffer, vint _size);
+			};
+		protected:
+			IDecoder*						decoder;
+			IStream*						stream;
 
-			vint Index()const override
-			{
-				return index;
-			}
+		public:
+			/// <summary>Create an decoder.</summary>
+			BomDecoder();
+			~BomDecoder();
 
-			bool Next()override
-			{
-				index++;
-				return index>=0 && index<container->Count();
-			}
+			void							Setup(IStream* _stream);
+			void							Close();
+			vint							Read(void* _buffer, vint _size);
+		};
 
-			void Reset()override
-			{
-				index=-1;
-			}
+/***********************************************************************
+Encoding Test
+***********************************************************************/
 
-			bool Evaluated()const override
-			{
-				return true;
-			}
-		};
+		/// <summary>Guess the text encoding in a buffer.</summary>
+		/// <param name="buffer">The buffer to guess.</param>
+		/// <param name="size">Size of the buffer in bytes.</param>
+		/// <param name="encoding">Returns the most possible encoding.</param>
+		/// <param name="containsBom">Returns true if the BOM information is at the beginning of the buffer.</param>
+		extern void							TestEncoding(unsigned char* buffer, vint size, BomEncoder::Encoding& encoding, bool& containsBom);
 
 /***********************************************************************
-迭代器比较
+Serialization
 ***********************************************************************/
 
-		template<typename T, typename U>
-		vint CompareEnumerable(const IEnumerable<T>& a, const IEnumerable<U>& b)
+		namespace internal
 		{
-			Ptr<IEnumerator<T>> ator=a.CreateEnumerator();
-			Ptr<IEnumerator<U>> btor=b.CreateEnumerator();
-			while(true)
+			template<typename T>
+			struct Reader
 			{
-				bool a=ator->Next();
-				bool b=btor->Next();
-				if(a&&!b) return 1;
-				if(!a&&b) return -1;
-				if(!a&&!b) break;
+				stream::IStream&			input;
+				T							context;
 
-				const T& ac=ator->Current();
-				const U& bc=btor->Current();
-				if(ac<bc)
+				Reader(stream::IStream& _input)
+					:input(_input)
+					, context(nullptr)
 				{
-					return -1;
 				}
-				else if(ac>bc)
-				{
-					return 1;
-				}
-				ator->Next();
-				btor->Next();
-			}
-			return 0;
-		}
-
-		template<typename T>
-		struct SortedListOperations
-		{
-			static bool Contains(const SortedList<T>& items, const T& item)
-			{
-				return items.Contains(item);
-			}
-		};
-
-		template<typename T>
-		struct SortedListOperations<Ptr<T>>
-		{
-			static bool Contains(const SortedList<Ptr<T>>& items, const Ptr<T>& item)
+			};
+				
+			template<typename T>
+			struct Writer
 			{
-				return items.Contains(item.Obj());
-			}
-		};
-	}
-}
-
-#endif
-
-/***********************************************************************
-COLLECTIONS\OPERATIONSELECT.H
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Data Structure::Operations
-
-***********************************************************************/
-
-#ifndef VCZH_COLLECTIONS_OPERATIONSELECT
-#define VCZH_COLLECTIONS_OPERATIONSELECT
-
-
-namespace vl
-{
-	namespace collections
-	{
+				stream::IStream&			output;
+				T							context;
 
-/***********************************************************************
-Select
-***********************************************************************/
+				Writer(stream::IStream& _output)
+					:output(_output)
+					, context(nullptr)
+				{
+				}
+			};
 
-		template<typename T, typename K>
-		class SelectEnumerator : public virtual IEnumerator<K>
-		{
-		protected:
-			IEnumerator<T>*		enumerator;
-			Func<K(T)>			selector;
-			K					current;
-		public:
-			SelectEnumerator(IEnumerator<T>* _enumerator, const Func<K(T)>& _selector, K _current=K())
-				:enumerator(_enumerator)
-				,selector(_selector)
-				,current(_current)
-			{
-			}
+			using ContextFreeReader = Reader<void*>;
+			using ContextFreeWriter = Writer<void*>;
 
-			~SelectEnumerator()
+			template<typename T>
+			struct Serialization
 			{
-				delete enumerator;
-			}
+				template<typename TIO>
+				static void IO(TIO& io, T& value);
+			};
 
-			IEnumerator<K>* Clone()const override
+			template<typename TValue, typename TContext>
+			Reader<TContext>& operator<<(Reader<TContext>& reader, TValue& value)
 			{
-				return new SelectEnumerator(enumerator->Clone(), selector, current);
+				Serialization<TValue>::IO(reader, value);
+				return reader;
 			}
 
-			const K& Current()const override
+			template<typename TValue, typename TContext>
+			Writer<TContext>& operator<<(Writer<TContext>& writer, TValue& value)
 			{
-				return current;
+				Serialization<TValue>::IO(writer, value);
+				return writer;
 			}
 
-			vint Index()const override
-			{
-				return enumerator->Index();
-			}
+			//---------------------------------------------
 
-			bool Next()override
+			template<>
+			struct Serialization<vint64_t>
 			{
-				if(enumerator->Next())
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, vint64_t& value)
 				{
-					current=selector(enumerator->Current());
-					return true;
+					if (reader.input.Read(&value, sizeof(value)) != sizeof(value))
+					{
+						CHECK_FAIL(L"Deserialization failed.");
+					}
 				}
-				else
+				
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, vint64_t& value)
 				{
-					return false;
+					if (writer.output.Write(&value, sizeof(value)) != sizeof(value))
+					{
+						CHECK_FAIL(L"Serialization failed.");
+					}
 				}
-			}
-
-			void Reset()override
-			{
-				enumerator->Reset();
-			}
-		};
-	}
-}
-
-#endif
-
-/***********************************************************************
-COLLECTIONS\OPERATIONWHERE.H
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Data Structure::Operations
-
-***********************************************************************/
-
-#ifndef VCZH_COLLECTIONS_OPERATIONWHERE
-#define VCZH_COLLECTIONS_OPERATIONWHERE
-
-
-namespace vl
-{
-	namespace collections
-	{
-/***********************************************************************
-Where
-***********************************************************************/
-
-		template<typename T>
-		class WhereEnumerator : public virtual IEnumerator<T>
-		{
-		protected:
-			IEnumerator<T>*			enumerator;
-			Func<bool(T)>			selector;
-			vint					index;
-
-		public:
-			WhereEnumerator(IEnumerator<T>* _enumerator, const Func<bool(T)>& _selector, vint _index=-1)
-				:enumerator(_enumerator)
-				,selector(_selector)
-				,index(_index)
-			{
-			}
-
-			~WhereEnumerator()
-			{
-				delete enumerator;
-			}
-
-			IEnumerator<T>* Clone()const override
-			{
-				return new WhereEnumerator(enumerator->Clone(), selector, index);
-			}
-
-			const T& Current()const override
-			{
-				return enumerator->Current();
-			}
+			};
 
-			vint Index()const override
+			template<>
+			struct Serialization<vint32_t>
 			{
-				return index;
-			}
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, vint32_t& value)
+				{
+					vint64_t v = 0;
+					Serialization<vint64_t>::IO(reader, v);
+					value = (vint32_t)v;
+				}
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, vint32_t& value)
+				{
+					vint64_t v = (vint64_t)value;
+					Serialization<vint64_t>::IO(writer, v);
+				}
+			};
 
-			bool Next()override
+			template<>
+			struct Serialization<bool>
 			{
-				while(enumerator->Next())
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, bool& value)
 				{
-					if(selector(enumerator->Current()))
+					vint8_t v = 0;
+					if (reader.input.Read(&v, sizeof(v)) != sizeof(v))
 					{
-						index++;
-						return true;
+						CHECK_FAIL(L"Deserialization failed.");
+					}
+					else
+					{
+						value = v == -1;
 					}
 				}
-				return false;
-			}
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, bool& value)
+				{
+					vint8_t v = value ? -1 : 0;
+					if (writer.output.Write(&v, sizeof(v)) != sizeof(v))
+					{
+						CHECK_FAIL(L"Serialization failed.");
+					}
+				}
+			};
 
-			void Reset()override
+			template<typename T>
+			struct Serialization<Ptr<T>>
 			{
-				enumerator->Reset();
-				index=-1;
-			}
-		};
-	}
-}
-
-#endif
-
-/***********************************************************************
-COLLECTIONS\OPERATIONCONCAT.H
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Data Structure::Operations
-
-***********************************************************************/
-
-#ifndef VCZH_COLLECTIONS_OPERATIONCONCAT
-#define VCZH_COLLECTIONS_OPERATIONCONCAT
-
-
-namespace vl
-{
-	namespace collections
-	{
-
-/***********************************************************************
-Concat
-***********************************************************************/
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, Ptr<T>& value)
+				{
+					bool notNull = false;
+					reader << notNull;
+					if (notNull)
+					{
+						value = new T;
+						Serialization<T>::IO(reader, *value.Obj());
+					}
+					else
+					{
+						value = 0;
+					}
+				}
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, Ptr<T>& value)
+				{
+					bool notNull = value;
+					writer << notNull;
+					if (notNull)
+					{
+						Serialization<T>::IO(writer, *value.Obj());
+					}
+				}
+			};
 
-		template<typename T>
-		class ConcatEnumerator : public virtual IEnumerator<T>
-		{
-		protected:
-			IEnumerator<T>*					enumerator1;
-			IEnumerator<T>*					enumerator2;
-			vint							index;
-			bool							turned;
-		public:
-			ConcatEnumerator(IEnumerator<T>* _enumerator1, IEnumerator<T>* _enumerator2, vint _index=-1, bool _turned=false)
-				:enumerator1(_enumerator1)
-				,enumerator2(_enumerator2)
-				,index(_index)
-				,turned(_turned)
+			template<typename T>
+			struct Serialization<Nullable<T>>
 			{
-			}
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, Nullable<T>& value)
+				{
+					bool notNull = false;
+					reader << notNull;
+					if (notNull)
+					{
+						T data;
+						Serialization<T>::IO(reader, data);
+						value = Nullable<T>(data);
+					}
+					else
+					{
+						value = Nullable<T>();
+					}
+				}
+				
+				template<typename TContext>	
+				static void IO(Writer<TContext>& writer, Nullable<T>& value)
+				{
+					bool notNull = value;
+					writer << notNull;
+					if (notNull)
+					{
+						T data = value.Value();
+						Serialization<T>::IO(writer, data);
+					}
+				}
+			};
 
-			~ConcatEnumerator()
+			template<>
+			struct Serialization<WString>
 			{
-				delete enumerator1;
-				delete enumerator2;
-			}
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, WString& value)
+				{
+					vint count = -1;
+					reader << count;
+					if (count > 0)
+					{
+						MemoryStream stream;
+						reader << (IStream&)stream;
+						Utf8Decoder decoder;
+						decoder.Setup(&stream);
 
-			IEnumerator<T>* Clone()const override
-			{
-				return new ConcatEnumerator(enumerator1->Clone(), enumerator2->Clone(), index, turned);
-			}
+						collections::Array<wchar_t> stringBuffer(count + 1);
+						vint stringSize = decoder.Read(&stringBuffer[0], count * sizeof(wchar_t));
+						stringBuffer[stringSize / sizeof(wchar_t)] = 0;
 
-			const T& Current()const override
-			{
-				if(turned)
-				{
-					return enumerator2->Current();
+						value = &stringBuffer[0];
+					}
+					else
+					{
+						value = L"";
+					}
 				}
-				else
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, WString& value)
 				{
-					return enumerator1->Current();
+					vint count = value.Length();
+					writer << count;
+					if (count > 0)
+					{
+						MemoryStream stream;
+						{
+							Utf8Encoder encoder;
+							encoder.Setup(&stream);
+							encoder.Write((void*)value.Buffer(), count * sizeof(wchar_t));
+						}
+						writer << (IStream&)stream;
+					}
 				}
-			}
-
-			vint Index()const override
-			{
-				return index;
-			}
+			};
 
-			bool Next()override
+			template<typename T>
+			struct Serialization<collections::List<T>>
 			{
-				index++;
-				if(turned)
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, collections::List<T>& value)
 				{
-					return enumerator2->Next();
+					vint32_t count = -1;
+					reader << count;
+					value.Clear();
+					for (vint i = 0; i < count; i++)
+					{
+						T t;
+						reader << t;
+						value.Add(t);
+					}
 				}
-				else
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, collections::List<T>& value)
 				{
-					if(enumerator1->Next())
+					vint32_t count = (vint32_t)value.Count();
+					writer << count;
+					for (vint i = 0; i < count; i++)
 					{
-						return true;
+						writer << value[i];
 					}
-					else
+				}
+			};
+
+			template<typename T>
+			struct Serialization<collections::Array<T>>
+			{
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, collections::Array<T>& value)
+				{
+					vint32_t count = -1;
+					reader << count;
+					value.Resize(count);
+					for (vint i = 0; i < count; i++)
 					{
-						turned=true;
-						return enumerator2->Next();
+						reader << value[i];
 					}
 				}
-			}
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, collections::Array<T>& value)
+				{
+					vint32_t count = (vint32_t)value.Count();
+					writer << count;
+					for (vint i = 0; i < count; i++)
+					{
+						writer << value[i];
+					}
+				}
+			};
 
-			void Reset()override
+			template<typename K, typename V>
+			struct Serialization<collections::Dictionary<K, V>>
 			{
-				enumerator1->Reset();
-				enumerator2->Reset();
-				index=-1;
-				turned=false;
-			}
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, collections::Dictionary<K, V>& value)
+				{
+					vint32_t count = -1;
+					reader << count;
+					value.Clear();
+					for (vint i = 0; i < count; i++)
+					{
+						K k;
+						V v;
+						reader << k << v;
+						value.Add(k, v);
+					}
+				}
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, collections::Dictionary<K, V>& value)
+				{
+					vint32_t count = (vint32_t)value.Count();
+					writer << count;
+					for (vint i = 0; i < count; i++)
+					{
+						K k = value.Keys()[i];
+						V v = value.Values()[i];
+						writer << k << v;
+					}
+				}
+			};
 
-			bool Evaluated()const override
+			template<typename K, typename V>
+			struct Serialization<collections::Group<K, V>>
 			{
-				return enumerator1->Evaluated() && enumerator2->Evaluated();
-			}
-		};
-	}
-}
-
-#endif
-
-/***********************************************************************
-COLLECTIONS\OPERATIONSEQUENCE.H
-***********************************************************************/
-/***********************************************************************
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, collections::Group<K, V>& value)
+				{
+					vint32_t count = -1;
+					reader << count;
+					value.Clear();
+					for (vint i = 0; i < count; i++)
+					{
+						K k;
+						collections::List<V> v;
+						reader << k << v;
+						for (vint j = 0; j < v.Count(); j++)
+						{
+							value.Add(k, v[j]);
+						}
+					}
+				}
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, collections::Group<K, V>& value)
+				{
+					vint32_t count = (vint32_t)value.Count();
+					writer << count;
+					for (vint i = 0; i < count; i++)
+					{
+						K k = value.Keys()[i];
+						collections::List<V>& v = const_cast<collections::List<V>&>(value.GetByIndex(i));
+						writer << k << v;
+					}
+				}
+			};
+
+			template<>
+			struct Serialization<stream::IStream>
+			{
+				template<typename TContext>
+				static void IO(Reader<TContext>& reader, stream::IStream& value)
+				{
+					vint32_t count = 0;
+					reader.input.Read(&count, sizeof(count));
+
+					if (count > 0)
+					{
+						vint length = 0;
+						collections::Array<vuint8_t> buffer(count);
+						value.SeekFromBegin(0);
+						length = reader.input.Read(&buffer[0], count);
+						if (length != count)
+						{
+							CHECK_FAIL(L"Deserialization failed.");
+						}
+						length = value.Write(&buffer[0], count);
+						if (length != count)
+						{
+							CHECK_FAIL(L"Deserialization failed.");
+						}
+						value.SeekFromBegin(0);
+					}
+				}
+					
+				template<typename TContext>
+				static void IO(Writer<TContext>& writer, stream::IStream& value)
+				{
+					vint32_t count = (vint32_t)value.Size();
+					writer.output.Write(&count, sizeof(count));
+
+					if (count > 0)
+					{
+						vint length = 0;
+						collections::Array<vuint8_t> buffer(count);
+						value.SeekFromBegin(0);
+						length = value.Read(&buffer[0], count);
+						if (length != count)
+						{
+							CHECK_FAIL(L"Serialization failed.");
+						}
+						length = writer.output.Write(&buffer[0], count);
+						if (length != count)
+						{
+							CHECK_FAIL(L"Serialization failed.");
+						}
+						value.SeekFromBegin(0);
+					}
+				}
+			};
+
+			//---------------------------------------------
+
+#define BEGIN_SERIALIZATION(TYPE)\
+				template<>\
+				struct Serialization<TYPE>\
+				{\
+					template<typename TIO>\
+					static void IO(TIO& op, TYPE& value)\
+					{\
+						op\
+
+#define SERIALIZE(FIELD)\
+						<< value.FIELD\
+
+#define END_SERIALIZATION\
+						;\
+					}\
+				};\
+
+#define SERIALIZE_ENUM(TYPE)\
+			template<>\
+			struct Serialization<TYPE>\
+			{\
+				template<typename TContext>\
+				static void IO(Reader<TContext>& reader, TYPE& value)\
+				{\
+					vint32_t v = 0;\
+					Serialization<vint32_t>::IO(reader, v);\
+					value = (TYPE)v;\
+				}\
+				template<typename TContext>\
+				static void IO(Writer<TContext>& writer, TYPE& value)\
+				{\
+					vint32_t v = (vint32_t)value;\
+					Serialization<vint32_t>::IO(writer, v);\
+				}\
+			};\
+
+		}
+	}
+}
+
+#endif
+
+/***********************************************************************
+COLLECTIONS\OPERATIONCOPYFROM.H
+***********************************************************************/
+/***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
 Data Structure::Operations
 
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_OPERATIONSEQUENCE
-#define VCZH_COLLECTIONS_OPERATIONSEQUENCE
+#ifndef VCZH_COLLECTIONS_OPERATIONCOPYFROM
+#define VCZH_COLLECTIONS_OPERATIONCOPYFROM
 
 
 namespace vl
@@ -5707,308 +5869,337 @@ namespace vl
 	{
 
 /***********************************************************************
-Take
+容器复制
 ***********************************************************************/
 
-		template<typename T>
-		class TakeEnumerator : public virtual IEnumerator<T>
+		namespace copyfrom_internal
 		{
-		protected:
-			IEnumerator<T>*			enumerator;
-			vint					count;
-		public:
-			TakeEnumerator(IEnumerator<T>* _enumerator, vint _count)
-				:enumerator(_enumerator)
-				,count(_count)
-			{
-			}
+			using namespace randomaccess_internal;
 
-			~TakeEnumerator()
+			template<typename Ds, typename Ss, bool DsRA, bool SsRA>
+			struct CopyFromAlgorithm
 			{
-				delete enumerator;
-			}
+			};
 
-			IEnumerator<T>* Clone()const override
+			template<typename Ds, typename Ss>
+			struct CopyFromAlgorithm<Ds, Ss, true, true>
 			{
-				return new TakeEnumerator(enumerator->Clone(), count);
-			}
+				static void Perform(Ds& ds, const Ss& ss, bool append)
+				{
+					vint copyCount=RandomAccess<Ss>::GetCount(ss);
+					vint index=(append?RandomAccess<Ds>::GetCount(ds):0);
+					vint resizeCount=index+copyCount;
+					RandomAccess<Ds>::SetCount(ds, resizeCount);
+					for(vint i=0;i<copyCount;i++)
+					{
+						RandomAccess<Ds>::SetValue(ds, index+i, RandomAccess<Ss>::GetValue(ss, i));
+					}
+				}
+			};
 
-			const T& Current()const override
+			template<typename Ds, typename Ss>
+			struct CopyFromAlgorithm<Ds, Ss, false, true>
 			{
-				return enumerator->Current();
-			}
+				static void Perform(Ds& ds, const Ss& ss, bool append)
+				{
+					if(!append)
+					{
+						ds.Clear();
+					}
+					vint copyCount=RandomAccess<Ss>::GetCount(ss);
+					for(vint i=0;i<copyCount;i++)
+					{
+						RandomAccess<Ds>::AppendValue(ds, RandomAccess<Ss>::GetValue(ss, i));
+					}
+				}
+			};
 
-			vint Index()const override
+			template<typename Ds, typename Ss>
+			struct CopyFromAlgorithm<Ds, Ss, true, false>
 			{
-				return enumerator->Index();
-			}
+				static void Perform(Ds& ds, const Ss& ss, bool append)
+				{
+					Ptr<IEnumerator<typename Ss::ElementType>> enumerator;
+					vint copyCount=0;
 
-			bool Next()override
-			{
-				if(enumerator->Index()>=count-1) return false;
-				return enumerator->Next();
-			}
+					enumerator=ss.CreateEnumerator();
+					while(enumerator->Next())
+					{
+						copyCount++;
+					}
 
-			void Reset()override
+					vint index=(append?RandomAccess<Ds>::GetCount(ds):0);
+					vint resizeCount=index+copyCount;
+					RandomAccess<Ds>::SetCount(ds, resizeCount);
+
+					enumerator=ss.CreateEnumerator();
+					while(enumerator->Next())
+					{
+						RandomAccess<Ds>::SetValue(ds, index++, enumerator->Current());
+					}
+				}
+			};
+
+			template<typename Ds, typename Ss>
+			struct CopyFromAlgorithm<Ds, Ss, false, false>
 			{
-				enumerator->Reset();
-			}
+				static void Perform(Ds& ds, const Ss& ss, bool append)
+				{
+					if(!append)
+					{
+						ds.Clear();
+					}
+					Ptr<IEnumerator<typename Ss::ElementType>> enumerator=ss.CreateEnumerator();
+					while(enumerator->Next())
+					{
+						RandomAccess<Ds>::AppendValue(ds, enumerator->Current());
+					}
+				}
+			};
 
-			bool Evaluated()const override
+			template<typename T>
+			struct Slice
 			{
-				return enumerator->Evaluated();
-			}
-		};
+				const T*	items;
+				vint		count;
+			};
+		}
 
-/***********************************************************************
-Skip
-***********************************************************************/
-
-		template<typename T>
-		class SkipEnumerator : public virtual IEnumerator<T>
+		namespace randomaccess_internal
 		{
-		protected:
-			IEnumerator<T>*			enumerator;
-			vint					count;
-			bool					skipped;
-		public:
-			SkipEnumerator(IEnumerator<T>* _enumerator, vint _count, bool _skipped=false)
-				:enumerator(_enumerator)
-				,count(_count)
-				,skipped(_skipped)
+			template<typename T>
+			struct RandomAccessable<copyfrom_internal::Slice<T>>
 			{
-			}
-
-			~SkipEnumerator()
+				static const bool							CanRead = true;
+				static const bool							CanResize = true;
+			};
+		
+			template<typename T>
+			struct RandomAccess<copyfrom_internal::Slice<T>>
 			{
-				delete enumerator;
-			}
+				static vint GetCount(const copyfrom_internal::Slice<T>& t)
+				{
+					return t.count;
+				}
 
-			IEnumerator<T>* Clone()const override
-			{
-				return new SkipEnumerator(enumerator->Clone(), count, skipped);
-			}
+				static const T& GetValue(const copyfrom_internal::Slice<T>& t, vint index)
+				{
+					return t.items[index];
+				}
+			};
+		}
 
-			const T& Current()const override
-			{
-				return enumerator->Current();
-			}
+		/// <summary>Copy containers.</summary>
+		/// <typeparam name="Ds">Type of the destination container.</typeparam>
+		/// <typeparam name="Ss">Type of the source container.</typeparam>
+		/// <param name="ds">The destination container.</param>
+		/// <param name="ss">The source container.</param>
+		/// <param name="append">Set to false to delete everything in the destination container before copying.</param>
+		template<typename Ds, typename Ss>
+		void CopyFrom(Ds& ds, const Ss& ss, bool append=false)
+		{
+			copyfrom_internal::CopyFromAlgorithm<Ds, Ss, randomaccess_internal::RandomAccessable<Ds>::CanResize, randomaccess_internal::RandomAccessable<Ss>::CanRead>::Perform(ds, ss, append);
+		}
+		
+		/// <summary>Copy containers.</summary>
+		/// <typeparam name="Ds">Type of the destination container.</typeparam>
+		/// <typeparam name="S">Type of the elements in the source container.</typeparam>
+		/// <param name="ds">The destination container.</param>
+		/// <param name="buffer">Pointer to the source array.</param>
+		/// <param name="count">The number of elements to copy.</param>
+		/// <param name="append">Set to false to delete everything in the destination container before copying.</param>
+		template<typename Ds, typename S>
+		void CopyFrom(Ds& ds, const S* buffer, vint count, bool append=false)
+		{
+			copyfrom_internal::Slice<S> slice={buffer, count};
+			CopyFrom(ds, slice, append);
+		}
+		
+		/// <summary>Copy containers.</summary>
+		/// <typeparam name="Ds">Type of the destination container.</typeparam>
+		/// <typeparam name="S">Type of the elements in the source container.</typeparam>
+		/// <param name="ds">The destination container.</param>
+		/// <param name="begin">Pointer to the first element in the source array.</param>
+		/// <param name="end">Pointer to the element after the last element in the source array.</param>
+		/// <param name="append">Set to false to delete everything in the destination container before copying.</param>
+		template<typename Ds, typename S>
+		void CopyFrom(Ds& ds, const S* begin, const S* end, bool append=false)
+		{
+			copyfrom_internal::Slice<S> slice={begin, end-begin};
+			CopyFrom(ds, slice, append);
+		}
+	}
+}
 
-			vint Index()const override
-			{
-				return enumerator->Index()-count;
-			}
+#endif
 
-			bool Next()override
+/***********************************************************************
+COLLECTIONS\OPERATIONENUMERABLE.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Data Structure::Operations
+
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_OPERATIONENUMERABLE
+#define VCZH_COLLECTIONS_OPERATIONENUMERABLE
+
+
+namespace vl
+{
+	namespace collections
+	{
+
+/***********************************************************************
+空迭代器
+***********************************************************************/
+
+		template<typename T>
+		class EmptyEnumerable : public Object, public IEnumerable<T>
+		{
+		private:
+			class Enumerator : public Object, public virtual IEnumerator<T>
 			{
-				if(!skipped)
+				IEnumerator<T>* Clone()const override
 				{
-					skipped=true;
-					for(vint i=0;i<count;i++)
-					{
-						if(!enumerator->Next())
-						{
-							return false;
-						}
-					}
+					return new Enumerator;
 				}
-				return enumerator->Next();
-			}
 
-			void Reset()override
-			{
-				enumerator->Reset();
-				skipped=false;
-			}
+				const T& Current()const override
+				{
+					return *(T*)0;
+				}
 
-			bool Evaluated()const override
+				vint Index()const override
+				{
+					return -1;
+				}
+
+				bool Next()override
+				{
+					return false;
+				}
+
+				void Reset()override
+				{
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+		public:
+			IEnumerator<T>* CreateEnumerator()const
 			{
-				return enumerator->Evaluated();
+				return new Enumerator;
 			}
 		};
 
 /***********************************************************************
-Repeat
+递增数组迭代器
 ***********************************************************************/
 
 		template<typename T>
-		class RepeatEnumerator : public virtual IEnumerator<T>
+		class RangeEnumerator : public Object, public virtual IEnumerator<T>
 		{
 		protected:
-			IEnumerator<T>*			enumerator;
-			vint					count;
-			vint					index;
-			vint					repeatedCount;
+			T			start;
+			T			count;
+			T			current;
 		public:
-			RepeatEnumerator(IEnumerator<T>* _enumerator, vint _count, vint _index=-1, vint _repeatedCount=0)
-				:enumerator(_enumerator)
+			RangeEnumerator(T _start, T _count, T _current)
+				:start(_start)
 				,count(_count)
-				,index(_index)
-				,repeatedCount(_repeatedCount)
+				,current(_current)
 			{
 			}
 
-			~RepeatEnumerator()
+			RangeEnumerator(T _start, T _count)
+				:start(_start)
+				,count(_count)
+				,current(_start-1)
 			{
-				delete enumerator;
 			}
 
 			IEnumerator<T>* Clone()const override
 			{
-				return new RepeatEnumerator(enumerator->Clone(), count, index, repeatedCount);
+				return new RangeEnumerator(start, count, current);
 			}
 
 			const T& Current()const override
 			{
-				return enumerator->Current();
+				return current;
 			}
 
-			vint Index()const override
+			T Index()const override
 			{
-				return index;
+				return current-start;
 			}
 
 			bool Next()override
 			{
-				while(repeatedCount<count)
+				if(start-1<=current && current<start+count-1)
 				{
-					if(enumerator->Next())
-					{
-						index++;
-						return true;
-					}
-					repeatedCount++;
-					enumerator->Reset();
+					current++;
+					return true;
+				}
+				else
+				{
+					return false;
 				}
-				return false;
 			}
 
 			void Reset()override
 			{
-				enumerator->Reset();
-				index=-1;
-				repeatedCount=0;
+				current=start-1;
 			}
 
 			bool Evaluated()const override
 			{
-				return enumerator->Evaluated();
+				return true;
 			}
 		};
 
 /***********************************************************************
-Distinct
+自包含迭代器
 ***********************************************************************/
 
-		template<typename T>
-		class DistinctEnumerator : public virtual IEnumerator<T>
+		template<typename T, typename TContainer>
+		class ContainerEnumerator : public Object, public virtual IEnumerator<T>
 		{
-		protected:
-			IEnumerator<T>*		enumerator;
-			SortedList<T>		distinct;
-			T					lastValue;
+		private:
+			Ptr<TContainer>					container;
+			vint							index;
 
 		public:
-			DistinctEnumerator(IEnumerator<T>* _enumerator)
-				:enumerator(_enumerator)
-			{
-			}
-
-			DistinctEnumerator(const DistinctEnumerator& _enumerator)
-				:lastValue(_enumerator.lastValue)
-			{
-				enumerator=_enumerator.enumerator->Clone();
-				CopyFrom(distinct, _enumerator.distinct);
-			}
-
-			~DistinctEnumerator()
+			ContainerEnumerator(Ptr<TContainer> _container, vint _index=-1)
 			{
-				delete enumerator;
+				container=_container;
+				index=_index;
 			}
 
 			IEnumerator<T>* Clone()const override
 			{
-				return new DistinctEnumerator(*this);
+				return new ContainerEnumerator(container, index);
 			}
 
 			const T& Current()const override
 			{
-				return lastValue;
+				return container->Get(index);
 			}
 
 			vint Index()const override
 			{
-				return distinct.Count()-1;
-			}
-
-			bool Next()override
-			{
-				while(enumerator->Next())
-				{
-					const T& current=enumerator->Current();
-					if(!SortedListOperations<T>::Contains(distinct, current))
-					{
-						lastValue=current;
-						distinct.Add(current);
-						return true;
-					}
-				}
-				return false;
-			}
-
-			void Reset()override
-			{
-				enumerator->Reset();
-				distinct.Clear();
-			}
-		};
-
-/***********************************************************************
-Reverse
-***********************************************************************/
-
-		template<typename T>
-		class ReverseEnumerator : public virtual IEnumerator<T>
-		{
-		protected:
-			List<T>						cache;
-			vint						index;
-		public:
-			ReverseEnumerator(const IEnumerable<T>& enumerable)
-				:index(-1)
-			{
-				CopyFrom(cache, enumerable);
-			}
-
-			ReverseEnumerator(const ReverseEnumerator& _enumerator)
-				:index(_enumerator.index)
-			{
-				CopyFrom(cache, _enumerator.cache);
-			}
-
-			~ReverseEnumerator()
-			{
-			}
-
-			IEnumerator<T>* Clone()const override
-			{
-				return new ReverseEnumerator(*this);
-			}
-
-			const T& Current()const override
-			{
-				return cache.Get(cache.Count()-1-index);
-			}
-
-			vint Index()const override
-			{
-				return index;
+				return index;
 			}
 
 			bool Next()override
 			{
 				index++;
-				return index<cache.Count();
+				return index>=0 && index<container->Count();
 			}
 
 			void Reset()override
@@ -6023,110 +6214,62 @@ Reverse
 		};
 
 /***********************************************************************
-FromIterator
+迭代器比较
 ***********************************************************************/
 
-		template<typename T, typename I>
-		class FromIteratorEnumerable : public Object, public IEnumerable<T>
+		template<typename T, typename U>
+		vint CompareEnumerable(const IEnumerable<T>& a, const IEnumerable<U>& b)
 		{
-		private:
-			class Enumerator : public Object, public IEnumerator<T>
+			Ptr<IEnumerator<T>> ator=a.CreateEnumerator();
+			Ptr<IEnumerator<U>> btor=b.CreateEnumerator();
+			while(true)
 			{
-			private:
-				I				begin;
-				I				end;
-				I				current;
-
-			public:
-				Enumerator(I _begin, I _end, I _current)
-					:begin(_begin)
-					,end(_end)
-					,current(_current)
-				{
-				}
-
-				IEnumerator<T>* Clone()const override
-				{
-					return new Enumerator(begin, end, current);
-				}
-
-				const T& Current()const override
-				{
-					return *current;
-				}
-
-				vint Index()const override
-				{
-					return current-begin;
-				}
-
-				bool Next()override
-				{
-					current++;
-					return begin<=current && current<end;
-				}
+				bool a=ator->Next();
+				bool b=btor->Next();
+				if(a&&!b) return 1;
+				if(!a&&b) return -1;
+				if(!a&&!b) break;
 
-				void Reset()override
+				const T& ac=ator->Current();
+				const U& bc=btor->Current();
+				if(ac<bc)
 				{
-					current=begin-1;
+					return -1;
 				}
-
-				bool Evaluated()const override
+				else if(ac>bc)
 				{
-					return true;
+					return 1;
 				}
-			};
-		private:
-			I					begin;
-			I					end;
-		public:
-			IEnumerator<T>* CreateEnumerator()const
-			{
-				return new Enumerator(begin, end, begin-1);
-			}
-
-			FromIteratorEnumerable(I _begin, I _end)
-				:begin(_begin)
-				,end(_end)
-			{
+				ator->Next();
+				btor->Next();
 			}
+			return 0;
+		}
 
-			FromIteratorEnumerable(const FromIteratorEnumerable<T, I>& enumerable)
-				:begin(enumerable.begin)
-				,end(enumerable.end)
+		template<typename T>
+		struct SortedListOperations
+		{
+			static bool Contains(const SortedList<T>& items, const T& item)
 			{
+				return items.Contains(item);
 			}
 		};
 
 		template<typename T>
-		class FromIterator
+		struct SortedListOperations<Ptr<T>>
 		{
-		public:
-			template<typename I>
-			static FromIteratorEnumerable<T, I> Wrap(I begin, I end)
+			static bool Contains(const SortedList<Ptr<T>>& items, const Ptr<T>& item)
 			{
-				return FromIteratorEnumerable<T, I>(begin, end);
+				return items.Contains(item.Obj());
 			}
 		};
-
-		template<typename T>
-		FromIteratorEnumerable<T, T*> FromPointer(T* begin, T* end)
-		{
-			return FromIteratorEnumerable<T, T*>(begin, end);
-		}
-
-		template<typename T, int size>
-		FromIteratorEnumerable<T, T*> FromArray(T (&items)[size])
-		{
-			return FromIteratorEnumerable<T, T*>(&items[0], &items[size]);
-		}
 	}
 }
 
 #endif
 
 /***********************************************************************
-COLLECTIONS\OPERATIONSET.H
+COLLECTIONS\OPERATIONSELECT.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
@@ -6135,8 +6278,8 @@ Data Structure::Operations
 
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_OPERATIONSET
-#define VCZH_COLLECTIONS_OPERATIONSET
+#ifndef VCZH_COLLECTIONS_OPERATIONSELECT
+#define VCZH_COLLECTIONS_OPERATIONSELECT
 
 
 namespace vl
@@ -6145,69 +6288,60 @@ namespace vl
 	{
 
 /***********************************************************************
-Intersect/Except
+Select
 ***********************************************************************/
 
-		template<typename T, bool Intersect>
-		class IntersectExceptEnumerator : public virtual IEnumerator<T>
+		template<typename T, typename K>
+		class SelectEnumerator : public virtual IEnumerator<K>
 		{
 		protected:
-			IEnumerator<T>*				enumerator;
-			SortedList<T>				reference;
-			vint						index;
-
+			IEnumerator<T>*		enumerator;
+			Func<K(T)>			selector;
+			K					current;
 		public:
-			IntersectExceptEnumerator(IEnumerator<T>* _enumerator, const IEnumerable<T>& _reference)
+			SelectEnumerator(IEnumerator<T>* _enumerator, const Func<K(T)>& _selector, K _current=K())
 				:enumerator(_enumerator)
-				,index(-1)
-			{
-				CopyFrom(reference, _reference);
-			}
-
-			IntersectExceptEnumerator(const IntersectExceptEnumerator& _enumerator)
+				,selector(_selector)
+				,current(_current)
 			{
-				enumerator=_enumerator.enumerator->Clone();
-				CopyFrom(reference, _enumerator.reference);
-				index=_enumerator.index;
 			}
 
-			~IntersectExceptEnumerator()
+			~SelectEnumerator()
 			{
 				delete enumerator;
 			}
 
-			IEnumerator<T>* Clone()const override
+			IEnumerator<K>* Clone()const override
 			{
-				return new IntersectExceptEnumerator(*this);
+				return new SelectEnumerator(enumerator->Clone(), selector, current);
 			}
 
-			const T& Current()const override
+			const K& Current()const override
 			{
-				return enumerator->Current();
+				return current;
 			}
 
 			vint Index()const override
 			{
-				return index;
+				return enumerator->Index();
 			}
 
 			bool Next()override
 			{
-				while(enumerator->Next())
+				if(enumerator->Next())
 				{
-					if(SortedListOperations<T>::Contains(reference, enumerator->Current())==Intersect)
-					{
-						index++;
-						return true;
-					}
+					current=selector(enumerator->Current());
+					return true;
+				}
+				else
+				{
+					return false;
 				}
-				return false;
 			}
 
 			void Reset()override
 			{
 				enumerator->Reset();
-				index=-1;
 			}
 		};
 	}
@@ -6216,7 +6350,7 @@ Intersect/Except
 #endif
 
 /***********************************************************************
-COLLECTIONS\OPERATIONPAIR.H
+COLLECTIONS\OPERATIONWHERE.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
@@ -6225,77 +6359,71 @@ Data Structure::Operations
 
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_OPERATIONPAIR
-#define VCZH_COLLECTIONS_OPERATIONPAIR
+#ifndef VCZH_COLLECTIONS_OPERATIONWHERE
+#define VCZH_COLLECTIONS_OPERATIONWHERE
 
 
 namespace vl
 {
 	namespace collections
 	{
-
 /***********************************************************************
-Pairwise
+Where
 ***********************************************************************/
 
-		template<typename S, typename T>
-		class PairwiseEnumerator : public virtual IEnumerator<Pair<S, T>>
+		template<typename T>
+		class WhereEnumerator : public virtual IEnumerator<T>
 		{
 		protected:
-			IEnumerator<S>*					enumerator1;
-			IEnumerator<T>*					enumerator2;
-			Pair<S, T>						current;
-		public:
-			PairwiseEnumerator(IEnumerator<S>* _enumerator1, IEnumerator<T>* _enumerator2, Pair<S, T> _current=Pair<S, T>())
-				:enumerator1(_enumerator1)
-				,enumerator2(_enumerator2)
-				,current(_current)
-			{
-			}
+			IEnumerator<T>*			enumerator;
+			Func<bool(T)>			selector;
+			vint					index;
 
-			~PairwiseEnumerator()
+		public:
+			WhereEnumerator(IEnumerator<T>* _enumerator, const Func<bool(T)>& _selector, vint _index=-1)
+				:enumerator(_enumerator)
+				,selector(_selector)
+				,index(_index)
 			{
-				delete enumerator1;
-				delete enumerator2;
 			}
 
-			IEnumerator<Pair<S, T>>* Clone()const override
+			~WhereEnumerator()
 			{
-				return new PairwiseEnumerator(enumerator1->Clone(), enumerator2->Clone(), current);
+				delete enumerator;
 			}
 
-			const Pair<S, T>& Current()const override
+			IEnumerator<T>* Clone()const override
 			{
-				return current;
+				return new WhereEnumerator(enumerator->Clone(), selector, index);
+			}
+
+			const T& Current()const override
+			{
+				return enumerator->Current();
 			}
 
 			vint Index()const override
 			{
-				return enumerator1->Index();
+				return index;
 			}
 
 			bool Next()override
 			{
-				if(enumerator1->Next() && enumerator2->Next())
-				{
-					current=Pair<S, T>(enumerator1->Current(), enumerator2->Current());
-					return true;
-				}
-				else
+				while(enumerator->Next())
 				{
-					return false;
+					if(selector(enumerator->Current()))
+					{
+						index++;
+						return true;
+					}
 				}
+				return false;
 			}
 
 			void Reset()override
 			{
-				enumerator1->Reset();
-				enumerator2->Reset();
-			}
-
-			bool Evaluated()const override
-			{
-				return enumerator1->Evaluated() && enumerator2->Evaluated();
+				enumerator->Reset();
+				index=-1;
 			}
 		};
 	}
@@ -6304,7 +6432,7 @@ Pairwise
 #endif
 
 /***********************************************************************
-COLLECTIONS\OPERATIONSTRING.H
+COLLECTIONS\OPERATIONCONCAT.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
@@ -6313,58 +6441,116 @@ Data Structure::Operations
 
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_OPERATIONSTRING
-#define VCZH_COLLECTIONS_OPERATIONSTRING
+#ifndef VCZH_COLLECTIONS_OPERATIONCONCAT
+#define VCZH_COLLECTIONS_OPERATIONCONCAT
 
 
 namespace vl
 {
 	namespace collections
 	{
-		template<typename Ds, typename S>
-		void CopyFrom(Ds& ds, const ObjectString<S>& ss, bool append=false)
-		{
-			const S* buffer=ss.Buffer();
-			vint count=ss.Length();
-			CopyFrom(ds, buffer, count, append);
-		}
 
-		template<typename D, typename Ss>
-		void CopyFrom(ObjectString<D>& ds, const Ss& ss, bool append=false)
+/***********************************************************************
+Concat
+***********************************************************************/
+
+		template<typename T>
+		class ConcatEnumerator : public virtual IEnumerator<T>
 		{
-			Array<D> da(ds.Buffer(), ds.Length());
-			CopyFrom(da, ss, append);
-			if(da.Count()==0)
+		protected:
+			IEnumerator<T>*					enumerator1;
+			IEnumerator<T>*					enumerator2;
+			vint							index;
+			bool							turned;
+		public:
+			ConcatEnumerator(IEnumerator<T>* _enumerator1, IEnumerator<T>* _enumerator2, vint _index=-1, bool _turned=false)
+				:enumerator1(_enumerator1)
+				,enumerator2(_enumerator2)
+				,index(_index)
+				,turned(_turned)
 			{
-				ds=ObjectString<D>();
 			}
-			else
+
+			~ConcatEnumerator()
 			{
-				ds=ObjectString<D>(&da[0], da.Count());
+				delete enumerator1;
+				delete enumerator2;
 			}
-		}
+
+			IEnumerator<T>* Clone()const override
+			{
+				return new ConcatEnumerator(enumerator1->Clone(), enumerator2->Clone(), index, turned);
+			}
+
+			const T& Current()const override
+			{
+				if(turned)
+				{
+					return enumerator2->Current();
+				}
+				else
+				{
+					return enumerator1->Current();
+				}
+			}
+
+			vint Index()const override
+			{
+				return index;
+			}
+
+			bool Next()override
+			{
+				index++;
+				if(turned)
+				{
+					return enumerator2->Next();
+				}
+				else
+				{
+					if(enumerator1->Next())
+					{
+						return true;
+					}
+					else
+					{
+						turned=true;
+						return enumerator2->Next();
+					}
+				}
+			}
+
+			void Reset()override
+			{
+				enumerator1->Reset();
+				enumerator2->Reset();
+				index=-1;
+				turned=false;
+			}
+
+			bool Evaluated()const override
+			{
+				return enumerator1->Evaluated() && enumerator2->Evaluated();
+			}
+		};
 	}
 }
 
 #endif
 
 /***********************************************************************
-COLLECTIONS\OPERATIONFOREACH.H
+COLLECTIONS\OPERATIONSEQUENCE.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
 Data Structure::Operations
 
-扩展：
-	实现一个函数重载IteratorType CreateForEachIterator(const CollectionType& collection);
-	CollectionType是所需要的容器类型
-	IteratorType继承自ForEachIterator<T>
-	必须写在vl::collections命名空间里
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_FOREACH
-#define VCZH_COLLECTIONS_FOREACH
+#ifndef VCZH_COLLECTIONS_OPERATIONSEQUENCE
+#define VCZH_COLLECTIONS_OPERATIONSEQUENCE
+
 
 namespace vl
 {
@@ -6372,439 +6558,508 @@ namespace vl
 	{
 
 /***********************************************************************
-ForEach基础设施
+Take
 ***********************************************************************/
 
 		template<typename T>
-		class ForEachIterator : public Object
+		class TakeEnumerator : public virtual IEnumerator<T>
 		{
+		protected:
+			IEnumerator<T>*			enumerator;
+			vint					count;
 		public:
-			virtual bool				Next(T& variable)const=0;
+			TakeEnumerator(IEnumerator<T>* _enumerator, vint _count)
+				:enumerator(_enumerator)
+				,count(_count)
+			{
+			}
 
-			operator bool()const
+			~TakeEnumerator()
 			{
-				return true;
+				delete enumerator;
+			}
+
+			IEnumerator<T>* Clone()const override
+			{
+				return new TakeEnumerator(enumerator->Clone(), count);
+			}
+
+			const T& Current()const override
+			{
+				return enumerator->Current();
+			}
+
+			vint Index()const override
+			{
+				return enumerator->Index();
+			}
+
+			bool Next()override
+			{
+				if(enumerator->Index()>=count-1) return false;
+				return enumerator->Next();
+			}
+
+			void Reset()override
+			{
+				enumerator->Reset();
+			}
+
+			bool Evaluated()const override
+			{
+				return enumerator->Evaluated();
 			}
 		};
 
 /***********************************************************************
-IEnumerable<T>支持
+Skip
 ***********************************************************************/
 
 		template<typename T>
-		class EnumerableForEachIterator : public ForEachIterator<T>
+		class SkipEnumerator : public virtual IEnumerator<T>
 		{
 		protected:
-			Ptr<IEnumerator<T>>			enumerator;
+			IEnumerator<T>*			enumerator;
+			vint					count;
+			bool					skipped;
 		public:
-			EnumerableForEachIterator(const IEnumerable<T>& enumerable)
-				:enumerator(enumerable.CreateEnumerator())
+			SkipEnumerator(IEnumerator<T>* _enumerator, vint _count, bool _skipped=false)
+				:enumerator(_enumerator)
+				,count(_count)
+				,skipped(_skipped)
 			{
 			}
 
-			EnumerableForEachIterator(const EnumerableForEachIterator<T>& enumerableIterator)
-				:enumerator(enumerableIterator.enumerator)
+			~SkipEnumerator()
 			{
+				delete enumerator;
 			}
 
-			bool Next(T& variable)const
+			IEnumerator<T>* Clone()const override
 			{
-				if(enumerator->Next())
-				{
-					variable=enumerator->Current();
-					return true;
-				}
-				else
-				{
-					return false;
-				}
+				return new SkipEnumerator(enumerator->Clone(), count, skipped);
 			}
-		};
 
-		template<typename T>
-		EnumerableForEachIterator<T> CreateForEachIterator(const IEnumerable<T>& enumerable)
-		{
-			return enumerable;
-		}
+			const T& Current()const override
+			{
+				return enumerator->Current();
+			}
 
-/***********************************************************************
-ForEach宏
-***********************************************************************/
+			vint Index()const override
+			{
+				return enumerator->Index()-count;
+			}
 
-#define FOREACH(TYPE, VARIABLE, COLLECTION)\
-		SCOPE_VARIABLE(const ForEachIterator<TYPE>&, __foreach_iterator__, CreateForEachIterator(COLLECTION))\
-		for(TYPE VARIABLE;__foreach_iterator__.Next(VARIABLE);)
+			bool Next()override
+			{
+				if(!skipped)
+				{
+					skipped=true;
+					for(vint i=0;i<count;i++)
+					{
+						if(!enumerator->Next())
+						{
+							return false;
+						}
+					}
+				}
+				return enumerator->Next();
+			}
 
-#define FOREACH_INDEXER(TYPE, VARIABLE, INDEXER, COLLECTION)\
-		SCOPE_VARIABLE(const ForEachIterator<TYPE>&, __foreach_iterator__, CreateForEachIterator(COLLECTION))\
-		SCOPE_VARIABLE(vint, INDEXER, 0)\
-		for(TYPE VARIABLE;__foreach_iterator__.Next(VARIABLE);INDEXER++)
-	}
-}
+			void Reset()override
+			{
+				enumerator->Reset();
+				skipped=false;
+			}
 
-#endif
+			bool Evaluated()const override
+			{
+				return enumerator->Evaluated();
+			}
+		};
 
 /***********************************************************************
-REGEX\REGEX.H
+Repeat
 ***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Regex::Regular Expression
 
-Classes:
-	RegexString						：字符串匹配结果
-	RegexMatch						：匹配结果
-	Regex							：正则表达式引擎
-	RegexToken						：词法记号
-	RegexTokens						：词法记号表
-	RegexLexer						：词法分析器
-***********************************************************************/
+		template<typename T>
+		class RepeatEnumerator : public virtual IEnumerator<T>
+		{
+		protected:
+			IEnumerator<T>*			enumerator;
+			vint					count;
+			vint					index;
+			vint					repeatedCount;
+		public:
+			RepeatEnumerator(IEnumerator<T>* _enumerator, vint _count, vint _index=-1, vint _repeatedCount=0)
+				:enumerator(_enumerator)
+				,count(_count)
+				,index(_index)
+				,repeatedCount(_repeatedCount)
+			{
+			}
 
-#ifndef VCZH_REGEX_REGEX
-#define VCZH_REGEX_REGEX
+			~RepeatEnumerator()
+			{
+				delete enumerator;
+			}
 
+			IEnumerator<T>* Clone()const override
+			{
+				return new RepeatEnumerator(enumerator->Clone(), count, index, repeatedCount);
+			}
 
-namespace vl
-{
-	namespace regex_internal
-	{
-		class PureResult;
-		class PureInterpretor;
-		class RichResult;
-		class RichInterpretor;
-	}
+			const T& Current()const override
+			{
+				return enumerator->Current();
+			}
 
-	namespace regex
-	{
+			vint Index()const override
+			{
+				return index;
+			}
+
+			bool Next()override
+			{
+				while(repeatedCount<count)
+				{
+					if(enumerator->Next())
+					{
+						index++;
+						return true;
+					}
+					repeatedCount++;
+					enumerator->Reset();
+				}
+				return false;
+			}
+
+			void Reset()override
+			{
+				enumerator->Reset();
+				index=-1;
+				repeatedCount=0;
+			}
+
+			bool Evaluated()const override
+			{
+				return enumerator->Evaluated();
+			}
+		};
 
 /***********************************************************************
-正则表达式引擎数据结构
+Distinct
 ***********************************************************************/
 
-		/// <summary>A type representing a fragment of the input string.</summary>
-		class RegexString : public Object
+		template<typename T>
+		class DistinctEnumerator : public virtual IEnumerator<T>
 		{
 		protected:
-			WString										value;
-			vint										start;
-			vint										length;
+			IEnumerator<T>*		enumerator;
+			SortedList<T>		distinct;
+			T					lastValue;
 
 		public:
-			RegexString(vint _start=0);
-			RegexString(const WString& _string, vint _start, vint _length);
+			DistinctEnumerator(IEnumerator<T>* _enumerator)
+				:enumerator(_enumerator)
+			{
+			}
 
-			/// <summary>The position of the input string.</summary>
-			/// <returns>The position.</returns>
-			vint										Start()const;
-			/// <summary>The size of the fragment in characters.</summary>
-			/// <returns>The size.</returns>
-			vint										Length()const;
-			/// <summary>Get the fragment.</summary>
-			/// <returns>The fragment.</returns>
-			const WString&								Value()const;
-			bool										operator==(const RegexString& string)const;
-		};
+			DistinctEnumerator(const DistinctEnumerator& _enumerator)
+				:lastValue(_enumerator.lastValue)
+			{
+				enumerator=_enumerator.enumerator->Clone();
+				CopyFrom(distinct, _enumerator.distinct);
+			}
 
-		/// <summary>A type representing a match of the input string.</summary>
-		class RegexMatch : public Object, private NotCopyable
-		{
-			friend class Regex;
-		public:
-			typedef Ptr<RegexMatch>										Ref;
-			typedef collections::List<Ref>								List;
-			typedef collections::List<RegexString>						CaptureList;
-			typedef collections::Group<WString, RegexString>			CaptureGroup;
-		protected:
-			collections::List<RegexString>				captures;
-			collections::Group<WString, RegexString>	groups;
-			bool										success;
-			RegexString									result;
+			~DistinctEnumerator()
+			{
+				delete enumerator;
+			}
 
-			RegexMatch(const WString& _string, regex_internal::PureResult* _result);
-			RegexMatch(const WString& _string, regex_internal::RichResult* _result, regex_internal::RichInterpretor* _rich);
-			RegexMatch(const RegexString& _result);
-		public:
-			
-			/// <summary>Test if this match is a success match or a failed match. A failed match will only appear when calling [M:vl.regex.Regex.Split] or [M:vl.regex.Regex.Cut]. In other cases, failed matches are either not included in the result, or become null pointers.</summary>
-			/// <returns>Returns true if this match is a success match.</returns>
-			bool										Success()const;
-			/// <summary>Get the whole fragment that matches.</summary>
-			/// <returns>The whole fragment.</returns>
-			const RegexString&							Result()const;
-			/// <summary>Get all fragments that are captured.</summary>
-			/// <returns>All fragments that are captured.</returns>
-			const CaptureList&							Captures()const;
-			/// <summary>Get all fragments that are captured by named groups.</summary>
-			/// <returns>All fragments that are captured.</returns>
-			const CaptureGroup&							Groups()const;
+			IEnumerator<T>* Clone()const override
+			{
+				return new DistinctEnumerator(*this);
+			}
+
+			const T& Current()const override
+			{
+				return lastValue;
+			}
+
+			vint Index()const override
+			{
+				return distinct.Count()-1;
+			}
+
+			bool Next()override
+			{
+				while(enumerator->Next())
+				{
+					const T& current=enumerator->Current();
+					if(!SortedListOperations<T>::Contains(distinct, current))
+					{
+						lastValue=current;
+						distinct.Add(current);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void Reset()override
+			{
+				enumerator->Reset();
+				distinct.Clear();
+			}
 		};
 
 /***********************************************************************
-正则表达式引擎
+Reverse
 ***********************************************************************/
 
-		/// <summary><![CDATA[
-		/// Regular Expression. Here is a brief description of the regular expression grammar:
-		///	1) Charset:
-		///		a, [a-z], [^a-z]
-		/// 2) Functional characters:
-		///		^: the beginning of the input (DFA incompatible)
-		///		$: the end of the input (DFA incompatible)
-		///		regex1|regex2: match either regex1 or regex2
-		///	3) Escaping (both \ and / mean the next character is escaped)
-		///		Escaped characters:
-		///			\r: the CR character
-		///			\n: the LF character
-		///			\t: the tab character
-		///			\s: spacing characters (including space, \r, \n, \t)
-		///			\S: non-spacing characters
-		///			\d: [0-9]
-		///			\D: [^0-9]
-		///			\l: [a-zA-Z]
-		///			\L: [^a-zA-Z]
-		///			\w: [a-zA-Z0-9_]
-		///			\W: [^a-zA-Z0-9_]
-		///			\.: any character (this is the main different from other regex, which treat "." as any characters and "\." as the dot character)
-		///			\\, \/, \(, \), \+, \*, \?, \{, \}, \[, \], \<, \>, \^, \$, \!, \=: represents itself
-		///		Escaped characters in charset defined in a square bracket:
-		///			\r: the CR character
-		///			\n: the LF character
-		///			\t: the tab character
-		///			\-, \[, \], \\, \/, \^, \$: represents itself
-		///	4) Loops:
-		///		regex{3}: repeats 3 times
-		///		regex{3,}: repeats 3 or more times
-		///		regex{1,3}: repeats 1 to 3 times
-		///		regex?: repeats 0 or 1 times
-		///		regex*: repeats 0 or more times
-		///		regex+: repeats 1 or more times
-		///		if you add a "?" right after a loop, it means repeating as less as possible (DFA incompatible)
-		///	5) Capturing: (DFA incompatible)
-		///		(regex): No capturing, just change the operators' association
-		///		(?regex): Capture matched fragment
-		///		(?<name>regex): Capture matched fragment in a named group called "name"
-		///		(<$i>): Match the i-th captured fragment, begins from 0
-		///		(<$name;i>): Match the i-th captured fragment in the named group called "name", begins from 0
-		///		(<$name>): Match any captured fragment in the named group called "name"
-		///	6) MISC
-		///		(=regex): The prefix of the following text should match the regex, but it is not counted in the whole match (DFA incompatible)
-		///		(!regex): Any prefix of the following text should not match the regex, and it is not counted in the whole match (DFA incompatible)
-		///		(<#name>regex): Name the regex "name", and it applies here
-		///		(<&name>): Copy the named regex "name" here and apply
-		/// ]]></summary>
-		class Regex : public Object, private NotCopyable
+		template<typename T>
+		class ReverseEnumerator : public virtual IEnumerator<T>
 		{
 		protected:
-			regex_internal::PureInterpretor*			pure;
-			regex_internal::RichInterpretor*			rich;
-
-			void										Process(const WString& text, bool keepEmpty, bool keepSuccess, bool keepFail, RegexMatch::List& matches)const;
+			List<T>						cache;
+			vint						index;
 		public:
-			/// <summary>Create a regular expression.</summary>
-			/// <param name="code">The regular expression in a string.</param>
-			/// <param name="preferPure">Set to true to tell the Regex to use DFA if possible.</param>
-			Regex(const WString& code, bool preferPure=true);
-			~Regex();
+			ReverseEnumerator(const IEnumerable<T>& enumerable)
+				:index(-1)
+			{
+				CopyFrom(cache, enumerable);
+			}
 
-			/// <summary>Test does the Regex uses DFA to match a string.</summary>
-			/// <returns>Returns true if DFA is used.</returns>
-			bool										IsPureMatch()const;
-			/// <summary>Test does the Regex uses DFA to test a string. Test means ignoring all capturing requirements.</summary>
-			/// <returns>Returns true if DFA is used.</returns>
-			bool										IsPureTest()const;
+			ReverseEnumerator(const ReverseEnumerator& _enumerator)
+				:index(_enumerator.index)
+			{
+				CopyFrom(cache, _enumerator.cache);
+			}
 
-			/// <summary>Match a prefix of the text.</summary>
-			/// <returns>Returns the match. Returns null if failed.</returns>
-			/// <param name="text">The text to match.</param>
-			RegexMatch::Ref								MatchHead(const WString& text)const;
-			/// <summary>Match a fragment of the text.</summary>
-			/// <returns>Returns the match. Returns null if failed.</returns>
-			/// <param name="text">The text to match.</param>
-			RegexMatch::Ref								Match(const WString& text)const;
-			/// <summary>Match a prefix of the text, ignoring all capturing requirements.</summary>
-			/// <returns>Returns true if succeeded.</returns>
-			/// <param name="text">The text to match.</param>
-			bool										TestHead(const WString& text)const;
-			/// <summary>Match a fragment of the text, ignoring all capturing requirements.</summary>
-			/// <returns>Returns true if succeeded.</returns>
-			/// <param name="text">The text to match.</param>
-			bool										Test(const WString& text)const;
-			/// <summary>Find all matched fragments of the text, returning all matched fragments.</summary>
-			/// <param name="text">The text to match.</param>
-			/// <param name="matches">All successful matches.</param>
-			void										Search(const WString& text, RegexMatch::List& matches)const;
-			/// <summary>Split the text by matched fragments, returning all unmatched fragments.</summary>
-			/// <param name="text">The text to match.</param>
-			/// <param name="keepEmptyMatch">Set to true to keep all empty matches.</param>
-			/// <param name="matches">All failed matches.</param>
-			void										Split(const WString& text, bool keepEmptyMatch, RegexMatch::List& matches)const;
-			/// <summary>Cut the text by matched fragments, returning all matched or unmatched fragments.</summary>
-			/// <param name="text">The text to match.</param>
-			/// <param name="keepEmptyMatch">Set to true to keep all empty matches.</param>
-			/// <param name="matches">All successful and failed matches.</param>
-			void										Cut(const WString& text, bool keepEmptyMatch, RegexMatch::List& matches)const;
+			~ReverseEnumerator()
+			{
+			}
+
+			IEnumerator<T>* Clone()const override
+			{
+				return new ReverseEnumerator(*this);
+			}
+
+			const T& Current()const override
+			{
+				return cache.Get(cache.Count()-1-index);
+			}
+
+			vint Index()const override
+			{
+				return index;
+			}
+
+			bool Next()override
+			{
+				index++;
+				return index<cache.Count();
+			}
+
+			void Reset()override
+			{
+				index=-1;
+			}
+
+			bool Evaluated()const override
+			{
+				return true;
+			}
 		};
 
 /***********************************************************************
-正则表达式词法分析器
+FromIterator
 ***********************************************************************/
 
-		/// <summary>A token.</summary>
-		class RegexToken
+		template<typename T, typename I>
+		class FromIteratorEnumerable : public Object, public IEnumerable<T>
 		{
+		private:
+			class Enumerator : public Object, public IEnumerator<T>
+			{
+			private:
+				I				begin;
+				I				end;
+				I				current;
+
+			public:
+				Enumerator(I _begin, I _end, I _current)
+					:begin(_begin)
+					,end(_end)
+					,current(_current)
+				{
+				}
+
+				IEnumerator<T>* Clone()const override
+				{
+					return new Enumerator(begin, end, current);
+				}
+
+				const T& Current()const override
+				{
+					return *current;
+				}
+
+				vint Index()const override
+				{
+					return current-begin;
+				}
+
+				bool Next()override
+				{
+					current++;
+					return begin<=current && current<end;
+				}
+
+				void Reset()override
+				{
+					current=begin-1;
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+		private:
+			I					begin;
+			I					end;
 		public:
-			/// <summary>Position in the input string.</summary>
-			vint										start;
-			/// <summary>Size of this token in characters.</summary>
-			vint										length;
-			/// <summary>The token id, begins at 0, represents the regular expression in the list that matches this token. -1 means this token is produced by an error.</summary>
-			vint										token;
-			/// <summary>The pointer to where this token starts in the input string .</summary>
-			const wchar_t*								reading;
-			/// <summary>The argument value from [M:vl.regex.RegexLexer.Parse].</summary>
-			vint										codeIndex;
-			/// <summary>True if this token is complete. False if this token does not end here.</summary>
-			bool										completeToken;
+			IEnumerator<T>* CreateEnumerator()const
+			{
+				return new Enumerator(begin, end, begin-1);
+			}
 
-			/// <summary>Row number of the first character, begins at 0.</summary>
-			vint										rowStart;
-			/// <summary>Column number of the first character, begins at 0.</summary>
-			vint										columnStart;
-			/// <summary>Row number of the last character, begins at 0.</summary>
-			vint										rowEnd;
-			/// <summary>Column number of the last character, begins at 0.</summary>
-			vint										columnEnd;
+			FromIteratorEnumerable(I _begin, I _end)
+				:begin(_begin)
+				,end(_end)
+			{
+			}
 
-			bool										operator==(const RegexToken& _token)const;
-			bool										operator==(const wchar_t* _token)const;
+			FromIteratorEnumerable(const FromIteratorEnumerable<T, I>& enumerable)
+				:begin(enumerable.begin)
+				,end(enumerable.end)
+			{
+			}
 		};
 
-		/// <summary>Token collection representing the result from the lexical analyzer.</summary>
-		class RegexTokens : public Object, public collections::IEnumerable<RegexToken>
+		template<typename T>
+		class FromIterator
 		{
-			friend class RegexLexer;
-		protected:
-			regex_internal::PureInterpretor*			pure;
-			const collections::Array<vint>&				stateTokens;
-			WString										code;
-			vint										codeIndex;
-			
-			RegexTokens(regex_internal::PureInterpretor* _pure, const collections::Array<vint>& _stateTokens, const WString& _code, vint _codeIndex);
 		public:
-			RegexTokens(const RegexTokens& tokens);
+			template<typename I>
+			static FromIteratorEnumerable<T, I> Wrap(I begin, I end)
+			{
+				return FromIteratorEnumerable<T, I>(begin, end);
+			}
+		};
 
-			collections::IEnumerator<RegexToken>*		CreateEnumerator()const;
+		template<typename T>
+		FromIteratorEnumerable<T, T*> FromPointer(T* begin, T* end)
+		{
+			return FromIteratorEnumerable<T, T*>(begin, end);
+		}
 
-			/// <summary>Copy all tokens.</summary>
-			/// <param name="tokens">Returns all tokens.</param>
-			/// <param name="discard">A callback to decide which kind of tokens to discard. The input is [F:vl.regex.RegexToken.token]. Returns true to discard this kind of tokens.</param>
-			void										ReadToEnd(collections::List<RegexToken>& tokens, bool(*discard)(vint)=0)const;
-		};
-		
-		/// <summary>Lexical walker.</summary>
-		class RegexLexerWalker : public Object
+		template<typename T, int size>
+		FromIteratorEnumerable<T, T*> FromArray(T (&items)[size])
 		{
-			friend class RegexLexer;
-		protected:
-			regex_internal::PureInterpretor*			pure;
-			const collections::Array<vint>&				stateTokens;
-			
-			RegexLexerWalker(regex_internal::PureInterpretor* _pure, const collections::Array<vint>& _stateTokens);
-		public:
-			RegexLexerWalker(const RegexLexerWalker& walker);
-			~RegexLexerWalker();
-			
-			/// <summary>Get the start DFA state number, which represents the correct state before parsing any input.</summary>
-			/// <returns>The DFA state number.</returns>
-			vint										GetStartState()const;
-			/// <summary>Test if this state can only lead to the end of one kind of token.</summary>
-			/// <returns>Returns the token index if this state can only lead to the end of one kind of token. Returns -1 if not.</returns>
-			/// <param name="state">The DFA state number.</param>
-			vint										GetRelatedToken(vint state)const;
-			/// <summary>Step forward by one character.</summary>
-			/// <param name="input">The input character.</param>
-			/// <param name="state">The current state. Returns the new current state when this function returns.</param>
-			/// <param name="token">Returns the token index at the end of the token.</param>
-			/// <param name="finalState">Returns true if it reach the end of the token.</param>
-			/// <param name="previousTokenStop">Returns true if the last character is the end of the token.</param>
-			void										Walk(wchar_t input, vint& state, vint& token, bool& finalState, bool& previousTokenStop)const;
-			/// <summary>Step forward by one character.</summary>
-			/// <returns>Returns the new current state.</returns>
-			/// <param name="input">The input character.</param>
-			/// <param name="state">The current state.</param>
-			vint										Walk(wchar_t input, vint state)const;
-			/// <summary>Test if the input text is a complete token.</summary>
-			/// <returns>Returns true if the input text is a complete token.</returns>
-			/// <param name="input">The input text.</param>
-			/// <param name="length">Size of the input text in characters.</param>
-			bool										IsClosedToken(const wchar_t* input, vint length)const;
-			/// <summary>Test if the input is a complete token.</summary>
-			/// <returns>Returns true if the input text is a complete token.</returns>
-			/// <param name="input">The input text.</param>
-			bool										IsClosedToken(const WString& input)const;
-		};
+			return FromIteratorEnumerable<T, T*>(&items[0], &items[size]);
+		}
+	}
+}
 
-		/// <summary>Lexical colorizer.</summary>
-		class RegexLexerColorizer : public Object
-		{
-			friend class RegexLexer;
-		public:
-			typedef void(*TokenProc)(void* argument, vint start, vint length, vint token);
+#endif
 
-		protected:
-			RegexLexerWalker							walker;
-			vint										currentState;
+/***********************************************************************
+COLLECTIONS\OPERATIONSET.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Data Structure::Operations
 
-			RegexLexerColorizer(const RegexLexerWalker& _walker);
-		public:
-			RegexLexerColorizer(const RegexLexerColorizer& colorizer);
-			~RegexLexerColorizer();
+***********************************************************************/
 
-			/// <summary>Reset the colorizer using the DFA state number.</summary>
-			/// <param name="state">The DFA state number.</param>
-			void										Reset(vint state);
-			/// <summary>Step forward by one character.</summary>
-			/// <param name="input">The input character.</param>
-			void										Pass(wchar_t input);
-			/// <summary>Get the start DFA state number, which represents the correct state before colorizing any characters.</summary>
-			/// <returns>The DFA state number.</returns>
-			vint										GetStartState()const;
-			/// <summary>Get the current DFA state number.</summary>
-			/// <returns>The DFA state number.</returns>
-			vint										GetCurrentState()const;
-			/// <summary>Colorize a text.</summary>
-			/// <param name="input">The text to colorize.</param>
-			/// <param name="length">Size of the text in characters.</param>
-			/// <param name="tokenProc">Colorizer callback. This callback will be called if any token is found..</param>
-			/// <param name="tokenProcArgument">The argument to call the callback.</param>
-			void										Colorize(const wchar_t* input, vint length, TokenProc tokenProc, void* tokenProcArgument);
-		};
+#ifndef VCZH_COLLECTIONS_OPERATIONSET
+#define VCZH_COLLECTIONS_OPERATIONSET
 
-		/// <summary>Lexical analyzer.</summary>
-		class RegexLexer : public Object, private NotCopyable
+
+namespace vl
+{
+	namespace collections
+	{
+
+/***********************************************************************
+Intersect/Except
+***********************************************************************/
+
+		template<typename T, bool Intersect>
+		class IntersectExceptEnumerator : public virtual IEnumerator<T>
 		{
 		protected:
-			regex_internal::PureInterpretor*			pure;
-			collections::Array<vint>					ids;
-			collections::Array<vint>					stateTokens;
+			IEnumerator<T>*				enumerator;
+			SortedList<T>				reference;
+			vint						index;
+
 		public:
-			/// <summary>Create a lexical analyzer by a set of regular expressions. [F:vl.regex.RegexToken.token] will be the index of the matched regular expression.</summary>
-			/// <param name="tokens">The regular expressions.</param>
-			RegexLexer(const collections::IEnumerable<WString>& tokens);
-			~RegexLexer();
+			IntersectExceptEnumerator(IEnumerator<T>* _enumerator, const IEnumerable<T>& _reference)
+				:enumerator(_enumerator)
+				,index(-1)
+			{
+				CopyFrom(reference, _reference);
+			}
 
-			/// <summary>Tokenize a input text.</summary>
-			/// <returns>The result.</returns>
-			/// <param name="code">The text to tokenize.</param>
-			/// <param name="codeIndex">Extra information that will store in [F:vl.regex.RegexToken.codeIndex].</param>
-			RegexTokens									Parse(const WString& code, vint codeIndex=-1)const;
-			/// <summary>Create a equivalence walker from this lexical analyzer.</summary>
-			/// <returns>The walker.</returns>
-			RegexLexerWalker							Walk()const;
-			/// <summary>Create a equivalence colorizer from this lexical analyzer.</summary>
-			/// <returns>The colorizer.</returns>
-			RegexLexerColorizer							Colorize()const;
+			IntersectExceptEnumerator(const IntersectExceptEnumerator& _enumerator)
+			{
+				enumerator=_enumerator.enumerator->Clone();
+				CopyFrom(reference, _enumerator.reference);
+				index=_enumerator.index;
+			}
+
+			~IntersectExceptEnumerator()
+			{
+				delete enumerator;
+			}
+
+			IEnumerator<T>* Clone()const override
+			{
+				return new IntersectExceptEnumerator(*this);
+			}
+
+			const T& Current()const override
+			{
+				return enumerator->Current();
+			}
+
+			vint Index()const override
+			{
+				return index;
+			}
+
+			bool Next()override
+			{
+				while(enumerator->Next())
+				{
+					if(SortedListOperations<T>::Contains(reference, enumerator->Current())==Intersect)
+					{
+						index++;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void Reset()override
+			{
+				enumerator->Reset();
+				index=-1;
+			}
 		};
 	}
 }
@@ -6812,1282 +7067,2444 @@ namespace vl
 #endif
 
 /***********************************************************************
-STREAM\ACCESSOR.H
+COLLECTIONS\OPERATIONPAIR.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
-Stream::Accessor
+Data Structure::Operations
 
-Classes:
-	TextReader						：字符串阅读器
-	TextWriter						：字符串书写器
-	StreamReader					：流阅读器
-	StreamWriter					：流书写器
-	EncoderStream					：编码流
-	DecoderStream					：解码流
 ***********************************************************************/
 
-#ifndef VCZH_STREAM_ACCESSOR
-#define VCZH_STREAM_ACCESSOR
+#ifndef VCZH_COLLECTIONS_OPERATIONPAIR
+#define VCZH_COLLECTIONS_OPERATIONPAIR
 
 
 namespace vl
 {
-	namespace stream
+	namespace collections
 	{
 
 /***********************************************************************
-流控制器
+Pairwise
 ***********************************************************************/
 
-		/// <summary>Text reader. All line breaks are normalized to CRLF regardless the format in the source.</summary>
-		class TextReader : public Object, private NotCopyable
-		{
-		public:
-			/// <summary>Test does the reader reach the end or not.</summary>
-			/// <returns>Returns true if the reader reaches the end.</returns>
-			virtual bool				IsEnd()=0;
-			/// <summary>Read a single character.</summary>
-			/// <returns>The character.</returns>
-			virtual wchar_t				ReadChar()=0;
-			/// <summary>Read a string of a specified size.</summary>
-			/// <returns>The string.</returns>
-			/// <param name="length">Expected length of the string to read.</param>
-			virtual WString				ReadString(vint length);
-			/// <summary>Read a string until a line breaks is reached.</summary>
-			/// <returns>The string. It does not contain the line break.</returns>
-			virtual WString				ReadLine();
-			/// <summary>Read everying remain.</summary>
-			/// <returns>The string.</returns>
-			virtual WString				ReadToEnd();
-		};
-		
-		/// <summary>Text writer.</summary>
-		class TextWriter : public Object, private NotCopyable
+		template<typename S, typename T>
+		class PairwiseEnumerator : public virtual IEnumerator<Pair<S, T>>
 		{
+		protected:
+			IEnumerator<S>*					enumerator1;
+			IEnumerator<T>*					enumerator2;
+			Pair<S, T>						current;
 		public:
-			/// <summary>Write a single character.</summary>
-			/// <param name="c">The character to write.</param>
-			virtual void				WriteChar(wchar_t c)=0;
-			/// <summary>Write a string.</summary>
-			/// <param name="string">Buffer to the string to write.</param>
-			/// <param name="charCount">Size of the string in characters not including the zero terminator.</param>
-			virtual void				WriteString(const wchar_t* string, vint charCount);
-			/// <summary>Write a string.</summary>
-			/// <param name="string">Buffer to the zero terminated string to write.</param>
-			virtual void				WriteString(const wchar_t* string);
-			/// <summary>Write a string.</summary>
-			/// <param name="string">The string to write.</param>
-			virtual void				WriteString(const WString& string);
-			/// <summary>Write a string with a CRLF.</summary>
-			/// <param name="string">Buffer to the string to write.</param>
-			/// <param name="charCount">Size of the string in characters not including the zero terminator.</param>
-			virtual void				WriteLine(const wchar_t* string, vint charCount);
-			/// <summary>Write a string with a CRLF.</summary>
-			/// <param name="string">Buffer to the zero terminated string to write.</param>
-			virtual void				WriteLine(const wchar_t* string);
-			/// <summary>Write a string with a CRLF.</summary>
-			/// <param name="string">The string to write.</param>
-			virtual void				WriteLine(const WString& string);
+			PairwiseEnumerator(IEnumerator<S>* _enumerator1, IEnumerator<T>* _enumerator2, Pair<S, T> _current=Pair<S, T>())
+				:enumerator1(_enumerator1)
+				,enumerator2(_enumerator2)
+				,current(_current)
+			{
+			}
 
-			virtual void				WriteMonospacedEnglishTable(collections::Array<WString>& tableByRow, vint rows, vint columns);
-		};
+			~PairwiseEnumerator()
+			{
+				delete enumerator1;
+				delete enumerator2;
+			}
 
-		/// <summary>Text reader from a string.</summary>
-		class StringReader : public TextReader
-		{
-		protected:
-			WString						string;
-			vint						current;
-			bool						lastCallIsReadLine;
+			IEnumerator<Pair<S, T>>* Clone()const override
+			{
+				return new PairwiseEnumerator(enumerator1->Clone(), enumerator2->Clone(), current);
+			}
 
-			void						PrepareIfLastCallIsReadLine();
-		public:
-			/// <summary>Create a text reader.</summary>
-			/// <param name="_string">The string to read.</param>
-			StringReader(const WString& _string);
+			const Pair<S, T>& Current()const override
+			{
+				return current;
+			}
 
-			bool						IsEnd();
-			wchar_t						ReadChar();
-			WString						ReadString(vint length);
-			WString						ReadLine();
-			WString						ReadToEnd();
-		};
-		
-		/// <summary>Text reader from a stream.</summary>
-		class StreamReader : public TextReader
-		{
-		protected:
-			IStream*					stream;
-		public:
-			/// <summary>Create a text reader.</summary>
-			/// <param name="_stream">The stream to read.</param>
-			StreamReader(IStream& _stream);
+			vint Index()const override
+			{
+				return enumerator1->Index();
+			}
 
-			bool						IsEnd();
-			wchar_t						ReadChar();
-		};
-		
-		/// <summary>Text writer to a stream.</summary>
-		class StreamWriter : public TextWriter
-		{
-		protected:
-			IStream*					stream;
-		public:
-			/// <summary>Create a text writer.</summary>
-			/// <param name="_stream">The stream to write.</param>
-			StreamWriter(IStream& _stream);
-			using TextWriter::WriteString;
+			bool Next()override
+			{
+				if(enumerator1->Next() && enumerator2->Next())
+				{
+					current=Pair<S, T>(enumerator1->Current(), enumerator2->Current());
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
 
-			void						WriteChar(wchar_t c);
-			void						WriteString(const wchar_t* string, vint charCount);
+			void Reset()override
+			{
+				enumerator1->Reset();
+				enumerator2->Reset();
+			}
+
+			bool Evaluated()const override
+			{
+				return enumerator1->Evaluated() && enumerator2->Evaluated();
+			}
 		};
+	}
+}
+
+#endif
 
 /***********************************************************************
-编码解码
+COLLECTIONS\OPERATIONSTRING.H
 ***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Data Structure::Operations
 
-		/// <summary>Encoder stream, a writable stream using an [T:vl.stream.IEncoder] to transform content.</summary>
-		class EncoderStream : public virtual IStream
-		{
-		protected:
-			IStream*					stream;
-			IEncoder*					encoder;
-			pos_t						position;
+***********************************************************************/
 
-		public:
-			/// <summary>Create a stream.</summary>
-			/// <param name="_stream">The target stream to write.</param>
-			/// <param name="_encoder">The encoder to transform content.</param>
-			EncoderStream(IStream& _stream, IEncoder& _encoder);
-			~EncoderStream();
+#ifndef VCZH_COLLECTIONS_OPERATIONSTRING
+#define VCZH_COLLECTIONS_OPERATIONSTRING
 
-			bool						CanRead()const;
-			bool						CanWrite()const;
-			bool						CanSeek()const;
-			bool						CanPeek()const;
-			bool						IsLimited()const;
-			bool						IsAvailable()const;
-			void						Close();
-			pos_t						Position()const;
-			pos_t						Size()const;
-			void						Seek(pos_t _size);
-			void						SeekFromBegin(pos_t _size);
-			void						SeekFromEnd(pos_t _size);
-			vint						Read(void* _buffer, vint _size);
-			vint						Write(void* _buffer, vint _size);
-			vint						Peek(void* _buffer, vint _size);
-		};
-		
-		/// <summary>Decoder stream, a readable stream using an [T:vl.stream.IDecoder] to transform content.</summary>
-		class DecoderStream : public virtual IStream
-		{
-		protected:
-			IStream*					stream;
-			IDecoder*					decoder;
-			pos_t						position;
 
-		public:
-			/// <summary>Create a stream.</summary>
-			/// <param name="_stream">The target stream to read.</param>
-			/// <param name="_decoder">The decoder to transform content.</param>
-			DecoderStream(IStream& _stream, IDecoder& _decoder);
-			~DecoderStream();
+namespace vl
+{
+	namespace collections
+	{
+		template<typename Ds, typename S>
+		void CopyFrom(Ds& ds, const ObjectString<S>& ss, bool append=false)
+		{
+			const S* buffer=ss.Buffer();
+			vint count=ss.Length();
+			CopyFrom(ds, buffer, count, append);
+		}
 
-			bool						CanRead()const;
-			bool						CanWrite()const;
-			bool						CanSeek()const;
-			bool						CanPeek()const;
-			bool						IsLimited()const;
-			bool						IsAvailable()const;
-			void						Close();
-			pos_t						Position()const;
-			pos_t						Size()const;
-			void						Seek(pos_t _size);
-			void						SeekFromBegin(pos_t _size);
-			void						SeekFromEnd(pos_t _size);
-			vint						Read(void* _buffer, vint _size);
-			vint						Write(void* _buffer, vint _size);
-			vint						Peek(void* _buffer, vint _size);
-		};
+		template<typename D, typename Ss>
+		void CopyFrom(ObjectString<D>& ds, const Ss& ss, bool append=false)
+		{
+			Array<D> da(ds.Buffer(), ds.Length());
+			CopyFrom(da, ss, append);
+			if(da.Count()==0)
+			{
+				ds=ObjectString<D>();
+			}
+			else
+			{
+				ds=ObjectString<D>(&da[0], da.Count());
+			}
+		}
 	}
 }
 
 #endif
 
 /***********************************************************************
-STREAM\COMPRESSIONSTREAM.H
+COLLECTIONS\OPERATIONFOREACH.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
-Stream::CharFormat
+Data Structure::Operations
 
-Classes:
+扩展：
+	实现一个函数重载IteratorType CreateForEachIterator(const CollectionType& collection);
+	CollectionType是所需要的容器类型
+	IteratorType继承自ForEachIterator<T>
+	必须写在vl::collections命名空间里
 ***********************************************************************/
 
-#ifndef VCZH_STREAM_COMPRESSIONSTREAM
-#define VCZH_STREAM_COMPRESSIONSTREAM
-
+#ifndef VCZH_COLLECTIONS_FOREACH
+#define VCZH_COLLECTIONS_FOREACH
 
 namespace vl
 {
-	namespace stream
+	namespace collections
 	{
 
 /***********************************************************************
-Compression
+ForEach基础设施
 ***********************************************************************/
 
-		namespace lzw
+		template<typename T>
+		class ForEachIterator : public Object
 		{
-			static const vint						BufferSize = 1024;
-			static const vint						MaxDictionarySize = 1 << 24;
+		public:
+			virtual bool				Next(T& variable)const=0;
 
-			struct Code
+			operator bool()const
 			{
-				typedef collections::PushOnlyAllocator<Code>			CodeAllocator;
-				typedef collections::ByteObjectMap<Code>::Allocator		MapAllocator;
+				return true;
+			}
+		};
 
-				vuint8_t							byte = 0;
-				vint								code = -1;
-				Code*								parent = 0;
-				vint								size = 0;
-				collections::ByteObjectMap<Code>	children;
-			};
-		}
+/***********************************************************************
+IEnumerable<T>支持
+***********************************************************************/
 
-		class LzwBase : public Object
+		template<typename T>
+		class EnumerableForEachIterator : public ForEachIterator<T>
 		{
 		protected:
-			lzw::Code::CodeAllocator				codeAllocator;
-			lzw::Code::MapAllocator					mapAllocator;
-			lzw::Code*								root;
-			vint									eofIndex = -1;
-			vint									nextIndex = 0;
-			vint									indexBits = 1;
+			Ptr<IEnumerator<T>>			enumerator;
+		public:
+			EnumerableForEachIterator(const IEnumerable<T>& enumerable)
+				:enumerator(enumerable.CreateEnumerator())
+			{
+			}
 
-			void									UpdateIndexBits();
-			lzw::Code*								CreateCode(lzw::Code* parent, vuint8_t byte);
+			EnumerableForEachIterator(const EnumerableForEachIterator<T>& enumerableIterator)
+				:enumerator(enumerableIterator.enumerator)
+			{
+			}
 
-			LzwBase();
-			LzwBase(bool (&existingBytes)[256]);
-			~LzwBase();
+			bool Next(T& variable)const
+			{
+				if(enumerator->Next())
+				{
+					variable=enumerator->Current();
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
 		};
 
-		/// <summary>An encoder to compress using Lzw algorithm.</summary>
-		class LzwEncoder : public LzwBase, public IEncoder
+		template<typename T>
+		EnumerableForEachIterator<T> CreateForEachIterator(const IEnumerable<T>& enumerable)
 		{
-		protected:
-			IStream*								stream = 0;
+			return enumerable;
+		}
 
-			vuint8_t								buffer[lzw::BufferSize];
-			vint									bufferUsedBits = 0;
-			lzw::Code*								prefix;
+/***********************************************************************
+ForEach宏
+***********************************************************************/
 
-			void									Flush();
-			void									WriteNumber(vint number, vint bitSize);
-		public:
-			/// <summary>Create an encoder.</summary>
-			LzwEncoder();
-			/// <summary>Create an encoder and tell it which byte will never appear in the data before compression.</summary>
-			/// <param name="existingBytes">An array to tell the encoder which byte will never appear in the data before compression.</param>
-			LzwEncoder(bool (&existingBytes)[256]);
-			~LzwEncoder();
-
-			void									Setup(IStream* _stream)override;
-			void									Close()override;
-			vint									Write(void* _buffer, vint _size)override;
-		};
-		
-		/// <summary>An decoder to decompress using Lzw algorithm.</summary>
-		class LzwDecoder :public LzwBase, public IDecoder
-		{
-		protected:
-			IStream*								stream = 0;
-			collections::List<lzw::Code*>			dictionary;
-			lzw::Code*								lastCode = 0;
-
-			vuint8_t								inputBuffer[lzw::BufferSize];
-			vint									inputBufferSize = 0;
-			vint									inputBufferUsedBits = 0;
-
-			collections::Array<vuint8_t>			outputBuffer;
-			vint									outputBufferSize = 0;
-			vint									outputBufferUsedBytes = 0;
-
-			bool									ReadNumber(vint& number, vint bitSize);
-			void									PrepareOutputBuffer(vint size);
-			void									ExpandCodeToOutputBuffer(lzw::Code* code);
-		public:
-			/// <summary>Create an decoder.</summary>
-			LzwDecoder();
-			/// <summary>Create an decoder and tell it which byte will never appear in the data before compression.</summary>
-			/// <param name="existingBytes">An array to tell the encoder which byte will never appear in the data before compression.</param>
-			LzwDecoder(bool (&existingBytes)[256]);
-			~LzwDecoder();
+#define FOREACH(TYPE, VARIABLE, COLLECTION)\
+		SCOPE_VARIABLE(const ForEachIterator<TYPE>&, __foreach_iterator__, CreateForEachIterator(COLLECTION))\
+		for(TYPE VARIABLE;__foreach_iterator__.Next(VARIABLE);)
 
-			void									Setup(IStream* _stream)override;
-			void									Close()override;
-			vint									Read(void* _buffer, vint _size)override;
-		};
+#define FOREACH_INDEXER(TYPE, VARIABLE, INDEXER, COLLECTION)\
+		SCOPE_VARIABLE(const ForEachIterator<TYPE>&, __foreach_iterator__, CreateForEachIterator(COLLECTION))\
+		SCOPE_VARIABLE(vint, INDEXER, 0)\
+		for(TYPE VARIABLE;__foreach_iterator__.Next(VARIABLE);INDEXER++)
 	}
 }
 
 #endif
 
 /***********************************************************************
-LOCALE.H
+REGEX\REGEX.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
-Framework::Locale
+Regex::Regular Expression
 
-Interfaces:
+Classes:
+	RegexString						：字符串匹配结果
+	RegexMatch						：匹配结果
+	Regex							：正则表达式引擎
+	RegexToken						：词法记号
+	RegexTokens						：词法记号表
+	RegexLexer						：词法分析器
 ***********************************************************************/
 
-#ifndef VCZH_LOCALE
-#define VCZH_LOCALE
+#ifndef VCZH_REGEX_REGEX
+#define VCZH_REGEX_REGEX
 
 
 namespace vl
 {
-	/// <summary>Locale awared operations. Macro "INVLOC" is a shortcut to get a invariant locale.</summary>
-	class Locale : public Object
+	namespace regex_internal
 	{
-	protected:
-		WString						localeName;
+		class PureResult;
+		class PureInterpretor;
+		class RichResult;
+		class RichInterpretor;
+	}
 
-	public:
-		Locale(const WString& _localeName=WString::Empty);
-		~Locale();
+	namespace regex
+	{
 
-		bool operator==(const Locale& value)const { return localeName==value.localeName; }
-		bool operator!=(const Locale& value)const { return localeName!=value.localeName; }
-		bool operator<(const Locale& value)const { return localeName<value.localeName; }
-		bool operator<=(const Locale& value)const { return localeName<=value.localeName; }
-		bool operator>(const Locale& value)const { return localeName>value.localeName; }
-		bool operator>=(const Locale& value)const { return localeName>=value.localeName; }
+/***********************************************************************
+正则表达式引擎数据结构
+***********************************************************************/
 
-		/// <summary>Get the invariant locale.</summary>
-		/// <returns>The invariant locale.</returns>
-		static Locale				Invariant();
-		/// <summary>Get the system default locale. This locale controls the code page that used by the the system to interpret ANSI string buffers.</summary>
-		/// <returns>The system default locale.</returns>
-		static Locale				SystemDefault();
-		/// <summary>Get the user default locale. This locale reflect the user's setting.</summary>
-		/// <returns>The user default locale.</returns>
-		static Locale				UserDefault();
-		/// <summary>Get all supported locales.</summary>
-		/// <param name="locales">All supported locales.</param>
-		static void					Enumerate(collections::List<Locale>& locales);
+		/// <summary>A type representing a fragment of the input string.</summary>
+		class RegexString : public Object
+		{
+		protected:
+			WString										value;
+			vint										start;
+			vint										length;
 
-		/// <summary>Get the name of the locale.</summary>
-		/// <returns>The name of the locale.</returns>
-		const WString&				GetName()const;
+		public:
+			RegexString(vint _start=0);
+			RegexString(const WString& _string, vint _start, vint _length);
 
-		/// <summary>Get all short date formats for the locale.</summary>
-		/// <param name="formats">The formats.</param>
-		void						GetShortDateFormats(collections::List<WString>& formats)const;
-		/// <summary>Get all long date formats for the locale.</summary>
-		/// <param name="formats">The formats.</param>
-		void						GetLongDateFormats(collections::List<WString>& formats)const;
-		/// <summary>Get all Year-Month date formats for the locale.</summary>
-		/// <param name="formats">The formats.</param>
-		void						GetYearMonthDateFormats(collections::List<WString>& formats)const;
-		/// <summary>Get all long time formats for the locale.</summary>
-		/// <param name="formats">The formats.</param>
-		void						GetLongTimeFormats(collections::List<WString>& formats)const;
-		/// <summary>Get all short time formats for the locale.</summary>
-		/// <param name="formats">The formats.</param>
-		void						GetShortTimeFormats(collections::List<WString>& formats)const;
+			/// <summary>The position of the input string.</summary>
+			/// <returns>The position.</returns>
+			vint										Start()const;
+			/// <summary>The size of the fragment in characters.</summary>
+			/// <returns>The size.</returns>
+			vint										Length()const;
+			/// <summary>Get the fragment.</summary>
+			/// <returns>The fragment.</returns>
+			const WString&								Value()const;
+			bool										operator==(const RegexString& string)const;
+		};
 
-		/// <summary>Convert a date to a formatted string.</summary>
-		/// <returns>The formatted string.</returns>
-		/// <param name="format">The format to use.</param>
-		/// <param name="date">The date to convert.</param>
-		WString						FormatDate(const WString& format, DateTime date)const;
-		/// <summary>Convert a time to a formatted string.</summary>
-		/// <returns>The formatted string.</returns>
-		/// <param name="format">The format to use.</param>
-		/// <param name="time">The time to convert.</param>
-		WString						FormatTime(const WString& format, DateTime time)const;
-#ifdef VCZH_MSVC
-		/// <summary>Convert a number to a formatted string.</summary>
-		/// <returns>The formatted string.</returns>
-		/// <param name="number">The number to convert.</param>
-		WString						FormatNumber(const WString& number)const;
-		/// <summary>Convert a currency (money) to a formatted string.</summary>
-		/// <returns>The formatted string.</returns>
-		/// <param name="currency">The currency to convert.</param>
-		WString						FormatCurrency(const WString& currency)const;
-#endif
+		/// <summary>A type representing a match of the input string.</summary>
+		class RegexMatch : public Object, private NotCopyable
+		{
+			friend class Regex;
+		public:
+			typedef Ptr<RegexMatch>										Ref;
+			typedef collections::List<Ref>								List;
+			typedef collections::List<RegexString>						CaptureList;
+			typedef collections::Group<WString, RegexString>			CaptureGroup;
+		protected:
+			collections::List<RegexString>				captures;
+			collections::Group<WString, RegexString>	groups;
+			bool										success;
+			RegexString									result;
 
-		/// <summary>Get the short display string of a day of week.</summary>
-		/// <returns>The display string.</returns>
-		/// <param name="dayOfWeek">Day of week, begins from 0 as Sunday.</param>
-		WString						GetShortDayOfWeekName(vint dayOfWeek)const;
-		/// <summary>Get the long display string of a day of week.</summary>
-		/// <returns>The display string.</returns>
-		/// <param name="dayOfWeek">Day of week, begins from 0 as Sunday.</param>
-		WString						GetLongDayOfWeekName(vint dayOfWeek)const;
-		/// <summary>Get the short display string of a month.</summary>
-		/// <returns>The display string.</returns>
-		/// <param name="month">Month, begins from 1 as January.</param>
-		WString						GetShortMonthName(vint month)const;
-		/// <summary>Get the long display string of a month.</summary>
-		/// <returns>The display string.</returns>
-		/// <param name="month">Month, begins from 1 as January.</param>
-		WString						GetLongMonthName(vint month)const;
-		
-#ifdef VCZH_MSVC
-		/// <summary>Convert characters to the full width.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToFullWidth(const WString& str)const;
-		/// <summary>Convert characters to the half width.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToHalfWidth(const WString& str)const;
-		/// <summary>Convert characters to the Hiragana.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToHiragana(const WString& str)const;
-		/// <summary>Convert characters to the Katagana.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToKatagana(const WString& str)const;
-#endif
-		
-		/// <summary>Convert characters to the lower case using the file system rule.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToLower(const WString& str)const;
-		/// <summary>Convert characters to the upper case using the file system rule.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToUpper(const WString& str)const;
-		/// <summary>Convert characters to the lower case using the linguistic rule.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToLinguisticLower(const WString& str)const;
-		/// <summary>Convert characters to the upper case using the linguistic rule.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToLinguisticUpper(const WString& str)const;
+			RegexMatch(const WString& _string, regex_internal::PureResult* _result);
+			RegexMatch(const WString& _string, regex_internal::RichResult* _result, regex_internal::RichInterpretor* _rich);
+			RegexMatch(const RegexString& _result);
+		public:
+			
+			/// <summary>Test if this match is a success match or a failed match. A failed match will only appear when calling [M:vl.regex.Regex.Split] or [M:vl.regex.Regex.Cut]. In other cases, failed matches are either not included in the result, or become null pointers.</summary>
+			/// <returns>Returns true if this match is a success match.</returns>
+			bool										Success()const;
+			/// <summary>Get the whole fragment that matches.</summary>
+			/// <returns>The whole fragment.</returns>
+			const RegexString&							Result()const;
+			/// <summary>Get all fragments that are captured.</summary>
+			/// <returns>All fragments that are captured.</returns>
+			const CaptureList&							Captures()const;
+			/// <summary>Get all fragments that are captured by named groups.</summary>
+			/// <returns>All fragments that are captured.</returns>
+			const CaptureGroup&							Groups()const;
+		};
 
-#ifdef VCZH_MSVC
-		/// <summary>Convert characters to Simplified Chinese.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToSimplifiedChinese(const WString& str)const;
-		/// <summary>Convert characters to the Traditional Chinese.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToTraditionalChinese(const WString& str)const;
-		/// <summary>Convert characters to the tile case, in which the first letter of each major word is capitalized.</summary>
-		/// <returns>The converted string.</returns>
-		/// <param name="str">The string to convert.</param>
-		WString						ToTileCase(const WString& str)const;
-#endif
+/***********************************************************************
+正则表达式引擎
+***********************************************************************/
 
-		/// <summary>Mergable flags controlling how to normalize a string.</summary>
-		enum Normalization
+		/// <summary><![CDATA[
+		/// Regular Expression. Here is a brief description of the regular expression grammar:
+		///	1) Charset:
+		///		a, [a-z], [^a-z]
+		/// 2) Functional characters:
+		///		^: the beginning of the input (DFA incompatible)
+		///		$: the end of the input (DFA incompatible)
+		///		regex1|regex2: match either regex1 or regex2
+		///	3) Escaping (both \ and / mean the next character is escaped)
+		///		Escaped characters:
+		///			\r: the CR character
+		///			\n: the LF character
+		///			\t: the tab character
+		///			\s: spacing characters (including space, \r, \n, \t)
+		///			\S: non-spacing characters
+		///			\d: [0-9]
+		///			\D: [^0-9]
+		///			\l: [a-zA-Z]
+		///			\L: [^a-zA-Z]
+		///			\w: [a-zA-Z0-9_]
+		///			\W: [^a-zA-Z0-9_]
+		///			\.: any character (this is the main different from other regex, which treat "." as any characters and "\." as the dot character)
+		///			\\, \/, \(, \), \+, \*, \?, \{, \}, \[, \], \<, \>, \^, \$, \!, \=: represents itself
+		///		Escaped characters in charset defined in a square bracket:
+		///			\r: the CR character
+		///			\n: the LF character
+		///			\t: the tab character
+		///			\-, \[, \], \\, \/, \^, \$: represents itself
+		///	4) Loops:
+		///		regex{3}: repeats 3 times
+		///		regex{3,}: repeats 3 or more times
+		///		regex{1,3}: repeats 1 to 3 times
+		///		regex?: repeats 0 or 1 times
+		///		regex*: repeats 0 or more times
+		///		regex+: repeats 1 or more times
+		///		if you add a "?" right after a loop, it means repeating as less as possible (DFA incompatible)
+		///	5) Capturing: (DFA incompatible)
+		///		(regex): No capturing, just change the operators' association
+		///		(?regex): Capture matched fragment
+		///		(?<name>regex): Capture matched fragment in a named group called "name"
+		///		(<$i>): Match the i-th captured fragment, begins from 0
+		///		(<$name;i>): Match the i-th captured fragment in the named group called "name", begins from 0
+		///		(<$name>): Match any captured fragment in the named group called "name"
+		///	6) MISC
+		///		(=regex): The prefix of the following text should match the regex, but it is not counted in the whole match (DFA incompatible)
+		///		(!regex): Any prefix of the following text should not match the regex, and it is not counted in the whole match (DFA incompatible)
+		///		(<#name>regex): Name the regex "name", and it applies here
+		///		(<&name>): Copy the named regex "name" here and apply
+		/// ]]></summary>
+		class Regex : public Object, private NotCopyable
 		{
-			/// <summary>Do nothing.</summary>
-			None=0,
-			/// <summary>Ignore case using the file system rule.</summary>
-			IgnoreCase=1,
-			/// <summary>Ignore case using the linguistic rule.</summary>
-			IgnoreCaseLinguistic=2,
-			/// <summary>Ignore the difference between between hiragana and katakana characters.</summary>
-			IgnoreKanaType=4,
-			/// <summary>Ignore nonspacing characters.</summary>
-			IgnoreNonSpace=8,
-			/// <summary>Ignore symbols and punctuation.</summary>
-			IgnoreSymbol=16,
-			/// <summary>Ignore the difference between half-width and full-width characters.</summary>
-			IgnoreWidth=32,
-			/// <summary>Treat digits as numbers during sorting.</summary>
-			DigitsAsNumbers=64,
-			/// <summary>Treat punctuation the same as symbols.</summary>
-			StringSoft=128,
-		};
+		protected:
+			regex_internal::PureInterpretor*			pure;
+			regex_internal::RichInterpretor*			rich;
 
-		/// <summary>Compare two strings.</summary>
-		/// <returns>Returns 0 if two strings are equal. Returns a positive number if the first string is larger. Returns a negative number if the second string is larger. When sorting strings, larger strings are put after then smaller strings.</returns>
-		/// <param name="s1">The first string to compare.</param>
-		/// <param name="s2">The second string to compare.</param>
-		/// <param name="normalization">Flags controlling how to normalize a string.</param>
-		vint									Compare(const WString& s1, const WString& s2, Normalization normalization)const;
-		/// <summary>Compare two strings to test binary equivalence.</summary>
-		/// <returns>Returns 0 if two strings are equal. Returns a positive number if the first string is larger. Returns a negative number if the second string is larger. When sorting strings, larger strings are put after then smaller strings.</returns>
-		/// <param name="s1">The first string to compare.</param>
-		/// <param name="s2">The second string to compare.</param>
-		vint									CompareOrdinal(const WString& s1, const WString& s2)const;
-		/// <summary>Compare two strings to test binary equivalence, ignoring case.</summary>
-		/// <returns>Returns 0 if two strings are equal. Returns a positive number if the first string is larger. Returns a negative number if the second string is larger. When sorting strings, larger strings are put after then smaller strings.</returns>
-		/// <param name="s1">The first string to compare.</param>
-		/// <param name="s2">The second string to compare.</param>
-		vint									CompareOrdinalIgnoreCase(const WString& s1, const WString& s2)const;
-		/// <summary>Find the first position that the sub string appears in a text.</summary>
-		/// <returns>Returns a pair of numbers, the first number indicating the position in the text, the second number indicating the size of the equivalence sub string in the text. For some normalization, the found sub string may be binary different to the string you want to find.</returns>
-		/// <param name="text">The text to find the sub string.</param>
-		/// <param name="find">The sub string to match.</param>
-		/// <param name="normalization">Flags controlling how to normalize a string.</param>
-		collections::Pair<vint, vint>			FindFirst(const WString& text, const WString& find, Normalization normalization)const;
-		/// <summary>Find the last position that the sub string appears in a text.</summary>
-		/// <returns>Returns a pair of numbers, the first number indicating the position in the text, the second number indicating the size of the equivalence sub string in the text. For some normalization, the found sub string may be binary different to the string you want to find.</returns>
-		/// <param name="text">The text to find the sub string.</param>
-		/// <param name="find">The sub string to match.</param>
-		/// <param name="normalization">Flags controlling how to normalize a string.</param>
-		collections::Pair<vint, vint>			FindLast(const WString& text, const WString& find, Normalization normalization)const;
-		/// <summary>Test is the prefix of the text equivalence to the provided sub string.</summary>
-		/// <returns>Returns true if the prefix of the text equivalence to the provided sub string.</returns>
-		/// <param name="text">The text to test the prefix.</param>
-		/// <param name="find">The sub string to match.</param>
-		/// <param name="normalization">Flags controlling how to normalize a string.</param>
-		bool									StartsWith(const WString& text, const WString& find, Normalization normalization)const;
-		/// <summary>Test is the postfix of the text equivalence to the provided sub string.</summary>
-		/// <returns>Returns true if the postfix of the text equivalence to the provided sub string.</returns>
-		/// <param name="text">The text to test the postfix.</param>
-		/// <param name="find">The sub string to match.</param>
-		/// <param name="normalization">Flags controlling how to normalize a string.</param>
-		bool									EndsWith(const WString& text, const WString& find, Normalization normalization)const;
-	};
+			void										Process(const WString& text, bool keepEmpty, bool keepSuccess, bool keepFail, RegexMatch::List& matches)const;
+		public:
+			/// <summary>Create a regular expression.</summary>
+			/// <param name="code">The regular expression in a string.</param>
+			/// <param name="preferPure">Set to true to tell the Regex to use DFA if possible.</param>
+			Regex(const WString& code, bool preferPure=true);
+			~Regex();
 
-#define INVLOC vl::Locale::Invariant()
-}
+			/// <summary>Test does the Regex uses DFA to match a string.</summary>
+			/// <returns>Returns true if DFA is used.</returns>
+			bool										IsPureMatch()const;
+			/// <summary>Test does the Regex uses DFA to test a string. Test means ignoring all capturing requirements.</summary>
+			/// <returns>Returns true if DFA is used.</returns>
+			bool										IsPureTest()const;
 
-#endif
+			/// <summary>Match a prefix of the text.</summary>
+			/// <returns>Returns the match. Returns null if failed.</returns>
+			/// <param name="text">The text to match.</param>
+			RegexMatch::Ref								MatchHead(const WString& text)const;
+			/// <summary>Match a fragment of the text.</summary>
+			/// <returns>Returns the match. Returns null if failed.</returns>
+			/// <param name="text">The text to match.</param>
+			RegexMatch::Ref								Match(const WString& text)const;
+			/// <summary>Match a prefix of the text, ignoring all capturing requirements.</summary>
+			/// <returns>Returns true if succeeded.</returns>
+			/// <param name="text">The text to match.</param>
+			bool										TestHead(const WString& text)const;
+			/// <summary>Match a fragment of the text, ignoring all capturing requirements.</summary>
+			/// <returns>Returns true if succeeded.</returns>
+			/// <param name="text">The text to match.</param>
+			bool										Test(const WString& text)const;
+			/// <summary>Find all matched fragments of the text, returning all matched fragments.</summary>
+			/// <param name="text">The text to match.</param>
+			/// <param name="matches">All successful matches.</param>
+			void										Search(const WString& text, RegexMatch::List& matches)const;
+			/// <summary>Split the text by matched fragments, returning all unmatched fragments.</summary>
+			/// <param name="text">The text to match.</param>
+			/// <param name="keepEmptyMatch">Set to true to keep all empty matches.</param>
+			/// <param name="matches">All failed matches.</param>
+			void										Split(const WString& text, bool keepEmptyMatch, RegexMatch::List& matches)const;
+			/// <summary>Cut the text by matched fragments, returning all matched or unmatched fragments.</summary>
+			/// <param name="text">The text to match.</param>
+			/// <param name="keepEmptyMatch">Set to true to keep all empty matches.</param>
+			/// <param name="matches">All successful and failed matches.</param>
+			void										Cut(const WString& text, bool keepEmptyMatch, RegexMatch::List& matches)const;
+		};
 
 /***********************************************************************
-EXCEPTION.H
+正则表达式词法分析器
 ***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Framework::Exception
 
-Classes:
-	Exception									：异常
-	ArgumentException							：预料的的参数错误
-***********************************************************************/
+		/// <summary>A token.</summary>
+		class RegexToken
+		{
+		public:
+			/// <summary>Position in the input string.</summary>
+			vint										start;
+			/// <summary>Size of this token in characters.</summary>
+			vint										length;
+			/// <summary>The token id, begins at 0, represents the regular expression in the list that matches this token. -1 means this token is produced by an error.</summary>
+			vint										token;
+			/// <summary>The pointer to where this token starts in the input string .</summary>
+			const wchar_t*								reading;
+			/// <summary>The argument value from [M:vl.regex.RegexLexer.Parse].</summary>
+			vint										codeIndex;
+			/// <summary>True if this token is complete. False if this token does not end here.</summary>
+			bool										completeToken;
 
-#ifndef VCZH_EXCEPTION
-#define VCZH_EXCEPTION
+			/// <summary>Row number of the first character, begins at 0.</summary>
+			vint										rowStart;
+			/// <summary>Column number of the first character, begins at 0.</summary>
+			vint										columnStart;
+			/// <summary>Row number of the last character, begins at 0.</summary>
+			vint										rowEnd;
+			/// <summary>Column number of the last character, begins at 0.</summary>
+			vint										columnEnd;
 
+			bool										operator==(const RegexToken& _token)const;
+			bool										operator==(const wchar_t* _token)const;
+		};
 
-namespace vl
-{
-	/// <summary>Base type of all exceptions.</summary>
-	class Exception : public Object
-	{
-	protected:
-		WString						message;
+		/// <summary>Token collection representing the result from the lexical analyzer.</summary>
+		class RegexTokens : public Object, public collections::IEnumerable<RegexToken>
+		{
+			friend class RegexLexer;
+		protected:
+			regex_internal::PureInterpretor*			pure;
+			const collections::Array<vint>&				stateTokens;
+			WString										code;
+			vint										codeIndex;
+			
+			RegexTokens(regex_internal::PureInterpretor* _pure, const collections::Array<vint>& _stateTokens, const WString& _code, vint _codeIndex);
+		public:
+			RegexTokens(const RegexTokens& tokens);
 
-	public:
-		Exception(const WString& _message=WString::Empty);
+			collections::IEnumerator<RegexToken>*		CreateEnumerator()const;
+
+			/// <summary>Copy all tokens.</summary>
+			/// <param name="tokens">Returns all tokens.</param>
+			/// <param name="discard">A callback to decide which kind of tokens to discard. The input is [F:vl.regex.RegexToken.token]. Returns true to discard this kind of tokens.</param>
+			void										ReadToEnd(collections::List<RegexToken>& tokens, bool(*discard)(vint)=0)const;
+		};
+		
+		/// <summary>Lexical walker.</summary>
+		class RegexLexerWalker : public Object
+		{
+			friend class RegexLexer;
+		protected:
+			regex_internal::PureInterpretor*			pure;
+			const collections::Array<vint>&				stateTokens;
+			
+			RegexLexerWalker(regex_internal::PureInterpretor* _pure, const collections::Array<vint>& _stateTokens);
+		public:
+			RegexLexerWalker(const RegexLexerWalker& walker);
+			~RegexLexerWalker();
+			
+			/// <summary>Get the start DFA state number, which represents the correct state before parsing any input.</summary>
+			/// <returns>The DFA state number.</returns>
+			vint										GetStartState()const;
+			/// <summary>Test if this state can only lead to the end of one kind of token.</summary>
+			/// <returns>Returns the token index if this state can only lead to the end of one kind of token. Returns -1 if not.</returns>
+			/// <param name="state">The DFA state number.</param>
+			vint										GetRelatedToken(vint state)const;
+			/// <summary>Step forward by one character.</summary>
+			/// <param name="input">The input character.</param>
+			/// <param name="state">The current state. Returns the new current state when this function returns.</param>
+			/// <param name="token">Returns the token index at the end of the token.</param>
+			/// <param name="finalState">Returns true if it reach the end of the token.</param>
+			/// <param name="previousTokenStop">Returns true if the last character is the end of the token.</param>
+			void										Walk(wchar_t input, vint& state, vint& token, bool& finalState, bool& previousTokenStop)const;
+			/// <summary>Step forward by one character.</summary>
+			/// <returns>Returns the new current state.</returns>
+			/// <param name="input">The input character.</param>
+			/// <param name="state">The current state.</param>
+			vint										Walk(wchar_t input, vint state)const;
+			/// <summary>Test if the input text is a complete token.</summary>
+			/// <returns>Returns true if the input text is a complete token.</returns>
+			/// <param name="input">The input text.</param>
+			/// <param name="length">Size of the input text in characters.</param>
+			bool										IsClosedToken(const wchar_t* input, vint length)const;
+			/// <summary>Test if the input is a complete token.</summary>
+			/// <returns>Returns true if the input text is a complete token.</returns>
+			/// <param name="input">The input text.</param>
+			bool										IsClosedToken(const WString& input)const;
+		};
+
+		/// <summary>Lexical colorizer.</summary>
+		class RegexLexerColorizer : public Object
+		{
+			friend class RegexLexer;
+		public:
+			typedef void(*TokenProc)(void* argument, vint start, vint length, vint token);
+
+		protected:
+			RegexLexerWalker							walker;
+			vint										currentState;
+
+			RegexLexerColorizer(const RegexLexerWalker& _walker);
+		public:
+			RegexLexerColorizer(const RegexLexerColorizer& colorizer);
+			~RegexLexerColorizer();
+
+			/// <summary>Reset the colorizer using the DFA state number.</summary>
+			/// <param name="state">The DFA state number.</param>
+			void										Reset(vint state);
+			/// <summary>Step forward by one character.</summary>
+			/// <param name="input">The input character.</param>
+			void										Pass(wchar_t input);
+			/// <summary>Get the start DFA state number, which represents the correct state before colorizing any characters.</summary>
+			/// <returns>The DFA state number.</returns>
+			vint										GetStartState()const;
+			/// <summary>Get the current DFA state number.</summary>
+			/// <returns>The DFA state number.</returns>
+			vint										GetCurrentState()const;
+			/// <summary>Colorize a text.</summary>
+			/// <param name="input">The text to colorize.</param>
+			/// <param name="length">Size of the text in characters.</param>
+			/// <param name="tokenProc">Colorizer callback. This callback will be called if any token is found..</param>
+			/// <param name="tokenProcArgument">The argument to call the callback.</param>
+			void										Colorize(const wchar_t* input, vint length, TokenProc tokenProc, void* tokenProcArgument);
+		};
+
+		/// <summary>Lexical analyzer.</summary>
+		class RegexLexer : public Object, private NotCopyable
+		{
+		protected:
+			regex_internal::PureInterpretor*			pure;
+			collections::Array<vint>					ids;
+			collections::Array<vint>					stateTokens;
+		public:
+			/// <summary>Create a lexical analyzer by a set of regular expressions. [F:vl.regex.RegexToken.token] will be the index of the matched regular expression.</summary>
+			/// <param name="tokens">The regular expressions.</param>
+			RegexLexer(const collections::IEnumerable<WString>& tokens);
+			~RegexLexer();
+
+			/// <summary>Tokenize a input text.</summary>
+			/// <returns>The result.</returns>
+			/// <param name="code">The text to tokenize.</param>
+			/// <param name="codeIndex">Extra information that will store in [F:vl.regex.RegexToken.codeIndex].</param>
+			RegexTokens									Parse(const WString& code, vint codeIndex=-1)const;
+			/// <summary>Create a equivalence walker from this lexical analyzer.</summary>
+			/// <returns>The walker.</returns>
+			RegexLexerWalker							Walk()const;
+			/// <summary>Create a equivalence colorizer from this lexical analyzer.</summary>
+			/// <returns>The colorizer.</returns>
+			RegexLexerColorizer							Colorize()const;
+		};
+	}
+}
+
+#endif
+
+/***********************************************************************
+STREAM\ACCESSOR.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Stream::Accessor
+
+Classes:
+	TextReader						：字符串阅读器
+	TextWriter						：字符串书写器
+	StreamReader					：流阅读器
+	StreamWriter					：流书写器
+	EncoderStream					：编码流
+	DecoderStream					：解码流
+***********************************************************************/
+
+#ifndef VCZH_STREAM_ACCESSOR
+#define VCZH_STREAM_ACCESSOR
+
+
+namespace vl
+{
+	namespace stream
+	{
+
+/***********************************************************************
+流控制器
+***********************************************************************/
+
+		/// <summary>Text reader. All line breaks are normalized to CRLF regardless the format in the source.</summary>
+		class TextReader : public Object, private NotCopyable
+		{
+		public:
+			/// <summary>Test does the reader reach the end or not.</summary>
+			/// <returns>Returns true if the reader reaches the end.</returns>
+			virtual bool				IsEnd()=0;
+			/// <summary>Read a single character.</summary>
+			/// <returns>The character.</returns>
+			virtual wchar_t				ReadChar()=0;
+			/// <summary>Read a string of a specified size.</summary>
+			/// <returns>The string.</returns>
+			/// <param name="length">Expected length of the string to read.</param>
+			virtual WString				ReadString(vint length);
+			/// <summary>Read a string until a line breaks is reached.</summary>
+			/// <returns>The string. It does not contain the line break.</returns>
+			virtual WString				ReadLine();
+			/// <summary>Read everying remain.</summary>
+			/// <returns>The string.</returns>
+			virtual WString				ReadToEnd();
+		};
+		
+		/// <summary>Text writer.</summary>
+		class TextWriter : public Object, private NotCopyable
+		{
+		public:
+			/// <summary>Write a single character.</summary>
+			/// <param name="c">The character to write.</param>
+			virtual void				WriteChar(wchar_t c)=0;
+			/// <summary>Write a string.</summary>
+			/// <param name="string">Buffer to the string to write.</param>
+			/// <param name="charCount">Size of the string in characters not including the zero terminator.</param>
+			virtual void				WriteString(const wchar_t* string, vint charCount);
+			/// <summary>Write a string.</summary>
+			/// <param name="string">Buffer to the zero terminated string to write.</param>
+			virtual void				WriteString(const wchar_t* string);
+			/// <summary>Write a string.</summary>
+			/// <param name="string">The string to write.</param>
+			virtual void				WriteString(const WString& string);
+			/// <summary>Write a string with a CRLF.</summary>
+			/// <param name="string">Buffer to the string to write.</param>
+			/// <param name="charCount">Size of the string in characters not including the zero terminator.</param>
+			virtual void				WriteLine(const wchar_t* string, vint charCount);
+			/// <summary>Write a string with a CRLF.</summary>
+			/// <param name="string">Buffer to the zero terminated string to write.</param>
+			virtual void				WriteLine(const wchar_t* string);
+			/// <summary>Write a string with a CRLF.</summary>
+			/// <param name="string">The string to write.</param>
+			virtual void				WriteLine(const WString& string);
+
+			virtual void				WriteMonospacedEnglishTable(collections::Array<WString>& tableByRow, vint rows, vint columns);
+		};
+
+		/// <summary>Text reader from a string.</summary>
+		class StringReader : public TextReader
+		{
+		protected:
+			WString						string;
+			vint						current;
+			bool						lastCallIsReadLine;
+
+			void						PrepareIfLastCallIsReadLine();
+		public:
+			/// <summary>Create a text reader.</summary>
+			/// <param name="_string">The string to read.</param>
+			StringReader(const WString& _string);
+
+			bool						IsEnd();
+			wchar_t						ReadChar();
+			WString						ReadString(vint length);
+			WString						ReadLine();
+			WString						ReadToEnd();
+		};
+		
+		/// <summary>Text reader from a stream.</summary>
+		class StreamReader : public TextReader
+		{
+		protected:
+			IStream*					stream;
+		public:
+			/// <summary>Create a text reader.</summary>
+			/// <param name="_stream">The stream to read.</param>
+			StreamReader(IStream& _stream);
+
+			bool						IsEnd();
+			wchar_t						ReadChar();
+		};
+		
+		/// <summary>Text writer to a stream.</summary>
+		class StreamWriter : public TextWriter
+		{
+		protected:
+			IStream*					stream;
+		public:
+			/// <summary>Create a text writer.</summary>
+			/// <param name="_stream">The stream to write.</param>
+			StreamWriter(IStream& _stream);
+			using TextWriter::WriteString;
+
+			void						WriteChar(wchar_t c);
+			void						WriteString(const wchar_t* string, vint charCount);
+		};
+
+/***********************************************************************
+编码解码
+***********************************************************************/
+
+		/// <summary>Encoder stream, a writable stream using an [T:vl.stream.IEncoder] to transform content.</summary>
+		class EncoderStream : public virtual IStream
+		{
+		protected:
+			IStream*					stream;
+			IEncoder*					encoder;
+			pos_t						position;
+
+		public:
+			/// <summary>Create a stream.</summary>
+			/// <param name="_stream">The target stream to write.</param>
+			/// <param name="_encoder">The encoder to transform content.</param>
+			EncoderStream(IStream& _stream, IEncoder& _encoder);
+			~EncoderStream();
+
+			bool						CanRead()const;
+			bool						CanWrite()const;
+			bool						CanSeek()const;
+			bool						CanPeek()const;
+			bool						IsLimited()const;
+			bool						IsAvailable()const;
+			void						Close();
+			pos_t						Position()const;
+			pos_t						Size()const;
+			void						Seek(pos_t _size);
+			void						SeekFromBegin(pos_t _size);
+			void						SeekFromEnd(pos_t _size);
+			vint						Read(void* _buffer, vint _size);
+			vint						Write(void* _buffer, vint _size);
+			vint						Peek(void* _buffer, vint _size);
+		};
+		
+		/// <summary>Decoder stream, a readable stream using an [T:vl.stream.IDecoder] to transform content.</summary>
+		class DecoderStream : public virtual IStream
+		{
+		protected:
+			IStream*					stream;
+			IDecoder*					decoder;
+			pos_t						position;
+
+		public:
+			/// <summary>Create a stream.</summary>
+			/// <param name="_stream">The target stream to read.</param>
+			/// <param name="_decoder">The decoder to transform content.</param>
+			DecoderStream(IStream& _stream, IDecoder& _decoder);
+			~DecoderStream();
+
+			bool						CanRead()const;
+			bool						CanWrite()const;
+			bool						CanSeek()const;
+			bool						CanPeek()const;
+			bool						IsLimited()const;
+			bool						IsAvailable()const;
+			void						Close();
+			pos_t						Position()const;
+			pos_t						Size()const;
+			void						Seek(pos_t _size);
+			void						SeekFromBegin(pos_t _size);
+			void						SeekFromEnd(pos_t _size);
+			vint						Read(void* _buffer, vint _size);
+			vint						Write(void* _buffer, vint _size);
+			vint						Peek(void* _buffer, vint _size);
+		};
+	}
+}
+
+#endif
+
+/***********************************************************************
+STREAM\COMPRESSIONSTREAM.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Stream::CharFormat
+
+Classes:
+***********************************************************************/
+
+#ifndef VCZH_STREAM_COMPRESSIONSTREAM
+#define VCZH_STREAM_COMPRESSIONSTREAM
+
+
+namespace vl
+{
+	namespace stream
+	{
+
+/***********************************************************************
+Compression
+***********************************************************************/
+
+		namespace lzw
+		{
+			static const vint						BufferSize = 1024;
+			static const vint						MaxDictionarySize = 1 << 24;
+
+			struct Code
+			{
+				typedef collections::PushOnlyAllocator<Code>			CodeAllocator;
+				typedef collections::ByteObjectMap<Code>::Allocator		MapAllocator;
+
+				vuint8_t							byte = 0;
+				vint								code = -1;
+				Code*								parent = 0;
+				vint								size = 0;
+				collections::ByteObjectMap<Code>	children;
+			};
+		}
+
+		class LzwBase : public Object
+		{
+		protected:
+			lzw::Code::CodeAllocator				codeAllocator;
+			lzw::Code::MapAllocator					mapAllocator;
+			lzw::Code*								root;
+			vint									eofIndex = -1;
+			vint									nextIndex = 0;
+			vint									indexBits = 1;
+
+			void									UpdateIndexBits();
+			lzw::Code*								CreateCode(lzw::Code* parent, vuint8_t byte);
+
+			LzwBase();
+			LzwBase(bool (&existingBytes)[256]);
+			~LzwBase();
+		};
+
+		/// <summary>An encoder to compress using Lzw algorithm.</summary>
+		class LzwEncoder : public LzwBase, public IEncoder
+		{
+		protected:
+			IStream*								stream = 0;
+
+			vuint8_t								buffer[lzw::BufferSize];
+			vint									bufferUsedBits = 0;
+			lzw::Code*								prefix;
+
+			void									Flush();
+			void									WriteNumber(vint number, vint bitSize);
+		public:
+			/// <summary>Create an encoder.</summary>
+			LzwEncoder();
+			/// <summary>Create an encoder and tell it which byte will never appear in the data before compression.</summary>
+			/// <param name="existingBytes">An array to tell the encoder which byte will never appear in the data before compression.</param>
+			LzwEncoder(bool (&existingBytes)[256]);
+			~LzwEncoder();
+
+			void									Setup(IStream* _stream)override;
+			void									Close()override;
+			vint									Write(void* _buffer, vint _size)override;
+		};
+		
+		/// <summary>An decoder to decompress using Lzw algorithm.</summary>
+		class LzwDecoder :public LzwBase, public IDecoder
+		{
+		protected:
+			IStream*								stream = 0;
+			collections::List<lzw::Code*>			dictionary;
+			lzw::Code*								lastCode = 0;
+
+			vuint8_t								inputBuffer[lzw::BufferSize];
+			vint									inputBufferSize = 0;
+			vint									inputBufferUsedBits = 0;
+
+			collections::Array<vuint8_t>			outputBuffer;
+			vint									outputBufferSize = 0;
+			vint									outputBufferUsedBytes = 0;
+
+			bool									ReadNumber(vint& number, vint bitSize);
+			void									PrepareOutputBuffer(vint size);
+			void									ExpandCodeToOutputBuffer(lzw::Code* code);
+		public:
+			/// <summary>Create an decoder.</summary>
+			LzwDecoder();
+			/// <summary>Create an decoder and tell it which byte will never appear in the data before compression.</summary>
+			/// <param name="existingBytes">An array to tell the encoder which byte will never appear in the data before compression.</param>
+			LzwDecoder(bool (&existingBytes)[256]);
+			~LzwDecoder();
+
+			void									Setup(IStream* _stream)override;
+			void									Close()override;
+			vint									Read(void* _buffer, vint _size)override;
+		};
+	}
+}
+
+#endif
+
+/***********************************************************************
+LOCALE.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Framework::Locale
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_LOCALE
+#define VCZH_LOCALE
+
+
+namespace vl
+{
+	/// <summary>Locale awared operations. Macro "INVLOC" is a shortcut to get a invariant locale.</summary>
+	class Locale : public Object
+	{
+	protected:
+		WString						localeName;
+
+	public:
+		Locale(const WString& _localeName=WString::Empty);
+		~Locale();
+
+		bool operator==(const Locale& value)const { return localeName==value.localeName; }
+		bool operator!=(const Locale& value)const { return localeName!=value.localeName; }
+		bool operator<(const Locale& value)const { return localeName<value.localeName; }
+		bool operator<=(const Locale& value)const { return localeName<=value.localeName; }
+		bool operator>(const Locale& value)const { return localeName>value.localeName; }
+		bool operator>=(const Locale& value)const { return localeName>=value.localeName; }
+
+		/// <summary>Get the invariant locale.</summary>
+		/// <returns>The invariant locale.</returns>
+		static Locale				Invariant();
+		/// <summary>Get the system default locale. This locale controls the code page that used by the the system to interpret ANSI string buffers.</summary>
+		/// <returns>The system default locale.</returns>
+		static Locale				SystemDefault();
+		/// <summary>Get the user default locale. This locale reflect the user's setting.</summary>
+		/// <returns>The user default locale.</returns>
+		static Locale				UserDefault();
+		/// <summary>Get all supported locales.</summary>
+		/// <param name="locales">All supported locales.</param>
+		static void					Enumerate(collections::List<Locale>& locales);
+
+		/// <summary>Get the name of the locale.</summary>
+		/// <returns>The name of the locale.</returns>
+		const WString&				GetName()const;
+
+		/// <summary>Get all short date formats for the locale.</summary>
+		/// <param name="formats">The formats.</param>
+		void						GetShortDateFormats(collections::List<WString>& formats)const;
+		/// <summary>Get all long date formats for the locale.</summary>
+		/// <param name="formats">The formats.</param>
+		void						GetLongDateFormats(collections::List<WString>& formats)const;
+		/// <summary>Get all Year-Month date formats for the locale.</summary>
+		/// <param name="formats">The formats.</param>
+		void						GetYearMonthDateFormats(collections::List<WString>& formats)const;
+		/// <summary>Get all long time formats for the locale.</summary>
+		/// <param name="formats">The formats.</param>
+		void						GetLongTimeFormats(collections::List<WString>& formats)const;
+		/// <summary>Get all short time formats for the locale.</summary>
+		/// <param name="formats">The formats.</param>
+		void						GetShortTimeFormats(collections::List<WString>& formats)const;
+
+		/// <summary>Convert a date to a formatted string.</summary>
+		/// <returns>The formatted string.</returns>
+		/// <param name="format">The format to use.</param>
+		/// <param name="date">The date to convert.</param>
+		WString						FormatDate(const WString& format, DateTime date)const;
+		/// <summary>Convert a time to a formatted string.</summary>
+		/// <returns>The formatted string.</returns>
+		/// <param name="format">The format to use.</param>
+		/// <param name="time">The time to convert.</param>
+		WString						FormatTime(const WString& format, DateTime time)const;
+#ifdef VCZH_MSVC
+		/// <summary>Convert a number to a formatted string.</summary>
+		/// <returns>The formatted string.</returns>
+		/// <param name="number">The number to convert.</param>
+		WString						FormatNumber(const WString& number)const;
+		/// <summary>Convert a currency (money) to a formatted string.</summary>
+		/// <returns>The formatted string.</returns>
+		/// <param name="currency">The currency to convert.</param>
+		WString						FormatCurrency(const WString& currency)const;
+#endif
+
+		/// <summary>Get the short display string of a day of week.</summary>
+		/// <returns>The display string.</returns>
+		/// <param name="dayOfWeek">Day of week, begins from 0 as Sunday.</param>
+		WString						GetShortDayOfWeekName(vint dayOfWeek)const;
+		/// <summary>Get the long display string of a day of week.</summary>
+		/// <returns>The display string.</returns>
+		/// <param name="dayOfWeek">Day of week, begins from 0 as Sunday.</param>
+		WString						GetLongDayOfWeekName(vint dayOfWeek)const;
+		/// <summary>Get the short display string of a month.</summary>
+		/// <returns>The display string.</returns>
+		/// <param name="month">Month, begins from 1 as January.</param>
+		WString						GetShortMonthName(vint month)const;
+		/// <summary>Get the long display string of a month.</summary>
+		/// <returns>The display string.</returns>
+		/// <param name="month">Month, begins from 1 as January.</param>
+		WString						GetLongMonthName(vint month)const;
+		
+#ifdef VCZH_MSVC
+		/// <summary>Convert characters to the full width.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToFullWidth(const WString& str)const;
+		/// <summary>Convert characters to the half width.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToHalfWidth(const WString& str)const;
+		/// <summary>Convert characters to the Hiragana.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToHiragana(const WString& str)const;
+		/// <summary>Convert characters to the Katagana.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToKatagana(const WString& str)const;
+#endif
+		
+		/// <summary>Convert characters to the lower case using the file system rule.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToLower(const WString& str)const;
+		/// <summary>Convert characters to the upper case using the file system rule.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToUpper(const WString& str)const;
+		/// <summary>Convert characters to the lower case using the linguistic rule.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToLinguisticLower(const WString& str)const;
+		/// <summary>Convert characters to the upper case using the linguistic rule.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToLinguisticUpper(const WString& str)const;
+
+#ifdef VCZH_MSVC
+		/// <summary>Convert characters to Simplified Chinese.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToSimplifiedChinese(const WString& str)const;
+		/// <summary>Convert characters to the Traditional Chinese.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToTraditionalChinese(const WString& str)const;
+		/// <summary>Convert characters to the tile case, in which the first letter of each major word is capitalized.</summary>
+		/// <returns>The converted string.</returns>
+		/// <param name="str">The string to convert.</param>
+		WString						ToTileCase(const WString& str)const;
+#endif
+
+		/// <summary>Mergable flags controlling how to normalize a string.</summary>
+		enum Normalization
+		{
+			/// <summary>Do nothing.</summary>
+			None=0,
+			/// <summary>Ignore case using the file system rule.</summary>
+			IgnoreCase=1,
+			/// <summary>Ignore case using the linguistic rule.</summary>
+			IgnoreCaseLinguistic=2,
+			/// <summary>Ignore the difference between between hiragana and katakana characters.</summary>
+			IgnoreKanaType=4,
+			/// <summary>Ignore nonspacing characters.</summary>
+			IgnoreNonSpace=8,
+			/// <summary>Ignore symbols and punctuation.</summary>
+			IgnoreSymbol=16,
+			/// <summary>Ignore the difference between half-width and full-width characters.</summary>
+			IgnoreWidth=32,
+			/// <summary>Treat digits as numbers during sorting.</summary>
+			DigitsAsNumbers=64,
+			/// <summary>Treat punctuation the same as symbols.</summary>
+			StringSoft=128,
+		};
+
+		/// <summary>Compare two strings.</summary>
+		/// <returns>Returns 0 if two strings are equal. Returns a positive number if the first string is larger. Returns a negative number if the second string is larger. When sorting strings, larger strings are put after then smaller strings.</returns>
+		/// <param name="s1">The first string to compare.</param>
+		/// <param name="s2">The second string to compare.</param>
+		/// <param name="normalization">Flags controlling how to normalize a string.</param>
+		vint									Compare(const WString& s1, const WString& s2, Normalization normalization)const;
+		/// <summary>Compare two strings to test binary equivalence.</summary>
+		/// <returns>Returns 0 if two strings are equal. Returns a positive number if the first string is larger. Returns a negative number if the second string is larger. When sorting strings, larger strings are put after then smaller strings.</returns>
+		/// <param name="s1">The first string to compare.</param>
+		/// <param name="s2">The second string to compare.</param>
+		vint									CompareOrdinal(const WString& s1, const WString& s2)const;
+		/// <summary>Compare two strings to test binary equivalence, ignoring case.</summary>
+		/// <returns>Returns 0 if two strings are equal. Returns a positive number if the first string is larger. Returns a negative number if the second string is larger. When sorting strings, larger strings are put after then smaller strings.</returns>
+		/// <param name="s1">The first string to compare.</param>
+		/// <param name="s2">The second string to compare.</param>
+		vint									CompareOrdinalIgnoreCase(const WString& s1, const WString& s2)const;
+		/// <summary>Find the first position that the sub string appears in a text.</summary>
+		/// <returns>Returns a pair of numbers, the first number indicating the position in the text, the second number indicating the size of the equivalence sub string in the text. For some normalization, the found sub string may be binary different to the string you want to find.</returns>
+		/// <param name="text">The text to find the sub string.</param>
+		/// <param name="find">The sub string to match.</param>
+		/// <param name="normalization">Flags controlling how to normalize a string.</param>
+		collections::Pair<vint, vint>			FindFirst(const WString& text, const WString& find, Normalization normalization)const;
+		/// <summary>Find the last position that the sub string appears in a text.</summary>
+		/// <returns>Returns a pair of numbers, the first number indicating the position in the text, the second number indicating the size of the equivalence sub string in the text. For some normalization, the found sub string may be binary different to the string you want to find.</returns>
+		/// <param name="text">The text to find the sub string.</param>
+		/// <param name="find">The sub string to match.</param>
+		/// <param name="normalization">Flags controlling how to normalize a string.</param>
+		collections::Pair<vint, vint>			FindLast(const WString& text, const WString& find, Normalization normalization)const;
+		/// <summary>Test is the prefix of the text equivalence to the provided sub string.</summary>
+		/// <returns>Returns true if the prefix of the text equivalence to the provided sub string.</returns>
+		/// <param name="text">The text to test the prefix.</param>
+		/// <param name="find">The sub string to match.</param>
+		/// <param name="normalization">Flags controlling how to normalize a string.</param>
+		bool									StartsWith(const WString& text, const WString& find, Normalization normalization)const;
+		/// <summary>Test is the postfix of the text equivalence to the provided sub string.</summary>
+		/// <returns>Returns true if the postfix of the text equivalence to the provided sub string.</returns>
+		/// <param name="text">The text to test the postfix.</param>
+		/// <param name="find">The sub string to match.</param>
+		/// <param name="normalization">Flags controlling how to normalize a string.</param>
+		bool									EndsWith(const WString& text, const WString& find, Normalization normalization)const;
+	};
+
+#define INVLOC vl::Locale::Invariant()
+}
+
+#endif
+
+/***********************************************************************
+EXCEPTION.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Framework::Exception
+
+Classes:
+	Exception									：异常
+	ArgumentException							：预料的的参数错误
+***********************************************************************/
+
+#ifndef VCZH_EXCEPTION
+#define VCZH_EXCEPTION
+
+
+namespace vl
+{
+	/// <summary>Base type of all exceptions.</summary>
+	class Exception : public Object
+	{
+	protected:
+		WString						message;
+
+	public:
+		Exception(const WString& _message=WString::Empty);
+
+		const WString&				Message()const;
+	};
+
+	class ArgumentException : public Exception
+	{
+	protected:
+		WString						function;
+		WString						name;
+
+	public:
+		ArgumentException(const WString& _message=WString::Empty, const WString& _function=WString::Empty, const WString& _name=WString::Empty);
+
+		const WString&				GetFunction()const;
+		const WString&				GetName()const;
+	};
+
+	class ParsingException : public Exception
+	{
+	protected:
+		vint							position;
+		WString						expression;
+
+	public:
+		ParsingException(const WString& _message, const WString& _expression, vint _position);
+
+		const WString&				GetExpression()const;
+		vint							GetPosition()const;
+	};
+}
+
+#endif
+
+/***********************************************************************
+EVENT.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Framework::Event
+
+Classes:
+	Event<function-type>									：事件对象
+***********************************************************************/
+#ifndef VCZH_EVENT
+#define VCZH_EVENT
+
+
+namespace vl
+{
+	template<typename T>
+	class Event
+	{
+	};
+ 
+	class EventHandler : public Object
+	{
+	public:
+		virtual bool							IsAttached() = 0;
+	};
+
+	/// <summary>Event.</summary>
+	/// <typeparam name="TArgs">Types of callback parameters.</typeparam>
+	template<typename ...TArgs>
+	class Event<void(TArgs...)> : public Object, private NotCopyable
+	{
+	protected:
+		class EventHandlerImpl : public EventHandler
+		{
+		public:
+			bool								attached;
+			Func<void(TArgs...)>				function;
+
+			EventHandlerImpl(const Func<void(TArgs...)>& _function)
+				:attached(true)
+				, function(_function)
+			{
+			}
+ 
+			bool IsAttached()override
+			{
+				return attached;
+			}
+		};
+ 
+		collections::SortedList<Ptr<EventHandlerImpl>>	handlers;
+	public:
+		/// <summary>Add a callback to the event.</summary>
+		/// <returns>The event handler representing the callback.</returns>
+		/// <param name="function">The callback.</param>
+		Ptr<EventHandler> Add(const Func<void(TArgs...)>& function)
+		{
+			Ptr<EventHandlerImpl> handler = new EventHandlerImpl(function);
+			handlers.Add(handler);
+			return handler;
+		}
+ 
+		/// <summary>Add a callback to the event.</summary>
+		/// <returns>The event handler representing the callback.</returns>
+		/// <param name="function">The callback.</param>
+		Ptr<EventHandler> Add(void(*function)(TArgs...))
+		{
+			return Add(Func<void(TArgs...)>(function));
+		}
+ 
+		/// <summary>Add a method callback to the event.</summary>
+		/// <typeparam name="C">Type of the class that has the method callback.</typeparam>
+		/// <returns>The event handler representing the callback.</returns>
+		/// <param name="sender">The object that has the method callback.</param>
+		/// <param name="function">The method callback.</param>
+		template<typename C>
+		Ptr<EventHandler> Add(C* sender, void(C::*function)(TArgs...))
+		{
+			return Add(Func<void(TArgs...)>(sender, function));
+		}
+ 
+		/// <summary>Remove a callback.</summary>
+		/// <returns>Returns true if this operation succeeded.</returns>
+		/// <param name="handler">The event handler representing the callback.</param>
+		bool Remove(Ptr<EventHandler> handler)
+		{
+			Ptr<EventHandlerImpl> impl = handler.Cast<EventHandlerImpl>();
+			if (!impl) return false;
+			vint index = handlers.IndexOf(impl);
+			if (index == -1) return false;
+			impl->attached = false;
+			handlers.RemoveAt(index);
+			return true;
+		}
+ 
+		/// <summary>Invoke all callbacks in the event.</summary>
+		/// <param name="args">Arguments to invoke all callbacks.</param>
+		void operator()(TArgs ...args)const
+		{
+			for(vint i = 0; i < handlers.Count(); i++)
+			{
+				handlers[i]->function(ForwardValue<TArgs>(args)...);
+			}
+		}
+	};
+}
+#endif
+
+/***********************************************************************
+COLLECTIONS\OPERATION.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Data Structure::Operations
+
+Functions:
+	CopyFrom(TargetContainer, SourceContainer)
+	[T]		.Select(T->K) => [K]
+	[T]		.SelectMany(T->[K]) => [K]
+	[T]		.Where(T->bool) => [T]
+	[Ptr<T>].Cast<K>() => [Ptr<K>]
+	[Ptr<T>].FindType<K>() => [Ptr<K>]
+	[T]		.OrderBy(T->T->int) => [T]
+
+	[T]		.Aggregate(T->T->T) => T
+	[T]		.Aggregate(T->T->T, T) => T
+	[T]		.All(T->bool) => bool
+	[T]		.Any(T->bool) => bool
+	[T]		.Max() => T
+	[T]		.Min() => T
+	[T]		.First() => T
+	[T]		.FirstOrDefault(T) => T
+	[T]		.Last() => T
+	[T]		.LastOrDefault(T) => T
+	[T]		.Count() => vint
+	[T]		.IsEmpty() => bool
+
+	[T]		.Concat([T]) => [T]
+	[T]		.Repeat(vint) => [T]
+	[T]		.Take(vint) => [T]
+	[T]		.Skip(vint) => [T]
+	[T]		.Distinct() => [T]
+	[T]		.Reverse() => [T]
+
+	[T]		.Pairwise([K]) => [(T,K)]
+	[T]		.Intersect([T]) => [T]
+	[T]		.Union([T]) => [T]
+	[T]		.Except([T]) => [T]
+
+	[T]		.Evaluate() => [T]
+	[T]		.GroupBy(T->K) => [(K, [T])]
+
+	From(begin, end) => [T]
+	From(array) => [T]
+	Range(start, count) => [vint]
+
+	FOREACH(X, a, XList)
+	FOREACH_INDEXER(X, a, index, XList)
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_OPERATION
+#define VCZH_COLLECTIONS_OPERATION
+
+
+namespace vl
+{
+	namespace collections
+	{
+
+/***********************************************************************
+OrderBy Quick Sort
+***********************************************************************/
+
+		template<typename T, typename F>
+		void SortLambda(T* items, vint length, F orderer)
+		{
+			if(length==0) return;
+			vint pivot=0;
+			vint left=0;
+			vint right=0;
+			bool flag=false;
+
+			while(left+right+1!=length)
+			{
+				vint& mine=(flag?left:right);
+				vint& theirs=(flag?right:left);
+				vint candidate=(flag?left:length-right-1);
+				vint factor=(flag?-1:1);
+
+				if(orderer(items[pivot], items[candidate])*factor<=0)
+				{
+					mine++;
+				}
+				else
+				{
+					theirs++;
+					T temp=items[pivot];
+					items[pivot]=items[candidate];
+					items[candidate]=temp;
+					pivot=candidate;
+					flag=!flag;
+				}
+			}
+
+			SortLambda(items, left, orderer);
+			SortLambda(items+left+1, right, orderer);
+		}
+
+		template<typename T>
+		void Sort(T* items, vint length, const Func<vint(T, T)>& orderer)
+		{
+			SortLambda<T, Func<vint(T, T)>>(items, length, orderer);
+		}
+
+/***********************************************************************
+LazyList
+***********************************************************************/
+
+		/// <summary>A lazy evaluated readonly container.</summary>
+		/// <typeparam name="T">The type of elements.</typeparam>
+		template<typename T>
+		class LazyList : public Object, public IEnumerable<T>
+		{
+		protected:
+			Ptr<IEnumerator<T>>			enumeratorPrototype;
+
+			template<typename U>
+			static U Element(const IEnumerable<U>&);
+
+			IEnumerator<T>* xs()const
+			{
+				return enumeratorPrototype->Clone();
+			}
+		public:
+			/// <summary>Create a lazy list with an enumerator.</summary>
+			/// <param name="enumerator">The enumerator.</param>
+			LazyList(IEnumerator<T>* enumerator)
+				:enumeratorPrototype(enumerator)
+			{
+			}
+			
+			/// <summary>Create a lazy list with an enumerator.</summary>
+			/// <param name="enumerator">The enumerator.</param>
+			LazyList(Ptr<IEnumerator<T>> enumerator)
+				:enumeratorPrototype(enumerator)
+			{
+			}
+			
+			/// <summary>Create a lazy list with an enumerable.</summary>
+			/// <param name="enumerable">The enumerator.</param>
+			LazyList(const IEnumerable<T>& enumerable)
+				:enumeratorPrototype(enumerable.CreateEnumerator())
+			{
+			}
+			
+			/// <summary>Create a lazy list with an lazy list.</summary>
+			/// <param name="lazyList">The lazy list.</param>
+			LazyList(const LazyList<T>& lazyList)
+				:enumeratorPrototype(lazyList.enumeratorPrototype)
+			{
+			}
+			
+			/// <summary>Create a lazy list with a container.</summary>
+			/// <typeparam name="TContainer">Type of the container.</typeparam>
+			/// <param name="container">The container.</param>
+			template<typename TContainer>
+			LazyList(Ptr<TContainer> container)
+				:enumeratorPrototype(new ContainerEnumerator<T, TContainer>(container))
+			{
+			}
+			
+			/// <summary>Create an empty lazy list.</summary>
+			LazyList()
+				:enumeratorPrototype(EmptyEnumerable<T>().CreateEnumerator())
+			{
+			}
+
+			LazyList<T>& operator=(const LazyList<T>& lazyList)
+			{
+				enumeratorPrototype=lazyList.enumeratorPrototype;
+				return *this;
+			}
+
+			IEnumerator<T>* CreateEnumerator()const
+			{
+				return enumeratorPrototype->Clone();
+			}
+
+			//-------------------------------------------------------
+
+			/// <summary>Create a new lazy list with all elements transformed.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="f">The lambda expression as a transformation function.</param>
+			template<typename F>
+			LazyList<FUNCTION_RESULT_TYPE(F)> Select(F f)const
+			{
+				return new SelectEnumerator<T, FUNCTION_RESULT_TYPE(F)>(xs(), f);
+			}
+			
+			/// <summary>Create a new lazy list with all elements that satisfy with a condition.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="f">The lambda expression as a filter.</param>
+			template<typename F>
+			LazyList<T> Where(F f)const
+			{
+				return new WhereEnumerator<T>(xs(), f);
+			}
+
+			/// <summary>Create a new lazy list with all elements casted to a new type.</summary>
+			/// <typeparam name="U">The new type.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			template<typename U>
+			LazyList<Ptr<U>> Cast()const
+			{
+				Func<Ptr<U>(T)> f=[](T t)->Ptr<U>{return t.template Cast<U>();};
+				return new SelectEnumerator<T, Ptr<U>>(xs(), f);
+			}
+			
+			/// <summary>Create a new lazy list with only elements that successfully casted to a new type.</summary>
+			/// <typeparam name="U">The new type.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			template<typename U>
+			LazyList<Ptr<U>> FindType()const
+			{
+				return Cast<U>().Where([](T t){return t;});
+			}
+			
+			/// <summary>Create a new lazy list with all elements sorted.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="f">The lambda expression as a comparing function.</param>
+			template<typename F>
+			LazyList<T> OrderBy(F f)const
+			{
+				Ptr<List<T>> sorted=new List<T>;
+				CopyFrom(*sorted.Obj(), *this);
+				if(sorted->Count()>0)
+				{
+					SortLambda<T, F>(&sorted->operator[](0), sorted->Count(), f);
+				}
+				return new ContainerEnumerator<T, List<T>>(sorted);
+			}
+
+			//-------------------------------------------------------
+			
+			/// <summary>Aggregate a lazy list. An exception will raise if the lazy list is empty.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The aggregated value.</returns>
+			/// <param name="f">The lambda expression as an aggregator.</param>
+			template<typename F>
+			T Aggregate(F f)const
+			{
+				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
+				if(!enumerator->Next())
+				{
+					throw Error(L"LazyList<T>::Aggregate(F)#Aggregate failed to calculate from an empty container.");
+				}
+				T result=enumerator->Current();
+				while(enumerator->Next())
+				{
+					result=f(result, enumerator->Current());
+				}
+				return result;
+			}
+			
+			/// <summary>Aggregate a lazy list.</summary>
+			/// <typeparam name="I">Type of the initial value.</typeparam>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The aggregated value.</returns>
+			/// <param name="init">The initial value that is virtually added before the lazy list.</param>
+			/// <param name="f">The lambda expression as an aggregator.</param>
+			template<typename I, typename F>
+			I Aggregate(I init, F f)const
+			{
+				FOREACH(T, t, *this)
+				{
+					init=f(init, t);
+				}
+				return init;
+			}
+
+			/// <summary>Test does all elements in the lazy list satisfy with a condition.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>Returns true if all elements satisfy with a condition.</returns>
+			/// <param name="f">The lambda expression as a filter.</param>
+			template<typename F>
+			bool All(F f)const
+			{
+				return Select(f).Aggregate(true, [](bool a, bool b){return a&&b;});
+			}
+			
+			/// <summary>Test does any elements in the lazy list satisfy with a condition.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>Returns true if at least one element satisfies with a condition.</returns>
+			/// <param name="f">The lambda expression as a filter.</param>
+			template<typename F>
+			bool Any(F f)const
+			{
+				return Select(f).Aggregate(false, [](bool a, bool b){return a||b;});
+			}
+
+			/// <summary>Get the maximum value in the lazy list. An exception will raise if the lazy list is empty.</summary>
+			/// <returns>The maximum value.</returns>
+			T Max()const
+			{
+				return Aggregate([](T a, T b){return a>b?a:b;});
+			}
+			
+			/// <summary>Get the minimum value in the lazy list. An exception will raise if the lazy list is empty.</summary>
+			/// <returns>The minimum value.</returns>
+			T Min()const
+			{
+				return Aggregate([](T a, T b){return a<b?a:b;});
+			}
+			
+			/// <summary>Get the first value in the lazy list. An exception will raise if the lazy list is empty.</summary>
+			/// <returns>The first value.</returns>
+			T First()const
+			{
+				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
+				if(!enumerator->Next())
+				{
+					throw Error(L"LazyList<T>::First(F)#First failed to calculate from an empty container.");
+				}
+				return enumerator->Current();
+			}
+			
+			/// <summary>Get the first value in the lazy list.</summary>
+			/// <returns>The first value.</returns>
+			/// <param name="defaultValue">Returns this argument if the lazy list is empty.</param>
+			T First(T defaultValue)const
+			{
+				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
+				if(!enumerator->Next())
+				{
+					return defaultValue;
+				}
+				return enumerator->Current();
+			}
+			
+			/// <summary>Get the last value in the lazy list. An exception will raise if the lazy list is empty.</summary>
+			/// <returns>The last value.</returns>
+			T Last()const
+			{
+				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
+				if(!enumerator->Next())
+				{
+					throw Error(L"LazyList<T>::Last(F)#Last failed to calculate from an empty container.");
+				}
+				else
+				{
+					T value=enumerator->Current();
+					while(enumerator->Next())
+					{
+						value=enumerator->Current();
+					}
+					return value;
+				}
+			}
+			
+			/// <summary>Get the last value in the lazy list.</summary>
+			/// <returns>The last value.</returns>
+			/// <param name="defaultValue">Returns this argument if the lazy list is empty.</param>
+			T Last(T defaultValue)const
+			{
+				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
+				while(enumerator->Next())
+				{
+					defaultValue=enumerator->Current();
+				}
+				return defaultValue;
+			}
 
-		const WString&				Message()const;
-	};
+			/// <summary>Get the number of elements in the lazy list.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				vint result=0;
+				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
+				while(enumerator->Next())
+				{
+					result++;
+				}
+				return result;
+			}
 
-	class ArgumentException : public Exception
-	{
-	protected:
-		WString						function;
-		WString						name;
+			/// <summary>Test is the lazy list empty.</summary>
+			/// <returns>Returns true if the lazy list is empty.</returns>
+			bool IsEmpty()const
+			{
+				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
+				return enumerator->Next();
+			}
 
-	public:
-		ArgumentException(const WString& _message=WString::Empty, const WString& _function=WString::Empty, const WString& _name=WString::Empty);
+			//-------------------------------------------------------
 
-		const WString&				GetFunction()const;
-		const WString&				GetName()const;
-	};
+			/// <summary>Create a new lazy list containing elements of the two container one after another.</summary>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="remains">Elements that put after this lazy list.</param>
+			LazyList<T> Concat(const IEnumerable<T>& remains)const
+			{
+				return new ConcatEnumerator<T>(xs(), remains.CreateEnumerator());
+			}
 
-	class ParsingException : public Exception
-	{
-	protected:
-		vint							position;
-		WString						expression;
+			/// <summary>Create a new lazy list with some prefix elements.</summary>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="count">The size of the prefix.</param>
+			LazyList<T> Take(vint count)const
+			{
+				return new TakeEnumerator<T>(xs(), count);
+			}
+			
+			/// <summary>Create a new lazy list without some prefix elements.</summary>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="count">The size of the prefix.</param>
+			LazyList<T> Skip(vint count)const
+			{
+				return new SkipEnumerator<T>(xs(), count);
+			}
 
-	public:
-		ParsingException(const WString& _message, const WString& _expression, vint _position);
+			/// <summary>Create a new lazy list with several copies of this lazy list one after another.</summary>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="count">The numbers of copies.</param>
+			LazyList<T> Repeat(vint count)const
+			{
+				return new RepeatEnumerator<T>(xs(), count);
+			}
 
-		const WString&				GetExpression()const;
-		vint							GetPosition()const;
-	};
-}
+			/// <summary>Create a new lazy list with all elements in this lazy list. If some elements appear several times, only one will be kept.</summary>
+			/// <returns>The created lazy list.</returns>
+			LazyList<T> Distinct()const
+			{
+				return new DistinctEnumerator<T>(xs());
+			}
 
-#endif
+			/// <summary>Create a new lazy list with all elements in this lazy list in a reverse order.</summary>
+			/// <returns>The created lazy list.</returns>
+			LazyList<T> Reverse()const
+			{
+				return new ReverseEnumerator<T>(*this);
+			}
 
-/***********************************************************************
-EVENT.H
-***********************************************************************/
-/***********************************************************************
-Vczh Library++ 3.0
-Developer: Zihan Chen(vczh)
-Framework::Event
+			//-------------------------------------------------------
 
-Classes:
-	Event<function-type>									：事件对象
-***********************************************************************/
-#ifndef VCZH_EVENT
-#define VCZH_EVENT
+			/// <summary>Create a new lazy list of pairs from elements from two containers.</summary>
+			/// <typeparam name="U">Type of all elements in the second container.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="remains">The second container.</param>
+			template<typename U>
+			LazyList<Pair<T, U>> Pairwise(const IEnumerable<U>& remains)const
+			{
+				return new PairwiseEnumerator<T, U>(xs(), remains.CreateEnumerator());
+			}
 
+			/// <summary>Create a new lazy list with only elements that appear in both containers.</summary>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="remains">The second container.</param>
+			LazyList<T> Intersect(const IEnumerable<T>& remains)const
+			{
+				return LazyList<T>(new IntersectExceptEnumerator<T, true>(xs(), remains)).Distinct();
+			}
+			
+			/// <summary>Create a new lazy list with only elements that appear in this lazy list but not in another container.</summary>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="remains">The second container.</param>
+			LazyList<T> Except(const IEnumerable<T>& remains)const
+			{
+				return LazyList<T>(new IntersectExceptEnumerator<T, false>(xs(), remains)).Distinct();
+			}
+			
+			/// <summary>Create a new lazy list with elements in two containers. If some elements appear several times, only one will be kept.</summary>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="remains">The second container.</param>
+			LazyList<T> Union(const IEnumerable<T>& remains)const
+			{
+				return Concat(remains).Distinct();
+			}
 
-namespace vl
-{
-	template<typename T>
-	class Event
-	{
-	};
- 
-	class EventHandler : public Object
-	{
-	public:
-		virtual bool							IsAttached() = 0;
-	};
+			//-------------------------------------------------------
 
-	/// <summary>Event.</summary>
-	/// <typeparam name="TArgs">Types of callback parameters.</typeparam>
-	template<typename ...TArgs>
-	class Event<void(TArgs...)> : public Object, private NotCopyable
-	{
-	protected:
-		class EventHandlerImpl : public EventHandler
-		{
-		public:
-			bool								attached;
-			Func<void(TArgs...)>				function;
+			LazyList<T> Evaluate()const
+			{
+				if(enumeratorPrototype->Evaluated())
+				{
+					return *this;
+				}
+				else
+				{
+					Ptr<List<T>> xs=new List<T>;
+					CopyFrom(*xs.Obj(), *this);
+					return xs;
+				}
+			}
 
-			EventHandlerImpl(const Func<void(TArgs...)>& _function)
-				:attached(true)
-				, function(_function)
+			/// <summary>Create a new lazy list, whose elements are from transformed elements in this lazy list.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="f">The lambda expression as a transformation function to transform one element to multiple elements.</param>
+			template<typename F>
+			FUNCTION_RESULT_TYPE(F) SelectMany(F f)const
 			{
+				typedef FUNCTION_RESULT_TYPE(F) LazyListU;
+				typedef typename LazyListU::ElementType U;
+				return Select(f).Aggregate(LazyList<U>(), [](const LazyList<U>& a, const IEnumerable<U>& b)->LazyList<U>{return a.Concat(b);});
 			}
- 
-			bool IsAttached()override
+
+			/// <summary>Create a new lazy list, whose elements are groupd by from elements in this lazy list.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The created lazy list.</returns>
+			/// <param name="f">The lambda expression as a key retriver to calcuate a key from an element.</param>
+			template<typename F>
+			LazyList<Pair<FUNCTION_RESULT_TYPE(F), LazyList<T>>> GroupBy(F f)const
 			{
-				return attached;
+				typedef FUNCTION_RESULT_TYPE(F) K;
+				return Select(f)
+					.Distinct()
+					.Select([=](K k)
+					{
+						return Pair<K, LazyList<T>>(
+							k,
+							Where([=](T t){return k==f(t);})
+							);
+					});
 			}
 		};
- 
-		collections::SortedList<Ptr<EventHandlerImpl>>	handlers;
-	public:
-		/// <summary>Add a callback to the event.</summary>
-		/// <returns>The event handler representing the callback.</returns>
-		/// <param name="function">The callback.</param>
-		Ptr<EventHandler> Add(const Func<void(TArgs...)>& function)
+
+		template<typename T>
+		LazyList<T> Range(T start, T count)
 		{
-			Ptr<EventHandlerImpl> handler = new EventHandlerImpl(function);
-			handlers.Add(handler);
-			return handler;
+			return new RangeEnumerator<T>(start, count);
 		}
- 
-		/// <summary>Add a callback to the event.</summary>
-		/// <returns>The event handler representing the callback.</returns>
-		/// <param name="function">The callback.</param>
-		Ptr<EventHandler> Add(void(*function)(TArgs...))
+
+		template<typename T>
+		LazyList<T> From(const IEnumerable<T>& enumerable)
 		{
-			return Add(Func<void(TArgs...)>(function));
+			return enumerable;
 		}
- 
-		/// <summary>Add a method callback to the event.</summary>
-		/// <typeparam name="C">Type of the class that has the method callback.</typeparam>
-		/// <returns>The event handler representing the callback.</returns>
-		/// <param name="sender">The object that has the method callback.</param>
-		/// <param name="function">The method callback.</param>
-		template<typename C>
-		Ptr<EventHandler> Add(C* sender, void(C::*function)(TArgs...))
+
+		template<typename T>
+		LazyList<T> From(const LazyList<T>& enumerable)
 		{
-			return Add(Func<void(TArgs...)>(sender, function));
+			return enumerable;
 		}
- 
-		/// <summary>Remove a callback.</summary>
-		/// <returns>Returns true if this operation succeeded.</returns>
-		/// <param name="handler">The event handler representing the callback.</param>
-		bool Remove(Ptr<EventHandler> handler)
+
+		template<typename T>
+		LazyList<T> From(const T* begin, const T* end)
 		{
-			Ptr<EventHandlerImpl> impl = handler.Cast<EventHandlerImpl>();
-			if (!impl) return false;
-			vint index = handlers.IndexOf(impl);
-			if (index == -1) return false;
-			impl->attached = false;
-			handlers.RemoveAt(index);
-			return true;
+			return FromPointer(begin, end);
+		}
+
+		template<typename T, int size>
+		LazyList<T> From(T (&items)[size])
+		{
+			return FromArray(items);
 		}
- 
-		/// <summary>Invoke all callbacks in the event.</summary>
-		/// <param name="args">Arguments to invoke all callbacks.</param>
-		void operator()(TArgs ...args)const
+
+		template<typename T, int size>
+		LazyList<T> From(const T (&items)[size])
 		{
-			for(vint i = 0; i < handlers.Count(); i++)
-			{
-				handlers[i]->function(ForwardValue<TArgs>(args)...);
-			}
+			return FromArray(items);
 		}
-	};
+	}
 }
+
 #endif
 
 /***********************************************************************
-COLLECTIONS\OPERATION.H
+COLLECTIONS\OPERATIONPIPELINE.H
 ***********************************************************************/
 /***********************************************************************
 Vczh Library++ 3.0
 Developer: Zihan Chen(vczh)
 Data Structure::Operations
 
-Functions:
-	CopyFrom(TargetContainer, SourceContainer)
-	[T]		.Select(T->K) => [K]
-	[T]		.SelectMany(T->[K]) => [K]
-	[T]		.Where(T->bool) => [T]
-	[Ptr<T>].Cast<K>() => [Ptr<K>]
-	[Ptr<T>].FindType<K>() => [Ptr<K>]
-	[T]		.OrderBy(T->T->int) => [T]
-
-	[T]		.Aggregate(T->T->T) => T
-	[T]		.Aggregate(T->T->T, T) => T
-	[T]		.All(T->bool) => bool
-	[T]		.Any(T->bool) => bool
-	[T]		.Max() => T
-	[T]		.Min() => T
-	[T]		.First() => T
-	[T]		.FirstOrDefault(T) => T
-	[T]		.Last() => T
-	[T]		.LastOrDefault(T) => T
-	[T]		.Count() => vint
-	[T]		.IsEmpty() => bool
-
-	[T]		.Concat([T]) => [T]
-	[T]		.Repeat(vint) => [T]
-	[T]		.Take(vint) => [T]
-	[T]		.Skip(vint) => [T]
-	[T]		.Distinct() => [T]
-	[T]		.Reverse() => [T]
-
-	[T]		.Pairwise([K]) => [(T,K)]
-	[T]		.Intersect([T]) => [T]
-	[T]		.Union([T]) => [T]
-	[T]		.Except([T]) => [T]
-
-	[T]		.Evaluate() => [T]
-	[T]		.GroupBy(T->K) => [(K, [T])]
-
-	From(begin, end) => [T]
-	From(array) => [T]
-	Range(start, count) => [vint]
-
-	FOREACH(X, a, XList)
-	FOREACH_INDEXER(X, a, index, XList)
+Classes:
+	Pipeline<TSource>							：融合的惰性操作
 ***********************************************************************/
 
-#ifndef VCZH_COLLECTIONS_OPERATION
-#define VCZH_COLLECTIONS_OPERATION
+#ifndef VCZH_COLLECTIONS_OPERATIONPIPELINE
+#define VCZH_COLLECTIONS_OPERATIONPIPELINE
 
 
 namespace vl
 {
 	namespace collections
 	{
+		template<typename TSource>
+		class Pipeline;
 
 /***********************************************************************
-OrderBy Quick Sort
+Pipeline Stages
 ***********************************************************************/
 
-		template<typename T, typename F>
-		void SortLambda(T* items, vint length, F orderer)
+		namespace pipeline_internal
 		{
-			if(length==0) return;
-			vint pivot=0;
-			vint left=0;
-			vint right=0;
-			bool flag=false;
-
-			while(left+right+1!=length)
+			template<typename TContainer>
+			class ContainerSource
 			{
-				vint& mine=(flag?left:right);
-				vint& theirs=(flag?right:left);
-				vint candidate=(flag?left:length-right-1);
-				vint factor=(flag?-1:1);
-
-				if(orderer(items[pivot], items[candidate])*factor<=0)
+			public:
+				typedef typename TContainer::ElementType	ElementType;
+			private:
+				const TContainer*				container;
+				vint							index;
+			public:
+				ContainerSource(const TContainer* _container)
+					:container(_container)
+					,index(-1)
 				{
-					mine++;
 				}
-				else
+
+				bool Next()
 				{
-					theirs++;
-					T temp=items[pivot];
-					items[pivot]=items[candidate];
-					items[candidate]=temp;
-					pivot=candidate;
-					flag=!flag;
+					if(index<container->Count()) index++;
+					return index<container->Count();
 				}
-			}
-
-			SortLambda(items, left, orderer);
-			SortLambda(items+left+1, right, orderer);
-		}
-
-		template<typename T>
-		void Sort(T* items, vint length, const Func<vint(T, T)>& orderer)
-		{
-			SortLambda<T, Func<vint(T, T)>>(items, length, orderer);
-		}
-
-/***********************************************************************
-LazyList
-***********************************************************************/
-
-		/// <summary>A lazy evaluated readonly container.</summary>
-		/// <typeparam name="T">The type of elements.</typeparam>
-		template<typename T>
-		class LazyList : public Object, public IEnumerable<T>
-		{
-		protected:
-			Ptr<IEnumerator<T>>			enumeratorPrototype;
 
-			template<typename U>
-			static U Element(const IEnumerable<U>&);
+				const ElementType& Current()const
+				{
+					return container->Get(index);
+				}
+			};
 
-			IEnumerator<T>* xs()const
-			{
-				return enumeratorPrototype->Clone();
-			}
-		public:
-			/// <summary>Create a lazy list with an enumerator.</summary>
-			/// <param name="enumerator">The enumerator.</param>
-			LazyList(IEnumerator<T>* enumerator)
-				:enumeratorPrototype(enumerator)
-			{
-			}
-			
-			/// <summary>Create a lazy list with an enumerator.</summary>
-			/// <param name="enumerator">The enumerator.</param>
-			LazyList(Ptr<IEnumerator<T>> enumerator)
-				:enumeratorPrototype(enumerator)
-			{
-			}
-			
-			/// <summary>Create a lazy list with an enumerable.</summary>
-			/// <param name="enumerable">The enumerator.</param>
-			LazyList(const IEnumerable<T>& enumerable)
-				:enumeratorPrototype(enumerable.CreateEnumerator())
-			{
-			}
-			
-			/// <summary>Create a lazy list with an lazy list.</summary>
-			/// <param name="lazyList">The lazy list.</param>
-			LazyList(const LazyList<T>& lazyList)
-				:enumeratorPrototype(lazyList.enumeratorPrototype)
-			{
-			}
-			
-			/// <summary>Create a lazy list with a container.</summary>
-			/// <typeparam name="TContainer">Type of the container.</typeparam>
-			/// <param name="container">The container.</param>
-			template<typename TContainer>
-			LazyList(Ptr<TContainer> container)
-				:enumeratorPrototype(new ContainerEnumerator<T, TContainer>(container))
-			{
-			}
-			
-			/// <summary>Create an empty lazy list.</summary>
-			LazyList()
-				:enumeratorPrototype(EmptyEnumerable<T>().CreateEnumerator())
+			template<typename T>
+			class EnumerableSource
 			{
-			}
+			public:
+				typedef T						ElementType;
+			private:
+				Ptr<IEnumerator<T>>				enumerator;
+			public:
+				EnumerableSource(IEnumerator<T>* _enumerator)
+					:enumerator(_enumerator)
+				{
+				}
 
-			LazyList<T>& operator=(const LazyList<T>& lazyList)
-			{
-				enumeratorPrototype=lazyList.enumeratorPrototype;
-				return *this;
-			}
+				EnumerableSource(const EnumerableSource<T>& source)
+					:enumerator(source.enumerator->Clone())
+				{
+				}
 
-			IEnumerator<T>* CreateEnumerator()const
-			{
-				return enumeratorPrototype->Clone();
-			}
+				EnumerableSource<T>& operator=(const EnumerableSource<T>& source)
+				{
+					enumerator=source.enumerator->Clone();
+					return *this;
+				}
 
-			//-------------------------------------------------------
+				bool Next()
+				{
+					return enumerator->Next();
+				}
 
-			/// <summary>Create a new lazy list with all elements transformed.</summary>
-			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="f">The lambda expression as a transformation function.</param>
-			template<typename F>
-			LazyList<FUNCTION_RESULT_TYPE(F)> Select(F f)const
-			{
-				return new SelectEnumerator<T, FUNCTION_RESULT_TYPE(F)>(xs(), f);
-			}
-			
-			/// <summary>Create a new lazy list with all elements that satisfy with a condition.</summary>
-			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="f">The lambda expression as a filter.</param>
-			template<typename F>
-			LazyList<T> Where(F f)const
-			{
-				return new WhereEnumerator<T>(xs(), f);
-			}
+				const T& Current()const
+				{
+					return enumerator->Current();
+				}
+			};
 
-			/// <summary>Create a new lazy list with all elements casted to a new type.</summary>
-			/// <typeparam name="U">The new type.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			template<typename U>
-			LazyList<Ptr<U>> Cast()const
-			{
-				Func<Ptr<U>(T)> f=[](T t)->Ptr<U>{return t.template Cast<U>();};
-				return new SelectEnumerator<T, Ptr<U>>(xs(), f);
-			}
-			
-			/// <summary>Create a new lazy list with only elements that successfully casted to a new type.</summary>
-			/// <typeparam name="U">The new type.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			template<typename U>
-			LazyList<Ptr<U>> FindType()const
-			{
-				return Cast<U>().Where([](T t){return t;});
-			}
-			
-			/// <summary>Create a new lazy list with all elements sorted.</summary>
-			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="f">The lambda expression as a comparing function.</param>
-			template<typename F>
-			LazyList<T> OrderBy(F f)const
+			template<typename T>
+			class RangeSource
 			{
-				Ptr<List<T>> sorted=new List<T>;
-				CopyFrom(*sorted.Obj(), *this);
-				if(sorted->Count()>0)
+			public:
+				typedef T						ElementType;
+			private:
+				T								start;
+				T								count;
+				T								index;
+				T								current;
+			public:
+				RangeSource(T _start, T _count)
+					:start(_start)
+					,count(_count)
+					,index(-1)
+					,current(_start)
+				{
+				}
+
+				bool Next()
+				{
+					if(index<count) index++;
+					current=start+index;
+					return index<count;
+				}
+
+				const T& Current()const
 				{
-					SortLambda<T, F>(&sorted->operator[](0), sorted->Count(), f);
+					return current;
 				}
-				return new ContainerEnumerator<T, List<T>>(sorted);
-			}
+			};
 
-			//-------------------------------------------------------
-			
-			/// <summary>Aggregate a lazy list. An exception will raise if the lazy list is empty.</summary>
-			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>The aggregated value.</returns>
-			/// <param name="f">The lambda expression as an aggregator.</param>
-			template<typename F>
-			T Aggregate(F f)const
+			// the transformed value is kept in the stage so that Current could return a reference, which requires the result type to be default constructible and copy assignable, the same as LazyList<T>::Select
+			template<typename TPrev, typename F>
+			class SelectStage
 			{
-				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
-				if(!enumerator->Next())
+			public:
+				typedef typename RemoveCVR<FUNCTION_RESULT_TYPE(F)>::Type		ElementType;
+			private:
+				TPrev							prev;
+				F								selector;
+				ElementType						current;
+			public:
+				SelectStage(const TPrev& _prev, const F& _selector)
+					:prev(_prev)
+					,selector(_selector)
 				{
-					throw Error(L"LazyList<T>::Aggregate(F)#Aggregate failed to calculate from an empty container.");
 				}
-				T result=enumerator->Current();
-				while(enumerator->Next())
+
+				bool Next()
 				{
-					result=f(result, enumerator->Current());
+					if(prev.Next())
+					{
+						current=selector(prev.Current());
+						return true;
+					}
+					return false;
 				}
-				return result;
-			}
-			
-			/// <summary>Aggregate a lazy list.</summary>
-			/// <typeparam name="I">Type of the initial value.</typeparam>
-			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>The aggregated value.</returns>
-			/// <param name="init">The initial value that is virtually added before the lazy list.</param>
-			/// <param name="f">The lambda expression as an aggregator.</param>
-			template<typename I, typename F>
-			I Aggregate(I init, F f)const
-			{
-				FOREACH(T, t, *this)
+
+				const ElementType& Current()const
 				{
-					init=f(init, t);
+					return current;
 				}
-				return init;
-			}
+			};
 
-			/// <summary>Test does all elements in the lazy list satisfy with a condition.</summary>
-			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>Returns true if all elements satisfy with a condition.</returns>
-			/// <param name="f">The lambda expression as a filter.</param>
-			template<typename F>
-			bool All(F f)const
-			{
-				return Select(f).Aggregate(true, [](bool a, bool b){return a&&b;});
-			}
-			
-			/// <summary>Test does any elements in the lazy list satisfy with a condition.</summary>
-			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>Returns true if at least one element satisfies with a condition.</returns>
-			/// <param name="f">The lambda expression as a filter.</param>
-			template<typename F>
-			bool Any(F f)const
+			template<typename TPrev, typename F>
+			class WhereStage
 			{
-				return Select(f).Aggregate(false, [](bool a, bool b){return a||b;});
-			}
+			public:
+				typedef typename TPrev::ElementType	ElementType;
+			private:
+				TPrev							prev;
+				F								selector;
+			public:
+				WhereStage(const TPrev& _prev, const F& _selector)
+					:prev(_prev)
+					,selector(_selector)
+				{
+				}
 
-			/// <summary>Get the maximum value in the lazy list. An exception will raise if the lazy list is empty.</summary>
-			/// <returns>The maximum value.</returns>
-			T Max()const
-			{
-				return Aggregate([](T a, T b){return a>b?a:b;});
-			}
-			
-			/// <summary>Get the minimum value in the lazy list. An exception will raise if the lazy list is empty.</summary>
-			/// <returns>The minimum value.</returns>
-			T Min()const
-			{
-				return Aggregate([](T a, T b){return a<b?a:b;});
-			}
-			
-			/// <summary>Get the first value in the lazy list. An exception will raise if the lazy list is empty.</summary>
-			/// <returns>The first value.</returns>
-			T First()const
-			{
-				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
-				if(!enumerator->Next())
+				bool Next()
 				{
-					throw Error(L"LazyList<T>::First(F)#First failed to calculate from an empty container.");
+					while(prev.Next())
+					{
+						if(selector(prev.Current()))
+						{
+							return true;
+						}
+					}
+					return false;
 				}
-				return enumerator->Current();
-			}
-			
-			/// <summary>Get the first value in the lazy list.</summary>
-			/// <returns>The first value.</returns>
-			/// <param name="defaultValue">Returns this argument if the lazy list is empty.</param>
-			T First(T defaultValue)const
-			{
-				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
-				if(!enumerator->Next())
+
+				const ElementType& Current()const
 				{
-					return defaultValue;
+					return prev.Current();
 				}
-				return enumerator->Current();
-			}
-			
-			/// <summary>Get the last value in the lazy list. An exception will raise if the lazy list is empty.</summary>
-			/// <returns>The last value.</returns>
-			T Last()const
+			};
+
+			template<typename TPrev>
+			class SkipStage
 			{
-				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
-				if(!enumerator->Next())
+			public:
+				typedef typename TPrev::ElementType	ElementType;
+			private:
+				TPrev							prev;
+				vint							count;
+			public:
+				SkipStage(const TPrev& _prev, vint _count)
+					:prev(_prev)
+					,count(_count)
 				{
-					throw Error(L"LazyList<T>::Last(F)#Last failed to calculate from an empty container.");
 				}
-				else
+
+				bool Next()
 				{
-					T value=enumerator->Current();
-					while(enumerator->Next())
+					while(count>0)
 					{
-						value=enumerator->Current();
+						count--;
+						if(!prev.Next()) return false;
 					}
-					return value;
+					return prev.Next();
 				}
-			}
-			
-			/// <summary>Get the last value in the lazy list.</summary>
-			/// <returns>The last value.</returns>
-			/// <param name="defaultValue">Returns this argument if the lazy list is empty.</param>
-			T Last(T defaultValue)const
-			{
-				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
-				while(enumerator->Next())
+
+				const ElementType& Current()const
 				{
-					defaultValue=enumerator->Current();
+					return prev.Current();
 				}
-				return defaultValue;
-			}
+			};
 
-			/// <summary>Get the number of elements in the lazy list.</summary>
-			/// <returns>The number of elements.</returns>
-			vint Count()const
+			template<typename TPrev>
+			class TakeStage
 			{
-				vint result=0;
-				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
-				while(enumerator->Next())
+			public:
+				typedef typename TPrev::ElementType	ElementType;
+			private:
+				TPrev							prev;
+				vint							count;
+			public:
+				TakeStage(const TPrev& _prev, vint _count)
+					:prev(_prev)
+					,count(_count)
 				{
-					result++;
 				}
-				return result;
-			}
 
-			/// <summary>Test is the lazy list empty.</summary>
-			/// <returns>Returns true if the lazy list is empty.</returns>
-			bool IsEmpty()const
-			{
-				Ptr<IEnumerator<T>> enumerator=CreateEnumerator();
-				return enumerator->Next();
-			}
+				bool Next()
+				{
+					if(count<=0) return false;
+					count--;
+					return prev.Next();
+				}
 
-			//-------------------------------------------------------
+				const ElementType& Current()const
+				{
+					return prev.Current();
+				}
+			};
 
-			/// <summary>Create a new lazy list containing elements of the two container one after another.</summary>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="remains">Elements that put after this lazy list.</param>
-			LazyList<T> Concat(const IEnumerable<T>& remains)const
+			template<typename TSource>
+			class PipelineEnumerator : public Object, public virtual IEnumerator<typename TSource::ElementType>
 			{
-				return new ConcatEnumerator<T>(xs(), remains.CreateEnumerator());
-			}
+				typedef typename TSource::ElementType	T;
+			protected:
+				TSource							prototype;
+				Ptr<TSource>					source;
+				vint							index;
+			public:
+				PipelineEnumerator(const TSource& _prototype, const TSource& _source, vint _index=-1)
+					:prototype(_prototype)
+					,source(new TSource(_source))
+					,index(_index)
+				{
+				}
 
-			/// <summary>Create a new lazy list with some prefix elements.</summary>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="count">The size of the prefix.</param>
-			LazyList<T> Take(vint count)const
+				IEnumerator<T>* Clone()const override
+				{
+					return new PipelineEnumerator<TSource>(prototype, *source.Obj(), index);
+				}
+
+				const T& Current()const override
+				{
+					return source->Current();
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next()override
+				{
+					if(source->Next())
+					{
+						index++;
+						return true;
+					}
+					return false;
+				}
+
+				void Reset()override
+				{
+					// stages may contain lambda expressions, which cannot be assigned
+					source=new TSource(prototype);
+					index=-1;
+				}
+			};
+
+			template<typename Ds, typename TSource, bool CanResize>
+			struct CopyFromPipeline
 			{
-				return new TakeEnumerator<T>(xs(), count);
-			}
-			
-			/// <summary>Create a new lazy list without some prefix elements.</summary>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="count">The size of the prefix.</param>
-			LazyList<T> Skip(vint count)const
+				static void Perform(Ds& ds, const TSource& ss, bool append)
+				{
+					if(!append)
+					{
+						ds.Clear();
+					}
+					TSource reading=ss;
+					while(reading.Next())
+					{
+						randomaccess_internal::RandomAccess<Ds>::AppendValue(ds, reading.Current());
+					}
+				}
+			};
+
+			template<typename Ds, typename TSource>
+			struct CopyFromPipeline<Ds, TSource, true>
 			{
-				return new SkipEnumerator<T>(xs(), count);
-			}
+				static void Perform(Ds& ds, const TSource& ss, bool append)
+				{
+					vint copyCount=0;
+					{
+						TSource reading=ss;
+						while(reading.Next())
+						{
+							copyCount++;
+						}
+					}
 
-			/// <summary>Create a new lazy list with several copies of this lazy list one after another.</summary>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="count">The numbers of copies.</param>
-			LazyList<T> Repeat(vint count)const
+					vint index=(append?randomaccess_internal::RandomAccess<Ds>::GetCount(ds):0);
+					randomaccess_internal::RandomAccess<Ds>::SetCount(ds, index+copyCount);
+
+					TSource reading=ss;
+					while(reading.Next())
+					{
+						randomaccess_internal::RandomAccess<Ds>::SetValue(ds, index++, reading.Current());
+					}
+				}
+			};
+		}
+
+/***********************************************************************
+Pipeline
+***********************************************************************/
+
+		/// <summary>A lazy evaluated readonly sequence like <see cref="LazyList`1"/>. All chained operations are fused into one loop at compile time, no enumerator is allocated and no virtual function is called for each element, unless the source is an <see cref="IEnumerable`1"/>.</summary>
+		/// <typeparam name="TSource">The type of the fused operations.</typeparam>
+		template<typename TSource>
+		class Pipeline : public Object
+		{
+		public:
+			typedef typename TSource::ElementType		ElementType;
+		protected:
+			TSource										source;
+		public:
+			/// <summary>Create a pipeline.</summary>
+			/// <param name="_source">The fused operations.</param>
+			Pipeline(const TSource& _source)
+				:source(_source)
 			{
-				return new RepeatEnumerator<T>(xs(), count);
 			}
 
-			/// <summary>Create a new lazy list with all elements in this lazy list. If some elements appear several times, only one will be kept.</summary>
-			/// <returns>The created lazy list.</returns>
-			LazyList<T> Distinct()const
+			/// <summary>Get a copy of the fused operations, which is ready to enumerate all elements by calling Next and Current.</summary>
+			/// <returns>The fused operations.</returns>
+			TSource CreateSource()const
 			{
-				return new DistinctEnumerator<T>(xs());
+				return source;
 			}
 
-			/// <summary>Create a new lazy list with all elements in this lazy list in a reverse order.</summary>
+			/// <summary>Create a lazy list that enumerates the same elements.</summary>
 			/// <returns>The created lazy list.</returns>
-			LazyList<T> Reverse()const
+			LazyList<ElementType> ToLazyList()const
 			{
-				return new ReverseEnumerator<T>(*this);
+				return new pipeline_internal::PipelineEnumerator<TSource>(source, source);
 			}
 
 			//-------------------------------------------------------
 
-			/// <summary>Create a new lazy list of pairs from elements from two containers.</summary>
-			/// <typeparam name="U">Type of all elements in the second container.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="remains">The second container.</param>
-			template<typename U>
-			LazyList<Pair<T, U>> Pairwise(const IEnumerable<U>& remains)const
+			/// <summary>Create a new pipeline with all elements transformed. The result type of the transformation function should be default constructible and copy assignable.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The created pipeline.</returns>
+			/// <param name="f">The lambda expression as a transformation function.</param>
+			template<typename F>
+			Pipeline<pipeline_internal::SelectStage<TSource, F>> Select(F f)const
 			{
-				return new PairwiseEnumerator<T, U>(xs(), remains.CreateEnumerator());
+				return pipeline_internal::SelectStage<TSource, F>(source, f);
 			}
-
-			/// <summary>Create a new lazy list with only elements that appear in both containers.</summary>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="remains">The second container.</param>
-			LazyList<T> Intersect(const IEnumerable<T>& remains)const
+			
+			/// <summary>Create a new pipeline with all elements that satisfy with a condition.</summary>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The created pipeline.</returns>
+			/// <param name="f">The lambda expression as a filter.</param>
+			template<typename F>
+			Pipeline<pipeline_internal::WhereStage<TSource, F>> Where(F f)const
 			{
-				return LazyList<T>(new IntersectExceptEnumerator<T, true>(xs(), remains)).Distinct();
+				return pipeline_internal::WhereStage<TSource, F>(source, f);
 			}
-			
-			/// <summary>Create a new lazy list with only elements that appear in this lazy list but not in another container.</summary>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="remains">The second container.</param>
-			LazyList<T> Except(const IEnumerable<T>& remains)const
+
+			/// <summary>Create a new pipeline with some prefix elements.</summary>
+			/// <returns>The created pipeline.</returns>
+			/// <param name="count">The size of the prefix.</param>
+			Pipeline<pipeline_internal::TakeStage<TSource>> Take(vint count)const
 			{
-				return LazyList<T>(new IntersectExceptEnumerator<T, false>(xs(), remains)).Distinct();
+				return pipeline_internal::TakeStage<TSource>(source, count);
 			}
-			
-			/// <summary>Create a new lazy list with elements in two containers. If some elements appear several times, only one will be kept.</summary>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="remains">The second container.</param>
-			LazyList<T> Union(const IEnumerable<T>& remains)const
+
+			/// <summary>Create a new pipeline without some prefix elements.</summary>
+			/// <returns>The created pipeline.</returns>
+			/// <param name="count">The size of the prefix.</param>
+			Pipeline<pipeline_internal::SkipStage<TSource>> Skip(vint count)const
 			{
-				return Concat(remains).Distinct();
+				return pipeline_internal::SkipStage<TSource>(source, count);
 			}
 
 			//-------------------------------------------------------
 
-			LazyList<T> Evaluate()const
+			/// <summary>Aggregate a pipeline.</summary>
+			/// <typeparam name="I">Type of the initial value.</typeparam>
+			/// <typeparam name="F">Type of the lambda expression.</typeparam>
+			/// <returns>The aggregated value.</returns>
+			/// <param name="init">The initial value that is virtually added before the pipeline.</param>
+			/// <param name="f">The lambda expression as an aggregator.</param>
+			template<typename I, typename F>
+			I Aggregate(I init, F f)const
 			{
-				if(enumeratorPrototype->Evaluated())
-				{
-					return *this;
-				}
-				else
+				TSource reading=source;
+				while(reading.Next())
 				{
-					Ptr<List<T>> xs=new List<T>;
-					CopyFrom(*xs.Obj(), *this);
-					return xs;
+					init=f(init, reading.Current());
 				}
+				return init;
 			}
 
-			/// <summary>Create a new lazy list, whose elements are from transformed elements in this lazy list.</summary>
+			/// <summary>Test does all elements in the pipeline satisfy with a condition. Elements after the first unsatisfied one are not evaluated.</summary>
 			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="f">The lambda expression as a transformation function to transform one element to multiple elements.</param>
+			/// <returns>Returns true if all elements satisfy with a condition.</returns>
+			/// <param name="f">The lambda expression as a filter.</param>
 			template<typename F>
-			FUNCTION_RESULT_TYPE(F) SelectMany(F f)const
+			bool All(F f)const
 			{
-				typedef FUNCTION_RESULT_TYPE(F) LazyListU;
-				typedef typename LazyListU::ElementType U;
-				return Select(f).Aggregate(LazyList<U>(), [](const LazyList<U>& a, const IEnumerable<U>& b)->LazyList<U>{return a.Concat(b);});
+				TSource reading=source;
+				while(reading.Next())
+				{
+					if(!f(reading.Current())) return false;
+				}
+				return true;
 			}
-
-			/// <summary>Create a new lazy list, whose elements are groupd by from elements in this lazy list.</summary>
+			
+			/// <summary>Test does any elements in the pipeline satisfy with a condition. Elements after the first satisfied one are not evaluated.</summary>
 			/// <typeparam name="F">Type of the lambda expression.</typeparam>
-			/// <returns>The created lazy list.</returns>
-			/// <param name="f">The lambda expression as a key retriver to calcuate a key from an element.</param>
+			/// <returns>Returns true if at least one element satisfies with a condition.</returns>
+			/// <param name="f">The lambda expression as a filter.</param>
 			template<typename F>
-			LazyList<Pair<FUNCTION_RESULT_TYPE(F), LazyList<T>>> GroupBy(F f)const
+			bool Any(F f)const
 			{
-				typedef FUNCTION_RESULT_TYPE(F) K;
-				return Select(f)
-					.Distinct()
-					.Select([=](K k)
-					{
-						return Pair<K, LazyList<T>>(
-							k,
-							Where([=](T t){return k==f(t);})
-							);
-					});
+				TSource reading=source;
+				while(reading.Next())
+				{
+					if(f(reading.Current())) return true;
+				}
+				return false;
+			}
+			
+			/// <summary>Get the first value in the pipeline. An exception will raise if the pipeline is empty.</summary>
+			/// <returns>The first value.</returns>
+			ElementType First()const
+			{
+				TSource reading=source;
+				if(!reading.Next())
+				{
+					throw Error(L"Pipeline<TSource>::First()#First failed to calculate from an empty container.");
+				}
+				return reading.Current();
+			}
+			
+			/// <summary>Get the first value in the pipeline.</summary>
+			/// <returns>The first value.</returns>
+			/// <param name="defaultValue">Returns this argument if the pipeline is empty.</param>
+			ElementType First(ElementType defaultValue)const
+			{
+				TSource reading=source;
+				if(!reading.Next())
+				{
+					return defaultValue;
+				}
+				return reading.Current();
+			}
+
+			/// <summary>Get the number of elements in the pipeline.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				vint result=0;
+				TSource reading=source;
+				while(reading.Next())
+				{
+					result++;
+				}
+				return result;
+			}
+
+			/// <summary>Test is the pipeline empty.</summary>
+			/// <returns>Returns true if the pipeline is empty.</returns>
+			bool IsEmpty()const
+			{
+				TSource reading=source;
+				return !reading.Next();
 			}
 		};
 
-		template<typename T>
-		LazyList<T> Range(T start, T count)
-		{
-			return new RangeEnumerator<T>(start, count);
-		}
+/***********************************************************************
+Pipeline Sources
+***********************************************************************/
 
+		/// <summary>Create a pipeline from an <see cref="Array`2"/>, a <see cref="List`2"/> or a <see cref="SortedList`2"/>. Elements are read by index without virtual functions. The container should be alive when the pipeline is evaluated. Other containers like <see cref="Dictionary`4"/> are enumerated as an <see cref="IEnumerable`1"/>.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <returns>The created pipeline.</returns>
+		/// <param name="container">The container.</param>
 		template<typename T>
-		LazyList<T> From(const IEnumerable<T>& enumerable)
+		Pipeline<pipeline_internal::ContainerSource<ArrayBase<T>>> PipelineFrom(const ArrayBase<T>& container)
 		{
-			return enumerable;
+			return pipeline_internal::ContainerSource<ArrayBase<T>>(&container);
 		}
 
+		/// <summary>Create a pipeline from an enumerable. Only the source is enumerated via virtual functions.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <returns>The created pipeline.</returns>
+		/// <param name="enumerable">The enumerable.</param>
 		template<typename T>
-		LazyList<T> From(const LazyList<T>& enumerable)
+		Pipeline<pipeline_internal::EnumerableSource<T>> PipelineFrom(const IEnumerable<T>& enumerable)
 		{
-			return enumerable;
+			return pipeline_internal::EnumerableSource<T>(enumerable.CreateEnumerator());
 		}
 
 		template<typename T>
-		LazyList<T> From(const T* begin, const T* end)
+		Pipeline<pipeline_internal::EnumerableSource<T>> PipelineFrom(const LazyList<T>& enumerable)
 		{
-			return FromPointer(begin, end);
+			return pipeline_internal::EnumerableSource<T>(enumerable.CreateEnumerator());
 		}
 
-		template<typename T, int size>
-		LazyList<T> From(T (&items)[size])
+		/// <summary>Create a pipeline of consecutive numbers.</summary>
+		/// <typeparam name="T">Type of numbers.</typeparam>
+		/// <returns>The created pipeline.</returns>
+		/// <param name="start">The first number.</param>
+		/// <param name="count">The number of numbers.</param>
+		template<typename T>
+		Pipeline<pipeline_internal::RangeSource<T>> PipelineRange(T start, T count)
 		{
-			return FromArray(items);
+			return pipeline_internal::RangeSource<T>(start, count);
 		}
 
-		template<typename T, int size>
-		LazyList<T> From(const T (&items)[size])
+		/// <summary>Copy all elements in a pipeline to a container.</summary>
+		/// <typeparam name="Ds">Type of the destination container.</typeparam>
+		/// <typeparam name="TSource">Type of the fused operations.</typeparam>
+		/// <param name="ds">The destination container.</param>
+		/// <param name="ss">The source pipeline.</param>
+		/// <param name="append">Set to false to delete everything in the destination container before copying.</param>
+		template<typename Ds, typename TSource>
+		void CopyFrom(Ds& ds, const Pipeline<TSource>& ss, bool append=false)
 		{
-			return FromArray(items);
+			pipeline_internal::CopyFromPipeline<Ds, TSource, randomaccess_internal::RandomAccessable<Ds>::CanResize>::Perform(ds, ss.CreateSource(), append);
 		}
 	}
 }
@@ -8565,17 +9982,45 @@ Value
 					/// <summary>The value stored using a string.</summary>
 					Text,
 				};
+
+				/// <summary>Representing how a primitive value is stored without being formatted to a string. A value with a primitive storage is still a <see cref="ValueType::Text"/> value, the text is created when it is required.</summary>
+				enum class PrimitiveType
+				{
+					/// <summary>The value is not stored as a primitive value.</summary>
+					None,
+					/// <summary>The value is stored as a signed integer.</summary>
+					SignedInteger,
+					/// <summary>The value is stored as an unsigned integer.</summary>
+					UnsignedInteger,
+					/// <summary>The value is stored as a floating point number.</summary>
+					Float,
+					/// <summary>The value is stored as a boolean.</summary>
+					Boolean,
+				};
 			protected:
+				union PrimitiveStorage
+				{
+					vint64_t					signedInteger;
+					vuint64_t					unsignedInteger;
+					double						floatingPoint;
+					bool						boolean;
+				};
+
 				ValueType						valueType;
 				DescriptableObject*				rawPtr;
 				Ptr<DescriptableObject>			sharedPtr;
-				WString							text;
+				mutable WString					text;
+				mutable volatile long			textState;
 				ITypeDescriptor*				typeDescriptor;
+				PrimitiveType					primitiveType;
+				PrimitiveStorage				primitive;
 
 				Value(DescriptableObject* value);
 				Value(Ptr<DescriptableObject> value);
 				Value(const WString& value, ITypeDescriptor* associatedTypeDescriptor);
+				Value(PrimitiveType type, PrimitiveStorage value, ITypeDescriptor* associatedTypeDescriptor);
 
+				void							CreatePrimitiveText()const;
 				vint							Compare(const Value& a, const Value& b)const;
 			public:
 				Value();
@@ -8597,9 +10042,24 @@ Value
 				/// <summary>Get the stored shared pointer if possible.</summary>
 				/// <returns>The stored shared pointer. Returns null if failed.</returns>
 				Ptr<DescriptableObject>			GetSharedPtr()const;
-				/// <summary>Get the stored text if possible.</summary>
+				/// <summary>Get the stored text if possible. If the value is stored as a primitive value, the text is created and cached at the first call, it is safe to call this function on the same value from multiple threads.</summary>
 				/// <returns>The stored text. Returns empty if failed.</returns>
 				const WString&					GetText()const;
+				/// <summary>Get how the primitive value is stored.</summary>
+				/// <returns>How the primitive value is stored. Returns <see cref="PrimitiveType::None"/> if the value is not stored as a primitive value.</returns>
+				PrimitiveType					GetPrimitiveType()const;
+				/// <summary>Get the stored signed integer if possible.</summary>
+				/// <returns>The stored signed integer. Returns 0 if failed.</returns>
+				vint64_t						GetSignedInteger()const;
+				/// <summary>Get the stored unsigned integer if possible.</summary>
+				/// <returns>The stored unsigned integer. Returns 0 if failed.</returns>
+				vuint64_t						GetUnsignedInteger()const;
+				/// <summary>Get the stored floating point number if possible.</summary>
+				/// <returns>The stored floating point number. Returns 0 if failed.</returns>
+				double							GetFloat()const;
+				/// <summary>Get the stored boolean if possible.</summary>
+				/// <returns>The stored boolean. Returns false if failed.</returns>
+				bool							GetBoolean()const;
 				/// <summary>Get the real type of the stored object.</summary>
 				/// <returns>The real type. Returns null if the value is null.</returns>
 				ITypeDescriptor*				GetTypeDescriptor()const;
@@ -8621,6 +10081,26 @@ Value
 				/// <param name="value">The text to store.</param>
 				/// <param name="type">The type that you expect to interpret the text.</param>
 				static Value					From(const WString& value, ITypeDescriptor* type);
+				/// <summary>Store a signed integer without formatting it to a text.</summary>
+				/// <returns>The boxed value.</returns>
+				/// <param name="value">The signed integer to store.</param>
+				/// <param name="type">The type that you expect to interpret the value.</param>
+				static Value					FromSignedInteger(vint64_t value, ITypeDescriptor* type);
+				/// <summary>Store an unsigned integer without formatting it to a text.</summary>
+				/// <returns>The boxed value.</returns>
+				/// <param name="value">The unsigned integer to store.</param>
+				/// <param name="type">The type that you expect to interpret the value.</param>
+				static Value					FromUnsignedInteger(vuint64_t value, ITypeDescriptor* type);
+				/// <summary>Store a floating point number without formatting it to a text.</summary>
+				/// <returns>The boxed value.</returns>
+				/// <param name="value">The floating point number to store.</param>
+				/// <param name="type">The type that you expect to interpret the value.</param>
+				static Value					FromFloat(double value, ITypeDescriptor* type);
+				/// <summary>Store a boolean without formatting it to a text.</summary>
+				/// <returns>The boxed value.</returns>
+				/// <param name="value">The boolean to store.</param>
+				/// <param name="type">The type that you expect to interpret the value.</param>
+				static Value					FromBoolean(bool value, ITypeDescriptor* type);
 
 				static IMethodInfo*				SelectMethod(IMethodGroupInfo* methodGroup, collections::Array<Value>& arguments);
 				static Value					Create(ITypeDescriptor* type);
@@ -10752,10 +12232,7 @@ GeneralValueSerializer
 					T value;
 					if(Deserialize(input, value))
 					{
-						WString text;
-						Serialize(value, text);
-						output = Value::From(text, ownedTypeDescriptor);
-						return true;
+						return Serialize(value, output);
 					}
 					return false;
 				}
@@ -10818,6 +12295,108 @@ TypedValueSerializer
 			{
 			};
 
+			template<typename T>
+			struct TypedValuePrimitiveProvider
+			{
+				static bool Box(const T& input, ITypeDescriptor* type, Value& output)
+				{
+					return false;
+				}
+
+				static bool Unbox(const Value& input, T& output)
+				{
+					return false;
+				}
+			};
+
+			template<typename T, vint64_t MinValue, vint64_t MaxValue>
+			struct SignedValuePrimitiveProvider
+			{
+				static bool Box(const T& input, ITypeDescriptor* type, Value& output)
+				{
+					output = Value::FromSignedInteger(input, type);
+					return true;
+				}
+
+				static bool Unbox(const Value& input, T& output)
+				{
+					if (input.GetPrimitiveType() != Value::PrimitiveType::SignedInteger) return false;
+					vint64_t value = input.GetSignedInteger();
+					if (value < MinValue || value > MaxValue) return false;
+					output = (T)value;
+					return true;
+				}
+			};
+
+			template<typename T, vuint64_t MaxValue>
+			struct UnsignedValuePrimitiveProvider
+			{
+				static bool Box(const T& input, ITypeDescriptor* type, Value& output)
+				{
+					output = Value::FromUnsignedInteger(input, type);
+					return true;
+				}
+
+				static bool Unbox(const Value& input, T& output)
+				{
+					if (input.GetPrimitiveType() != Value::PrimitiveType::UnsignedInteger) return false;
+					vuint64_t value = input.GetUnsignedInteger();
+					if (value > MaxValue) return false;
+					output = (T)value;
+					return true;
+				}
+			};
+
+			template<> struct TypedValuePrimitiveProvider<vint8_t> : SignedValuePrimitiveProvider<vint8_t, _I8_MIN, _I8_MAX> {};
+			template<> struct TypedValuePrimitiveProvider<vint16_t> : SignedValuePrimitiveProvider<vint16_t, _I16_MIN, _I16_MAX> {};
+			template<> struct TypedValuePrimitiveProvider<vint32_t> : SignedValuePrimitiveProvider<vint32_t, _I32_MIN, _I32_MAX> {};
+			template<> struct TypedValuePrimitiveProvider<vint64_t> : SignedValuePrimitiveProvider<vint64_t, _I64_MIN, _I64_MAX> {};
+			template<> struct TypedValuePrimitiveProvider<vuint8_t> : UnsignedValuePrimitiveProvider<vuint8_t, _UI8_MAX> {};
+			template<> struct TypedValuePrimitiveProvider<vuint16_t> : UnsignedValuePrimitiveProvider<vuint16_t, _UI16_MAX> {};
+			template<> struct TypedValuePrimitiveProvider<vuint32_t> : UnsignedValuePrimitiveProvider<vuint32_t, _UI32_MAX> {};
+			template<> struct TypedValuePrimitiveProvider<vuint64_t> : UnsignedValuePrimitiveProvider<vuint64_t, _UI64_MAX> {};
+
+			template<>
+			struct TypedValuePrimitiveProvider<double>
+			{
+				static bool Box(const double& input, ITypeDescriptor* type, Value& output)
+				{
+					output = Value::FromFloat(input, type);
+					return true;
+				}
+
+				static bool Unbox(const Value& input, double& output)
+				{
+					if (input.GetPrimitiveType() != Value::PrimitiveType::Float) return false;
+					output = input.GetFloat();
+					return true;
+				}
+			};
+
+			template<>
+			struct TypedValuePrimitiveProvider<float>
+			{
+				static bool Box(const float& input, ITypeDescriptor* type, Value& output);
+				static bool Unbox(const Value& input, float& output);
+			};
+
+			template<>
+			struct TypedValuePrimitiveProvider<bool>
+			{
+				static bool Box(const bool& input, ITypeDescriptor* type, Value& output)
+				{
+					output = Value::FromBoolean(input, type);
+					return true;
+				}
+
+				static bool Unbox(const Value& input, bool& output)
+				{
+					if (input.GetPrimitiveType() != Value::PrimitiveType::Boolean) return false;
+					output = input.GetBoolean();
+					return true;
+				}
+			};
+
 			template<typename T>
 			class TypedValueSerializer : public GeneralValueSerializer<T>
 			{
@@ -10844,6 +12423,24 @@ TypedValueSerializer
 					, defaultValue(_defaultValue)
 				{
 				}
+
+				bool Serialize(const T& input, Value& output)override
+				{
+					if (TypedValuePrimitiveProvider<T>::Box(input, this->ownedTypeDescriptor, output))
+					{
+						return true;
+					}
+					return GeneralValueSerializer<T>::Serialize(input, output);
+				}
+
+				bool Deserialize(const Value& input, T& output)override
+				{
+					if (TypedValuePrimitiveProvider<T>::Unbox(input, output))
+					{
+						return true;
+					}
+					return GeneralValueSerializer<T>::Deserialize(input, output);
+				}
 			};
 
 			template<typename T>
@@ -11341,6 +12938,7 @@ MethodInfoImpl
 				collections::List<Ptr<IParameterInfo>>	parameters;
 				Ptr<ITypeInfo>							returnInfo;
 				bool									isStatic;
+				WString									cppInvokeTemplate;
 
 				virtual Value							InvokeInternal(const Value& thisObject, collections::Array<Value>& arguments)=0;
 				virtual Value							CreateFunctionProxyInternal(const Value& thisObject) = 0;
@@ -11361,6 +12959,13 @@ MethodInfoImpl
 				Value									CreateFunctionProxy(const Value& thisObject)override;
 				bool									AddParameter(Ptr<IParameterInfo> parameter);
 				bool									SetOwnerMethodgroup(IMethodGroupInfo* _ownerMethodGroup);
+
+				/// <summary>Get the C++ expression that calls this method, used by code generators to call the method without boxing arguments. $This is replaced by the object pointer, $Type by the C++ type name of the owner type, $Arguments by unboxed arguments. An empty string means the method cannot be called directly.</summary>
+				/// <returns>The C++ expression.</returns>
+				const WString&							GetCppInvokeTemplate();
+				/// <summary>Set the C++ expression that calls this method.</summary>
+				/// <param name="_cppInvokeTemplate">The C++ expression.</param>
+				void									SetCppInvokeTemplate(const WString& _cppInvokeTemplate);
 			};
 
 /***********************************************************************
@@ -14195,6 +15800,7 @@ Method
 						vl::function_lambda::LambdaRetriveType<FUNCTIONTYPE>::FunctionType\
 						>\
 					(parameterNames, (FUNCTIONTYPE)&ClassType::FUNCTIONNAME);\
+				methodInfo->SetCppInvokeTemplate(L"$This->" L ## #FUNCTIONNAME L"($Arguments)");\
 				AddMethod(\
 					L ## #EXPECTEDNAME,\
 					methodInfo\
@@ -14228,7 +15834,18 @@ Static Method
 			}
 
 #define CLASS_MEMBER_STATIC_METHOD_OVERLOAD(FUNCTIONNAME, PARAMETERNAMES, FUNCTIONTYPE)\
-			CLASS_MEMBER_STATIC_EXTERNALMETHOD(FUNCTIONNAME, PROTECT_PARAMETERS(PARAMETERNAMES), FUNCTIONTYPE, (FUNCTIONTYPE)&ClassType::FUNCTIONNAME)
+			{\
+				const wchar_t* parameterNames[]=PARAMETERNAMES;\
+				auto methodInfo = new CustomStaticMethodInfoImpl<\
+						vl::function_lambda::FunctionObjectRetriveType<FUNCTIONTYPE>::FunctionType\
+						>\
+					(parameterNames, (FUNCTIONTYPE)&ClassType::FUNCTIONNAME);\
+				methodInfo->SetCppInvokeTemplate(L"$Type::" L ## #FUNCTIONNAME L"($Arguments)");\
+				AddMethod(\
+					L ## #FUNCTIONNAME,\
+					methodInfo\
+					);\
+			}
 
 #define CLASS_MEMBER_STATIC_METHOD(FUNCTIONNAME, PARAMETERNAMES)\
 			CLASS_MEMBER_STATIC_METHOD_OVERLOAD(FUNCTIONNAME, PROTECT_PARAMETERS(PARAMETERNAMES), decltype(&ClassType::FUNCTIONNAME))
@@ -17190,6 +18807,10 @@ namespace vl
 		}
 
 #ifdef VCZH_GCC
+		/// <summary>Set the number of worker threads. Each worker owns a task queue and steals tasks from other workers when its own queue is empty. It only works before the first task is queued.</summary>
+		/// <returns>Returns true if this operation succeeded.</returns>
+		/// <param name="count">The number of worker threads. Set to 0 to use the default number, which is 4 times the number of processors, because tasks are allowed to block.</param>
+		static bool									SetWorkerCount(vint count);
 		static bool									Stop(bool discardPendingTasks);
 #endif
 	};
@@ -17921,13 +19542,34 @@ namespace vl
 			static const vint	SupportedCharCount = 0x110000;		// UTF-32
 #endif
 
-			vint				charMap[SupportedCharCount];		// char -> char set index
+			static const vint	CharBlockBits = 8;
+			static const vint	CharBlockSize = 1 << CharBlockBits;
+
+			vint				charMap[CharBlockSize];				// char in the first block -> char set index
+			vint*				charBlocks;							// (block offset + char index in the block) -> char set index, identical blocks are shared
+			vint*				charBlockOffsets;					// block -> block offset
+			vint				charBlockCount;
 			vint**				transition;							// (state * char set index) -> state*
 			bool*				finalState;							// state -> bool
 			vint*				relatedFinalState;					// sate -> (finalState or -1)
 			vint				stateCount;
 			vint				charSetCount;
 			vint				startState;
+
+			vint GetCharIndex(wchar_t input)
+			{
+				vuint code = (vuint)input;
+				if (code < (vuint)CharBlockSize)
+				{
+					return charMap[code];
+				}
+				vuint block = code >> CharBlockBits;
+				if (block < (vuint)charBlockCount)
+				{
+					return charBlocks[charBlockOffsets[block] + (code & (CharBlockSize - 1))];
+				}
+				return charSetCount - 1;
+			}
 		public:
 			PureInterpretor(Automaton::Ref dfa, CharRange::List& subsets);
 			~PureInterpretor();
@@ -20,6 +20,156 @@ namespace vl
 		namespace runtime
 		{
 
+/***********************************************************************
+WfRuntimeNativeModule
+***********************************************************************/
+
+			SpinLock nativeModuleLock;
+			WfRuntimeNativeModule* firstNativeModule = nullptr;
+
+			vuint64_t GetAssemblyChecksum(WfAssembly* assembly)
+			{
+				vuint64_t checksum = 14695981039346656037ULL;
+				auto hash = [&](vint64_t value)
+				{
+					checksum = (checksum ^ (vuint64_t)value) * 1099511628211ULL;
+				};
+
+				hash(assembly->functions.Count());
+				FOREACH(Ptr<WfAssemblyFunction>, function, assembly->functions)
+				{
+					hash(function->firstInstruction);
+					hash(function->lastInstruction);
+					hash(function->argumentNames.Count());
+					hash(function->capturedVariableNames.Count());
+					hash(function->localVariableNames.Count());
+				}
+
+				auto hashName = [&](const WString& name)
+				{
+					for (vint i = 0; i < name.Length(); i++)
+					{
+						hash(name[i]);
+					}
+				};
+
+				auto hashValue = [&](const Value& value)
+				{
+					// constants are part of the generated code, so literals must change the checksum
+					hash((vint64_t)value.GetValueType());
+					if (auto td = value.GetTypeDescriptor())
+					{
+						hashName(td->GetTypeName());
+					}
+					if (value.GetValueType() == Value::Text)
+					{
+						hashName(value.GetText());
+					}
+				};
+
+				auto hashOwner = [&](ITypeDescriptor* td)
+				{
+					if (td)
+					{
+						hashName(td->GetTypeName());
+					}
+				};
+
+				auto hashMethod = [&](IMethodInfo* method)
+				{
+					// native functions call the selected overload directly, so the owner type and parameter types are also hashed
+					hashOwner(method->GetOwnerTypeDescriptor());
+					hashName(method->GetName());
+					for (vint i = 0; i < method->GetParameterCount(); i++)
+					{
+						hashName(method->GetParameter(i)->GetType()->GetTypeFriendlyName());
+					}
+				};
+
+				hash(assembly->instructions.Count());
+				FOREACH(WfInstruction, ins, assembly->instructions)
+				{
+					hash((vint64_t)ins.code);
+					switch (ins.code)
+					{
+#define HASH(NAME)
+#define HASH_VALUE(NAME)							case WfInsCode::NAME: hashValue(ins.valueParameter); break;
+#define HASH_FUNCTION(NAME)							case WfInsCode::NAME: hash(ins.indexParameter); break;
+#define HASH_FUNCTION_COUNT(NAME)					case WfInsCode::NAME: hash(ins.indexParameter); hash(ins.countParameter); break;
+#define HASH_VARIABLE(NAME)							case WfInsCode::NAME: hash(ins.indexParameter); break;
+#define HASH_COUNT(NAME)							case WfInsCode::NAME: hash(ins.countParameter); break;
+#define HASH_FLAG_TYPEDESCRIPTOR(NAME)				case WfInsCode::NAME: hash((vint64_t)ins.flagParameter); if (ins.typeDescriptorParameter) hashName(ins.typeDescriptorParameter->GetTypeName()); break;
+#define HASH_PROPERTY(NAME)							case WfInsCode::NAME: hashOwner(ins.propertyParameter->GetOwnerTypeDescriptor()); hashName(ins.propertyParameter->GetName()); break;
+#define HASH_METHOD(NAME)							case WfInsCode::NAME: hashMethod(ins.methodParameter); break;
+#define HASH_METHOD_COUNT(NAME)						case WfInsCode::NAME: hashMethod(ins.methodParameter); hash(ins.countParameter); break;
+#define HASH_EVENT(NAME)							case WfInsCode::NAME: hashName(ins.eventParameter->GetName()); break;
+#define HASH_EVENT_COUNT(NAME)						case WfInsCode::NAME: hashName(ins.eventParameter->GetName()); hash(ins.countParameter); break;
+#define HASH_LABEL(NAME)							case WfInsCode::NAME: hash(ins.indexParameter); break;
+#define HASH_TYPE(NAME)								case WfInsCode::NAME: hash((vint64_t)ins.typeParameter); break;
+
+						INSTRUCTION_CASES(
+							HASH,
+							HASH_VALUE,
+							HASH_FUNCTION,
+							HASH_FUNCTION_COUNT,
+							HASH_VARIABLE,
+							HASH_COUNT,
+							HASH_FLAG_TYPEDESCRIPTOR,
+							HASH_PROPERTY,
+							HASH_METHOD,
+							HASH_METHOD_COUNT,
+							HASH_EVENT,
+							HASH_EVENT_COUNT,
+							HASH_LABEL,
+							HASH_TYPE)
+
+#undef HASH
+#undef HASH_VALUE
+#undef HASH_FUNCTION
+#undef HASH_FUNCTION_COUNT
+#undef HASH_VARIABLE
+#undef HASH_COUNT
+#undef HASH_FLAG_TYPEDESCRIPTOR
+#undef HASH_PROPERTY
+#undef HASH_METHOD
+#undef HASH_METHOD_COUNT
+#undef HASH_EVENT
+#undef HASH_EVENT_COUNT
+#undef HASH_LABEL
+#undef HASH_TYPE
+					default:;
+					}
+				}
+				return checksum;
+			}
+
+			void RegisterNativeModule(WfRuntimeNativeModule* module)
+			{
+				SPIN_LOCK(nativeModuleLock)
+				{
+					module->next = firstNativeModule;
+					firstNativeModule = module;
+				}
+			}
+
+			void UnregisterNativeModule(WfRuntimeNativeModule* module)
+			{
+				SPIN_LOCK(nativeModuleLock)
+				{
+					auto current = &firstNativeModule;
+					while (*current)
+					{
+						if (*current == module)
+						{
+							*current = module->next;
+							module->next = nullptr;
+							return;
+						}
+						current = &(*current)->next;
+					}
+				}
+			}
+
 /***********************************************************************
 WfRuntimeGlobalContext
 ***********************************************************************/
@@ -33,6 +183,73 @@ WfRuntimeGlobalContext
 				{
 					assembly->typeImpl->SetGlobalContext(this);
 				}
+
+				nativeFunctions.Resize(assembly->functions.Count());
+				for (vint i = 0; i < nativeFunctions.Count(); i++)
+				{
+					nativeFunctions[i] = nullptr;
+				}
+				bool hasNativeModules = false;
+				SPIN_LOCK(nativeModuleLock)
+				{
+					hasNativeModules = firstNativeModule != nullptr;
+				}
+				if (hasNativeModules)
+				{
+					auto checksum = GetAssemblyChecksum(assembly.Obj());
+					SPIN_LOCK(nativeModuleLock)
+					{
+						for (auto module = firstNativeModule; module; module = module->next)
+						{
+							if (module->checksum == checksum && module->functionCount == nativeFunctions.Count())
+							{
+								for (vint i = 0; i < nativeFunctions.Count(); i++)
+								{
+									nativeFunctions[i] = module->functions[i];
+								}
+								break;
+							}
+						}
+					}
+				}
+
+				callCaches.Resize(assembly->instructions.Count());
+				FOREACH_INDEXER(WfInstruction, ins, index, assembly->instructions)
+				{
+					auto& cache = callCaches[index];
+					switch (ins.code)
+					{
+					case WfInsCode::InvokeMethod:
+						if (auto staticMethod = dynamic_cast<typeimpl::WfStaticMethod*>(ins.methodParameter))
+						{
+							if (staticMethod->GetGlobalContext() == this)
+							{
+								cache.kind = WfRuntimeCallKind::StaticMethod;
+								cache.functionIndex = staticMethod->functionIndex;
+							}
+						}
+						else if (auto classMethod = dynamic_cast<typeimpl::WfClassMethod*>(ins.methodParameter))
+						{
+							if (classMethod->GetGlobalContext() == this)
+							{
+								cache.kind = WfRuntimeCallKind::ClassMethod;
+								cache.functionIndex = classMethod->functionIndex;
+							}
+						}
+						break;
+					case WfInsCode::InvokeBaseCtor:
+						if (auto ctor = dynamic_cast<typeimpl::WfClassConstructor*>(ins.methodParameter))
+						{
+							if (ctor->GetGlobalContext() == this)
+							{
+								cache.kind = WfRuntimeCallKind::ClassConstructor;
+								cache.functionIndex = ctor->functionIndex;
+							}
+						}
+						break;
+					default:;
+					}
+				}
 			}
 
 			WfRuntimeGlobalContext::~WfRuntimeGlobalContext()
@@ -2064,8 +2281,36 @@ WfRuntimeLambda
 
 			Value WfRuntimeLambda::Invoke(Ptr<WfRuntimeGlobalContext> globalContext, Ptr<WfRuntimeVariableContext> capturedVariables, vint functionIndex, Ptr<reflection::description::IValueList> arguments)
 			{
-				WfRuntimeThreadContext context(globalContext);
 				vint count = arguments->GetCount();
+				if (0 <= functionIndex && functionIndex < globalContext->nativeFunctions.Count())
+				{
+					if (auto function = globalContext->nativeFunctions[functionIndex])
+					{
+						if (!GetDebuggerCallback())
+						{
+							Array<Value> nativeArguments(count);
+							for (vint i = 0; i < count; i++)
+							{
+								nativeArguments[i] = arguments->Get(i);
+							}
+							try
+							{
+								return function(globalContext.Obj(), capturedVariables.Obj(), count == 0 ? nullptr : &nativeArguments[0]);
+							}
+							catch (const Exception& ex)
+							{
+								// WfRuntimeException is also an Exception, it is rethrown as is to keep its exception info
+								if (dynamic_cast<const WfRuntimeException*>(&ex))
+								{
+									throw;
+								}
+								throw WfRuntimeException(ex.Message(), false);
+							}
+						}
+					}
+				}
+
+				WfRuntimeThreadContext context(globalContext);
 				for (vint i = 0; i < count; i++)
 				{
 					context.PushValue(arguments->Get(i));
@@ -2975,43 +3220,7 @@ WfRuntimeThreadContext (Operators)
 				Value first, second;
 				CONTEXT_ACTION(PopValue(second), L"failed to pop a value from the stack.");
 				CONTEXT_ACTION(PopValue(first), L"failed to pop a value from the stack.");
-
-				bool firstNull = first.GetValueType() == Value::Null;
-				bool secondNull = second.GetValueType() == Value::Null;
-				if (firstNull)
-				{
-					if (secondNull)
-					{
-						context.PushValue(BoxValue((vint)0));
-					}
-					else
-					{
-						context.PushValue(BoxValue((vint)-1));
-					}
-				}
-				else
-				{
-					if (secondNull)
-					{context.PushValue(BoxValue((vint)1));
-					}
-					else
-					{
-						T firstValue = UnboxValue<T>(first);
-						T secondValue = UnboxValue<T>(second);
-						if (firstValue < secondValue)
-						{
-							context.PushValue(BoxValue((vint)-1));
-						}
-						else if (firstValue > secondValue)
-						{
-							context.PushValue(BoxValue((vint)1));
-						}
-						else
-						{
-							context.PushValue(BoxValue((vint)0));
-						}
-					}
-				}
+				context.PushValue(WfRuntimeNativeHelper::CompareLiteral<T>(first, second));
 				return WfRuntimeExecutionAction::ExecuteInstruction;
 			}
 			
@@ -3126,6 +3335,229 @@ WfRuntimeThreadContext (ReverseEnumerable)
 #undef UNARY_OPERATOR
 #undef BINARY_OPERATOR
 
+/***********************************************************************
+WfRuntimeNativeHelper
+***********************************************************************/
+
+			Value WfRuntimeNativeHelper::Invoke(WfRuntimeGlobalContext* globalContext, vint functionIndex, WfRuntimeVariableContext* capturedVariables, Value* arguments, vint count)
+			{
+				auto list = IValueList::Create();
+				for (vint i = 0; i < count; i++)
+				{
+					list->Add(arguments[i]);
+				}
+				return WfRuntimeLambda::Invoke(globalContext, capturedVariables, functionIndex, list);
+			}
+
+			Value WfRuntimeNativeHelper::InvokeProxy(WfRuntimeGlobalContext* globalContext, const Value& thisValue, Value* arguments, vint count)
+			{
+				auto proxy = UnboxValue<Ptr<IValueFunctionProxy>>(thisValue);
+				if (!proxy)
+				{
+					throw WfRuntimeException(L"Internal error: failed to invoke a null function proxy.", true);
+				}
+
+				if (auto lambda = proxy.Cast<WfRuntimeLambda>())
+				{
+					if (lambda->globalContext == globalContext)
+					{
+						return Invoke(globalContext, lambda->functionIndex, lambda->capturedVariables.Obj(), arguments, count);
+					}
+				}
+
+				List<Value> list;
+				for (vint i = 0; i < count; i++)
+				{
+					list.Add(arguments[i]);
+				}
+				Ptr<IValueList> wrapper = new ValueListWrapper<List<Value>*>(&list);
+				return proxy->Invoke(wrapper);
+			}
+
+			Value WfRuntimeNativeHelper::InvokeMethod(WfRuntimeGlobalContext* globalContext, vint instructionIndex, const Value& thisValue, Value* arguments, vint count)
+			{
+				auto& cache = globalContext->callCaches[instructionIndex];
+				switch (cache.kind)
+				{
+				case WfRuntimeCallKind::StaticMethod:
+					return Invoke(globalContext, cache.functionIndex, nullptr, arguments, count);
+				case WfRuntimeCallKind::ClassMethod:
+					{
+						auto capturedVariable = MakePtr<WfRuntimeVariableContext>();
+						capturedVariable->variables.Resize(1);
+						capturedVariable->variables[0] = Value::From(thisValue.GetRawPtr());
+						return Invoke(globalContext, cache.functionIndex, capturedVariable.Obj(), arguments, count);
+					}
+				default:;
+				}
+
+				Array<Value> methodArguments(count);
+				for (vint i = 0; i < count; i++)
+				{
+					methodArguments[i] = arguments[i];
+				}
+				return globalContext->assembly->instructions[instructionIndex].methodParameter->Invoke(thisValue, methodArguments);
+			}
+
+			Value WfRuntimeNativeHelper::InvokeEvent(IEventInfo* eventInfo, const Value& thisValue, Value* arguments, vint count)
+			{
+				Array<Value> eventArguments(count);
+				for (vint i = 0; i < count; i++)
+				{
+					eventArguments[i] = arguments[i];
+				}
+				eventInfo->Invoke(thisValue, eventArguments);
+				return Value();
+			}
+
+			Value WfRuntimeNativeHelper::AttachEvent(IEventInfo* eventInfo, const Value& thisValue, const Value& function)
+			{
+				auto proxy = UnboxValue<Ptr<IValueFunctionProxy>>(function);
+				auto handler = eventInfo->Attach(thisValue, proxy);
+				return Value::From(handler);
+			}
+
+			Value WfRuntimeNativeHelper::DetachEvent(const Value& handler)
+			{
+				auto eventHandler = UnboxValue<Ptr<IEventHandler>>(handler);
+				return BoxValue(eventHandler->Detach());
+			}
+
+			Value WfRuntimeNativeHelper::CreateArray(Value* values, vint count)
+			{
+				auto list = IValueList::Create();
+				for (vint i = count - 1; i >= 0; i--)
+				{
+					list->Add(values[i]);
+				}
+				return Value::From(list);
+			}
+
+			Value WfRuntimeNativeHelper::CreateMap(Value* values, vint count)
+			{
+				auto map = IValueDictionary::Create();
+				for (vint i = count - 2; i >= 0; i -= 2)
+				{
+					map->Set(values[i], values[i + 1]);
+				}
+				return Value::From(map);
+			}
+
+			Value WfRuntimeNativeHelper::CreateClosureContext(Value* values, vint count)
+			{
+				Ptr<WfRuntimeVariableContext> capturedVariables;
+				if (count > 0)
+				{
+					capturedVariables = new WfRuntimeVariableContext;
+					capturedVariables->variables.Resize(count);
+					for (vint i = 0; i < count; i++)
+					{
+						capturedVariables->variables[i] = values[i];
+					}
+				}
+				return Value::From(capturedVariables);
+			}
+
+			Value WfRuntimeNativeHelper::CreateClosure(WfRuntimeGlobalContext* globalContext, const Value& context, const Value& function)
+			{
+				auto capturedVariables = context.GetSharedPtr().Cast<WfRuntimeVariableContext>();
+				auto functionIndex = UnboxValue<vint>(function);
+				auto lambda = MakePtr<WfRuntimeLambda>(globalContext, capturedVariables, functionIndex);
+				return Value::From(lambda);
+			}
+
+			Value WfRuntimeNativeHelper::ReverseEnumerable(const Value& operand)
+			{
+				return OPERATOR_OpReverseEnumerable(operand);
+			}
+
+			Value WfRuntimeNativeHelper::ConvertToType(const Value& operand, const WfInstruction& ins)
+			{
+				Value converted;
+				if (!OPERATOR_OpConvertToType(operand, converted, ins))
+				{
+					WString from = operand.IsNull() ? L"<null>" : L"<" + operand.GetText() + L"> of " + operand.GetTypeDescriptor()->GetTypeName();
+					WString to = ins.typeDescriptorParameter->GetTypeName();
+					throw WfRuntimeException(L"Failed to convert from \"" + from + L"\" to \"" + to + L"\".", false);
+				}
+				return converted;
+			}
+
+			Value WfRuntimeNativeHelper::TryConvertToType(const Value& operand, const WfInstruction& ins)
+			{
+				Value converted;
+				if (!OPERATOR_OpConvertToType(operand, converted, ins))
+				{
+					return Value();
+				}
+				return converted;
+			}
+
+			Value WfRuntimeNativeHelper::TestType(const Value& operand, const WfInstruction& ins)
+			{
+				return BoxValue(operand.GetTypeDescriptor() && operand.GetValueType() == ins.flagParameter && operand.GetTypeDescriptor()->CanConvertTo(ins.typeDescriptorParameter));
+			}
+
+			Value WfRuntimeNativeHelper::TestElementInSet(const Value& element, const Value& set)
+			{
+				auto enumerable = UnboxValue<Ptr<IValueEnumerable>>(set);
+				auto enumerator = enumerable->CreateEnumerator();
+				while (enumerator->Next())
+				{
+					if (enumerator->GetCurrent() == element)
+					{
+						return BoxValue(true);
+					}
+				}
+				return BoxValue(false);
+			}
+
+			Value WfRuntimeNativeHelper::CompareStruct(const Value& first, const Value& second)
+			{
+				if (!first.IsNull() && !first.GetTypeDescriptor()->GetValueSerializer())
+				{
+					throw WfRuntimeException(L"Internal error: type" + first.GetTypeDescriptor()->GetTypeName() + L" is not a struct.", true);
+				}
+				if (!second.IsNull() && !second.GetTypeDescriptor()->GetValueSerializer())
+				{
+					throw WfRuntimeException(L"Internal error: type" + second.GetTypeDescriptor()->GetTypeName() + L" is not a struct.", true);
+				}
+
+				if (first.GetValueType() != second.GetValueType())
+				{
+					return BoxValue(false);
+				}
+				else if (first.IsNull())
+				{
+					return BoxValue(true);
+				}
+				else
+				{
+					return BoxValue(first.GetText() == second.GetText());
+				}
+			}
+
+			Value WfRuntimeNativeHelper::CompareReference(const Value& first, const Value& second)
+			{
+				return BoxValue(first.GetValueType() != Value::Text && second.GetValueType() != Value::Text && first.GetRawPtr() == second.GetRawPtr());
+			}
+
+			void WfRuntimeNativeHelper::RaiseException(const Value& operand)
+			{
+				if (operand.GetValueType() == Value::Text)
+				{
+					throw WfRuntimeException(operand.GetText(), false);
+				}
+				else if (auto info = operand.GetSharedPtr().Cast<WfRuntimeExceptionInfo>())
+				{
+					throw WfRuntimeException(info);
+				}
+				else
+				{
+					throw WfRuntimeException(L"Internal error: failed to raise an exception which is neither a string nor a WfRuntimeExceptionInfo.", true);
+				}
+			}
+
 /***********************************************************************
 Helper Functions
 ***********************************************************************/
@@ -3187,6 +3619,56 @@ WfRuntimeThreadContext
 #define BEGIN_TYPE								switch(ins.typeParameter) {
 #define END_TYPE								default: INTERNAL_ERROR(L"unexpected type argument."); }
 
+			WfInstruction* WfRuntimeThreadContext::FuseNextInstruction(WfRuntimeStackFrame& stackFrame, WfInsCode code, IWfDebuggerCallback* callback)
+			{
+				// a debugger expects to break at every instruction, so instructions are only fused when no debugger is attached
+				if (callback) return nullptr;
+				vint index = stackFrame.nextInstructionIndex;
+				auto& instructions = globalContext->assembly->instructions;
+				if (index < 0 || index >= instructions.Count()) return nullptr;
+
+				auto& ins = instructions[index];
+				if (ins.code != code) return nullptr;
+				stackFrame.nextInstructionIndex++;
+				return &ins;
+			}
+
+			WfRuntimeExecutionAction WfRuntimeThreadContext::EnterFunction(vint functionIndex, vint argumentCount, Ptr<WfRuntimeVariableContext> capturedVariables, IWfDebuggerCallback* callback)
+			{
+				if (!callback && 0 <= functionIndex && functionIndex < globalContext->nativeFunctions.Count())
+				{
+					if (auto function = globalContext->nativeFunctions[functionIndex])
+					{
+						Array<Value> arguments(argumentCount);
+						for (vint i = argumentCount - 1; i >= 0; i--)
+						{
+							CONTEXT_ACTION(PopValue(arguments[i]), L"failed to pop a value from the stack.");
+						}
+						PushValue(function(globalContext.Obj(), capturedVariables.Obj(), argumentCount == 0 ? nullptr : &arguments[0]));
+						return WfRuntimeExecutionAction::ExecuteInstruction;
+					}
+				}
+
+				CONTEXT_ACTION(PushStackFrame(functionIndex, argumentCount, capturedVariables), L"failed to invoke a function.");
+				return WfRuntimeExecutionAction::EnterStackFrame;
+			}
+
+			WfRuntimeExecutionAction WfRuntimeThreadContext::ExecuteCondition(bool condition, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback)
+			{
+				if (auto jumpIf = FuseNextInstruction(stackFrame, WfInsCode::JumpIf, callback))
+				{
+					if (condition)
+					{
+						stackFrame.nextInstructionIndex = jumpIf->indexParameter;
+					}
+				}
+				else
+				{
+					PushValue(BoxValue(condition));
+				}
+				return WfRuntimeExecutionAction::ExecuteInstruction;
+			}
+
 			WfRuntimeExecutionAction WfRuntimeThreadContext::ExecuteInternal(WfInstruction& ins, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback)
 			{
 				switch (ins.code)
@@ -3208,14 +3690,28 @@ WfRuntimeThreadContext
 					{
 						Value operand;
 						CONTEXT_ACTION(LoadLocalVariable(ins.indexParameter, operand), L"illegal local variable index.");
-						PushValue(operand);
+						if (auto getProperty = FuseNextInstruction(stackFrame, WfInsCode::GetProperty, callback))
+						{
+							PushValue(getProperty->propertyParameter->GetValue(operand));
+						}
+						else
+						{
+							PushValue(operand);
+						}
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 				case WfInsCode::LoadCapturedVar:
 					{
 						Value operand;
 						CONTEXT_ACTION(LoadCapturedVariable(ins.indexParameter, operand), L"illegal captured variable index.");
-						PushValue(operand);
+						if (auto getProperty = FuseNextInstruction(stackFrame, WfInsCode::GetProperty, callback))
+						{
+							PushValue(getProperty->propertyParameter->GetValue(operand));
+						}
+						else
+						{
+							PushValue(operand);
+						}
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
 				case WfInsCode::LoadGlobalVar:
@@ -3468,13 +3964,11 @@ WfRuntimeThreadContext
 					}
 				case WfInsCode::Invoke:
 					{
-						CONTEXT_ACTION(PushStackFrame(ins.indexParameter, ins.countParameter), L"failed to invoke a function.");
-						return WfRuntimeExecutionAction::EnterStackFrame;
+						return EnterFunction(ins.indexParameter, ins.countParameter, nullptr, callback);
 					}
 				case WfInsCode::InvokeWithContext:
 					{
-						CONTEXT_ACTION(PushStackFrame(ins.indexParameter, ins.countParameter, GetCurrentStackFrame().capturedVariables), L"failed to invoke a function.");
-						return WfRuntimeExecutionAction::EnterStackFrame;
+						return EnterFunction(ins.indexParameter, ins.countParameter, GetCurrentStackFrame().capturedVariables, callback);
 					}
 				case WfInsCode::GetProperty:
 					{
@@ -3509,8 +4003,7 @@ WfRuntimeThreadContext
 						{
 							if (lambda->globalContext == globalContext)
 							{
-								CONTEXT_ACTION(PushStackFrame(lambda->functionIndex, ins.countParameter, lambda->capturedVariables), L"failed to invoke a function.");
-								return WfRuntimeExecutionAction::EnterStackFrame;
+								return EnterFunction(lambda->functionIndex, ins.countParameter, lambda->capturedVariables, callback);
 							}
 						}
 
@@ -3533,26 +4026,22 @@ WfRuntimeThreadContext
 						CONTEXT_ACTION(PopValue(thisValue), L"failed to pop a value from the stack.");
 						CALL_DEBUGGER(callback->BreakInvoke(thisValue.GetRawPtr(), ins.methodParameter));
 
-						if (auto staticMethod = dynamic_cast<WfStaticMethod*>(ins.methodParameter))
+						auto& cache = globalContext->callCaches[&ins - &globalContext->assembly->instructions[0]];
+						switch (cache.kind)
 						{
-							if (staticMethod->GetGlobalContext() == globalContext.Obj())
+						case WfRuntimeCallKind::StaticMethod:
 							{
-								CONTEXT_ACTION(PushStackFrame(staticMethod->functionIndex, ins.countParameter, nullptr), L"failed to invoke a function.");
-								return WfRuntimeExecutionAction::EnterStackFrame;
+								return EnterFunction(cache.functionIndex, ins.countParameter, nullptr, callback);
 							}
-						}
-
-						if (auto classMethod = dynamic_cast<WfClassMethod*>(ins.methodParameter))
-						{
-							if (classMethod->GetGlobalContext() == globalContext.Obj())
+						case WfRuntimeCallKind::ClassMethod:
 							{
 								auto capturedVariable = MakePtr<WfRuntimeVariableContext>();
 								capturedVariable->variables.Resize(1);
 								capturedVariable->variables[0] = Value::From(thisValue.GetRawPtr());
 
-								CONTEXT_ACTION(PushStackFrame(classMethod->functionIndex, ins.countParameter, capturedVariable), L"failed to invoke a function.");
-								return WfRuntimeExecutionAction::EnterStackFrame;
+								return EnterFunction(cache.functionIndex, ins.countParameter, capturedVariable, callback);
 							}
+						default:;
 						}
 
 						Array<Value> arguments(ins.countParameter);
@@ -3591,17 +4080,14 @@ WfRuntimeThreadContext
 						CONTEXT_ACTION(PopValue(thisValue), L"failed to pop a value from the stack.");
 						CALL_DEBUGGER(callback->BreakInvoke(thisValue.GetRawPtr(), ins.eventParameter));
 						
-						if (auto ctor = dynamic_cast<WfClassConstructor*>(ins.methodParameter))
+						auto& cache = globalContext->callCaches[&ins - &globalContext->assembly->instructions[0]];
+						if (cache.kind == WfRuntimeCallKind::ClassConstructor)
 						{
-							if (ctor->GetGlobalContext() == globalContext.Obj())
-							{
-								auto capturedVariable = MakePtr<WfRuntimeVariableContext>();
-								capturedVariable->variables.Resize(1);
-								capturedVariable->variables[0] = Value::From(thisValue.GetRawPtr());
+							auto capturedVariable = MakePtr<WfRuntimeVariableContext>();
+							capturedVariable->variables.Resize(1);
+							capturedVariable->variables[0] = Value::From(thisValue.GetRawPtr());
 
-								CONTEXT_ACTION(PushStackFrame(ctor->functionIndex, ins.countParameter, capturedVariable), L"failed to invoke a function.");
-								return WfRuntimeExecutionAction::EnterStackFrame;
-							}
+							return EnterFunction(cache.functionIndex, ins.countParameter, capturedVariable, callback);
 						}
 
 						Array<Value> arguments(ins.countParameter);
@@ -3959,8 +4445,7 @@ WfRuntimeThreadContext
 						Value operand;
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						vint value = UnboxValue<vint>(operand);
-						PushValue(BoxValue(value < 0));
-						return WfRuntimeExecutionAction::ExecuteInstruction;
+						return ExecuteCondition(value < 0, stackFrame, callback);
 					}
 					break;
 				case WfInsCode::OpGT:
@@ -3968,8 +4453,7 @@ WfRuntimeThreadContext
 						Value operand;
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						vint value = UnboxValue<vint>(operand);
-						PushValue(BoxValue(value > 0));
-						return WfRuntimeExecutionAction::ExecuteInstruction;
+						return ExecuteCondition(value > 0, stackFrame, callback);
 					}
 					break;
 				case WfInsCode::OpLE:
@@ -3977,8 +4461,7 @@ WfRuntimeThreadContext
 						Value operand;
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						vint value = UnboxValue<vint>(operand);
-						PushValue(BoxValue(value <= 0));
-						return WfRuntimeExecutionAction::ExecuteInstruction;
+						return ExecuteCondition(value <= 0, stackFrame, callback);
 					}
 					break;
 				case WfInsCode::OpGE:
@@ -3986,8 +4469,7 @@ WfRuntimeThreadContext
 						Value operand;
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						vint value = UnboxValue<vint>(operand);
-						PushValue(BoxValue(value >= 0));
-						return WfRuntimeExecutionAction::ExecuteInstruction;
+						return ExecuteCondition(value >= 0, stackFrame, callback);
 					}
 					break;
 				case WfInsCode::OpEQ:
@@ -3995,8 +4477,7 @@ WfRuntimeThreadContext
 						Value operand;
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						vint value = UnboxValue<vint>(operand);
-						PushValue(BoxValue(value == 0));
-						return WfRuntimeExecutionAction::ExecuteInstruction;
+						return ExecuteCondition(value == 0, stackFrame, callback);
 					}
 					break;
 				case WfInsCode::OpNE:
@@ -4004,8 +4485,7 @@ WfRuntimeThreadContext
 						Value operand;
 						CONTEXT_ACTION(PopValue(operand), L"failed to pop a value from the stack.");
 						vint value = UnboxValue<vint>(operand);
-						PushValue(BoxValue(value != 0));
-						return WfRuntimeExecutionAction::ExecuteInstruction;
+						return ExecuteCondition(value != 0, stackFrame, callback);
 					}
 					break;
 				default:
@@ -1268,12 +1268,39 @@ RuntimeEnvironment
 				VariableArray					variables;
 			};
 
+			/// <summary>How a method call site is dispatched.</summary>
+			enum class WfRuntimeCallKind
+			{
+				/// <summary>Call the method through the reflection.</summary>
+				Reflection,
+				/// <summary>The method is a static method defined in the same global context, push a stack frame instead.</summary>
+				StaticMethod,
+				/// <summary>The method is a class method defined in the same global context, push a stack frame instead.</summary>
+				ClassMethod,
+				/// <summary>The method is a class constructor defined in the same global context, push a stack frame instead.</summary>
+				ClassConstructor,
+			};
+
+			/// <summary>Resolved dispatch of a method call site. A method defined in an assembly only belongs to the global context that is created for this assembly, so the dispatch is resolved once when the global context is created.</summary>
+			struct WfRuntimeCallCache
+			{
+				WfRuntimeCallKind				kind = WfRuntimeCallKind::Reflection;
+				vint							functionIndex = -1;
+			};
+
+			/// <summary>A function that is translated to C++ by [M:vl.workflow.analyzer.GenerateCppFile].</summary>
+			typedef reflection::description::Value(*WfRuntimeNativeFunction)(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, reflection::description::Value* arguments);
+
 			/// <summary>Global context for executing a Workflow program. After the context is prepared, use [M:vl.workflow.runtime.LoadFunction] to call any functions inside the assembly. Function "&lt;initialize&gt;" should be the first to execute.</summary>
 			class WfRuntimeGlobalContext : public Object, public reflection::Description<WfRuntimeGlobalContext>
 			{
 			public:
-				Ptr<WfAssembly>					assembly;
-				Ptr<WfRuntimeVariableContext>	globalVariables;
+				Ptr<WfAssembly>									assembly;
+				Ptr<WfRuntimeVariableContext>					globalVariables;
+				/// <summary>Resolved dispatch for each instruction, only used by [F:vl.workflow.runtime.WfInsCode.InvokeMethod] and [F:vl.workflow.runtime.WfInsCode.InvokeBaseCtor].</summary>
+				collections::Array<WfRuntimeCallCache>			callCaches;
+				/// <summary>Native implementation for each function, taken from a registered [T:vl.workflow.runtime.WfRuntimeNativeModule] that matches the assembly. A function without a native implementation is interpreted.</summary>
+				collections::Array<WfRuntimeNativeFunction>		nativeFunctions;
 				
 				/// <summary>Create a global context for executing a Workflow program.</summary>
 				/// <param name="_assembly">The assembly.</param>
@@ -1492,6 +1519,9 @@ RuntimeThreadContext
 				WfRuntimeThreadContextError		LoadLocalVariable(vint variableIndex, reflection::description::Value& value);
 				WfRuntimeThreadContextError		StoreLocalVariable(vint variableIndex, const reflection::description::Value& value);
 
+				WfInstruction*					FuseNextInstruction(WfRuntimeStackFrame& stackFrame, WfInsCode code, IWfDebuggerCallback* callback);
+				WfRuntimeExecutionAction		EnterFunction(vint functionIndex, vint argumentCount, Ptr<WfRuntimeVariableContext> capturedVariables, IWfDebuggerCallback* callback);
+				WfRuntimeExecutionAction		ExecuteCondition(bool condition, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback);
 				WfRuntimeExecutionAction		ExecuteInternal(WfInstruction& ins, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback);
 				WfRuntimeExecutionAction		Execute(IWfDebuggerCallback* callback);
 				void							ExecuteToEnd();
@@ -1520,6 +1550,113 @@ Helper Functions
 				reflection::description::UnboxParameter<Func<TFunction>>(reflection::description::Value::From(proxy), function);
 				return function;
 			}
+
+/***********************************************************************
+Native Functions
+***********************************************************************/
+
+			/// <summary>Native functions that are generated by [M:vl.workflow.analyzer.GenerateCppFile] for an assembly. After the module is registered, every global context created for the same assembly calls these functions instead of interpreting them, unless a debugger is attached.</summary>
+			struct WfRuntimeNativeModule
+			{
+				/// <summary>The checksum of the assembly, see [M:vl.workflow.runtime.GetAssemblyChecksum].</summary>
+				vuint64_t										checksum;
+				/// <summary>Number of functions in the assembly.</summary>
+				vint											functionCount;
+				/// <summary>Native implementation of each function. A function that is not translated is null.</summary>
+				WfRuntimeNativeFunction*						functions;
+				/// <summary>The next registered module, maintained by [M:vl.workflow.runtime.RegisterNativeModule].</summary>
+				WfRuntimeNativeModule*							next;
+			};
+
+			/// <summary>Calculate a checksum from the functions, instructions, constants and referenced members in an assembly, to test if a native module is generated from the same assembly.</summary>
+			/// <returns>The checksum.</returns>
+			/// <param name="assembly">The assembly.</param>
+			extern vuint64_t									GetAssemblyChecksum(WfAssembly* assembly);
+			/// <summary>Register a native module. It only affects global contexts created after the registration.</summary>
+			/// <param name="module">The native module.</param>
+			extern void											RegisterNativeModule(WfRuntimeNativeModule* module);
+			/// <summary>Unregister a native module.</summary>
+			/// <param name="module">The native module.</param>
+			extern void											UnregisterNativeModule(WfRuntimeNativeModule* module);
+
+			/// <summary>Operations called by native functions. They behave the same as instructions executed by [T:vl.workflow.runtime.WfRuntimeThreadContext]. Values on the stack are passed in the order from the bottom to the top.</summary>
+			struct WfRuntimeNativeHelper
+			{
+				typedef reflection::description::Value						Value;
+				typedef reflection::description::IEventInfo					IEventInfo;
+
+				static Value						Invoke(WfRuntimeGlobalContext* globalContext, vint functionIndex, WfRuntimeVariableContext* capturedVariables, Value* arguments, vint count);
+				static Value						InvokeProxy(WfRuntimeGlobalContext* globalContext, const Value& thisValue, Value* arguments, vint count);
+				static Value						InvokeMethod(WfRuntimeGlobalContext* globalContext, vint instructionIndex, const Value& thisValue, Value* arguments, vint count);
+				static Value						InvokeEvent(IEventInfo* eventInfo, const Value& thisValue, Value* arguments, vint count);
+				static Value						AttachEvent(IEventInfo* eventInfo, const Value& thisValue, const Value& function);
+				static Value						DetachEvent(const Value& handler);
+
+				static Value						CreateArray(Value* values, vint count);
+				static Value						CreateMap(Value* values, vint count);
+				static Value						CreateClosureContext(Value* values, vint count);
+				static Value						CreateClosure(WfRuntimeGlobalContext* globalContext, const Value& context, const Value& function);
+				static Value						ReverseEnumerable(const Value& operand);
+
+				static Value						ConvertToType(const Value& operand, const WfInstruction& ins);
+				static Value						TryConvertToType(const Value& operand, const WfInstruction& ins);
+				static Value						TestType(const Value& operand, const WfInstruction& ins);
+				static Value						TestElementInSet(const Value& element, const Value& set);
+				static Value						CompareStruct(const Value& first, const Value& second);
+				static Value						CompareReference(const Value& first, const Value& second);
+				static void							RaiseException(const Value& operand);
+
+				template<typename T>
+				static Value CreateRange(const Value& begin, const Value& end)
+				{
+					T beginValue = reflection::description::UnboxValue<T>(begin);
+					T endValue = reflection::description::UnboxValue<T>(end);
+					return Value::From(MakePtr<WfRuntimeRange<T>>(beginValue, endValue));
+				}
+
+				template<typename T>
+				static Value CompareLiteral(const Value& first, const Value& second)
+				{
+					bool firstNull = first.GetValueType() == Value::Null;
+					bool secondNull = second.GetValueType() == Value::Null;
+					if (firstNull)
+					{
+						return reflection::description::BoxValue<vint>(secondNull ? 0 : -1);
+					}
+					else if (secondNull)
+					{
+						return reflection::description::BoxValue<vint>(1);
+					}
+					else
+					{
+						T firstValue = reflection::description::UnboxValue<T>(first);
+						T secondValue = reflection::description::UnboxValue<T>(second);
+						if (firstValue < secondValue)
+						{
+							return reflection::description::BoxValue<vint>(-1);
+						}
+						else if (firstValue > secondValue)
+						{
+							return reflection::description::BoxValue<vint>(1);
+						}
+						else
+						{
+							return reflection::description::BoxValue<vint>(0);
+						}
+					}
+				}
+
+				template<typename T>
+				static T* GetThis(const Value& thisValue, reflection::description::IMethodInfo* methodInfo)
+				{
+					// a method that is called directly checks the object in the same way as IMethodInfo::Invoke
+					if (thisValue.IsNull())
+					{
+						throw reflection::description::ArgumentNullException(L"thisObject", methodInfo);
+					}
+					return reflection::description::UnboxValue<T*>(thisValue, methodInfo->GetOwnerTypeDescriptor(), L"thisObject");
+				}
+			};
 		}
 	}
 }
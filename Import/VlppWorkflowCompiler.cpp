@@ -5199,6 +5199,818 @@ ExpandBindExpression
 	}
 }
 
+/***********************************************************************
+ANALYZER\WFANALYZER_GENERATECPP.CPP
+***********************************************************************/
+
+namespace vl
+{
+	namespace workflow
+	{
+		namespace analyzer
+		{
+			using namespace collections;
+			using namespace stream;
+			using namespace reflection;
+			using namespace reflection::description;
+			using namespace runtime;
+
+/***********************************************************************
+GenerateCppFile (Analyzing)
+***********************************************************************/
+
+			bool GetCppStackEffect(const WfInstruction& ins, vint& pop, vint& push)
+			{
+				pop = 0;
+				push = 0;
+				switch (ins.code)
+				{
+				case WfInsCode::Nop:
+				case WfInsCode::Jump:
+					break;
+				case WfInsCode::LoadValue:
+				case WfInsCode::LoadFunction:
+				case WfInsCode::LoadLocalVar:
+				case WfInsCode::LoadCapturedVar:
+				case WfInsCode::LoadGlobalVar:
+				case WfInsCode::LoadMethodInfo:
+				case WfInsCode::LoadClosureContext:
+				case WfInsCode::Duplicate:
+					push = 1;
+					break;
+				case WfInsCode::LoadMethodClosure:
+				case WfInsCode::ReverseEnumerable:
+				case WfInsCode::ConvertToType:
+				case WfInsCode::TryConvertToType:
+				case WfInsCode::TestType:
+				case WfInsCode::GetType:
+				case WfInsCode::GetProperty:
+				case WfInsCode::DetachEvent:
+				case WfInsCode::OpNot:
+				case WfInsCode::OpPositive:
+				case WfInsCode::OpNegative:
+				case WfInsCode::OpLT:
+				case WfInsCode::OpGT:
+				case WfInsCode::OpLE:
+				case WfInsCode::OpGE:
+				case WfInsCode::OpEQ:
+				case WfInsCode::OpNE:
+					pop = 1;
+					push = 1;
+					break;
+				case WfInsCode::StoreLocalVar:
+				case WfInsCode::StoreCapturedVar:
+				case WfInsCode::StoreGlobalVar:
+				case WfInsCode::Pop:
+				case WfInsCode::Return:
+				case WfInsCode::DeleteRawPtr:
+				case WfInsCode::JumpIf:
+				case WfInsCode::RaiseException:
+					pop = 1;
+					break;
+				case WfInsCode::CreateArray:
+				case WfInsCode::CreateMap:
+				case WfInsCode::CreateClosureContext:
+				case WfInsCode::Invoke:
+				case WfInsCode::InvokeWithContext:
+					pop = ins.countParameter;
+					push = 1;
+					break;
+				case WfInsCode::CreateClosure:
+				case WfInsCode::CreateRange:
+				case WfInsCode::AttachEvent:
+				case WfInsCode::TestElementInSet:
+				case WfInsCode::CompareLiteral:
+				case WfInsCode::CompareStruct:
+				case WfInsCode::CompareReference:
+				case WfInsCode::OpConcat:
+				case WfInsCode::OpExp:
+				case WfInsCode::OpAdd:
+				case WfInsCode::OpSub:
+				case WfInsCode::OpMul:
+				case WfInsCode::OpDiv:
+				case WfInsCode::OpMod:
+				case WfInsCode::OpShl:
+				case WfInsCode::OpShr:
+				case WfInsCode::OpXor:
+				case WfInsCode::OpAnd:
+				case WfInsCode::OpOr:
+					pop = 2;
+					push = 1;
+					break;
+				case WfInsCode::SetProperty:
+					pop = 2;
+					break;
+				case WfInsCode::InvokeProxy:
+				case WfInsCode::InvokeMethod:
+				case WfInsCode::InvokeEvent:
+					pop = ins.countParameter + 1;
+					push = 1;
+					break;
+				default:
+					// instructions that work with trap frames or create interfaces are left to the interpreter
+					return false;
+				}
+				return true;
+			}
+
+			bool AnalyzeCppStackDepth(WfAssembly* assembly, WfAssemblyFunction* function, Array<vint>& depths, vint& maxDepth)
+			{
+				vint first = function->firstInstruction;
+				vint last = function->lastInstruction;
+				if (first < 0 || last < first || last >= assembly->instructions.Count())
+				{
+					return false;
+				}
+
+				depths.Resize(last - first + 1);
+				for (vint i = 0; i < depths.Count(); i++)
+				{
+					depths[i] = -1;
+				}
+				maxDepth = 0;
+
+				List<vint> tasks;
+				depths[0] = 0;
+				tasks.Add(first);
+
+				auto visit = [&](vint index, vint depth)
+				{
+					if (index < first || index > last) return false;
+					vint& target = depths[index - first];
+					if (target == -1)
+					{
+						target = depth;
+						tasks.Add(index);
+						return true;
+					}
+					return target == depth;
+				};
+
+				while (tasks.Count() > 0)
+				{
+					vint index = tasks[tasks.Count() - 1];
+					tasks.RemoveAt(tasks.Count() - 1);
+					auto& ins = assembly->instructions[index];
+
+					vint pop, push;
+					if (!GetCppStackEffect(ins, pop, push)) return false;
+					vint depth = depths[index - first];
+					if (depth < pop) return false;
+					if (ins.code == WfInsCode::Duplicate && depth <= ins.countParameter) return false;
+
+					vint nextDepth = depth - pop + push;
+					if (maxDepth < nextDepth) maxDepth = nextDepth;
+
+					switch (ins.code)
+					{
+					case WfInsCode::Return:
+					case WfInsCode::RaiseException:
+						break;
+					case WfInsCode::Jump:
+						if (!visit(ins.indexParameter, nextDepth)) return false;
+						break;
+					case WfInsCode::JumpIf:
+						if (!visit(ins.indexParameter, nextDepth)) return false;
+						if (!visit(index + 1, nextDepth)) return false;
+						break;
+					default:
+						if (!visit(index + 1, nextDepth)) return false;
+					}
+				}
+				return true;
+			}
+
+/***********************************************************************
+GenerateCppFile (Writing)
+***********************************************************************/
+
+			WString GetCppInsType(WfInsType type)
+			{
+				switch (type)
+				{
+				case WfInsType::Bool:	return L"bool";
+				case WfInsType::I1:		return L"vint8_t";
+				case WfInsType::I2:		return L"vint16_t";
+				case WfInsType::I4:		return L"vint32_t";
+				case WfInsType::I8:		return L"vint64_t";
+				case WfInsType::U1:		return L"vuint8_t";
+				case WfInsType::U2:		return L"vuint16_t";
+				case WfInsType::U4:		return L"vuint32_t";
+				case WfInsType::U8:		return L"vuint64_t";
+				case WfInsType::F4:		return L"float";
+				case WfInsType::F8:		return L"double";
+				case WfInsType::String:	return L"WString";
+				default:				return L"void";
+				}
+			}
+
+			WString GetCppStackValue(vint index)
+			{
+				return L"s" + itow(index);
+			}
+
+			WString GetCppFunctionName(vint index)
+			{
+				return L"Function_" + itow(index);
+			}
+
+			WString GetCppComment(const WString& text)
+			{
+				WString result;
+				for (vint i = 0; i < text.Length(); i++)
+				{
+					wchar_t c = text[i];
+					result += (c == L'\r' || c == L'\n') ? WString(L' ') : WString(c);
+				}
+				return result;
+			}
+
+			WString GetCppTypeName(ITypeInfo* typeInfo)
+			{
+				switch (typeInfo->GetDecorator())
+				{
+				case ITypeInfo::RawPtr:
+					{
+						WString element = GetCppTypeName(typeInfo->GetElementType());
+						return element == L"" ? element : element + L"*";
+					}
+				case ITypeInfo::SharedPtr:
+					{
+						WString element = GetCppTypeName(typeInfo->GetElementType());
+						return element == L"" ? element : L"Ptr<" + element + L">";
+					}
+				case ITypeInfo::Nullable:
+					{
+						WString element = GetCppTypeName(typeInfo->GetElementType());
+						return element == L"" ? element : L"Nullable<" + element + L">";
+					}
+				case ITypeInfo::TypeDescriptor:
+					return typeInfo->GetTypeDescriptor()->GetCppFullTypeName();
+				default:
+					// generic types are not mapped to C++, members using them are called through reflection
+					return L"";
+				}
+			}
+
+			WString ReplaceCppTemplate(const WString& text, const WString& pattern, const WString& replacement)
+			{
+				WString result;
+				vint start = 0;
+				for (vint i = 0; i + pattern.Length() <= text.Length(); i++)
+				{
+					if (text.Sub(i, pattern.Length()) == pattern)
+					{
+						result += text.Sub(start, i - start) + replacement;
+						i += pattern.Length() - 1;
+						start = i + 1;
+					}
+				}
+				return result + text.Sub(start, text.Length() - start);
+			}
+
+			class WfCppFunctionWriter
+			{
+			protected:
+				WfAssembly*							assembly;
+				vint								functionIndex;
+				Array<bool>&						translated;
+				Array<vint>&						depths;
+				vint								maxDepth;
+				TextWriter&							writer;
+				SortedList<vint>					labels;
+
+				WfAssemblyFunction* GetFunction()
+				{
+					return assembly->functions[functionIndex].Obj();
+				}
+
+				vint GetDepth(vint index)
+				{
+					return depths[index - GetFunction()->firstInstruction];
+				}
+
+				bool IsReachable(vint index)
+				{
+					auto function = GetFunction();
+					return function->firstInstruction <= index && index <= function->lastInstruction && GetDepth(index) != -1;
+				}
+
+				void WriteLine(const WString& line)
+				{
+					writer.WriteString(L"\t\t");
+					writer.WriteLine(line);
+				}
+
+				WString WriteStackArray(vint base, vint count)
+				{
+					if (count == 0)
+					{
+						return L"nullptr";
+					}
+
+					WString line = L"Value values[] = { ";
+					for (vint i = 0; i < count; i++)
+					{
+						if (i > 0) line += L", ";
+						line += GetCppStackValue(base + i);
+					}
+					line += L" };";
+					WriteLine(L"\t" + line);
+					return L"values";
+				}
+
+				bool WriteDirectCall(IMethodInfo* method, const WString& methodRef, const WString& thisValue, const List<WString>& arguments, const WString& result)
+				{
+					// a method registered from a C++ member is called directly, instead of boxing arguments for IMethodInfo::Invoke
+					auto methodInfo = dynamic_cast<MethodInfoImpl*>(method);
+					if (!methodInfo || methodInfo->GetCppInvokeTemplate() == L"") return false;
+					if (methodInfo->GetParameterCount() != arguments.Count()) return false;
+
+					auto ownerType = methodInfo->GetOwnerTypeDescriptor();
+					WString ownerName = ownerType->GetCppFullTypeName();
+					if (ownerName == L"") return false;
+					if (!methodInfo->IsStatic() && (ownerType->GetTypeDescriptorFlags() & TypeDescriptorFlags::ReferenceType) == TypeDescriptorFlags::Undefined) return false;
+
+					WString unboxedArguments;
+					for (vint i = 0; i < arguments.Count(); i++)
+					{
+						WString type = GetCppTypeName(methodInfo->GetParameter(i)->GetType());
+						if (type == L"") return false;
+						if (i > 0) unboxedArguments += L", ";
+						unboxedArguments += L"UnboxValue<" + type + L">(" + arguments[i] + L")";
+					}
+
+					auto returnInfo = methodInfo->GetReturn();
+					bool returnVoid = returnInfo->GetDecorator() == ITypeInfo::TypeDescriptor && returnInfo->GetTypeDescriptor() == description::GetTypeDescriptor<void>();
+					WString returnType = returnVoid ? WString(L"void") : GetCppTypeName(returnInfo);
+					if (returnType == L"") return false;
+
+					WString expression = methodInfo->GetCppInvokeTemplate();
+					expression = ReplaceCppTemplate(expression, L"$This", L"WfRuntimeNativeHelper::GetThis<" + ownerName + L">(" + thisValue + L", " + methodRef + L")");
+					expression = ReplaceCppTemplate(expression, L"$Type", ownerName);
+					expression = ReplaceCppTemplate(expression, L"$Arguments", unboxedArguments);
+
+					if (returnVoid)
+					{
+						WriteLine(L"\t" + expression + L";");
+						if (result != L"")
+						{
+							WriteLine(L"\t" + result + L" = Value();");
+						}
+					}
+					else if (result != L"")
+					{
+						WriteLine(L"\t" + result + L" = BoxValue<" + returnType + L">(" + expression + L");");
+					}
+					else
+					{
+						WriteLine(L"\t" + expression + L";");
+					}
+					return true;
+				}
+
+				void WriteCall(vint index, const WfInstruction& ins, vint depth)
+				{
+					vint count = ins.countParameter;
+					switch (ins.code)
+					{
+					case WfInsCode::Invoke:
+					case WfInsCode::InvokeWithContext:
+						{
+							vint base = depth - count;
+							WString captured = ins.code == WfInsCode::Invoke ? L"nullptr" : L"capturedVariables";
+							WString values = WriteStackArray(base, count);
+							if (0 <= ins.indexParameter && ins.indexParameter < translated.Count() && translated[ins.indexParameter])
+							{
+								WriteLine(L"\t" + GetCppStackValue(base) + L" = " + GetCppFunctionName(ins.indexParameter) + L"(globalContext, " + captured + L", " + values + L");");
+							}
+							else
+							{
+								WriteLine(L"\t" + GetCppStackValue(base) + L" = WfRuntimeNativeHelper::Invoke(globalContext, " + itow(ins.indexParameter) + L", " + captured + L", " + values + L", " + itow(count) + L");");
+							}
+						}
+						break;
+					case WfInsCode::InvokeProxy:
+					case WfInsCode::InvokeMethod:
+					case WfInsCode::InvokeEvent:
+						{
+							vint base = depth - 1 - count;
+							WString thisValue = GetCppStackValue(depth - 1);
+							if (ins.code == WfInsCode::InvokeMethod)
+							{
+								List<WString> arguments;
+								for (vint i = 0; i < count; i++)
+								{
+									arguments.Add(GetCppStackValue(base + i));
+								}
+								if (WriteDirectCall(ins.methodParameter, L"ins[" + itow(index) + L"].methodParameter", thisValue, arguments, GetCppStackValue(base)))
+								{
+									break;
+								}
+							}
+							WString values = WriteStackArray(base, count);
+							WString call;
+							switch (ins.code)
+							{
+							case WfInsCode::InvokeProxy:
+								call = L"WfRuntimeNativeHelper::InvokeProxy(globalContext, " + thisValue + L", ";
+								break;
+							case WfInsCode::InvokeMethod:
+								call = L"WfRuntimeNativeHelper::InvokeMethod(globalContext, " + itow(index) + L", " + thisValue + L", ";
+								break;
+							default:
+								call = L"WfRuntimeNativeHelper::InvokeEvent(ins[" + itow(index) + L"].eventParameter, " + thisValue + L", ";
+							}
+							WriteLine(L"\t" + GetCppStackValue(base) + L" = " + call + values + L", " + itow(count) + L");");
+						}
+						break;
+					default:
+						{
+							vint base = depth - count;
+							WString values = WriteStackArray(base, count);
+							WString helper =
+								ins.code == WfInsCode::CreateArray ? L"CreateArray" :
+								ins.code == WfInsCode::CreateMap ? L"CreateMap" :
+								L"CreateClosureContext";
+							WriteLine(L"\t" + GetCppStackValue(base) + L" = WfRuntimeNativeHelper::" + helper + L"(" + values + L", " + itow(count) + L");");
+						}
+					}
+				}
+
+				bool WriteCondition(vint index, const WfInstruction& ins, vint depth)
+				{
+					WString op;
+					switch (ins.code)
+					{
+					case WfInsCode::OpLT: op = L" < 0"; break;
+					case WfInsCode::OpGT: op = L" > 0"; break;
+					case WfInsCode::OpLE: op = L" <= 0"; break;
+					case WfInsCode::OpGE: op = L" >= 0"; break;
+					case WfInsCode::OpEQ: op = L" == 0"; break;
+					default: op = L" != 0";
+					}
+
+					WString top = GetCppStackValue(depth - 1);
+					WString condition = L"UnboxValue<vint>(" + top + L")" + op;
+					vint next = index + 1;
+					if (IsReachable(next) && !labels.Contains(next) && assembly->instructions[next].code == WfInsCode::JumpIf)
+					{
+						WriteLine(L"if (" + condition + L") { " + top + L" = Value(); goto L" + itow(assembly->instructions[next].indexParameter) + L"; }");
+						WriteLine(top + L" = Value();");
+						return true;
+					}
+					WriteLine(top + L" = BoxValue<bool>(" + condition + L");");
+					return false;
+				}
+
+				void WriteInstruction(vint index, const WfInstruction& ins, vint depth)
+				{
+					WString insRef = L"ins[" + itow(index) + L"]";
+					WString top = depth > 0 ? GetCppStackValue(depth - 1) : L"";
+					WString second = depth > 1 ? GetCppStackValue(depth - 2) : L"";
+					WString push = GetCppStackValue(depth);
+					WString type = GetCppInsType(ins.typeParameter);
+
+					switch (ins.code)
+					{
+					case WfInsCode::Nop:
+						break;
+					case WfInsCode::LoadValue:
+						WriteLine(push + L" = " + insRef + L".valueParameter;");
+						break;
+					case WfInsCode::LoadFunction:
+						WriteLine(push + L" = BoxValue<vint>(" + itow(ins.indexParameter) + L");");
+						break;
+					case WfInsCode::LoadLocalVar:
+						WriteLine(push + L" = v" + itow(ins.indexParameter) + L";");
+						break;
+					case WfInsCode::LoadCapturedVar:
+						WriteLine(push + L" = capturedVariables->variables[" + itow(ins.indexParameter) + L"];");
+						break;
+					case WfInsCode::LoadGlobalVar:
+						WriteLine(push + L" = globalContext->globalVariables->variables[" + itow(ins.indexParameter) + L"];");
+						break;
+					case WfInsCode::LoadMethodInfo:
+						WriteLine(push + L" = Value::From(" + insRef + L".methodParameter);");
+						break;
+					case WfInsCode::LoadMethodClosure:
+						WriteLine(top + L" = " + insRef + L".methodParameter->CreateFunctionProxy(" + top + L");");
+						break;
+					case WfInsCode::LoadClosureContext:
+						WriteLine(push + L" = Value::From(Ptr<WfRuntimeVariableContext>(capturedVariables));");
+						break;
+					case WfInsCode::StoreLocalVar:
+						WriteLine(L"v" + itow(ins.indexParameter) + L" = " + top + L";");
+						break;
+					case WfInsCode::StoreCapturedVar:
+						WriteLine(L"capturedVariables->variables[" + itow(ins.indexParameter) + L"] = " + top + L";");
+						break;
+					case WfInsCode::StoreGlobalVar:
+						WriteLine(L"globalContext->globalVariables->variables[" + itow(ins.indexParameter) + L"] = " + top + L";");
+						break;
+					case WfInsCode::Duplicate:
+						WriteLine(push + L" = " + GetCppStackValue(depth - 1 - ins.countParameter) + L";");
+						break;
+					case WfInsCode::Pop:
+						break;
+					case WfInsCode::Return:
+						WriteLine(L"return " + top + L";");
+						break;
+					case WfInsCode::CreateArray:
+					case WfInsCode::CreateMap:
+					case WfInsCode::CreateClosureContext:
+					case WfInsCode::Invoke:
+					case WfInsCode::InvokeWithContext:
+					case WfInsCode::InvokeProxy:
+					case WfInsCode::InvokeMethod:
+					case WfInsCode::InvokeEvent:
+						WriteLine(L"{");
+						WriteCall(index, ins, depth);
+						WriteLine(L"}");
+						break;
+					case WfInsCode::CreateClosure:
+						WriteLine(second + L" = WfRuntimeNativeHelper::CreateClosure(globalContext, " + second + L", " + top + L");");
+						break;
+					case WfInsCode::CreateRange:
+						WriteLine(second + L" = WfRuntimeNativeHelper::CreateRange<" + type + L">(" + second + L", " + top + L");");
+						break;
+					case WfInsCode::ReverseEnumerable:
+						WriteLine(top + L" = WfRuntimeNativeHelper::ReverseEnumerable(" + top + L");");
+						break;
+					case WfInsCode::DeleteRawPtr:
+						WriteLine(top + L".DeleteRawPtr();");
+						break;
+					case WfInsCode::ConvertToType:
+						WriteLine(top + L" = WfRuntimeNativeHelper::ConvertToType(" + top + L", " + insRef + L");");
+						break;
+					case WfInsCode::TryConvertToType:
+						WriteLine(top + L" = WfRuntimeNativeHelper::TryConvertToType(" + top + L", " + insRef + L");");
+						break;
+					case WfInsCode::TestType:
+						WriteLine(top + L" = WfRuntimeNativeHelper::TestType(" + top + L", " + insRef + L");");
+						break;
+					case WfInsCode::GetType:
+						WriteLine(top + L" = Value::From(" + top + L".GetTypeDescriptor());");
+						break;
+					case WfInsCode::Jump:
+						WriteLine(L"goto L" + itow(ins.indexParameter) + L";");
+						break;
+					case WfInsCode::JumpIf:
+						WriteLine(L"if (UnboxValue<bool>(" + top + L")) { " + top + L" = Value(); goto L" + itow(ins.indexParameter) + L"; }");
+						break;
+					case WfInsCode::GetProperty:
+						{
+							WriteLine(L"{");
+							List<WString> arguments;
+							if (!WriteDirectCall(ins.propertyParameter->GetGetter(), insRef + L".propertyParameter->GetGetter()", top, arguments, top))
+							{
+								WriteLine(L"\t" + top + L" = " + insRef + L".propertyParameter->GetValue(" + top + L");");
+							}
+							WriteLine(L"}");
+						}
+						break;
+					case WfInsCode::SetProperty:
+						{
+							WriteLine(L"{");
+							List<WString> arguments;
+							arguments.Add(second);
+							if (!WriteDirectCall(ins.propertyParameter->GetSetter(), insRef + L".propertyParameter->GetSetter()", top, arguments, L""))
+							{
+								WriteLine(L"\t" + insRef + L".propertyParameter->SetValue(" + top + L", " + second + L");");
+							}
+							WriteLine(L"}");
+						}
+						break;
+					case WfInsCode::AttachEvent:
+						WriteLine(second + L" = WfRuntimeNativeHelper::AttachEvent(" + insRef + L".eventParameter, " + second + L", " + top + L");");
+						break;
+					case WfInsCode::DetachEvent:
+						WriteLine(top + L" = WfRuntimeNativeHelper::DetachEvent(" + top + L");");
+						break;
+					case WfInsCode::RaiseException:
+						WriteLine(L"WfRuntimeNativeHelper::RaiseException(" + top + L");");
+						break;
+					case WfInsCode::TestElementInSet:
+						WriteLine(second + L" = WfRuntimeNativeHelper::TestElementInSet(" + second + L", " + top + L");");
+						break;
+					case WfInsCode::CompareLiteral:
+						WriteLine(second + L" = WfRuntimeNativeHelper::CompareLiteral<" + type + L">(" + second + L", " + top + L");");
+						break;
+					case WfInsCode::CompareStruct:
+						WriteLine(second + L" = WfRuntimeNativeHelper::CompareStruct(" + second + L", " + top + L");");
+						break;
+					case WfInsCode::CompareReference:
+						WriteLine(second + L" = WfRuntimeNativeHelper::CompareReference(" + second + L", " + top + L");");
+						break;
+					case WfInsCode::OpNot:
+						WriteLine(top + L" = BoxValue<" + type + L">((" + type + L")(" + (ins.typeParameter == WfInsType::Bool ? L"!" : L"~") + L"UnboxValue<" + type + L">(" + top + L")));");
+						break;
+					case WfInsCode::OpPositive:
+					case WfInsCode::OpNegative:
+						WriteLine(top + L" = BoxValue<" + type + L">((" + type + L")(" + (ins.code == WfInsCode::OpPositive ? L"+" : L"-") + L"UnboxValue<" + type + L">(" + top + L")));");
+						break;
+					case WfInsCode::OpConcat:
+						WriteLine(second + L" = BoxValue<WString>(" + second + L".GetText() + " + top + L".GetText());");
+						break;
+					case WfInsCode::OpExp:
+						WriteLine(second + L" = BoxValue<" + type + L">((" + type + L")exp(UnboxValue<" + type + L">(" + top + L") * log(UnboxValue<" + type + L">(" + second + L"))));");
+						break;
+					case WfInsCode::OpAdd:
+					case WfInsCode::OpSub:
+					case WfInsCode::OpMul:
+					case WfInsCode::OpDiv:
+					case WfInsCode::OpMod:
+					case WfInsCode::OpShl:
+					case WfInsCode::OpShr:
+					case WfInsCode::OpXor:
+					case WfInsCode::OpAnd:
+					case WfInsCode::OpOr:
+						{
+							const wchar_t* op =
+								ins.code == WfInsCode::OpAdd ? L" + " :
+								ins.code == WfInsCode::OpSub ? L" - " :
+								ins.code == WfInsCode::OpMul ? L" * " :
+								ins.code == WfInsCode::OpDiv ? L" / " :
+								ins.code == WfInsCode::OpMod ? L" % " :
+								ins.code == WfInsCode::OpShl ? L" << " :
+								ins.code == WfInsCode::OpShr ? L" >> " :
+								ins.code == WfInsCode::OpXor ? L" ^ " :
+								ins.code == WfInsCode::OpAnd ? L" & " :
+								L" | ";
+							WriteLine(second + L" = BoxValue<" + type + L">((" + type + L")(UnboxValue<" + type + L">(" + second + L")" + op + L"UnboxValue<" + type + L">(" + top + L")));");
+						}
+						break;
+					default:;
+					}
+				}
+			public:
+				WfCppFunctionWriter(WfAssembly* _assembly, vint _functionIndex, Array<bool>& _translated, Array<vint>& _depths, vint _maxDepth, TextWriter& _writer)
+					:assembly(_assembly)
+					, functionIndex(_functionIndex)
+					, translated(_translated)
+					, depths(_depths)
+					, maxDepth(_maxDepth)
+					, writer(_writer)
+				{
+				}
+
+				void Write()
+				{
+					auto function = GetFunction();
+					for (vint i = function->firstInstruction; i <= function->lastInstruction; i++)
+					{
+						auto& ins = assembly->instructions[i];
+						if (IsReachable(i) && (ins.code == WfInsCode::Jump || ins.code == WfInsCode::JumpIf))
+						{
+							if (!labels.Contains(ins.indexParameter))
+							{
+								labels.Add(ins.indexParameter);
+							}
+						}
+					}
+
+					writer.WriteLine(L"\t// " + GetCppComment(function->name));
+					writer.WriteLine(L"\tValue " + GetCppFunctionName(functionIndex) + L"(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments)");
+					writer.WriteLine(L"\t{");
+					WriteLine(L"auto& ins = globalContext->assembly->instructions;");
+
+					vint argumentCount = function->argumentNames.Count();
+					vint variableCount = argumentCount + function->localVariableNames.Count();
+					for (vint i = 0; i < variableCount; i++)
+					{
+						WriteLine(L"Value v" + itow(i) + (i < argumentCount ? L" = arguments[" + itow(i) + L"];" : WString(L";")));
+					}
+					for (vint i = 0; i < maxDepth; i++)
+					{
+						WriteLine(L"Value " + GetCppStackValue(i) + L";");
+					}
+
+					bool skipNext = false;
+					for (vint i = function->firstInstruction; i <= function->lastInstruction; i++)
+					{
+						if (!IsReachable(i)) continue;
+						if (labels.Contains(i))
+						{
+							writer.WriteLine(L"\tL" + itow(i) + L":;");
+						}
+						if (skipNext)
+						{
+							skipNext = false;
+							continue;
+						}
+
+						auto& ins = assembly->instructions[i];
+						vint depth = GetDepth(i);
+						switch (ins.code)
+						{
+						case WfInsCode::OpLT:
+						case WfInsCode::OpGT:
+						case WfInsCode::OpLE:
+						case WfInsCode::OpGE:
+						case WfInsCode::OpEQ:
+						case WfInsCode::OpNE:
+							skipNext = WriteCondition(i, ins, depth);
+							break;
+						default:
+							WriteInstruction(i, ins, depth);
+						}
+
+						if (!skipNext && ins.code != WfInsCode::Return && ins.code != WfInsCode::RaiseException)
+						{
+							// release values that are popped from the stack, so that objects are released as early as the interpreter does
+							vint pop, push;
+							GetCppStackEffect(ins, pop, push);
+							for (vint j = depth - pop + push; j < depth; j++)
+							{
+								WriteLine(GetCppStackValue(j) + L" = Value();");
+							}
+						}
+					}
+					writer.WriteLine(L"\t}");
+					writer.WriteLine(L"");
+				}
+			};
+
+/***********************************************************************
+GenerateCppFile
+***********************************************************************/
+
+			void GenerateCppFile(Ptr<runtime::WfAssembly> assembly, const WString& name, const WString& include, stream::TextWriter& writer)
+			{
+				vint functionCount = assembly->functions.Count();
+				Array<bool> translated(functionCount);
+				Array<Array<vint>> depths(functionCount);
+				Array<vint> maxDepths(functionCount);
+				for (vint i = 0; i < functionCount; i++)
+				{
+					translated[i] = AnalyzeCppStackDepth(assembly.Obj(), assembly->functions[i].Obj(), depths[i], maxDepths[i]);
+				}
+
+				writer.WriteLine(L"/***********************************************************************");
+				writer.WriteLine(L"!!!!!! DO NOT MODIFY !!!!!!");
+				writer.WriteLine(L"");
+				writer.WriteLine(L"This file is generated by Workflow compiler");
+				writer.WriteLine(L"Call Register" + name + L"() to execute the assembly with native functions");
+				writer.WriteLine(L"***********************************************************************/");
+				writer.WriteLine(L"");
+				writer.WriteLine(L"#include \"" + include + L"\"");
+				writer.WriteLine(L"#include <math.h>");
+				writer.WriteLine(L"");
+				writer.WriteLine(L"using namespace vl;");
+				writer.WriteLine(L"using namespace vl::collections;");
+				writer.WriteLine(L"using namespace vl::reflection::description;");
+				writer.WriteLine(L"using namespace vl::workflow::runtime;");
+				writer.WriteLine(L"");
+				writer.WriteLine(L"namespace");
+				writer.WriteLine(L"{");
+
+				for (vint i = 0; i < functionCount; i++)
+				{
+					if (translated[i])
+					{
+						writer.WriteLine(L"\tValue " + GetCppFunctionName(i) + L"(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments);");
+					}
+				}
+				writer.WriteLine(L"");
+
+				for (vint i = 0; i < functionCount; i++)
+				{
+					if (translated[i])
+					{
+						WfCppFunctionWriter(assembly.Obj(), i, translated, depths[i], maxDepths[i], writer).Write();
+					}
+				}
+
+				writer.WriteLine(L"\tWfRuntimeNativeFunction nativeFunctions[] =");
+				writer.WriteLine(L"\t{");
+				for (vint i = 0; i < functionCount; i++)
+				{
+					writer.WriteLine(L"\t\t" + (translated[i] ? GetCppFunctionName(i) : WString(L"nullptr")) + L",");
+				}
+				if (functionCount == 0)
+				{
+					writer.WriteLine(L"\t\tnullptr,");
+				}
+				writer.WriteLine(L"\t};");
+				writer.WriteLine(L"");
+				writer.WriteLine(L"\tWfRuntimeNativeModule nativeModule = { " + u64tow(GetAssemblyChecksum(assembly.Obj())) + L"ULL, " + itow(functionCount) + L", nativeFunctions, nullptr };");
+				writer.WriteLine(L"}");
+				writer.WriteLine(L"");
+				writer.WriteLine(L"void Register" + name + L"()");
+				writer.WriteLine(L"{");
+				writer.WriteLine(L"\tRegisterNativeModule(&nativeModule);");
+				writer.WriteLine(L"}");
+				writer.WriteLine(L"");
+				writer.WriteLine(L"void Unregister" + name + L"()");
+				writer.WriteLine(L"{");
+				writer.WriteLine(L"\tUnregisterNativeModule(&nativeModule);");
+				writer.WriteLine(L"}");
+			}
+		}
+	}
+}
+
 /***********************************************************************
 ANALYZER\WFANALYZER_GENERATEDECLARATION.CPP
 ***********************************************************************/
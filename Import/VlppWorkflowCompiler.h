@@ -2260,6 +2260,13 @@ Code Generation
 			/// <param name="manager">The Workflow compiler.</param>
 			extern Ptr<runtime::WfAssembly>					GenerateAssembly(WfLexicalScopeManager* manager);
 
+			/// <summary>Translate all functions in an assembly to C++ functions. Functions that cannot be translated, e.g. those containing try statements, are executed by the interpreter. Methods and properties registered from C++ members are called directly without reflection, when all parameter types are not generic. The generated file defines void Register[name]() and void Unregister[name](). After the module is registered, every [T:vl.workflow.runtime.WfRuntimeGlobalContext] created for an assembly with the same checksum executes the generated functions when no debugger is attached.</summary>
+			/// <param name="assembly">The assembly.</param>
+			/// <param name="name">The name to generate registration functions.</param>
+			/// <param name="include">The header file to include in the generated C++ code, it should be VlppWorkflow.h or a file that includes it.</param>
+			/// <param name="writer">The writer to receive the generated C++ code.</param>
+			extern void										GenerateCppFile(Ptr<runtime::WfAssembly> assembly, const WString& name, const WString& include, stream::TextWriter& writer);
+
 			/// <summary>Compile a Workflow program.</summary>
 			/// <returns>The generated assembly.</returns>
 			/// <param name="table">The workflow parser table. It can be retrived from [M:vl.workflow.WfLoadTable].</param>
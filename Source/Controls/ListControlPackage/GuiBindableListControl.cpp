@@ -13,12 +13,61 @@ namespace vl
 			using namespace reflection::description;
 			using namespace templates;
 
-			Value ReadProperty(const Value& thisObject, const WString& propertyName)
+/***********************************************************************
+ItemPropertyCache
+***********************************************************************/
+
+			IPropertyInfo* ItemPropertyCache::GetPropertyInfo(ITypeDescriptor* td, const WString& name)
+			{
+				// cells of a data grid are read from parallel tasks when parallelReordering is enabled, so the cache is only accessed in the lock
+				SPIN_LOCK(cacheLock)
+				{
+					// property names are usually copies of the same string, so comparing buffers avoids comparing characters
+					if (td == typeDescriptor && (name.Buffer() == propertyName.Buffer() || name == propertyName))
+					{
+						return propertyInfo;
+					}
+				}
+
+				// searching the property does not need the lock
+				auto info = td ? td->GetPropertyByName(name, true) : nullptr;
+				SPIN_LOCK(cacheLock)
+				{
+					typeDescriptor = td;
+					propertyName = name;
+					propertyInfo = info;
+				}
+				return info;
+			}
+
+			ItemPropertyCache::ItemPropertyCache()
+				:typeDescriptor(nullptr)
+				, propertyInfo(nullptr)
+			{
+			}
+
+			ItemPropertyCache::ItemPropertyCache(const ItemPropertyCache&)
+				:typeDescriptor(nullptr)
+				, propertyInfo(nullptr)
+			{
+			}
+
+			ItemPropertyCache& ItemPropertyCache::operator=(const ItemPropertyCache&)
 			{
-				if (!thisObject.IsNull() && propertyName != L"")
+				SPIN_LOCK(cacheLock)
 				{
-					auto td = thisObject.GetTypeDescriptor();
-					auto info = td->GetPropertyByName(propertyName, true);
+					typeDescriptor = nullptr;
+					propertyName = WString::Empty;
+					propertyInfo = nullptr;
+				}
+				return *this;
+			}
+
+			Value ItemPropertyCache::Read(const Value& thisObject, const WString& name)
+			{
+				if (!thisObject.IsNull() && name != L"")
+				{
+					auto info = GetPropertyInfo(thisObject.GetTypeDescriptor(), name);
 					if (info && info->IsReadable())
 					{
 						return info->GetValue(thisObject);
@@ -31,12 +80,11 @@ namespace vl
 				return thisObject;
 			}
 
-			void WriteProperty(Value& thisObject, const WString& propertyName, const Value& newValue)
+			void ItemPropertyCache::Write(Value& thisObject, const WString& name, const Value& newValue)
 			{
-				if (!thisObject.IsNull() && propertyName != L"")
+				if (!thisObject.IsNull() && name != L"")
 				{
-					auto td = thisObject.GetTypeDescriptor();
-					auto info = td->GetPropertyByName(propertyName, true);
+					auto info = GetPropertyInfo(thisObject.GetTypeDescriptor(), name);
 					if (info && info->IsWritable())
 					{
 						info->SetValue(thisObject, newValue);
@@ -179,7 +227,7 @@ GuiBindableTextList::ItemSource
 				{
 					if (0 <= itemIndex && itemIndex < itemSource->GetCount())
 					{
-						return ReadProperty(itemSource->Get(itemIndex), textProperty).GetText();
+						return textPropertyCache.Read(itemSource->Get(itemIndex), textProperty).GetText();
 					}
 				}
 				return L"";
@@ -191,7 +239,7 @@ GuiBindableTextList::ItemSource
 				{
 					if (0 <= itemIndex && itemIndex < itemSource->GetCount())
 					{
-						auto value = ReadProperty(itemSource->Get(itemIndex), checkedProperty);
+						auto value = checkedPropertyCache.Read(itemSource->Get(itemIndex), checkedProperty);
 						if (value.GetTypeDescriptor() == description::GetTypeDescriptor<bool>())
 						{
 							return UnboxValue<bool>(value);
@@ -208,7 +256,7 @@ GuiBindableTextList::ItemSource
 					if (0 <= itemIndex && itemIndex < itemSource->GetCount())
 					{
 						auto thisValue = itemSource->Get(itemIndex);
-						WriteProperty(thisValue, checkedProperty, BoxValue(value));
+						checkedPropertyCache.Write(thisValue, checkedProperty, BoxValue(value));
 					}
 				}
 			}
@@ -281,6 +329,15 @@ GuiBindableTextList
 GuiBindableListView::ItemSource
 ***********************************************************************/
 
+			ItemPropertyCache& GuiBindableListView::ItemSource::GetColumnTextPropertyCache(vint column)
+			{
+				if (columnTextPropertyCaches.Count() <= column)
+				{
+					columnTextPropertyCaches.Resize(columns.Count() > column ? columns.Count() : column + 1);
+				}
+				return columnTextPropertyCaches[column];
+			}
+
 			GuiBindableListView::ItemSource::ItemSource()
 				:columns(this)
 				, dataColumns(this)
@@ -456,7 +513,7 @@ GuiBindableListView::ItemSource
 				{
 					if (0 <= itemIndex && itemIndex < itemSource->GetCount())
 					{
-						auto value = ReadProperty(itemSource->Get(itemIndex), smallImageProperty);
+						auto value = smallImagePropertyCache.Read(itemSource->Get(itemIndex), smallImageProperty);
 						return value.GetSharedPtr().Cast<GuiImageData>();
 					}
 				}
@@ -469,7 +526,7 @@ GuiBindableListView::ItemSource
 				{
 					if (0 <= itemIndex && itemIndex < itemSource->GetCount())
 					{
-						auto value = ReadProperty(itemSource->Get(itemIndex), largeImageProperty);
+						auto value = largeImagePropertyCache.Read(itemSource->Get(itemIndex), largeImageProperty);
 						return value.GetSharedPtr().Cast<GuiImageData>();
 					}
 				}
@@ -482,7 +539,7 @@ GuiBindableListView::ItemSource
 				{
 					if (0 <= itemIndex && itemIndex < itemSource->GetCount() && columns.Count()>0)
 					{
-						return ReadProperty(itemSource->Get(itemIndex), columns[0]->GetTextProperty()).GetText();
+						return GetColumnTextPropertyCache(0).Read(itemSource->Get(itemIndex), columns[0]->GetTextProperty()).GetText();
 					}
 				}
 				return L"";
@@ -494,7 +551,7 @@ GuiBindableListView::ItemSource
 				{
 					if (0 <= itemIndex && itemIndex < itemSource->GetCount() && 0 <= index && index < columns.Count() - 1)
 					{
-						return ReadProperty(itemSource->Get(itemIndex), columns[index + 1]->GetTextProperty()).GetText();
+						return GetColumnTextPropertyCache(index + 1).Read(itemSource->Get(itemIndex), columns[index + 1]->GetTextProperty()).GetText();
 					}
 				}
 				return L"";
@@ -682,7 +739,7 @@ GuiBindableTreeView::ItemSourceNode
 			{
 				if (!childrenVirtualList)
 				{
-					auto value = ReadProperty(itemSource, rootProvider->childrenProperty);
+					auto value = rootProvider->childrenPropertyCache.Read(itemSource, rootProvider->childrenProperty);
 					if (auto td = value.GetTypeDescriptor())
 					{
 						if (td->CanConvertTo(description::GetTypeDescriptor<IValueObservableList>()))
@@ -691,6 +748,13 @@ GuiBindableTreeView::ItemSourceNode
 							itemChangedEventHandler = ol->ItemChanged.Add([this](vint start, vint oldCount, vint newCount)
 							{
 								callback->OnBeforeItemModified(this, start, oldCount, newCount);
+								vint offset = newCount;
+								for (vint i = 0; i < oldCount; i++)
+								{
+									auto node = children[start + i];
+									offset -= node->totalVisibleNodeCount;
+									node->parent = nullptr;
+								}
 								children.RemoveRange(start, oldCount);
 								for (vint i = 0; i < newCount; i++)
 								{
@@ -698,6 +762,11 @@ GuiBindableTreeView::ItemSourceNode
 									auto node = new ItemSourceNode(value, this);
 									children.Insert(start + i, node);
 								}
+								childVisibleNodesModified = true;
+								if (GetExpanding())
+								{
+									OnTotalVisibleNodesChanged(offset);
+								}
 								callback->OnAfterItemModified(this, start, oldCount, newCount);
 							});
 							childrenVirtualList = ol;
@@ -725,6 +794,12 @@ GuiBindableTreeView::ItemSourceNode
 						auto node = new ItemSourceNode(value, this);
 						children.Add(node);
 					}
+
+					childVisibleNodesModified = true;
+					if (GetExpanding())
+					{
+						OnTotalVisibleNodesChanged(count);
+					}
 				}
 			}
 
@@ -739,9 +814,47 @@ GuiBindableTreeView::ItemSourceNode
 				childrenVirtualList = nullptr;
 				FOREACH(Ptr<ItemSourceNode>, node, children)
 				{
+					node->parent = nullptr;
 					node->UnprepareChildren();
 				}
 				children.Clear();
+
+				childVisibleNodesModified = true;
+				OnTotalVisibleNodesChanged(1 - totalVisibleNodeCount);
+			}
+
+			void GuiBindableTreeView::ItemSourceNode::EnsureChildVisibleNodes()
+			{
+				if (childVisibleNodesModified)
+				{
+					childVisibleNodesModified = false;
+					for (vint i = 0; i < children.Count(); i++)
+					{
+						children[i]->indexInParent = i;
+					}
+					childVisibleNodes.Rebuild(children.Count(), [this](vint index) {return children[index]->totalVisibleNodeCount; });
+				}
+			}
+
+			void GuiBindableTreeView::ItemSourceNode::OnTotalVisibleNodesChanged(vint offset)
+			{
+				totalVisibleNodeCount += offset;
+				if (parent)
+				{
+					parent->OnChildTotalVisibleNodesChanged(this, offset);
+				}
+			}
+
+			void GuiBindableTreeView::ItemSourceNode::OnChildTotalVisibleNodesChanged(ItemSourceNode* child, vint offset)
+			{
+				if (!childVisibleNodesModified)
+				{
+					childVisibleNodes.Add(child->indexInParent, offset);
+				}
+				if (GetExpanding())
+				{
+					OnTotalVisibleNodesChanged(offset);
+				}
 			}
 
 			GuiBindableTreeView::ItemSourceNode::ItemSourceNode(const description::Value& _itemSource, ItemSourceNode* _parent)
@@ -788,7 +901,11 @@ GuiBindableTreeView::ItemSourceNode
 			{
 				if (this != rootProvider->rootNode.Obj() && expanding != value)
 				{
+					PrepareChildren();
 					expanding = value;
+					EnsureChildVisibleNodes();
+					vint offset = childVisibleNodes.GetTotalVisibleNodes();
+					OnTotalVisibleNodesChanged(expanding ? offset : -offset);
 					if (expanding)
 					{
 						callback->OnItemExpanded(this);
@@ -808,12 +925,7 @@ GuiBindableTreeView::ItemSourceNode
 				}
 
 				PrepareChildren();
-				vint count = 1;
-				FOREACH(Ptr<ItemSourceNode>, child, children)
-				{
-					count += child->CalculateTotalVisibleNodes();
-				}
-				return count;
+				return totalVisibleNodeCount;
 			}
 
 			vint GuiBindableTreeView::ItemSourceNode::GetChildCount()
@@ -845,6 +957,30 @@ GuiBindableTreeView::ItemSourceNode
 			{
 			}
 
+			vint GuiBindableTreeView::ItemSourceNode::GetIndexInParent()
+			{
+				if (parent)
+				{
+					parent->EnsureChildVisibleNodes();
+					return indexInParent;
+				}
+				return -1;
+			}
+
+			vint GuiBindableTreeView::ItemSourceNode::CalculateVisibleNodesBeforeChild(vint index)
+			{
+				PrepareChildren();
+				EnsureChildVisibleNodes();
+				return childVisibleNodes.GetVisibleNodesBefore(index);
+			}
+
+			vint GuiBindableTreeView::ItemSourceNode::FindChildByVisibleOffset(vint& offset)
+			{
+				PrepareChildren();
+				EnsureChildVisibleNodes();
+				return childVisibleNodes.FindByVisibleOffset(offset);
+			}
+
 /***********************************************************************
 GuiBindableTreeView::ItemSource
 ***********************************************************************/
@@ -935,7 +1071,7 @@ GuiBindableTreeView::ItemSource
 			{
 				if (auto itemSourceNode = dynamic_cast<ItemSourceNode*>(node))
 				{
-					auto value = ReadProperty(itemSourceNode->GetItemSource(), imageProperty);
+					auto value = imagePropertyCache.Read(itemSourceNode->GetItemSource(), imageProperty);
 					return value.GetSharedPtr().Cast<GuiImageData>();
 				}
 				return nullptr;
@@ -945,7 +1081,7 @@ GuiBindableTreeView::ItemSource
 			{
 				if (auto itemSourceNode = dynamic_cast<ItemSourceNode*>(node))
 				{
-					return ReadProperty(itemSourceNode->GetItemSource(), textProperty).GetText();
+					return textPropertyCache.Read(itemSourceNode->GetItemSource(), textProperty).GetText();
 				}
 				return L"";
 			}
@@ -1078,7 +1214,7 @@ GuiBindableDataColumn
 					{
 						if (0 <= row && row < dataProvider->itemSource->GetCount())
 						{
-							return ReadProperty(dataProvider->itemSource->Get(row), valueProperty);
+							return valuePropertyCache.Read(dataProvider->itemSource->Get(row), valueProperty);
 						}
 					}
 					return Value();
@@ -1091,7 +1227,7 @@ GuiBindableDataColumn
 						if (0 <= row && row < dataProvider->itemSource->GetCount())
 						{
 							auto rowValue = dataProvider->itemSource->Get(row);
-							return WriteProperty(rowValue, valueProperty, value);
+							return valuePropertyCache.Write(rowValue, valueProperty, value);
 						}
 					}
 				}
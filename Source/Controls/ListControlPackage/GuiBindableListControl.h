@@ -21,6 +21,40 @@ namespace vl
 		namespace controls
 		{
 
+/***********************************************************************
+ItemPropertyCache
+***********************************************************************/
+
+			/// <summary>Reads and writes a property of items by name. The property is only searched again when the type of the item or the property name is different from the last access. A cache could be used by multiple threads.</summary>
+			class ItemPropertyCache
+			{
+			protected:
+				SpinLock											cacheLock;
+				description::ITypeDescriptor*						typeDescriptor;
+				WString												propertyName;
+				description::IPropertyInfo*							propertyInfo;
+
+				description::IPropertyInfo*							GetPropertyInfo(description::ITypeDescriptor* td, const WString& name);
+			public:
+				ItemPropertyCache();
+				/// <summary>Create an empty cache. The cached property is not copied.</summary>
+				ItemPropertyCache(const ItemPropertyCache&);
+				/// <summary>Clear the cache. The cached property is not copied.</summary>
+				/// <returns>The cache itself.</returns>
+				ItemPropertyCache&									operator=(const ItemPropertyCache&);
+
+				/// <summary>Read a property.</summary>
+				/// <returns>The property value. Returns the item itself if the property name is empty.</returns>
+				/// <param name="thisObject">The item.</param>
+				/// <param name="name">The property name.</param>
+				description::Value									Read(const description::Value& thisObject, const WString& name);
+				/// <summary>Write a property.</summary>
+				/// <param name="thisObject">The item.</param>
+				/// <param name="name">The property name.</param>
+				/// <param name="newValue">The property value.</param>
+				void												Write(description::Value& thisObject, const WString& name, const description::Value& newValue);
+			};
+
 /***********************************************************************
 GuiBindableTextList
 ***********************************************************************/
@@ -37,6 +71,8 @@ GuiBindableTextList
 				protected:
 					Ptr<EventHandler>								itemChangedEventHandler;
 					Ptr<description::IValueReadonlyList>			itemSource;
+					ItemPropertyCache								textPropertyCache;
+					ItemPropertyCache								checkedPropertyCache;
 
 				public:
 					WString											textProperty;
@@ -138,6 +174,11 @@ GuiBindableListView
 					ColumnItemViewCallbackList						columnItemViewCallbacks;
 					Ptr<EventHandler>								itemChangedEventHandler;
 					Ptr<description::IValueReadonlyList>			itemSource;
+					ItemPropertyCache								largeImagePropertyCache;
+					ItemPropertyCache								smallImagePropertyCache;
+					collections::Array<ItemPropertyCache>			columnTextPropertyCaches;
+
+					ItemPropertyCache&								GetColumnTextPropertyCache(vint column);
 
 				public:
 					WString											largeImageProperty;
@@ -258,6 +299,7 @@ GuiBindableTreeView
 				class ItemSourceNode
 					: public Object
 					, public virtual tree::INodeProvider
+					, public virtual tree::INodeVisibleOffsetLocator
 				{
 					friend class ItemSource;
 					typedef collections::List<Ptr<ItemSourceNode>>	NodeList;
@@ -271,9 +313,16 @@ GuiBindableTreeView
 					Ptr<EventHandler>								itemChangedEventHandler;
 					Ptr<description::IValueReadonlyList>			childrenVirtualList;
 					NodeList										children;
+					vint											totalVisibleNodeCount = 1;
+					vint											indexInParent = -1;
+					bool											childVisibleNodesModified = true;
+					tree::NodeVisibleCountTree						childVisibleNodes;
 
 					void											PrepareChildren();
 					void											UnprepareChildren();
+					void											EnsureChildVisibleNodes();
+					void											OnTotalVisibleNodesChanged(vint offset);
+					void											OnChildTotalVisibleNodesChanged(ItemSourceNode* child, vint offset);
 				public:
 					ItemSourceNode(const description::Value& _itemSource, ItemSourceNode* _parent);
 					ItemSourceNode(ItemSource* _rootProvider);
@@ -293,6 +342,12 @@ GuiBindableTreeView
 					tree::INodeProvider*							GetChild(vint index)override;
 					void											Increase()override;
 					void											Release()override;
+
+					// ===================== tree::INodeVisibleOffsetLocator =====================
+
+					vint											GetIndexInParent()override;
+					vint											CalculateVisibleNodesBeforeChild(vint index)override;
+					vint											FindChildByVisibleOffset(vint& offset)override;
 				};
 
 				class ItemSource
@@ -305,6 +360,9 @@ GuiBindableTreeView
 					WString											textProperty;
 					WString											imageProperty;
 					WString											childrenProperty;
+					ItemPropertyCache								textPropertyCache;
+					ItemPropertyCache								imagePropertyCache;
+					ItemPropertyCache								childrenPropertyCache;
 					Ptr<ItemSourceNode>								rootNode;
 
 				public:
@@ -401,6 +459,7 @@ GuiBindableDataGrid
 				protected:
 					BindableDataProvider*							dataProvider;
 					WString											valueProperty;
+					ItemPropertyCache								valuePropertyCache;
 
 				public:
 					BindableDataColumn();
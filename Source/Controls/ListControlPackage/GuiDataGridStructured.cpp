@@ -79,7 +79,7 @@ StructuredDataAndFilter
 
 				bool StructuredDataAndFilter::Filter(vint row)
 				{
-					return From(filters)
+					return PipelineFrom(filters)
 						.All([row](Ptr<IStructuredDataFilter> filter)
 						{
 							return filter->Filter(row);
@@ -96,7 +96,7 @@ StructuredDataOrFilter
 
 				bool StructuredDataOrFilter::Filter(vint row)
 				{
-					return From(filters)
+					return PipelineFrom(filters)
 						.Any([row](Ptr<IStructuredDataFilter> filter)
 						{
 							return filter->Filter(row);
@@ -186,6 +186,11 @@ StructuredDataReverseSorter
 				{
 				}
 
+				Ptr<IStructuredDataSorter> StructuredDataReverseSorter::GetSubSorter()
+				{
+					return sorter;
+				}
+
 				bool StructuredDataReverseSorter::SetSubSorter(Ptr<IStructuredDataSorter> value)
 				{
 					if(sorter==value) return false;
@@ -197,6 +202,107 @@ StructuredDataReverseSorter
 				{
 					return sorter?-sorter->Compare(row1, row2):0;
 				}
+
+/***********************************************************************
+StructuredDataParallelTasks
+***********************************************************************/
+
+				vint StructuredDataParallelTasks::GetTaskCount(vint rowCount)
+				{
+					vint taskCount=rowCount/MinimumRowsPerTask;
+					vint cpuCount=Thread::GetCPUCount();
+					if(taskCount>cpuCount) taskCount=cpuCount;
+					return taskCount<1?1:taskCount;
+				}
+
+				struct StructuredDataParallelTaskState
+				{
+					volatile vint						remainingTasks=0;
+					EventObject							finished;
+					SpinLock							lock;
+					Ptr<Exception>						exception;
+					const wchar_t*						error=nullptr;
+				};
+
+				void StructuredDataParallelTasks::Run(vint taskCount, const Func<void(vint)>& task)
+				{
+					if(taskCount<=1)
+					{
+						if(taskCount==1) task(0);
+						return;
+					}
+
+					// the state is shared with workers, because a worker may still be inside Signal when the waiting thread wakes up
+					auto state=MakePtr<StructuredDataParallelTaskState>();
+					state->remainingTasks=taskCount-1;
+					state->finished.CreateManualUnsignal(false);
+
+					// every pooled task decreases the counter even if it fails, so that Wait always returns before task goes out of scope
+					auto runTask=[&task](Ptr<StructuredDataParallelTaskState> state, vint index)
+					{
+						try
+						{
+							task(index);
+						}
+						catch(const Exception& e)
+						{
+							SPIN_LOCK(state->lock)
+							{
+								if(!state->exception && !state->error) state->exception=new Exception(e.Message());
+							}
+						}
+						catch(const Error& e)
+						{
+							SPIN_LOCK(state->lock)
+							{
+								if(!state->exception && !state->error) state->error=e.Description();
+							}
+						}
+						catch(...)
+						{
+							SPIN_LOCK(state->lock)
+							{
+								if(!state->exception && !state->error) state->error=L"vl::presentation::controls::list::StructuredDataParallelTasks::Run(vint, const Func<void(vint)>&)#A task failed with an unknown exception.";
+							}
+						}
+						if(DECRC(&state->remainingTasks)==0)
+						{
+							state->finished.Signal();
+						}
+					};
+
+					for(vint i=1;i<taskCount;i++)
+					{
+						if(!ThreadPoolLite::Queue(Func<void()>([runTask, state, i]()
+						{
+							runTask(state, i);
+						})))
+						{
+							runTask(state, i);
+						}
+					}
+
+					try
+					{
+						task(0);
+					}
+					catch(...)
+					{
+						state->finished.Wait();
+						throw;
+					}
+					state->finished.Wait();
+
+					// an exception from a pooled task is rethrown in the current thread, Exception is rethrown without its derived type
+					if(state->exception)
+					{
+						throw Exception(state->exception->Message());
+					}
+					if(state->error)
+					{
+						throw Error(state->error);
+					}
+				}
 				
 /***********************************************************************
 StructuredDataProvider
@@ -220,6 +326,10 @@ StructuredDataProvider
 						}
 						commandExecutor->OnDataProviderItemModified(start, count, newCount);
 					}
+					else if(newCount<=MaxIncrementalReorderingRows)
+					{
+						ReorderModifiedRows(start, count, newCount);
+					}
 					else
 					{
 						ReorderRows(true);
@@ -246,7 +356,7 @@ StructuredDataProvider
 					List<Ptr<IStructuredDataFilter>> selectedFilters;
 					CopyFrom(
 						selectedFilters,
-						Range<vint>(0, GetColumnCount())
+						PipelineRange<vint>(0, GetColumnCount())
 							.Select([this](vint column){return structuredDataProvider->GetColumn(column)->GetInherentFilter();})
 							.Where([](Ptr<IStructuredDataFilter> filter){return (bool)filter;})
 						);
@@ -283,11 +393,35 @@ StructuredDataProvider
 
 					if(currentFilter)
 					{
-						for(vint i=0;i<rowCount;i++)
+						vint taskCount=parallelReordering?StructuredDataParallelTasks::GetTaskCount(rowCount):1;
+						if(taskCount==1)
 						{
-							if(currentFilter->Filter(i))
+							for(vint i=0;i<rowCount;i++)
 							{
-								reorderedRows.Add(i);
+								if(currentFilter->Filter(i))
+								{
+									reorderedRows.Add(i);
+								}
+							}
+						}
+						else
+						{
+							IStructuredDataFilter* filter=currentFilter.Obj();
+							Array<bool> accepted(rowCount);
+							StructuredDataParallelTasks::Run(taskCount, [=, &accepted](vint task)
+							{
+								vint end=rowCount*(task+1)/taskCount;
+								for(vint i=rowCount*task/taskCount;i<end;i++)
+								{
+									accepted[i]=filter->Filter(i);
+								}
+							});
+							for(vint i=0;i<rowCount;i++)
+							{
+								if(accepted[i])
+								{
+									reorderedRows.Add(i);
+								}
 							}
 						}
 					}
@@ -299,10 +433,31 @@ StructuredDataProvider
 						}
 					}
 
-					if(currentSorter && reorderedRows.Count()>0)
+					if(currentSorter && reorderedRows.Count()>1)
 					{
 						IStructuredDataSorter* sorter=currentSorter.Obj();
-						SortLambda(&reorderedRows[0], reorderedRows.Count(), [sorter](vint a, vint b){return sorter->Compare(a, b);});
+						bool ascending=true;
+						if(auto reverseSorter=dynamic_cast<StructuredDataReverseSorter*>(sorter))
+						{
+							sorter=reverseSorter->GetSubSorter().Obj();
+							ascending=false;
+						}
+
+						// rows are compared by their indices when the sorter cannot tell, so that the order is stable
+						vint taskCount=parallelReordering?StructuredDataParallelTasks::GetTaskCount(reorderedRows.Count()):1;
+						if(auto keySorter=dynamic_cast<IStructuredDataKeySorter*>(sorter))
+						{
+							keySorter->SortRows(reorderedRows, ascending, taskCount);
+						}
+						else if(sorter)
+						{
+							StructuredDataParallelTasks::Sort(&reorderedRows[0], reorderedRows.Count(), taskCount, [sorter, ascending](vint a, vint b)
+							{
+								vint result=sorter->Compare(a, b);
+								if(!ascending) result=-result;
+								return result!=0?result:a-b;
+							});
+						}
 					}
 
 					if(invokeCallback && commandExecutor)
@@ -311,6 +466,78 @@ StructuredDataProvider
 					}
 				}
 
+				void StructuredDataProvider::ReorderModifiedRows(vint start, vint count, vint newCount)
+				{
+					// the modified range is [prefix, oldRowCount-suffix) before and [prefix, newRowCount-suffix) after
+					vint oldRowCount=reorderedRows.Count();
+					vint prefix=oldRowCount;
+					vint suffix=oldRowCount;
+
+					// remove modified rows and shift row numbers after them
+					vint delta=newCount-count;
+					vint writing=0;
+					for(vint i=0;i<oldRowCount;i++)
+					{
+						vint row=reorderedRows[i];
+						if(row<start)
+						{
+							reorderedRows[writing++]=row;
+						}
+						else if(row>=start+count)
+						{
+							reorderedRows[writing++]=row+delta;
+						}
+						else
+						{
+							if(prefix>i) prefix=i;
+							suffix=oldRowCount-i-1;
+						}
+					}
+					if(writing<oldRowCount)
+					{
+						reorderedRows.RemoveRange(writing, oldRowCount-writing);
+					}
+
+					// insert accepted rows by binary search, rows are compared by their indices when the sorter cannot tell, which is the order that ReorderRows produces
+					IStructuredDataSorter* sorter=currentSorter.Obj();
+					for(vint row=start;row<start+newCount;row++)
+					{
+						if(currentFilter && !currentFilter->Filter(row)) continue;
+
+						vint first=0;
+						vint last=reorderedRows.Count();
+						while(first<last)
+						{
+							vint middle=(first+last)/2;
+							vint existingRow=reorderedRows[middle];
+							vint result=sorter?sorter->Compare(existingRow, row):0;
+							if(result==0) result=existingRow-row;
+							if(result<0)
+							{
+								first=middle+1;
+							}
+							else
+							{
+								last=middle;
+							}
+						}
+						reorderedRows.Insert(first, row);
+						if(prefix>first) prefix=first;
+						if(suffix>reorderedRows.Count()-first-1) suffix=reorderedRows.Count()-first-1;
+					}
+
+					vint newRowCount=reorderedRows.Count();
+					if(prefix>newRowCount) prefix=newRowCount;
+					if(suffix>oldRowCount-prefix) suffix=oldRowCount-prefix;
+					if(suffix>newRowCount-prefix) suffix=newRowCount-prefix;
+					vint modifiedCount=oldRowCount-prefix-suffix;
+					vint newModifiedCount=newRowCount-prefix-suffix;
+					if(commandExecutor && (modifiedCount>0 || newModifiedCount>0))
+					{
+						commandExecutor->OnDataProviderItemModified(prefix, modifiedCount, newModifiedCount);
+					}
+				}
+
 				vint StructuredDataProvider::TranslateRowNumber(vint row)
 				{
 					return reorderedRows[row];
@@ -333,9 +560,20 @@ StructuredDataProvider
 					ReorderRows(true);
 				}
 
+				bool StructuredDataProvider::GetParallelReordering()
+				{
+					return parallelReordering;
+				}
+
+				void StructuredDataProvider::SetParallelReordering(bool value)
+				{
+					parallelReordering=value;
+				}
+
 				StructuredDataProvider::StructuredDataProvider(Ptr<IStructuredDataProvider> provider)
 					:structuredDataProvider(provider)
 					,commandExecutor(0)
+					,parallelReordering(false)
 				{
 					structuredDataProvider->SetCommandExecutor(this);
 					RebuildFilter(false);
@@ -129,6 +129,9 @@ Sorter Extensions
 					/// <summary>Create the sorter.</summary>
 					StructuredDataReverseSorter();
 					
+					/// <summary>Get the sub sorter.</summary>
+					/// <returns>The sub sorter.</returns>
+					Ptr<IStructuredDataSorter>							GetSubSorter();
 					/// <summary>Set the sub sorter.</summary>
 					/// <returns>Returns true if this operation succeeded.</returns>
 					/// <param name="value">The sub sorter.</param>
@@ -136,6 +139,100 @@ Sorter Extensions
 					vint												Compare(vint row1, vint row2)override;
 				};
 
+/***********************************************************************
+Parallel Reordering
+***********************************************************************/
+
+				/// <summary>Helper functions to split filtering and sorting into tasks that run on the thread pool.</summary>
+				class StructuredDataParallelTasks
+				{
+				public:
+					/// <summary>The minimum number of rows for each task.</summary>
+					static const vint									MinimumRowsPerTask=16384;
+
+					/// <summary>Get the number of tasks to process rows.</summary>
+					/// <returns>The number of tasks, which is at least 1 and at most the number of processors.</returns>
+					/// <param name="rowCount">The number of rows.</param>
+					static vint											GetTaskCount(vint rowCount);
+					/// <summary>Run tasks and wait until all of them finish. The first task runs in the current thread, others run on the thread pool, or in the current thread if they cannot be queued. If any task fails, the first exception is rethrown after all tasks finish.</summary>
+					/// <param name="taskCount">The number of tasks.</param>
+					/// <param name="task">The task, which receives the task index.</param>
+					static void											Run(vint taskCount, const Func<void(vint)>& task);
+
+					/// <summary>Sort items. Each task sorts a chunk of items, and sorted chunks are merged in parallel.</summary>
+					/// <typeparam name="T">Type of items.</typeparam>
+					/// <typeparam name="F">Type of the orderer. It returns a negative number, 0 or a positive number, like <see cref="IStructuredDataSorter::Compare"/>.</typeparam>
+					/// <param name="items">The items to sort.</param>
+					/// <param name="count">The number of items.</param>
+					/// <param name="taskCount">The number of tasks.</param>
+					/// <param name="orderer">The orderer.</param>
+					template<typename T, typename F>
+					static void Sort(T* items, vint count, vint taskCount, const F& orderer)
+					{
+						if(count<2) return;
+						if(taskCount>count) taskCount=count;
+						if(taskCount<=1)
+						{
+							collections::SortLambda(items, count, orderer);
+							return;
+						}
+
+						collections::Array<vint> bounds(taskCount+1);
+						for(vint i=0;i<=taskCount;i++)
+						{
+							bounds[i]=count*i/taskCount;
+						}
+						Run(taskCount, [&](vint task)
+						{
+							collections::SortLambda(items+bounds[task], bounds[task+1]-bounds[task], orderer);
+						});
+
+						collections::Array<T> buffer(count);
+						T* source=items;
+						T* target=&buffer[0];
+						for(vint width=1;width<taskCount;width*=2)
+						{
+							Run((taskCount+width*2-1)/(width*2), [&](vint merge)
+							{
+								vint first=merge*width*2;
+								vint i=bounds[first];
+								vint middle=bounds[first+width<taskCount?first+width:taskCount];
+								vint j=middle;
+								vint last=bounds[first+width*2<taskCount?first+width*2:taskCount];
+								vint k=i;
+								while(i<middle && j<last)
+								{
+									target[k++]=orderer(source[j], source[i])<0?source[j++]:source[i++];
+								}
+								while(i<middle) target[k++]=source[i++];
+								while(j<last) target[k++]=source[j++];
+							});
+							T* temp=source;
+							source=target;
+							target=temp;
+						}
+
+						if(source!=items)
+						{
+							for(vint i=0;i<count;i++)
+							{
+								items[i]=source[i];
+							}
+						}
+					}
+				};
+
+				/// <summary>A <see cref="IStructuredDataSorter"/> that extracts a sort key once for each row, instead of reading rows for each comparison. <see cref="StructuredDataProvider"/> prefers this interface when it exists.</summary>
+				class IStructuredDataKeySorter : public virtual Interface
+				{
+				public:
+					/// <summary>Sort rows. Rows that are equal keep their order.</summary>
+					/// <param name="rows">The rows to sort.</param>
+					/// <param name="ascending">Set to false to sort rows in the reverse order.</param>
+					/// <param name="taskCount">The number of tasks to extract keys and sort rows. When it is greater than 1, the sorter and the data provider are called from multiple threads.</param>
+					virtual void										SortRows(collections::List<vint>& rows, bool ascending, vint taskCount)=0;
+				};
+
 /***********************************************************************
 Structured DataSource Extensions
 ***********************************************************************/
@@ -155,14 +252,19 @@ Structured DataSource Extensions
 					Ptr<IStructuredDataFilter>							currentFilter;
 					Ptr<IStructuredDataSorter>							currentSorter;
 					collections::List<vint>								reorderedRows;
+					bool												parallelReordering;
 					
 					void												OnDataProviderColumnChanged()override;
 					void												OnDataProviderItemModified(vint start, vint count, vint newCount)override;
 					void												OnFilterChanged()override;
 					void												RebuildFilter(bool invokeCallback);
 					void												ReorderRows(bool invokeCallback);
+					void												ReorderModifiedRows(vint start, vint count, vint newCount);
 					vint												TranslateRowNumber(vint row);
 				public:
+					/// <summary>When no more than this number of rows are inserted or modified at the same time, only these rows are filtered and moved to their sorted positions, instead of reordering all rows.</summary>
+					static const vint									MaxIncrementalReorderingRows=64;
+
 					/// <summary>Create a data provider from a <see cref="IStructuredDataProvider"/>.</summary>
 					/// <param name="provider">The structured data provider.</param>
 					StructuredDataProvider(Ptr<IStructuredDataProvider> provider);
@@ -177,6 +279,12 @@ Structured DataSource Extensions
 					/// <summary>Set the additional filter. This filter will be composed with inherent filters of all column to be the final filter.</summary>
 					/// <param name="value">The additional filter.</param>
 					void												SetAdditionalFilter(Ptr<IStructuredDataFilter> value);
+					/// <summary>Test if filtering and sorting run on the thread pool.</summary>
+					/// <returns>Returns true if filtering and sorting run on the thread pool.</returns>
+					bool												GetParallelReordering();
+					/// <summary>Set if filtering and sorting run on the thread pool for large number of rows. Only enable it when all filters, sorters and the <see cref="IStructuredDataProvider"/> can be called from multiple threads, while the UI thread waits for the result.</summary>
+					/// <param name="value">Set to true to run filtering and sorting on the thread pool.</param>
+					void												SetParallelReordering(bool value);
 
 					void												SetCommandExecutor(IDataProviderCommandExecutor* value)override;
 					vint												GetColumnCount()override;
@@ -343,9 +451,16 @@ Strong Typed DataSource Extensions
 						}
 					};
 
-					class SorterBase : public Object, public virtual IStructuredDataSorter
+					class SorterBase : public Object, public virtual IStructuredDataSorter, public virtual IStructuredDataKeySorter
 					{
 					protected:
+						struct SortKey
+						{
+							vint											row;
+							TRow											rowData;
+							TColumn											cellData;
+						};
+
 						StrongTypedColumnProviderBase<TRow, TColumn>*		ownerColumn;
 						StrongTypedDataProvider<TRow>*						dataProvider;
 
@@ -367,6 +482,36 @@ Strong Typed DataSource Extensions
 							ownerColumn->GetCellData(rowData2, cellData2);
 							return CompareData(rowData1, cellData1, rowData2, cellData2);
 						}
+
+						void SortRows(collections::List<vint>& rows, bool ascending, vint taskCount)override
+						{
+							vint count=rows.Count();
+							if(count<2) return;
+							collections::Array<SortKey> keys(count);
+							StructuredDataParallelTasks::Run(taskCount, [&](vint task)
+							{
+								vint end=count*(task+1)/taskCount;
+								for(vint i=count*task/taskCount;i<end;i++)
+								{
+									SortKey& key=keys[i];
+									key.row=rows[i];
+									dataProvider->GetRowData(key.row, key.rowData);
+									ownerColumn->GetCellData(key.rowData, key.cellData);
+								}
+							});
+
+							StructuredDataParallelTasks::Sort(&keys[0], count, taskCount, [this, ascending](const SortKey& key1, const SortKey& key2)
+							{
+								vint result=CompareData(key1.rowData, key1.cellData, key2.rowData, key2.cellData);
+								if(!ascending) result=-result;
+								return result!=0?result:key1.row-key2.row;
+							});
+
+							for(vint i=0;i<count;i++)
+							{
+								rows[i]=keys[i].row;
+							}
+						}
 					};
 
 					class Sorter : public SorterBase
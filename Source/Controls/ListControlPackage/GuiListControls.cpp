@@ -262,17 +262,15 @@ GuiListControl
 
 #define ATTACH_ITEM_MOUSE_EVENT(EVENTNAME, ITEMEVENTNAME)\
 					{\
-						Func<void(GuiItemMouseEvent&, IItemStyleController*, GuiGraphicsComposition*, GuiMouseEventArgs&)> func(this, &GuiListControl::OnItemMouseEvent);\
-						helper->EVENTNAME##Handler=style->GetBoundsComposition()->GetEventReceiver()->EVENTNAME.AttachFunction(\
-							Curry(Curry(func)(ITEMEVENTNAME))(style)\
+						helper->EVENTNAME##Handler=style->GetBoundsComposition()->GetEventReceiver()->EVENTNAME.AttachLambda(\
+							[this, style](GuiGraphicsComposition* sender, GuiMouseEventArgs& arguments){OnItemMouseEvent(ITEMEVENTNAME, style, sender, arguments);}\
 							);\
 					}\
 
 #define ATTACH_ITEM_NOTIFY_EVENT(EVENTNAME, ITEMEVENTNAME)\
 					{\
-						Func<void(GuiItemNotifyEvent&, IItemStyleController*, GuiGraphicsComposition*, GuiEventArgs&)> func(this, &GuiListControl::OnItemNotifyEvent);\
-						helper->EVENTNAME##Handler=style->GetBoundsComposition()->GetEventReceiver()->EVENTNAME.AttachFunction(\
-							Curry(Curry(func)(ITEMEVENTNAME))(style)\
+						helper->EVENTNAME##Handler=style->GetBoundsComposition()->GetEventReceiver()->EVENTNAME.AttachLambda(\
+							[this, style](GuiGraphicsComposition* sender, GuiEventArgs& arguments){OnItemNotifyEvent(ITEMEVENTNAME, style, sender, arguments);}\
 							);\
 					}\
 
@@ -1725,6 +1723,357 @@ FixedHeightMultiColumnItemArranger
 					return expectedSize;
 				}
 
+/***********************************************************************
+VariableHeightItemArranger
+***********************************************************************/
+
+				void VariableHeightItemArranger::ResetItemHeights(vint count)
+				{
+					itemHeights.Resize(count);
+					for(vint i=0;i<count;i++)
+					{
+						itemHeights[i]=-1;
+					}
+				}
+
+				void VariableHeightItemArranger::BuildItemHeightTrees()
+				{
+					vint count=itemHeights.Count();
+					measuredHeightTree.Resize(count+1);
+					measuredCountTree.Resize(count+1);
+					for(vint i=0;i<=count;i++)
+					{
+						measuredHeightTree[i]=0;
+						measuredCountTree[i]=0;
+					}
+
+					measuredHeight=0;
+					measuredCount=0;
+					for(vint i=1;i<=count;i++)
+					{
+						vint height=itemHeights[i-1];
+						if(height!=-1)
+						{
+							measuredHeightTree[i]+=height;
+							measuredCountTree[i]++;
+							measuredHeight+=height;
+							measuredCount++;
+						}
+
+						vint parent=i+(i&-i);
+						if(parent<=count)
+						{
+							measuredHeightTree[parent]+=measuredHeightTree[i];
+							measuredCountTree[parent]+=measuredCountTree[i];
+						}
+					}
+					if(measuredCount>0)
+					{
+						estimatedHeight=measuredHeight/measuredCount;
+						if(estimatedHeight<1) estimatedHeight=1;
+					}
+				}
+
+				void VariableHeightItemArranger::SetItemHeight(vint itemIndex, vint height)
+				{
+					if(height<0) height=0;
+					vint oldHeight=itemHeights[itemIndex];
+					if(oldHeight==height) return;
+
+					vint deltaHeight=height-(oldHeight==-1?0:oldHeight);
+					vint deltaCount=oldHeight==-1?1:0;
+					itemHeights[itemIndex]=height;
+					for(vint i=itemIndex+1;i<measuredHeightTree.Count();i+=(i&-i))
+					{
+						measuredHeightTree[i]+=deltaHeight;
+						measuredCountTree[i]+=deltaCount;
+					}
+
+					measuredHeight+=deltaHeight;
+					measuredCount+=deltaCount;
+					estimatedHeight=measuredHeight/measuredCount;
+					if(estimatedHeight<1) estimatedHeight=1;
+				}
+
+				vint VariableHeightItemArranger::GetItemHeight(vint itemIndex)
+				{
+					vint height=itemHeights[itemIndex];
+					return height==-1?estimatedHeight:height;
+				}
+
+				vint VariableHeightItemArranger::GetItemTop(vint itemIndex)
+				{
+					vint height=0;
+					vint count=0;
+					for(vint i=itemIndex;i>0;i-=(i&-i))
+					{
+						height+=measuredHeightTree[i];
+						count+=measuredCountTree[i];
+					}
+					return height+(itemIndex-count)*estimatedHeight;
+				}
+
+				vint VariableHeightItemArranger::GetTotalHeight()
+				{
+					return measuredHeight+(itemHeights.Count()-measuredCount)*estimatedHeight;
+				}
+
+				vint VariableHeightItemArranger::GetItemIndexFromPosition(vint y)
+				{
+					vint count=itemHeights.Count();
+					if(count==0 || y<0) return 0;
+
+					vint step=1;
+					while(step*2<=count) step*=2;
+
+					// each node in the tree covers exactly "step" items when it is visited
+					vint index=0;
+					for(;step>0;step/=2)
+					{
+						vint next=index+step;
+						if(next<=count)
+						{
+							vint height=measuredHeightTree[next]+(step-measuredCountTree[next])*estimatedHeight;
+							if(height<=y)
+							{
+								index=next;
+								y-=height;
+							}
+						}
+					}
+					return index<count?index:count-1;
+				}
+
+				void VariableHeightItemArranger::RearrangeItemBounds()
+				{
+					vint top=GetItemTop(startIndex)-viewBounds.Top();
+					for(vint i=0;i<visibleStyles.Count();i++)
+					{
+						GuiListControl::IItemStyleController* style=visibleStyles[i];
+						vint height=GetItemHeight(startIndex+i);
+						callback->SetStyleAlignmentToParent(style, Margin(0, -1, 0, -1));
+						callback->SetStyleBounds(style, Rect(Point(0, top), Size(0, height)));
+						top+=height;
+					}
+				}
+
+				void VariableHeightItemArranger::OnStylesCleared()
+				{
+					ResetItemHeights(itemHeights.Count());
+					estimatedHeight=1;
+					BuildItemHeightTrees();
+					InvalidateAdoptedSize();
+				}
+
+				Size VariableHeightItemArranger::OnCalculateTotalSize()
+				{
+					if(callback)
+					{
+						return Size(0, GetTotalHeight());
+					}
+					else
+					{
+						return Size(0, 0);
+					}
+				}
+
+				void VariableHeightItemArranger::OnViewChangedInternal(Rect oldBounds, Rect newBounds)
+				{
+					if(callback)
+					{
+						if(!suppressOnViewChanged)
+						{
+							vint oldVisibleCount=visibleStyles.Count();
+							vint oldTotalHeight=GetTotalHeight();
+							vint itemCount=itemHeights.Count();
+							vint newStartIndex=GetItemIndexFromPosition(newBounds.Top());
+							vint offset=newBounds.Top()-GetItemTop(newStartIndex);
+
+							// items are placed from the top of the first visible item, measuring an item only moves items after it
+							vint endIndex=startIndex+oldVisibleCount-1;
+							vint newEndIndex=newStartIndex-1;
+							vint y=-offset;
+							for(vint i=newStartIndex;i<itemCount && y<newBounds.Height();i++)
+							{
+								GuiListControl::IItemStyleController* style=0;
+								if(startIndex<=i && i<=endIndex)
+								{
+									style=visibleStyles[i-startIndex];
+								}
+								else
+								{
+									style=callback->RequestItem(i);
+									callback->SetStyleAlignmentToParent(style, Margin(0, -1, 0, -1));
+								}
+								visibleStyles.Add(style);
+								SetItemHeight(i, callback->GetStylePreferredSize(style).y);
+								y+=GetItemHeight(i);
+								newEndIndex=i;
+							}
+
+							for(vint i=0;i<oldVisibleCount;i++)
+							{
+								vint index=startIndex+i;
+								if(index<newStartIndex || newEndIndex<index)
+								{
+									GuiListControl::IItemStyleController* style=visibleStyles[i];
+									callback->ReleaseItem(style);
+								}
+							}
+							visibleStyles.RemoveRange(0, oldVisibleCount);
+							startIndex=newStartIndex;
+
+							// keep the first visible item at the same place when measuring items changes the estimated height
+							vint newTop=GetItemTop(newStartIndex)+offset;
+							if(oldTotalHeight!=GetTotalHeight() || newTop!=newBounds.Top())
+							{
+								suppressOnViewChanged=true;
+								callback->OnTotalSizeChanged();
+								callback->SetViewLocation(Point(newBounds.Left(), newTop));
+								suppressOnViewChanged=false;
+								InvalidateAdoptedSize();
+							}
+							RearrangeItemBounds();
+						}
+					}
+				}
+
+				VariableHeightItemArranger::VariableHeightItemArranger()
+					:measuredHeight(0)
+					,measuredCount(0)
+					,estimatedHeight(1)
+					,suppressOnViewChanged(false)
+				{
+					BuildItemHeightTrees();
+				}
+
+				VariableHeightItemArranger::~VariableHeightItemArranger()
+				{
+				}
+
+				void VariableHeightItemArranger::OnItemModified(vint start, vint count, vint newCount)
+				{
+					Array<vint> oldHeights;
+					CopyFrom(oldHeights, itemHeights);
+					vint itemCount=itemProvider->Count();
+					ResetItemHeights(itemCount);
+					for(vint i=0;i<itemCount;i++)
+					{
+						vint oldIndex=-1;
+						if(i<start)
+						{
+							oldIndex=i;
+						}
+						else if(i>=start+newCount)
+						{
+							oldIndex=i-newCount+count;
+						}
+						if(0<=oldIndex && oldIndex<oldHeights.Count())
+						{
+							itemHeights[i]=oldHeights[oldIndex];
+						}
+					}
+					BuildItemHeightTrees();
+					RangedItemArrangerBase::OnItemModified(start, count, newCount);
+				}
+
+				vint VariableHeightItemArranger::FindItem(vint itemIndex, compositions::KeyDirection key)
+				{
+					vint count=itemProvider->Count();
+					if(count==0) return -1;
+					if(itemIndex<0) itemIndex=0;
+					if(itemIndex>=count) itemIndex=count-1;
+					switch(key)
+					{
+					case KeyDirection::Up:
+						itemIndex--;
+						break;
+					case KeyDirection::Down:
+						itemIndex++;
+						break;
+					case KeyDirection::Home:
+						itemIndex=0;
+						break;
+					case KeyDirection::End:
+						itemIndex=count;
+						break;
+					case KeyDirection::PageUp:
+						{
+							vint newIndex=GetItemIndexFromPosition(GetItemTop(itemIndex)-viewBounds.Height());
+							itemIndex=newIndex<itemIndex?newIndex:itemIndex-1;
+						}
+						break;
+					case KeyDirection::PageDown:
+						{
+							vint newIndex=GetItemIndexFromPosition(GetItemTop(itemIndex)+viewBounds.Height());
+							itemIndex=newIndex>itemIndex?newIndex:itemIndex+1;
+						}
+						break;
+					default:
+						return -1;
+					}
+					
+					if(itemIndex<0) return 0;
+					else if(itemIndex>=count) return count-1;
+					else return itemIndex;
+				}
+
+				bool VariableHeightItemArranger::EnsureItemVisible(vint itemIndex)
+				{
+					if(callback)
+					{
+						if(itemIndex<0 || itemIndex>=itemProvider->Count())
+						{
+							return false;
+						}
+						while(true)
+						{
+							vint top=GetItemTop(itemIndex);
+							vint bottom=top+GetItemHeight(itemIndex);
+
+							if(viewBounds.Height()<bottom-top)
+							{
+								if(viewBounds.Top()<bottom && top<viewBounds.Bottom())
+								{
+									break;
+								}
+							}
+
+							Point location=viewBounds.LeftTop();
+							if(top<viewBounds.Top())
+							{
+								location.y=top;
+							}
+							else if(viewBounds.Bottom()<bottom)
+							{
+								location.y=bottom-viewBounds.Height();
+							}
+							else
+							{
+								break;
+							}
+
+							if(location==viewBounds.LeftTop())
+							{
+								break;
+							}
+							callback->SetViewLocation(location);
+						}
+						return true;
+					}
+					return false;
+				}
+
+				Size VariableHeightItemArranger::GetAdoptedSize(Size expectedSize)
+				{
+					if (itemProvider)
+					{
+						vint totalHeight = GetTotalHeight();
+						return Size(expectedSize.x, totalHeight < expectedSize.y ? totalHeight : expectedSize.y);
+					}
+					return expectedSize;
+				}
+
 /***********************************************************************
 ItemStyleControllerBase
 ***********************************************************************/
@@ -325,7 +325,7 @@ List Control
 				};
 				
 				friend class collections::ArrayBase<Ptr<VisibleStyleHelper>>;
-				collections::Dictionary<IItemStyleController*, Ptr<VisibleStyleHelper>>		visibleStyles;
+				collections::HashDictionary<IItemStyleController*, Ptr<VisibleStyleHelper>>	visibleStyles;
 
 				void											OnItemMouseEvent(compositions::GuiItemMouseEvent& itemEvent, IItemStyleController* style, compositions::GuiGraphicsComposition* sender, compositions::GuiMouseEventArgs& arguments);
 				void											OnItemNotifyEvent(compositions::GuiItemNotifyEvent& itemEvent, IItemStyleController* style, compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
@@ -605,6 +605,41 @@ Predefined ItemArranger
 					bool										EnsureItemVisible(vint itemIndex)override;
 					Size										GetAdoptedSize(Size expectedSize)override;
 				};
+
+				/// <summary>Variable height item arranger. This arranger lists all items using their own minimum heights. Only displayed items are measured, other items use the average height of all measured items, so that a large list is still virtualized.</summary>
+				class VariableHeightItemArranger : public RangedItemArrangerBase, public Description<VariableHeightItemArranger>
+				{
+				protected:
+					collections::Array<vint>					itemHeights;			// measured heights, -1 for unmeasured items
+					collections::Array<vint>					measuredHeightTree;		// binary indexed tree of measured heights
+					collections::Array<vint>					measuredCountTree;		// binary indexed tree of the number of measured items
+					vint										measuredHeight;
+					vint										measuredCount;
+					vint										estimatedHeight;
+					bool										suppressOnViewChanged;
+
+					void										ResetItemHeights(vint count);
+					void										BuildItemHeightTrees();
+					void										SetItemHeight(vint itemIndex, vint height);
+					vint										GetItemHeight(vint itemIndex);
+					vint										GetItemTop(vint itemIndex);
+					vint										GetTotalHeight();
+					vint										GetItemIndexFromPosition(vint y);
+
+					virtual void								RearrangeItemBounds();
+					void										OnStylesCleared()override;
+					Size										OnCalculateTotalSize()override;
+					void										OnViewChangedInternal(Rect oldBounds, Rect newBounds)override;
+				public:
+					/// <summary>Create the arranger.</summary>
+					VariableHeightItemArranger();
+					~VariableHeightItemArranger();
+
+					void										OnItemModified(vint start, vint count, vint newCount)override;
+					vint										FindItem(vint itemIndex, compositions::KeyDirection key)override;
+					bool										EnsureItemVisible(vint itemIndex)override;
+					Size										GetAdoptedSize(Size expectedSize)override;
+				};
 			}
 
 /***********************************************************************
@@ -27,6 +27,21 @@ NodeItemProvider
 					if(provider->GetExpanding() && offset>0)
 					{
 						offset-=1;
+						if(auto locator=dynamic_cast<INodeVisibleOffsetLocator*>(provider))
+						{
+							if(offset<provider->CalculateTotalVisibleNodes()-1)
+							{
+								vint index=locator->FindChildByVisibleOffset(offset);
+								INodeProvider* child=provider->GetChild(index);
+								if(child)
+								{
+									result=GetNodeByOffset(child, offset);
+								}
+							}
+							ReleaseNode(provider);
+							return result;
+						}
+
 						vint count=provider->GetChildCount();
 						for(vint i=0;(!result && i<count);i++)
 						{
@@ -136,11 +151,18 @@ NodeItemProvider
 					{
 						vint visibility=0;
 						vint count=node->GetChildCount();
-						for(vint i=0;i<count;i++)
+						if(auto locator=dynamic_cast<INodeVisibleOffsetLocator*>(node))
 						{
-							INodeProvider* child=node->GetChild(i);
-							visibility+=child->CalculateTotalVisibleNodes();
-							child->Release();
+							visibility=locator->CalculateVisibleNodesBeforeChild(count);
+						}
+						else
+						{
+							for(vint i=0;i<count;i++)
+							{
+								INodeProvider* child=node->GetChild(i);
+								visibility+=child->CalculateTotalVisibleNodes();
+								child->Release();
+							}
 						}
 						InvokeOnItemModified(base+1, visibility, 0);
 					}
@@ -164,6 +186,18 @@ NodeItemProvider
 						return -2;
 					}
 
+					auto locator=dynamic_cast<INodeVisibleOffsetLocator*>(node);
+					auto parentLocator=dynamic_cast<INodeVisibleOffsetLocator*>(parent);
+					if(locator && parentLocator)
+					{
+						vint childIndex=locator->GetIndexInParent();
+						if(childIndex==-1)
+						{
+							return -1;
+						}
+						return index+1+parentLocator->CalculateVisibleNodesBeforeChild(childIndex);
+					}
+
 					vint count=parent->GetChildCount();
 					for(vint i=0;i<count;i++)
 					{
@@ -395,6 +429,57 @@ NodeItemProvider
 					}
 				}
 
+/***********************************************************************
+NodeVisibleCountTree
+***********************************************************************/
+
+				NodeVisibleCountTree::NodeVisibleCountTree()
+					:totalVisibleNodes(0)
+				{
+				}
+
+				void NodeVisibleCountTree::Add(vint index, vint offset)
+				{
+					for(vint i=index+1;i<tree.Count();i+=(i&-i))
+					{
+						tree[i]+=offset;
+					}
+					totalVisibleNodes+=offset;
+				}
+
+				vint NodeVisibleCountTree::GetVisibleNodesBefore(vint index)
+				{
+					vint result=0;
+					for(vint i=index;i>0;i-=(i&-i))
+					{
+						result+=tree[i];
+					}
+					return result;
+				}
+
+				vint NodeVisibleCountTree::GetTotalVisibleNodes()
+				{
+					return totalVisibleNodes;
+				}
+
+				vint NodeVisibleCountTree::FindByVisibleOffset(vint& offset)
+				{
+					vint count=tree.Count()-1;
+					vint step=1;
+					while(step*2<=count) step*=2;
+
+					vint index=0;
+					for(;step>0;step/=2)
+					{
+						if(index+step<=count && tree[index+step]<=offset)
+						{
+							index+=step;
+							offset-=tree[index];
+						}
+					}
+					return index;
+				}
+
 /***********************************************************************
 MemoryNodeProvider::NodeCollection
 ***********************************************************************/
@@ -419,6 +504,7 @@ MemoryNodeProvider::NodeCollection
 				void MemoryNodeProvider::NodeCollection::OnAfterChildModified(vint start, vint count, vint newCount)
 				{
 					ownerProvider->childCount+=(newCount-count);
+					ownerProvider->childVisibleNodesModified=true;
 					if(ownerProvider->expanding)
 					{
 						vint offset=0;
@@ -426,7 +512,7 @@ MemoryNodeProvider::NodeCollection
 						{
 							offset+=items[start+i]->totalVisibleNodeCount;
 						}
-						ownerProvider->OnChildTotalVisibleNodesChanged(offset-ownerProvider->offsetBeforeChildModified);
+						ownerProvider->OnTotalVisibleNodesChanged(offset-ownerProvider->offsetBeforeChildModified);
 					}
 					INodeProviderCallback* proxy=ownerProvider->GetCallbackProxyInternal();
 					if(proxy)
@@ -488,12 +574,38 @@ MemoryNodeProvider
 					}
 				}
 
-				void MemoryNodeProvider::OnChildTotalVisibleNodesChanged(vint offset)
+				void MemoryNodeProvider::EnsureChildVisibleNodes()
+				{
+					if(childVisibleNodesModified)
+					{
+						childVisibleNodesModified=false;
+						for(vint i=0;i<childCount;i++)
+						{
+							children[i]->indexInParent=i;
+						}
+						childVisibleNodes.Rebuild(childCount, [this](vint index){return children[index]->totalVisibleNodeCount;});
+					}
+				}
+
+				void MemoryNodeProvider::OnTotalVisibleNodesChanged(vint offset)
 				{
 					totalVisibleNodeCount+=offset;
 					if(parent)
 					{
-						parent->OnChildTotalVisibleNodesChanged(offset);
+						parent->OnChildTotalVisibleNodesChanged(this, offset);
+					}
+				}
+
+				void MemoryNodeProvider::OnChildTotalVisibleNodesChanged(MemoryNodeProvider* child, vint offset)
+				{
+					if(!childVisibleNodesModified)
+					{
+						childVisibleNodes.Add(child->indexInParent, offset);
+					}
+					// a collapsed node always has only one visible node
+					if(expanding)
+					{
+						OnTotalVisibleNodesChanged(offset);
 					}
 				}
 
@@ -503,6 +615,8 @@ MemoryNodeProvider
 					,childCount(0)
 					,totalVisibleNodeCount(1)
 					,offsetBeforeChildModified(0)
+					,indexInParent(-1)
+					,childVisibleNodesModified(true)
 				{
 					children.ownerProvider=this;
 				}
@@ -513,6 +627,8 @@ MemoryNodeProvider
 					,childCount(0)
 					,totalVisibleNodeCount(1)
 					,offsetBeforeChildModified(0)
+					,indexInParent(-1)
+					,childVisibleNodesModified(true)
 					,data(_data)
 				{
 					children.ownerProvider=this;
@@ -562,13 +678,9 @@ MemoryNodeProvider
 					if(expanding!=value)
 					{
 						expanding=value;
-						vint offset=0;
-						for(vint i=0;i<childCount;i++)
-						{
-							offset+=children[i]->totalVisibleNodeCount;
-						}
-
-						OnChildTotalVisibleNodesChanged(expanding?offset:-offset);
+						EnsureChildVisibleNodes();
+						vint offset=childVisibleNodes.GetTotalVisibleNodes();
+						OnTotalVisibleNodesChanged(expanding?offset:-offset);
 						INodeProviderCallback* proxy=GetCallbackProxyInternal();
 						if(proxy)
 						{
@@ -619,6 +731,28 @@ MemoryNodeProvider
 				{
 				}
 
+				vint MemoryNodeProvider::GetIndexInParent()
+				{
+					if(parent)
+					{
+						parent->EnsureChildVisibleNodes();
+						return indexInParent;
+					}
+					return -1;
+				}
+
+				vint MemoryNodeProvider::CalculateVisibleNodesBeforeChild(vint index)
+				{
+					EnsureChildVisibleNodes();
+					return childVisibleNodes.GetVisibleNodesBefore(index);
+				}
+
+				vint MemoryNodeProvider::FindChildByVisibleOffset(vint& offset)
+				{
+					EnsureChildVisibleNodes();
+					return childVisibleNodes.FindByVisibleOffset(offset);
+				}
+
 /***********************************************************************
 NodeRootProviderBase
 ***********************************************************************/
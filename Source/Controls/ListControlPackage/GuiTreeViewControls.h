@@ -91,6 +91,23 @@ GuiVirtualTreeListControl NodeProvider
 					/// <summary>Decrease the reference counter. If the counter is zero, the node will be deleted. Use [M:vl.presentation.controls.tree.INodeProvider.Increase] to increase the reference counter.</summary>
 					virtual void					Release()=0;
 				};
+
+				/// <summary>Optionally implemented by an <see cref="INodeProvider"/> that keeps the number of visible nodes before each child. <see cref="NodeItemProvider"/> uses it to convert between nodes and visible indices without visiting all siblings.</summary>
+				class INodeVisibleOffsetLocator : public virtual Interface
+				{
+				public:
+					/// <summary>Get the index of this node in its parent.</summary>
+					/// <returns>The index of this node in its parent.</returns>
+					virtual vint					GetIndexInParent()=0;
+					/// <summary>Calculate the number of total visible nodes of all sub nodes before a specified sub node.</summary>
+					/// <returns>The number of total visible nodes.</returns>
+					/// <param name="index">The index of the sub node.</param>
+					virtual vint					CalculateVisibleNodesBeforeChild(vint index)=0;
+					/// <summary>Find the sub node that contains a visible node.</summary>
+					/// <returns>The index of the sub node.</returns>
+					/// <param name="offset">The offset of the visible node in all total visible nodes of all sub nodes. It becomes the offset in the found sub node.</param>
+					virtual vint					FindChildByVisibleOffset(vint& offset)=0;
+				};
 				
 				/// <summary>Represents a root node provider.</summary>
 				class INodeRootProvider : public virtual IDescriptable, public Description<INodeRootProvider>
@@ -303,6 +320,57 @@ GuiVirtualTreeListControl Predefined NodeProvider
 
 			namespace tree
 			{
+				/// <summary>A binary indexed tree that stores the number of total visible nodes of each sub node. It is used to implement <see cref="INodeVisibleOffsetLocator"/>.</summary>
+				class NodeVisibleCountTree
+				{
+				protected:
+					collections::Array<vint>		tree;
+					vint							totalVisibleNodes;
+
+				public:
+					NodeVisibleCountTree();
+
+					/// <summary>Rebuild the tree.</summary>
+					/// <typeparam name="F">Type of the function to get the number of total visible nodes of a sub node.</typeparam>
+					/// <param name="count">The number of sub nodes.</param>
+					/// <param name="getVisibleNodes">The function to get the number of total visible nodes of a sub node.</param>
+					template<typename F>
+					void Rebuild(vint count, const F& getVisibleNodes)
+					{
+						tree.Resize(count+1);
+						tree[0]=0;
+						for(vint i=1;i<=count;i++)
+						{
+							tree[i]=getVisibleNodes(i-1);
+						}
+						for(vint i=1;i<=count;i++)
+						{
+							vint j=i+(i&-i);
+							if(j<=count)
+							{
+								tree[j]+=tree[i];
+							}
+						}
+						totalVisibleNodes=count==0?0:GetVisibleNodesBefore(count);
+					}
+
+					/// <summary>Change the number of total visible nodes of a sub node.</summary>
+					/// <param name="index">The index of the sub node.</param>
+					/// <param name="offset">The difference.</param>
+					void							Add(vint index, vint offset);
+					/// <summary>Get the number of total visible nodes of all sub nodes before a specified sub node.</summary>
+					/// <returns>The number of total visible nodes.</returns>
+					/// <param name="index">The index of the sub node.</param>
+					vint							GetVisibleNodesBefore(vint index);
+					/// <summary>Get the number of total visible nodes of all sub nodes.</summary>
+					/// <returns>The number of total visible nodes.</returns>
+					vint							GetTotalVisibleNodes();
+					/// <summary>Find the sub node that contains a visible node.</summary>
+					/// <returns>The index of the sub node.</returns>
+					/// <param name="offset">The offset of the visible node in all total visible nodes of all sub nodes. It becomes the offset in the found sub node.</param>
+					vint							FindByVisibleOffset(vint& offset);
+				};
+
 				/// <summary>Base type for tree view node data.</summary>
 				class IMemoryNodeData : public virtual IDescriptable, public Description<IMemoryNodeData>
 				{
@@ -312,6 +380,7 @@ GuiVirtualTreeListControl Predefined NodeProvider
 				class MemoryNodeProvider
 					: public Object
 					, public virtual INodeProvider
+					, public virtual INodeVisibleOffsetLocator
 					, public Description<MemoryNodeProvider>
 				{
 					typedef collections::List<Ptr<MemoryNodeProvider>> ChildList;
@@ -343,11 +412,16 @@ GuiVirtualTreeListControl Predefined NodeProvider
 					vint							childCount;
 					vint							totalVisibleNodeCount;
 					vint							offsetBeforeChildModified;
+					vint							indexInParent;
+					bool							childVisibleNodesModified;
+					NodeVisibleCountTree			childVisibleNodes;
 					Ptr<IMemoryNodeData>			data;
 					NodeCollection					children;
 
 					virtual INodeProviderCallback*	GetCallbackProxyInternal();
-					void							OnChildTotalVisibleNodesChanged(vint offset);
+					void							EnsureChildVisibleNodes();
+					void							OnTotalVisibleNodesChanged(vint offset);
+					void							OnChildTotalVisibleNodesChanged(MemoryNodeProvider* child, vint offset);
 				public:
 					/// <summary>Create a node provider.</summary>
 					MemoryNodeProvider();
@@ -377,6 +451,10 @@ GuiVirtualTreeListControl Predefined NodeProvider
 					INodeProvider*					GetChild(vint index)override;
 					void							Increase()override;
 					void							Release()override;
+
+					vint							GetIndexInParent()override;
+					vint							CalculateVisibleNodesBeforeChild(vint index)override;
+					vint							FindChildByVisibleOffset(vint& offset)override;
 				};
 
 				/// <summary>A general implementation for <see cref="INodeRootProvider"/>.</summary>
@@ -13,60 +13,169 @@ namespace vl
 GuiTextBoxColorizerBase
 ***********************************************************************/
 
+			void GuiTextBoxColorizerBase::NotifyColorizedLines(GuiColorizedTextElement* element)
+			{
+				if(element)
+				{
+					Ptr<GuiColorizedTextElement> colorizedElement=element;
+					GetCurrentController()->AsyncService()->InvokeInMainThread([=]()
+					{
+						colorizedElement->InvokeOnCompositionStateChanged();
+					});
+				}
+			}
+
 			void GuiTextBoxColorizerBase::ColorizerThreadProc(void* argument)
 			{
 				GuiTextBoxColorizerBase* colorizer=(GuiTextBoxColorizerBase*)argument;
+
+				// buffers are reused by all batches, each line in the batch is copied with CRLF at the end
+				collections::Array<wchar_t> text;
+				collections::Array<vuint32_t> colors;
+				collections::Array<vint> lineStarts(ColorizeLineBatchSize+1);
+				collections::Array<vint> lexerStates(ColorizeLineBatchSize);
+				collections::Array<vint> contextStates(ColorizeLineBatchSize);
+
 				while(!colorizer->isFinalizing)
 				{
-					vint lineIndex=-1;
-					wchar_t* text=0;
-					vuint32_t* colors=0;
-					vint length=0;
+					vint firstLine=-1;
+					vint lineCount=0;
 					vint lexerState=-1;
 					vint contextState=-1;
 
 					SPIN_LOCK(*colorizer->elementModifyLock)
 					{
-						if(colorizer->colorizedLineCount>=colorizer->element->GetLines().GetCount())
+						TextLines& lines=colorizer->element->GetLines();
+						if(colorizer->colorizedLineCount>=lines.GetCount())
 						{
 							colorizer->isColorizerRunning=false;
+							NotifyColorizedLines(colorizer->element);
 							goto CANCEL_COLORIZING;
 						}
 
-						lineIndex=colorizer->colorizedLineCount++;
-						TextLine& line=colorizer->element->GetLines().GetLine(lineIndex);
-						length=line.dataLength;
-						text=new wchar_t[length+2];
-						colors=new vuint32_t[length+2];
-						memcpy(text, line.text, sizeof(wchar_t)*length);
-						text[length]=L'\r';
-						text[length+1]=L'\n';
-						lexerState=lineIndex==0?colorizer->GetLexerStartState():colorizer->element->GetLines().GetLine(lineIndex-1).lexerFinalState;
-						contextState=lineIndex==0?colorizer->GetContextStartState():colorizer->element->GetLines().GetLine(lineIndex-1).contextFinalState;
+						firstLine=colorizer->colorizedLineCount;
+						lineCount=lines.GetCount()-firstLine;
+						if(lineCount>ColorizeLineBatchSize)
+						{
+							lineCount=ColorizeLineBatchSize;
+						}
+						colorizer->colorizedLineCount=firstLine+lineCount;
+
+						vint length=0;
+						for(vint i=0;i<lineCount;i++)
+						{
+							lineStarts[i]=length;
+							length+=lines.GetLine(firstLine+i).dataLength+2;
+						}
+						lineStarts[lineCount]=length;
+						if(text.Count()<length)
+						{
+							text.Resize(length);
+							colors.Resize(length);
+						}
+
+						for(vint i=0;i<lineCount;i++)
+						{
+							TextLine& line=lines.GetLine(firstLine+i);
+							wchar_t* buffer=&text[lineStarts[i]];
+							memcpy(buffer, line.text, sizeof(wchar_t)*line.dataLength);
+							buffer[line.dataLength]=L'\r';
+							buffer[line.dataLength+1]=L'\n';
+						}
+						lexerState=firstLine==0?colorizer->GetLexerStartState():lines.GetLine(firstLine-1).lexerFinalState;
+						contextState=firstLine==0?colorizer->GetContextStartState():lines.GetLine(firstLine-1).contextFinalState;
 					}
 
-					colorizer->ColorizeLineWithCRLF(lineIndex, text, colors, length+2, lexerState, contextState);
+					for(vint i=0;i<lineCount;i++)
+					{
+						vint start=lineStarts[i];
+						colorizer->ColorizeLineWithCRLF(firstLine+i, &text[start], &colors[start], lineStarts[i+1]-start, lexerState, contextState);
+						lexerStates[i]=lexerState;
+						contextStates[i]=contextState;
+					}
 
 					SPIN_LOCK(*colorizer->elementModifyLock)
 					{
-						if(lineIndex<colorizer->colorizedLineCount && lineIndex<colorizer->element->GetLines().GetCount())
+						TextLines& lines=colorizer->element->GetLines();
+
+						// lines that are modified during colorizing are not before colorizedLineCount anymore, their results are discarded
+						vint availableCount=colorizer->colorizedLineCount<lines.GetCount()?colorizer->colorizedLineCount:lines.GetCount();
+						availableCount-=firstLine;
+						if(availableCount>lineCount)
 						{
-							TextLine& line=colorizer->element->GetLines().GetLine(lineIndex);
-							line.lexerFinalState=lexerState;
-							line.contextFinalState=contextState;
-							for(vint i=0;i<length;i++)
+							availableCount=lineCount;
+						}
+
+						vint writtenCount=0;
+						bool converged=false;
+						while(writtenCount<availableCount && !converged)
+						{
+							TextLine& line=lines.GetLine(firstLine+writtenCount);
+							converged
+								=line.lexerFinalState!=-1
+								&& line.lexerFinalState==lexerStates[writtenCount]
+								&& line.contextFinalState==contextStates[writtenCount];
+							line.lexerFinalState=lexerStates[writtenCount];
+							line.contextFinalState=contextStates[writtenCount];
+
+							vuint32_t* lineColors=&colors[lineStarts[writtenCount]];
+							for(vint i=0;i<line.dataLength;i++)
+							{
+								line.att[i].colorIndex=lineColors[i];
+							}
+							writtenCount++;
+						}
+
+						if(writtenCount>0)
+						{
+							vint nextLine=firstLine+writtenCount;
+							if(converged)
+							{
+								// following lines are colorized from the same state as before, so skip them until a modified line
+								while(nextLine<lines.GetCount() && lines.GetLine(nextLine).lexerFinalState!=-1)
+								{
+									nextLine++;
+								}
+								colorizer->colorizedLineCount=nextLine;
+							}
+							else if(nextLine<lines.GetCount())
+							{
+								// the next line was colorized from a different state, it cannot be used to stop colorizing
+								TextLine& line=lines.GetLine(nextLine);
+								line.lexerFinalState=-1;
+								line.contextFinalState=-1;
+							}
+
+							if(firstLine/NotifyLineInterval!=nextLine/NotifyLineInterval)
 							{
-								line.att[i].colorIndex=colors[i];
+								NotifyColorizedLines(colorizer->element);
 							}
 						}
-						delete[] text;
-						delete[] colors;
 					}
 				}
 			CANCEL_COLORIZING:
 				colorizer->colorizerRunningEvent.Leave();
 			}
 
+			void GuiTextBoxColorizerBase::InvalidateLines(vint start, vint end)
+			{
+				TextLines& lines=element->GetLines();
+				if(end>=lines.GetCount())
+				{
+					end=lines.GetCount()-1;
+				}
+				for(vint i=start;i<=end;i++)
+				{
+					TextLine& line=lines.GetLine(i);
+					line.lexerFinalState=-1;
+					line.contextFinalState=-1;
+				}
+				if(colorizedLineCount>start)
+				{
+					colorizedLineCount=start;
+				}
+			}
+
 			void GuiTextBoxColorizerBase::StartColorizer()
 			{
 				if(!isColorizerRunning)
@@ -116,6 +225,7 @@ GuiTextBoxColorizerBase
 					{
 						element=_element;
 						elementModifyLock=&_elementModifyLock;
+						InvalidateLines(0, element->GetLines().GetCount()-1);
 						StartColorizer();
 					}
 				}
@@ -144,14 +254,7 @@ GuiTextBoxColorizerBase
 				{
 					SPIN_LOCK(*elementModifyLock)
 					{
-						vint line
-							=arguments.originalStart.row<arguments.originalEnd.row
-							?arguments.originalStart.row
-							:arguments.originalEnd.row;
-						if(colorizedLineCount>line)
-						{
-							colorizedLineCount=line;
-						}
+						InvalidateLines(arguments.inputStart.row, arguments.inputEnd.row);
 						StartColorizer();
 					}
 				}
@@ -171,7 +274,7 @@ GuiTextBoxColorizerBase
 				{
 					SPIN_LOCK(*elementModifyLock)
 					{
-						colorizedLineCount=0;
+						InvalidateLines(0, element->GetLines().GetCount()-1);
 						StartColorizer();
 					}
 				}
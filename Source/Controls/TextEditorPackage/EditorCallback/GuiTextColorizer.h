@@ -27,6 +27,8 @@ GuiTextBoxColorizerBase
 			{
 			public:
 				typedef collections::Array<elements::text::ColorEntry>			ColorArray;
+				static const vint							NotifyLineInterval=256;
+				static const vint							ColorizeLineBatchSize=64;
 			protected:
 				elements::GuiColorizedTextElement*			element;
 				SpinLock*									elementModifyLock;
@@ -35,8 +37,10 @@ GuiTextBoxColorizerBase
 				volatile bool								isFinalizing;
 				SpinLock									colorizerRunningEvent;
 
+				static void									NotifyColorizedLines(elements::GuiColorizedTextElement* element);
 				static void									ColorizerThreadProc(void* argument);
 
+				void										InvalidateLines(vint start, vint end);
 				void										StartColorizer();
 				void										StopColorizer(bool forever);
 				void										StopColorizerForever();
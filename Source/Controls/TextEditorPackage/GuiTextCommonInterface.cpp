@@ -178,6 +178,7 @@ GuiTextBoxCommonInterface
 					{
 						end=textElement->GetLines().Modify(start, end, inputText);
 					}
+					textElement->InvokeOnCompositionStateChanged();
 					callback->AfterModify(originalStart, originalEnd, originalText, start, end, inputText);
 					
 					editVersion++;
@@ -46,5 +46,6 @@ using namespace vl::presentation::templates;
 extern int SetupWindowsGDIRenderer();
 extern int SetupWindowsDirect2DRenderer();
 extern int SetupOSXCoreGraphicsRenderer();
+extern int SetupHeadlessSoftwareRenderer();
 
 #endif
\ No newline at end of file
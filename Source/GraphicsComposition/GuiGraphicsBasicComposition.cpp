@@ -133,12 +133,16 @@ GuiBoundsComposition
 
 			void GuiBoundsComposition::SetBounds(Rect value)
 			{
-				compositionBounds=value;
+				if(compositionBounds!=value)
+				{
+					compositionBounds=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			void GuiBoundsComposition::ClearAlignmentToParent()
 			{
-				alignmentToParent=Margin(-1, -1, -1, -1);
+				SetAlignmentToParent(Margin(-1, -1, -1, -1));
 			}
 
 			Margin GuiBoundsComposition::GetAlignmentToParent()
@@ -148,7 +152,11 @@ GuiBoundsComposition
 
 			void GuiBoundsComposition::SetAlignmentToParent(Margin value)
 			{
-				alignmentToParent=value;
+				if(alignmentToParent!=value)
+				{
+					alignmentToParent=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			bool GuiBoundsComposition::IsAlignedToParent()
@@ -75,6 +75,7 @@ GuiSharedSizeItemComposition
 				{
 					group = value;
 					Update();
+					InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -89,6 +90,7 @@ GuiSharedSizeItemComposition
 				{
 					sharedWidth = value;
 					Update();
+					InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -103,6 +105,7 @@ GuiSharedSizeItemComposition
 				{
 					sharedHeight = value;
 					Update();
+					InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -88,12 +88,17 @@ GuiGraphicsComposition
 				,associatedHost(0)
 				,associatedCursor(0)
 				,associatedHitTestResult(INativeWindowListener::NoDecision)
+				,minPreferredClientSizeCached(false)
 			{
 				sharedPtrDestructorProc = &GuiGraphicsComposition::SharedPtrDestructorProc;
 			}
 
 			GuiGraphicsComposition::~GuiGraphicsComposition()
 			{
+				if(ownedElement && ownedElement->GetOwnerComposition()==this)
+				{
+					ownedElement->SetOwnerComposition(0);
+				}
 				for(vint i=0;i<children.Count();i++)
 				{
 					delete children[i];
@@ -124,6 +129,7 @@ GuiGraphicsComposition
 				child->SetRenderTarget(renderTarget);
 				OnChildInserted(child);
 				child->OnParentChanged(0, child->parent);
+				InvokeOnCompositionStateChanged();
 				return true;
 			}
 
@@ -142,6 +148,7 @@ GuiGraphicsComposition
 					host->DisconnectComposition(child);
 				}
 				children.RemoveAt(index);
+				InvokeOnCompositionStateChanged();
 				return true;
 			}
 
@@ -152,6 +159,10 @@ GuiGraphicsComposition
 				if(index==-1) return false;
 				children.RemoveAt(index);
 				children.Insert(newIndex, child);
+				if(index!=newIndex)
+				{
+					InvokeOnCompositionStateChanged();
+				}
 				return true;
 			}
 
@@ -162,6 +173,7 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::SetOwnedElement(Ptr<IGuiGraphicsElement> element)
 			{
+				if(ownedElement==element) return;
 				if(ownedElement)
 				{
 					IGuiGraphicsRenderer* renderer=ownedElement->GetRenderer();
@@ -169,6 +181,10 @@ GuiGraphicsComposition
 					{
 						renderer->SetRenderTarget(0);
 					}
+					if(ownedElement->GetOwnerComposition()==this)
+					{
+						ownedElement->SetOwnerComposition(0);
+					}
 				}
 				ownedElement=element;
 				if(ownedElement)
@@ -178,7 +194,9 @@ GuiGraphicsComposition
 					{
 						renderer->SetRenderTarget(renderTarget);
 					}
+					ownedElement->SetOwnerComposition(this);
 				}
+				InvokeOnCompositionStateChanged();
 			}
 
 			bool GuiGraphicsComposition::GetVisible()
@@ -188,7 +206,11 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::SetVisible(bool value)
 			{
-				visible=value;
+				if(visible!=value)
+				{
+					visible=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			GuiGraphicsComposition::MinSizeLimitation GuiGraphicsComposition::GetMinSizeLimitation()
@@ -198,7 +220,11 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::SetMinSizeLimitation(MinSizeLimitation value)
 			{
-				minSizeLimitation=value;
+				if(minSizeLimitation!=value)
+				{
+					minSizeLimitation=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			IGuiGraphicsRenderTarget* GuiGraphicsComposition::GetRenderTarget()
@@ -209,6 +235,7 @@ GuiGraphicsComposition
 			void GuiGraphicsComposition::SetRenderTarget(IGuiGraphicsRenderTarget* value)
 			{
 				renderTarget=value;
+				minPreferredClientSizeCached=false;
 				if(ownedElement)
 				{
 					IGuiGraphicsRenderer* renderer=ownedElement->GetRenderer();
@@ -246,7 +273,12 @@ GuiGraphicsComposition
 							IGuiGraphicsRenderer* renderer=ownedElement->GetRenderer();
 							if(renderer)
 							{
+								Size elementMinSize=renderer->GetMinSize();
 								renderer->Render(bounds);
+								if(renderer->GetMinSize()!=elementMinSize)
+								{
+									InvokeOnCompositionStateChanged();
+								}
 							}
 						}
 						if(children.Count()>0)
@@ -294,15 +326,11 @@ GuiGraphicsComposition
 				Rect relativeBounds=Rect(Point(0, 0), bounds.GetSize());
 				if(relativeBounds.Contains(location))
 				{
-					Rect clientArea=GetClientArea();
-					for(vint i=children.Count()-1;i>=0;i--)
+					if(children.Count()>0)
 					{
-						GuiGraphicsComposition* child=children[i];
-						Rect childBounds=child->GetBounds();
-						vint offsetX=childBounds.x1+(clientArea.x1-bounds.x1);
-						vint offsetY=childBounds.y1+(clientArea.y1-bounds.y1);
-						Point newLocation=location-Size(offsetX, offsetY);
-						GuiGraphicsComposition* childResult=child->FindComposition(newLocation);
+						Rect clientArea=GetClientArea();
+						Point clientLocation=location-Size(clientArea.x1-bounds.x1, clientArea.y1-bounds.y1);
+						GuiGraphicsComposition* childResult=FindCompositionInChildren(clientLocation);
 						if(childResult)
 						{
 							return childResult;
@@ -456,6 +484,55 @@ GuiGraphicsComposition
 				return 0;
 			}
 
+			GuiGraphicsComposition* GuiGraphicsComposition::FindCompositionInChild(GuiGraphicsComposition* child, Point location)
+			{
+				if(!child->visible) return 0;
+				Rect childBounds=child->GetBounds();
+				return child->FindComposition(location-Size(childBounds.x1, childBounds.y1));
+			}
+
+			GuiGraphicsComposition* GuiGraphicsComposition::FindCompositionInChildren(Point location)
+			{
+				for(vint i=children.Count()-1;i>=0;i--)
+				{
+					GuiGraphicsComposition* childResult=FindCompositionInChild(children[i], location);
+					if(childResult)
+					{
+						return childResult;
+					}
+				}
+				return 0;
+			}
+
+			Size GuiGraphicsComposition::GetCachedMinPreferredClientSize()
+			{
+				if(!minPreferredClientSizeCached)
+				{
+					cachedMinPreferredClientSize=GetMinPreferredClientSize();
+					minPreferredClientSizeCached=true;
+				}
+				return cachedMinPreferredClientSize;
+			}
+
+			void GuiGraphicsComposition::InvokeOnCompositionStateChanged()
+			{
+				GuiGraphicsHost* host=0;
+				GuiGraphicsComposition* composition=this;
+				while(composition)
+				{
+					composition->minPreferredClientSizeCached=false;
+					if(!host)
+					{
+						host=composition->associatedHost;
+					}
+					composition=composition->parent;
+				}
+				if(host)
+				{
+					host->RequestRender();
+				}
+			}
+
 			Margin GuiGraphicsComposition::GetMargin()
 			{
 				return margin;
@@ -463,7 +540,11 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::SetMargin(Margin value)
 			{
-				margin=value;
+				if(margin!=value)
+				{
+					margin=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			Margin GuiGraphicsComposition::GetInternalMargin()
@@ -473,7 +554,11 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::SetInternalMargin(Margin value)
 			{
-				internalMargin=value;
+				if(internalMargin!=value)
+				{
+					internalMargin=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			Size GuiGraphicsComposition::GetPreferredMinSize()
@@ -483,7 +568,11 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::SetPreferredMinSize(Size value)
 			{
-				preferredMinSize=value;
+				if(preferredMinSize!=value)
+				{
+					preferredMinSize=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			Rect GuiGraphicsComposition::GetClientArea()
@@ -510,7 +599,7 @@ GuiGraphicsSite
 
 			Rect GuiGraphicsSite::GetBoundsInternal(Rect expectedBounds)
 			{
-				Size minSize=GetMinPreferredClientSize();
+				Size minSize=GetCachedMinPreferredClientSize();
 				if(minSize.x<preferredMinSize.x) minSize.x=preferredMinSize.x;
 				if(minSize.y<preferredMinSize.y) minSize.y=preferredMinSize.y;
 
@@ -529,6 +618,10 @@ GuiGraphicsSite
 				{
 					previousBounds=bounds;
 					BoundsChanged.Execute(GuiEventArgs(this));
+					if(GuiGraphicsHost* host=GetRelatedGraphicsHost())
+					{
+						host->RequestRender();
+					}
 				}
 			}
 
@@ -579,13 +672,21 @@ GuiGraphicsSite
 
 			Rect GuiGraphicsSite::GetPreferredBounds()
 			{
-				return GetBoundsInternal(Rect(Point(0, 0), GetMinPreferredClientSize()));
+				return GetBoundsInternal(Rect(Point(0, 0), GetCachedMinPreferredClientSize()));
 			}
 
 /***********************************************************************
 Helper Functions
 ***********************************************************************/
 
+			void InvokeOnCompositionStateChanged(GuiGraphicsComposition* composition)
+			{
+				if(composition)
+				{
+					composition->InvokeOnCompositionStateChanged();
+				}
+			}
+
 			void SafeDeleteControl(controls::GuiControl* value)
 			{
 				if(value)
@@ -73,6 +73,9 @@ Basic Construction
 				Margin										internalMargin;
 				Size										preferredMinSize;
 
+				bool										minPreferredClientSizeCached;
+				Size										cachedMinPreferredClientSize;
+
 				virtual void								OnControlParentChanged(controls::GuiControl* control);
 				virtual void								OnChildInserted(GuiGraphicsComposition* child);
 				virtual void								OnChildRemoved(GuiGraphicsComposition* child);
@@ -83,6 +86,20 @@ Basic Construction
 				virtual void								SetAssociatedControl(controls::GuiControl* control);
 				virtual void								SetAssociatedHost(GuiGraphicsHost* host);
 
+				/// <summary>Find the deepest composition under a location in a child composition.</summary>
+				/// <returns>The deepest composition under the location. Returns null if the location is not in the child composition.</returns>
+				/// <param name="child">The child composition.</param>
+				/// <param name="location">The location in the client area of this composition.</param>
+				static GuiGraphicsComposition*				FindCompositionInChild(GuiGraphicsComposition* child, Point location);
+				/// <summary>Find the deepest composition under a location in all child compositions. A composition that arranges its children could override this function to avoid testing all children.</summary>
+				/// <returns>The deepest composition under the location. Returns null if the location is not in any child composition.</returns>
+				/// <param name="location">The location in the client area of this composition.</param>
+				virtual GuiGraphicsComposition*				FindCompositionInChildren(Point location);
+
+				/// <summary>Get the preferred minimum client size, returns the cached value if the layout of this composition is not invalidated since the last calculation.</summary>
+				/// <returns>The preferred minimum client size.</returns>
+				Size										GetCachedMinPreferredClientSize();
+
 				static bool									SharedPtrDestructorProc(DescriptableObject* obj, bool forceDisposing);
 			public:
 				GuiGraphicsComposition();
@@ -186,6 +203,8 @@ Basic Construction
 				/// <summary>Get the related cursor. A related cursor is from the deepest composition that contains this composition and associated with a cursor.</summary>
 				/// <returns>The related cursor.</returns>
 				INativeCursor*								GetRelatedCursor();
+				/// <summary>Notify that the visual state of this composition is changed. The cached layout of this composition and all its ancestors are discarded, and the related graphics host will render it again.</summary>
+				void										InvokeOnCompositionStateChanged();
 				
 				/// <summary>Get the margin.</summary>
 				/// <returns>The margin.</returns>
@@ -49,7 +49,88 @@ Event
 
 				class IHandler : public virtual IDescriptable, public Description<IHandler>
 				{
+					friend class GuiGraphicsEvent<T>;
+				private:
+					struct Attachment
+					{
+						GuiGraphicsEvent<T>*	event;
+						vint					index;				// the position in the event, so that Detach does not search for the handler
+
+						Attachment(GuiGraphicsEvent<T>* _event=0, vint _index=-1)
+							:event(_event)
+							,index(_index)
+						{
+						}
+					};
+
+					Attachment							attachment;				// most handlers are only attached to one event
+					collections::List<Attachment>		extraAttachments;		// other events, or the same event again
+
+					void AddAttachment(GuiGraphicsEvent<T>* event, vint index)
+					{
+						if(attachment.event)
+						{
+							extraAttachments.Add(Attachment(event, index));
+						}
+						else
+						{
+							attachment=Attachment(event, index);
+						}
+					}
+
+					vint RemoveAttachment(GuiGraphicsEvent<T>* event)
+					{
+						// if the handler is attached to the event more than once, the first one is removed
+						vint extra=-1;
+						vint index=attachment.event==event?attachment.index:-1;
+						for(vint i=0;i<extraAttachments.Count();i++)
+						{
+							const Attachment& current=extraAttachments[i];
+							if(current.event==event && (index==-1 || current.index<index))
+							{
+								extra=i;
+								index=current.index;
+							}
+						}
+
+						if(extra!=-1)
+						{
+							extraAttachments.RemoveAt(extra);
+						}
+						else if(index!=-1)
+						{
+							if(extraAttachments.Count()>0)
+							{
+								attachment=extraAttachments[extraAttachments.Count()-1];
+								extraAttachments.RemoveAt(extraAttachments.Count()-1);
+							}
+							else
+							{
+								attachment=Attachment();
+							}
+						}
+						return index;
+					}
+
+					void MoveAttachment(GuiGraphicsEvent<T>* event, vint oldIndex, vint newIndex)
+					{
+						if(attachment.event==event && attachment.index==oldIndex)
+						{
+							attachment.index=newIndex;
+							return;
+						}
+						for(vint i=0;i<extraAttachments.Count();i++)
+						{
+							Attachment& current=extraAttachments[i];
+							if(current.event==event && current.index==oldIndex)
+							{
+								current.index=newIndex;
+								return;
+							}
+						}
+					}
 				public:
+
 					virtual void			Execute(GuiGraphicsComposition* sender, T& argument)=0;
 				};
 
@@ -74,23 +155,136 @@ Event
 						handler(sender, argument);
 					}
 				};
+
+				template<typename TLambda>
+				class LambdaHandler : public Object, public IHandler
+				{
+				protected:
+					TLambda					handler;
+				public:
+					LambdaHandler(const TLambda& _handler)
+						:handler(_handler)
+					{
+					}
+
+					void Execute(GuiGraphicsComposition* sender, T& argument)override
+					{
+						handler(sender, argument);
+					}
+				};
+
+				template<typename TClass, typename TMethod>
+				class MethodHandler : public Object, public IHandler
+				{
+				protected:
+					TClass*					receiver;
+					TMethod TClass::*		method;
+				public:
+					MethodHandler(TClass* _receiver, TMethod TClass::* _method)
+						:receiver(_receiver)
+						,method(_method)
+					{
+					}
+
+					void Execute(GuiGraphicsComposition* sender, T& argument)override
+					{
+						(receiver->*method)(sender, argument);
+					}
+				};
 			protected:
-				struct HandlerNode
+				static const vint										InlineHandlerCount=2;
+
+				class ExecutingGuard
 				{
-					Ptr<IHandler>										handler;
-					Ptr<HandlerNode>									next;
+				protected:
+					GuiGraphicsEvent<T>*								event;
+				public:
+					ExecutingGuard(GuiGraphicsEvent<T>* _event)
+						:event(_event)
+					{
+						event->executingCount++;
+					}
+
+					~ExecutingGuard()
+					{
+						if(--event->executingCount==0)
+						{
+							event->TryRemoveDetachedHandlers();
+						}
+					}
 				};
 
 				GuiGraphicsComposition*									sender;
-				Ptr<HandlerNode>										handlers;
+				Ptr<IHandler>											inlineHandlers[InlineHandlerCount];
+				Ptr<IHandler>*											extraHandlers;
+				vint													extraHandlerCapacity;
+				vint													handlerCount;			// detached handlers stay as null until they are compacted
+				vint													detachedCount;
+				vint													executingCount;
+
+				GuiGraphicsEvent(const GuiGraphicsEvent<T>&);
+				GuiGraphicsEvent<T>& operator=(const GuiGraphicsEvent<T>&);
+
+				Ptr<IHandler>& GetHandler(vint index)
+				{
+					return index<InlineHandlerCount?inlineHandlers[index]:extraHandlers[index-InlineHandlerCount];
+				}
+
+				void RemoveDetachedHandlers()
+				{
+					vint writing=0;
+					for(vint i=0;i<handlerCount;i++)
+					{
+						Ptr<IHandler>& handler=GetHandler(i);
+						if(handler)
+						{
+							if(writing!=i)
+							{
+								handler->MoveAttachment(this, i, writing);
+								GetHandler(writing)=handler;
+								handler=0;
+							}
+							writing++;
+						}
+					}
+					handlerCount=writing;
+					detachedCount=0;
+				}
+
+				void TryRemoveDetachedHandlers()
+				{
+					// trailing null slots are dropped immediately, others are compacted when they take half of the storage, so that Detach is amortized O(1)
+					while(handlerCount>0 && !GetHandler(handlerCount-1))
+					{
+						handlerCount--;
+						detachedCount--;
+					}
+					if(detachedCount>0 && detachedCount*2>=handlerCount)
+					{
+						RemoveDetachedHandlers();
+					}
+				}
 			public:
 				GuiGraphicsEvent(GuiGraphicsComposition* _sender=0)
 					:sender(_sender)
+					,extraHandlers(0)
+					,extraHandlerCapacity(0)
+					,handlerCount(0)
+					,detachedCount(0)
+					,executingCount(0)
 				{
 				}
 
 				~GuiGraphicsEvent()
 				{
+					for(vint i=0;i<handlerCount;i++)
+					{
+						if(Ptr<IHandler> handler=GetHandler(i))
+						{
+							handler->RemoveAttachment(this);
+						}
+					}
+					delete[] extraHandlers;
 				}
 
 				GuiGraphicsComposition* GetAssociatedComposition()
@@ -105,34 +299,36 @@ Event
 
 				bool Attach(Ptr<IHandler> handler)
 				{
-					Ptr<HandlerNode>* currentHandler=&handlers;
-					while(*currentHandler)
+					if(!handler) return false;
+
+					if(handlerCount==InlineHandlerCount+extraHandlerCapacity)
 					{
-						if((*currentHandler)->handler==handler)
-						{
-							return false;
-						}
-						else
+						vint capacity=extraHandlerCapacity==0?InlineHandlerCount:extraHandlerCapacity*2;
+						Ptr<IHandler>* handlers=new Ptr<IHandler>[capacity];
+						for(vint i=0;i<extraHandlerCapacity;i++)
 						{
-							currentHandler=&(*currentHandler)->next;
+							handlers[i]=extraHandlers[i];
 						}
+						delete[] extraHandlers;
+						extraHandlers=handlers;
+						extraHandlerCapacity=capacity;
 					}
-					(*currentHandler)=new HandlerNode;
-					(*currentHandler)->handler=handler;
+					handler->AddAttachment(this, handlerCount);
+					GetHandler(handlerCount++)=handler;
 					return true;
 				}
 
 				template<typename TClass, typename TMethod>
 				Ptr<IHandler> AttachMethod(TClass* receiver, TMethod TClass::* method)
 				{
-					Ptr<IHandler> handler=new FunctionHandler(FunctionType(receiver, method));
+					Ptr<IHandler> handler=new MethodHandler<TClass, TMethod>(receiver, method);
 					Attach(handler);
 					return handler;
 				}
 
 				Ptr<IHandler> AttachFunction(RawFunctionType* function)
 				{
-					Ptr<IHandler> handler=new FunctionHandler(FunctionType(function));
+					Ptr<IHandler> handler=new LambdaHandler<RawFunctionType*>(function);
 					Attach(handler);
 					return handler;
 				}
@@ -147,37 +343,37 @@ Event
 				template<typename TLambda>
 				Ptr<IHandler> AttachLambda(const TLambda& lambda)
 				{
-					Ptr<IHandler> handler=new FunctionHandler(FunctionType(lambda));
+					Ptr<IHandler> handler=new LambdaHandler<TLambda>(lambda);
 					Attach(handler);
 					return handler;
 				}
 
 				bool Detach(Ptr<IHandler> handler)
 				{
-					Ptr<HandlerNode>* currentHandler=&handlers;
-					while(*currentHandler)
+					if(!handler) return false;
+					vint index=handler->RemoveAttachment(this);
+					if(index==-1) return false;
+					GetHandler(index)=0;
+					detachedCount++;
+					if(executingCount==0)
 					{
-						if((*currentHandler)->handler==handler)
-						{
-							Ptr<HandlerNode> next=(*currentHandler)->next;
-							(*currentHandler)=next;
-							return true;
-						}
-						else
-						{
-							currentHandler=&(*currentHandler)->next;
-						}
+						TryRemoveDetachedHandlers();
 					}
-					return false;
+					return true;
 				}
 
 				void ExecuteWithNewSender(T& argument, GuiGraphicsComposition* newSender)
 				{
-					Ptr<HandlerNode>* currentHandler=&handlers;
-					while(*currentHandler)
+					// null slots are not compacted until the outermost Execute returns, even if a handler throws
+					ExecutingGuard guard(this);
+					for(vint i=0;i<handlerCount;i++)
 					{
-						(*currentHandler)->handler->Execute(newSender?newSender:sender, argument);
-						currentHandler=&(*currentHandler)->next;
+						// handlers could be attached or detached by themselves, so the storage is accessed again for each handler
+						Ptr<IHandler> handler=GetHandler(i);
+						if(handler)
+						{
+							handler->Execute(newSender?newSender:sender, argument);
+						}
 					}
 				}
 
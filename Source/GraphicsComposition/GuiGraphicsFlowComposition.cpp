@@ -31,6 +31,7 @@ GuiFlowComposition
 					flowItemBounds.Resize(flowItems.Count());
 					for (vint i = 0; i < flowItems.Count(); i++)
 					{
+						flowItems[i]->flowIndex = i;
 						flowItemBounds[i] = Rect(Point(0, 0), flowItems[i]->GetMinSize());
 					}
 
@@ -135,7 +136,12 @@ GuiFlowComposition
 						currentIndex += rowItemCount;
 					}
 
-					minHeight = rowTop == 0 ? 0 : rowTop - rowPadding;
+					vint newMinHeight = rowTop == 0 ? 0 : rowTop - rowPadding;
+					if (minHeight != newMinHeight)
+					{
+						minHeight = newMinHeight;
+						InvokeOnCompositionStateChanged();
+					}
 				}
 			}
 
@@ -148,10 +154,14 @@ GuiFlowComposition
 			{
 				GuiBoundsComposition::OnChildInserted(child);
 				auto item = dynamic_cast<GuiFlowItemComposition*>(child);
-				if (item && !flowItems.Contains(item))
+				if (item)
 				{
-					flowItems.Add(item);
-					needUpdate = true;
+					vint index = item->flowIndex;
+					if (index < 0 || index >= flowItems.Count() || flowItems[index] != item)
+					{
+						item->flowIndex = flowItems.Add(item);
+						needUpdate = true;
+					}
 				}
 			}
 
@@ -162,6 +172,7 @@ GuiFlowComposition
 				if(item)
 				{
 					flowItems.Remove(item);
+					item->flowIndex = -1;
 					needUpdate = true;
 				}
 			}
@@ -188,8 +199,12 @@ GuiFlowComposition
 
 			void GuiFlowComposition::SetExtraMargin(Margin value)
 			{
-				extraMargin = value;
-				needUpdate = true;
+				if (extraMargin != value)
+				{
+					extraMargin = value;
+					needUpdate = true;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			vint GuiFlowComposition::GetRowPadding()
@@ -199,8 +214,12 @@ GuiFlowComposition
 
 			void GuiFlowComposition::SetRowPadding(vint value)
 			{
-				rowPadding = value;
-				needUpdate = true;
+				if (rowPadding != value)
+				{
+					rowPadding = value;
+					needUpdate = true;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			vint GuiFlowComposition::GetColumnPadding()
@@ -210,8 +229,12 @@ GuiFlowComposition
 
 			void GuiFlowComposition::SetColumnPadding(vint value)
 			{
-				columnPadding = value;
-				needUpdate = true;
+				if (columnPadding != value)
+				{
+					columnPadding = value;
+					needUpdate = true;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			Ptr<IGuiAxis> GuiFlowComposition::GetAxis()
@@ -225,6 +248,7 @@ GuiFlowComposition
 				{
 					axis = value;
 					needUpdate = true;
+					InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -235,8 +259,12 @@ GuiFlowComposition
 
 			void GuiFlowComposition::SetAlignment(FlowAlignment value)
 			{
-				alignment = value;
-				needUpdate = true;
+				if (alignment != value)
+				{
+					alignment = value;
+					needUpdate = true;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			void GuiFlowComposition::ForceCalculateSizeImmediately()
@@ -331,7 +359,11 @@ GuiFlowItemComposition
 				if(flowParent)
 				{
 					flowParent->UpdateFlowItemBounds(false);
-					vint index = flowParent->flowItems.IndexOf(this);
+					vint index = flowIndex;
+					if (index < 0 || index >= flowParent->flowItems.Count() || flowParent->flowItems[index] != this)
+					{
+						index = flowParent->flowItems.IndexOf(this);
+					}
 					if (index != -1)
 					{
 						result = flowParent->flowItemBounds[index];
@@ -360,7 +392,11 @@ GuiFlowItemComposition
 
 			void GuiFlowItemComposition::SetExtraMargin(Margin value)
 			{
-				extraMargin = value;
+				if (extraMargin != value)
+				{
+					extraMargin = value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			GuiFlowOption GuiFlowItemComposition::GetFlowOption()
@@ -375,6 +411,7 @@ GuiFlowItemComposition
 				{
 					flowParent->needUpdate = true;
 				}
+				InvokeOnCompositionStateChanged();
 			}
 		}
 	}
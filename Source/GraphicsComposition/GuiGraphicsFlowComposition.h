@@ -143,6 +143,7 @@ Flow Compositions
 				friend class GuiFlowComposition;
 			protected:
 				GuiFlowComposition*					flowParent;
+				vint								flowIndex = -1;
 				Rect								bounds;
 				Margin								extraMargin;
 				GuiFlowOption						option;
@@ -29,7 +29,11 @@ GuiSideAlignedComposition
 
 			void GuiSideAlignedComposition::SetDirection(Direction value)
 			{
-				direction=value;
+				if(direction!=value)
+				{
+					direction=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			vint GuiSideAlignedComposition::GetMaxLength()
@@ -40,7 +44,11 @@ GuiSideAlignedComposition
 			void GuiSideAlignedComposition::SetMaxLength(vint value)
 			{
 				if(value<0) value=0;
-				maxLength=value;
+				if(maxLength!=value)
+				{
+					maxLength=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			double GuiSideAlignedComposition::GetMaxRatio()
@@ -50,10 +58,15 @@ GuiSideAlignedComposition
 
 			void GuiSideAlignedComposition::SetMaxRatio(double value)
 			{
-				maxRatio=
+				value=
 					value<0?0:
 					value>1?1:
 					value;
+				if(maxRatio!=value)
+				{
+					maxRatio=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			bool GuiSideAlignedComposition::IsSizeAffectParent()
@@ -139,22 +152,38 @@ GuiPartialViewComposition
 
 			void GuiPartialViewComposition::SetWidthRatio(double value)
 			{
-				wRatio=value;
+				if(wRatio!=value)
+				{
+					wRatio=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			void GuiPartialViewComposition::SetWidthPageSize(double value)
 			{
-				wPageSize=value;
+				if(wPageSize!=value)
+				{
+					wPageSize=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			void GuiPartialViewComposition::SetHeightRatio(double value)
 			{
-				hRatio=value;
+				if(hRatio!=value)
+				{
+					hRatio=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			void GuiPartialViewComposition::SetHeightPageSize(double value)
 			{
-				hPageSize=value;
+				if(hPageSize!=value)
+				{
+					hPageSize=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			bool GuiPartialViewComposition::IsSizeAffectParent()
@@ -13,17 +13,25 @@ GuiStackComposition
 
 			void GuiStackComposition::UpdateStackItemBounds()
 			{
+				needUpdate = false;
 				if (stackItemBounds.Count() != stackItems.Count())
 				{
 					stackItemBounds.Resize(stackItems.Count());
 				}
 
+				Size previousTotalSize = stackItemTotalSize;
 				stackItemTotalSize = Size(0, 0);
+				itemsOverlapped = padding < 0;
 				Point offset;
 				for (vint i = 0; i < stackItems.Count(); i++)
 				{
 					vint offsetX = 0;
 					vint offsetY = 0;
+					stackItems[i]->stackIndex = i;
+					if (stackItems[i]->extraMargin != Margin())
+					{
+						itemsOverlapped = true;
+					}
 					Size itemSize = stackItems[i]->GetMinSize();
 					stackItemBounds[i] = Rect(offset, itemSize);
 
@@ -56,6 +64,10 @@ GuiStackComposition
 					offset.x += itemSize.x + padding;
 					offset.y += itemSize.y + padding;
 				}
+				if (stackItemTotalSize != previousTotalSize)
+				{
+					InvokeOnCompositionStateChanged();
+				}
 				EnsureStackItemVisible();
 			}
 
@@ -105,11 +117,12 @@ GuiStackComposition
 				GuiStackItemComposition* item = dynamic_cast<GuiStackItemComposition*>(child);
 				if (item)
 				{
-					if (!stackItems.Contains(item))
+					vint index = item->stackIndex;
+					if (index < 0 || index >= stackItems.Count() || stackItems[index] != item)
 					{
-						stackItems.Add(item);
+						item->stackIndex = stackItems.Add(item);
 					}
-					UpdateStackItemBounds();
+					needUpdate = true;
 				}
 			}
 
@@ -120,12 +133,52 @@ GuiStackComposition
 				if(item)
 				{
 					stackItems.Remove(item);
+					item->stackIndex = -1;
 					if (item == ensuringVisibleStackItem)
 					{
 						ensuringVisibleStackItem = 0;
 					}
+					needUpdate = true;
+				}
+			}
+
+			GuiGraphicsComposition* GuiStackComposition::FindCompositionInChildren(Point location)
+			{
+				if (needUpdate)
+				{
 					UpdateStackItemBounds();
 				}
+				if (itemsOverlapped || stackItems.Count() != Children().Count())
+				{
+					return GuiBoundsComposition::FindCompositionInChildren(location);
+				}
+
+				// stack items are not overlapped and sorted in the stack direction, binary search the only candidate
+				bool reversed = direction == ReversedHorizontal || direction == ReversedVertical;
+				bool horizontal = direction == Horizontal || direction == ReversedHorizontal;
+				vint position = horizontal ? location.x : location.y;
+				vint start = 0;
+				vint end = stackItems.Count() - 1;
+				while (start <= end)
+				{
+					vint middle = (start + end) / 2;
+					Rect itemBounds = stackItems[middle]->GetBounds();
+					vint itemStart = horizontal ? itemBounds.x1 : itemBounds.y1;
+					vint itemEnd = horizontal ? itemBounds.x2 : itemBounds.y2;
+					if (position < itemStart)
+					{
+						if (reversed) start = middle + 1; else end = middle - 1;
+					}
+					else if (position >= itemEnd)
+					{
+						if (reversed) end = middle - 1; else start = middle + 1;
+					}
+					else
+					{
+						return FindCompositionInChild(stackItems[middle], location);
+					}
+				}
+				return 0;
 			}
 
 			GuiStackComposition::GuiStackComposition()
@@ -145,9 +198,11 @@ GuiStackComposition
 			bool GuiStackComposition::InsertStackItem(vint index, GuiStackItemComposition* item)
 			{
 				index=stackItems.Insert(index, item);
+				item->stackIndex=index;
 				if(!AddChild(item))
 				{
 					stackItems.RemoveAt(index);
+					item->stackIndex=-1;
 					return false;
 				}
 				else
@@ -163,8 +218,12 @@ GuiStackComposition
 
 			void GuiStackComposition::SetDirection(Direction value)
 			{
-				direction = value;
-				EnsureStackItemVisible();
+				if (direction != value)
+				{
+					direction = value;
+					EnsureStackItemVisible();
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			vint GuiStackComposition::GetPadding()
@@ -174,8 +233,12 @@ GuiStackComposition
 
 			void GuiStackComposition::SetPadding(vint value)
 			{
-				padding = value;
-				EnsureStackItemVisible();
+				if (padding != value)
+				{
+					padding = value;
+					EnsureStackItemVisible();
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			void GuiStackComposition::ForceCalculateSizeImmediately()
@@ -186,6 +249,10 @@ GuiStackComposition
 			
 			Size GuiStackComposition::GetMinPreferredClientSize()
 			{
+				if (needUpdate)
+				{
+					UpdateStackItemBounds();
+				}
 				Size minSize = GuiBoundsComposition::GetMinPreferredClientSize();
 				if (GetMinSizeLimitation() == GuiGraphicsComposition::LimitToElementAndChildren)
 				{
@@ -216,12 +283,19 @@ GuiStackComposition
 
 			Rect GuiStackComposition::GetBounds()
 			{
-				for (vint i = 0; i < stackItems.Count(); i++)
+				if (needUpdate)
 				{
-					if (stackItemBounds[i].GetSize() != stackItems[i]->GetMinSize())
+					UpdateStackItemBounds();
+				}
+				else
+				{
+					for (vint i = 0; i < stackItems.Count(); i++)
 					{
-						UpdateStackItemBounds();
-						break;
+						if (stackItemBounds[i].GetSize() != stackItems[i]->GetMinSize())
+						{
+							UpdateStackItemBounds();
+							break;
+						}
 					}
 				}
 
@@ -238,8 +312,12 @@ GuiStackComposition
 
 			void GuiStackComposition::SetExtraMargin(Margin value)
 			{
-				extraMargin=value;
-				EnsureStackItemVisible();
+				if (extraMargin != value)
+				{
+					extraMargin = value;
+					EnsureStackItemVisible();
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			bool GuiStackComposition::IsStackItemClipped()
@@ -282,6 +360,7 @@ GuiStackComposition
 					ensuringVisibleStackItem = 0;
 				}
 				EnsureStackItemVisible();
+				InvokeOnCompositionStateChanged();
 				return ensuringVisibleStackItem != 0;
 			}
 
@@ -320,7 +399,15 @@ GuiStackItemComposition
 				Rect result = bounds;
 				if(stackParent)
 				{
-					vint index = stackParent->stackItems.IndexOf(this);
+					if (stackParent->needUpdate)
+					{
+						stackParent->UpdateStackItemBounds();
+					}
+					vint index = stackIndex;
+					if (index < 0 || index >= stackParent->stackItems.Count() || stackParent->stackItems[index] != this)
+					{
+						index = stackParent->stackItems.IndexOf(this);
+					}
 					if (index != -1)
 					{
 						result = stackParent->stackItemBounds[index];
@@ -385,7 +472,15 @@ GuiStackItemComposition
 
 			void GuiStackItemComposition::SetExtraMargin(Margin value)
 			{
-				extraMargin = value;
+				if (extraMargin != value)
+				{
+					extraMargin = value;
+					if (stackParent)
+					{
+						stackParent->needUpdate = true;
+					}
+					InvokeOnCompositionStateChanged();
+				}
 			}
 		}
 	}
@@ -58,12 +58,15 @@ Stack Compositions
 				collections::Array<Rect>			stackItemBounds;
 				Size								stackItemTotalSize;
 				Rect								previousBounds;
+				bool								needUpdate = false;
+				bool								itemsOverlapped = false;
 
 				void								UpdateStackItemBounds();
 				void								EnsureStackItemVisible();
 				void								OnBoundsChanged(GuiGraphicsComposition* sender, GuiEventArgs& arguments);
 				void								OnChildInserted(GuiGraphicsComposition* child)override;
 				void								OnChildRemoved(GuiGraphicsComposition* child)override;
+				GuiGraphicsComposition*				FindCompositionInChildren(Point location)override;
 			public:
 				GuiStackComposition();
 				~GuiStackComposition();
@@ -117,6 +120,7 @@ Stack Compositions
 				friend class GuiStackComposition;
 			protected:
 				GuiStackComposition*				stackParent;
+				vint								stackIndex = -1;
 				Rect								bounds;
 				Margin								extraMargin;
 
@@ -56,6 +56,27 @@ GuiTableComposition
 				{
 					return cell->GetColumnSpan();
 				}
+
+				vint BinarySearchLastOffset(const Array<vint>& offsets, vint position)
+				{
+					vint start = 0;
+					vint end = offsets.Count() - 1;
+					vint result = -1;
+					while (start <= end)
+					{
+						vint middle = (start + end) / 2;
+						if (offsets[middle] <= position)
+						{
+							result = middle;
+							start = middle + 1;
+						}
+						else
+						{
+							end = middle - 1;
+						}
+					}
+					return result;
+				}
 			}
 			using namespace update_cell_bounds_helpers;
 
@@ -67,6 +88,7 @@ GuiTableComposition
 			void GuiTableComposition::SetSitedCell(vint _row, vint _column, GuiCellComposition* cell)
 			{
 				cellCompositions[GetSiteIndex(rows, columns, _row, _column)]=cell;
+				sitedCellCount=-1;
 			}
 
 			void GuiTableComposition::UpdateCellBoundsInternal(
@@ -408,6 +430,7 @@ GuiTableComposition
 				{
 					previousContentMinSize=tableContentMinSize;
 					UpdateCellBoundsInternal();
+					InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -419,6 +442,55 @@ GuiTableComposition
 				}
 			}
 
+			void GuiTableComposition::OnChildInserted(GuiGraphicsComposition* child)
+			{
+				GuiBoundsComposition::OnChildInserted(child);
+				sitedCellCount = -1;
+			}
+
+			void GuiTableComposition::OnChildRemoved(GuiGraphicsComposition* child)
+			{
+				GuiBoundsComposition::OnChildRemoved(child);
+				sitedCellCount = -1;
+			}
+
+			GuiGraphicsComposition* GuiTableComposition::FindCompositionInChildren(Point location)
+			{
+				if (sitedCellCount == -1)
+				{
+					// only cells sited in the table are arranged by UpdateCellBounds, a child that is not a sited cell disables the fast path
+					sitedCellCount = 0;
+					for (vint r = 0; r < rows; r++)
+					{
+						for (vint c = 0; c < columns; c++)
+						{
+							GuiCellComposition* cell = cellCompositions[GetSiteIndex(rows, columns, r, c)];
+							if (cell && cell->GetRow() == r && cell->GetColumn() == c)
+							{
+								sitedCellCount++;
+							}
+						}
+					}
+				}
+
+				if (sitedCellCount != Children().Count() || rowOffsets.Count() != rows || columnOffsets.Count() != columns)
+				{
+					return GuiBoundsComposition::FindCompositionInChildren(location);
+				}
+
+				// cells are not overlapped, locate the only candidate from row and column offsets
+				vint offset = borderVisible ? cellPadding : 0;
+				vint row = BinarySearchLastOffset(rowOffsets, location.y - offset);
+				vint column = BinarySearchLastOffset(columnOffsets, location.x - offset);
+				if (row == -1 || column == -1)
+				{
+					return 0;
+				}
+
+				GuiCellComposition* cell = cellCompositions[GetSiteIndex(rows, columns, row, column)];
+				return cell ? FindCompositionInChild(cell, location) : 0;
+			}
+
 			GuiTableComposition::GuiTableComposition()
 				:rows(0)
 				, columns(0)
@@ -426,6 +498,7 @@ GuiTableComposition
 				, borderVisible(true)
 				, rowExtending(0)
 				, columnExtending(0)
+				, sitedCellCount(-1)
 			{
 				ConfigChanged.SetAssociatedComposition(this);
 				SetRowsAndColumns(1, 1);
@@ -457,6 +530,7 @@ GuiTableComposition
 					cellCompositions[i]=0;
 					cellBounds[i]=Rect();
 				}
+				sitedCellCount=-1;
 				rows=_rows;
 				columns=_columns;
 				vint childCount=Children().Count();
@@ -470,6 +544,7 @@ GuiTableComposition
 				}
 				ConfigChanged.Execute(GuiEventArgs(this));
 				UpdateCellBounds();
+				InvokeOnCompositionStateChanged();
 				return true;
 			}
 
@@ -487,6 +562,7 @@ GuiTableComposition
 			{
 				rowOptions[_row]=option;
 				ConfigChanged.Execute(GuiEventArgs(this));
+				InvokeOnCompositionStateChanged();
 			}
 
 			GuiCellOption GuiTableComposition::GetColumnOption(vint _column)
@@ -498,6 +574,7 @@ GuiTableComposition
 			{
 				columnOptions[_column]=option;
 				ConfigChanged.Execute(GuiEventArgs(this));
+				InvokeOnCompositionStateChanged();
 			}
 
 			vint GuiTableComposition::GetCellPadding()
@@ -508,7 +585,11 @@ GuiTableComposition
 			void GuiTableComposition::SetCellPadding(vint value)
 			{
 				if(value<0) value=0;
-				cellPadding=value;
+				if(cellPadding!=value)
+				{
+					cellPadding=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			bool GuiTableComposition::GetBorderVisible()
@@ -522,6 +603,7 @@ GuiTableComposition
 				{
 					borderVisible = value;
 					UpdateCellBounds();
+					InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -570,17 +652,19 @@ GuiTableComposition
 				}
 
 				bool cellMinSizeModified=false;
-				SortedList<GuiCellComposition*> cells;
-				FOREACH(GuiCellComposition*, cell, cellCompositions)
+				for(vint r=0;r<rows;r++)
 				{
-					if(cell && !cells.Contains(cell))
+					for(vint c=0;c<columns;c++)
 					{
-						cells.Add(cell);
-						Size newSize=cell->GetPreferredBounds().GetSize();
-						if(cell->lastPreferredSize!=newSize)
+						GuiCellComposition* cell=cellCompositions[GetSiteIndex(rows, columns, r, c)];
+						if(cell && cell->GetRow()==r && cell->GetColumn()==c)
 						{
-							cell->lastPreferredSize=newSize;
-							cellMinSizeModified=true;
+							Size newSize=cell->GetPreferredBounds().GetSize();
+							if(cell->lastPreferredSize!=newSize)
+							{
+								cell->lastPreferredSize=newSize;
+								cellMinSizeModified=true;
+							}
 						}
 					}
 				}
@@ -740,6 +824,7 @@ GuiCellComposition
 					{
 						tableParent->UpdateCellBounds();
 					}
+					InvokeOnCompositionStateChanged();
 					return true;
 				}
 				else
@@ -983,7 +1068,11 @@ GuiRowSplitterComposition
 
 			void GuiRowSplitterComposition::SetRowsToTheTop(vint value)
 			{
-				rowsToTheTop = value;
+				if (rowsToTheTop != value)
+				{
+					rowsToTheTop = value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			Rect GuiRowSplitterComposition::GetBounds()
@@ -1034,7 +1123,11 @@ GuiColumnSplitterComposition
 
 			void GuiColumnSplitterComposition::SetColumnsToTheLeft(vint value)
 			{
-				columnsToTheLeft = value;
+				if (columnsToTheLeft != value)
+				{
+					columnsToTheLeft = value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			Rect GuiColumnSplitterComposition::GetBounds()
@@ -122,6 +122,7 @@ Table Compositions
 				Rect										previousBounds;
 				Size										previousContentMinSize;
 				Size										tableContentMinSize;
+				vint										sitedCellCount;			// -1 means it needs to be counted again
 
 				vint								GetSiteIndex(vint _rows, vint _columns, vint _row, vint _column);
 				void								SetSitedCell(vint _row, vint _column, GuiCellComposition* cell);
@@ -155,6 +156,9 @@ Table Compositions
 				void								UpdateCellBoundsInternal();
 				void								UpdateTableContentMinSize();
 				void								OnRenderTargetChanged()override;
+				void								OnChildInserted(GuiGraphicsComposition* child)override;
+				void								OnChildRemoved(GuiGraphicsComposition* child)override;
+				GuiGraphicsComposition*				FindCompositionInChildren(Point location)override;
 			public:
 				GuiTableComposition();
 				~GuiTableComposition();
@@ -258,13 +258,126 @@ GuiDocumentElement::GuiDocumentElementRenderer
 
 			void GuiDocumentElement::GuiDocumentElementRenderer::RenderTargetChangedInternal(IGuiGraphicsRenderTarget* oldRenderTarget, IGuiGraphicsRenderTarget* newRenderTarget)
 			{
-				for(vint i=0;i<paragraphCaches.Count();i++)
+				ReleaseAllParagraphs();
+			}
+
+			void GuiDocumentElement::GuiDocumentElementRenderer::BuildParagraphHeightTree()
+			{
+				vint count=paragraphHeights.Count();
+				paragraphHeightTree.Resize(count+1);
+				paragraphHeightTree[0]=0;
+				cachedTotalHeight=0;
+				for(vint i=1;i<=count;i++)
+				{
+					paragraphHeightTree[i]=paragraphHeights[i-1]+paragraphDistance;
+					cachedTotalHeight+=paragraphHeightTree[i];
+				}
+				for(vint i=1;i<=count;i++)
+				{
+					vint parent=i+(i&-i);
+					if(parent<=count)
+					{
+						paragraphHeightTree[parent]+=paragraphHeightTree[i];
+					}
+				}
+				if(count>0)
+				{
+					cachedTotalHeight-=paragraphDistance;
+				}
+			}
+
+			void GuiDocumentElement::GuiDocumentElementRenderer::SetParagraphHeight(vint paragraphIndex, vint height)
+			{
+				vint delta=height-paragraphHeights[paragraphIndex];
+				if(delta==0) return;
+				paragraphHeights[paragraphIndex]=height;
+				for(vint i=paragraphIndex+1;i<paragraphHeightTree.Count();i+=(i&-i))
+				{
+					paragraphHeightTree[i]+=delta;
+				}
+				cachedTotalHeight+=delta;
+			}
+
+			vint GuiDocumentElement::GuiDocumentElementRenderer::GetParagraphTop(vint paragraphIndex)
+			{
+				vint top=0;
+				for(vint i=paragraphIndex;i>0;i-=(i&-i))
+				{
+					top+=paragraphHeightTree[i];
+				}
+				return top;
+			}
+
+			void GuiDocumentElement::GuiDocumentElementRenderer::TouchParagraph(ParagraphCache* cache)
+			{
+				if(firstUsedParagraph==cache) return;
+				if(cache->previousUsed)
 				{
-					ParagraphCache* cache=paragraphCaches[i].Obj();
-					if(cache)
+					cache->previousUsed->nextUsed=cache->nextUsed;
+					if(cache->nextUsed)
 					{
-						cache->graphicsParagraph=0;
+						cache->nextUsed->previousUsed=cache->previousUsed;
 					}
+					else
+					{
+						lastUsedParagraph=cache->previousUsed;
+					}
+				}
+				else
+				{
+					usedParagraphCount++;
+				}
+
+				cache->previousUsed=nullptr;
+				cache->nextUsed=firstUsedParagraph;
+				if(firstUsedParagraph)
+				{
+					firstUsedParagraph->previousUsed=cache;
+				}
+				else
+				{
+					lastUsedParagraph=cache;
+				}
+				firstUsedParagraph=cache;
+
+				vint cacheSize=element->paragraphCacheSize<1?1:element->paragraphCacheSize;
+				while(usedParagraphCount>cacheSize)
+				{
+					ReleaseParagraph(lastUsedParagraph);
+				}
+			}
+
+			void GuiDocumentElement::GuiDocumentElementRenderer::ReleaseParagraph(ParagraphCache* cache)
+			{
+				if(!cache->graphicsParagraph) return;
+				cache->graphicsParagraph=0;
+
+				if(cache->previousUsed)
+				{
+					cache->previousUsed->nextUsed=cache->nextUsed;
+				}
+				else
+				{
+					firstUsedParagraph=cache->nextUsed;
+				}
+				if(cache->nextUsed)
+				{
+					cache->nextUsed->previousUsed=cache->previousUsed;
+				}
+				else
+				{
+					lastUsedParagraph=cache->previousUsed;
+				}
+				cache->previousUsed=nullptr;
+				cache->nextUsed=nullptr;
+				usedParagraphCount--;
+			}
+
+			void GuiDocumentElement::GuiDocumentElementRenderer::ReleaseAllParagraphs()
+			{
+				while(firstUsedParagraph)
+				{
+					ReleaseParagraph(firstUsedParagraph);
 				}
 			}
 
@@ -288,18 +401,16 @@ GuiDocumentElement::GuiDocumentElementRenderer
 						cache->graphicsParagraph->SetParagraphAlignment(paragraph->alignment ? paragraph->alignment.Value() : Alignment::Left);
 						SetPropertiesVisitor::SetProperty(element->document.Obj(), this, cache, paragraph, cache->selectionBegin, cache->selectionEnd);
 					}
+					TouchParagraph(cache.Obj());
 					if(cache->graphicsParagraph->GetMaxWidth()!=lastMaxWidth)
 					{
 						cache->graphicsParagraph->SetMaxWidth(lastMaxWidth);
 					}
 
-					vint paragraphHeight=paragraphHeights[paragraphIndex];
 					vint height=cache->graphicsParagraph->GetHeight();
-					if(paragraphHeight!=height)
+					if(paragraphHeights[paragraphIndex]!=height)
 					{
-						cachedTotalHeight+=height-paragraphHeight;
-						paragraphHeight=height;
-						paragraphHeights[paragraphIndex]=paragraphHeight;
+						SetParagraphHeight(paragraphIndex, height);
 						minSize=Size(0, cachedTotalHeight);
 					}
 				}
@@ -309,24 +420,32 @@ GuiDocumentElement::GuiDocumentElementRenderer
 
 			bool GuiDocumentElement::GuiDocumentElementRenderer::GetParagraphIndexFromPoint(Point point, vint& top, vint& index)
 			{
+				vint count=paragraphHeights.Count();
+				if(count==0) return true;
+
+				vint step=1;
+				while(step*2<=count) step*=2;
+
+				// find the first paragraph whose bottom, including the paragraph distance, is below the point
 				vint y=0;
-				for(vint i=0;i<paragraphHeights.Count();i++)
+				vint i=0;
+				for(;step>0;step/=2)
 				{
-					vint paragraphHeight=paragraphHeights[i];
-					vint nextY=y+paragraphHeight+paragraphDistance;
-					top=y;
-					index=i;
-
-					if(nextY<=point.y)
-					{
-						y=nextY;
-						continue;
-					}
-					else
+					vint next=i+step;
+					if(next<=count && y+paragraphHeightTree[next]<=point.y)
 					{
-						break;
+						i=next;
+						y+=paragraphHeightTree[next];
 					}
 				}
+
+				if(i==count)
+				{
+					i=count-1;
+					y-=paragraphHeights[i]+paragraphDistance;
+				}
+				top=y;
+				index=i;
 				return true;
 			}
 
@@ -356,10 +475,12 @@ GuiDocumentElement::GuiDocumentElementRenderer
 					vint y1=clipper.Top()-bounds.Top();
 					vint y2=y1+clipper.Height();
 					vint y=0;
+					vint startIndex=0;
 
 					lastMaxWidth=maxWidth;
+					GetParagraphIndexFromPoint(Point(0, y1), y, startIndex);
 
-					for(vint i=0;i<paragraphHeights.Count();i++)
+					for(vint i=startIndex;i<paragraphHeights.Count();i++)
 					{
 						vint paragraphHeight=paragraphHeights[i];
 						if(y+paragraphHeight<=y1)
@@ -402,7 +523,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 
 							if (resized)
 							{
-								cache->graphicsParagraph = 0;
+								ReleaseParagraph(cache.Obj());
 							}
 						}
 
@@ -418,6 +539,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 
 			void GuiDocumentElement::GuiDocumentElementRenderer::OnElementStateChanged()
 			{
+				ReleaseAllParagraphs();
 				if (element->document && element->document->paragraphs.Count() > 0)
 				{
 					vint defaultSize = GetCurrentController()->ResourceService()->GetDefaultFont().size;
@@ -436,18 +558,14 @@ GuiDocumentElement::GuiDocumentElementRenderer
 						paragraphHeights[i] = defaultHeight;
 					}
 
-					cachedTotalHeight = paragraphHeights.Count() * (defaultHeight + paragraphDistance);
-					if (paragraphHeights.Count()>0)
-					{
-						cachedTotalHeight -= paragraphDistance;
-					}
+					BuildParagraphHeightTree();
 					minSize = Size(0, cachedTotalHeight);
 				}
 				else
 				{
 					paragraphCaches.Resize(0);
 					paragraphHeights.Resize(0);
-					cachedTotalHeight = 0;
+					BuildParagraphHeightTree();
 					minSize = Size(0, 0);
 				}
 
@@ -473,7 +591,13 @@ GuiDocumentElement::GuiDocumentElementRenderer
 					paragraphHeights.Resize(paragraphCount);
 
 					vint defaultHeight = GetCurrentController()->ResourceService()->GetDefaultFont().size;
-					cachedTotalHeight = 0;
+					for (vint i = 0; i < oldCount; i++)
+					{
+						if (auto cache = oldCaches[index + i])
+						{
+							ReleaseParagraph(cache.Obj());
+						}
+					}
 
 					for (vint i = 0; i < paragraphCount; i++)
 					{
@@ -488,12 +612,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 							paragraphHeights[i] = defaultHeight;
 							if (!updatedText && i < index + oldCount)
 							{
-								auto cache = oldCaches[i];
-								if(cache)
-								{
-									cache->graphicsParagraph = 0;
-								}
-								paragraphCaches[i] = cache;
+								paragraphCaches[i] = oldCaches[i];
 							}
 						}
 						else
@@ -501,12 +620,8 @@ GuiDocumentElement::GuiDocumentElementRenderer
 							paragraphCaches[i] = oldCaches[i - (newCount - oldCount)];
 							paragraphHeights[i] = oldHeights[i - (newCount - oldCount)];
 						}
-						cachedTotalHeight += paragraphHeights[i] + paragraphDistance;
-					}
-					if (paragraphCount > 0)
-					{
-						cachedTotalHeight -= paragraphDistance;
 					}
+					BuildParagraphHeightTree();
 
 					if (updatedText)
 					{
@@ -525,6 +640,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 							}
 						}
 					}
+					element->InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -744,13 +860,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 					Rect bounds=cache->graphicsParagraph->GetCaretBounds(caret.column, frontSide);
 					if(bounds!=Rect())
 					{
-						vint y=0;
-						for(vint i=0;i<caret.row;i++)
-						{
-							EnsureAndGetCache(i, true);
-							y+=paragraphHeights[i]+paragraphDistance;
-						}
-
+						vint y=GetParagraphTop(caret.row);
 						bounds.y1+=y;
 						bounds.y2+=y;
 						return bounds;
@@ -777,6 +887,7 @@ GuiDocumentElement
 					{
 						elementRenderer->CloseCaret(caretEnd);
 					}
+					InvokeOnCompositionStateChanged();
 				}
 			}
 
@@ -800,6 +911,16 @@ GuiDocumentElement
 				callback = value;
 			}
 
+			vint GuiDocumentElement::GetParagraphCacheSize()
+			{
+				return paragraphCacheSize;
+			}
+
+			void GuiDocumentElement::SetParagraphCacheSize(vint value)
+			{
+				paragraphCacheSize = value < 1 ? 1 : value;
+			}
+
 			Ptr<DocumentModel> GuiDocumentElement::GetDocument()
 			{
 				return document;
@@ -810,7 +931,7 @@ GuiDocumentElement
 				document=value;
 				if(renderer)
 				{
-					renderer->OnElementStateChanged();
+					InvokeOnElementStateChanged();
 					SetCaret(TextPos(), TextPos(), false);
 				}
 			}
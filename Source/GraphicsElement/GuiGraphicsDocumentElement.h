@@ -32,6 +32,8 @@ Rich Content Document (element)
 			{
 				DEFINE_GUI_GRAPHICS_ELEMENT(GuiDocumentElement, L"RichDocument");
 			public:
+				static const vint							DefaultParagraphCacheSize = 256;
+
 				/// <summary>Callback interface for this element.</summary>
 				class ICallback : public virtual IDescriptable, public Description<ICallback>
 				{
@@ -74,10 +76,14 @@ Rich Content Document (element)
 						IdEmbeddedObjectMap					embeddedObjects;
 						vint								selectionBegin;
 						vint								selectionEnd;
+						ParagraphCache*						previousUsed;		// caches with a graphicsParagraph are linked from the most recently used one
+						ParagraphCache*						nextUsed;
 
 						ParagraphCache()
 							:selectionBegin(-1)
 							,selectionEnd(-1)
+							,previousUsed(nullptr)
+							,nextUsed(nullptr)
 						{
 						}
 					};
@@ -95,6 +101,10 @@ Rich Content Document (element)
 					IGuiGraphicsLayoutProvider*				layoutProvider;
 					ParagraphCacheArray						paragraphCaches;
 					ParagraphHeightArray					paragraphHeights;
+					ParagraphHeightArray					paragraphHeightTree;		// binary indexed tree of paragraph heights plus paragraph distances
+					ParagraphCache*							firstUsedParagraph = nullptr;
+					ParagraphCache*							lastUsedParagraph = nullptr;
+					vint									usedParagraphCount = 0;
 
 					TextPos									lastCaret;
 					Color									lastCaretColor;
@@ -110,6 +120,12 @@ Rich Content Document (element)
 					void									InitializeInternal();
 					void									FinalizeInternal();
 					void									RenderTargetChangedInternal(IGuiGraphicsRenderTarget* oldRenderTarget, IGuiGraphicsRenderTarget* newRenderTarget);
+					void									BuildParagraphHeightTree();
+					void									SetParagraphHeight(vint paragraphIndex, vint height);
+					vint									GetParagraphTop(vint paragraphIndex);
+					void									TouchParagraph(ParagraphCache* cache);
+					void									ReleaseParagraph(ParagraphCache* cache);
+					void									ReleaseAllParagraphs();
 					Ptr<ParagraphCache>						EnsureAndGetCache(vint paragraphIndex, bool createParagraph);
 					bool									GetParagraphIndexFromPoint(Point point, vint& top, vint& index);
 				public:
@@ -131,6 +147,7 @@ Rich Content Document (element)
 			protected:
 				Ptr<DocumentModel>							document;
 				ICallback*									callback = nullptr;
+				vint										paragraphCacheSize = DefaultParagraphCacheSize;
 				TextPos										caretBegin;
 				TextPos										caretEnd;
 				bool										caretVisible;
@@ -149,6 +166,12 @@ Rich Content Document (element)
 				/// <summary>Set the callback.</summary>
 				/// <param name="value">The callback.</param>
 				void										SetCallback(ICallback* value);
+				/// <summary>Get the maximum number of paragraphs that keep their layout.</summary>
+				/// <returns>The maximum number of paragraphs that keep their layout.</returns>
+				vint										GetParagraphCacheSize();
+				/// <summary>Set the maximum number of paragraphs that keep their layout. When more paragraphs are laid out, layouts of least recently used paragraphs are released, and they will be laid out again when they are needed. The value should be larger than the number of paragraphs that are visible at the same time.</summary>
+				/// <param name="value">The maximum number of paragraphs that keep their layout. Values less than 1 are treated as 1.</param>
+				void										SetParagraphCacheSize(vint value);
 				
 				/// <summary>Get the document.</summary>
 				/// <returns>The document.</returns>
@@ -33,10 +33,7 @@ GuiSolidBorderElement
 				if(color!=value)
 				{
 					color=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 			
@@ -47,7 +44,11 @@ GuiSolidBorderElement
 
 			void GuiSolidBorderElement::SetShape(ElementShape value)
 			{
-				shape=value;
+				if(shape!=value)
+				{
+					shape=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 /***********************************************************************
@@ -75,10 +76,7 @@ GuiRoundBorderElement
 				if(color!=value)
 				{
 					color=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -92,10 +90,7 @@ GuiRoundBorderElement
 				if(radius!=value)
 				{
 					radius=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -138,10 +133,7 @@ Gui3DBorderElement
 				{
 					color1=value1;
 					color2=value2;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -185,10 +177,7 @@ Gui3DSplitterElement
 				{
 					color1=value1;
 					color2=value2;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -202,10 +191,7 @@ Gui3DSplitterElement
 				if(direction!=value)
 				{
 					direction=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -234,10 +220,7 @@ GuiSolidBackgroundElement
 				if(color!=value)
 				{
 					color=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 			
@@ -248,7 +231,11 @@ GuiSolidBackgroundElement
 
 			void GuiSolidBackgroundElement::SetShape(ElementShape value)
 			{
-				shape=value;
+				if(shape!=value)
+				{
+					shape=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 /***********************************************************************
@@ -292,10 +279,7 @@ GuiGradientBackgroundElement
 				{
 					color1=value1;
 					color2=value2;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -309,10 +293,7 @@ GuiGradientBackgroundElement
 				if(direction!=value)
 				{
 					direction=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 			
@@ -323,7 +304,11 @@ GuiGradientBackgroundElement
 
 			void GuiGradientBackgroundElement::SetShape(ElementShape value)
 			{
-				shape=value;
+				if(shape!=value)
+				{
+					shape=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 /***********************************************************************
@@ -358,10 +343,7 @@ GuiSolidLabelElement
 				if(color!=value)
 				{
 					color=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -375,10 +357,7 @@ GuiSolidLabelElement
 				if(fontProperties!=value)
 				{
 					fontProperties=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -392,10 +371,7 @@ GuiSolidLabelElement
 				if(text!=value)
 				{
 					text=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -425,10 +401,7 @@ GuiSolidLabelElement
 				{
 					hAlignment=horizontal;
 					vAlignment=vertical;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -442,10 +415,7 @@ GuiSolidLabelElement
 				if(wrapLine!=value)
 				{
 					wrapLine=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -459,10 +429,7 @@ GuiSolidLabelElement
 				if(ellipse!=value)
 				{
 					ellipse=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -476,10 +443,7 @@ GuiSolidLabelElement
 				if(multiline!=value)
 				{
 					multiline=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -493,10 +457,7 @@ GuiSolidLabelElement
 				if(wrapLineHeightCalculation!=value)
 				{
 					wrapLineHeightCalculation=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -552,10 +513,7 @@ GuiImageFrameElement
 						image=_image;
 						frameIndex=_frameIndex;
 					}
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -585,10 +543,7 @@ GuiImageFrameElement
 				{
 					hAlignment=horizontal;
 					vAlignment=vertical;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -602,10 +557,7 @@ GuiImageFrameElement
 				if(stretch!=value)
 				{
 					stretch=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -619,10 +571,7 @@ GuiImageFrameElement
 				if(enabled!=value)
 				{
 					enabled=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -648,10 +597,7 @@ GuiPolygonElement
 				if(size!=value)
 				{
 					size=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -672,10 +618,7 @@ GuiPolygonElement
 				{
 					memcpy(&points[0], p, sizeof(*p)*count);
 				}
-				if(renderer)
-				{
-					renderer->OnElementStateChanged();
-				}
+				InvokeOnElementStateChanged();
 			}
 
 			const GuiPolygonElement::PointArray& GuiPolygonElement::GetPointsArray()
@@ -686,6 +629,7 @@ GuiPolygonElement
 			void GuiPolygonElement::SetPointsArray(const PointArray& value)
 			{
 				CopyFrom(points, value);
+				InvokeOnElementStateChanged();
 			}
 
 			Color GuiPolygonElement::GetBorderColor()
@@ -698,10 +642,7 @@ GuiPolygonElement
 				if(borderColor!=value)
 				{
 					borderColor=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -715,10 +656,7 @@ GuiPolygonElement
 				if(backgroundColor!=value)
 				{
 					backgroundColor=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 		}
@@ -17,6 +17,15 @@ namespace vl
 	{
 		using namespace reflection;
 
+		namespace compositions
+		{
+			class GuiGraphicsComposition;
+
+			/// <summary>Notify a composition that its visual state is changed, so that the related graphics host will render it again.</summary>
+			/// <param name="composition">The composition.</param>
+			extern void									InvokeOnCompositionStateChanged(GuiGraphicsComposition* composition);
+		}
+
 		namespace elements
 		{
 			class IGuiGraphicsElement;
@@ -47,6 +56,20 @@ Basic Construction
 				/// </summary>
 				/// <returns>Returns the related renderer.</returns>
 				virtual IGuiGraphicsRenderer*			GetRenderer()=0;
+				/// <summary>
+				/// Get the composition that contains this graphics element.
+				/// A graphics host only renders again when a composition or an element notifies a change, an element uses its owner composition to notify.
+				/// Elements defined with DEFINE_GUI_GRAPHICS_ELEMENT implement this function.
+				/// The default implementation returns null, the graphics host of such an element is not notified, call [M:vl.presentation.compositions.GuiGraphicsHost.RequestRender] after changing it.
+				/// </summary>
+				/// <returns>Returns the owner composition.</returns>
+				virtual compositions::GuiGraphicsComposition*	GetOwnerComposition();
+				/// <summary>
+				/// Set the composition that contains this graphics element. This function is designed for internal usage. Users are not suggested to call this function directly.
+				/// The default implementation does nothing.
+				/// </summary>
+				/// <param name="composition">The owner composition.</param>
+				virtual void							SetOwnerComposition(compositions::GuiGraphicsComposition* composition);
 			};
 
 			/// <summary>
@@ -551,10 +551,22 @@ GuiGraphicsHost
 				{
 					previousClientSize=size;
 					minSize=windowComposition->GetPreferredBounds().GetSize();
+					RequestRender();
 					Render();
 				}
 			}
 
+			void GuiGraphicsHost::Opened()
+			{
+				RequestRender();
+			}
+
+			void GuiGraphicsHost::Paint()
+			{
+				// the operating system asks the window to paint when the content is lost, like a window that was covered
+				RequestRender();
+			}
+
 			void GuiGraphicsHost::LeftButtonDown(const NativeWindowMouseInfo& info)
 			{
 				CloseAltHost();
@@ -629,9 +641,15 @@ GuiGraphicsHost
 					GuiGraphicsComposition* composition=windowComposition->FindComposition(Point(info.x, info.y));
 					while(composition)
 					{
-						newCompositions.Insert(0, composition);
+						newCompositions.Add(composition);
 						composition=composition->GetParent();
 					}
+					for(vint i=0, j=newCompositions.Count()-1;i<j;i++, j--)
+					{
+						GuiGraphicsComposition* temp=newCompositions[i];
+						newCompositions.Set(i, newCompositions[j]);
+						newCompositions.Set(j, temp);
+					}
 				}
 
 				vint firstDifferentIndex=mouseEnterCompositions.Count();
@@ -833,7 +851,10 @@ GuiGraphicsHost
 					}
 				}
 				
-				Render();
+				if(needToRender)
+				{
+					Render();
+				}
 			}
 
 			GuiGraphicsHost::GuiGraphicsHost()
@@ -843,6 +864,7 @@ GuiGraphicsHost
 				,focusedComposition(0)
 				,mouseCaptureComposition(0)
 				,lastCaretTime(0)
+				,needToRender(true)
 				,currentAltHost(0)
 				,supressAltKey(0)
 			{
@@ -885,6 +907,7 @@ GuiGraphicsHost
 						minSize=windowComposition->GetPreferredBounds().GetSize();
 						nativeWindow->SetCaretPoint(caretPoint);
 					}
+					RequestRender();
 				}
 			}
 
@@ -897,6 +920,7 @@ GuiGraphicsHost
 			{
 				if(nativeWindow && nativeWindow->IsVisible())
 				{
+					needToRender=false;
 					windowComposition->GetRenderTarget()->StartRendering();
 					windowComposition->Render(Size());
 					bool success = windowComposition->GetRenderTarget()->StopRendering();
@@ -907,10 +931,16 @@ GuiGraphicsHost
 						windowComposition->SetAttachedWindow(0);
 						GetGuiGraphicsResourceManager()->RecreateRenderTarget(nativeWindow);
 						windowComposition->SetAttachedWindow(nativeWindow);
+						needToRender=true;
 					}
 				}
 			}
 
+			void GuiGraphicsHost::RequestRender()
+			{
+				needToRender=true;
+			}
+
 			IGuiShortcutKeyManager* GuiGraphicsHost::GetShortcutKeyManager()
 			{
 				return shortcutKeyManager;
@@ -180,6 +180,7 @@ Host
 				Size									minSize;
 				Point									caretPoint;
 				vuint64_t								lastCaretTime;
+				bool									needToRender;
 
 				GuiGraphicsAnimationManager				animationManager;
 				GuiGraphicsComposition*					mouseCaptureComposition;
@@ -212,6 +213,8 @@ Host
 				INativeWindowListener::HitTestResult	HitTest(Point location)override;
 				void									Moving(Rect& bounds, bool fixSizeOnly)override;
 				void									Moved()override;
+				void									Opened()override;
+				void									Paint()override;
 
 				void									LeftButtonDown(const NativeWindowMouseInfo& info)override;
 				void									LeftButtonUp(const NativeWindowMouseInfo& info)override;
@@ -250,6 +253,8 @@ Host
 				GuiGraphicsComposition*					GetMainComposition();
 				/// <summary>Render the main composition and all content to the associated window.</summary>
 				void									Render();
+				/// <summary>Request the main composition to be rendered in the next global timer tick. Frames are skipped until a composition or an element in this graphics host is changed, call this function when the content is changed without notifying the composition tree, like drawing in a user-defined element.</summary>
+				void									RequestRender();
 
 				/// <summary>Get the <see cref="IGuiShortcutKeyManager"/> attached with this graphics host.</summary>
 				/// <returns>The shortcut key manager.</returns>
@@ -8,6 +8,19 @@ namespace vl
 		{
 			using namespace collections;
 
+/***********************************************************************
+IGuiGraphicsElement
+***********************************************************************/
+
+			compositions::GuiGraphicsComposition* IGuiGraphicsElement::GetOwnerComposition()
+			{
+				return 0;
+			}
+
+			void IGuiGraphicsElement::SetOwnerComposition(compositions::GuiGraphicsComposition* composition)
+			{
+			}
+
 /***********************************************************************
 GuiGraphicsResourceManager
 ***********************************************************************/
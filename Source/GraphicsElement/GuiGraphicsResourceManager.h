@@ -119,6 +119,7 @@ Helpers
 					{\
 						TELEMENT* element=new TELEMENT;\
 						element->factory=this;\
+						element->ownerComposition=0;\
 						IGuiGraphicsRendererFactory* rendererFactory=GetGuiGraphicsResourceManager()->GetRendererFactory(GetElementTypeName());\
 						if(rendererFactory)\
 						{\
@@ -131,6 +132,7 @@ Helpers
 			protected:\
 				IGuiGraphicsElementFactory*		factory;\
 				Ptr<IGuiGraphicsRenderer>		renderer;\
+				compositions::GuiGraphicsComposition*	ownerComposition;\
 			public:\
 				static WString GetElementTypeName()\
 				{\
@@ -148,6 +150,29 @@ Helpers
 				{\
 					return renderer.Obj();\
 				}\
+				compositions::GuiGraphicsComposition* GetOwnerComposition()override\
+				{\
+					return ownerComposition;\
+				}\
+				void SetOwnerComposition(compositions::GuiGraphicsComposition* composition)override\
+				{\
+					ownerComposition=composition;\
+				}\
+				void InvokeOnCompositionStateChanged()\
+				{\
+					if(ownerComposition)\
+					{\
+						compositions::InvokeOnCompositionStateChanged(ownerComposition);\
+					}\
+				}\
+				void InvokeOnElementStateChanged()\
+				{\
+					if(renderer)\
+					{\
+						renderer->OnElementStateChanged();\
+					}\
+					InvokeOnCompositionStateChanged();\
+				}\
 
 #define DEFINE_GUI_GRAPHICS_RENDERER(TELEMENT, TRENDERER, TTARGET)\
 			public:\
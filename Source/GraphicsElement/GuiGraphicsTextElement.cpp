@@ -178,33 +178,219 @@ text::CharMeasurer
 text::TextLines
 ***********************************************************************/
 
+				vint TextLines::LocateBlock(vint row)
+				{
+					if(lastBlock<blocks.Count())
+					{
+						if(blockStarts[lastBlock]<=row && row<blockStarts[lastBlock]+blocks[lastBlock]->lines.Count())
+						{
+							return lastBlock;
+						}
+						vint next=lastBlock+1;
+						if(next<blocks.Count() && blockStarts[next]<=row && row<blockStarts[next]+blocks[next]->lines.Count())
+						{
+							return lastBlock=next;
+						}
+					}
+
+					vint start=0;
+					vint end=blocks.Count()-1;
+					while(start<end)
+					{
+						vint middle=(start+end+1)/2;
+						if(blockStarts[middle]<=row)
+						{
+							start=middle;
+						}
+						else
+						{
+							end=middle-1;
+						}
+					}
+					return lastBlock=start;
+				}
+
+				void TextLines::InvalidateRowWidths(vint start, vint end)
+				{
+					vint firstBlock=LocateBlock(start);
+					vint endBlock=LocateBlock(end);
+					for(vint i=firstBlock;i<=endBlock;i++)
+					{
+						blocks[i]->widthDirty=true;
+					}
+				}
+
+				vint TextLines::EstimateCharWidth()
+				{
+					vint width=1;
+					if(measuredCharCount>0)
+					{
+						width=(measuredCharWidth+measuredCharCount/2)/measuredCharCount;
+					}
+					else if(charMeasurer)
+					{
+						width=charMeasurer->MeasureWidth(L' ');
+					}
+					return width<1?1:width;
+				}
+
+				void TextLines::UpdateBlockStarts()
+				{
+					blockStarts.Clear();
+					lineCount=0;
+					for(vint i=0;i<blocks.Count();i++)
+					{
+						blockStarts.Add(lineCount);
+						lineCount+=blocks[i]->lines.Count();
+					}
+					lastBlock=0;
+				}
+
+				void TextLines::InsertLines(vint row, vint count)
+				{
+					if(count<=0) return;
+					if(blocks.Count()==0)
+					{
+						blocks.Add(new TextLineBlock);
+						UpdateBlockStarts();
+					}
+
+					vint blockIndex=row==lineCount?blocks.Count()-1:LocateBlock(row);
+					vint offset=row-blockStarts[blockIndex];
+					Ptr<TextLineBlock> block=blocks[blockIndex];
+					if(block->lines.Count()+count<=MaxLinesPerBlock)
+					{
+						block->widthDirty=true;
+						for(vint i=0;i<count;i++)
+						{
+							block->lines.Insert(offset, TextLine());
+						}
+					}
+					else
+					{
+						// the block is too large after inserting, so it is replaced by new blocks
+						TextLineBlockList newBlocks;
+						Ptr<TextLineBlock> current=new TextLineBlock;
+						auto add=[&](const TextLine& line)
+						{
+							if(current->lines.Count()==LinesPerBlock)
+							{
+								newBlocks.Add(current);
+								current=new TextLineBlock;
+							}
+							current->lines.Add(line);
+						};
+
+						for(vint i=0;i<offset;i++)
+						{
+							add(block->lines.Get(i));
+						}
+						for(vint i=0;i<count;i++)
+						{
+							add(TextLine());
+						}
+						for(vint i=offset;i<block->lines.Count();i++)
+						{
+							add(block->lines.Get(i));
+						}
+						newBlocks.Add(current);
+
+						TextLineBlockList oldBlocks;
+						CopyFrom(oldBlocks, blocks);
+						blocks.Clear();
+						for(vint i=0;i<blockIndex;i++)
+						{
+							blocks.Add(oldBlocks[i]);
+						}
+						for(vint i=0;i<newBlocks.Count();i++)
+						{
+							blocks.Add(newBlocks[i]);
+						}
+						for(vint i=blockIndex+1;i<oldBlocks.Count();i++)
+						{
+							blocks.Add(oldBlocks[i]);
+						}
+					}
+					UpdateBlockStarts();
+				}
+
+				void TextLines::RemoveLineRange(vint row, vint count)
+				{
+					if(count<=0) return;
+					vint firstBlock=LocateBlock(row);
+					vint firstOffset=row-blockStarts[firstBlock];
+					vint endBlock=LocateBlock(row+count-1);
+					vint endOffset=row+count-blockStarts[endBlock];
+
+					blocks[firstBlock]->widthDirty=true;
+					if(firstBlock==endBlock)
+					{
+						blocks[firstBlock]->lines.RemoveRange(firstOffset, count);
+					}
+					else
+					{
+						blocks[firstBlock]->lines.RemoveRange(firstOffset, blocks[firstBlock]->lines.Count()-firstOffset);
+						blocks[endBlock]->lines.RemoveRange(0, endOffset);
+						blocks[endBlock]->widthDirty=true;
+						if(endBlock-firstBlock>1)
+						{
+							blocks.RemoveRange(firstBlock+1, endBlock-firstBlock-1);
+						}
+
+						// merge the two blocks at both sides of the removed range if they are small enough
+						auto first=blocks[firstBlock];
+						auto second=blocks[firstBlock+1];
+						if(first->lines.Count()+second->lines.Count()<=LinesPerBlock)
+						{
+							for(vint i=0;i<second->lines.Count();i++)
+							{
+								first->lines.Add(second->lines.Get(i));
+							}
+							blocks.RemoveAt(firstBlock+1);
+						}
+					}
+
+					for(vint i=firstBlock+1;i>=firstBlock;i--)
+					{
+						if(i<blocks.Count() && blocks[i]->lines.Count()==0)
+						{
+							blocks.RemoveAt(i);
+						}
+					}
+					UpdateBlockStarts();
+				}
+
 				TextLines::TextLines()
-					:charMeasurer(0)
+					:lineCount(0)
+					,lastBlock(0)
+					,charMeasurer(0)
 					,renderTarget(0)
 					,tabWidth(1)
 					,tabSpaceCount(4)
 					,passwordChar(L'\0')
+					,measuredCharCount(0)
+					,measuredCharWidth(0)
 				{
-					TextLine line;
-					line.Initialize();
-					lines.Add(line);
+					InsertLines(0, 1);
+					GetLine(0).Initialize();
 				}
 
 				TextLines::~TextLines()
 				{
-					RemoveLines(0, lines.Count());
+					RemoveLines(0, lineCount);
 				}
 
 				//--------------------------------------------------------
 
 				vint TextLines::GetCount()
 				{
-					return lines.Count();
+					return lineCount;
 				}
 
 				TextLine& TextLines::GetLine(vint row)
 				{
-					return lines[row];
+					vint blockIndex=LocateBlock(row);
+					return blocks[blockIndex]->lines[row-blockStarts[blockIndex]];
 				}
 
 				CharMeasurer* TextLines::GetCharMeasurer()
@@ -237,15 +423,15 @@ text::TextLines
 
 					if(start.row==end.row)
 					{
-						return WString(lines[start.row].text+start.column, end.column-start.column);
+						return WString(GetLine(start.row).text+start.column, end.column-start.column);
 					}
 
 					vint count=0;
 					for(vint i=start.row+1;i<end.row;i++)
 					{
-						count+=lines[i].dataLength;
+						count+=GetLine(i).dataLength;
 					}
-					count+=lines[start.row].dataLength-start.column;
+					count+=GetLine(start.row).dataLength-start.column;
 					count+=end.column;
 
 					Array<wchar_t> buffer;
@@ -254,12 +440,12 @@ text::TextLines
 
 					for(vint i=start.row;i<=end.row;i++)
 					{
-						wchar_t* text=lines[i].text;
+						wchar_t* text=GetLine(i).text;
 						vint chars=0;
 						if(i==start.row)
 						{
 							text+=start.column;
-							chars=lines[i].dataLength-start.column;
+							chars=GetLine(i).dataLength-start.column;
 						}
 						else if(i==end.row)
 						{
@@ -267,7 +453,7 @@ text::TextLines
 						}
 						else
 						{
-							chars=lines[i].dataLength;
+							chars=GetLine(i).dataLength;
 						}
 
 						if(i!=start.row)
@@ -283,30 +469,30 @@ text::TextLines
 
 				WString TextLines::GetText()
 				{
-					return GetText(TextPos(0, 0), TextPos(lines.Count()-1, lines[lines.Count()-1].dataLength));
+					return GetText(TextPos(0, 0), TextPos(lineCount-1, GetLine(lineCount-1).dataLength));
 				}
 
 				void TextLines::SetText(const WString& value)
 				{
-					Modify(TextPos(0, 0), TextPos(lines.Count()-1, lines[lines.Count()-1].dataLength), value);
+					Modify(TextPos(0, 0), TextPos(lineCount-1, GetLine(lineCount-1).dataLength), value);
 				}
 
 				//--------------------------------------------------------
 
 				bool TextLines::RemoveLines(vint start, vint count)
 				{
-					if(start<0 || count<0 || start+count>lines.Count()) return false;
-					for(vint i=start+count-1;i>=start;i--)
+					if(start<0 || count<0 || start+count>lineCount) return false;
+					for(vint i=start;i<start+count;i++)
 					{
-						lines[i].Finalize();
+						GetLine(i).Finalize();
 					}
-					lines.RemoveRange(start, count);
+					RemoveLineRange(start, count);
 					return true;
 				}
 
 				bool TextLines::IsAvailable(TextPos pos)
 				{
-					return 0<=pos.row && pos.row<lines.Count() && 0<=pos.column && pos.column<=lines[pos.row].dataLength;
+					return 0<=pos.row && pos.row<lineCount && 0<=pos.column && pos.column<=GetLine(pos.row).dataLength;
 				}
 
 				TextPos TextLines::Normalize(TextPos pos)
@@ -315,13 +501,13 @@ text::TextLines
 					{
 						return TextPos(0, 0);
 					}
-					else if(pos.row>=lines.Count())
+					else if(pos.row>=lineCount)
 					{
-						return TextPos(lines.Count()-1, lines[lines.Count()-1].dataLength);
+						return TextPos(lineCount-1, GetLine(lineCount-1).dataLength);
 					}
 					else
 					{
-						TextLine& line=lines[pos.row];
+						TextLine& line=GetLine(pos.row);
 						if(pos.column<0)
 						{
 							return TextPos(pos.row, 0);
@@ -340,12 +526,13 @@ text::TextLines
 				TextPos TextLines::Modify(TextPos start, TextPos end, const wchar_t** inputs, vint* inputCounts, vint rows)
 				{
 					if(!IsAvailable(start) || !IsAvailable(end) || start>end) return TextPos(-1, -1);
+					InvalidateRowWidths(start.row, end.row);
 
 					if(rows==1)
 					{
 						if(start.row==end.row)
 						{
-							lines[start.row].Modify(start.column, end.column-start.column, inputs[0], inputCounts[0]);
+							GetLine(start.row).Modify(start.column, end.column-start.column, inputs[0], inputCounts[0]);
 						}
 						else
 						{
@@ -353,18 +540,19 @@ text::TextLines
 							{
 								RemoveLines(start.row+1, end.row-start.row-1);
 							}
-							vint modifyCount=lines[start.row].dataLength-start.column+end.column;
-							lines[start.row].AppendAndFinalize(lines[start.row+1]);
-							lines.RemoveAt(start.row+1);
-							lines[start.row].Modify(start.column, modifyCount, inputs[0], inputCounts[0]);
+							vint modifyCount=GetLine(start.row).dataLength-start.column+end.column;
+							GetLine(start.row).AppendAndFinalize(GetLine(start.row+1));
+							RemoveLineRange(start.row+1, 1);
+							GetLine(start.row).Modify(start.column, modifyCount, inputs[0], inputCounts[0]);
 						}
 						return TextPos(start.row, start.column+inputCounts[0]);
 					}
 
 					if(start.row==end.row)
 					{
-						TextLine newLine=lines[start.row].Split(end.column);
-						lines.Insert(start.row+1, newLine);
+						TextLine newLine=GetLine(start.row).Split(end.column);
+						InsertLines(start.row+1, 1);
+						GetLine(start.row+1)=newLine;
 						end=TextPos(start.row+1, 0);
 					}
 
@@ -372,11 +560,10 @@ text::TextLines
 					vint newMiddleLines=rows-2;
 					if(oldMiddleLines<newMiddleLines)
 					{
+						InsertLines(end.row, newMiddleLines-oldMiddleLines);
 						for(vint i=oldMiddleLines;i<newMiddleLines;i++)
 						{
-							TextLine line;
-							line.Initialize();
-							lines.Insert(end.row, line);
+							GetLine(end.row+i-oldMiddleLines).Initialize();
 						}
 					}
 					else if(oldMiddleLines>newMiddleLines)
@@ -385,12 +572,13 @@ text::TextLines
 					}
 					end.row+=newMiddleLines-oldMiddleLines;
 
-					lines[start.row].Modify(start.column, lines[start.row].dataLength-start.column, inputs[0], inputCounts[0]);
-					lines[end.row].Modify(0, end.column, inputs[rows-1], inputCounts[rows-1]);
+					GetLine(start.row).Modify(start.column, GetLine(start.row).dataLength-start.column, inputs[0], inputCounts[0]);
+					GetLine(end.row).Modify(0, end.column, inputs[rows-1], inputCounts[rows-1]);
 					for(vint i=1;i<rows-1;i++)
 					{
-						lines[start.row+i].Modify(0, lines[start.row+i].dataLength, inputs[i], inputCounts[i]);
+						GetLine(start.row+i).Modify(0, GetLine(start.row+i).dataLength, inputs[i], inputCounts[i]);
 					}
+					InvalidateRowWidths(start.row, end.row);
 					return TextPos(end.row, inputCounts[rows-1]);
 				}
 
@@ -437,20 +625,25 @@ text::TextLines
 
 				void TextLines::Clear()
 				{
-					RemoveLines(0, lines.Count());
-					TextLine line;
-					line.Initialize();
-					lines.Add(line);
+					RemoveLines(0, lineCount);
+					InsertLines(0, 1);
+					GetLine(0).Initialize();
 				}
 
 				//--------------------------------------------------------
 
 				void TextLines::ClearMeasurement()
 				{
-					for(vint i=0;i<lines.Count();i++)
+					for(vint i=0;i<lineCount;i++)
 					{
-						lines[i].availableOffsetCount=0;
+						GetLine(i).availableOffsetCount=0;
 					}
+					for(vint i=0;i<blocks.Count();i++)
+					{
+						blocks[i]->widthDirty=true;
+					}
+					measuredCharCount=0;
+					measuredCharWidth=0;
 					if(charMeasurer)
 					{
 						tabWidth=tabSpaceCount*charMeasurer->MeasureWidth(L' ');
@@ -478,12 +671,15 @@ text::TextLines
 
 				void TextLines::MeasureRow(vint row)
 				{
-					TextLine& line=lines[row];
+					TextLine& line=GetLine(row);
+					if(line.availableOffsetCount==line.dataLength) return;
 					vint offset=0;
 					if(line.availableOffsetCount)
 					{
 						offset=line.att[line.availableOffsetCount-1].rightOffset;
 					}
+					measuredCharCount+=line.dataLength-line.availableOffsetCount;
+					measuredCharWidth-=offset;
 					for(vint i=line.availableOffsetCount;i<line.dataLength;i++)
 					{
 						CharAtt& att=line.att[i];
@@ -505,12 +701,14 @@ text::TextLines
 						att.rightOffset=(int)offset;
 					}
 					line.availableOffsetCount=line.dataLength;
+					measuredCharWidth+=offset;
+					blocks[LocateBlock(row)]->widthDirty=true;
 				}
 
 				vint TextLines::GetRowWidth(vint row)
 				{
-					if(row<0 || row>=lines.Count()) return -1;
-					TextLine& line=lines[row];
+					if(row<0 || row>=lineCount) return -1;
+					TextLine& line=GetLine(row);
 					if(line.dataLength==0)
 					{
 						return 0;
@@ -529,21 +727,42 @@ text::TextLines
 
 				vint TextLines::GetMaxWidth()
 				{
+					vint charWidth=EstimateCharWidth();
 					vint width=0;
-					for(vint i=0;i<lines.Count();i++)
+					for(vint i=0;i<blocks.Count();i++)
 					{
-						vint rowWidth=GetRowWidth(i);
-						if(width<rowWidth)
+						TextLineBlock* block=blocks[i].Obj();
+						if(block->widthDirty)
 						{
-							width=rowWidth;
+							// only rows in modified blocks are visited, and characters are never measured here
+							block->measuredWidth=0;
+							block->unmeasuredLength=0;
+							for(vint j=0;j<block->lines.Count();j++)
+							{
+								TextLine& line=block->lines[j];
+								if(line.availableOffsetCount==line.dataLength)
+								{
+									vint rowWidth=line.dataLength==0?0:line.att[line.dataLength-1].rightOffset;
+									if(block->measuredWidth<rowWidth) block->measuredWidth=rowWidth;
+								}
+								else if(block->unmeasuredLength<line.dataLength)
+								{
+									block->unmeasuredLength=line.dataLength;
+								}
+							}
+							block->widthDirty=false;
 						}
+
+						vint blockWidth=block->unmeasuredLength*charWidth;
+						if(blockWidth<block->measuredWidth) blockWidth=block->measuredWidth;
+						if(width<blockWidth) width=blockWidth;
 					}
 					return width;
 				}
 
 				vint TextLines::GetMaxHeight()
 				{
-					return lines.Count()*charMeasurer->GetRowHeight();
+					return lineCount*charMeasurer->GetRowHeight();
 				}
 
 				TextPos TextLines::GetTextPosFromPoint(Point point)
@@ -553,9 +772,9 @@ text::TextLines
 					{
 						point.y=0;
 					}
-					else if(point.y>=h*lines.Count())
+					else if(point.y>=h*lineCount)
 					{
-						point.y=h*lines.Count()-1;
+						point.y=h*lineCount-1;
 					}
 
 					vint row=point.y/h;
@@ -565,9 +784,9 @@ text::TextLines
 					}
 					else if(point.x>=GetRowWidth(row))
 					{
-						return TextPos(row, lines[row].dataLength);
+						return TextPos(row, GetLine(row).dataLength);
 					}
-					TextLine& line=lines[row];
+					TextLine& line=GetLine(row);
 
 					vint i1=0, i2=line.dataLength;
 					vint p1=0, p2=line.att[line.dataLength-1].rightOffset;
@@ -601,7 +820,7 @@ text::TextLines
 						else
 						{
 							MeasureRow(pos.row);
-							TextLine& line=lines[pos.row];
+							TextLine& line=GetLine(pos.row);
 							return Point(line.att[pos.column-1].rightOffset, y);
 						}
 					}
@@ -621,7 +840,7 @@ text::TextLines
 					else
 					{
 						vint h=charMeasurer->GetRowHeight();
-						TextLine& line=lines[pos.row];
+						TextLine& line=GetLine(pos.row);
 						if(pos.column==line.dataLength)
 						{
 							return Rect(point, Size(h/2, h));
@@ -645,6 +864,82 @@ text::TextLines
 					passwordChar=value;
 					ClearMeasurement();
 				}
+
+				void TextLines::BuildRuns(Rect viewBounds, TextPos selectionBegin, TextPos selectionEnd, vint colorCount, collections::List<TextRun>& runs)
+				{
+					runs.Clear();
+					vint h=GetRowHeight();
+					vint startRow=GetTextPosFromPoint(Point(viewBounds.x1, viewBounds.y1)).row;
+					vint endRow=GetTextPosFromPoint(Point(viewBounds.x2, viewBounds.y2)).row;
+
+					for(vint row=startRow;row<=endRow;row++)
+					{
+						vint y=row*h;
+						vint startColumn=GetTextPosFromPoint(Point(viewBounds.x1, y)).column;
+						vint endColumn=GetTextPosFromPoint(Point(viewBounds.x2, y)).column;
+						TextLine& line=GetLine(row);
+
+						// columns in [selectionStart, selectionStop) are selected, the line break is at column dataLength
+						vint selectionStart=0;
+						vint selectionStop=0;
+						if(selectionBegin.row<=row && row<=selectionEnd.row)
+						{
+							selectionStart=row==selectionBegin.row?selectionBegin.column:0;
+							selectionStop=row==selectionEnd.row?selectionEnd.column:line.dataLength+1;
+						}
+
+						vint column=startColumn;
+						vint x=column==0?0:line.att[column-1].rightOffset;
+						while(column<=endColumn)
+						{
+							TextRun run;
+							run.row=row;
+							run.startColumn=column;
+							run.x1=x;
+							run.inSelection=selectionStart<=column && column<selectionStop;
+
+							if(column==line.dataLength)
+							{
+								run.endColumn=column+1;
+								run.x2=x+h/2;
+								run.colorIndex=0;
+								run.lineBreak=true;
+							}
+							else
+							{
+								vint limit=endColumn<line.dataLength?endColumn+1:line.dataLength;
+								if(run.inSelection)
+								{
+									if(limit>selectionStop) limit=selectionStop;
+								}
+								else if(column<selectionStart && limit>selectionStart)
+								{
+									limit=selectionStart;
+								}
+
+								vint colorIndex=line.att[column].colorIndex;
+								run.colorIndex=colorIndex<colorCount?colorIndex:0;
+								run.endColumn=column+1;
+								if(line.text[column]!=L'\t')
+								{
+									while(run.endColumn<limit)
+									{
+										vint nextColorIndex=line.att[run.endColumn].colorIndex;
+										if(nextColorIndex>=colorCount) nextColorIndex=0;
+										if(nextColorIndex!=run.colorIndex || line.text[run.endColumn]==L'\t') break;
+										run.endColumn++;
+									}
+								}
+								run.x2=line.att[run.endColumn-1].rightOffset;
+								run.lineBreak=false;
+							}
+
+							runs.Add(run);
+							column=run.endColumn;
+							x=run.x2;
+						}
+					}
+				}
 			}
 
 			using namespace text;
@@ -694,10 +989,7 @@ GuiColorizedTextElement
 			{
 				CopyFrom(colors, value);
 				if(callback) callback->ColorChanged();
-				if(renderer)
-				{
-					renderer->OnElementStateChanged();
-				}
+				InvokeOnElementStateChanged();
 			}
 
 			void GuiColorizedTextElement::ResetTextColorIndex(vint index)
@@ -729,10 +1021,7 @@ GuiColorizedTextElement
 					{
 						callback->FontChanged();
 					}
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -746,10 +1035,7 @@ GuiColorizedTextElement
 				if(lines.GetPasswordChar()!=value)
 				{
 					lines.SetPasswordChar(value);
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -763,10 +1049,7 @@ GuiColorizedTextElement
 				if(viewPosition!=value)
 				{
 					viewPosition=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -780,10 +1063,7 @@ GuiColorizedTextElement
 				if(isVisuallyEnabled!=value)
 				{
 					isVisuallyEnabled=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -797,10 +1077,7 @@ GuiColorizedTextElement
 				if(isFocused!=value)
 				{
 					isFocused=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
 
@@ -811,7 +1088,11 @@ GuiColorizedTextElement
 
 			void GuiColorizedTextElement::SetCaretBegin(TextPos value)
 			{
-				caretBegin=value;
+				if(caretBegin!=value)
+				{
+					caretBegin=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			TextPos GuiColorizedTextElement::GetCaretEnd()
@@ -821,7 +1102,11 @@ GuiColorizedTextElement
 
 			void GuiColorizedTextElement::SetCaretEnd(TextPos value)
 			{
-				caretEnd=value;
+				if(caretEnd!=value)
+				{
+					caretEnd=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			bool GuiColorizedTextElement::GetCaretVisible()
@@ -831,7 +1116,11 @@ GuiColorizedTextElement
 
 			void GuiColorizedTextElement::SetCaretVisible(bool value)
 			{
-				caretVisible=value;
+				if(caretVisible!=value)
+				{
+					caretVisible=value;
+					InvokeOnCompositionStateChanged();
+				}
 			}
 
 			Color GuiColorizedTextElement::GetCaretColor()
@@ -844,12 +1133,16 @@ GuiColorizedTextElement
 				if(caretColor!=value)
 				{
 					caretColor=value;
-					if(renderer)
-					{
-						renderer->OnElementStateChanged();
-					}
+					InvokeOnElementStateChanged();
 				}
 			}
+
+			void GuiColorizedTextElement::BuildTextRuns(Size viewSize, collections::List<text::TextRun>& runs)
+			{
+				TextPos selectionBegin=caretBegin<caretEnd?caretBegin:caretEnd;
+				TextPos selectionEnd=caretBegin>caretEnd?caretBegin:caretEnd;
+				lines.BuildRuns(Rect(viewPosition, viewSize), selectionBegin, selectionEnd, colors.Count(), runs);
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -118,6 +118,48 @@ Colorized Plain Text (model)
 					void							AppendAndFinalize(TextLine& line);
 				};
 
+				/// <summary>
+				/// Represents continuous characters in a row that share the same color index and selection state. Use [M:vl.presentation.elements.text.TextLines.BuildRuns] to build runs for the visible area.
+				/// </summary>
+				struct TextRun
+				{
+					/// <summary>
+					/// The row number.
+					/// </summary>
+					vint							row;
+					/// <summary>
+					/// The column of the first character.
+					/// </summary>
+					vint							startColumn;
+					/// <summary>
+					/// The column after the last character. For a line break run, it is the column of the line break plus 1.
+					/// </summary>
+					vint							endColumn;
+					/// <summary>
+					/// The distance from the head of the line to the left side of the first character in pixel.
+					/// </summary>
+					vint							x1;
+					/// <summary>
+					/// The distance from the head of the line to the right side of the last character in pixel.
+					/// </summary>
+					vint							x2;
+					/// <summary>
+					/// The color index of all characters, which is always a valid index in the color table, or 0 when the color table is empty.
+					/// </summary>
+					vint							colorIndex;
+					/// <summary>
+					/// True if all characters are selected.
+					/// </summary>
+					bool							inSelection;
+					/// <summary>
+					/// True if this run represents the line break after the last character of the row, which has no text to draw.
+					/// </summary>
+					bool							lineBreak;
+
+					bool							operator==(const TextRun& value)const{return false;}
+					bool							operator!=(const TextRun& value)const{return true;}
+				};
+
 				/// <summary>
 				/// An abstract class for character size measuring in differect rendering technology.
 				/// </summary>
@@ -173,14 +215,38 @@ Colorized Plain Text (model)
 				/// </summary>
 				class TextLines : public Object, public Description<TextLines>
 				{
-					typedef collections::List<TextLine>		TextLineList;
+					typedef collections::List<TextLine>				TextLineList;
+
+					struct TextLineBlock
+					{
+						TextLineList				lines;
+						bool						widthDirty = true;		// measuredWidth and unmeasuredLength need to be calculated again
+						vint						measuredWidth = 0;		// the maximum width of all measured lines
+						vint						unmeasuredLength = 0;	// the maximum number of characters of all lines that are not completely measured
+					};
+					typedef collections::List<Ptr<TextLineBlock>>	TextLineBlockList;
 				protected:
-					TextLineList					lines;
+					static const vint				LinesPerBlock=256;
+					static const vint				MaxLinesPerBlock=512;
+
+					TextLineBlockList				blocks;				// lines are stored in blocks, inserting or removing lines only moves lines in affected blocks
+					collections::List<vint>			blockStarts;		// block -> row number of the first line in the block
+					vint							lineCount;
+					vint							lastBlock;			// the block found by the last LocateBlock, to make sequential accesses cheap
 					CharMeasurer*					charMeasurer;
 					IGuiGraphicsRenderTarget*		renderTarget;
 					vint							tabWidth;
 					vint							tabSpaceCount;
 					wchar_t							passwordChar;
+					vint							measuredCharCount;
+					vint							measuredCharWidth;
+
+					vint							LocateBlock(vint row);
+					void							InvalidateRowWidths(vint start, vint end);
+					vint							EstimateCharWidth();
+					void							UpdateBlockStarts();
+					void							InsertLines(vint row, vint count);
+					void							RemoveLineRange(vint row, vint count);
 				public:
 					TextLines();
 					~TextLines();
@@ -324,7 +390,7 @@ Colorized Plain Text (model)
 					/// <returns>The height of a row, in pixel.</returns>
 					vint							GetRowHeight();
 					/// <summary>
-					/// Returns the total width of the text lines.
+					/// Returns the total width of the text lines. Rows that have not been measured are not measured by this function, their widths are estimated from the average width of measured characters.
 					/// </summary>
 					/// <returns>The width of the text lines, in pixel.</returns>
 					vint							GetMaxWidth();
@@ -361,6 +427,15 @@ Colorized Plain Text (model)
 					/// </summary>
 					/// <param name="value">The password mode displaying character. Set to L'\0' to deactivate the password mode.</param>
 					void							SetPasswordChar(wchar_t value);
+					/// <summary>
+					/// Build runs for all visible characters. Each run is the longest range of characters in a row that share the same color index and selection state, except that a tab character always forms a run by itself, so that characters in a run can be drawn in one call. The line break of each visible row is represented by a separated run.
+					/// </summary>
+					/// <param name="viewBounds">The visible bounds, in pixel.</param>
+					/// <param name="selectionBegin">The begin position of the selection area.</param>
+					/// <param name="selectionEnd">The end position of the selection area, which should not be less than the begin position.</param>
+					/// <param name="colorCount">The number of colors in the color table. Color indices that are out of range are treated as 0.</param>
+					/// <param name="runs">Receives all runs from the top row to the bottom row, and from left to right in each row.</param>
+					void							BuildRuns(Rect viewBounds, TextPos selectionBegin, TextPos selectionEnd, vint colorCount, collections::List<TextRun>& runs);
 				};
 				
 				/// <summary>
@@ -570,6 +645,13 @@ Colorized Plain Text (element)
 				/// </summary>
 				/// <param name="value">The color of the caret.</param>
 				void								SetCaretColor(Color value);
+
+				/// <summary>
+				/// Build runs for all characters in the visible bounds using the current selection area and color table. Renderers should draw characters run by run instead of character by character.
+				/// </summary>
+				/// <param name="viewSize">The size of the visible bounds. The left-top position of the visible bounds is the view position.</param>
+				/// <param name="runs">Receives all runs.</param>
+				void								BuildTextRuns(Size viewSize, collections::List<text::TextRun>& runs);
 			};
 		}
 	}
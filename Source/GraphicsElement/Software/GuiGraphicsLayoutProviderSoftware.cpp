@@ -0,0 +1,773 @@
+#include "GuiGraphicsLayoutProviderSoftware.h"
+#include "GuiGraphicsSoftware.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_software
+		{
+			using namespace elements;
+			using namespace collections;
+
+/***********************************************************************
+SoftwareParagraph
+***********************************************************************/
+
+			class SoftwareParagraph : public Object, public IGuiGraphicsParagraph
+			{
+			protected:
+				struct CharStyle
+				{
+					FontProperties						font;
+					Color								color;
+					Color								backgroundColor;
+				};
+
+				struct InlineObject
+				{
+					vint								start;
+					vint								length;
+					InlineObjectProperties				properties;
+				};
+
+				// a character, or an inline object that is placed as a whole
+				struct Unit
+				{
+					vint								start;
+					vint								length;
+					vint								inlineObject;		// index in inlineObjects, -1 for a character
+					vint								x;					// relative to the left side of the line
+					vint								width;
+					vint								ascent;
+					vint								descent;
+
+					bool operator==(const Unit& value)const{return false;}
+					bool operator!=(const Unit& value)const{return true;}
+				};
+
+				struct Line
+				{
+					vint								startUnit;
+					vint								endUnit;
+					vint								start;				// text position of the first character
+					vint								end;				// text position after the last character, including line breaks
+					vint								left;
+					vint								top;
+					vint								width;
+					vint								ascent;
+					vint								descent;
+					bool								forcedBreak;		// the line ends with a line break, so the end position does not belong to this line
+
+					bool operator==(const Line& value)const{return false;}
+					bool operator!=(const Line& value)const{return true;}
+				};
+
+				IGuiGraphicsLayoutProvider*				provider;
+				WString									text;
+				ISoftwareRenderTarget*					renderTarget;
+				IGuiGraphicsParagraphCallback*			paragraphCallback;
+
+				Array<CharStyle>						charStyles;
+				Array<vint>								charInlineObjects;	// index in inlineObjects for each character, -1 for normal characters
+				List<Ptr<InlineObject>>					inlineObjects;		// reset inline objects become null so that indices are stable
+				bool									wrapLine;
+				vint									maxWidth;
+				Alignment								paragraphAlignment;
+
+				bool									layouted;
+				List<Unit>								units;
+				List<Line>								lines;
+				vint									height;
+
+				vint									caret;
+				Color									caretColor;
+				bool									caretFrontSide;
+
+				bool IsRangeAvailable(vint start, vint length)
+				{
+					return 0<=start && start<text.Length() && length>=0 && 0<=start+length && start+length<=text.Length();
+				}
+
+				bool IsSpaceUnit(vint unitIndex)
+				{
+					Unit& unit=units[unitIndex];
+					if(unit.inlineObject!=-1) return false;
+					wchar_t c=text[unit.start];
+					return c==L' ' || c==L'\t' || c==L'\r' || c==L'\n';
+				}
+
+				bool CanBreakBetween(vint previous, vint next)
+				{
+					Unit& previousUnit=units[previous];
+					Unit& nextUnit=units[next];
+					if(previousUnit.inlineObject!=-1)
+					{
+						return inlineObjects[previousUnit.inlineObject]->properties.breakCondition!=StickToNextRun;
+					}
+					if(nextUnit.inlineObject!=-1)
+					{
+						return inlineObjects[nextUnit.inlineObject]->properties.breakCondition!=StickToPreviousRun;
+					}
+
+					// spaces always stay at the end of a line
+					wchar_t p=text[previousUnit.start];
+					wchar_t n=text[nextUnit.start];
+					if(n==L' ' || n==L'\t' || n==L'\r' || n==L'\n') return false;
+					return p==L' ' || p==L'\t' || p>=0x1100 || n>=0x1100;
+				}
+
+				void BuildUnits()
+				{
+					units.Clear();
+					for(vint i=0;i<text.Length();)
+					{
+						Unit unit;
+						unit.start=i;
+						unit.x=0;
+
+						vint index=charInlineObjects[i];
+						if(index!=-1)
+						{
+							InlineObject* inlineObject=inlineObjects[index].Obj();
+							Size size=inlineObject->properties.size;
+							vint baseline=inlineObject->properties.baseline;
+							unit.length=inlineObject->length;
+							unit.inlineObject=index;
+							unit.width=size.x;
+							unit.ascent=baseline==-1?size.y:baseline;
+							unit.descent=size.y-unit.ascent;
+						}
+						else
+						{
+							wchar_t c=text[i];
+							const FontProperties& font=charStyles[i].font;
+							vint rowHeight=GetSoftwareRowHeight(font);
+							unit.length=1;
+							unit.inlineObject=-1;
+							unit.width=(c==L'\r' || c==L'\n')?0:GetSoftwareCharWidth(font, c);
+							unit.ascent=rowHeight-rowHeight/5;
+							unit.descent=rowHeight/5;
+						}
+
+						units.Add(unit);
+						i+=unit.length;
+					}
+				}
+
+				void AddLine(vint startUnit, vint endUnit, bool forcedBreak, vint& top)
+				{
+					Line line;
+					line.startUnit=startUnit;
+					line.endUnit=endUnit;
+					line.start=startUnit<units.Count()?units[startUnit].start:text.Length();
+					line.end=endUnit>startUnit?units[endUnit-1].start+units[endUnit-1].length:line.start;
+					line.top=top;
+					line.width=0;
+					line.ascent=0;
+					line.descent=0;
+					line.forcedBreak=forcedBreak;
+
+					vint x=0;
+					for(vint i=startUnit;i<endUnit;i++)
+					{
+						Unit& unit=units[i];
+						unit.x=x;
+						x+=unit.width;
+						if(!IsSpaceUnit(i)) line.width=x;
+						if(line.ascent<unit.ascent) line.ascent=unit.ascent;
+						if(line.descent<unit.descent) line.descent=unit.descent;
+					}
+
+					if(startUnit==endUnit)
+					{
+						vint rowHeight=GetSoftwareRowHeight(GetCurrentController()->ResourceService()->GetDefaultFont());
+						line.ascent=rowHeight-rowHeight/5;
+						line.descent=rowHeight/5;
+					}
+
+					line.left=0;
+					if(maxWidth!=-1 && line.width<maxWidth)
+					{
+						switch(paragraphAlignment)
+						{
+						case Alignment::Center:
+							line.left=(maxWidth-line.width)/2;
+							break;
+						case Alignment::Right:
+							line.left=maxWidth-line.width;
+							break;
+						default:;
+						}
+					}
+
+					lines.Add(line);
+					top+=line.ascent+line.descent;
+				}
+
+				void Layout()
+				{
+					if(layouted) return;
+					layouted=true;
+					BuildUnits();
+					lines.Clear();
+
+					vint availableWidth=wrapLine?maxWidth:-1;
+					vint count=units.Count();
+					vint top=0;
+					vint first=0;
+					bool forcedBreak=false;
+					do
+					{
+						vint end=first;
+						vint lastBreak=-1;
+						vint x=0;
+						forcedBreak=false;
+						while(end<count)
+						{
+							Unit& unit=units[end];
+							if(unit.inlineObject==-1 && text[unit.start]==L'\n')
+							{
+								end++;
+								forcedBreak=true;
+								break;
+							}
+							if(availableWidth!=-1 && end>first && x+unit.width>availableWidth && !IsSpaceUnit(end))
+							{
+								if(lastBreak>first)
+								{
+									end=lastBreak;
+								}
+								break;
+							}
+
+							x+=unit.width;
+							end++;
+							if(end<count && CanBreakBetween(end-1, end))
+							{
+								lastBreak=end;
+							}
+						}
+
+						AddLine(first, end, forcedBreak, top);
+						first=end;
+					}
+					while(first<count);
+
+					if(forcedBreak)
+					{
+						AddLine(count, count, false, top);
+					}
+					height=top;
+				}
+
+				vint GetLineFromTextPos(vint textPos, bool frontSide)
+				{
+					vint start=0;
+					vint end=lines.Count()-1;
+					while(start<end)
+					{
+						vint middle=(start+end+1)/2;
+						if(lines[middle].start<=textPos)
+						{
+							start=middle;
+						}
+						else
+						{
+							end=middle-1;
+						}
+					}
+
+					if(frontSide && start>0 && lines[start].start==textPos && !lines[start-1].forcedBreak)
+					{
+						start--;
+					}
+					return start;
+				}
+
+				vint GetLineFromY(vint y)
+				{
+					vint start=0;
+					vint end=lines.Count()-1;
+					while(start<end)
+					{
+						vint middle=(start+end+1)/2;
+						if(lines[middle].top<=y)
+						{
+							start=middle;
+						}
+						else
+						{
+							end=middle-1;
+						}
+					}
+					return start;
+				}
+
+				vint GetLineLastCaret(vint lineIndex)
+				{
+					Line& line=lines[lineIndex];
+					vint caret=line.end;
+					if(line.forcedBreak)
+					{
+						caret--;
+						if(caret>line.start && text[caret-1]==L'\r')
+						{
+							caret--;
+						}
+					}
+					return caret;
+				}
+
+				template<typename F>
+				vint GetFirstUnit(vint startUnit, vint endUnit, const F& predicate)
+				{
+					// the predicate is false for a prefix of units and true for the rest, because units in a line are sorted by text position and x
+					while(startUnit<endUnit)
+					{
+						vint middle=(startUnit+endUnit)/2;
+						if(predicate(units[middle]))
+						{
+							endUnit=middle;
+						}
+						else
+						{
+							startUnit=middle+1;
+						}
+					}
+					return startUnit;
+				}
+
+				vint GetCaretX(vint lineIndex, vint textPos)
+				{
+					Line& line=lines[lineIndex];
+					vint i=GetFirstUnit(line.startUnit, line.endUnit, [=](const Unit& unit){return unit.start>=textPos;});
+					if(i<line.endUnit)
+					{
+						return line.left+units[i].x;
+					}
+					else if(i>line.startUnit)
+					{
+						return line.left+units[i-1].x+units[i-1].width;
+					}
+					return line.left;
+				}
+
+				vint GetCaretFromLine(vint lineIndex, vint x)
+				{
+					Line& line=lines[lineIndex];
+					vint lastCaret=GetLineLastCaret(lineIndex);
+					vint endUnit=GetFirstUnit(line.startUnit, line.endUnit, [=](const Unit& unit){return unit.start>=lastCaret;});
+					vint i=GetFirstUnit(line.startUnit, endUnit, [&](const Unit& unit){return x<line.left+unit.x+unit.width/2;});
+					return i<endUnit?units[i].start:lastCaret;
+				}
+			public:
+				SoftwareParagraph(IGuiGraphicsLayoutProvider* _provider, const WString& _text, IGuiGraphicsRenderTarget* _renderTarget, IGuiGraphicsParagraphCallback* _paragraphCallback)
+					:provider(_provider)
+					,text(_text)
+					,renderTarget(dynamic_cast<ISoftwareRenderTarget*>(_renderTarget))
+					,paragraphCallback(_paragraphCallback)
+					,wrapLine(true)
+					,maxWidth(-1)
+					,paragraphAlignment(Alignment::Left)
+					,layouted(false)
+					,height(0)
+					,caret(-1)
+					,caretFrontSide(false)
+				{
+					CharStyle style;
+					style.font=GetCurrentController()->ResourceService()->GetDefaultFont();
+					style.color=Color(0, 0, 0);
+					style.backgroundColor=Color(0, 0, 0, 0);
+
+					charStyles.Resize(text.Length());
+					charInlineObjects.Resize(text.Length());
+					for(vint i=0;i<text.Length();i++)
+					{
+						charStyles[i]=style;
+						charInlineObjects[i]=-1;
+					}
+				}
+
+				~SoftwareParagraph()
+				{
+					CloseCaret();
+				}
+
+				IGuiGraphicsLayoutProvider* GetProvider()override
+				{
+					return provider;
+				}
+
+				IGuiGraphicsRenderTarget* GetRenderTarget()override
+				{
+					return renderTarget;
+				}
+
+				bool GetWrapLine()override
+				{
+					return wrapLine;
+				}
+
+				void SetWrapLine(bool value)override
+				{
+					if(wrapLine!=value)
+					{
+						wrapLine=value;
+						layouted=false;
+					}
+				}
+
+				vint GetMaxWidth()override
+				{
+					return maxWidth;
+				}
+
+				void SetMaxWidth(vint value)override
+				{
+					if(maxWidth!=value)
+					{
+						maxWidth=value;
+						layouted=false;
+					}
+				}
+
+				Alignment GetParagraphAlignment()override
+				{
+					return paragraphAlignment;
+				}
+
+				void SetParagraphAlignment(Alignment value)override
+				{
+					if(paragraphAlignment!=value)
+					{
+						paragraphAlignment=value;
+						layouted=false;
+					}
+				}
+
+				bool SetFont(vint start, vint length, const WString& value)override
+				{
+					if(length==0) return true;
+					if(!IsRangeAvailable(start, length)) return false;
+					for(vint i=start;i<start+length;i++)
+					{
+						charStyles[i].font.fontFamily=value;
+					}
+					return true;
+				}
+
+				bool SetSize(vint start, vint length, vint value)override
+				{
+					if(length==0) return true;
+					if(!IsRangeAvailable(start, length)) return false;
+					for(vint i=start;i<start+length;i++)
+					{
+						charStyles[i].font.size=value;
+					}
+					layouted=false;
+					return true;
+				}
+
+				bool SetStyle(vint start, vint length, TextStyle value)override
+				{
+					if(length==0) return true;
+					if(!IsRangeAvailable(start, length)) return false;
+					for(vint i=start;i<start+length;i++)
+					{
+						FontProperties& font=charStyles[i].font;
+						font.bold=(value&Bold)!=0;
+						font.italic=(value&Italic)!=0;
+						font.underline=(value&Underline)!=0;
+						font.strikeline=(value&Strikeline)!=0;
+					}
+					return true;
+				}
+
+				bool SetColor(vint start, vint length, Color value)override
+				{
+					if(length==0) return true;
+					if(!IsRangeAvailable(start, length)) return false;
+					for(vint i=start;i<start+length;i++)
+					{
+						charStyles[i].color=value;
+					}
+					return true;
+				}
+
+				bool SetBackgroundColor(vint start, vint length, Color value)override
+				{
+					if(length==0) return true;
+					if(!IsRangeAvailable(start, length)) return false;
+					for(vint i=start;i<start+length;i++)
+					{
+						charStyles[i].backgroundColor=value;
+					}
+					return true;
+				}
+
+				bool SetInlineObject(vint start, vint length, const InlineObjectProperties& properties)override
+				{
+					if(length==0) return true;
+					if(!IsRangeAvailable(start, length)) return false;
+					for(vint i=start;i<start+length;i++)
+					{
+						if(charInlineObjects[i]!=-1) return false;
+					}
+
+					Ptr<InlineObject> inlineObject=new InlineObject;
+					inlineObject->start=start;
+					inlineObject->length=length;
+					inlineObject->properties=properties;
+					vint index=inlineObjects.Add(inlineObject);
+					for(vint i=start;i<start+length;i++)
+					{
+						charInlineObjects[i]=index;
+					}
+
+					if(properties.backgroundImage)
+					{
+						IGuiGraphicsRenderer* renderer=properties.backgroundImage->GetRenderer();
+						if(renderer)
+						{
+							renderer->SetRenderTarget(renderTarget);
+						}
+					}
+					layouted=false;
+					return true;
+				}
+
+				bool ResetInlineObject(vint start, vint length)override
+				{
+					if(length==0) return true;
+					if(!IsRangeAvailable(start, length)) return false;
+
+					vint index=charInlineObjects[start];
+					if(index==-1) return false;
+					Ptr<InlineObject> inlineObject=inlineObjects[index];
+					if(inlineObject->start!=start || inlineObject->length!=length) return false;
+
+					for(vint i=start;i<start+length;i++)
+					{
+						charInlineObjects[i]=-1;
+					}
+					inlineObjects[index]=0;
+
+					if(auto element=inlineObject->properties.backgroundImage)
+					{
+						auto renderer=element->GetRenderer();
+						if(renderer)
+						{
+							renderer->SetRenderTarget(0);
+						}
+					}
+					layouted=false;
+					return true;
+				}
+
+				vint GetHeight()override
+				{
+					Layout();
+					return height;
+				}
+
+				bool OpenCaret(vint _caret, Color _color, bool _frontSide)override
+				{
+					if(!IsValidCaret(_caret)) return false;
+					caret=_caret;
+					caretColor=_color;
+					caretFrontSide=_frontSide;
+					return true;
+				}
+
+				bool CloseCaret()override
+				{
+					if(caret==-1) return false;
+					caret=-1;
+					return true;
+				}
+
+				void Render(Rect bounds)override
+				{
+					if(!renderTarget) return;
+					Layout();
+
+					for(vint i=0;i<lines.Count();i++)
+					{
+						Line& line=lines[i];
+						vint y=bounds.y1+line.top;
+						vint lineHeight=line.ascent+line.descent;
+						for(vint j=line.startUnit;j<line.endUnit;j++)
+						{
+							Unit& unit=units[j];
+							vint x=bounds.x1+line.left+unit.x;
+							Point position(x, y+line.ascent-unit.ascent);
+
+							if(unit.inlineObject!=-1)
+							{
+								InlineObjectProperties& properties=inlineObjects[unit.inlineObject]->properties;
+								Rect objectBounds(position, properties.size);
+								if(properties.backgroundImage)
+								{
+									IGuiGraphicsRenderer* renderer=properties.backgroundImage->GetRenderer();
+									if(renderer)
+									{
+										renderer->Render(objectBounds);
+									}
+								}
+								if(properties.callbackId!=-1 && paragraphCallback)
+								{
+									Rect location(Point(objectBounds.x1-bounds.x1, objectBounds.y1-bounds.y1), objectBounds.GetSize());
+									Size size=paragraphCallback->OnRenderInlineObject(properties.callbackId, location);
+									if(properties.size!=size)
+									{
+										properties.size=size;
+										layouted=false;
+									}
+								}
+							}
+							else
+							{
+								CharStyle& style=charStyles[unit.start];
+								if(style.backgroundColor.a>0)
+								{
+									renderTarget->FillRectangle(Rect(x, y, x+unit.width, y+lineHeight), style.backgroundColor);
+								}
+								wchar_t c=text[unit.start];
+								if(c!=L'\r' && c!=L'\n' && style.color.a>0)
+								{
+									DrawSoftwareChar(renderTarget, style.font, (c==L'\t'?L' ':c), position, style.color);
+								}
+							}
+						}
+					}
+
+					if(caret!=-1)
+					{
+						Rect caretBounds=GetCaretBounds(caret, caretFrontSide);
+						vint x=caretBounds.x1+bounds.x1;
+						vint y1=caretBounds.y1+bounds.y1;
+						renderTarget->FillRectangle(Rect(x-1, y1, x+1, y1+caretBounds.Height()), caretColor);
+					}
+				}
+
+				vint GetCaret(vint comparingCaret, CaretRelativePosition position, bool& preferFrontSide)override
+				{
+					Layout();
+					switch(position)
+					{
+					case CaretFirst:
+						return 0;
+					case CaretLast:
+						return text.Length();
+					default:;
+					}
+
+					if(!IsValidCaret(comparingCaret)) return -1;
+					vint lineIndex=GetLineFromTextPos(comparingCaret, preferFrontSide);
+					switch(position)
+					{
+					case CaretLineFirst:
+						return lines[lineIndex].start;
+					case CaretLineLast:
+						return GetLineLastCaret(lineIndex);
+					case CaretMoveLeft:
+						return comparingCaret==0?0:GetNearestCaretFromTextPos(comparingCaret-1, true);
+					case CaretMoveRight:
+						return comparingCaret==text.Length()?comparingCaret:GetNearestCaretFromTextPos(comparingCaret+1, false);
+					case CaretMoveUp:
+					case CaretMoveDown:
+						{
+							vint targetLine=position==CaretMoveUp?lineIndex-1:lineIndex+1;
+							if(targetLine<0 || targetLine>=lines.Count()) return comparingCaret;
+							vint newCaret=GetCaretFromLine(targetLine, GetCaretX(lineIndex, comparingCaret));
+							preferFrontSide=newCaret==GetLineLastCaret(targetLine) && newCaret!=lines[targetLine].start;
+							return newCaret;
+						}
+					default:
+						return -1;
+					}
+				}
+
+				Rect GetCaretBounds(vint caret, bool frontSide)override
+				{
+					Layout();
+					if(!IsValidCaret(caret)) return Rect();
+					vint lineIndex=GetLineFromTextPos(caret, frontSide);
+					Line& line=lines[lineIndex];
+					vint x=GetCaretX(lineIndex, caret);
+					return Rect(x, line.top, x, line.top+line.ascent+line.descent);
+				}
+
+				vint GetCaretFromPoint(Point point)override
+				{
+					Layout();
+					return GetCaretFromLine(GetLineFromY(point.y), point.x);
+				}
+
+				Nullable<InlineObjectProperties> GetInlineObjectFromPoint(Point point, vint& start, vint& length)override
+				{
+					Layout();
+					if(point.y<0 || point.y>=height) return Nullable<InlineObjectProperties>();
+
+					Line& line=lines[GetLineFromY(point.y)];
+					for(vint i=line.startUnit;i<line.endUnit;i++)
+					{
+						Unit& unit=units[i];
+						vint x=line.left+unit.x;
+						if(x<=point.x && point.x<x+unit.width)
+						{
+							if(unit.inlineObject!=-1)
+							{
+								start=unit.start;
+								length=unit.length;
+								return inlineObjects[unit.inlineObject]->properties;
+							}
+							break;
+						}
+					}
+					return Nullable<InlineObjectProperties>();
+				}
+
+				vint GetNearestCaretFromTextPos(vint textPos, bool frontSide)override
+				{
+					if(!IsValidTextPos(textPos)) return -1;
+					if(IsValidCaret(textPos)) return textPos;
+
+					vint index=charInlineObjects[textPos];
+					if(index!=-1)
+					{
+						InlineObject* inlineObject=inlineObjects[index].Obj();
+						return frontSide?inlineObject->start:inlineObject->start+inlineObject->length;
+					}
+					return frontSide?textPos-1:textPos+1;
+				}
+
+				bool IsValidCaret(vint caret)override
+				{
+					if(!IsValidTextPos(caret)) return false;
+					if(caret==0 || caret==text.Length()) return true;
+
+					vint index=charInlineObjects[caret];
+					if(index!=-1 && charInlineObjects[caret-1]==index) return false;
+					if(text[caret-1]==L'\r' && text[caret]==L'\n') return false;
+					return true;
+				}
+
+				bool IsValidTextPos(vint textPos)override
+				{
+					return 0<=textPos && textPos<=text.Length();
+				}
+			};
+
+/***********************************************************************
+SoftwareLayoutProvider
+***********************************************************************/
+
+			Ptr<IGuiGraphicsParagraph> SoftwareLayoutProvider::CreateParagraph(const WString& text, IGuiGraphicsRenderTarget* renderTarget, IGuiGraphicsParagraphCallback* callback)
+			{
+				return new SoftwareParagraph(this, text, renderTarget, callback);
+			}
+		}
+	}
+}
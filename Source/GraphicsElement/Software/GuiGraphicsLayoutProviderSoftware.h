@@ -0,0 +1,30 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Software Renderer
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSLAYOUTPROVIDERSOFTWARE
+#define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSLAYOUTPROVIDERSOFTWARE
+
+#include "../GuiGraphicsDocumentInterfaces.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_software
+		{
+			/// <summary>A layout provider that does not depend on any font engine. Characters are measured using the software renderer font metrics, lines are wrapped greedily at spaces and around CJK characters.</summary>
+			class SoftwareLayoutProvider : public Object, public elements::IGuiGraphicsLayoutProvider
+			{
+			public:
+				Ptr<elements::IGuiGraphicsParagraph>		CreateParagraph(const WString& text, elements::IGuiGraphicsRenderTarget* renderTarget, elements::IGuiGraphicsParagraphCallback* callback)override;
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,740 @@
+#include "GuiGraphicsRenderersSoftware.h"
+#include <math.h>
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_software
+		{
+			using namespace collections;
+
+/***********************************************************************
+Rasterization Helpers
+***********************************************************************/
+
+			namespace software_rasterization_helpers
+			{
+				bool GetRoundRectSpan(Rect bounds, vint radiusX, vint radiusY, vint y, vint& x1, vint& x2)
+				{
+					if(y<bounds.y1 || y>=bounds.y2 || bounds.x1>=bounds.x2) return false;
+					double rx=(double)(radiusX*2>bounds.Width()?bounds.Width()/2.0:radiusX);
+					double ry=(double)(radiusY*2>bounds.Height()?bounds.Height()/2.0:radiusY);
+					double py=y+0.5;
+					double dy=0;
+					if(py<bounds.y1+ry)
+					{
+						dy=bounds.y1+ry-py;
+					}
+					else if(py>bounds.y2-ry)
+					{
+						dy=py-(bounds.y2-ry);
+					}
+
+					vint inset=0;
+					if(dy>0 && ry>0)
+					{
+						double t=dy/ry;
+						inset=(vint)(rx*(1-sqrt(t<1?1-t*t:0))+0.5);
+					}
+					x1=bounds.x1+inset;
+					x2=bounds.x2-inset;
+					return x1<x2;
+				}
+
+				void FillRoundRect(ISoftwareRenderTarget* renderTarget, Rect bounds, vint radiusX, vint radiusY, Color color)
+				{
+					for(vint y=bounds.y1;y<bounds.y2;y++)
+					{
+						vint x1=0, x2=0;
+						if(GetRoundRectSpan(bounds, radiusX, radiusY, y, x1, x2))
+						{
+							renderTarget->FillSpan(x1, x2, y, color);
+						}
+					}
+				}
+
+				void DrawRoundRect(ISoftwareRenderTarget* renderTarget, Rect bounds, vint radiusX, vint radiusY, Color color)
+				{
+					Rect inner(bounds.x1+1, bounds.y1+1, bounds.x2-1, bounds.y2-1);
+					vint innerRadiusX=radiusX>0?radiusX-1:0;
+					vint innerRadiusY=radiusY>0?radiusY-1:0;
+					for(vint y=bounds.y1;y<bounds.y2;y++)
+					{
+						vint x1=0, x2=0, ix1=0, ix2=0;
+						if(GetRoundRectSpan(bounds, radiusX, radiusY, y, x1, x2))
+						{
+							if(GetRoundRectSpan(inner, innerRadiusX, innerRadiusY, y, ix1, ix2))
+							{
+								renderTarget->FillSpan(x1, ix1, y, color);
+								renderTarget->FillSpan(ix2, x2, y, color);
+							}
+							else
+							{
+								renderTarget->FillSpan(x1, x2, y, color);
+							}
+						}
+					}
+				}
+
+				Color Interpolate(Color color1, Color color2, vint position, vint length)
+				{
+					if(length<=0) return color1;
+					return Color(
+						(unsigned char)(color1.r+(color2.r-color1.r)*position/length),
+						(unsigned char)(color1.g+(color2.g-color1.g)*position/length),
+						(unsigned char)(color1.b+(color2.b-color1.b)*position/length),
+						(unsigned char)(color1.a+(color2.a-color1.a)*position/length)
+						);
+				}
+			}
+			using namespace software_rasterization_helpers;
+
+/***********************************************************************
+GuiSolidBorderElementRenderer
+***********************************************************************/
+
+			void GuiSolidBorderElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiSolidBorderElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiSolidBorderElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiSolidBorderElementRenderer::Render(Rect bounds)
+			{
+				Color color=element->GetColor();
+				if(color.a>0)
+				{
+					switch(element->GetShape())
+					{
+					case ElementShape::Rectangle:
+						DrawRoundRect(renderTarget, bounds, 0, 0, color);
+						break;
+					case ElementShape::Ellipse:
+						DrawRoundRect(renderTarget, bounds, bounds.Width()/2, bounds.Height()/2, color);
+						break;
+					}
+				}
+			}
+
+			void GuiSolidBorderElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiRoundBorderElementRenderer
+***********************************************************************/
+
+			void GuiRoundBorderElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiRoundBorderElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiRoundBorderElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiRoundBorderElementRenderer::Render(Rect bounds)
+			{
+				Color color=element->GetColor();
+				if(color.a>0)
+				{
+					vint radius=element->GetRadius();
+					DrawRoundRect(renderTarget, bounds, radius, radius, color);
+				}
+			}
+
+			void GuiRoundBorderElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+Gui3DBorderElementRenderer
+***********************************************************************/
+
+			void Gui3DBorderElementRenderer::InitializeInternal()
+			{
+			}
+
+			void Gui3DBorderElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void Gui3DBorderElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void Gui3DBorderElementRenderer::Render(Rect bounds)
+			{
+				Color color1=element->GetColor1();
+				Color color2=element->GetColor2();
+				if(color1.a>0)
+				{
+					renderTarget->FillRectangle(Rect(bounds.x1, bounds.y1, bounds.x2-1, bounds.y1+1), color1);
+					renderTarget->FillRectangle(Rect(bounds.x1, bounds.y1, bounds.x1+1, bounds.y2-1), color1);
+				}
+				if(color2.a>0)
+				{
+					renderTarget->FillRectangle(Rect(bounds.x2-1, bounds.y1, bounds.x2, bounds.y2), color2);
+					renderTarget->FillRectangle(Rect(bounds.x1, bounds.y2-1, bounds.x2, bounds.y2), color2);
+				}
+			}
+
+			void Gui3DBorderElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+Gui3DSplitterElementRenderer
+***********************************************************************/
+
+			void Gui3DSplitterElementRenderer::InitializeInternal()
+			{
+			}
+
+			void Gui3DSplitterElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void Gui3DSplitterElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void Gui3DSplitterElementRenderer::Render(Rect bounds)
+			{
+				Rect r1, r2;
+				switch(element->GetDirection())
+				{
+				case Gui3DSplitterElement::Horizontal:
+					{
+						vint y=bounds.y1+bounds.Height()/2-1;
+						r1=Rect(bounds.x1, y, bounds.x2, y+1);
+						r2=Rect(bounds.x1, y+1, bounds.x2, y+2);
+					}
+					break;
+				case Gui3DSplitterElement::Vertical:
+					{
+						vint x=bounds.x1+bounds.Width()/2-1;
+						r1=Rect(x, bounds.y1, x+1, bounds.y2);
+						r2=Rect(x+1, bounds.y1, x+2, bounds.y2);
+					}
+					break;
+				}
+				renderTarget->FillRectangle(r1, element->GetColor1());
+				renderTarget->FillRectangle(r2, element->GetColor2());
+			}
+
+			void Gui3DSplitterElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiSolidBackgroundElementRenderer
+***********************************************************************/
+
+			void GuiSolidBackgroundElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiSolidBackgroundElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiSolidBackgroundElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiSolidBackgroundElementRenderer::Render(Rect bounds)
+			{
+				Color color=element->GetColor();
+				if(color.a>0)
+				{
+					switch(element->GetShape())
+					{
+					case ElementShape::Rectangle:
+						renderTarget->FillRectangle(bounds, color);
+						break;
+					case ElementShape::Ellipse:
+						FillRoundRect(renderTarget, bounds, bounds.Width()/2, bounds.Height()/2, color);
+						break;
+					}
+				}
+			}
+
+			void GuiSolidBackgroundElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiGradientBackgroundElementRenderer
+***********************************************************************/
+
+			void GuiGradientBackgroundElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiGradientBackgroundElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiGradientBackgroundElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiGradientBackgroundElementRenderer::Render(Rect bounds)
+			{
+				Color color1=element->GetColor1();
+				Color color2=element->GetColor2();
+				if(color1.a>0 || color2.a>0)
+				{
+					vint w=bounds.Width();
+					vint h=bounds.Height();
+					bool ellipse=element->GetShape()==ElementShape::Ellipse;
+					for(vint y=bounds.y1;y<bounds.y2;y++)
+					{
+						vint x1=bounds.x1, x2=bounds.x2;
+						if(ellipse && !GetRoundRectSpan(bounds, w/2, h/2, y, x1, x2)) continue;
+
+						vint dy=y-bounds.y1;
+						switch(element->GetDirection())
+						{
+						case GuiGradientBackgroundElement::Horizontal:
+							for(vint x=x1;x<x2;x++)
+							{
+								renderTarget->FillSpan(x, x+1, y, Interpolate(color1, color2, x-bounds.x1, w-1));
+							}
+							break;
+						case GuiGradientBackgroundElement::Vertical:
+							renderTarget->FillSpan(x1, x2, y, Interpolate(color1, color2, dy, h-1));
+							break;
+						case GuiGradientBackgroundElement::Slash:
+							for(vint x=x1;x<x2;x++)
+							{
+								renderTarget->FillSpan(x, x+1, y, Interpolate(color1, color2, (bounds.x2-1-x)+dy, w+h-2));
+							}
+							break;
+						case GuiGradientBackgroundElement::Backslash:
+							for(vint x=x1;x<x2;x++)
+							{
+								renderTarget->FillSpan(x, x+1, y, Interpolate(color1, color2, (x-bounds.x1)+dy, w+h-2));
+							}
+							break;
+						}
+					}
+				}
+			}
+
+			void GuiGradientBackgroundElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiSolidLabelElementRenderer
+***********************************************************************/
+
+			vint GuiSolidLabelElementRenderer::MeasureCharWidth(wchar_t c)
+			{
+				return GetSoftwareCharWidth(element->GetFont(), c);
+			}
+
+			void GuiSolidLabelElementRenderer::BuildLines(collections::List<LineRange>& lines, vint maxWidth)
+			{
+				const WString& text=element->GetText();
+				bool multiline=element->GetMultiline() || element->GetWrapLine();
+				bool wrapLine=element->GetWrapLine() && maxWidth>0;
+
+				LineRange current;
+				current.start=0;
+				current.length=0;
+				vint currentWidth=0;
+				for(vint i=0;i<text.Length();i++)
+				{
+					wchar_t c=text[i];
+					if(multiline && c==L'\n')
+					{
+						lines.Add(current);
+						current.start=i+1;
+						current.length=0;
+						currentWidth=0;
+						continue;
+					}
+					if(c==L'\r') c=L' ';
+
+					vint width=MeasureCharWidth(c);
+					if(wrapLine && current.length>0 && currentWidth+width>maxWidth)
+					{
+						lines.Add(current);
+						current.start=i;
+						current.length=0;
+						currentWidth=0;
+					}
+					current.length++;
+					currentWidth+=width;
+				}
+				lines.Add(current);
+			}
+
+			void GuiSolidLabelElementRenderer::UpdateMinSize()
+			{
+				const WString& text=element->GetText();
+				vint rowHeight=GetSoftwareRowHeight(element->GetFont());
+				if(element->GetWrapLine())
+				{
+					if(element->GetWrapLineHeightCalculation())
+					{
+						if(oldMaxWidth==-1 || text.Length()==0)
+						{
+							minSize=Size(0, rowHeight);
+						}
+						else
+						{
+							List<LineRange> lines;
+							BuildLines(lines, oldMaxWidth);
+							minSize=Size(0, rowHeight*lines.Count());
+						}
+					}
+					else
+					{
+						minSize=Size(0, 0);
+					}
+				}
+				else
+				{
+					List<LineRange> lines;
+					BuildLines(lines, -1);
+					vint maxWidth=0;
+					FOREACH(LineRange, line, lines)
+					{
+						vint width=0;
+						for(vint i=0;i<line.length;i++)
+						{
+							width+=MeasureCharWidth(text[line.start+i]);
+						}
+						if(maxWidth<width) maxWidth=width;
+					}
+					if(maxWidth==0) maxWidth=MeasureCharWidth(L' ');
+					minSize=Size((element->GetEllipse()?0:maxWidth), rowHeight*lines.Count());
+				}
+			}
+
+			void GuiSolidLabelElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiSolidLabelElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiSolidLabelElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+				UpdateMinSize();
+			}
+
+			GuiSolidLabelElementRenderer::GuiSolidLabelElementRenderer()
+				:oldMaxWidth(-1)
+			{
+			}
+
+			void GuiSolidLabelElementRenderer::Render(Rect bounds)
+			{
+				Color color=element->GetColor();
+				if(color.a>0)
+				{
+					const WString& text=element->GetText();
+					const FontProperties& font=element->GetFont();
+					vint rowHeight=GetSoftwareRowHeight(font);
+
+					List<LineRange> lines;
+					BuildLines(lines, bounds.Width());
+
+					vint y=bounds.y1;
+					switch(element->GetVerticalAlignment())
+					{
+					case Alignment::Top:
+						break;
+					case Alignment::Center:
+						y+=(bounds.Height()-rowHeight*lines.Count())/2;
+						break;
+					case Alignment::Bottom:
+						y+=bounds.Height()-rowHeight*lines.Count();
+						break;
+					}
+
+					FOREACH(LineRange, line, lines)
+					{
+						vint width=0;
+						for(vint i=0;i<line.length;i++)
+						{
+							width+=MeasureCharWidth(text[line.start+i]);
+						}
+
+						vint x=bounds.x1;
+						switch(element->GetHorizontalAlignment())
+						{
+						case Alignment::Left:
+							break;
+						case Alignment::Center:
+							x+=(bounds.Width()-width)/2;
+							break;
+						case Alignment::Right:
+							x+=bounds.Width()-width;
+							break;
+						}
+
+						for(vint i=0;i<line.length;i++)
+						{
+							wchar_t c=text[line.start+i];
+							vint charWidth=MeasureCharWidth(c);
+							if(element->GetEllipse() && x+charWidth>bounds.x2)
+							{
+								break;
+							}
+							DrawSoftwareChar(renderTarget, font, c, Point(x, y), color);
+							x+=charWidth;
+						}
+						y+=rowHeight;
+					}
+
+					if(oldMaxWidth!=bounds.Width())
+					{
+						oldMaxWidth=bounds.Width();
+						UpdateMinSize();
+					}
+				}
+			}
+
+			void GuiSolidLabelElementRenderer::OnElementStateChanged()
+			{
+				UpdateMinSize();
+			}
+
+/***********************************************************************
+GuiImageFrameElementRenderer
+***********************************************************************/
+
+			void GuiImageFrameElementRenderer::UpdateMinSize()
+			{
+				if(element->GetImage() && !element->GetStretch())
+				{
+					minSize=element->GetImage()->GetFrame(element->GetFrameIndex())->GetSize();
+				}
+				else
+				{
+					minSize=Size(0, 0);
+				}
+			}
+
+			void GuiImageFrameElementRenderer::InitializeInternal()
+			{
+				UpdateMinSize();
+			}
+
+			void GuiImageFrameElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiImageFrameElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiImageFrameElementRenderer::Render(Rect bounds)
+			{
+				// INativeImageFrame does not expose pixels, so only the layout of the image is honored
+			}
+
+			void GuiImageFrameElementRenderer::OnElementStateChanged()
+			{
+				UpdateMinSize();
+			}
+
+/***********************************************************************
+GuiPolygonElementRenderer
+***********************************************************************/
+
+			void GuiPolygonElementRenderer::InitializeInternal()
+			{
+				OnElementStateChanged();
+			}
+
+			void GuiPolygonElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiPolygonElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiPolygonElementRenderer::Render(Rect bounds)
+			{
+				vint pointCount=points.Count();
+				Color borderColor=element->GetBorderColor();
+				Color backgroundColor=element->GetBackgroundColor();
+				if(pointCount>=3 && (borderColor.a || backgroundColor.a))
+				{
+					vint offsetX=(bounds.Width()-minSize.x)/2+bounds.x1;
+					vint offsetY=(bounds.Height()-minSize.y)/2+bounds.y1;
+
+					if(backgroundColor.a)
+					{
+						vint minY=points[0].y, maxY=points[0].y;
+						for(vint i=1;i<pointCount;i++)
+						{
+							if(minY>points[i].y) minY=points[i].y;
+							if(maxY<points[i].y) maxY=points[i].y;
+						}
+
+						// even-odd scanline fill, sampling the center of each pixel
+						List<vint> crossings;
+						for(vint y=minY;y<maxY;y++)
+						{
+							double py=y+0.5;
+							crossings.Clear();
+							for(vint i=0;i<pointCount;i++)
+							{
+								Point p1=points[i];
+								Point p2=points[(i+1)%pointCount];
+								if((p1.y<=py && py<p2.y) || (p2.y<=py && py<p1.y))
+								{
+									double x=p1.x+(py-p1.y)*(p2.x-p1.x)/(p2.y-p1.y);
+									vint cx=(vint)floor(x+0.5);
+									vint index=0;
+									while(index<crossings.Count() && crossings[index]<cx) index++;
+									crossings.Insert(index, cx);
+								}
+							}
+							for(vint i=0;i+1<crossings.Count();i+=2)
+							{
+								renderTarget->FillSpan(crossings[i]+offsetX, crossings[i+1]+offsetX, y+offsetY, backgroundColor);
+							}
+						}
+					}
+
+					if(borderColor.a)
+					{
+						for(vint i=0;i<pointCount;i++)
+						{
+							Point p1=points[i];
+							Point p2=points[(i+1)%pointCount];
+							renderTarget->DrawLine(Point(p1.x+offsetX, p1.y+offsetY), Point(p2.x+offsetX, p2.y+offsetY), borderColor);
+						}
+					}
+				}
+			}
+
+			void GuiPolygonElementRenderer::OnElementStateChanged()
+			{
+				minSize=element->GetSize();
+				points.Resize(element->GetPointCount());
+				for(vint i=0;i<points.Count();i++)
+				{
+					points[i]=element->GetPoint(i);
+				}
+			}
+
+/***********************************************************************
+GuiColorizedTextElementRenderer
+***********************************************************************/
+
+			void GuiColorizedTextElementRenderer::ColorChanged()
+			{
+			}
+
+			void GuiColorizedTextElementRenderer::FontChanged()
+			{
+				ISoftwareResourceManager* resourceManager=GetSoftwareResourceManager();
+				if(hasFont)
+				{
+					element->GetLines().SetCharMeasurer(0);
+					resourceManager->DestroyCharMeasurer(oldFont);
+				}
+				oldFont=element->GetFont();
+				hasFont=true;
+				element->GetLines().SetCharMeasurer(resourceManager->CreateCharMeasurer(oldFont).Obj());
+			}
+
+			void GuiColorizedTextElementRenderer::InitializeInternal()
+			{
+				element->SetCallback(this);
+				runs.SetLessMemoryMode(false);
+			}
+
+			void GuiColorizedTextElementRenderer::FinalizeInternal()
+			{
+				if(hasFont)
+				{
+					GetSoftwareResourceManager()->DestroyCharMeasurer(oldFont);
+				}
+			}
+
+			void GuiColorizedTextElementRenderer::RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget)
+			{
+				element->GetLines().SetRenderTarget(newRenderTarget);
+			}
+
+			GuiColorizedTextElementRenderer::GuiColorizedTextElementRenderer()
+				:hasFont(false)
+			{
+			}
+
+			void GuiColorizedTextElementRenderer::Render(Rect bounds)
+			{
+				if(renderTarget)
+				{
+					const GuiColorizedTextElement::ColorArray& colors=element->GetColors();
+					wchar_t passwordChar=element->GetPasswordChar();
+					Point viewPosition=element->GetViewPosition();
+					bool focused=element->GetFocused();
+					vint height=element->GetLines().GetRowHeight();
+
+					element->BuildTextRuns(bounds.GetSize(), runs);
+					if(colors.Count()>0)
+					{
+						for(vint i=0;i<runs.Count();i++)
+						{
+							const text::TextRun& run=runs[i];
+							const text::ColorItem& color=
+								!run.inSelection?colors[run.colorIndex].normal:
+								focused?colors[run.colorIndex].selectedFocused:
+								colors[run.colorIndex].selectedUnfocused;
+							vint tx=run.x1-viewPosition.x+bounds.x1;
+							vint ty=run.row*height-viewPosition.y+bounds.y1;
+
+							renderTarget->FillRectangle(Rect(tx, ty, tx+(run.x2-run.x1), ty+height), color.background);
+							if(!run.lineBreak && color.text.a)
+							{
+								text::TextLine& line=element->GetLines().GetLine(run.row);
+								for(vint column=run.startColumn;column<run.endColumn;column++)
+								{
+									vint x=column==0?0:line.att[column-1].rightOffset;
+									DrawSoftwareChar(renderTarget, oldFont, (passwordChar?passwordChar:line.text[column]), Point(x-viewPosition.x+bounds.x1, ty), color.text);
+								}
+							}
+						}
+					}
+
+					if(element->GetCaretVisible() && element->GetLines().IsAvailable(element->GetCaretEnd()))
+					{
+						Point caretPoint=element->GetLines().GetPointFromTextPos(element->GetCaretEnd());
+						vint height=element->GetLines().GetRowHeight();
+						vint x=caretPoint.x-viewPosition.x+bounds.x1;
+						vint y=caretPoint.y-viewPosition.y+bounds.y1;
+						renderTarget->FillRectangle(Rect(x-1, y+1, x+1, y+height-1), element->GetCaretColor());
+					}
+				}
+			}
+
+			void GuiColorizedTextElementRenderer::OnElementStateChanged()
+			{
+			}
+		}
+	}
+}
@@ -0,0 +1,180 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Software Renderer
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSRENDERERSSOFTWARE
+#define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSRENDERERSSOFTWARE
+
+#include "GuiGraphicsSoftware.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_software
+		{
+			using namespace elements;
+
+/***********************************************************************
+Renderers
+***********************************************************************/
+
+			class GuiSolidBorderElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiSolidBorderElement, GuiSolidBorderElementRenderer, ISoftwareRenderTarget)
+			protected:
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class GuiRoundBorderElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiRoundBorderElement, GuiRoundBorderElementRenderer, ISoftwareRenderTarget)
+			protected:
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class Gui3DBorderElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(Gui3DBorderElement, Gui3DBorderElementRenderer, ISoftwareRenderTarget)
+			protected:
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class Gui3DSplitterElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(Gui3DSplitterElement, Gui3DSplitterElementRenderer, ISoftwareRenderTarget)
+			protected:
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class GuiSolidBackgroundElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiSolidBackgroundElement, GuiSolidBackgroundElementRenderer, ISoftwareRenderTarget)
+			protected:
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class GuiGradientBackgroundElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiGradientBackgroundElement, GuiGradientBackgroundElementRenderer, ISoftwareRenderTarget)
+			protected:
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class GuiSolidLabelElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiSolidLabelElement, GuiSolidLabelElementRenderer, ISoftwareRenderTarget)
+			protected:
+				struct LineRange
+				{
+					vint				start;
+					vint				length;
+
+					bool operator==(const LineRange& value)const{return false;}
+					bool operator!=(const LineRange& value)const{return true;}
+				};
+
+				vint					oldMaxWidth;
+
+				vint					GetFontSize();
+				vint					MeasureCharWidth(wchar_t c);
+				void					BuildLines(collections::List<LineRange>& lines, vint maxWidth);
+				void					UpdateMinSize();
+
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				GuiSolidLabelElementRenderer();
+
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class GuiImageFrameElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiImageFrameElement, GuiImageFrameElementRenderer, ISoftwareRenderTarget)
+			protected:
+				void					UpdateMinSize();
+
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+
+			class GuiPolygonElementRenderer : public Object, public IGuiGraphicsRenderer
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiPolygonElement, GuiPolygonElementRenderer, ISoftwareRenderTarget)
+			protected:
+				collections::Array<Point>		points;
+
+				void							InitializeInternal();
+				void							FinalizeInternal();
+				void							RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				void							Render(Rect bounds)override;
+				void							OnElementStateChanged()override;
+			};
+
+			class GuiColorizedTextElementRenderer : public Object, public IGuiGraphicsRenderer, protected GuiColorizedTextElement::ICallback
+			{
+				DEFINE_GUI_GRAPHICS_RENDERER(GuiColorizedTextElement, GuiColorizedTextElementRenderer, ISoftwareRenderTarget)
+			protected:
+				FontProperties			oldFont;
+				bool					hasFont;
+				collections::List<text::TextRun>	runs;
+
+				void					ColorChanged();
+				void					FontChanged();
+
+				void					InitializeInternal();
+				void					FinalizeInternal();
+				void					RenderTargetChangedInternal(ISoftwareRenderTarget* oldRenderTarget, ISoftwareRenderTarget* newRenderTarget);
+			public:
+				GuiColorizedTextElementRenderer();
+
+				void					Render(Rect bounds)override;
+				void					OnElementStateChanged()override;
+			};
+		}
+	}
+}
+
+#endif
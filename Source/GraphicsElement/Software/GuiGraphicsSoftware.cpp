@@ -0,0 +1,410 @@
+#include "GuiGraphicsSoftware.h"
+#include "GuiGraphicsRenderersSoftware.h"
+#include "GuiGraphicsLayoutProviderSoftware.h"
+#include "../../Controls/GuiApplication.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_software
+		{
+			using namespace headless;
+			using namespace elements;
+			using namespace collections;
+
+/***********************************************************************
+SoftwareRenderTarget
+***********************************************************************/
+
+			class SoftwareRenderTarget : public Object, public ISoftwareRenderTarget
+			{
+			protected:
+				INativeWindow*				window;
+				Size						size;
+				Array<Color>				buffer;
+				List<Rect>					clippers;
+				vint						clipperCoverWholeTargetCounter;
+
+				static unsigned char Blend(unsigned char source, unsigned char target, vint alpha)
+				{
+					return (unsigned char)((source*alpha+target*(255-alpha)+127)/255);
+				}
+
+				void BlendPixel(Color& target, Color source)
+				{
+					if(source.a==255)
+					{
+						target=source;
+					}
+					else if(source.a>0)
+					{
+						target.r=Blend(source.r, target.r, source.a);
+						target.g=Blend(source.g, target.g, source.a);
+						target.b=Blend(source.b, target.b, source.a);
+						target.a=(unsigned char)(source.a+(target.a*(255-source.a)+127)/255);
+					}
+				}
+			public:
+				SoftwareRenderTarget(INativeWindow* _window)
+					:window(_window)
+					,clipperCoverWholeTargetCounter(0)
+				{
+				}
+
+				void StartRendering()override
+				{
+					Size clientSize=window->GetClientSize();
+					if(clientSize.x<0) clientSize.x=0;
+					if(clientSize.y<0) clientSize.y=0;
+					if(size!=clientSize)
+					{
+						size=clientSize;
+						buffer.Resize(size.x*size.y);
+					}
+					for(vint i=0;i<buffer.Count();i++)
+					{
+						buffer[i]=Color(0, 0, 0, 0);
+					}
+				}
+
+				bool StopRendering()override
+				{
+					return true;
+				}
+
+				void PushClipper(Rect clipper)override
+				{
+					if(clipperCoverWholeTargetCounter>0)
+					{
+						clipperCoverWholeTargetCounter++;
+					}
+					else
+					{
+						Rect previousClipper=GetClipper();
+						Rect currentClipper;
+
+						currentClipper.x1=(previousClipper.x1>clipper.x1?previousClipper.x1:clipper.x1);
+						currentClipper.y1=(previousClipper.y1>clipper.y1?previousClipper.y1:clipper.y1);
+						currentClipper.x2=(previousClipper.x2<clipper.x2?previousClipper.x2:clipper.x2);
+						currentClipper.y2=(previousClipper.y2<clipper.y2?previousClipper.y2:clipper.y2);
+
+						if(currentClipper.x1<currentClipper.x2 && currentClipper.y1<currentClipper.y2)
+						{
+							clippers.Add(currentClipper);
+						}
+						else
+						{
+							clipperCoverWholeTargetCounter++;
+						}
+					}
+				}
+
+				void PopClipper()override
+				{
+					if(clippers.Count()>0)
+					{
+						if(clipperCoverWholeTargetCounter>0)
+						{
+							clipperCoverWholeTargetCounter--;
+						}
+						else
+						{
+							clippers.RemoveAt(clippers.Count()-1);
+						}
+					}
+				}
+
+				Rect GetClipper()override
+				{
+					if(clippers.Count()==0)
+					{
+						return Rect(Point(0, 0), size);
+					}
+					else
+					{
+						return clippers[clippers.Count()-1];
+					}
+				}
+
+				bool IsClipperCoverWholeTarget()override
+				{
+					return clipperCoverWholeTargetCounter>0;
+				}
+
+				Size GetSize()override
+				{
+					return size;
+				}
+
+				const Color* GetBuffer()override
+				{
+					return buffer.Count()==0?0:&buffer[0];
+				}
+
+				Color GetPixel(vint x, vint y)override
+				{
+					if(0<=x && x<size.x && 0<=y && y<size.y)
+					{
+						return buffer[y*size.x+x];
+					}
+					return Color(0, 0, 0, 0);
+				}
+
+				void FillSpan(vint x1, vint x2, vint y, Color color)override
+				{
+					if(color.a==0 || clipperCoverWholeTargetCounter>0) return;
+					Rect clipper=GetClipper();
+					if(y<clipper.y1 || y>=clipper.y2 || y<0 || y>=size.y) return;
+					if(x1<clipper.x1) x1=clipper.x1;
+					if(x2>clipper.x2) x2=clipper.x2;
+					if(x1<0) x1=0;
+					if(x2>size.x) x2=size.x;
+
+					Color* row=&buffer[y*size.x];
+					for(vint x=x1;x<x2;x++)
+					{
+						BlendPixel(row[x], color);
+					}
+				}
+
+				void FillRectangle(Rect bounds, Color color)override
+				{
+					for(vint y=bounds.y1;y<bounds.y2;y++)
+					{
+						FillSpan(bounds.x1, bounds.x2, y, color);
+					}
+				}
+
+				void DrawLine(Point p1, Point p2, Color color)override
+				{
+					vint dx=p2.x>p1.x?p2.x-p1.x:p1.x-p2.x;
+					vint dy=p2.y>p1.y?p2.y-p1.y:p1.y-p2.y;
+					vint sx=p1.x<p2.x?1:-1;
+					vint sy=p1.y<p2.y?1:-1;
+					vint error=dx-dy;
+					vint x=p1.x;
+					vint y=p1.y;
+					while(true)
+					{
+						FillSpan(x, x+1, y, color);
+						if(x==p2.x && y==p2.y) break;
+						vint error2=error*2;
+						if(error2>-dy)
+						{
+							error-=dy;
+							x+=sx;
+						}
+						if(error2<dx)
+						{
+							error+=dx;
+							y+=sy;
+						}
+					}
+				}
+			};
+
+/***********************************************************************
+CachedResourceAllocator
+***********************************************************************/
+
+			class CachedCharMeasurerAllocator
+			{
+				DEFINE_CACHED_RESOURCE_ALLOCATOR(FontProperties, Ptr<text::CharMeasurer>)
+
+			protected:
+				class SoftwareCharMeasurer : public text::CharMeasurer
+				{
+				protected:
+					FontProperties			font;
+
+					vint MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return GetSoftwareCharWidth(font, character);
+					}
+
+					vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return GetSoftwareRowHeight(font);
+					}
+				public:
+					SoftwareCharMeasurer(const FontProperties& _font)
+						:text::CharMeasurer(GetSoftwareRowHeight(_font))
+						,font(_font)
+					{
+					}
+				};
+			public:
+				Ptr<text::CharMeasurer> CreateInternal(const FontProperties& value)
+				{
+					return new SoftwareCharMeasurer(value);
+				}
+			};
+
+/***********************************************************************
+SoftwareResourceManager
+***********************************************************************/
+
+			class SoftwareResourceManager : public GuiGraphicsResourceManager, public ISoftwareResourceManager, public INativeControllerListener
+			{
+			protected:
+				SortedList<Ptr<SoftwareRenderTarget>>		renderTargets;
+				CachedCharMeasurerAllocator					charMeasurers;
+				SoftwareLayoutProvider						layoutProvider;
+			public:
+				IGuiGraphicsRenderTarget* GetRenderTarget(INativeWindow* window)override
+				{
+					return GetSoftwareRenderTarget(window);
+				}
+
+				void RecreateRenderTarget(INativeWindow* window)override
+				{
+				}
+
+				IGuiGraphicsLayoutProvider* GetLayoutProvider()override
+				{
+					return &layoutProvider;
+				}
+
+				void NativeWindowCreated(INativeWindow* window)override
+				{
+					SoftwareRenderTarget* renderTarget=new SoftwareRenderTarget(window);
+					renderTargets.Add(renderTarget);
+					GetHeadlessForm(window)->SetGraphicsHandler(renderTarget);
+				}
+
+				void NativeWindowDestroying(INativeWindow* window)override
+				{
+					SoftwareRenderTarget* renderTarget=dynamic_cast<SoftwareRenderTarget*>(GetSoftwareRenderTarget(window));
+					GetHeadlessForm(window)->SetGraphicsHandler(0);
+					renderTargets.Remove(renderTarget);
+				}
+
+				Ptr<text::CharMeasurer> CreateCharMeasurer(const FontProperties& fontProperties)override
+				{
+					return charMeasurers.Create(fontProperties);
+				}
+
+				void DestroyCharMeasurer(const FontProperties& fontProperties)override
+				{
+					charMeasurers.Destroy(fontProperties);
+				}
+			};
+
+			ISoftwareResourceManager* softwareResourceManager=0;
+
+			ISoftwareResourceManager* GetSoftwareResourceManager()
+			{
+				return softwareResourceManager;
+			}
+
+			void SetSoftwareResourceManager(ISoftwareResourceManager* resourceManager)
+			{
+				softwareResourceManager=resourceManager;
+			}
+
+			ISoftwareRenderTarget* GetSoftwareRenderTarget(INativeWindow* window)
+			{
+				IHeadlessForm* form=GetHeadlessForm(window);
+				return form?dynamic_cast<ISoftwareRenderTarget*>(form->GetGraphicsHandler()):0;
+			}
+
+/***********************************************************************
+Font Metrics
+***********************************************************************/
+
+			vint GetSoftwareFontSize(const FontProperties& fontProperties)
+			{
+				vint size=fontProperties.size<0?-fontProperties.size:fontProperties.size;
+				return size==0?12:size;
+			}
+
+			vint GetSoftwareCharWidth(const FontProperties& fontProperties, wchar_t character)
+			{
+				vint size=GetSoftwareFontSize(fontProperties);
+				if(character==L'\t')
+				{
+					return (size+1)/2*4;
+				}
+				else if(character<0x1100)
+				{
+					return (size+1)/2;
+				}
+				else
+				{
+					return size;
+				}
+			}
+
+			vint GetSoftwareRowHeight(const FontProperties& fontProperties)
+			{
+				vint size=GetSoftwareFontSize(fontProperties);
+				return size+size/3;
+			}
+
+			void DrawSoftwareChar(ISoftwareRenderTarget* renderTarget, const FontProperties& fontProperties, wchar_t character, Point position, Color color)
+			{
+				vint width=GetSoftwareCharWidth(fontProperties, character);
+				vint height=GetSoftwareRowHeight(fontProperties);
+				vint baseline=position.y+height-height/5;
+				if(character>L' ')
+				{
+					vint top=position.y+height/5;
+					vint inset=fontProperties.bold?0:1;
+					renderTarget->FillRectangle(Rect(position.x+inset, top, position.x+width-inset, baseline), color);
+				}
+				if(fontProperties.underline)
+				{
+					renderTarget->FillSpan(position.x, position.x+width, baseline, color);
+				}
+				if(fontProperties.strikeline)
+				{
+					renderTarget->FillSpan(position.x, position.x+width, (position.y+baseline)/2, color);
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************************
+NativeMain
+***********************************************************************/
+
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::headless;
+
+void RendererMainSoftware()
+{
+	elements_software::SoftwareResourceManager resourceManager;
+	SetGuiGraphicsResourceManager(&resourceManager);
+	elements_software::SetSoftwareResourceManager(&resourceManager);
+	GetCurrentController()->CallbackService()->InstallListener(&resourceManager);
+
+	elements_software::GuiSolidBorderElementRenderer::Register();
+	elements_software::GuiRoundBorderElementRenderer::Register();
+	elements_software::Gui3DBorderElementRenderer::Register();
+	elements_software::Gui3DSplitterElementRenderer::Register();
+	elements_software::GuiSolidBackgroundElementRenderer::Register();
+	elements_software::GuiGradientBackgroundElementRenderer::Register();
+	elements_software::GuiSolidLabelElementRenderer::Register();
+	elements_software::GuiImageFrameElementRenderer::Register();
+	elements_software::GuiPolygonElementRenderer::Register();
+	elements_software::GuiColorizedTextElementRenderer::Register();
+	elements::GuiDocumentElement::GuiDocumentElementRenderer::Register();
+
+	GuiApplicationMain();
+	GetCurrentController()->CallbackService()->UninstallListener(&resourceManager);
+	elements_software::SetSoftwareResourceManager(0);
+	SetGuiGraphicsResourceManager(0);
+}
+
+int SetupHeadlessSoftwareRenderer()
+{
+	INativeController* controller=CreateHeadlessNativeController(Size(1024, 768));
+	SetCurrentController(controller);
+	RendererMainSoftware();
+	SetCurrentController(0);
+	DestroyHeadlessNativeController(controller);
+	return 0;
+}
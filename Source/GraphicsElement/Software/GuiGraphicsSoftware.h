@@ -0,0 +1,101 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Software Renderer
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSSOFTWARE
+#define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSSOFTWARE
+
+#include "../GuiGraphicsElement.h"
+#include "../GuiGraphicsTextElement.h"
+#include "../../NativeWindow/Headless/HeadlessNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_software
+		{
+
+/***********************************************************************
+Functionality
+***********************************************************************/
+
+			/// <summary>A render target that rasterizes into an RGBA buffer in memory. The buffer has the same size as the client area of the window.</summary>
+			class ISoftwareRenderTarget : public elements::IGuiGraphicsRenderTarget
+			{
+			public:
+				/// <summary>Get the size of the buffer.</summary>
+				/// <returns>The size of the buffer.</returns>
+				virtual Size							GetSize()=0;
+				/// <summary>Get all pixels, row by row from the top left corner.</summary>
+				/// <returns>The first pixel, or null if the buffer is empty.</returns>
+				virtual const Color*					GetBuffer()=0;
+				/// <summary>Get a pixel.</summary>
+				/// <returns>The pixel. A transparent color is returned if the position is outside of the buffer.</returns>
+				/// <param name="x">The x coordinate.</param>
+				/// <param name="y">The y coordinate.</param>
+				virtual Color							GetPixel(vint x, vint y)=0;
+
+				/// <summary>Blend a rectangle into the buffer inside the current clipper.</summary>
+				/// <param name="bounds">The rectangle.</param>
+				/// <param name="color">The color.</param>
+				virtual void							FillRectangle(Rect bounds, Color color)=0;
+				/// <summary>Blend a horizontal span into the buffer inside the current clipper.</summary>
+				/// <param name="x1">The first pixel.</param>
+				/// <param name="x2">The pixel after the last pixel.</param>
+				/// <param name="y">The row.</param>
+				/// <param name="color">The color.</param>
+				virtual void							FillSpan(vint x1, vint x2, vint y, Color color)=0;
+				/// <summary>Blend a one pixel width line into the buffer inside the current clipper.</summary>
+				/// <param name="p1">The first point.</param>
+				/// <param name="p2">The last point.</param>
+				/// <param name="color">The color.</param>
+				virtual void							DrawLine(Point p1, Point p2, Color color)=0;
+			};
+
+			/// <summary>Resources that are shared by all software renderers.</summary>
+			class ISoftwareResourceManager : public Interface
+			{
+			public:
+				virtual Ptr<elements::text::CharMeasurer>	CreateCharMeasurer(const FontProperties& fontProperties)=0;
+				virtual void								DestroyCharMeasurer(const FontProperties& fontProperties)=0;
+			};
+
+			extern ISoftwareResourceManager*			GetSoftwareResourceManager();
+
+/***********************************************************************
+Font Metrics
+***********************************************************************/
+
+			/// <summary>Get the width of a character. There is no font rasterizer behind the software renderer, every character occupies a fixed size box that only depends on the font size and the character range.</summary>
+			/// <returns>The width of the character.</returns>
+			/// <param name="fontProperties">The font.</param>
+			/// <param name="character">The character.</param>
+			extern vint									GetSoftwareCharWidth(const FontProperties& fontProperties, wchar_t character);
+			/// <summary>Get the height of a row of text.</summary>
+			/// <returns>The height of a row.</returns>
+			/// <param name="fontProperties">The font.</param>
+			extern vint									GetSoftwareRowHeight(const FontProperties& fontProperties);
+			/// <summary>Draw a placeholder box for a character. Nothing is drawn for white spaces.</summary>
+			/// <param name="renderTarget">The render target.</param>
+			/// <param name="fontProperties">The font.</param>
+			/// <param name="character">The character.</param>
+			/// <param name="position">The top left corner of the character.</param>
+			/// <param name="color">The color.</param>
+			extern void									DrawSoftwareChar(ISoftwareRenderTarget* renderTarget, const FontProperties& fontProperties, wchar_t character, Point position, Color color);
+
+			/// <summary>Get the render target of a window when the software renderer is running.</summary>
+			/// <returns>The render target.</returns>
+			/// <param name="window">The window.</param>
+			extern ISoftwareRenderTarget*				GetSoftwareRenderTarget(INativeWindow* window);
+		}
+	}
+}
+
+extern void RendererMainSoftware();
+
+#endif
@@ -1,5 +1,6 @@
 #include <math.h>
 #include "GuiGraphicsRenderersWindowsDirect2D.h"
+#include "..\GuiGraphicsHost.h"
 #include "..\..\NativeWindow\Windows\Direct2D\WinDirect2DApplication.h"
 
 namespace vl
@@ -1111,6 +1112,7 @@ GuiColorizedTextElementRenderer
 				textFormat=0;
 				caretBrush=0;
 				element->SetCallback(this);
+				runs.SetLessMemoryMode(false);
 			}
 
 			void GuiColorizedTextElementRenderer::FinalizeInternal()
@@ -1142,75 +1144,43 @@ GuiColorizedTextElementRenderer
 					ID2D1RenderTarget* d2dRenderTarget=renderTarget->GetDirect2DRenderTarget();
 					wchar_t passwordChar=element->GetPasswordChar();
 					Point viewPosition=element->GetViewPosition();
-					Rect viewBounds(viewPosition, bounds.GetSize());
-					vint startRow=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x1, viewBounds.y1)).row;
-					vint endRow=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x2, viewBounds.y2)).row;
-					TextPos selectionBegin=element->GetCaretBegin()<element->GetCaretEnd()?element->GetCaretBegin():element->GetCaretEnd();
-					TextPos selectionEnd=element->GetCaretBegin()>element->GetCaretEnd()?element->GetCaretBegin():element->GetCaretEnd();
 					bool focused=element->GetFocused();
+					vint height=element->GetLines().GetRowHeight();
 					
 					renderTarget->SetTextAntialias(oldFont.antialias, oldFont.verticalAntialias);
 
-					for(vint row=startRow;row<=endRow;row++)
+					element->BuildTextRuns(bounds.GetSize(), runs);
+					for(vint i=0;i<runs.Count();i++)
 					{
-						Rect startRect=element->GetLines().GetRectFromTextPos(TextPos(row, 0));
-						Point startPoint=startRect.LeftTop();
-						vint startColumn=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x1, startPoint.y)).column;
-						vint endColumn=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x2, startPoint.y)).column;
-						text::TextLine& line=element->GetLines().GetLine(row);
-
-						vint x=startColumn==0?0:line.att[startColumn-1].rightOffset;
-						for(vint column=startColumn; column<=endColumn; column++)
+						const text::TextRun& run=runs[i];
+						ColorItemResource& color=
+							!run.inSelection?colors[run.colorIndex].normal:
+							focused?colors[run.colorIndex].selectedFocused:
+							colors[run.colorIndex].selectedUnfocused;
+						vint tx=run.x1-viewPosition.x+bounds.x1;
+						vint ty=run.row*height-viewPosition.y+bounds.y1;
+						
+						if(color.background.a>0)
 						{
-							bool inSelection=false;
-							if(selectionBegin.row==selectionEnd.row)
-							{
-								inSelection=(row==selectionBegin.row && selectionBegin.column<=column && column<selectionEnd.column);
-							}
-							else if(row==selectionBegin.row)
-							{
-								inSelection=selectionBegin.column<=column;
-							}
-							else if(row==selectionEnd.row)
-							{
-								inSelection=column<selectionEnd.column;
-							}
-							else
-							{
-								inSelection=selectionBegin.row<row && row<selectionEnd.row;
-							}
-							
-							bool crlf=column==line.dataLength;
-							vint colorIndex=crlf?0:line.att[column].colorIndex;
-							if(colorIndex>=colors.Count())
-							{
-								colorIndex=0;
-							}
-							ColorItemResource& color=
-								!inSelection?colors[colorIndex].normal:
-								focused?colors[colorIndex].selectedFocused:
-								colors[colorIndex].selectedUnfocused;
-							vint x2=crlf?x+startRect.Height()/2:line.att[column].rightOffset;
-							vint tx=x-viewPosition.x+bounds.x1;
-							vint ty=startPoint.y-viewPosition.y+bounds.y1;
-							
-							if(color.background.a>0)
-							{
-								d2dRenderTarget->FillRectangle(D2D1::RectF((FLOAT)tx, (FLOAT)ty, (FLOAT)(tx+(x2-x)), (FLOAT)(ty+startRect.Height())), color.backgroundBrush);
-							}
-							if(!crlf)
+							d2dRenderTarget->FillRectangle(D2D1::RectF((FLOAT)tx, (FLOAT)ty, (FLOAT)(tx+(run.x2-run.x1)), (FLOAT)(ty+height)), color.backgroundBrush);
+						}
+						if(!run.lineBreak)
+						{
+							// characters are measured one by one, so they are also drawn one by one to keep them at measured positions
+							text::TextLine& line=element->GetLines().GetLine(run.row);
+							for(vint column=run.startColumn;column<run.endColumn;column++)
 							{
+								vint x=(column==0?0:line.att[column-1].rightOffset)-viewPosition.x+bounds.x1;
 								d2dRenderTarget->DrawText(
 									(passwordChar?&passwordChar:&line.text[column]),
 									1,
 									textFormat->textFormat.Obj(),
-									D2D1::RectF((FLOAT)tx, (FLOAT)ty, (FLOAT)tx+1, (FLOAT)ty+1),
+									D2D1::RectF((FLOAT)x, (FLOAT)ty, (FLOAT)x+1, (FLOAT)ty+1),
 									color.textBrush,
 									D2D1_DRAW_TEXT_OPTIONS_NO_SNAP,
 									DWRITE_MEASURING_MODE_GDI_NATURAL
 									);
 							}
-							x=x2;
 						}
 					}
 
@@ -1297,6 +1267,16 @@ GuiDirect2DElementRenderer
 						element->Rendering.Execute(arguments);
 					}
 					renderTarget->PopClipper();
+
+					if(element->GetContinuousRendering())
+					{
+						compositions::GuiGraphicsComposition* composition=element->GetOwnerComposition();
+						compositions::GuiGraphicsHost* host=composition?composition->GetRelatedGraphicsHost():0;
+						if(host)
+						{
+							host->RequestRender();
+						}
+					}
 				}
 			}
 
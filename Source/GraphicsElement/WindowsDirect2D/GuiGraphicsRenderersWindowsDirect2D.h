@@ -205,6 +205,7 @@ Renderers
 				ColorArray						colors;
 				Color							oldCaretColor;
 				ID2D1SolidColorBrush*			caretBrush;
+				collections::List<text::TextRun>	runs;
 				
 				void					CreateTextBrush(IWindowsDirect2DRenderTarget* _renderTarget);
 				void					DestroyTextBrush(IWindowsDirect2DRenderTarget* _renderTarget);
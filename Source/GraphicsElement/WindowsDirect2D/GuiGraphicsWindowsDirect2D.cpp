@@ -16,12 +16,23 @@ GuiDirect2DElement
 ***********************************************************************/
 
 			GuiDirect2DElement::GuiDirect2DElement()
+				:continuousRendering(true)
 			{
 			}
 
 			GuiDirect2DElement::~GuiDirect2DElement()
 			{
 			}
+
+			bool GuiDirect2DElement::GetContinuousRendering()
+			{
+				return continuousRendering;
+			}
+
+			void GuiDirect2DElement::SetContinuousRendering(bool value)
+			{
+				continuousRendering=value;
+			}
 		}
 
 		namespace elements_windows_d2d
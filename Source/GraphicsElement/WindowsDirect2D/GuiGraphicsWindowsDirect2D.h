@@ -60,9 +60,23 @@ Raw API Rendering Element
 			{
 				DEFINE_GUI_GRAPHICS_ELEMENT(GuiDirect2DElement, L"Direct2DElement")
 			protected:
+				bool							continuousRendering;
+
 				GuiDirect2DElement();
 			public:
 				~GuiDirect2DElement();
+
+				/// <summary>
+				/// Test if the graphics host renders again in the next frame after this element is rendered.
+				/// A graphics host only renders when a composition or an element is changed, but the content of this element is drawn in the <see cref="Rendering"/> event, which the graphics host cannot see.
+				/// The default value is true, so that an element that draws an animation in every <see cref="Rendering"/> event keeps working.
+				/// Set it to false and call [M:vl.presentation.compositions.GuiGraphicsHost.RequestRender] when the content is changed, to stop rendering frames when nothing is changed.
+				/// </summary>
+				/// <returns>Returns true if the graphics host renders again in the next frame.</returns>
+				bool							GetContinuousRendering();
+				/// <summary>Set if the graphics host renders again in the next frame after this element is rendered.</summary>
+				/// <param name="value">Set to true to render again in the next frame.</param>
+				void							SetContinuousRendering(bool value);
 				
 				/// <summary>Render target changed (before) event. Resources that binded to the render target can be released at this moment.</summary>
 				compositions::GuiGraphicsEvent<GuiDirect2DElementEventArgs>		BeforeRenderTargetChanged;
@@ -1,4 +1,5 @@
 #include "GuiGraphicsRenderersWindowsGDI.h"
+#include "..\GuiGraphicsHost.h"
 
 namespace vl
 {
@@ -838,6 +839,7 @@ GuiColorizedTextElementRenderer
 				element->SetCallback(this);
 				oldCaretColor=element->GetCaretColor();
 				caretPen=resourceManager->CreateGdiPen(oldCaretColor);
+				runs.SetLessMemoryMode(false);
 			}
 
 			void GuiColorizedTextElementRenderer::FinalizeInternal()
@@ -866,75 +868,49 @@ GuiColorizedTextElementRenderer
 					
 					wchar_t passwordChar=element->GetPasswordChar();
 					Point viewPosition=element->GetViewPosition();
-					Rect viewBounds(viewPosition, bounds.GetSize());
-					vint startRow=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x1, viewBounds.y1)).row;
-					vint endRow=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x2, viewBounds.y2)).row;
-					TextPos selectionBegin=element->GetCaretBegin()<element->GetCaretEnd()?element->GetCaretBegin():element->GetCaretEnd();
-					TextPos selectionEnd=element->GetCaretBegin()>element->GetCaretEnd()?element->GetCaretBegin():element->GetCaretEnd();
 					bool focused=element->GetFocused();
+					vint height=element->GetLines().GetRowHeight();
 					Ptr<windows::WinBrush> lastBrush=0;
 
-					for(vint row=startRow;row<=endRow;row++)
+					Array<wchar_t> passwordBuffer;
+					element->BuildTextRuns(bounds.GetSize(), runs);
+					for(vint i=0;i<runs.Count();i++)
 					{
-						Rect startRect=element->GetLines().GetRectFromTextPos(TextPos(row, 0));
-						Point startPoint=startRect.LeftTop();
-						vint startColumn=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x1, startPoint.y)).column;
-						vint endColumn=element->GetLines().GetTextPosFromPoint(Point(viewBounds.x2, startPoint.y)).column;
-						text::TextLine& line=element->GetLines().GetLine(row);
-
-						vint x=startColumn==0?0:line.att[startColumn-1].rightOffset;
-						for(vint column=startColumn; column<=endColumn; column++)
+						const text::TextRun& run=runs[i];
+						ColorItemResource& color=
+							!run.inSelection?colors[run.colorIndex].normal:
+							focused?colors[run.colorIndex].selectedFocused:
+							colors[run.colorIndex].selectedUnfocused;
+						vint tx=run.x1-viewPosition.x+bounds.x1;
+						vint ty=run.row*height-viewPosition.y+bounds.y1;
+
+						if(color.background.a)
 						{
-							bool inSelection=false;
-							if(selectionBegin.row==selectionEnd.row)
+							if(lastBrush!=color.backgroundBrush)
 							{
-								inSelection=(row==selectionBegin.row && selectionBegin.column<=column && column<selectionEnd.column);
+								lastBrush=color.backgroundBrush;
+								dc->SetBrush(lastBrush);
 							}
-							else if(row==selectionBegin.row)
-							{
-								inSelection=selectionBegin.column<=column;
-							}
-							else if(row==selectionEnd.row)
-							{
-								inSelection=column<selectionEnd.column;
-							}
-							else
-							{
-								inSelection=selectionBegin.row<row && row<selectionEnd.row;
-							}
-							
-							bool crlf=column==line.dataLength;
-							vint colorIndex=crlf?0:line.att[column].colorIndex;
-							if(colorIndex>=colors.Count())
-							{
-								colorIndex=0;
-							}
-							ColorItemResource& color=
-								!inSelection?colors[colorIndex].normal:
-								focused?colors[colorIndex].selectedFocused:
-								colors[colorIndex].selectedUnfocused;
-							vint x2=crlf?x+startRect.Height()/2:line.att[column].rightOffset;
-							vint tx=x-viewPosition.x+bounds.x1;
-							vint ty=startPoint.y-viewPosition.y+bounds.y1;
-							
-							if(color.background.a)
-							{
-								if(lastBrush!=color.backgroundBrush)
-								{
-									lastBrush=color.backgroundBrush;
-									dc->SetBrush(lastBrush);
-								}
-								dc->FillRect(tx, ty, tx+(x2-x), ty+startRect.Height());
-							}
-							if(!crlf)
+							dc->FillRect(tx, ty, tx+(run.x2-run.x1), ty+height);
+						}
+						if(!run.lineBreak && color.text.a)
+						{
+							vint count=run.endColumn-run.startColumn;
+							const wchar_t* buffer=&element->GetLines().GetLine(run.row).text[run.startColumn];
+							if(passwordChar)
 							{
-								if(color.text.a)
+								if(passwordBuffer.Count()<count)
 								{
-									dc->SetTextColor(RGB(color.text.r, color.text.g, color.text.b));
-									dc->DrawBuffer(tx, ty, (passwordChar?&passwordChar:&line.text[column]), 1);
+									passwordBuffer.Resize(count);
+									for(vint j=0;j<count;j++)
+									{
+										passwordBuffer[j]=passwordChar;
+									}
 								}
+								buffer=&passwordBuffer[0];
 							}
-							x=x2;
+							dc->SetTextColor(RGB(color.text.r, color.text.g, color.text.b));
+							dc->DrawBuffer(tx, ty, buffer, count);
 						}
 					}
 
@@ -999,6 +975,16 @@ GuiGDIElementRenderer
 						element->Rendering.Execute(arguments);
 					}
 					renderTarget->PopClipper();
+
+					if(element->GetContinuousRendering())
+					{
+						compositions::GuiGraphicsComposition* composition=element->GetOwnerComposition();
+						compositions::GuiGraphicsHost* host=composition?composition->GetRelatedGraphicsHost():0;
+						if(host)
+						{
+							host->RequestRender();
+						}
+					}
 				}
 			}
 
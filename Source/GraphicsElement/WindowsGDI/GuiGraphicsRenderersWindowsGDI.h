@@ -206,6 +206,7 @@ Renderers
 				ColorArray				colors;
 				Color					oldCaretColor;
 				Ptr<windows::WinPen>	caretPen;
+				collections::List<text::TextRun>	runs;
 
 				void					DestroyColors();
 				void					ColorChanged();
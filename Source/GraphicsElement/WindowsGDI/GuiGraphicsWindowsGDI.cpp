@@ -15,12 +15,23 @@ GuiGDIElement
 ***********************************************************************/
 
 			GuiGDIElement::GuiGDIElement()
+				:continuousRendering(true)
 			{
 			}
 
 			GuiGDIElement::~GuiGDIElement()
 			{
 			}
+
+			bool GuiGDIElement::GetContinuousRendering()
+			{
+				return continuousRendering;
+			}
+
+			void GuiGDIElement::SetContinuousRendering(bool value)
+			{
+				continuousRendering=value;
+			}
 		}
 
 		namespace elements_windows_gdi
@@ -55,10 +55,24 @@ Raw API Rendering Element
 			{
 				DEFINE_GUI_GRAPHICS_ELEMENT(GuiGDIElement, L"GDIElement")
 			protected:
+				bool							continuousRendering;
+
 				GuiGDIElement();
 			public:
 				~GuiGDIElement();
 
+				/// <summary>
+				/// Test if the graphics host renders again in the next frame after this element is rendered.
+				/// A graphics host only renders when a composition or an element is changed, but the content of this element is drawn in the <see cref="Rendering"/> event, which the graphics host cannot see.
+				/// The default value is true, so that an element that draws an animation in every <see cref="Rendering"/> event keeps working.
+				/// Set it to false and call [M:vl.presentation.compositions.GuiGraphicsHost.RequestRender] when the content is changed, to stop rendering frames when nothing is changed.
+				/// </summary>
+				/// <returns>Returns true if the graphics host renders again in the next frame.</returns>
+				bool							GetContinuousRendering();
+				/// <summary>Set if the graphics host renders again in the next frame after this element is rendered.</summary>
+				/// <param name="value">Set to true to render again in the next frame.</param>
+				void							SetContinuousRendering(bool value);
+
 				/// <summary>Rendering event.</summary>
 				compositions::GuiGraphicsEvent<GuiGDIElementEventArgs>		Rendering;
 			};
@@ -0,0 +1,1354 @@
+#include "HeadlessNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			using namespace collections;
+
+/***********************************************************************
+HeadlessCursor
+***********************************************************************/
+
+			class HeadlessCursor : public Object, public INativeCursor
+			{
+			protected:
+				SystemCursorType					systemCursorType;
+			public:
+				HeadlessCursor(SystemCursorType _systemCursorType)
+					:systemCursorType(_systemCursorType)
+				{
+				}
+
+				bool IsSystemCursor()override
+				{
+					return true;
+				}
+
+				SystemCursorType GetSystemCursorType()override
+				{
+					return systemCursorType;
+				}
+			};
+
+/***********************************************************************
+HeadlessScreen
+***********************************************************************/
+
+			class HeadlessScreen : public Object, public INativeScreen
+			{
+			protected:
+				Size								size;
+			public:
+				HeadlessScreen(Size _size)
+					:size(_size)
+				{
+				}
+
+				Rect GetBounds()override
+				{
+					return Rect(Point(0, 0), size);
+				}
+
+				Rect GetClientBounds()override
+				{
+					return Rect(Point(0, 0), size);
+				}
+
+				WString GetName()override
+				{
+					return L"Headless";
+				}
+
+				bool IsPrimary()override
+				{
+					return true;
+				}
+			};
+
+/***********************************************************************
+HeadlessCallbackService
+***********************************************************************/
+
+			class HeadlessCallbackService : public Object, public INativeCallbackService
+			{
+			protected:
+				List<INativeControllerListener*>	listeners;
+			public:
+				bool InstallListener(INativeControllerListener* listener)override
+				{
+					if(listeners.Contains(listener))
+					{
+						return false;
+					}
+					listeners.Add(listener);
+					return true;
+				}
+
+				bool UninstallListener(INativeControllerListener* listener)override
+				{
+					return listeners.Remove(listener);
+				}
+
+				void InvokeGlobalTimer()
+				{
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->GlobalTimer();
+					}
+				}
+
+				void InvokeClipboardUpdated()
+				{
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->ClipboardUpdated();
+					}
+				}
+
+				void InvokeNativeWindowCreated(INativeWindow* window)
+				{
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->NativeWindowCreated(window);
+					}
+				}
+
+				void InvokeNativeWindowDestroyed(INativeWindow* window)
+				{
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->NativeWindowDestroying(window);
+					}
+				}
+			};
+
+/***********************************************************************
+HeadlessResourceService
+***********************************************************************/
+
+			class HeadlessResourceService : public Object, public INativeResourceService
+			{
+			protected:
+				Ptr<HeadlessCursor>					systemCursors[INativeCursor::SystemCursorCount];
+				FontProperties						defaultFont;
+			public:
+				HeadlessResourceService()
+				{
+					for(vint i=0;i<INativeCursor::SystemCursorCount;i++)
+					{
+						systemCursors[i]=new HeadlessCursor((INativeCursor::SystemCursorType)i);
+					}
+					defaultFont.fontFamily=L"Headless";
+					defaultFont.size=12;
+				}
+
+				INativeCursor* GetSystemCursor(INativeCursor::SystemCursorType type)override
+				{
+					vint index=(vint)type;
+					if(0<=index && index<INativeCursor::SystemCursorCount)
+					{
+						return systemCursors[index].Obj();
+					}
+					return 0;
+				}
+
+				INativeCursor* GetDefaultSystemCursor()override
+				{
+					return GetSystemCursor(INativeCursor::Arrow);
+				}
+
+				FontProperties GetDefaultFont()override
+				{
+					return defaultFont;
+				}
+
+				void SetDefaultFont(const FontProperties& value)override
+				{
+					defaultFont=value;
+				}
+			};
+
+/***********************************************************************
+HeadlessAsyncService
+***********************************************************************/
+
+			class HeadlessAsyncService : public Object, public INativeAsyncService
+			{
+			protected:
+				struct TaskWaiting
+				{
+					Semaphore						semaphore;
+					volatile bool					executed;
+
+					TaskWaiting()
+						:executed(false)
+					{
+						semaphore.Create(0, 1);
+					}
+				};
+
+				struct TaskItem
+				{
+					Ptr<TaskWaiting>				waiting;
+					Func<void()>					proc;
+
+					TaskItem()
+					{
+					}
+
+					TaskItem(Ptr<TaskWaiting> _waiting, const Func<void()>& _proc)
+						:waiting(_waiting)
+						,proc(_proc)
+					{
+					}
+				};
+
+				class DelayItem : public Object, public INativeDelay
+				{
+				public:
+					HeadlessAsyncService*			service;
+					Func<void()>					proc;
+					ExecuteStatus					status;
+					DateTime						executeTime;
+					bool							executeInMainThread;
+
+					DelayItem(HeadlessAsyncService* _service, const Func<void()>& _proc, bool _executeInMainThread, vint milliseconds)
+						:service(_service)
+						,proc(_proc)
+						,status(INativeDelay::Pending)
+						,executeTime(DateTime::LocalTime().Forward(milliseconds))
+						,executeInMainThread(_executeInMainThread)
+					{
+					}
+
+					ExecuteStatus GetStatus()override
+					{
+						return status;
+					}
+
+					bool Delay(vint milliseconds)override
+					{
+						SPIN_LOCK(service->taskListLock)
+						{
+							if(status==INativeDelay::Pending)
+							{
+								executeTime=DateTime::LocalTime().Forward(milliseconds);
+								return true;
+							}
+						}
+						return false;
+					}
+
+					bool Cancel()override
+					{
+						SPIN_LOCK(service->taskListLock)
+						{
+							if(status==INativeDelay::Pending)
+							{
+								if(service->delayItems.Remove(this))
+								{
+									status=INativeDelay::Canceled;
+									return true;
+								}
+							}
+						}
+						return false;
+					}
+				};
+			protected:
+				vint								mainThreadId;
+				SpinLock							taskListLock;
+				List<TaskItem>						taskItems;
+				List<Ptr<DelayItem>>				delayItems;
+			public:
+				HeadlessAsyncService()
+					:mainThreadId(Thread::GetCurrentThreadId())
+				{
+				}
+
+				void ExecuteAsyncTasks()
+				{
+					DateTime now=DateTime::LocalTime();
+					Array<TaskItem> items;
+					List<Ptr<DelayItem>> executableDelayItems;
+
+					SPIN_LOCK(taskListLock)
+					{
+						CopyFrom(items, taskItems);
+						taskItems.RemoveRange(0, items.Count());
+						for(vint i=delayItems.Count()-1;i>=0;i--)
+						{
+							Ptr<DelayItem> item=delayItems[i];
+							if(now.filetime>=item->executeTime.filetime)
+							{
+								item->status=INativeDelay::Executing;
+								executableDelayItems.Add(item);
+								delayItems.RemoveAt(i);
+							}
+						}
+					}
+
+					FOREACH(TaskItem, item, items)
+					{
+						item.proc();
+						if(item.waiting)
+						{
+							item.waiting->executed=true;
+							item.waiting->semaphore.Release();
+						}
+					}
+					FOREACH(Ptr<DelayItem>, item, executableDelayItems)
+					{
+						if(item->executeInMainThread)
+						{
+							item->proc();
+							item->status=INativeDelay::Executed;
+						}
+						else
+						{
+							InvokeAsync([=]()
+							{
+								item->proc();
+								item->status=INativeDelay::Executed;
+							});
+						}
+					}
+				}
+
+				bool IsInMainThread()override
+				{
+					return Thread::GetCurrentThreadId()==mainThreadId;
+				}
+
+				void InvokeAsync(const Func<void()>& proc)override
+				{
+					ThreadPoolLite::Queue(proc);
+				}
+
+				void InvokeInMainThread(const Func<void()>& proc)override
+				{
+					SPIN_LOCK(taskListLock)
+					{
+						taskItems.Add(TaskItem(0, proc));
+					}
+				}
+
+				bool InvokeInMainThreadAndWait(const Func<void()>& proc, vint milliseconds)override
+				{
+					Ptr<TaskWaiting> waiting=new TaskWaiting;
+					SPIN_LOCK(taskListLock)
+					{
+						taskItems.Add(TaskItem(waiting, proc));
+					}
+
+					if(milliseconds<0)
+					{
+						return waiting->semaphore.Wait();
+					}
+					else
+					{
+						// semaphores cannot wait with a timeout on every platform, so the task is polled instead
+						DateTime timeout=DateTime::LocalTime().Forward(milliseconds);
+						while(!waiting->executed)
+						{
+							if(DateTime::LocalTime().filetime>=timeout.filetime)
+							{
+								return false;
+							}
+							Thread::Sleep(1);
+						}
+						return true;
+					}
+				}
+
+				Ptr<INativeDelay> DelayExecute(const Func<void()>& proc, vint milliseconds)override
+				{
+					Ptr<DelayItem> delay;
+					SPIN_LOCK(taskListLock)
+					{
+						delay=new DelayItem(this, proc, false, milliseconds);
+						delayItems.Add(delay);
+					}
+					return delay;
+				}
+
+				Ptr<INativeDelay> DelayExecuteInMainThread(const Func<void()>& proc, vint milliseconds)override
+				{
+					Ptr<DelayItem> delay;
+					SPIN_LOCK(taskListLock)
+					{
+						delay=new DelayItem(this, proc, true, milliseconds);
+						delayItems.Add(delay);
+					}
+					return delay;
+				}
+			};
+
+/***********************************************************************
+HeadlessClipboardService
+***********************************************************************/
+
+			class HeadlessClipboardService : public Object, public INativeClipboardService
+			{
+			protected:
+				HeadlessCallbackService*			callbackService;
+				bool								containsText;
+				WString								text;
+			public:
+				HeadlessClipboardService(HeadlessCallbackService* _callbackService)
+					:callbackService(_callbackService)
+					,containsText(false)
+				{
+				}
+
+				bool ContainsText()override
+				{
+					return containsText;
+				}
+
+				WString GetText()override
+				{
+					return text;
+				}
+
+				bool SetText(const WString& value)override
+				{
+					containsText=true;
+					text=value;
+					callbackService->InvokeClipboardUpdated();
+					return true;
+				}
+			};
+
+/***********************************************************************
+HeadlessImageService
+***********************************************************************/
+
+			class HeadlessImageService : public Object, public INativeImageService
+			{
+			public:
+				Ptr<INativeImage> CreateImageFromFile(const WString& path)override
+				{
+					return 0;
+				}
+
+				Ptr<INativeImage> CreateImageFromMemory(void* buffer, vint length)override
+				{
+					return 0;
+				}
+
+				Ptr<INativeImage> CreateImageFromStream(stream::IStream& stream)override
+				{
+					return 0;
+				}
+			};
+
+/***********************************************************************
+HeadlessScreenService
+***********************************************************************/
+
+			class HeadlessScreenService : public Object, public INativeScreenService
+			{
+			protected:
+				HeadlessScreen						screen;
+			public:
+				HeadlessScreenService(Size screenSize)
+					:screen(screenSize)
+				{
+				}
+
+				vint GetScreenCount()override
+				{
+					return 1;
+				}
+
+				INativeScreen* GetScreen(vint index)override
+				{
+					return index==0?&screen:0;
+				}
+
+				INativeScreen* GetScreen(INativeWindow* window)override
+				{
+					return &screen;
+				}
+			};
+
+/***********************************************************************
+HeadlessInputService
+***********************************************************************/
+
+			class HeadlessInputService : public Object, public INativeInputService
+			{
+			protected:
+				bool								isHookingMouse;
+				bool								isTimerEnabled;
+				Dictionary<vint, WString>			keyNames;
+				Dictionary<WString, vint>			keys;
+
+				void RegisterKey(vint code, const WString& name)
+				{
+					keyNames.Add(code, name);
+					keys.Add(name, code);
+				}
+			public:
+				HeadlessInputService()
+					:isHookingMouse(false)
+					,isTimerEnabled(false)
+				{
+					for(vint i=0;i<26;i++)
+					{
+						RegisterKey(VKEY_A+i, WString((wchar_t)(L'A'+i)));
+					}
+					for(vint i=0;i<10;i++)
+					{
+						RegisterKey(VKEY_0+i, WString((wchar_t)(L'0'+i)));
+					}
+					for(vint i=0;i<24;i++)
+					{
+						RegisterKey(VKEY_F1+i, L"F"+itow(i+1));
+					}
+					RegisterKey(VKEY_BACK, L"Backspace");
+					RegisterKey(VKEY_TAB, L"Tab");
+					RegisterKey(VKEY_RETURN, L"Enter");
+					RegisterKey(VKEY_SHIFT, L"Shift");
+					RegisterKey(VKEY_CONTROL, L"Ctrl");
+					RegisterKey(VKEY_MENU, L"Alt");
+					RegisterKey(VKEY_ESCAPE, L"Esc");
+					RegisterKey(VKEY_SPACE, L"Space");
+					RegisterKey(VKEY_PRIOR, L"Page Up");
+					RegisterKey(VKEY_NEXT, L"Page Down");
+					RegisterKey(VKEY_END, L"End");
+					RegisterKey(VKEY_HOME, L"Home");
+					RegisterKey(VKEY_LEFT, L"Left");
+					RegisterKey(VKEY_UP, L"Up");
+					RegisterKey(VKEY_RIGHT, L"Right");
+					RegisterKey(VKEY_DOWN, L"Down");
+					RegisterKey(VKEY_INSERT, L"Insert");
+					RegisterKey(VKEY_DELETE, L"Delete");
+				}
+
+				void StartHookMouse()override
+				{
+					isHookingMouse=true;
+				}
+
+				void StopHookMouse()override
+				{
+					isHookingMouse=false;
+				}
+
+				bool IsHookingMouse()override
+				{
+					return isHookingMouse;
+				}
+
+				void StartTimer()override
+				{
+					isTimerEnabled=true;
+				}
+
+				void StopTimer()override
+				{
+					isTimerEnabled=false;
+				}
+
+				bool IsTimerEnabled()override
+				{
+					return isTimerEnabled;
+				}
+
+				bool IsKeyPressing(vint code)override
+				{
+					return false;
+				}
+
+				bool IsKeyToggled(vint code)override
+				{
+					return false;
+				}
+
+				WString GetKeyName(vint code)override
+				{
+					vint index=keyNames.Keys().IndexOf(code);
+					return index==-1?L"?":keyNames.Values()[index];
+				}
+
+				vint GetKey(const WString& name)override
+				{
+					vint index=keys.Keys().IndexOf(name);
+					return index==-1?-1:keys.Values()[index];
+				}
+			};
+
+/***********************************************************************
+HeadlessDialogService
+***********************************************************************/
+
+			class HeadlessDialogService : public Object, public INativeDialogService
+			{
+			public:
+				MessageBoxButtonsOutput ShowMessageBox(INativeWindow* window, const WString& text, const WString& title, MessageBoxButtonsInput buttons, MessageBoxDefaultButton defaultButton, MessageBoxIcons icon, MessageBoxModalOptions modal)override
+				{
+					// there is nobody to click, so the default button is always chosen
+					MessageBoxButtonsOutput outputs[3]={SelectOK, SelectOK, SelectOK};
+					vint count=1;
+					switch(buttons)
+					{
+					case DisplayOK:
+						outputs[0]=SelectOK;
+						break;
+					case DisplayOKCancel:
+						outputs[0]=SelectOK;
+						outputs[1]=SelectCancel;
+						count=2;
+						break;
+					case DisplayYesNo:
+						outputs[0]=SelectYes;
+						outputs[1]=SelectNo;
+						count=2;
+						break;
+					case DisplayYesNoCancel:
+						outputs[0]=SelectYes;
+						outputs[1]=SelectNo;
+						outputs[2]=SelectCancel;
+						count=3;
+						break;
+					case DisplayRetryCancel:
+						outputs[0]=SelectRetry;
+						outputs[1]=SelectCancel;
+						count=2;
+						break;
+					case DisplayAbortRetryIgnore:
+						outputs[0]=SelectAbort;
+						outputs[1]=SelectRetry;
+						outputs[2]=SelectIgnore;
+						count=3;
+						break;
+					case DisplayCancelTryAgainContinue:
+						outputs[0]=SelectCancel;
+						outputs[1]=SelectTryAgain;
+						outputs[2]=SelectContinue;
+						count=3;
+						break;
+					}
+					vint index=(vint)defaultButton;
+					return outputs[index<count?index:0];
+				}
+
+				bool ShowColorDialog(INativeWindow* window, Color& selection, bool selected, ColorDialogCustomColorOptions customColorOptions, Color* customColors)override
+				{
+					return false;
+				}
+
+				bool ShowFontDialog(INativeWindow* window, FontProperties& selectionFont, Color& selectionColor, bool selected, bool showEffect, bool forceFontExist)override
+				{
+					return false;
+				}
+
+				bool ShowFileDialog(INativeWindow* window, collections::List<WString>& selectionFileNames, vint& selectionFilterIndex, FileDialogTypes dialogType, const WString& title, const WString& initialFileName, const WString& initialDirectory, const WString& defaultExtension, const WString& filter, FileDialogOptions options)override
+				{
+					return false;
+				}
+			};
+
+/***********************************************************************
+HeadlessForm
+***********************************************************************/
+
+			class HeadlessForm : public Object, public INativeWindow, public IHeadlessForm
+			{
+			protected:
+				List<INativeWindowListener*>		listeners;
+				Interface*							graphicsHandler;
+				Rect								bounds;
+				WString								title;
+				INativeCursor*						cursor;
+				Point								caretPoint;
+				HeadlessForm*						parentWindow;
+				bool								alwaysPassFocusToParent;
+				bool								customFrameMode;
+				WindowSizeState						sizeState;
+				bool								visible;
+				bool								enabled;
+				bool								focused;
+				bool								activated;
+				bool								appearedInTaskBar;
+				bool								enabledActivate;
+				bool								capturing;
+				bool								maximizedBox;
+				bool								minimizedBox;
+				bool								border;
+				bool								sizeBox;
+				bool								iconVisible;
+				bool								titleBar;
+				bool								topMost;
+
+				void SetFocusInternal(bool value)
+				{
+					if(focused!=value)
+					{
+						focused=value;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							if(value)
+							{
+								listeners[i]->GotFocus();
+							}
+							else
+							{
+								listeners[i]->LostFocus();
+							}
+						}
+					}
+				}
+
+				void SetActivateInternal(bool value)
+				{
+					if(activated!=value)
+					{
+						activated=value;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							if(value)
+							{
+								listeners[i]->Activated();
+							}
+							else
+							{
+								listeners[i]->Deactivated();
+							}
+						}
+					}
+				}
+
+				void ShowInternal(WindowSizeState state, bool activate)
+				{
+					sizeState=state;
+					if(!visible)
+					{
+						visible=true;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Opened();
+						}
+					}
+					if(activate && enabledActivate)
+					{
+						SetActivateInternal(true);
+						SetFocusInternal(true);
+					}
+				}
+			public:
+				HeadlessForm()
+					:graphicsHandler(0)
+					,bounds(0, 0, 0, 0)
+					,cursor(0)
+					,parentWindow(0)
+					,alwaysPassFocusToParent(false)
+					,customFrameMode(false)
+					,sizeState(Restored)
+					,visible(false)
+					,enabled(true)
+					,focused(false)
+					,activated(false)
+					,appearedInTaskBar(true)
+					,enabledActivate(true)
+					,capturing(false)
+					,maximizedBox(true)
+					,minimizedBox(true)
+					,border(true)
+					,sizeBox(true)
+					,iconVisible(true)
+					,titleBar(true)
+					,topMost(false)
+				{
+				}
+
+				~HeadlessForm()
+				{
+					List<INativeWindowListener*> copiedListeners;
+					CopyFrom(copiedListeners, listeners);
+					for(vint i=0;i<copiedListeners.Count();i++)
+					{
+						INativeWindowListener* listener=copiedListeners[i];
+						if(listeners.Contains(listener))
+						{
+							listener->Destroyed();
+						}
+					}
+				}
+
+				void InvokeDestroying()
+				{
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->Destroying();
+					}
+				}
+
+				Interface* GetGraphicsHandler()override
+				{
+					return graphicsHandler;
+				}
+
+				void SetGraphicsHandler(Interface* handler)override
+				{
+					graphicsHandler=handler;
+				}
+
+				const List<INativeWindowListener*>& GetListeners()override
+				{
+					return listeners;
+				}
+
+				Rect GetBounds()override
+				{
+					return bounds;
+				}
+
+				void SetBounds(const Rect& _bounds)override
+				{
+					Rect newBounds=_bounds;
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->Moving(newBounds, true);
+					}
+					if(bounds!=newBounds)
+					{
+						bounds=newBounds;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Moved();
+						}
+					}
+				}
+
+				Size GetClientSize()override
+				{
+					return bounds.GetSize();
+				}
+
+				void SetClientSize(Size size)override
+				{
+					SetBounds(Rect(bounds.LeftTop(), size));
+				}
+
+				Rect GetClientBoundsInScreen()override
+				{
+					return bounds;
+				}
+
+				WString GetTitle()override
+				{
+					return title;
+				}
+
+				void SetTitle(WString _title)override
+				{
+					title=_title;
+				}
+
+				INativeCursor* GetWindowCursor()override
+				{
+					return cursor;
+				}
+
+				void SetWindowCursor(INativeCursor* _cursor)override
+				{
+					cursor=_cursor;
+				}
+
+				Point GetCaretPoint()override
+				{
+					return caretPoint;
+				}
+
+				void SetCaretPoint(Point point)override
+				{
+					caretPoint=point;
+				}
+
+				INativeWindow* GetParent()override
+				{
+					return parentWindow;
+				}
+
+				void SetParent(INativeWindow* parent)override
+				{
+					parentWindow=dynamic_cast<HeadlessForm*>(parent);
+				}
+
+				bool GetAlwaysPassFocusToParent()override
+				{
+					return alwaysPassFocusToParent;
+				}
+
+				void SetAlwaysPassFocusToParent(bool value)override
+				{
+					alwaysPassFocusToParent=value;
+				}
+
+				void EnableCustomFrameMode()override
+				{
+					customFrameMode=true;
+				}
+
+				void DisableCustomFrameMode()override
+				{
+					customFrameMode=false;
+				}
+
+				bool IsCustomFrameModeEnabled()override
+				{
+					return customFrameMode;
+				}
+
+				WindowSizeState GetSizeState()override
+				{
+					return sizeState;
+				}
+
+				void Show()override
+				{
+					ShowInternal(sizeState, true);
+				}
+
+				void ShowDeactivated()override
+				{
+					ShowInternal(sizeState, false);
+				}
+
+				void ShowRestored()override
+				{
+					ShowInternal(Restored, true);
+				}
+
+				void ShowMaximized()override
+				{
+					ShowInternal(Maximized, true);
+				}
+
+				void ShowMinimized()override
+				{
+					ShowInternal(Minimized, false);
+				}
+
+				void Hide()override
+				{
+					if(visible)
+					{
+						SetFocusInternal(false);
+						SetActivateInternal(false);
+						visible=false;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Closed();
+						}
+					}
+				}
+
+				bool IsVisible()override
+				{
+					return visible;
+				}
+
+				void Enable()override
+				{
+					if(!enabled)
+					{
+						enabled=true;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Enabled();
+						}
+					}
+				}
+
+				void Disable()override
+				{
+					if(enabled)
+					{
+						enabled=false;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Disabled();
+						}
+					}
+				}
+
+				bool IsEnabled()override
+				{
+					return enabled;
+				}
+
+				void SetFocus()override
+				{
+					if(alwaysPassFocusToParent && parentWindow)
+					{
+						parentWindow->SetFocus();
+					}
+					else
+					{
+						SetFocusInternal(true);
+					}
+				}
+
+				bool IsFocused()override
+				{
+					return focused;
+				}
+
+				void SetActivate()override
+				{
+					SetActivateInternal(true);
+				}
+
+				bool IsActivated()override
+				{
+					return activated;
+				}
+
+				void ShowInTaskBar()override
+				{
+					appearedInTaskBar=true;
+				}
+
+				void HideInTaskBar()override
+				{
+					appearedInTaskBar=false;
+				}
+
+				bool IsAppearedInTaskBar()override
+				{
+					return appearedInTaskBar;
+				}
+
+				void EnableActivate()override
+				{
+					enabledActivate=true;
+				}
+
+				void DisableActivate()override
+				{
+					enabledActivate=false;
+				}
+
+				bool IsEnabledActivate()override
+				{
+					return enabledActivate;
+				}
+
+				bool RequireCapture()override
+				{
+					capturing=true;
+					return true;
+				}
+
+				bool ReleaseCapture()override
+				{
+					capturing=false;
+					return true;
+				}
+
+				bool IsCapturing()override
+				{
+					return capturing;
+				}
+
+				bool GetMaximizedBox()override
+				{
+					return maximizedBox;
+				}
+
+				void SetMaximizedBox(bool visible)override
+				{
+					maximizedBox=visible;
+				}
+
+				bool GetMinimizedBox()override
+				{
+					return minimizedBox;
+				}
+
+				void SetMinimizedBox(bool visible)override
+				{
+					minimizedBox=visible;
+				}
+
+				bool GetBorder()override
+				{
+					return border;
+				}
+
+				void SetBorder(bool visible)override
+				{
+					border=visible;
+				}
+
+				bool GetSizeBox()override
+				{
+					return sizeBox;
+				}
+
+				void SetSizeBox(bool visible)override
+				{
+					sizeBox=visible;
+				}
+
+				bool GetIconVisible()override
+				{
+					return iconVisible;
+				}
+
+				void SetIconVisible(bool visible)override
+				{
+					iconVisible=visible;
+				}
+
+				bool GetTitleBar()override
+				{
+					return titleBar;
+				}
+
+				void SetTitleBar(bool visible)override
+				{
+					titleBar=visible;
+				}
+
+				bool GetTopMost()override
+				{
+					return topMost;
+				}
+
+				void SetTopMost(bool topmost)override
+				{
+					topMost=topmost;
+				}
+
+				void SupressAlt()override
+				{
+				}
+
+				bool InstallListener(INativeWindowListener* listener)override
+				{
+					if(listeners.Contains(listener))
+					{
+						return false;
+					}
+					listeners.Add(listener);
+					return true;
+				}
+
+				bool UninstallListener(INativeWindowListener* listener)override
+				{
+					return listeners.Remove(listener);
+				}
+
+				void RedrawContent()override
+				{
+				}
+			};
+
+/***********************************************************************
+HeadlessController
+***********************************************************************/
+
+			class HeadlessController : public Object, public virtual INativeController, public virtual INativeWindowService
+			{
+			public:
+				static const vint					FrameInterval=16;
+			protected:
+				List<Ptr<HeadlessForm>>				windows;
+				INativeWindow*						mainWindow;
+
+				HeadlessCallbackService				callbackService;
+				HeadlessResourceService				resourceService;
+				HeadlessAsyncService				asyncService;
+				HeadlessClipboardService			clipboardService;
+				HeadlessImageService				imageService;
+				HeadlessScreenService				screenService;
+				HeadlessInputService				inputService;
+				HeadlessDialogService				dialogService;
+
+			public:
+				HeadlessController(Size screenSize)
+					:mainWindow(0)
+					,clipboardService(&callbackService)
+					,screenService(screenSize)
+				{
+				}
+
+				~HeadlessController()
+				{
+					inputService.StopTimer();
+					inputService.StopHookMouse();
+				}
+
+				void ProcessFrame()
+				{
+					asyncService.ExecuteAsyncTasks();
+					if(inputService.IsTimerEnabled())
+					{
+						callbackService.InvokeGlobalTimer();
+					}
+				}
+
+				//=======================================================================
+
+				INativeWindow* CreateNativeWindow()override
+				{
+					Ptr<HeadlessForm> window=new HeadlessForm;
+					windows.Add(window);
+					callbackService.InvokeNativeWindowCreated(window.Obj());
+					window->SetWindowCursor(resourceService.GetDefaultSystemCursor());
+					return window.Obj();
+				}
+
+				void DestroyNativeWindow(INativeWindow* window)override
+				{
+					HeadlessForm* headlessForm=dynamic_cast<HeadlessForm*>(window);
+					if(!headlessForm) return;
+					vint index=windows.IndexOf(headlessForm);
+					if(index==-1) return;
+
+					Ptr<HeadlessForm> form=windows[index];
+					form->InvokeDestroying();
+					callbackService.InvokeNativeWindowDestroyed(window);
+					windows.RemoveAt(index);
+
+					if(window==mainWindow)
+					{
+						// destroying the main window ends the application, just like the Windows implementation
+						mainWindow=0;
+						FOREACH(Ptr<HeadlessForm>, other, windows)
+						{
+							other->Hide();
+						}
+						while(windows.Count())
+						{
+							DestroyNativeWindow(windows[0].Obj());
+						}
+					}
+				}
+
+				INativeWindow* GetMainWindow()override
+				{
+					return mainWindow;
+				}
+
+				void Run(INativeWindow* window)override
+				{
+					mainWindow=window;
+					mainWindow->Show();
+					while(mainWindow)
+					{
+						ProcessFrame();
+						Thread::Sleep(FrameInterval);
+					}
+					asyncService.ExecuteAsyncTasks();
+				}
+
+				INativeWindow* GetWindow(Point location)override
+				{
+					for(vint i=windows.Count()-1;i>=0;i--)
+					{
+						HeadlessForm* window=windows[i].Obj();
+						if(window->IsVisible() && window->GetBounds().Contains(location))
+						{
+							return window;
+						}
+					}
+					return 0;
+				}
+
+				//=======================================================================
+
+				INativeCallbackService* CallbackService()override
+				{
+					return &callbackService;
+				}
+
+				INativeResourceService* ResourceService()override
+				{
+					return &resourceService;
+				}
+
+				INativeAsyncService* AsyncService()override
+				{
+					return &asyncService;
+				}
+
+				INativeClipboardService* ClipboardService()override
+				{
+					return &clipboardService;
+				}
+
+				INativeImageService* ImageService()override
+				{
+					return &imageService;
+				}
+
+				INativeScreenService* ScreenService()override
+				{
+					return &screenService;
+				}
+
+				INativeWindowService* WindowService()override
+				{
+					return this;
+				}
+
+				INativeInputService* InputService()override
+				{
+					return &inputService;
+				}
+
+				INativeDialogService* DialogService()override
+				{
+					return &dialogService;
+				}
+
+				WString GetOSVersion()override
+				{
+					return L"Headless";
+				}
+
+				WString GetExecutablePath()override
+				{
+					return L"";
+				}
+			};
+
+/***********************************************************************
+Headless Native Controller
+***********************************************************************/
+
+			INativeController* CreateHeadlessNativeController(Size screenSize)
+			{
+				return new HeadlessController(screenSize);
+			}
+
+			IHeadlessForm* GetHeadlessForm(INativeWindow* window)
+			{
+				return dynamic_cast<HeadlessForm*>(window);
+			}
+
+			void ProcessHeadlessFrame(INativeController* controller)
+			{
+				HeadlessController* headlessController=dynamic_cast<HeadlessController*>(controller);
+				if(headlessController)
+				{
+					headlessController->ProcessFrame();
+				}
+			}
+
+			void DestroyHeadlessNativeController(INativeController* controller)
+			{
+				delete controller;
+			}
+		}
+	}
+}
@@ -0,0 +1,58 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_HEADLESSNATIVEWINDOW
+#define VCZH_PRESENTATION_HEADLESS_HEADLESSNATIVEWINDOW
+
+#include "../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+
+/***********************************************************************
+Headless Native Controller
+***********************************************************************/
+
+			/// <summary>A window that lives only in memory. There is no operating system resource behind it, the renderer stores its own surface in the graphics handler.</summary>
+			class IHeadlessForm : public Interface
+			{
+			public:
+				/// <summary>Get the object that the renderer binds to this window.</summary>
+				/// <returns>The graphics handler.</returns>
+				virtual Interface*							GetGraphicsHandler() = 0;
+				/// <summary>Bind an object from the renderer to this window.</summary>
+				/// <param name="handler">The graphics handler.</param>
+				virtual void								SetGraphicsHandler(Interface* handler) = 0;
+				/// <summary>Get all installed listeners, for sending simulated input to the window.</summary>
+				/// <returns>All installed listeners.</returns>
+				virtual const collections::List<INativeWindowListener*>&	GetListeners() = 0;
+			};
+
+			/// <summary>Create a native controller that does not need any display. Windows are kept in memory and the main loop is driven by an internal clock.</summary>
+			/// <returns>The created controller.</returns>
+			/// <param name="screenSize">The size of the only screen.</param>
+			extern INativeController*						CreateHeadlessNativeController(Size screenSize);
+			/// <summary>Get the headless window interface from a window that is created by a headless controller.</summary>
+			/// <returns>The headless window interface, or null if the window is not created by a headless controller.</returns>
+			/// <param name="window">The window.</param>
+			extern IHeadlessForm*							GetHeadlessForm(INativeWindow* window);
+			/// <summary>Execute all pending tasks and raise the global timer once. Visible windows that need to be rendered are rendered in this call.</summary>
+			/// <param name="controller">The controller created by <see cref="CreateHeadlessNativeController"/>.</param>
+			extern void										ProcessHeadlessFrame(INativeController* controller);
+			/// <summary>Destroy a controller that is created by <see cref="CreateHeadlessNativeController"/>.</summary>
+			/// <param name="controller">The controller.</param>
+			extern void										DestroyHeadlessNativeController(INativeController* controller);
+		}
+	}
+}
+
+#endif
@@ -606,6 +606,11 @@ Type Declaration
 				CLASS_MEMBER_CONSTRUCTOR(Ptr<FixedHeightMultiColumnItemArranger>(), NO_PARAMETER)
 			END_CLASS_MEMBER(FixedHeightMultiColumnItemArranger)
 
+			BEGIN_CLASS_MEMBER(VariableHeightItemArranger)
+				CLASS_MEMBER_BASE(RangedItemArrangerBase)
+				CLASS_MEMBER_CONSTRUCTOR(Ptr<VariableHeightItemArranger>(), NO_PARAMETER)
+			END_CLASS_MEMBER(VariableHeightItemArranger)
+
 			BEGIN_CLASS_MEMBER(ItemStyleControllerBase)
 				CLASS_MEMBER_BASE(GuiListControl::IItemStyleController)
 			END_CLASS_MEMBER(ItemStyleControllerBase)
@@ -1540,6 +1545,7 @@ Type Declaration
 				CLASS_MEMBER_BASE(IStructuredDataSorter)
 				CLASS_MEMBER_CONSTRUCTOR(Ptr<StructuredDataReverseSorter>(), NO_PARAMETER)
 				
+				CLASS_MEMBER_METHOD(GetSubSorter, NO_PARAMETER)
 				CLASS_MEMBER_METHOD(SetSubSorter, {L"value"})
 			END_CLASS_MEMBER(StructuredDataReverseSorter)
 
@@ -1548,6 +1554,7 @@ Type Declaration
 
 				CLASS_MEMBER_PROPERTY_READONLY_FAST(StructuredDataProvider)
 				CLASS_MEMBER_PROPERTY_FAST(AdditionalFilter)
+				CLASS_MEMBER_PROPERTY_FAST(ParallelReordering)
 			END_CLASS_MEMBER(StructuredDataProvider)
 
 			BEGIN_CLASS_MEMBER(StructuredColummProviderBase)
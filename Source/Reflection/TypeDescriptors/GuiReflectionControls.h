@@ -78,6 +78,7 @@ Type List
 			F(presentation::controls::list::FixedHeightItemArranger)\
 			F(presentation::controls::list::FixedSizeMultiColumnItemArranger)\
 			F(presentation::controls::list::FixedHeightMultiColumnItemArranger)\
+			F(presentation::controls::list::VariableHeightItemArranger)\
 			F(presentation::controls::list::ItemStyleControllerBase)\
 			F(presentation::controls::list::TextItemStyleProvider)\
 			F(presentation::controls::list::TextItemStyleProvider::IBulletFactory)\
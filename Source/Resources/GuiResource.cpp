@@ -136,7 +136,7 @@ GlobalStringKey
 		class GlobalStringKeyManager
 		{
 		public:
-			Dictionary<WString, vint>		stoi;
+			HashDictionary<WString, vint>	stoi;
 			List<WString>					itos;
 
 			void InitializeConstants()
@@ -285,6 +285,9 @@ GuiResourceNodeBase
 GuiResourceItem
 ***********************************************************************/
 
+		const vint32_t								PrecompiledBinaryHeader = -1;
+		const vint									PrecompiledBinaryVersion = 1;
+
 		GuiResourceItem::GuiResourceItem()
 		{
 		}
@@ -300,33 +303,66 @@ GuiResourceItem
 
 		Ptr<DescriptableObject> GuiResourceItem::GetContent()
 		{
-			return content;
+			Ptr<DescriptableObject> result;
+			// the content could be accessed from multiple threads, only the first one deserializes it, and others wait until it is done
+			CS_LOCK(contentLock)
+			{
+				if (precompiledContent)
+				{
+					auto precompiled = precompiledContent;
+					precompiledContent = nullptr;
+
+					auto buffer = precompiled->size > 0 ? &precompiled->binary->operator[](precompiled->offset) : nullptr;
+					MemoryWrapperStream stream(buffer, precompiled->size);
+
+					content = precompiled->preloadResolver->DirectLoadStream()->ResolveResourcePrecompiled(stream, loadingErrors);
+					if (content && precompiled->typeResolver != precompiled->preloadResolver)
+					{
+						content = precompiled->typeResolver->IndirectLoad()->ResolveResource(content, 0, loadingErrors);
+					}
+					if (!content && loadingErrors.Count() == 0)
+					{
+						loadingErrors.Add(L"Failed to load resource item \"" + GetName() + L"\" of type \"" + typeName + L"\" from the precompiled binary.");
+					}
+				}
+				result = content;
+			}
+			return result;
+		}
+
+		const collections::List<WString>& GuiResourceItem::GetLoadingErrors()
+		{
+			return loadingErrors;
 		}
 
 		void GuiResourceItem::SetContent(const WString& _typeName, Ptr<DescriptableObject> value)
 		{
-			typeName = _typeName;
-			content = value;
+			CS_LOCK(contentLock)
+			{
+				typeName = _typeName;
+				content = value;
+				precompiledContent = nullptr;
+			}
 		}
 
 		Ptr<GuiImageData> GuiResourceItem::AsImage()
 		{
-			return content.Cast<GuiImageData>();
+			return GetContent().Cast<GuiImageData>();
 		}
 
 		Ptr<parsing::xml::XmlDocument> GuiResourceItem::AsXml()
 		{
-			return content.Cast<XmlDocument>();
+			return GetContent().Cast<XmlDocument>();
 		}
 
 		Ptr<GuiTextData> GuiResourceItem::AsString()
 		{
-			return content.Cast<GuiTextData>();
+			return GetContent().Cast<GuiTextData>();
 		}
 
 		Ptr<DocumentModel> GuiResourceItem::AsDocument()
 		{
-			return content.Cast<DocumentModel>();
+			return GetContent().Cast<DocumentModel>();
 		}
 
 /***********************************************************************
@@ -601,7 +637,7 @@ GuiResourceFolder
 			}
 		}
 
-		void GuiResourceFolder::LoadResourceFolderFromBinary(DelayLoadingList& delayLoadings, stream::internal::ContextFreeReader& reader, collections::List<WString>& typeNames, collections::List<WString>& errors)
+		void GuiResourceFolder::LoadResourceFolderFromBinary(DelayLoadingList& delayLoadings, stream::internal::ContextFreeReader& reader, Ptr<GuiResourceItem::PrecompiledBinary> binary, collections::List<WString>& typeNames, collections::List<WString>& errors)
 		{
 			vint count = 0;
 			reader << count;
@@ -611,6 +647,19 @@ GuiResourceFolder
 				WString name;
 				reader << typeName << name;
 
+				// with a binary, the content is stored in the binary instead of following the name
+				vint offset = 0;
+				vint size = 0;
+				if (binary)
+				{
+					reader << offset << size;
+					if (offset < 0 || size < 0 || offset + size > binary->Count())
+					{
+						errors.Add(L"Content of resource item \"" + name + L"\" is out of the precompiled binary.");
+						continue;
+					}
+				}
+
 				auto resolver = GetResourceResolverManager()->GetTypeResolver(typeNames[typeName]);
 				Ptr<GuiResourceItem> item = new GuiResourceItem;
 				if(AddItem(name, item))
@@ -641,16 +690,43 @@ GuiResourceFolder
 
 					if(typeResolver && preloadResolver)
 					{
-						if (auto directLoad = preloadResolver->DirectLoadStream())
+						auto directLoad = preloadResolver->DirectLoadStream();
+						auto indirectLoad = typeResolver != preloadResolver ? typeResolver->IndirectLoad() : nullptr;
+						bool delayLoad = indirectLoad && indirectLoad->IsDelayLoad();
+
+						if (directLoad && binary && !delayLoad && (typeResolver == preloadResolver || indirectLoad))
+						{
+							// the content is deserialized in GuiResourceItem::GetContent when it is accessed for the first time
+							auto precompiled = MakePtr<GuiResourceItem::PrecompiledContent>();
+							precompiled->binary = binary;
+							precompiled->offset = offset;
+							precompiled->size = size;
+							precompiled->typeResolver = typeResolver;
+							precompiled->preloadResolver = preloadResolver;
+
+							item->typeName = typeResolver->GetType();
+							item->precompiledContent = precompiled;
+						}
+						else if (directLoad)
 						{
 							WString itemType = preloadResolver->GetType();
-							auto resource = directLoad->ResolveResourcePrecompiled(reader.input, errors);
+							Ptr<DescriptableObject> resource;
+							if (binary)
+							{
+								auto buffer = size > 0 ? &binary->operator[](offset) : nullptr;
+								MemoryWrapperStream stream(buffer, size);
+								resource = directLoad->ResolveResourcePrecompiled(stream, errors);
+							}
+							else
+							{
+								resource = directLoad->ResolveResourcePrecompiled(reader.input, errors);
+							}
 
 							if (typeResolver != preloadResolver)
 							{
-								if (auto indirectLoad = typeResolver->IndirectLoad())
+								if (indirectLoad)
 								{
-									if(indirectLoad->IsDelayLoad())
+									if(delayLoad)
 									{
 										DelayLoading delayLoading;
 										delayLoading.type = type;
@@ -677,7 +753,7 @@ GuiResourceFolder
 						}
 					}
 
-					if(!item->GetContent())
+					if(!item->precompiledContent && !item->content)
 					{
 						RemoveItem(name);
 					}
@@ -695,12 +771,12 @@ GuiResourceFolder
 				reader << name;
 
 				auto folder = MakePtr<GuiResourceFolder>();
-				folder->LoadResourceFolderFromBinary(delayLoadings, reader, typeNames, errors);
+				folder->LoadResourceFolderFromBinary(delayLoadings, reader, binary, typeNames, errors);
 				AddFolder(name, folder);
 			}
 		}
 
-		void GuiResourceFolder::SaveResourceFolderToBinary(stream::internal::ContextFreeWriter& writer, collections::List<WString>& typeNames)
+		void GuiResourceFolder::SaveResourceFolderToBinary(stream::internal::ContextFreeWriter& writer, stream::IStream& binaryStream, collections::List<WString>& typeNames)
 		{
 			typedef Tuple<vint, WString, IGuiResourceTypeResolver_DirectLoadStream*, Ptr<DescriptableObject>> ItemTuple;
 			List<ItemTuple> itemTuples;
@@ -739,11 +815,13 @@ GuiResourceFolder
 			{
 				vint typeName = item.f0;
 				WString name = item.f1;
-				writer << typeName << name;
 
 				auto directLoad = item.f2;
 				auto resource = item.f3;
-				directLoad->SerializePrecompiled(resource, writer.output);
+				vint offset = (vint)binaryStream.Position();
+				directLoad->SerializePrecompiled(resource, binaryStream);
+				vint size = (vint)binaryStream.Position() - offset;
+				writer << typeName << name << offset << size;
 			}
 
 			count = folders.Count();
@@ -752,7 +830,7 @@ GuiResourceFolder
 			{
 				WString name = folder->GetName();
 				writer << name;
-				folder->SaveResourceFolderToBinary(writer, typeNames);
+				folder->SaveResourceFolderToBinary(writer, binaryStream, typeNames);
 			}
 		}
 
@@ -892,6 +970,7 @@ GuiResourceFolder
 				Ptr<GuiResourceItem> item=GetItem(path);
 				if(item)
 				{
+					// an item that fails to load stays in the folder with its loading errors, and the path returns null
 					return item->GetContent();
 				}
 			}
@@ -1045,11 +1124,44 @@ GuiResource
 			stream::internal::ContextFreeReader reader(stream);
 			auto resource = MakePtr<GuiResource>();
 
+			// the old format begins with the number of type names instead of PrecompiledBinaryHeader
+			vint32_t header = 0;
+			reader << header;
+
 			List<WString> typeNames;
-			reader << typeNames;
+			Ptr<Array<vuint8_t>> binary;
+			if (header == PrecompiledBinaryHeader)
+			{
+				vint version = 0;
+				reader << version;
+				if (version != PrecompiledBinaryVersion)
+				{
+					errors.Add(L"Unsupported precompiled resource binary version: " + itow(version) + L".");
+					return nullptr;
+				}
+				reader << typeNames;
+
+				vint size = 0;
+				reader << size;
+				binary = MakePtr<Array<vuint8_t>>(size);
+				if (size > 0 && stream.Read(&binary->operator[](0), size) != size)
+				{
+					errors.Add(L"The precompiled resource binary is incomplete.");
+					return nullptr;
+				}
+			}
+			else
+			{
+				for (vint i = 0; i < header; i++)
+				{
+					WString typeName;
+					reader << typeName;
+					typeNames.Add(typeName);
+				}
+			}
 			
 			DelayLoadingList delayLoadings;
-			resource->LoadResourceFolderFromBinary(delayLoadings, reader, typeNames, errors);
+			resource->LoadResourceFolderFromBinary(delayLoadings, reader, binary, typeNames, errors);
 			
 			ProcessDelayLoading(resource, delayLoadings, errors);
 			return resource;
@@ -1061,8 +1173,27 @@ GuiResource
 
 			List<WString> typeNames;
 			CollectTypeNames(typeNames);
-			writer << typeNames;
-			SaveResourceFolderToBinary(writer, typeNames);
+
+			// contents of all items are stored in one binary before the folder structure, which records offsets and sizes of contents
+			MemoryStream binaryStream;
+			MemoryStream folderStream;
+			{
+				stream::internal::ContextFreeWriter folderWriter(folderStream);
+				SaveResourceFolderToBinary(folderWriter, binaryStream, typeNames);
+			}
+
+			vint32_t header = PrecompiledBinaryHeader;
+			vint version = PrecompiledBinaryVersion;
+			vint size = (vint)binaryStream.Size();
+			writer << header << version << typeNames << size;
+			if (size > 0)
+			{
+				stream.Write(binaryStream.GetInternalBuffer(), size);
+			}
+			if (folderStream.Size() > 0)
+			{
+				stream.Write(folderStream.GetInternalBuffer(), (vint)folderStream.Size());
+			}
 		}
 
 		void GuiResource::Precompile(IGuiResourcePrecompileCallback* callback, collections::List<WString>& errors)
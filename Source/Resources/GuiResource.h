@@ -183,14 +183,29 @@ Resource Structure
 		struct GuiResourcePrecompileContext;
 		struct GuiResourceInitializeContext;
 		class IGuiResourcePrecompileCallback;
+		class IGuiResourceTypeResolver;
 		
 		/// <summary>Resource item.</summary>
 		class GuiResourceItem : public GuiResourceNodeBase, public Description<GuiResourceItem>
 		{
 			friend class GuiResourceFolder;
 		protected:
+			typedef collections::Array<vuint8_t>	PrecompiledBinary;
+
+			struct PrecompiledContent
+			{
+				Ptr<PrecompiledBinary>				binary;
+				vint								offset = 0;
+				vint								size = 0;
+				IGuiResourceTypeResolver*			typeResolver = nullptr;
+				IGuiResourceTypeResolver*			preloadResolver = nullptr;
+			};
+
 			Ptr<DescriptableObject>					content;
 			WString									typeName;
+			Ptr<PrecompiledContent>					precompiledContent;
+			CriticalSection							contentLock;
+			collections::List<WString>				loadingErrors;
 			
 		public:
 			/// <summary>Create a resource item.</summary>
@@ -201,9 +216,12 @@ Resource Structure
 			/// <returns>The type name.</returns>
 			const WString&							GetTypeName();
 			
-			/// <summary>Get the contained object for this resource item.</summary>
+			/// <summary>Get the contained object for this resource item. For a resource loaded from a precompiled binary, the object is deserialized on the first call, and errors are stored in <see cref="GetLoadingErrors"/>.</summary>
 			/// <returns>The contained object.</returns>
 			Ptr<DescriptableObject>					GetContent();
+			/// <summary>Get all errors from deserializing the contained object from a precompiled binary. It is not empty if <see cref="GetContent"/> failed and returned null.</summary>
+			/// <returns>All errors.</returns>
+			const collections::List<WString>&		GetLoadingErrors();
 			/// <summary>Set the containd object for this resource item.</summary>
 			/// <param name="_typeName">The type name of this contained object.</param>
 			/// <param name="value">The contained object.</param>
@@ -247,8 +265,8 @@ Resource Structure
 			void									LoadResourceFolderFromXml(DelayLoadingList& delayLoadings, const WString& containingFolder, Ptr<parsing::xml::XmlElement> folderXml, collections::List<WString>& errors);
 			void									SaveResourceFolderToXml(Ptr<parsing::xml::XmlElement> xmlParent);
 			void									CollectTypeNames(collections::List<WString>& typeNames);
-			void									LoadResourceFolderFromBinary(DelayLoadingList& delayLoadings, stream::internal::ContextFreeReader& reader, collections::List<WString>& typeNames, collections::List<WString>& errors);
-			void									SaveResourceFolderToBinary(stream::internal::ContextFreeWriter& writer, collections::List<WString>& typeNames);
+			void									LoadResourceFolderFromBinary(DelayLoadingList& delayLoadings, stream::internal::ContextFreeReader& reader, Ptr<GuiResourceItem::PrecompiledBinary> binary, collections::List<WString>& typeNames, collections::List<WString>& errors);
+			void									SaveResourceFolderToBinary(stream::internal::ContextFreeWriter& writer, stream::IStream& binaryStream, collections::List<WString>& typeNames);
 			void									PrecompileResourceFolder(GuiResourcePrecompileContext& context, IGuiResourcePrecompileCallback* callback, collections::List<WString>& errors);
 			void									InitializeResourceFolder(GuiResourceInitializeContext& context);
 		public:
@@ -294,7 +312,7 @@ Resource Structure
 			/// <summary>Remove all resource folders.</summary>
 			void									ClearFolders();
 
-			/// <summary>Get a contained resource object using a path like "Packages\Application\Name".</summary>
+			/// <summary>Get a contained resource object using a path like "Packages\Application\Name". An item that fails to be deserialized from a precompiled binary is removed, as if the path does not exist.</summary>
 			/// <returns>The containd resource object.</returns>
 			/// <param name="path">The path.</param>
 			Ptr<DescriptableObject>					GetValueByPath(const WString& path);
@@ -353,7 +371,7 @@ Resource
 			/// <returns>The xml.</returns>
 			Ptr<parsing::xml::XmlDocument>			SaveToXml();
 			
-			/// <summary>Load a precompiled resource from a stream.</summary>
+			/// <summary>Load a precompiled resource from a stream. Contents of items are deserialized when they are accessed for the first time, except those which need delay loading.</summary>
 			/// <returns>The loaded resource.</returns>
 			/// <param name="stream">The stream.</param>
 			/// <param name="errors">All collected errors during loading a resource.</param>
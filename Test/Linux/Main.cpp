@@ -1,12 +1,22 @@
-#include "../../Source/GacUI.h"
+#include "TestBenchmark.h"
+#include <string.h>
 
 using namespace vl;
+using namespace vl::unittest;
 
-int main()
+int main(int argc, char* argv[])
 {
-	return 0;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--benchmark") == 0)
+		{
+			BenchmarkEnabled() = true;
+		}
+	}
+	return SetupHeadlessSoftwareRenderer();
 }
 
 void GuiMain()
 {
+	UnitTest::RunAndDisposeTests();
 }
@@ -0,0 +1,92 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Unit Test::Benchmark
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_TEST_LINUX_TESTBENCHMARK
+#define VCZH_TEST_LINUX_TESTBENCHMARK
+
+#include "../../Source/GacUI.h"
+#include <chrono>
+#include <stdio.h>
+
+// benchmarks are slow, they only run when the test program is started with --benchmark
+
+inline bool& BenchmarkEnabled()
+{
+	static bool enabled = false;
+	return enabled;
+}
+
+#define BENCHMARK_CASE(NAME)\
+	extern void BENCHMARK_##NAME();\
+	TEST_CASE(NAME)\
+	{\
+		if (BenchmarkEnabled())\
+		{\
+			BENCHMARK_##NAME();\
+		}\
+		else\
+		{\
+			TEST_PRINT(L"    Skipped, run with --benchmark");\
+		}\
+	}\
+	void BENCHMARK_##NAME()
+
+// DateTime only has a precision of one second in Linux, so time is measured by std::chrono::steady_clock
+
+template<typename F>
+double BenchmarkMilliseconds(const F& f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+inline vl::WString FormatBenchmarkNumber(double value)
+{
+	wchar_t buffer[64];
+	swprintf(buffer, sizeof(buffer) / sizeof(*buffer), L"%.2f", value);
+	return buffer;
+}
+
+inline vl::vint GetResidentMemoryBytes()
+{
+	long pages = 0;
+	long residentPages = 0;
+	if (FILE* file = fopen("/proc/self/statm", "r"))
+	{
+		if (fscanf(file, "%ld %ld", &pages, &residentPages) != 2)
+		{
+			residentPages = 0;
+		}
+		fclose(file);
+	}
+	return (vl::vint)residentPages * 4096;
+}
+
+// tests that compare with a reference implementation use a fixed sequence of random numbers, so that failures could be reproduced
+
+class TestRandom
+{
+private:
+	vl::vuint64_t state;
+
+public:
+	TestRandom(vl::vuint64_t seed = 1)
+		:state(seed)
+	{
+	}
+
+	vl::vint Next(vl::vint max)
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return (vl::vint)((state >> 33) % (vl::vuint64_t)max);
+	}
+};
+
+#endif
@@ -0,0 +1,256 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::elements::text;
+
+namespace test_colorized_text_runs
+{
+	const vint RowCount = 2000;
+
+	WString CreateCode()
+	{
+		WString code;
+		for (vint i = 0; i < RowCount; i++)
+		{
+			code += L"\tif (value" + itow(i) + L" > 42) { text = \"abc\"; } // comment " + itow(i) + L"\r\n";
+		}
+		return code;
+	}
+
+	// 0: default, 1: keyword, 2: number, 3: string, 4: comment
+	void Colorize(TextLines& lines)
+	{
+		for (vint row = 0; row < lines.GetCount(); row++)
+		{
+			TextLine& line = lines.GetLine(row);
+			vint state = 0;
+			for (vint column = 0; column < line.dataLength; column++)
+			{
+				wchar_t c = line.text[column];
+				vint color = 0;
+				if (state == 4 || (c == L'/' && column + 1 < line.dataLength && line.text[column + 1] == L'/'))
+				{
+					color = state = 4;
+				}
+				else if (c == L'\"')
+				{
+					color = 3;
+					state = state == 3 ? 0 : 3;
+				}
+				else if (state == 3)
+				{
+					color = 3;
+				}
+				else if (L'0' <= c && c <= L'9')
+				{
+					color = 2;
+				}
+				else if ((c == L'i' || c == L'f') && column < 3)
+				{
+					color = 1;
+				}
+				line.att[column].colorIndex = (vuint32_t)color;
+			}
+		}
+	}
+
+	void CreateColors(GuiColorizedTextElement::ColorArray& colors)
+	{
+		colors.Resize(5);
+		for (vint i = 0; i < colors.Count(); i++)
+		{
+			colors[i].normal.text = Color((unsigned char)(i * 40), 0, 0);
+			colors[i].normal.background = Color(0, 0, 0, 0);
+			colors[i].selectedFocused.text = Color(255, 255, 255);
+			colors[i].selectedFocused.background = Color(0, 0, 128);
+			colors[i].selectedUnfocused.text = Color(255, 255, 255);
+			colors[i].selectedUnfocused.background = Color(128, 128, 128);
+		}
+	}
+
+	// the same per-character loop and conditions as renderers had before drawing from runs, counting FillRect and DrawString calls
+	vint CountCharacterDrawCalls(GuiColorizedTextElement* element, Size viewSize)
+	{
+		TextLines& lines = element->GetLines();
+		const GuiColorizedTextElement::ColorArray& colors = element->GetColors();
+		Rect viewBounds(element->GetViewPosition(), viewSize);
+		vint startRow = lines.GetTextPosFromPoint(Point(viewBounds.x1, viewBounds.y1)).row;
+		vint endRow = lines.GetTextPosFromPoint(Point(viewBounds.x2, viewBounds.y2)).row;
+		TextPos selectionBegin = element->GetCaretBegin() < element->GetCaretEnd() ? element->GetCaretBegin() : element->GetCaretEnd();
+		TextPos selectionEnd = element->GetCaretBegin() > element->GetCaretEnd() ? element->GetCaretBegin() : element->GetCaretEnd();
+		bool focused = element->GetFocused();
+		vint calls = 0;
+
+		for (vint row = startRow; row <= endRow; row++)
+		{
+			Rect startRect = lines.GetRectFromTextPos(TextPos(row, 0));
+			vint startColumn = lines.GetTextPosFromPoint(Point(viewBounds.x1, startRect.y1)).column;
+			vint endColumn = lines.GetTextPosFromPoint(Point(viewBounds.x2, startRect.y1)).column;
+			TextLine& line = lines.GetLine(row);
+			for (vint column = startColumn; column <= endColumn; column++)
+			{
+				bool inSelection = false;
+				if (selectionBegin.row == selectionEnd.row)
+				{
+					inSelection = (row == selectionBegin.row && selectionBegin.column <= column && column < selectionEnd.column);
+				}
+				else if (row == selectionBegin.row)
+				{
+					inSelection = selectionBegin.column <= column;
+				}
+				else if (row == selectionEnd.row)
+				{
+					inSelection = column < selectionEnd.column;
+				}
+				else
+				{
+					inSelection = selectionBegin.row < row && row < selectionEnd.row;
+				}
+
+				bool crlf = column == line.dataLength;
+				vint colorIndex = crlf ? 0 : line.att[column].colorIndex;
+				if (colorIndex >= colors.Count())
+				{
+					colorIndex = 0;
+				}
+				const ColorItem& color =
+					!inSelection ? colors[colorIndex].normal :
+					focused ? colors[colorIndex].selectedFocused :
+					colors[colorIndex].selectedUnfocused;
+				if (color.background.a) calls++;
+				if (!crlf && color.text.a) calls++;
+			}
+		}
+		return calls;
+	}
+
+	// renderers keep the list between frames with SetLessMemoryMode(false), so building runs does not allocate
+	vint CountRunDrawCalls(GuiColorizedTextElement* element, Size viewSize, List<TextRun>& runs)
+	{
+		const GuiColorizedTextElement::ColorArray& colors = element->GetColors();
+		bool focused = element->GetFocused();
+		vint calls = 0;
+
+		runs.Clear();
+		element->BuildTextRuns(viewSize, runs);
+		for (vint i = 0; i < runs.Count(); i++)
+		{
+			const TextRun& run = runs[i];
+			const ColorItem& color =
+				!run.inSelection ? colors[run.colorIndex].normal :
+				focused ? colors[run.colorIndex].selectedFocused :
+				colors[run.colorIndex].selectedUnfocused;
+			if (color.background.a) calls++;
+			if (!run.lineBreak && color.text.a) calls++;
+		}
+		return calls;
+	}
+
+	template<typename F>
+	void WithColorizedTextElement(const F& f)
+	{
+		INativeWindow* window = GetCurrentController()->WindowService()->CreateNativeWindow();
+		{
+			Ptr<GuiColorizedTextElement> element = GuiColorizedTextElement::Create();
+			element->GetRenderer()->SetRenderTarget(GetGuiGraphicsResourceManager()->GetRenderTarget(window));
+			element->SetFont(GetCurrentController()->ResourceService()->GetDefaultFont());
+			element->GetLines().SetText(CreateCode());
+			GuiColorizedTextElement::ColorArray colors;
+			CreateColors(colors);
+			element->SetColors(colors);
+			Colorize(element->GetLines());
+			element->SetFocused(true);
+			f(element.Obj());
+			element->GetRenderer()->SetRenderTarget(0);
+		}
+		GetCurrentController()->WindowService()->DestroyNativeWindow(window);
+	}
+}
+using namespace test_colorized_text_runs;
+
+TEST_CASE(TestColorizedTextRuns)
+{
+	WithColorizedTextElement([](GuiColorizedTextElement* element)
+	{
+		vint rowHeight = element->GetLines().GetRowHeight();
+		Size viewSize(400, rowHeight * 20);
+		element->SetViewPosition(Point(0, rowHeight * 100));
+		element->SetCaretBegin(TextPos(105, 8));
+		element->SetCaretEnd(TextPos(110, 3));
+
+		List<TextRun> runs;
+		CountRunDrawCalls(element, viewSize, runs);
+		TEST_ASSERT(runs.Count() > 0);
+		for (vint i = 0; i < runs.Count(); i++)
+		{
+			const TextRun& run = runs[i];
+			TextLine& line = element->GetLines().GetLine(run.row);
+			TEST_ASSERT(100 <= run.row && run.row <= 120);
+			TEST_ASSERT(run.startColumn < run.endColumn);
+			TEST_ASSERT(run.x1 < run.x2);
+			if (run.lineBreak)
+			{
+				TEST_ASSERT(run.startColumn == line.dataLength && run.endColumn == line.dataLength + 1);
+			}
+			else
+			{
+				TEST_ASSERT(run.endColumn <= line.dataLength);
+				TEST_ASSERT(run.x1 == (run.startColumn == 0 ? 0 : (vint)line.att[run.startColumn - 1].rightOffset));
+				TEST_ASSERT(run.x2 == (vint)line.att[run.endColumn - 1].rightOffset);
+				for (vint column = run.startColumn; column < run.endColumn; column++)
+				{
+					TEST_ASSERT((vint)line.att[column].colorIndex == run.colorIndex);
+				}
+			}
+
+			bool inSelection = (run.row == 105 && run.startColumn >= 8) || (105 < run.row && run.row < 110) || (run.row == 110 && run.endColumn <= 3);
+			TEST_ASSERT(run.inSelection == inSelection);
+
+			if (i > 0 && runs[i - 1].row == run.row)
+			{
+				TEST_ASSERT(runs[i - 1].endColumn == run.startColumn);
+				TEST_ASSERT(runs[i - 1].x2 == run.x1);
+			}
+		}
+	});
+}
+
+BENCHMARK_CASE(BenchmarkColorizedTextRuns)
+{
+	WithColorizedTextElement([](GuiColorizedTextElement* element)
+	{
+		const vint frames = 1000;
+		vint rowHeight = element->GetLines().GetRowHeight();
+		Size viewSize(1000, rowHeight * 50);
+		element->SetViewPosition(Point(0, rowHeight * 1000));
+		element->SetCaretBegin(TextPos(1010, 5));
+		element->SetCaretEnd(TextPos(1020, 5));
+
+		List<TextRun> runs;
+		runs.SetLessMemoryMode(false);
+		vint characterCalls = CountCharacterDrawCalls(element, viewSize);
+		vint runCalls = CountRunDrawCalls(element, viewSize, runs);
+		double characterTime = BenchmarkMilliseconds([&]()
+		{
+			for (vint i = 0; i < frames; i++)
+			{
+				characterCalls = CountCharacterDrawCalls(element, viewSize);
+			}
+		});
+		double runTime = BenchmarkMilliseconds([&]()
+		{
+			for (vint i = 0; i < frames; i++)
+			{
+				runCalls = CountRunDrawCalls(element, viewSize, runs);
+			}
+		});
+		TEST_ASSERT(runCalls < characterCalls);
+
+		TEST_PRINT(L"Colorized text, 50 visible rows with 10 selected rows:");
+		TEST_PRINT(L"    Draw calls per frame: " + itow(characterCalls) + L" per character, " + itow(runCalls) + L" per run");
+		TEST_PRINT(L"    Layout per frame: " + FormatBenchmarkNumber(characterTime * 1000 / frames) + L"us per character, " + FormatBenchmarkNumber(runTime * 1000 / frames) + L"us per run");
+	});
+}
@@ -0,0 +1,319 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+
+namespace test_composition_layout
+{
+	const vint TableSize = 10;
+
+	// a table of stacks and flows, each of them contains leaves in items
+	GuiBoundsComposition* CreateTree(vint itemCount, List<GuiGraphicsComposition*>& nodes, List<GuiBoundsComposition*>& leaves)
+	{
+		auto root = new GuiBoundsComposition;
+		root->SetBounds(Rect(0, 0, 1000, 1000));
+		root->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+		nodes.Add(root);
+
+		auto table = new GuiTableComposition;
+		table->SetAlignmentToParent(Margin(0, 0, 0, 0));
+		table->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+		table->SetRowsAndColumns(TableSize, TableSize);
+		for (vint i = 0; i < TableSize; i++)
+		{
+			table->SetRowOption(i, GuiCellOption::MinSizeOption());
+			table->SetColumnOption(i, GuiCellOption::MinSizeOption());
+		}
+		root->AddChild(table);
+		nodes.Add(table);
+
+		for (vint r = 0; r < TableSize; r++)
+		{
+			for (vint c = 0; c < TableSize; c++)
+			{
+				auto cell = new GuiCellComposition;
+				cell->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+				table->AddChild(cell);
+				cell->SetSite(r, c, 1, 1);
+				nodes.Add(cell);
+
+				GuiBoundsComposition* container = nullptr;
+				if ((r + c) % 2 == 0)
+				{
+					auto stack = new GuiStackComposition;
+					stack->SetDirection(GuiStackComposition::Vertical);
+					container = stack;
+				}
+				else
+				{
+					container = new GuiFlowComposition;
+				}
+				container->SetAlignmentToParent(Margin(0, 0, 0, 0));
+				container->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+				cell->AddChild(container);
+				nodes.Add(container);
+
+				for (vint i = 0; i < itemCount; i++)
+				{
+					GuiGraphicsComposition* item = nullptr;
+					if (auto stack = dynamic_cast<GuiStackComposition*>(container))
+					{
+						auto stackItem = new GuiStackItemComposition;
+						stack->InsertStackItem(i, stackItem);
+						item = stackItem;
+					}
+					else
+					{
+						item = new GuiFlowItemComposition;
+						container->AddChild(item);
+					}
+					item->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+					nodes.Add(item);
+
+					auto leaf = new GuiBoundsComposition;
+					leaf->SetPreferredMinSize(Size(10 + i % 7, 10 + i % 5));
+					leaf->SetAlignmentToParent(Margin(0, 0, 0, 0));
+					item->AddChild(leaf);
+					nodes.Add(leaf);
+					leaves.Add(leaf);
+				}
+			}
+		}
+		return root;
+	}
+
+	// compares a tree that has been laid out and then changed, with a tree that is laid out for the first time
+	void AssertSameLayout(List<GuiGraphicsComposition*>& changedNodes, List<GuiGraphicsComposition*>& freshNodes)
+	{
+		TEST_ASSERT(changedNodes.Count() == freshNodes.Count());
+		for (vint i = 0; i < freshNodes.Count(); i++)
+		{
+			TEST_ASSERT(changedNodes[i]->GetPreferredBounds() == freshNodes[i]->GetPreferredBounds());
+			TEST_ASSERT(changedNodes[i]->GetBounds() == freshNodes[i]->GetBounds());
+		}
+	}
+
+	vint GetAllBounds(List<GuiGraphicsComposition*>& nodes)
+	{
+		vint area = 0;
+		for (vint i = 0; i < nodes.Count(); i++)
+		{
+			Rect bounds = nodes[i]->GetBounds();
+			area += bounds.Width() + bounds.Height();
+		}
+		return area;
+	}
+
+	// like the render loop, lay out again until bounds do not change
+	void LayoutUntilStable(List<GuiGraphicsComposition*>& nodes)
+	{
+		vint area = GetAllBounds(nodes);
+		for (vint i = 0; i < 10; i++)
+		{
+			vint newArea = GetAllBounds(nodes);
+			if (newArea == area) return;
+			area = newArea;
+		}
+		TEST_ASSERT(false);
+	}
+
+	// hit testing before binary search: check all children in reverse order
+	GuiGraphicsComposition* ReferenceFindComposition(GuiGraphicsComposition* composition, Point location)
+	{
+		if (!composition->GetVisible()) return nullptr;
+		Rect bounds = composition->GetBounds();
+		if (!Rect(Point(0, 0), bounds.GetSize()).Contains(location)) return nullptr;
+
+		Rect clientArea = composition->GetClientArea();
+		Point clientLocation = location - Size(clientArea.x1 - bounds.x1, clientArea.y1 - bounds.y1);
+		for (vint i = composition->Children().Count() - 1; i >= 0; i--)
+		{
+			auto child = composition->Children()[i];
+			Rect childBounds = child->GetBounds();
+			if (auto result = ReferenceFindComposition(child, clientLocation - Size(childBounds.x1, childBounds.y1)))
+			{
+				return result;
+			}
+		}
+		return composition;
+	}
+
+	// a table with padding and spanned cells, containing stacks in all directions, some items are hidden or overlapped
+	GuiBoundsComposition* CreateHitTestTree(TestRandom& random, List<GuiGraphicsComposition*>& nodes)
+	{
+		auto root = new GuiBoundsComposition;
+		root->SetBounds(Rect(0, 0, 600, 600));
+		root->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+		nodes.Add(root);
+
+		auto table = new GuiTableComposition;
+		table->SetAlignmentToParent(Margin(0, 0, 0, 0));
+		table->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+		table->SetCellPadding(random.Next(5));
+		table->SetBorderVisible(random.Next(2) == 0);
+		table->SetRowsAndColumns(4, 4);
+		for (vint i = 0; i < 4; i++)
+		{
+			table->SetRowOption(i, GuiCellOption::MinSizeOption());
+			table->SetColumnOption(i, GuiCellOption::MinSizeOption());
+		}
+		root->AddChild(table);
+		nodes.Add(table);
+
+		GuiStackComposition::Direction directions[] = { GuiStackComposition::Horizontal, GuiStackComposition::Vertical, GuiStackComposition::ReversedHorizontal, GuiStackComposition::ReversedVertical };
+		for (vint r = 0; r < 4; r++)
+		{
+			for (vint c = 0; c < 4; c++)
+			{
+				// the cell at (1, 1) covers (1, 1) to (2, 2), and the cell at (3, 3) is missing
+				if (r >= 1 && r <= 2 && c >= 1 && c <= 2 && (r != 1 || c != 1)) continue;
+				if (r == 3 && c == 3) continue;
+				auto cell = new GuiCellComposition;
+				cell->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+				table->AddChild(cell);
+				cell->SetSite(r, c, r == 1 && c == 1 ? 2 : 1, r == 1 && c == 1 ? 2 : 1);
+				nodes.Add(cell);
+
+				auto stack = new GuiStackComposition;
+				stack->SetDirection(directions[random.Next(4)]);
+				stack->SetPadding(random.Next(4));
+				stack->SetAlignmentToParent(Margin(random.Next(3), random.Next(3), random.Next(3), random.Next(3)));
+				stack->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+				cell->AddChild(stack);
+				nodes.Add(stack);
+
+				bool overlapped = random.Next(4) == 0;
+				vint itemCount = random.Next(12);
+				for (vint i = 0; i < itemCount; i++)
+				{
+					auto item = new GuiStackItemComposition;
+					stack->InsertStackItem(i, item);
+					item->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+					if (overlapped && i == itemCount / 2)
+					{
+						item->SetExtraMargin(Margin(5, 5, 5, 5));
+					}
+					if (random.Next(8) == 0)
+					{
+						item->SetVisible(false);
+					}
+					nodes.Add(item);
+
+					auto leaf = new GuiBoundsComposition;
+					leaf->SetPreferredMinSize(Size(3 + random.Next(15), 3 + random.Next(15)));
+					leaf->SetAlignmentToParent(Margin(random.Next(2), random.Next(2), random.Next(2), random.Next(2)));
+					item->AddChild(leaf);
+					nodes.Add(leaf);
+				}
+			}
+		}
+		return root;
+	}
+}
+using namespace test_composition_layout;
+
+TEST_CASE(TestCompositionLayout)
+{
+	List<GuiGraphicsComposition*> nodes;
+	List<GuiBoundsComposition*> leaves;
+	auto root = CreateTree(20, nodes, leaves);
+	LayoutUntilStable(nodes);
+	Rect oldBounds = root->Children()[0]->GetBounds();
+
+	leaves[0]->SetPreferredMinSize(Size(20, 3000));
+	LayoutUntilStable(nodes);
+	TEST_ASSERT(root->Children()[0]->GetBounds() != oldBounds);
+	{
+		List<GuiGraphicsComposition*> freshNodes;
+		List<GuiBoundsComposition*> freshLeaves;
+		auto freshRoot = CreateTree(20, freshNodes, freshLeaves);
+		freshLeaves[0]->SetPreferredMinSize(Size(20, 3000));
+		LayoutUntilStable(freshNodes);
+		AssertSameLayout(nodes, freshNodes);
+		delete freshRoot;
+	}
+
+	leaves[0]->SetPreferredMinSize(Size(10, 10));
+	leaves[leaves.Count() - 1]->SetAlignmentToParent(Margin(0, 0, 300, 300));
+	LayoutUntilStable(nodes);
+	{
+		List<GuiGraphicsComposition*> freshNodes;
+		List<GuiBoundsComposition*> freshLeaves;
+		auto freshRoot = CreateTree(20, freshNodes, freshLeaves);
+		freshLeaves[freshLeaves.Count() - 1]->SetAlignmentToParent(Margin(0, 0, 300, 300));
+		LayoutUntilStable(freshNodes);
+		AssertSameLayout(nodes, freshNodes);
+		delete freshRoot;
+	}
+	delete root;
+}
+
+TEST_CASE(TestCompositionHitTest)
+{
+	// binary search in stacks and tables finds the same composition as checking all children
+	TestRandom random;
+	for (vint i = 0; i < 10; i++)
+	{
+		List<GuiGraphicsComposition*> nodes;
+		auto root = CreateHitTestTree(random, nodes);
+		LayoutUntilStable(nodes);
+		Rect bounds = root->GetBounds();
+		for (vint y = -2; y < bounds.Height() + 2; y++)
+		{
+			for (vint x = -2; x < bounds.Width() + 2; x++)
+			{
+				Point location(x, y);
+				TEST_ASSERT(root->FindComposition(location) == ReferenceFindComposition(root, location));
+			}
+		}
+		delete root;
+	}
+}
+
+BENCHMARK_CASE(BenchmarkCompositionLayout)
+{
+	// with cached minimum sizes, the cost of GetBounds per composition should not grow with the size of the tree,
+	// and GetGlobalBounds, which calls GetBounds on every ancestor, should not grow with the size of the subtrees of ancestors
+	TEST_PRINT(L"GetBounds on all compositions in tables, stacks and flows:");
+	for (vint itemCount = 25; itemCount <= 100; itemCount *= 2)
+	{
+		List<GuiGraphicsComposition*> nodes;
+		List<GuiBoundsComposition*> leaves;
+		auto root = CreateTree(itemCount, nodes, leaves);
+
+		vint firstArea = 0;
+		vint cachedArea = 0;
+		vint changedArea = 0;
+		double first = BenchmarkMilliseconds([&]()
+		{
+			firstArea = GetAllBounds(nodes);
+		});
+		LayoutUntilStable(nodes);
+		vint stableArea = GetAllBounds(nodes);
+		double cached = BenchmarkMilliseconds([&]()
+		{
+			cachedArea = GetAllBounds(nodes);
+		});
+		vint globalArea = 0;
+		double global = BenchmarkMilliseconds([&]()
+		{
+			for (vint i = 0; i < leaves.Count(); i++)
+			{
+				globalArea += leaves[i]->GetGlobalBounds().Width();
+			}
+		});
+		double changed = BenchmarkMilliseconds([&]()
+		{
+			leaves[leaves.Count() / 2]->SetPreferredMinSize(Size(20, 20));
+			changedArea = GetAllBounds(nodes);
+		});
+		TEST_ASSERT(firstArea > 0 && cachedArea == stableArea && globalArea > 0 && changedArea > 0);
+
+		auto perNode = [&](double milliseconds) {return FormatBenchmarkNumber(milliseconds * 1000000 / nodes.Count()) + L"ns"; };
+		TEST_PRINT(L"    " + itow(nodes.Count()) + L" compositions, per composition: first " + perNode(first) + L", cached " + perNode(cached) + L", after changing one leaf " + perNode(changed));
+		TEST_PRINT(L"    " + itow(leaves.Count()) + L" leaves, GetGlobalBounds per leaf: " + FormatBenchmarkNumber(global * 1000000 / leaves.Count()) + L"ns");
+		delete root;
+	}
+}
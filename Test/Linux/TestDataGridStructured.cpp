@@ -0,0 +1,327 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::list;
+
+namespace test_data_grid_structured
+{
+	struct Row
+	{
+		vint							id = 0;			// identifies a row after rows before it are inserted or removed
+		vint							key = 0;
+	};
+
+	class TestDataProvider : public StrongTypedDataProvider<Row>
+	{
+	public:
+		List<Row>						rows;
+
+		TestDataProvider()
+		{
+			AddSortableFieldColumn(L"Key", &Row::key);
+		}
+
+		vint GetRowCount()override
+		{
+			return rows.Count();
+		}
+
+		void GetRowData(vint row, Row& rowData)override
+		{
+			rowData = rows[row];
+		}
+
+		void Modify(vint start, vint count, List<Row>& newRows)
+		{
+			rows.RemoveRange(start, count);
+			for (vint i = 0; i < newRows.Count(); i++)
+			{
+				rows.Insert(start + i, newRows[i]);
+			}
+			commandExecutor->OnDataProviderItemModified(start, count, newRows.Count());
+		}
+	};
+
+	class KeyFilter : public StructuredDataFilterBase
+	{
+	protected:
+		TestDataProvider*				dataProvider;
+
+	public:
+		KeyFilter(TestDataProvider* _dataProvider)
+			:dataProvider(_dataProvider)
+		{
+		}
+
+		bool Filter(vint row)override
+		{
+			return dataProvider->rows[row].key % 3 != 0;
+		}
+	};
+
+	// exposes reordered rows, and reorders all rows as a reference
+	class TestStructuredDataProvider : public StructuredDataProvider
+	{
+	public:
+		TestStructuredDataProvider(Ptr<TestDataProvider> provider)
+			:StructuredDataProvider(provider)
+		{
+		}
+
+		void GetRows(List<vint>& rows)
+		{
+			CopyFrom(rows, reorderedRows);
+		}
+
+		void ReorderAllRows()
+		{
+			ReorderRows(false);
+		}
+	};
+
+	// records the last range that is reported to the list control
+	class TestCommandExecutor : public Object, public virtual IDataProviderCommandExecutor
+	{
+	public:
+		vint							start = -1;
+		vint							count = -1;
+		vint							newCount = -1;
+
+		void OnDataProviderColumnChanged()override
+		{
+		}
+
+		void OnDataProviderItemModified(vint _start, vint _count, vint _newCount)override
+		{
+			start = _start;
+			count = _count;
+			newCount = _newCount;
+		}
+	};
+
+	void GetRowIds(TestDataProvider* dataProvider, TestStructuredDataProvider* provider, List<vint>& ids)
+	{
+		List<vint> rows;
+		provider->GetRows(rows);
+		ids.Clear();
+		FOREACH(vint, row, rows)
+		{
+			ids.Add(dataProvider->rows[row].id);
+		}
+	}
+
+	// rows sorted by keys and then by row numbers, filtered one by one, as ReorderRows did before running in parallel
+	void ReferenceRows(TestDataProvider* dataProvider, bool filter, vint sorting, List<vint>& rows)
+	{
+		rows.Clear();
+		for (vint i = 0; i < dataProvider->rows.Count(); i++)
+		{
+			if (!filter || dataProvider->rows[i].key % 3 != 0)
+			{
+				rows.Add(i);
+			}
+		}
+		if (sorting != 0 && rows.Count() > 0)
+		{
+			SortLambda(&rows[0], rows.Count(), [=](vint a, vint b)
+			{
+				vint result = dataProvider->rows[a].key - dataProvider->rows[b].key;
+				if (sorting < 0) result = -result;
+				return result != 0 ? result : a - b;
+			});
+		}
+	}
+
+	vint nextRowId = 0;
+
+	Row CreateRow(TestRandom& random)
+	{
+		Row row;
+		row.id = nextRowId++;
+		row.key = random.Next(50);
+		return row;
+	}
+}
+using namespace test_data_grid_structured;
+
+TEST_CASE(TestStructuredDataParallelSort)
+{
+	TestRandom random;
+	vint counts[] = { 0, 1, 2, 7, 100, 1000, 4099 };
+	for (vint c = 0; c < sizeof(counts) / sizeof(*counts); c++)
+	{
+		vint count = counts[c];
+		for (vint taskCount = 1; taskCount <= 9; taskCount++)
+		{
+			// items with the same key keep their order, as a sequential stable sort does
+			Array<Pair<vint, vint>> items(count), expected(count);
+			for (vint i = 0; i < count; i++)
+			{
+				items[i] = Pair<vint, vint>(random.Next(20), i);
+			}
+			for (vint i = 0; i < count; i++)
+			{
+				expected[i] = items[i];
+			}
+			auto orderer = [](const Pair<vint, vint>& a, const Pair<vint, vint>& b)
+			{
+				vint result = a.key - b.key;
+				return result != 0 ? result : a.value - b.value;
+			};
+			if (count > 0)
+			{
+				SortLambda(&expected[0], count, orderer);
+				StructuredDataParallelTasks::Sort(&items[0], count, taskCount, orderer);
+			}
+			for (vint i = 0; i < count; i++)
+			{
+				TEST_ASSERT(items[i].key == expected[i].key && items[i].value == expected[i].value);
+			}
+		}
+	}
+
+	// every task runs exactly once, and an exception in a pooled task is rethrown after all tasks finish
+	for (vint taskCount = 0; taskCount <= 9; taskCount++)
+	{
+		Array<vint> executed(taskCount);
+		for (vint i = 0; i < taskCount; i++)
+		{
+			executed[i] = 0;
+		}
+		StructuredDataParallelTasks::Run(taskCount, [&](vint task)
+		{
+			INCRC(&executed[task]);
+		});
+		for (vint i = 0; i < taskCount; i++)
+		{
+			TEST_ASSERT(executed[i] == 1);
+		}
+	}
+
+	volatile vint finished = 0;
+	bool thrown = false;
+	try
+	{
+		StructuredDataParallelTasks::Run(4, [&](vint task)
+		{
+			if (task == 3) throw Exception(L"Task failed.");
+			INCRC(&finished);
+		});
+	}
+	catch (const Exception& e)
+	{
+		thrown = e.Message() == L"Task failed.";
+	}
+	TEST_ASSERT(thrown);
+	TEST_ASSERT(finished == 3);
+}
+
+TEST_CASE(TestStructuredDataKeySorter)
+{
+	// cached sort keys in any number of tasks produce the order of comparing rows one pair at a time
+	TestRandom random;
+	auto dataProvider = MakePtr<TestDataProvider>();
+	for (vint i = 0; i < 3000; i++)
+	{
+		dataProvider->rows.Add(CreateRow(random));
+	}
+	auto sorter = dataProvider->GetColumn(0)->GetInherentSorter();
+	auto keySorter = sorter.Cast<IStructuredDataKeySorter>();
+	TEST_ASSERT(keySorter);
+
+	for (vint sorting = -1; sorting <= 1; sorting += 2)
+	{
+		List<vint> expected;
+		ReferenceRows(dataProvider.Obj(), true, sorting, expected);
+		for (vint taskCount = 1; taskCount <= 5; taskCount++)
+		{
+			List<vint> rows;
+			ReferenceRows(dataProvider.Obj(), true, 0, rows);
+			keySorter->SortRows(rows, sorting > 0, taskCount);
+			TEST_ASSERT(CompareEnumerable(rows, expected) == 0);
+		}
+	}
+
+	auto provider = MakePtr<TestStructuredDataProvider>(dataProvider);
+	provider->SetParallelReordering(true);
+	provider->SetAdditionalFilter(new KeyFilter(dataProvider.Obj()));
+	provider->SortByColumn(0, false);
+	List<vint> rows, expected;
+	provider->GetRows(rows);
+	ReferenceRows(dataProvider.Obj(), true, -1, expected);
+	TEST_ASSERT(CompareEnumerable(rows, expected) == 0);
+}
+
+TEST_CASE(TestStructuredDataModifiedRows)
+{
+	TestRandom random;
+	for (vint mode = 0; mode < 4; mode++)
+	{
+		auto dataProvider = MakePtr<TestDataProvider>();
+		for (vint i = 0; i < 200; i++)
+		{
+			dataProvider->rows.Add(CreateRow(random));
+		}
+		auto provider = MakePtr<TestStructuredDataProvider>(dataProvider);
+		TestCommandExecutor executor;
+		provider->SetCommandExecutor(&executor);
+
+		// with a filter, a sorter, both, or a sorter in descending order
+		bool filter = mode != 1;
+		vint sorting = mode == 0 ? 0 : mode == 3 ? -1 : 1;
+		if (filter) provider->SetAdditionalFilter(new KeyFilter(dataProvider.Obj()));
+		if (sorting != 0) provider->SortByColumn(0, sorting > 0);
+
+		for (vint step = 0; step < 200; step++)
+		{
+			List<vint> oldIds;
+			GetRowIds(dataProvider.Obj(), provider.Obj(), oldIds);
+
+			// insert, remove or edit rows, not exceeding MaxIncrementalReorderingRows
+			vint rowCount = dataProvider->rows.Count();
+			vint start = random.Next(rowCount + 1);
+			vint count = random.Next(rowCount - start < 10 ? rowCount - start + 1 : 10);
+			vint newCount = random.Next(3) == 0 ? count : random.Next(10);
+			List<Row> newRows;
+			for (vint i = 0; i < newCount; i++)
+			{
+				newRows.Add(CreateRow(random));
+			}
+			executor.start = -1;
+			dataProvider->Modify(start, count, newRows);
+
+			// the incremental result is the same as reordering all rows
+			List<vint> rows, expected;
+			provider->GetRows(rows);
+			ReferenceRows(dataProvider.Obj(), filter, sorting, expected);
+			TEST_ASSERT(CompareEnumerable(rows, expected) == 0);
+			provider->ReorderAllRows();
+			provider->GetRows(expected);
+			TEST_ASSERT(CompareEnumerable(rows, expected) == 0);
+
+			// rows outside of the reported range are not changed
+			List<vint> newIds;
+			GetRowIds(dataProvider.Obj(), provider.Obj(), newIds);
+			if (executor.start == -1)
+			{
+				TEST_ASSERT(CompareEnumerable(oldIds, newIds) == 0);
+			}
+			else
+			{
+				TEST_ASSERT(oldIds.Count() - executor.count == newIds.Count() - executor.newCount);
+				for (vint i = 0; i < executor.start; i++)
+				{
+					TEST_ASSERT(oldIds[i] == newIds[i]);
+				}
+				for (vint i = executor.start + executor.count; i < oldIds.Count(); i++)
+				{
+					TEST_ASSERT(oldIds[i] == newIds[i - executor.count + executor.newCount]);
+				}
+			}
+		}
+		provider->SetCommandExecutor(nullptr);
+	}
+}
@@ -0,0 +1,231 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+
+namespace test_document_element
+{
+	// exposes paragraph positions, so that they could be compared with sums over all paragraphs
+	class TestDocumentRenderer : public GuiDocumentElement::GuiDocumentElementRenderer
+	{
+	public:
+		TestDocumentRenderer()
+		{
+			factory = nullptr;
+			element = nullptr;
+			renderTarget = nullptr;
+		}
+
+		void SetHeights(List<vint>& heights, vint distance)
+		{
+			paragraphDistance = distance;
+			paragraphCaches.Resize(heights.Count());
+			paragraphHeights.Resize(heights.Count());
+			for (vint i = 0; i < heights.Count(); i++)
+			{
+				paragraphHeights[i] = heights[i];
+			}
+			BuildParagraphHeightTree();
+		}
+
+		void ChangeHeight(vint index, vint height)
+		{
+			SetParagraphHeight(index, height);
+		}
+
+		void SetMaxWidth(vint value)
+		{
+			lastMaxWidth = value;
+		}
+
+		vint Count()
+		{
+			return paragraphHeights.Count();
+		}
+
+		vint Height(vint index)
+		{
+			return paragraphHeights[index];
+		}
+
+		vint Distance()
+		{
+			return paragraphDistance;
+		}
+
+		vint Top(vint index)
+		{
+			return GetParagraphTop(index);
+		}
+
+		vint TotalHeight()
+		{
+			return cachedTotalHeight;
+		}
+
+		void IndexFromPoint(vint y, vint& top, vint& index)
+		{
+			GetParagraphIndexFromPoint(Point(0, y), top, index);
+		}
+
+		vint LaidOutParagraphs()
+		{
+			vint count = 0;
+			for (vint i = 0; i < paragraphCaches.Count(); i++)
+			{
+				if (paragraphCaches[i] && paragraphCaches[i]->graphicsParagraph) count++;
+			}
+
+			// every laid out paragraph is in the list
+			vint linked = 0;
+			for (auto cache = firstUsedParagraph; cache; cache = cache->nextUsed)
+			{
+				linked++;
+			}
+			return linked == count && linked == usedParagraphCount ? count : -1;
+		}
+	};
+
+	// paragraph positions before prefix sums: walk all paragraphs above
+	vint ReferenceTop(TestDocumentRenderer& renderer, vint index)
+	{
+		vint y = 0;
+		for (vint i = 0; i < index; i++)
+		{
+			y += renderer.Height(i) + renderer.Distance();
+		}
+		return y;
+	}
+
+	void ReferenceIndexFromPoint(TestDocumentRenderer& renderer, vint y, vint& top, vint& index)
+	{
+		vint current = 0;
+		for (vint i = 0; i < renderer.Count(); i++)
+		{
+			vint next = current + renderer.Height(i) + renderer.Distance();
+			top = current;
+			index = i;
+			if (next <= y)
+			{
+				current = next;
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	bool MatchesReference(TestDocumentRenderer& renderer)
+	{
+		vint count = renderer.Count();
+		for (vint i = 0; i <= count; i++)
+		{
+			if (renderer.Top(i) != ReferenceTop(renderer, i)) return false;
+		}
+		vint total = count == 0 ? 0 : ReferenceTop(renderer, count) - renderer.Distance();
+		if (renderer.TotalHeight() != total) return false;
+
+		for (vint y = -3; y <= total + renderer.Distance() + 3; y++)
+		{
+			vint top = -1, index = -1;
+			vint expectedTop = -1, expectedIndex = -1;
+			renderer.IndexFromPoint(y, top, index);
+			ReferenceIndexFromPoint(renderer, y, expectedTop, expectedIndex);
+			if (top != expectedTop || index != expectedIndex) return false;
+		}
+		return true;
+	}
+
+	Ptr<DocumentModel> CreateDocument(TestRandom& random, vint paragraphCount)
+	{
+		auto document = MakePtr<DocumentModel>();
+		for (vint i = 0; i < paragraphCount; i++)
+		{
+			WString text = L"Paragraph " + itow(i);
+			vint words = random.Next(30);
+			for (vint j = 0; j < words; j++)
+			{
+				text += L" word";
+			}
+
+			auto textRun = MakePtr<DocumentTextRun>();
+			textRun->text = text;
+			auto paragraph = MakePtr<DocumentParagraphRun>();
+			paragraph->runs.Add(textRun);
+			document->paragraphs.Add(paragraph);
+		}
+		return document;
+	}
+}
+using namespace test_document_element;
+
+TEST_CASE(TestDocumentParagraphPositions)
+{
+	TestRandom random;
+	vint counts[] = { 0, 1, 2, 3, 8, 13, 100 };
+	for (vint c = 0; c < sizeof(counts) / sizeof(*counts); c++)
+	{
+		vint count = counts[c];
+		TestDocumentRenderer renderer;
+		List<vint> heights;
+		for (vint i = 0; i < count; i++)
+		{
+			heights.Add(random.Next(20));
+		}
+		renderer.SetHeights(heights, random.Next(5));
+		TEST_ASSERT(MatchesReference(renderer));
+
+		// paragraphs are laid out in random order and get their real heights, including empty paragraphs
+		for (vint i = 0; i < count * 2; i++)
+		{
+			renderer.ChangeHeight(random.Next(count), random.Next(4) == 0 ? 0 : random.Next(40));
+			TEST_ASSERT(MatchesReference(renderer));
+		}
+	}
+}
+
+TEST_CASE(TestDocumentParagraphCache)
+{
+	const vint paragraphCount = 200;
+	const vint cacheSize = 8;
+	TestRandom random;
+	Ptr<GuiDocumentElement> element = GuiDocumentElement::Create();
+	element->SetParagraphCacheSize(cacheSize);
+	element->SetDocument(CreateDocument(random, paragraphCount));
+
+	TestDocumentRenderer renderer;
+	renderer.Initialize(element.Obj());
+	renderer.OnElementStateChanged();
+	renderer.SetMaxWidth(100);
+	TEST_ASSERT(renderer.Count() == paragraphCount);
+	TEST_ASSERT(renderer.LaidOutParagraphs() == 0);
+
+	for (vint i = 0; i < 300; i++)
+	{
+		// carets are placed at tops of paragraphs, where paragraphs above them may not be laid out
+		vint index = random.Next(paragraphCount);
+		Rect bounds = renderer.GetCaretBounds(TextPos(index, 0), true);
+		TEST_ASSERT(bounds.y1 == ReferenceTop(renderer, index));
+
+		vint laidOut = renderer.LaidOutParagraphs();
+		TEST_ASSERT(0 < laidOut && laidOut <= cacheSize);
+		TEST_ASSERT(MatchesReference(renderer));
+
+		// a paragraph that is released is laid out again when a point is in it
+		vint total = renderer.TotalHeight();
+		vint y = random.Next(total + 1);
+		vint expectedTop = -1, expectedIndex = -1;
+		ReferenceIndexFromPoint(renderer, y, expectedTop, expectedIndex);
+		TEST_ASSERT(renderer.CalculateCaretFromPoint(Point(0, y)).row == expectedIndex);
+		TEST_ASSERT(renderer.LaidOutParagraphs() <= cacheSize);
+	}
+
+	element->SetParagraphCacheSize(1);
+	renderer.GetCaretBounds(TextPos(0, 0), true);
+	renderer.GetCaretBounds(TextPos(1, 0), true);
+	TEST_ASSERT(renderer.LaidOutParagraphs() == 1);
+	renderer.Finalize();
+}
@@ -0,0 +1,218 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+
+namespace test_graphics_event
+{
+	class TestEvent : public GuiNotifyEvent
+	{
+	public:
+		vint GetHandlerCount()
+		{
+			return handlerCount;
+		}
+
+		vint GetExtraHandlerCapacity()
+		{
+			return extraHandlerCapacity;
+		}
+	};
+
+	typedef GuiNotifyEvent::IHandler	IHandler;
+
+	Ptr<IHandler> CreateHandler(List<vint>& calls, vint id)
+	{
+		return new GuiNotifyEvent::FunctionHandler([&calls, id](GuiGraphicsComposition*, GuiEventArgs&)
+		{
+			calls.Add(id);
+		});
+	}
+
+	void Execute(GuiNotifyEvent& event)
+	{
+		GuiEventArgs arguments;
+		event.Execute(arguments);
+	}
+
+	bool CallsAre(List<vint>& calls, const vint* expected, vint count)
+	{
+		bool result = calls.Count() == count;
+		for (vint i = 0; result && i < count; i++)
+		{
+			result = calls[i] == expected[i];
+		}
+		calls.Clear();
+		return result;
+	}
+}
+using namespace test_graphics_event;
+
+TEST_CASE(TestGraphicsEventMultipleAttach)
+{
+	List<vint> calls;
+	TestEvent event1, event2;
+	auto handler = CreateHandler(calls, 1);
+	auto other = CreateHandler(calls, 2);
+
+	// a handler could be attached to multiple events, and to the same event more than once
+	TEST_ASSERT(event1.Attach(handler));
+	TEST_ASSERT(event2.Attach(handler));
+	TEST_ASSERT(event1.Attach(other));
+	TEST_ASSERT(event1.Attach(handler));
+	{
+		vint expected[] = { 1, 2, 1 };
+		Execute(event1);
+		TEST_ASSERT(CallsAre(calls, expected, 3));
+	}
+	{
+		vint expected[] = { 1 };
+		Execute(event2);
+		TEST_ASSERT(CallsAre(calls, expected, 1));
+	}
+
+	// Detach removes the first one
+	TEST_ASSERT(event1.Detach(handler));
+	{
+		vint expected[] = { 2, 1 };
+		Execute(event1);
+		TEST_ASSERT(CallsAre(calls, expected, 2));
+	}
+	TEST_ASSERT(event1.Detach(handler));
+	TEST_ASSERT(!event1.Detach(handler));
+	{
+		vint expected[] = { 2 };
+		Execute(event1);
+		TEST_ASSERT(CallsAre(calls, expected, 1));
+	}
+	{
+		vint expected[] = { 1 };
+		Execute(event2);
+		TEST_ASSERT(CallsAre(calls, expected, 1));
+	}
+	TEST_ASSERT(event2.Detach(handler));
+	TEST_ASSERT(!event2.Detach(handler));
+	TEST_ASSERT(!event1.Detach(0));
+	TEST_ASSERT(!event1.Attach(0));
+
+	// a destroyed event detaches its handlers, so they could still be detached from other events
+	{
+		TestEvent temporary;
+		TEST_ASSERT(temporary.Attach(handler));
+		TEST_ASSERT(event2.Attach(handler));
+		TEST_ASSERT(temporary.Attach(handler));
+	}
+	TEST_ASSERT(event2.Detach(handler));
+	TEST_ASSERT(!event2.Detach(handler));
+}
+
+TEST_CASE(TestGraphicsEventInlineStorage)
+{
+	List<vint> calls;
+	TestEvent event;
+	List<Ptr<IHandler>> handlers;
+	for (vint i = 0; i < 10; i++)
+	{
+		handlers.Add(CreateHandler(calls, i));
+	}
+
+	// the first two handlers are stored in the event, others spill to the heap
+	TEST_ASSERT(event.Attach(handlers[0]));
+	TEST_ASSERT(event.Attach(handlers[1]));
+	TEST_ASSERT(event.GetExtraHandlerCapacity() == 0);
+	TEST_ASSERT(event.Attach(handlers[2]));
+	TEST_ASSERT(event.GetExtraHandlerCapacity() > 0);
+	for (vint i = 3; i < 10; i++)
+	{
+		TEST_ASSERT(event.Attach(handlers[i]));
+	}
+	TEST_ASSERT(event.GetHandlerCount() == 10);
+	{
+		vint expected[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Execute(event);
+		TEST_ASSERT(CallsAre(calls, expected, 10));
+	}
+
+	// handlers keep their order when the storage is compacted
+	for (vint i = 0; i < 10; i += 2)
+	{
+		TEST_ASSERT(event.Detach(handlers[i]));
+	}
+	TEST_ASSERT(event.GetHandlerCount() < 10);
+	{
+		vint expected[] = { 1, 3, 5, 7, 9 };
+		Execute(event);
+		TEST_ASSERT(CallsAre(calls, expected, 5));
+	}
+	TEST_ASSERT(event.Detach(handlers[9]));
+	TEST_ASSERT(event.Detach(handlers[1]));
+	TEST_ASSERT(event.Attach(handlers[0]));
+	{
+		vint expected[] = { 3, 5, 7, 0 };
+		Execute(event);
+		TEST_ASSERT(CallsAre(calls, expected, 4));
+	}
+	for (vint i = 0; i < 10; i++)
+	{
+		event.Detach(handlers[i]);
+	}
+	TEST_ASSERT(event.GetHandlerCount() == 0);
+}
+
+TEST_CASE(TestGraphicsEventDetachDuringExecute)
+{
+	List<vint> calls;
+	TestEvent event;
+	Ptr<IHandler> second = CreateHandler(calls, 2);
+	Ptr<IHandler> fifth = CreateHandler(calls, 5);
+	Ptr<IHandler> added = CreateHandler(calls, 4);
+	Ptr<IHandler> self;
+	Ptr<IHandler> nested;
+
+	// the first handler detaches itself and two other handlers, and attaches a new one
+	self = new GuiNotifyEvent::FunctionHandler([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		calls.Add(1);
+		TEST_ASSERT(event.Detach(self));
+		TEST_ASSERT(event.Detach(second));
+		TEST_ASSERT(event.Detach(fifth));
+		TEST_ASSERT(event.Attach(added));
+		TEST_ASSERT(event.GetHandlerCount() == 5);
+	});
+
+	// the third handler executes the event again, the storage is not compacted until the outermost Execute returns
+	bool executing = false;
+	nested = new GuiNotifyEvent::FunctionHandler([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		calls.Add(3);
+		if (!executing)
+		{
+			executing = true;
+			Execute(event);
+			TEST_ASSERT(event.GetHandlerCount() == 5);
+		}
+	});
+
+	TEST_ASSERT(event.Attach(self));
+	TEST_ASSERT(event.Attach(second));
+	TEST_ASSERT(event.Attach(nested));
+	TEST_ASSERT(event.Attach(fifth));
+	{
+		vint expected[] = { 1, 3, 3, 4, 4 };
+		Execute(event);
+		TEST_ASSERT(CallsAre(calls, expected, 5));
+	}
+
+	// detached slots are compacted after executingCount drops to 0
+	TEST_ASSERT(event.GetHandlerCount() == 2);
+	{
+		vint expected[] = { 3, 4 };
+		Execute(event);
+		TEST_ASSERT(CallsAre(calls, expected, 2));
+	}
+	TEST_ASSERT(!event.Detach(self));
+	TEST_ASSERT(!event.Detach(second));
+	TEST_ASSERT(!event.Detach(fifth));
+}
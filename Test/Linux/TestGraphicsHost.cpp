@@ -0,0 +1,146 @@
+#include "TestBenchmark.h"
+#include "../../Source/NativeWindow/Headless/HeadlessNativeWindow.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::compositions;
+using namespace vl::presentation::headless;
+
+namespace test_graphics_host
+{
+	class CountingElement : public Object, public IGuiGraphicsElement, public Description<CountingElement>
+	{
+		DEFINE_GUI_GRAPHICS_ELEMENT(CountingElement, L"TestCountingElement")
+	protected:
+		Color						color;
+
+		CountingElement()
+		{
+		}
+	public:
+		Color GetColor()
+		{
+			return color;
+		}
+
+		void SetColor(Color value)
+		{
+			if (color != value)
+			{
+				color = value;
+				InvokeOnElementStateChanged();
+			}
+		}
+	};
+
+	vint renderCount = 0;
+
+	class CountingElementRenderer : public Object, public IGuiGraphicsRenderer
+	{
+		DEFINE_GUI_GRAPHICS_RENDERER(CountingElement, CountingElementRenderer, IGuiGraphicsRenderTarget)
+	protected:
+		void InitializeInternal() {}
+		void FinalizeInternal() {}
+		void RenderTargetChangedInternal(IGuiGraphicsRenderTarget* oldRenderTarget, IGuiGraphicsRenderTarget* newRenderTarget) {}
+	public:
+		void Render(Rect bounds)override
+		{
+			renderCount++;
+		}
+
+		void OnElementStateChanged()override
+		{
+		}
+	};
+
+	// an element written without DEFINE_GUI_GRAPHICS_ELEMENT, which relies on the default implementation of owner composition functions
+	class PlainElement : public Object, public IGuiGraphicsElement
+	{
+	public:
+		IGuiGraphicsElementFactory* GetFactory()override
+		{
+			return 0;
+		}
+
+		IGuiGraphicsRenderer* GetRenderer()override
+		{
+			return 0;
+		}
+	};
+
+	vint RenderFrames(vint frames)
+	{
+		vint count = renderCount;
+		for (vint i = 0; i < frames; i++)
+		{
+			ProcessHeadlessFrame(GetCurrentController());
+		}
+		return renderCount - count;
+	}
+}
+using namespace test_graphics_host;
+
+TEST_CASE(TestGraphicsHostRenderOnDemand)
+{
+	if (!GetGuiGraphicsResourceManager()->GetElementFactory(CountingElement::GetElementTypeName()))
+	{
+		CountingElementRenderer::Register();
+	}
+
+	INativeWindow* window = GetCurrentController()->WindowService()->CreateNativeWindow();
+	window->SetClientSize(Size(200, 200));
+	{
+		GuiGraphicsHost host;
+		host.SetNativeWindow(window);
+
+		Ptr<CountingElement> element = CountingElement::Create();
+		auto bounds = new GuiBoundsComposition;
+		bounds->SetOwnedElement(element);
+		bounds->SetBounds(Rect(10, 10, 100, 100));
+		host.GetMainComposition()->AddChild(bounds);
+		window->Show();
+
+		// settle the layout, then an idle window does not render
+		RenderFrames(10);
+		TEST_ASSERT(RenderFrames(10) == 0);
+
+		element->SetColor(Color(255, 0, 0));
+		TEST_ASSERT(RenderFrames(10) == 1);
+
+		element->SetColor(Color(255, 0, 0));
+		TEST_ASSERT(RenderFrames(10) == 0);
+
+		bounds->SetVisible(false);
+		bounds->SetVisible(true);
+		TEST_ASSERT(RenderFrames(10) == 1);
+
+		bounds->SetBounds(Rect(20, 20, 100, 100));
+		RenderFrames(10);
+		TEST_ASSERT(RenderFrames(10) == 0);
+
+		// the operating system asks the window to paint when its content is lost
+		FOREACH(INativeWindowListener*, listener, GetHeadlessForm(window)->GetListeners())
+		{
+			listener->Paint();
+		}
+		TEST_ASSERT(RenderFrames(10) == 1);
+
+		host.RequestRender();
+		TEST_ASSERT(RenderFrames(10) == 1);
+
+		window->Hide();
+		element->SetColor(Color(0, 255, 0));
+		TEST_ASSERT(RenderFrames(10) == 0);
+
+		host.SetNativeWindow(0);
+	}
+	GetCurrentController()->WindowService()->DestroyNativeWindow(window);
+
+	PlainElement plainElement;
+	auto composition = new GuiBoundsComposition;
+	plainElement.SetOwnerComposition(composition);
+	TEST_ASSERT(plainElement.GetOwnerComposition() == 0);
+	delete composition;
+}
@@ -0,0 +1,182 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+
+TEST_CASE(TestHashSet)
+{
+	HashSet<vint> set;
+	for (vint i = 0; i < 1000; i++)
+	{
+		TEST_ASSERT(set.Add(i * 7) == i);
+	}
+	TEST_ASSERT(set.Count() == 1000);
+	TEST_ASSERT(set.Add(7) == 1);
+	TEST_ASSERT(set.Count() == 1000);
+
+	for (vint i = 0; i < 1000; i++)
+	{
+		TEST_ASSERT(set.Contains(i * 7));
+		TEST_ASSERT(!set.Contains(i * 7 + 1));
+		TEST_ASSERT(set.IndexOf(i * 7) == i);
+	}
+
+	for (vint i = 0; i < 1000; i += 2)
+	{
+		TEST_ASSERT(set.Remove(i * 7));
+		TEST_ASSERT(!set.Remove(i * 7));
+	}
+	TEST_ASSERT(set.Count() == 500);
+	for (vint i = 0; i < 1000; i++)
+	{
+		TEST_ASSERT(set.Contains(i * 7) == (i % 2 == 1));
+	}
+	for (vint i = 0; i < set.Count(); i++)
+	{
+		TEST_ASSERT(set.IndexOf(set[i]) == i);
+	}
+
+	TEST_ASSERT(set.Clear());
+	TEST_ASSERT(set.Count() == 0);
+	TEST_ASSERT(!set.Contains(7));
+}
+
+TEST_CASE(TestHashDictionary)
+{
+	HashDictionary<WString, vint> dictionary;
+	for (vint i = 0; i < 1000; i++)
+	{
+		TEST_ASSERT(dictionary.Add(itow(i), i));
+	}
+	TEST_ASSERT(dictionary.Count() == 1000);
+	TEST_ERROR(dictionary.Add(L"1", 1));
+
+	for (vint i = 0; i < 1000; i++)
+	{
+		TEST_ASSERT(dictionary.Contains(itow(i)));
+		TEST_ASSERT(dictionary[itow(i)] == i);
+		TEST_ASSERT(dictionary.Keys().IndexOf(itow(i)) == i);
+	}
+	TEST_ASSERT(!dictionary.Contains(L"-1"));
+
+	TEST_ASSERT(dictionary.Set(L"1", 100));
+	TEST_ASSERT(dictionary.Set(L"-1", -1));
+	TEST_ASSERT(dictionary.Count() == 1001);
+	TEST_ASSERT(dictionary[L"1"] == 100);
+	TEST_ASSERT(dictionary[L"-1"] == -1);
+
+	for (vint i = 0; i < 1000; i += 3)
+	{
+		TEST_ASSERT(dictionary.Remove(itow(i)));
+	}
+	TEST_ASSERT(!dictionary.Remove(L"0"));
+	TEST_ASSERT(dictionary.Count() == 667);
+	for (vint i = 2; i < 1000; i++)
+	{
+		TEST_ASSERT(dictionary.Contains(itow(i)) == (i % 3 != 0));
+	}
+	for (vint i = 0; i < dictionary.Count(); i++)
+	{
+		TEST_ASSERT(dictionary[dictionary.Keys()[i]] == dictionary.Values()[i]);
+	}
+
+	typedef Pair<WString, vint> StringIntPair;
+	vint sum = 0;
+	FOREACH(StringIntPair, pair, dictionary)
+	{
+		TEST_ASSERT(wtoi(pair.key) == pair.value || pair.key == L"1");
+		sum += pair.value;
+	}
+	TEST_ASSERT(sum == From(dictionary.Values()).Aggregate([](vint a, vint b) {return a + b; }));
+
+	HashDictionary<WString, vint> copied;
+	CopyFrom(copied, dictionary);
+	TEST_ASSERT(copied.Count() == dictionary.Count());
+	TEST_ASSERT(copied[L"-1"] == -1);
+}
+
+TEST_CASE(TestHashGroup)
+{
+	HashGroup<vint, WString> group;
+	for (vint i = 0; i < 100; i++)
+	{
+		for (vint j = 0; j <= i % 5; j++)
+		{
+			group.Add(i, itow(j));
+		}
+	}
+	TEST_ASSERT(group.Count() == 100);
+	for (vint i = 0; i < 100; i++)
+	{
+		TEST_ASSERT(group.Contains(i));
+		TEST_ASSERT(group[i].Count() == i % 5 + 1);
+		TEST_ASSERT(group.Contains(i, L"0"));
+		TEST_ASSERT(!group.Contains(i, L"5"));
+	}
+	TEST_ASSERT(!group.Contains(100));
+
+	TEST_ASSERT(group.Remove(4, L"4"));
+	TEST_ASSERT(group[4].Count() == 4);
+	TEST_ASSERT(group.Remove(0, L"0"));
+	TEST_ASSERT(!group.Contains(0));
+	TEST_ASSERT(group.Remove(1));
+	TEST_ASSERT(!group.Contains(1));
+	TEST_ASSERT(group.Count() == 98);
+	for (vint i = 0; i < group.Count(); i++)
+	{
+		TEST_ASSERT(group.Get(group.Keys()[i]).Count() == group.GetByIndex(i).Count());
+	}
+
+	typedef Pair<vint, WString> IntStringPair;
+	vint pairs = 0;
+	FOREACH(IntStringPair, pair, group)
+	{
+		TEST_ASSERT(group.Contains(pair.key, pair.value));
+		pairs++;
+	}
+	TEST_ASSERT(pairs == 300 - 1 - 1 - 2);
+}
+
+BENCHMARK_CASE(BenchmarkHashDictionary)
+{
+	const vint count = 20000;
+	const vint passes = 10;
+	List<WString> keys;
+	for (vint i = 0; i < count; i++)
+	{
+		// scatter the keys, so that the sorted Dictionary inserts in the middle
+		keys.Add(L"key_" + itow((i * 7919) % count));
+	}
+
+	Dictionary<WString, vint> dictionary;
+	HashDictionary<WString, vint> hashDictionary;
+	vint dictionaryFound = 0;
+	vint hashDictionaryFound = 0;
+
+	double dictionaryAdd = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < count; i++) dictionary.Add(keys[i], i);
+	});
+	double hashDictionaryAdd = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < count; i++) hashDictionary.Add(keys[i], i);
+	});
+	double dictionaryLookup = BenchmarkMilliseconds([&]()
+	{
+		for (vint p = 0; p < passes; p++)
+			for (vint i = 0; i < count; i++)
+				if (dictionary.Keys().Contains(keys[i])) dictionaryFound++;
+	});
+	double hashDictionaryLookup = BenchmarkMilliseconds([&]()
+	{
+		for (vint p = 0; p < passes; p++)
+			for (vint i = 0; i < count; i++)
+				if (hashDictionary.Contains(keys[i])) hashDictionaryFound++;
+	});
+	TEST_ASSERT(dictionaryFound == count * passes);
+	TEST_ASSERT(hashDictionaryFound == count * passes);
+
+	TEST_PRINT(itow(count) + L" string keys, add once, then look up " + itow(passes) + L" times:");
+	TEST_PRINT(L"    Dictionary:     add " + FormatBenchmarkNumber(dictionaryAdd) + L"ms, lookup " + FormatBenchmarkNumber(dictionaryLookup) + L"ms");
+	TEST_PRINT(L"    HashDictionary: add " + FormatBenchmarkNumber(hashDictionaryAdd) + L"ms, lookup " + FormatBenchmarkNumber(hashDictionaryLookup) + L"ms");
+}
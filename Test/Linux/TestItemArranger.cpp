@@ -0,0 +1,168 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+
+namespace test_item_arranger
+{
+	// exposes the binary indexed trees, so that they could be compared with sums over all items
+	class TestVariableHeightItemArranger : public list::VariableHeightItemArranger
+	{
+	public:
+		void Reset(vint count)
+		{
+			ResetItemHeights(count);
+			BuildItemHeightTrees();
+		}
+
+		void Measure(vint itemIndex, vint height)
+		{
+			SetItemHeight(itemIndex, height);
+		}
+
+		// changes heights without updating the trees, as OnItemModified does before rebuilding them
+		void Replace(vint itemIndex, vint height)
+		{
+			itemHeights[itemIndex] = height;
+		}
+
+		void Rebuild()
+		{
+			BuildItemHeightTrees();
+		}
+
+		vint Count()
+		{
+			return itemHeights.Count();
+		}
+
+		vint Top(vint itemIndex)
+		{
+			return GetItemTop(itemIndex);
+		}
+
+		vint TotalHeight()
+		{
+			return GetTotalHeight();
+		}
+
+		vint IndexFromPosition(vint y)
+		{
+			return GetItemIndexFromPosition(y);
+		}
+
+		vint EstimatedHeight()
+		{
+			return estimatedHeight;
+		}
+
+		vint RawHeight(vint itemIndex)
+		{
+			return itemHeights[itemIndex];
+		}
+	};
+
+	// the arranger before binary indexed trees: sum heights of all items above
+	vint ReferenceEstimatedHeight(TestVariableHeightItemArranger& arranger, vint oldEstimatedHeight)
+	{
+		vint height = 0;
+		vint count = 0;
+		for (vint i = 0; i < arranger.Count(); i++)
+		{
+			vint itemHeight = arranger.RawHeight(i);
+			if (itemHeight != -1)
+			{
+				height += itemHeight;
+				count++;
+			}
+		}
+		if (count == 0) return oldEstimatedHeight;
+		return height / count < 1 ? 1 : height / count;
+	}
+
+	void ReferenceTops(TestVariableHeightItemArranger& arranger, List<vint>& tops)
+	{
+		tops.Clear();
+		vint top = 0;
+		tops.Add(top);
+		for (vint i = 0; i < arranger.Count(); i++)
+		{
+			vint itemHeight = arranger.RawHeight(i);
+			top += itemHeight == -1 ? arranger.EstimatedHeight() : itemHeight;
+			tops.Add(top);
+		}
+	}
+
+	vint ReferenceIndexFromPosition(List<vint>& tops, vint y)
+	{
+		vint count = tops.Count() - 1;
+		if (count == 0 || y < 0) return 0;
+		for (vint i = count; i > 0; i--)
+		{
+			if (tops[i] <= y)
+			{
+				return i < count ? i : count - 1;
+			}
+		}
+		return 0;
+	}
+
+	bool MatchesReference(TestVariableHeightItemArranger& arranger)
+	{
+		List<vint> tops;
+		ReferenceTops(arranger, tops);
+		vint count = arranger.Count();
+		for (vint i = 0; i <= count; i++)
+		{
+			if (arranger.Top(i) != tops[i]) return false;
+		}
+		if (arranger.TotalHeight() != tops[count]) return false;
+
+		for (vint y = -2; y <= tops[count] + 2; y++)
+		{
+			if (arranger.IndexFromPosition(y) != ReferenceIndexFromPosition(tops, y)) return false;
+		}
+		return true;
+	}
+}
+using namespace test_item_arranger;
+
+TEST_CASE(TestVariableHeightItemArranger)
+{
+	TestRandom random;
+	TestVariableHeightItemArranger arranger;
+
+	arranger.Reset(0);
+	TEST_ASSERT(arranger.TotalHeight() == 0);
+	TEST_ASSERT(arranger.IndexFromPosition(10) == 0);
+
+	// count covers lengths that are and are not powers of 2
+	vint counts[] = { 1, 2, 7, 16, 33, 100 };
+	for (vint c = 0; c < sizeof(counts) / sizeof(*counts); c++)
+	{
+		vint count = counts[c];
+		arranger.Reset(count);
+		TEST_ASSERT(MatchesReference(arranger));
+
+		// items are measured in random order, including items measured again with different heights and empty items
+		for (vint i = 0; i < count * 2; i++)
+		{
+			vint oldEstimatedHeight = arranger.EstimatedHeight();
+			arranger.Measure(random.Next(count), random.Next(4) == 0 ? 0 : 1 + random.Next(30));
+			TEST_ASSERT(arranger.EstimatedHeight() == ReferenceEstimatedHeight(arranger, oldEstimatedHeight));
+			TEST_ASSERT(MatchesReference(arranger));
+		}
+
+		// items are replaced and the trees are rebuilt
+		for (vint i = 0; i < count; i++)
+		{
+			arranger.Replace(random.Next(count), random.Next(3) == 0 ? -1 : random.Next(20));
+		}
+		vint oldEstimatedHeight = arranger.EstimatedHeight();
+		arranger.Rebuild();
+		TEST_ASSERT(arranger.EstimatedHeight() == ReferenceEstimatedHeight(arranger, oldEstimatedHeight));
+		TEST_ASSERT(MatchesReference(arranger));
+	}
+}
@@ -0,0 +1,161 @@
+#include "TestBenchmark.h"
+#include "../../Source/GraphicsElement/Software/GuiGraphicsSoftware.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::elements_software;
+
+namespace test_layout_provider
+{
+	struct ParagraphModel
+	{
+		WString								text;
+		Array<vint>							widths;			// width of each character, an inline object is measured at its first character
+		Ptr<IGuiGraphicsParagraph>			paragraph;
+	};
+
+	void CreateParagraph(TestRandom& random, ParagraphModel& model)
+	{
+		// words with spaces, CJK characters and line breaks
+		const wchar_t* words[] = { L"a", L"word", L"wrapping", L"\x4E2D\x6587", L"  ", L"\r\n", L"\t", L"x\x4E00y" };
+		WString text;
+		vint wordCount = 5 + random.Next(40);
+		for (vint i = 0; i < wordCount; i++)
+		{
+			text += words[random.Next(sizeof(words) / sizeof(*words))];
+			text += L" ";
+		}
+		model.text = text;
+		model.paragraph = GetGuiGraphicsResourceManager()->GetLayoutProvider()->CreateParagraph(text, nullptr, nullptr);
+
+		FontProperties font = GetCurrentController()->ResourceService()->GetDefaultFont();
+		Array<vint> sizes(text.Length());
+		for (vint i = 0; i < text.Length(); i++)
+		{
+			sizes[i] = font.size;
+		}
+		for (vint i = 0; i < 3; i++)
+		{
+			vint start = random.Next(text.Length());
+			vint length = random.Next(text.Length() - start + 1);
+			vint size = font.size + random.Next(10);
+			TEST_ASSERT(model.paragraph->SetSize(start, length, size));
+			for (vint j = start; j < start + length; j++)
+			{
+				sizes[j] = size;
+			}
+		}
+
+		model.widths.Resize(text.Length());
+		for (vint i = 0; i < text.Length(); i++)
+		{
+			FontProperties charFont = font;
+			charFont.size = sizes[i];
+			wchar_t c = text[i];
+			model.widths[i] = c == L'\r' || c == L'\n' ? 0 : GetSoftwareCharWidth(charFont, c);
+		}
+
+		// an inline object is placed as a whole, it is a unit covering multiple characters
+		vint start = random.Next(text.Length() - 2);
+		if (text[start] != L'\r' && text[start] != L'\n' && text[start + 1] != L'\r' && text[start + 1] != L'\n')
+		{
+			IGuiGraphicsParagraph::InlineObjectProperties properties;
+			properties.size = Size(10 + random.Next(20), 5 + random.Next(30));
+			properties.breakCondition = IGuiGraphicsParagraph::Alone;
+			TEST_ASSERT(model.paragraph->SetInlineObject(start, 2, properties));
+			model.widths[start] = properties.size.x;
+			model.widths[start + 1] = 0;
+		}
+
+		Alignment alignments[] = { Alignment::Left, Alignment::Center, Alignment::Right };
+		model.paragraph->SetParagraphAlignment(alignments[random.Next(3)]);
+		model.paragraph->SetMaxWidth(40 + random.Next(300));
+	}
+
+	// x of a caret as the sum of all widths before it in the line
+	vint ReferenceCaretX(ParagraphModel& model, vint lineStart, vint caret)
+	{
+		vint x = model.paragraph->GetCaretBounds(lineStart, false).x1;
+		for (vint i = lineStart; i < caret; i++)
+		{
+			x += model.widths[i];
+		}
+		return x;
+	}
+
+	// the caret at a point, by checking units in the line one by one, as the paragraph did before binary search
+	vint ReferenceCaretFromLine(ParagraphModel& model, vint lineStart, vint lastCaret, vint x)
+	{
+		vint caret = lineStart;
+		while (caret < lastCaret)
+		{
+			vint next = model.paragraph->GetNearestCaretFromTextPos(caret + 1, false);
+			vint width = 0;
+			for (vint i = caret; i < next; i++)
+			{
+				width += model.widths[i];
+			}
+			if (x < ReferenceCaretX(model, lineStart, caret) + width / 2)
+			{
+				return caret;
+			}
+			caret = next;
+		}
+		return lastCaret;
+	}
+}
+using namespace test_layout_provider;
+
+TEST_CASE(TestLayoutProviderCarets)
+{
+	TestRandom random;
+	vint paragraphCount = 50;
+	vint lines = 0;
+	for (vint p = 0; p < paragraphCount; p++)
+	{
+		ParagraphModel model;
+		CreateParagraph(random, model);
+		auto paragraph = model.paragraph;
+		vint length = model.text.Length();
+
+		vint lineStart = 0;
+		while (true)
+		{
+			bool preferFrontSide = false;
+			TEST_ASSERT(paragraph->GetCaret(lineStart, IGuiGraphicsParagraph::CaretLineFirst, preferFrontSide) == lineStart);
+			vint lastCaret = paragraph->GetCaret(lineStart, IGuiGraphicsParagraph::CaretLineLast, preferFrontSide);
+			Rect lineBounds = paragraph->GetCaretBounds(lineStart, false);
+			lines++;
+
+			// caret positions, the last caret in a wrapped line is at the end of the line only for the front side
+			for (vint caret = lineStart; caret <= lastCaret; caret++)
+			{
+				if (!paragraph->IsValidCaret(caret)) continue;
+				bool frontSide = caret == lastCaret && caret != lineStart;
+				Rect bounds = paragraph->GetCaretBounds(caret, frontSide);
+				TEST_ASSERT(bounds.y1 == lineBounds.y1);
+				TEST_ASSERT(bounds.x1 == ReferenceCaretX(model, lineStart, caret));
+			}
+
+			// carets from points in the line
+			for (vint x = lineBounds.x1 - 5; x <= ReferenceCaretX(model, lineStart, lastCaret) + 5; x++)
+			{
+				vint expected = ReferenceCaretFromLine(model, lineStart, lastCaret, x);
+				TEST_ASSERT(paragraph->GetCaretFromPoint(Point(x, lineBounds.y1)) == expected);
+				TEST_ASSERT(paragraph->GetCaretFromPoint(Point(x, lineBounds.y2 - 1)) == expected);
+			}
+
+			if (lastCaret == length) break;
+			vint next = lastCaret;
+			if (model.text[next] == L'\r') next++;
+			if (model.text[next] == L'\n') next++;
+			TEST_ASSERT(next > lineStart);
+			lineStart = next;
+		}
+	}
+
+	// most paragraphs are wrapped into multiple lines
+	TEST_ASSERT(lines > paragraphCount * 2);
+}
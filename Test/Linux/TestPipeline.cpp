@@ -0,0 +1,122 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+
+namespace test_pipeline
+{
+	template<typename TSource>
+	void AssertSameAsLazyList(const Pipeline<TSource>& pipeline, const LazyList<typename TSource::ElementType>& lazyList)
+	{
+		List<typename TSource::ElementType> a, b;
+		CopyFrom(a, pipeline);
+		CopyFrom(b, lazyList);
+		TEST_ASSERT(CompareEnumerable(a, b) == 0);
+		TEST_ASSERT(pipeline.Count() == lazyList.Count());
+		TEST_ASSERT(CompareEnumerable(pipeline.ToLazyList(), lazyList) == 0);
+	}
+}
+using namespace test_pipeline;
+
+TEST_CASE(TestPipeline)
+{
+	List<vint> xs;
+	for (vint i = 0; i < 10; i++) xs.Add(i);
+
+	auto isEven = [](vint x) {return x % 2 == 0; };
+	auto timesTen = [](vint x) {return x * 10; };
+	auto sum = [](vint a, vint b) {return a + b; };
+
+	auto pipeline = PipelineFrom(xs).Where(isEven).Select(timesTen);
+	auto lazyList = From(xs).Where(isEven).Select(timesTen);
+	AssertSameAsLazyList(pipeline, lazyList);
+	AssertSameAsLazyList(pipeline.Skip(1).Take(3), lazyList.Skip(1).Take(3));
+	AssertSameAsLazyList(pipeline.Skip(10), lazyList.Skip(10));
+	AssertSameAsLazyList(pipeline.Take(0), lazyList.Take(0));
+
+	TEST_ASSERT(pipeline.First() == lazyList.First());
+	TEST_ASSERT(pipeline.Skip(10).First(-1) == lazyList.Skip(10).First(-1));
+	TEST_ASSERT(pipeline.Skip(10).IsEmpty() && lazyList.Skip(10).Count() == 0);
+	TEST_ASSERT(!pipeline.IsEmpty() && lazyList.Count() > 0);
+	TEST_ASSERT(pipeline.Aggregate((vint)0, sum) == lazyList.Aggregate(sum));
+	TEST_ASSERT(pipeline.All([](vint x) {return x % 10 == 0; }) == lazyList.All([](vint x) {return x % 10 == 0; }));
+	TEST_ASSERT(pipeline.Any([](vint x) {return x == 40; }) == lazyList.Any([](vint x) {return x == 40; }));
+	TEST_ASSERT(pipeline.Any([](vint x) {return x == 30; }) == lazyList.Any([](vint x) {return x == 30; }));
+	TEST_ERROR(pipeline.Skip(10).First());
+
+	vint evaluated = 0;
+	TEST_ASSERT(!PipelineFrom(xs).All([&](vint x) {evaluated++; return x < 3; }));
+	TEST_ASSERT(evaluated == 4);
+
+	{
+		Array<vint> ys;
+		CopyFrom(ys, pipeline);
+		CopyFrom(ys, pipeline, true);
+		TEST_ASSERT(ys.Count() == 10 && ys[4] == 80 && ys[5] == 0);
+	}
+	{
+		auto enumerator = pipeline.ToLazyList().CreateEnumerator();
+		TEST_ASSERT(enumerator->Next() && enumerator->Next());
+		auto cloned = enumerator->Clone();
+		TEST_ASSERT(cloned->Current() == 20 && cloned->Index() == 1);
+		enumerator->Reset();
+		TEST_ASSERT(enumerator->Next() && enumerator->Current() == 0);
+		delete enumerator;
+		delete cloned;
+	}
+
+	AssertSameAsLazyList(PipelineFrom(lazyList).Where([](vint x) {return x > 30; }), lazyList.Where([](vint x) {return x > 30; }));
+	AssertSameAsLazyList(PipelineRange<vint>(3, 4).Select(timesTen), Range<vint>(3, 4).Select(timesTen));
+
+	{
+		SortedList<vint> sorted;
+		sorted.Add(3);
+		sorted.Add(1);
+		sorted.Add(2);
+		AssertSameAsLazyList(PipelineFrom(sorted).Select(timesTen), From(sorted).Select(timesTen));
+	}
+	{
+		// Dictionary has Count and Get, but it is enumerated by pairs like LazyList
+		Dictionary<vint, vint> dictionary;
+		dictionary.Add(1, 2);
+		dictionary.Add(3, 4);
+		auto value = [](const Pair<vint, vint>& pair) {return pair.value; };
+		AssertSameAsLazyList(PipelineFrom(dictionary).Select(value), From(dictionary).Select(value));
+	}
+	{
+		List<WString> strings;
+		strings.Add(L"a");
+		strings.Add(L"bb");
+		strings.Add(L"ccc");
+		auto isLong = [](const WString& s) {return s.Length() > 1; };
+		AssertSameAsLazyList(PipelineFrom(strings).Where(isLong), From(strings).Where(isLong));
+		TEST_ASSERT(PipelineFrom(strings).Where(isLong).First(L"") == L"bb");
+	}
+}
+
+BENCHMARK_CASE(BenchmarkPipeline)
+{
+	const vint count = 10000000;
+	List<vint> xs;
+	for (vint i = 0; i < count; i++) xs.Add(i);
+
+	auto isMultipleOfThree = [](vint x) {return x % 3 == 0; };
+	auto twice = [](vint x) {return x * 2; };
+	auto sum = [](vint a, vint b) {return a + b; };
+
+	vint lazyListResult = 0;
+	vint pipelineResult = 0;
+	double lazyListTime = BenchmarkMilliseconds([&]()
+	{
+		lazyListResult = From(xs).Where(isMultipleOfThree).Select(twice).Aggregate(sum);
+	});
+	double pipelineTime = BenchmarkMilliseconds([&]()
+	{
+		pipelineResult = PipelineFrom(xs).Where(isMultipleOfThree).Select(twice).Aggregate((vint)0, sum);
+	});
+	TEST_ASSERT(lazyListResult == pipelineResult);
+
+	TEST_PRINT(L"Where+Select+Aggregate over " + itow(count) + L" integers:");
+	TEST_PRINT(L"    LazyList: " + FormatBenchmarkNumber(lazyListTime * 1000000 / count) + L"ns per element");
+	TEST_PRINT(L"    Pipeline: " + FormatBenchmarkNumber(pipelineTime * 1000000 / count) + L"ns per element");
+}
@@ -0,0 +1,79 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::regex;
+
+namespace test_regex_lexers
+{
+	void CreateTokens(List<WString>& tokens)
+	{
+		tokens.Add(L"[a-zA-Z_]/w*");
+		tokens.Add(L"/d+(./d+)?");
+		tokens.Add(L"/s+");
+		tokens.Add(L"[一-龥]+");
+		tokens.Add(L"[+/-*//()]");
+	}
+}
+using namespace test_regex_lexers;
+
+TEST_CASE(TestRegexLexer)
+{
+	List<WString> tokenDefinitions;
+	CreateTokens(tokenDefinitions);
+	RegexLexer lexer(tokenDefinitions);
+
+	List<RegexToken> tokens;
+	CopyFrom(tokens, lexer.Parse(L"x1 + 3.14*(中文 - y)é"));
+	TEST_ASSERT(tokens.Count() == 14);
+
+	vint expectedTokens[] = { 0, 2, 4, 2, 1, 4, 4, 3, 2, 4, 2, 0, 4, -1 };
+	vint expectedLengths[] = { 2, 1, 1, 1, 4, 1, 1, 2, 1, 1, 1, 1, 1, 1 };
+	for (vint i = 0; i < tokens.Count(); i++)
+	{
+		TEST_ASSERT(tokens[i].token == expectedTokens[i]);
+		TEST_ASSERT(tokens[i].length == expectedLengths[i]);
+	}
+
+	Regex regex(L"^[一-龥]+[a-z]$");
+	TEST_ASSERT(regex.TestHead(L"中文x"));
+	TEST_ASSERT(!regex.TestHead(L"中éx"));
+	TEST_ASSERT(!regex.TestHead(L"\U0001F600x"));
+	TEST_ASSERT(Regex(L"^[^a]$").TestHead(L"é"));
+	TEST_ASSERT(Regex(L"^[^a]$").TestHead(L"龥"));
+}
+
+BENCHMARK_CASE(BenchmarkRegexLexer)
+{
+	const vint lexerCount = 200;
+	List<WString> tokenDefinitions;
+	CreateTokens(tokenDefinitions);
+
+	List<Ptr<RegexLexer>> lexers;
+	vint memoryBefore = GetResidentMemoryBytes();
+	double create = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < lexerCount; i++)
+		{
+			lexers.Add(new RegexLexer(tokenDefinitions));
+		}
+	});
+	vint memoryAfter = GetResidentMemoryBytes();
+
+	WString code;
+	for (vint i = 0; i < 10000; i++)
+	{
+		code += L"value" + itow(i) + L" = (3.14 + x) * 中文\r\n";
+	}
+	vint tokenCount = 0;
+	double parse = BenchmarkMilliseconds([&]()
+	{
+		tokenCount = From(lexers[0]->Parse(code)).Count();
+	});
+	TEST_ASSERT(tokenCount == 10000 * 16);
+
+	TEST_PRINT(itow(lexerCount) + L" lexers with identifier, number, space and CJK tokens:");
+	TEST_PRINT(L"    Memory: " + itow((memoryAfter - memoryBefore) / 1024 / 1024) + L"MB");
+	TEST_PRINT(L"    Create: " + FormatBenchmarkNumber(create) + L"ms");
+	TEST_PRINT(L"    Parse " + itow(code.Length()) + L" characters into " + itow(tokenCount) + L" tokens: " + FormatBenchmarkNumber(parse) + L"ms");
+}
@@ -0,0 +1,152 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::stream;
+using namespace vl::parsing::xml;
+using namespace vl::presentation;
+
+namespace test_resource_loading
+{
+	const vint ItemCount = 500;
+
+	Ptr<XmlDocument> CreateXml(const WString& rootName, vint childCount)
+	{
+		auto xml = MakePtr<XmlDocument>();
+		xml->rootElement = MakePtr<XmlElement>();
+		xml->rootElement->name.value = rootName;
+		for (vint i = 0; i < childCount; i++)
+		{
+			auto text = MakePtr<XmlText>();
+			text->content.value = L"Text " + itow(i);
+
+			auto child = MakePtr<XmlElement>();
+			child->name.value = L"Child";
+			child->subNodes.Add(text);
+			xml->rootElement->subNodes.Add(child);
+		}
+		return xml;
+	}
+
+	void SaveResource(MemoryStream& stream)
+	{
+		auto resource = MakePtr<GuiResource>();
+		auto folder = MakePtr<GuiResourceFolder>();
+		resource->AddFolder(L"Items", folder);
+		for (vint i = 0; i < ItemCount; i++)
+		{
+			auto item = MakePtr<GuiResourceItem>();
+			item->SetContent(L"Xml", CreateXml(L"Item" + itow(i), 100));
+			folder->AddItem(L"Item" + itow(i), item);
+		}
+		{
+			// "a b" is printed as an element with an attribute without a value, which cannot be parsed back
+			auto item = MakePtr<GuiResourceItem>();
+			item->SetContent(L"Xml", CreateXml(L"a b", 0));
+			resource->AddItem(L"Broken", item);
+		}
+		resource->SavePrecompiledBinary(stream);
+	}
+
+	Ptr<GuiResource> LoadResource(MemoryStream& stream)
+	{
+		stream.SeekFromBegin(0);
+		List<WString> errors;
+		auto resource = GuiResource::LoadPrecompiledBinary(stream, errors);
+		TEST_ASSERT(resource);
+		TEST_ASSERT(errors.Count() == 0);
+		return resource;
+	}
+
+	// written by SavePrecompiledBinary before the format began with PrecompiledBinaryHeader, on a 64-bit build
+	// it contains two xml items "Items/Item0" and "Items/Item1" with two children each
+	const vuint8_t OldFormatBinary[] =
+	{
+		0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x03, 0x00, 0x00, 0x00, 0x58, 0x6D, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05,
+		0x00, 0x00, 0x00, 0x49, 0x74, 0x65, 0x6D, 0x73, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x05, 0x00, 0x00, 0x00, 0x49, 0x74, 0x65, 0x6D, 0x30, 0x39, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x39, 0x00, 0x00, 0x00, 0x3C, 0x49, 0x74, 0x65, 0x6D, 0x30, 0x3E, 0x3C, 0x43, 0x68, 0x69,
+		0x6C, 0x64, 0x3E, 0x54, 0x65, 0x78, 0x74, 0x20, 0x30, 0x3C, 0x2F, 0x43, 0x68, 0x69, 0x6C, 0x64,
+		0x3E, 0x3C, 0x43, 0x68, 0x69, 0x6C, 0x64, 0x3E, 0x54, 0x65, 0x78, 0x74, 0x20, 0x31, 0x3C, 0x2F,
+		0x43, 0x68, 0x69, 0x6C, 0x64, 0x3E, 0x3C, 0x2F, 0x49, 0x74, 0x65, 0x6D, 0x30, 0x3E, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00,
+		0x00, 0x00, 0x49, 0x74, 0x65, 0x6D, 0x31, 0x39, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39,
+		0x00, 0x00, 0x00, 0x3C, 0x49, 0x74, 0x65, 0x6D, 0x31, 0x3E, 0x3C, 0x43, 0x68, 0x69, 0x6C, 0x64,
+		0x3E, 0x54, 0x65, 0x78, 0x74, 0x20, 0x30, 0x3C, 0x2F, 0x43, 0x68, 0x69, 0x6C, 0x64, 0x3E, 0x3C,
+		0x43, 0x68, 0x69, 0x6C, 0x64, 0x3E, 0x54, 0x65, 0x78, 0x74, 0x20, 0x31, 0x3C, 0x2F, 0x43, 0x68,
+		0x69, 0x6C, 0x64, 0x3E, 0x3C, 0x2F, 0x49, 0x74, 0x65, 0x6D, 0x31, 0x3E, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00
+	};
+}
+using namespace test_resource_loading;
+
+TEST_CASE(TestResourceLoading)
+{
+	MemoryStream stream;
+	SaveResource(stream);
+	auto resource = LoadResource(stream);
+
+	auto xml = resource->GetXmlByPath(L"Items/Item7");
+	TEST_ASSERT(xml->rootElement->name.value == L"Item7");
+	TEST_ASSERT(xml->rootElement->subNodes.Count() == 100);
+	TEST_ASSERT(resource->GetXmlByPath(L"Items\\Item7") == xml);
+	TEST_ASSERT(resource->GetFolder(L"Items")->GetItem(L"Item8")->GetLoadingErrors().Count() == 0);
+
+	auto broken = resource->GetItem(L"Broken");
+	TEST_ASSERT(broken);
+	TEST_ASSERT(!broken->GetContent());
+	TEST_ASSERT(broken->GetLoadingErrors().Count() > 0);
+	TEST_ASSERT(!resource->GetValueByPath(L"Broken"));
+	TEST_ASSERT(resource->GetItem(L"Broken") == broken);
+	TEST_ASSERT(broken->GetLoadingErrors().Count() > 0);
+	TEST_EXCEPTION(resource->GetXmlByPath(L"Broken"), ArgumentException, [](const ArgumentException&) {});
+	TEST_EXCEPTION(resource->GetXmlByPath(L"Items/Missing"), ArgumentException, [](const ArgumentException&) {});
+}
+
+TEST_CASE(TestResourceLoadingOldFormat)
+{
+	MemoryStream stream;
+	stream.Write((void*)OldFormatBinary, sizeof(OldFormatBinary));
+	auto resource = LoadResource(stream);
+
+	for (vint i = 0; i < 2; i++)
+	{
+		auto xml = resource->GetXmlByPath(L"Items/Item" + itow(i));
+		TEST_ASSERT(xml->rootElement->name.value == L"Item" + itow(i));
+		TEST_ASSERT(xml->rootElement->subNodes.Count() == 2);
+	}
+	TEST_ASSERT(!resource->GetValueByPath(L"Items/Item2"));
+}
+
+BENCHMARK_CASE(BenchmarkResourceLoading)
+{
+	MemoryStream stream;
+	SaveResource(stream);
+
+	Ptr<GuiResource> lazyResource, eagerResource;
+	double lazy = BenchmarkMilliseconds([&]()
+	{
+		lazyResource = LoadResource(stream);
+	});
+	double firstItem = BenchmarkMilliseconds([&]()
+	{
+		TEST_ASSERT(lazyResource->GetXmlByPath(L"Items/Item0"));
+	});
+	double eager = BenchmarkMilliseconds([&]()
+	{
+		eagerResource = LoadResource(stream);
+		auto folder = eagerResource->GetFolder(L"Items");
+		for (vint i = 0; i < ItemCount; i++)
+		{
+			TEST_ASSERT(folder->GetItem(L"Item" + itow(i))->GetContent());
+		}
+	});
+
+	TEST_PRINT(L"Precompiled resource with " + itow(ItemCount) + L" xml items (" + itow(stream.Size() / 1024) + L"KB):");
+	TEST_PRINT(L"    Load: " + FormatBenchmarkNumber(lazy) + L"ms");
+	TEST_PRINT(L"    Access the first item: " + FormatBenchmarkNumber(firstItem) + L"ms");
+	TEST_PRINT(L"    Load and access all items: " + FormatBenchmarkNumber(eager) + L"ms");
+}
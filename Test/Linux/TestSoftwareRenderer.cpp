@@ -0,0 +1,132 @@
+#include "TestBenchmark.h"
+#include "../../Source/GraphicsElement/Software/GuiGraphicsSoftware.h"
+#include "../../Source/NativeWindow/Headless/HeadlessNativeWindow.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::elements_software;
+using namespace vl::presentation::compositions;
+using namespace vl::presentation::headless;
+
+namespace test_software_renderer
+{
+	// pixels of a window painted one by one, a pixel is blended only when it is inside the clipper
+	class ReferenceImage
+	{
+	public:
+		Size							size;
+		Array<Color>					pixels;
+
+		ReferenceImage(Size _size)
+			:size(_size)
+			, pixels(_size.x * _size.y)
+		{
+			for (vint i = 0; i < pixels.Count(); i++)
+			{
+				pixels[i] = Color(0, 0, 0, 0);
+			}
+		}
+
+		void Fill(Rect bounds, Rect clipper, Color color)
+		{
+			for (vint y = 0; y < size.y; y++)
+			{
+				for (vint x = 0; x < size.x; x++)
+				{
+					if (!bounds.Contains(Point(x, y)) || !clipper.Contains(Point(x, y))) continue;
+					Color& target = pixels[y * size.x + x];
+					vint a = color.a;
+					target.r = (unsigned char)((color.r * a + target.r * (255 - a) + 127) / 255);
+					target.g = (unsigned char)((color.g * a + target.g * (255 - a) + 127) / 255);
+					target.b = (unsigned char)((color.b * a + target.b * (255 - a) + 127) / 255);
+					target.a = (unsigned char)(a + (target.a * (255 - a) + 127) / 255);
+				}
+			}
+		}
+	};
+
+	GuiBoundsComposition* AddBackground(GuiGraphicsComposition* parent, Rect bounds, Color color)
+	{
+		auto element = GuiSolidBackgroundElement::Create();
+		element->SetColor(color);
+		auto composition = new GuiBoundsComposition;
+		composition->SetOwnedElement(element);
+		composition->SetBounds(bounds);
+		parent->AddChild(composition);
+		return composition;
+	}
+
+	void RenderFrames(vint frames)
+	{
+		for (vint i = 0; i < frames; i++)
+		{
+			ProcessHeadlessFrame(GetCurrentController());
+		}
+	}
+}
+using namespace test_software_renderer;
+
+TEST_CASE(TestSoftwareRenderTarget)
+{
+	Size clientSize(200, 100);
+	INativeWindow* window = GetCurrentController()->WindowService()->CreateNativeWindow();
+	window->SetClientSize(clientSize);
+	{
+		GuiGraphicsHost host;
+		host.SetNativeWindow(window);
+		ReferenceImage reference(clientSize);
+		Rect windowBounds(0, 0, clientSize.x, clientSize.y);
+
+		// an opaque rectangle, a translucent rectangle over it, and one that goes out of the window
+		AddBackground(host.GetMainComposition(), Rect(10, 10, 50, 50), Color(255, 0, 0));
+		reference.Fill(Rect(10, 10, 50, 50), windowBounds, Color(255, 0, 0));
+		AddBackground(host.GetMainComposition(), Rect(30, 30, 70, 70), Color(0, 0, 255, 128));
+		reference.Fill(Rect(30, 30, 70, 70), windowBounds, Color(0, 0, 255, 128));
+		AddBackground(host.GetMainComposition(), Rect(180, 80, 260, 160), Color(0, 128, 0, 200));
+		reference.Fill(Rect(180, 80, 260, 160), windowBounds, Color(0, 128, 0, 200));
+
+		// children are clipped by their parents
+		auto parent = AddBackground(host.GetMainComposition(), Rect(100, 10, 140, 40), Color(10, 20, 30, 40));
+		reference.Fill(Rect(100, 10, 140, 40), windowBounds, Color(10, 20, 30, 40));
+		AddBackground(parent, Rect(-10, -10, 20, 60), Color(200, 100, 50, 255));
+		reference.Fill(Rect(90, 0, 120, 50), Rect(100, 10, 140, 40), Color(200, 100, 50, 255));
+
+		window->Show();
+		RenderFrames(10);
+
+		ISoftwareRenderTarget* renderTarget = GetSoftwareRenderTarget(window);
+		TEST_ASSERT(renderTarget);
+		TEST_ASSERT(renderTarget->GetSize() == clientSize);
+		for (vint y = 0; y < clientSize.y; y++)
+		{
+			for (vint x = 0; x < clientSize.x; x++)
+			{
+				Color expected = reference.pixels[y * clientSize.x + x];
+				TEST_ASSERT(renderTarget->GetPixel(x, y) == expected);
+				TEST_ASSERT(renderTarget->GetBuffer()[y * clientSize.x + x] == expected);
+			}
+		}
+		TEST_ASSERT(renderTarget->GetPixel(-1, 0) == Color(0, 0, 0, 0));
+		TEST_ASSERT(renderTarget->GetPixel(0, clientSize.y) == Color(0, 0, 0, 0));
+
+		// a border is drawn on the outermost pixels of its bounds
+		auto border = GuiSolidBorderElement::Create();
+		border->SetColor(Color(0, 255, 0));
+		auto borderComposition = new GuiBoundsComposition;
+		borderComposition->SetOwnedElement(border);
+		borderComposition->SetBounds(Rect(150, 10, 170, 30));
+		host.GetMainComposition()->AddChild(borderComposition);
+		RenderFrames(10);
+		TEST_ASSERT(renderTarget->GetPixel(150, 10) == Color(0, 255, 0));
+		TEST_ASSERT(renderTarget->GetPixel(169, 29) == Color(0, 255, 0));
+		TEST_ASSERT(renderTarget->GetPixel(160, 10) == Color(0, 255, 0));
+		TEST_ASSERT(renderTarget->GetPixel(160, 20) == Color(0, 0, 0, 0));
+		TEST_ASSERT(renderTarget->GetPixel(149, 20) == Color(0, 0, 0, 0));
+
+		window->Hide();
+		host.SetNativeWindow(0);
+	}
+	GetCurrentController()->WindowService()->DestroyNativeWindow(window);
+}
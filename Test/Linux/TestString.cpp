@@ -0,0 +1,191 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+
+TEST_CASE(TestString)
+{
+	WString empty;
+	WString a = L"Vczh Library++";
+	WString b = WString(L"Vczh ") + L"Library++";
+	TEST_ASSERT(empty.Length() == 0 && empty == L"");
+	TEST_ASSERT(a == b && !(a != b));
+	TEST_ASSERT(a != L"Vczh Library--" && a != L"Vczh");
+	TEST_ASSERT(WString::Compare(a, b) == 0);
+	TEST_ASSERT(WString::Compare(WString(L"abc"), WString(L"abd")) < 0);
+	TEST_ASSERT(WString::Compare(WString(L"abc"), WString(L"ab")) > 0);
+
+	WString sub = a.Sub(5, 7);
+	TEST_ASSERT(sub == L"Library");
+	TEST_ASSERT(sub.Length() == 7 && sub.Buffer()[7] == 0);
+	TEST_ASSERT(a.Left(4) == L"Vczh" && a.Right(2) == L"++");
+	TEST_ASSERT(WString::Compare(a.Sub(0, 4), a.Left(4)) == 0);
+
+	TEST_ASSERT(a.IndexOf(L'V') == 0);
+	TEST_ASSERT(a.IndexOf(L'+') == 12);
+	TEST_ASSERT(a.IndexOf(L'-') == -1);
+	TEST_ASSERT(sub.IndexOf(L'V') == -1 && sub.IndexOf(L'y') == 6);
+	TEST_ASSERT(AString("abc").IndexOf('c') == 2);
+
+	WString c = a;
+	c += L"!";
+	TEST_ASSERT(a == L"Vczh Library++" && c == L"Vczh Library++!");
+	TEST_ASSERT(a.Insert(4, L" GacUI") == L"Vczh GacUI Library++");
+	TEST_ASSERT(a.Remove(4, 8) == L"Vczh++");
+	TEST_ASSERT(WString(L'x') == L"x");
+	TEST_ASSERT(wtoa(a) == "Vczh Library++" && atow(AString("Vczh")) == L"Vczh");
+
+	TEST_ASSERT(KeyHash<WString>::GetHashCode(a) == KeyHash<WString>::GetHashCode(b));
+	TEST_ASSERT(KeyHash<WString>::GetHashCode(sub) == KeyHash<WString>::GetHashCode(L"Library"));
+	TEST_ASSERT(KeyHash<WString>::GetHashCode(a) != KeyHash<WString>::GetHashCode(c));
+
+	{
+		// a substring keeps the characters alive after the original string is gone
+		WString* original = new WString(L"0123456789");
+		WString digits = original->Sub(3, 4);
+		delete original;
+		TEST_ASSERT(digits == L"3456");
+	}
+}
+
+BENCHMARK_CASE(BenchmarkString)
+{
+	const vint count = 1000000;
+	const vint passes = 100;
+	List<WString> words;
+	List<WString> copies;
+	WString text;
+	vint memoryBefore = GetResidentMemoryBytes();
+
+	double construct = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < count; i++)
+		{
+			words.Add(L"word_" + itow(i % 1000));
+		}
+	});
+	vint memoryAfter = GetResidentMemoryBytes();
+	double copy = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < count; i++)
+		{
+			copies.Add(WString(words[i].Buffer()));
+		}
+	});
+
+	vint equals = 0;
+	double compare = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 1; i < count; i++)
+		{
+			if (words[i] == copies[i - 1]) equals++;
+			if (WString::Compare(words[i], copies[i]) == 0) equals++;
+		}
+	});
+	TEST_ASSERT(equals == count - 1);
+
+	for (vint i = 0; i < 10000; i++)
+	{
+		text += L"abcdefghijklmnopqrstuvwxyz";
+	}
+	text += L"!#";
+	vint found = 0;
+	double indexOf = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < passes; i++)
+		{
+			found += text.IndexOf(i % 2 == 0 ? L'!' : L'#');
+		}
+	});
+	TEST_ASSERT(found == (text.Length() - 2) * passes + passes / 2);
+
+	TEST_PRINT(L"String operations:");
+	TEST_PRINT(L"    Construct " + itow(count) + L" strings: " + FormatBenchmarkNumber(construct) + L"ms");
+	TEST_PRINT(L"    Copy " + itow(count) + L" strings: " + FormatBenchmarkNumber(copy) + L"ms");
+	TEST_PRINT(L"    Compare " + itow(count * 2) + L" pairs: " + FormatBenchmarkNumber(compare) + L"ms");
+	TEST_PRINT(L"    IndexOf over " + itow(text.Length()) + L" characters " + itow(passes) + L" times: " + FormatBenchmarkNumber(indexOf) + L"ms");
+	TEST_PRINT(L"    Memory of " + itow(count) + L" strings: " + itow((memoryAfter - memoryBefore) / 1024 / 1024) + L"MB");
+}
+
+BENCHMARK_CASE(BenchmarkStringReflectionLookup)
+{
+	using namespace vl::reflection::description;
+	const vint passes = 100;
+
+	// names are copied, so that lookups compare characters like names read from resources
+	List<WString> typeNames;
+	List<ITypeDescriptor*> propertyTypes;
+	List<WString> propertyNames;
+	auto manager = GetGlobalTypeManager();
+	for (vint i = 0; i < manager->GetTypeDescriptorCount(); i++)
+	{
+		auto td = manager->GetTypeDescriptor(i);
+		typeNames.Add(WString(td->GetTypeName().Buffer()));
+		for (vint j = 0; j < td->GetPropertyCount(); j++)
+		{
+			propertyTypes.Add(td);
+			propertyNames.Add(WString(td->GetProperty(j)->GetName().Buffer()));
+		}
+	}
+
+	vint found = 0;
+	double typeLookup = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < passes; i++)
+		{
+			for (vint j = 0; j < typeNames.Count(); j++)
+			{
+				if (GetTypeDescriptor(typeNames[j])) found++;
+			}
+		}
+	});
+	TEST_ASSERT(found == typeNames.Count() * passes);
+
+	found = 0;
+	double propertyLookup = BenchmarkMilliseconds([&]()
+	{
+		for (vint i = 0; i < passes; i++)
+		{
+			for (vint j = 0; j < propertyNames.Count(); j++)
+			{
+				if (propertyTypes[j]->GetPropertyByName(propertyNames[j], true)) found++;
+			}
+		}
+	});
+	TEST_ASSERT(found == propertyNames.Count() * passes);
+
+	TEST_PRINT(L"Reflection lookups:");
+	TEST_PRINT(L"    GetTypeDescriptor " + itow(typeNames.Count() * passes) + L" times: " + FormatBenchmarkNumber(typeLookup) + L"ms");
+	TEST_PRINT(L"    GetPropertyByName " + itow(propertyNames.Count() * passes) + L" times: " + FormatBenchmarkNumber(propertyLookup) + L"ms");
+}
+
+BENCHMARK_CASE(BenchmarkStringXmlLoading)
+{
+	using namespace vl::parsing::xml;
+	const vint count = 20000;
+
+	// items are joined in groups, so that building the document does not copy the whole string for each item
+	WString xml = L"<Resource>";
+	for (vint i = 0; i < count; i += 100)
+	{
+		WString group;
+		for (vint j = i; j < i + 100; j++)
+		{
+			group += L"<Item Name=\"Item" + itow(j) + L"\" Type=\"Text\"><Text>Content " + itow(j) + L"</Text></Item>";
+		}
+		xml += group;
+	}
+	xml += L"</Resource>";
+
+	auto table = XmlLoadTable();
+	Ptr<XmlDocument> document;
+	double parsing = BenchmarkMilliseconds([&]()
+	{
+		document = XmlParseDocument(xml, table);
+	});
+	TEST_ASSERT(document);
+	TEST_ASSERT(document->rootElement->subNodes.Count() == count);
+
+	TEST_PRINT(L"XML loading:");
+	TEST_PRINT(L"    Parse " + itow(xml.Length()) + L" characters with " + itow(count * 2) + L" elements: " + FormatBenchmarkNumber(parsing) + L"ms");
+}
@@ -0,0 +1,187 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::elements::text;
+using namespace vl::presentation::controls;
+
+namespace test_text_colorizer
+{
+	// 0: default, 1: comment, a comment in /* */ could span multiple lines
+	void Lex(const wchar_t* text, vuint32_t* colors, vint length, vint& state)
+	{
+		for (vint i = 0; i < length; i++)
+		{
+			bool next = i + 1 < length;
+			if (state == 0 && next && text[i] == L'/' && text[i + 1] == L'*')
+			{
+				state = 1;
+				colors[i] = 1;
+			}
+			else if (state == 1 && next && text[i] == L'*' && text[i + 1] == L'/')
+			{
+				colors[i] = 1;
+				colors[i + 1] = 1;
+				state = 0;
+				i++;
+			}
+			else
+			{
+				colors[i] = (vuint32_t)state;
+			}
+		}
+	}
+
+	class TestColorizer : public GuiTextBoxColorizerBase
+	{
+	protected:
+		ColorArray							colors;
+
+	public:
+		volatile vint						colorizedLines = 0;
+
+		vint GetLexerStartState()override
+		{
+			return 0;
+		}
+
+		vint GetContextStartState()override
+		{
+			return 0;
+		}
+
+		void ColorizeLineWithCRLF(vint lineIndex, const wchar_t* text, vuint32_t* colors, vint length, vint& lexerState, vint& contextState)override
+		{
+			INCRC(&colorizedLines);
+			Lex(text, colors, length, lexerState);
+		}
+
+		const ColorArray& GetColors()override
+		{
+			return colors;
+		}
+
+		bool WaitUntilColorized()
+		{
+			for (vint i = 0; i < 5000; i++)
+			{
+				bool running = true;
+				SPIN_LOCK(*elementModifyLock)
+				{
+					running = isColorizerRunning;
+				}
+				if (!running) return true;
+				Thread::Sleep(1);
+			}
+			return false;
+		}
+	};
+
+	// colorizes all lines from the first line, as the colorizer did before it stopped at converged lines
+	bool MatchesReference(TextLines& lines)
+	{
+		vint state = 0;
+		Array<vuint32_t> colors;
+		for (vint row = 0; row < lines.GetCount(); row++)
+		{
+			TextLine& line = lines.GetLine(row);
+			WString text = WString(line.text, line.dataLength) + L"\r\n";
+			colors.Resize(text.Length());
+			Lex(text.Buffer(), &colors[0], text.Length(), state);
+			if (line.lexerFinalState != state) return false;
+			for (vint i = 0; i < line.dataLength; i++)
+			{
+				if (line.att[i].colorIndex != colors[i]) return false;
+			}
+		}
+		return true;
+	}
+
+	WString CreateText(vint rowCount)
+	{
+		WString text;
+		for (vint i = 0; i < rowCount; i++)
+		{
+			if (i > 0) text += L"\r\n";
+			text += L"int value" + itow(i) + L" = 0;";
+			if (i % 100 == 10) text += L" /* comment";
+			if (i % 100 == 15) text += L" end */";
+		}
+		return text;
+	}
+
+	void Modify(GuiColorizedTextElement* element, SpinLock& lock, TestColorizer& colorizer, TextPos start, TextPos end, const WString& input)
+	{
+		ICommonTextEditCallback::TextEditNotifyStruct arguments;
+		SPIN_LOCK(lock)
+		{
+			arguments.originalStart = start;
+			arguments.originalEnd = end;
+			arguments.inputStart = start;
+			arguments.inputEnd = element->GetLines().Modify(start, end, input);
+			arguments.inputText = input;
+		}
+		colorizer.TextEditNotify(arguments);
+	}
+}
+using namespace test_text_colorizer;
+
+TEST_CASE(TestTextColorizerConvergence)
+{
+	const vint rowCount = 3000;
+	Ptr<GuiColorizedTextElement> element = GuiColorizedTextElement::Create();
+	TextLines& lines = element->GetLines();
+	lines.SetText(CreateText(rowCount));
+
+	SpinLock lock;
+	TestColorizer colorizer;
+	colorizer.Attach(element.Obj(), lock, nullptr, 0);
+	TEST_ASSERT(colorizer.WaitUntilColorized());
+	TEST_ASSERT(colorizer.colorizedLines == rowCount);
+	TEST_ASSERT(MatchesReference(lines));
+
+	// an edit that does not change the state at the end of the line only colorizes one batch
+	colorizer.colorizedLines = 0;
+	Modify(element.Obj(), lock, colorizer, TextPos(1000, 3), TextPos(1000, 3), L"abc");
+	TEST_ASSERT(colorizer.WaitUntilColorized());
+	TEST_ASSERT(0 < colorizer.colorizedLines && colorizer.colorizedLines <= GuiTextBoxColorizerBase::ColorizeLineBatchSize);
+	TEST_ASSERT(MatchesReference(lines));
+
+	// an unclosed comment colorizes lines until the state is the same as before
+	colorizer.colorizedLines = 0;
+	Modify(element.Obj(), lock, colorizer, TextPos(1001, 0), TextPos(1001, 0), L"/*");
+	TEST_ASSERT(colorizer.WaitUntilColorized());
+	TEST_ASSERT(colorizer.colorizedLines >= 15);
+	TEST_ASSERT(MatchesReference(lines));
+
+	// edits are made while the colorizer is running
+	TestRandom random;
+	const wchar_t* inputs[] = { L"x", L"/*", L"*/", L"\r\n", L"a\r\n/* b\r\nc */ d", L"" };
+	for (vint step = 0; step < 50; step++)
+	{
+		for (vint i = 0; i < 1 + random.Next(3); i++)
+		{
+			// lines are also read by the colorizer, the lock is required even when only reading them
+			TextPos start, end;
+			SPIN_LOCK(lock)
+			{
+				vint row = random.Next(lines.GetCount());
+				start = TextPos(row, random.Next(lines.GetLine(row).dataLength + 1));
+				end = start;
+				if (random.Next(2) == 0)
+				{
+					end.row = start.row + random.Next(3);
+					if (end.row >= lines.GetCount()) end.row = lines.GetCount() - 1;
+					end.column = end.row == start.row ? lines.GetLine(end.row).dataLength : random.Next(lines.GetLine(end.row).dataLength + 1);
+				}
+			}
+			Modify(element.Obj(), lock, colorizer, start, end, inputs[random.Next(sizeof(inputs) / sizeof(*inputs))]);
+		}
+		TEST_ASSERT(colorizer.WaitUntilColorized());
+		TEST_ASSERT(MatchesReference(lines));
+	}
+
+	colorizer.Detach();
+}
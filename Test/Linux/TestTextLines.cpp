@@ -0,0 +1,267 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::elements::text;
+
+namespace test_text_lines
+{
+	// TextLines stores 256 to 512 lines in each block, edits near these rows cross block boundaries
+	const vint LinesPerBlock = 256;
+
+	class TestCharMeasurer : public CharMeasurer
+	{
+	protected:
+		bool							fixedWidth;
+
+		vint MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)override
+		{
+			return fixedWidth ? 3 : 1 + character % 7;
+		}
+
+		vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)override
+		{
+			return 10;
+		}
+	public:
+		TestCharMeasurer(bool _fixedWidth)
+			:CharMeasurer(10)
+			, fixedWidth(_fixedWidth)
+		{
+		}
+	};
+
+	WString CreateLine(TestRandom& random, bool withTabs)
+	{
+		const wchar_t* chars = withTabs ? L"abc XYZ\t" : L"abc XYZ";
+		vint charCount = withTabs ? 8 : 7;
+		vint length = random.Next(40);
+		Array<wchar_t> buffer(length + 1);
+		for (vint i = 0; i < length; i++)
+		{
+			buffer[i] = chars[random.Next(charCount)];
+		}
+		buffer[length] = 0;
+		return &buffer[0];
+	}
+
+	WString JoinLines(List<WString>& lines)
+	{
+		WString text;
+		for (vint i = 0; i < lines.Count(); i++)
+		{
+			if (i > 0) text += L"\r\n";
+			text += lines[i];
+		}
+		return text;
+	}
+
+	// replaces characters in a flat list of lines, as TextLines did before storing lines in blocks
+	TextPos ReferenceModify(List<WString>& lines, TextPos start, TextPos end, List<WString>& inputs)
+	{
+		WString prefix = lines[start.row].Left(start.column);
+		WString suffix = lines[end.row].Right(lines[end.row].Length() - end.column);
+		lines.RemoveRange(start.row, end.row - start.row + 1);
+		for (vint i = 0; i < inputs.Count(); i++)
+		{
+			WString line = inputs[i];
+			if (i == 0) line = prefix + line;
+			if (i == inputs.Count() - 1) line += suffix;
+			lines.Insert(start.row + i, line);
+		}
+		vint lastRow = inputs.Count() - 1;
+		return TextPos(start.row + lastRow, (lastRow == 0 ? start.column : 0) + inputs[lastRow].Length());
+	}
+
+	TextPos RandomPos(TestRandom& random, List<WString>& lines, vint row)
+	{
+		if (row < 0) row = 0;
+		if (row >= lines.Count()) row = lines.Count() - 1;
+		return TextPos(row, random.Next(lines[row].Length() + 1));
+	}
+
+	bool MatchesReference(TextLines& textLines, List<WString>& lines)
+	{
+		if (textLines.GetCount() != lines.Count()) return false;
+		for (vint i = 0; i < lines.Count(); i++)
+		{
+			TextLine& line = textLines.GetLine(i);
+			if (WString(line.text, line.dataLength) != lines[i]) return false;
+		}
+		return true;
+	}
+
+	// GetMaxWidth before width caches: measure every row and take the widest
+	vint ReferenceMaxWidth(TextLines& textLines)
+	{
+		vint width = 0;
+		for (vint i = 0; i < textLines.GetCount(); i++)
+		{
+			vint rowWidth = textLines.GetRowWidth(i);
+			if (width < rowWidth) width = rowWidth;
+		}
+		return width;
+	}
+
+	void RandomEdit(TestRandom& random, TextLines& textLines, List<WString>& lines, bool withTabs)
+	{
+		TextPos start, end;
+		vint inputCount = 1 + random.Next(4);
+		switch (random.Next(5))
+		{
+		case 0:
+			// edit characters in a line
+			start = RandomPos(random, lines, random.Next(lines.Count()));
+			end = RandomPos(random, lines, start.row);
+			inputCount = 1;
+			break;
+		case 1:
+			// replace a random range
+			start = RandomPos(random, lines, random.Next(lines.Count()));
+			end = RandomPos(random, lines, start.row + random.Next(20));
+			break;
+		case 2:
+			// insert more lines than a block could hold
+			start = RandomPos(random, lines, random.Next(lines.Count()));
+			end = start;
+			inputCount = LinesPerBlock + random.Next(LinesPerBlock * 2);
+			break;
+		case 3:
+			// remove more lines than a block holds
+			start = RandomPos(random, lines, random.Next(lines.Count()));
+			end = RandomPos(random, lines, start.row + LinesPerBlock / 2 + random.Next(LinesPerBlock * 2));
+			break;
+		case 4:
+			// replace a range across a block boundary
+			{
+				vint boundary = LinesPerBlock * (1 + random.Next(lines.Count() / LinesPerBlock + 1));
+				start = RandomPos(random, lines, boundary - 1 - random.Next(2));
+				end = RandomPos(random, lines, boundary + random.Next(2));
+			}
+			break;
+		}
+		if (end < start)
+		{
+			TextPos pos = start;
+			start = end;
+			end = pos;
+		}
+
+		List<WString> inputs;
+		for (vint i = 0; i < inputCount; i++)
+		{
+			inputs.Add(CreateLine(random, withTabs));
+		}
+		TextPos expected = ReferenceModify(lines, start, end, inputs);
+		TEST_ASSERT(textLines.Modify(start, end, JoinLines(inputs)) == expected);
+	}
+}
+using namespace test_text_lines;
+
+TEST_CASE(TestTextLinesModify)
+{
+	TestRandom random;
+	List<WString> lines;
+	for (vint i = 0; i < LinesPerBlock * 5 + 17; i++)
+	{
+		lines.Add(CreateLine(random, true));
+	}
+
+	TextLines textLines;
+	textLines.SetText(JoinLines(lines));
+	TEST_ASSERT(MatchesReference(textLines, lines));
+
+	for (vint step = 0; step < 300; step++)
+	{
+		RandomEdit(random, textLines, lines, true);
+		TEST_ASSERT(MatchesReference(textLines, lines));
+
+		if (step % 10 == 0 && lines.Count() > 2)
+		{
+			// remove lines, keeping at least one line
+			vint start = random.Next(lines.Count() - 1);
+			vint count = 1 + random.Next(lines.Count() - start - 1);
+			TEST_ASSERT(textLines.RemoveLines(start, count));
+			lines.RemoveRange(start, count);
+			TEST_ASSERT(MatchesReference(textLines, lines));
+		}
+	}
+	TEST_ASSERT(textLines.GetText() == JoinLines(lines));
+
+	textLines.Clear();
+	lines.Clear();
+	lines.Add(L"");
+	TEST_ASSERT(MatchesReference(textLines, lines));
+}
+
+TEST_CASE(TestTextLinesMaxWidth)
+{
+	TestRandom random;
+	{
+		// widths of measured rows are the same as measuring all rows
+		TestCharMeasurer measurer(false);
+		TextLines textLines;
+		textLines.SetCharMeasurer(&measurer);
+		List<WString> lines;
+		for (vint i = 0; i < LinesPerBlock * 3; i++)
+		{
+			lines.Add(CreateLine(random, true));
+		}
+		textLines.SetText(JoinLines(lines));
+
+		for (vint step = 0; step < 100; step++)
+		{
+			RandomEdit(random, textLines, lines, true);
+			if (step % 5 == 0)
+			{
+				textLines.SetTabSpaceCount(1 + random.Next(8));
+			}
+			vint expected = ReferenceMaxWidth(textLines);
+			TEST_ASSERT(textLines.GetMaxWidth() == expected);
+		}
+		TEST_ASSERT(MatchesReference(textLines, lines));
+	}
+	{
+		// when all characters have the same width, estimated widths of rows that are not measured are accurate
+		TestCharMeasurer measurer(true);
+		TextLines textLines;
+		textLines.SetCharMeasurer(&measurer);
+		List<WString> lines;
+		for (vint i = 0; i < LinesPerBlock * 3; i++)
+		{
+			lines.Add(CreateLine(random, false));
+		}
+		textLines.SetText(JoinLines(lines));
+
+		for (vint step = 0; step < 100; step++)
+		{
+			RandomEdit(random, textLines, lines, false);
+			if (step % 2 == 0)
+			{
+				textLines.ClearMeasurement();
+			}
+			for (vint i = 0; i < 20; i++)
+			{
+				textLines.MeasureRow(random.Next(textLines.GetCount()));
+			}
+
+			// GetMaxWidth does not measure rows
+			vint measuredRows = 0;
+			for (vint i = 0; i < textLines.GetCount(); i++)
+			{
+				TextLine& line = textLines.GetLine(i);
+				if (line.availableOffsetCount == line.dataLength) measuredRows++;
+			}
+			vint width = textLines.GetMaxWidth();
+			for (vint i = 0; i < textLines.GetCount(); i++)
+			{
+				TextLine& line = textLines.GetLine(i);
+				if (line.availableOffsetCount == line.dataLength) measuredRows--;
+			}
+			TEST_ASSERT(measuredRows == 0);
+			TEST_ASSERT(width == ReferenceMaxWidth(textLines));
+		}
+	}
+}
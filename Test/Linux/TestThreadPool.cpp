@@ -0,0 +1,123 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+
+namespace test_thread_pool
+{
+	bool WaitUntil(const Func<bool()>& condition)
+	{
+		for (vint i = 0; i < 5000; i++)
+		{
+			if (condition()) return true;
+			Thread::Sleep(1);
+		}
+		return false;
+	}
+
+	// stop the pool created by other tests, so that the number of workers could be changed
+	void ResetThreadPool(vint workerCount)
+	{
+		ThreadPoolLite::Stop(false);
+		TEST_ASSERT(ThreadPoolLite::SetWorkerCount(workerCount));
+	}
+}
+using namespace test_thread_pool;
+
+TEST_CASE(TestThreadPoolWorkStealing)
+{
+	ResetThreadPool(2);
+	volatile vint executed = 0;
+	volatile bool stolen = false;
+	EventObject finished;
+	finished.CreateManualUnsignal(false);
+
+	ThreadPoolLite::Queue([&]()
+	{
+		// tasks queued by a worker go to its own queue, they could only be executed by the other worker while this one is waiting
+		for (vint i = 0; i < 10; i++)
+		{
+			ThreadPoolLite::Queue([&]()
+			{
+				INCRC(&executed);
+			});
+		}
+		stolen = WaitUntil([&]() { return executed == 10; });
+		finished.Signal();
+	});
+
+	// the number of workers is fixed after the first task is queued
+	TEST_ASSERT(!ThreadPoolLite::SetWorkerCount(4));
+	finished.Wait();
+	TEST_ASSERT(stolen);
+	TEST_ASSERT(executed == 10);
+
+	TEST_ASSERT(ThreadPoolLite::Stop(false));
+	TEST_ASSERT(!ThreadPoolLite::Stop(false));
+	TEST_ASSERT(ThreadPoolLite::SetWorkerCount(0));
+}
+
+TEST_CASE(TestThreadPoolStop)
+{
+	const vint count = 100;
+	{
+		// all accepted tasks are executed before Stop returns
+		ResetThreadPool(2);
+		volatile vint executed = 0;
+		vint accepted = 0;
+		for (vint i = 0; i < count; i++)
+		{
+			if (ThreadPoolLite::Queue([&]()
+			{
+				Thread::Sleep(1);
+				INCRC(&executed);
+			}))
+			{
+				accepted++;
+			}
+		}
+		TEST_ASSERT(accepted == count);
+		TEST_ASSERT(ThreadPoolLite::Stop(false));
+		TEST_ASSERT(executed == count);
+	}
+	{
+		// pending tasks are discarded, tasks being executed are finished
+		ResetThreadPool(2);
+		volatile vint executed = 0;
+		volatile vint blocked = 0;
+		EventObject gate;
+		gate.CreateManualUnsignal(false);
+		for (vint i = 0; i < 2; i++)
+		{
+			ThreadPoolLite::Queue([&]()
+			{
+				INCRC(&blocked);
+				gate.Wait();
+			});
+		}
+		TEST_ASSERT(WaitUntil([&]() { return blocked == 2; }));
+		for (vint i = 0; i < count; i++)
+		{
+			TEST_ASSERT(ThreadPoolLite::Queue([&]()
+			{
+				INCRC(&executed);
+			}));
+		}
+
+		volatile bool stopped = false;
+		auto thread = Thread::CreateAndStart([&]()
+		{
+			stopped = ThreadPoolLite::Stop(true);
+		}, false);
+
+		// once a task is rejected, the pool is stopping and pending tasks are being discarded
+		TEST_ASSERT(WaitUntil([&]() { return !ThreadPoolLite::Queue([]() {}); }));
+		Thread::Sleep(50);
+		gate.Signal();
+		thread->Wait();
+		delete thread;
+
+		TEST_ASSERT(stopped);
+		TEST_ASSERT(executed == 0);
+	}
+	TEST_ASSERT(ThreadPoolLite::SetWorkerCount(0));
+}
@@ -0,0 +1,156 @@
+#include "TestBenchmark.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::tree;
+
+namespace test_tree_view_nodes
+{
+	// visible nodes in the order of a depth first search, which is how NodeItemProvider counted them before prefix sums
+	void CollectVisibleNodes(MemoryNodeProvider* node, List<MemoryNodeProvider*>& visibleNodes)
+	{
+		for (vint i = 0; i < node->Children().Count(); i++)
+		{
+			auto child = node->Children()[i].Obj();
+			visibleNodes.Add(child);
+			if (child->GetExpanding())
+			{
+				CollectVisibleNodes(child, visibleNodes);
+			}
+		}
+	}
+
+	void CollectAllNodes(MemoryNodeProvider* node, List<MemoryNodeProvider*>& nodes)
+	{
+		for (vint i = 0; i < node->Children().Count(); i++)
+		{
+			auto child = node->Children()[i].Obj();
+			nodes.Add(child);
+			CollectAllNodes(child, nodes);
+		}
+	}
+
+	bool MatchesReference(MemoryNodeRootProvider* root, NodeItemProvider* itemProvider, INodeItemView* view)
+	{
+		List<MemoryNodeProvider*> visibleNodes, allNodes;
+		CollectVisibleNodes(root, visibleNodes);
+		CollectAllNodes(root, allNodes);
+		if (itemProvider->Count() != visibleNodes.Count()) return false;
+
+		// RequestNode and CalculateNodeVisibilityIndex are inverses for visible nodes
+		for (vint i = 0; i < visibleNodes.Count(); i++)
+		{
+			auto node = view->RequestNode(i);
+			bool same = node == visibleNodes[i];
+			view->ReleaseNode(node);
+			if (!same) return false;
+			if (view->CalculateNodeVisibilityIndex(visibleNodes[i]) != i) return false;
+		}
+		if (view->RequestNode(visibleNodes.Count()) != nullptr) return false;
+
+		// nodes in collapsed nodes are not visible
+		FOREACH(MemoryNodeProvider*, node, allNodes)
+		{
+			if (!visibleNodes.Contains(node) && view->CalculateNodeVisibilityIndex(node) != -1) return false;
+		}
+		return true;
+	}
+}
+using namespace test_tree_view_nodes;
+
+TEST_CASE(TestNodeVisibleCountTree)
+{
+	TestRandom random;
+	for (vint count = 0; count <= 40; count++)
+	{
+		Array<vint> counts(count);
+		for (vint i = 0; i < count; i++)
+		{
+			counts[i] = 1 + random.Next(5);
+		}
+
+		NodeVisibleCountTree tree;
+		tree.Rebuild(count, [&](vint index) { return counts[index]; });
+		for (vint step = 0; step <= count; step++)
+		{
+			if (step > 0)
+			{
+				// a node is expanded or collapsed, but it is always visible
+				vint index = random.Next(count);
+				vint offset = random.Next(7) - counts[index] + 1;
+				counts[index] += offset;
+				tree.Add(index, offset);
+			}
+
+			vint total = 0;
+			for (vint i = 0; i < count; i++)
+			{
+				TEST_ASSERT(tree.GetVisibleNodesBefore(i) == total);
+				for (vint j = 0; j < counts[i]; j++)
+				{
+					vint offset = total + j;
+					TEST_ASSERT(tree.FindByVisibleOffset(offset) == i);
+					TEST_ASSERT(offset == j);
+				}
+				total += counts[i];
+			}
+			TEST_ASSERT(tree.GetTotalVisibleNodes() == total);
+		}
+	}
+}
+
+TEST_CASE(TestTreeViewVisibleIndex)
+{
+	TestRandom random;
+	auto root = MakePtr<MemoryNodeRootProvider>();
+	auto itemProvider = MakePtr<NodeItemProvider>(root);
+	auto view = dynamic_cast<INodeItemView*>(itemProvider->RequestView(INodeItemView::Identifier));
+	TEST_ASSERT(view);
+	TEST_ASSERT(MatchesReference(root.Obj(), itemProvider.Obj(), view));
+
+	List<MemoryNodeProvider*> nodes;
+	nodes.Add(root.Obj());
+	for (vint step = 0; step < 300; step++)
+	{
+		auto node = nodes[random.Next(nodes.Count())];
+		switch (random.Next(nodes.Count() < 50 ? 2 : 4))
+		{
+		case 0:
+		case 1:
+			{
+				// add a child at a random position
+				auto child = MakePtr<MemoryNodeProvider>();
+				child->SetExpanding(random.Next(2) == 0);
+				node->Children().Insert(random.Next(node->Children().Count() + 1), child);
+				nodes.Add(child.Obj());
+			}
+			break;
+		case 2:
+			// expand or collapse a node, including nodes inside collapsed nodes
+			if (node != root.Obj())
+			{
+				node->SetExpanding(!node->GetExpanding());
+			}
+			break;
+		case 3:
+			// remove a child with all its descendants
+			if (node->Children().Count() > 0)
+			{
+				vint index = random.Next(node->Children().Count());
+				List<MemoryNodeProvider*> removed;
+				removed.Add(node->Children()[index].Obj());
+				CollectAllNodes(removed[0], removed);
+				FOREACH(MemoryNodeProvider*, removedNode, removed)
+				{
+					nodes.Remove(removedNode);
+				}
+				node->Children().RemoveAt(index);
+			}
+			break;
+		}
+		TEST_ASSERT(MatchesReference(root.Obj(), itemProvider.Obj(), view));
+	}
+	itemProvider->ReleaseView(view);
+}
@@ -0,0 +1,180 @@
+#include "TestBenchmark.h"
+#include <math.h>
+#include <string.h>
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+
+namespace test_value
+{
+	template<typename T>
+	WString Serialize(const T& value)
+	{
+		WString text;
+		TEST_ASSERT(TypedValueSerializerProvider<T>::Serialize(value, text));
+		return text;
+	}
+
+	// bool is serialized by BoolValueSerializer, which uses these names
+	template<>
+	WString Serialize<bool>(const bool& value)
+	{
+		return value ? L"true" : L"false";
+	}
+
+	template<typename T>
+	void TestPrimitive(const T& value)
+	{
+		// the text is created from the primitive storage, it should be the same as the serializer creates
+		WString text = Serialize(value);
+		Value boxed = BoxValue<T>(value);
+		TEST_ASSERT(boxed.GetValueType() == Value::Text);
+		TEST_ASSERT(boxed.GetText() == text);
+
+		// compared by bits, so that NaN and -0.0 are also checked
+		T unboxed = UnboxValue<T>(boxed);
+		TEST_ASSERT(memcmp(&unboxed, &value, sizeof(T)) == 0);
+
+		// copies keep the text if it is created, otherwise create it again
+		Value copied = boxed;
+		TEST_ASSERT(copied.GetText() == text);
+		Value assigned;
+		assigned = boxed;
+		TEST_ASSERT(assigned.GetText() == text);
+		assigned = assigned;
+		TEST_ASSERT(assigned.GetText() == text);
+
+		Value fresh = BoxValue<T>(value);
+		Value freshCopied = fresh;
+		TEST_ASSERT(freshCopied.GetText() == text);
+		TEST_ASSERT(fresh.GetText() == text);
+		TEST_ASSERT(memcmp(&unboxed, &value, sizeof(T)) == 0);
+	}
+
+	vint Sign(vint value)
+	{
+		return value < 0 ? -1 : value > 0 ? 1 : 0;
+	}
+
+	vint Sign(const Value& a, const Value& b)
+	{
+		return a < b ? -1 : a > b ? 1 : 0;
+	}
+}
+using namespace test_value;
+
+TEST_CASE(TestValuePrimitives)
+{
+	const vint64_t int64Max = 9223372036854775807LL;
+	const vint64_t int64Min = -int64Max - 1;
+	const vuint64_t uint64Max = 18446744073709551615ULL;
+
+	TestPrimitive<vint64_t>(0);
+	TestPrimitive<vint64_t>(-1);
+	TestPrimitive<vint64_t>(int64Max);
+	TestPrimitive<vint64_t>(int64Min);
+	TestPrimitive<vuint64_t>(0);
+	TestPrimitive<vuint64_t>(uint64Max);
+	TestPrimitive<vuint64_t>((vuint64_t)int64Max + 1);
+	TestPrimitive<vint32_t>(-2147483647 - 1);
+	TestPrimitive<vuint32_t>(4294967295U);
+	TestPrimitive<vint8_t>(-128);
+	TestPrimitive<vuint8_t>(255);
+	TestPrimitive<vint16_t>(-32768);
+	TestPrimitive<vuint16_t>(65535);
+
+	TestPrimitive<double>(0.0);
+	TestPrimitive<double>(-0.0);
+	TestPrimitive<double>(NAN);
+	TestPrimitive<double>(INFINITY);
+	TestPrimitive<double>(-INFINITY);
+	TestPrimitive<double>(1.5);
+	TestPrimitive<double>(-123456.789);
+	TestPrimitive<double>(1e300);
+	TestPrimitive<double>(5e-324);
+	TestPrimitive<float>(0.1f);
+	TestPrimitive<float>(-0.0f);
+	TestPrimitive<float>(3.4e38f);
+
+	TestPrimitive<bool>(true);
+	TestPrimitive<bool>(false);
+
+	TEST_ASSERT(UnboxValue<double>(BoxValue<double>(NAN)) != UnboxValue<double>(BoxValue<double>(NAN)));
+	TEST_ASSERT(signbit(UnboxValue<double>(BoxValue<double>(-0.0))));
+}
+
+TEST_CASE(TestValueCompare)
+{
+	// Compare orders text values by their texts, as it did when primitive values were stored as texts
+	List<Value> values;
+	values.Add(BoxValue<vint64_t>(0));
+	values.Add(BoxValue<vint64_t>(-1));
+	values.Add(BoxValue<vint64_t>(10));
+	values.Add(BoxValue<vint64_t>(9));
+	values.Add(BoxValue<vint64_t>(9223372036854775807LL));
+	values.Add(BoxValue<vuint64_t>(0));
+	values.Add(BoxValue<vuint64_t>(18446744073709551615ULL));
+	values.Add(BoxValue<vint32_t>(10));
+	values.Add(BoxValue<double>(0.0));
+	values.Add(BoxValue<double>(-0.0));
+	values.Add(BoxValue<double>(NAN));
+	values.Add(BoxValue<double>(NAN));
+	values.Add(BoxValue<double>(10.0));
+	values.Add(BoxValue<double>(2.5));
+	values.Add(BoxValue<bool>(true));
+	values.Add(BoxValue<bool>(false));
+	values.Add(BoxValue<WString>(L"10"));
+	values.Add(BoxValue<WString>(L"true"));
+	values.Add(BoxValue<WString>(L"abc"));
+
+	for (vint i = 0; i < values.Count(); i++)
+	{
+		for (vint j = 0; j < values.Count(); j++)
+		{
+			// compare texts from copies, so that Compare also runs on values whose texts are not created
+			Value a = BoxValue<vint>(0);
+			Value b = a;
+			a = values[i];
+			b = values[j];
+			vint expected = Sign(WString::Compare(Value(values[i]).GetText(), Value(values[j]).GetText()));
+			TEST_ASSERT(Sign(a, b) == expected);
+			TEST_ASSERT((a == b) == (expected == 0));
+			TEST_ASSERT((a != b) == (expected != 0));
+		}
+	}
+}
+
+TEST_CASE(TestValueGetTextFromThreads)
+{
+	const vint count = 10000;
+	const vint threadCount = 4;
+	Array<Value> values(count);
+	for (vint i = 0; i < count; i++)
+	{
+		values[i] = BoxValue<vint64_t>(i * 7919 - count);
+	}
+
+	// all threads read texts of the same values at the same time
+	volatile vint errors = 0;
+	List<Thread*> threads;
+	for (vint i = 0; i < threadCount; i++)
+	{
+		threads.Add(Thread::CreateAndStart([&]()
+		{
+			for (vint j = 0; j < count; j++)
+			{
+				if (values[j].GetText() != i64tow(j * 7919 - count))
+				{
+					INCRC(&errors);
+				}
+			}
+		}, false));
+	}
+	FOREACH(Thread*, thread, threads)
+	{
+		thread->Wait();
+		delete thread;
+	}
+	TEST_ASSERT(errors == 0);
+}
@@ -0,0 +1,325 @@
+#include "TestBenchmark.h"
+#include "../../Import/VlppWorkflowCompiler.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::parsing;
+using namespace vl::stream;
+using namespace vl::filesystem;
+using namespace vl::reflection::description;
+using namespace vl::workflow;
+using namespace vl::workflow::analyzer;
+using namespace vl::workflow::runtime;
+
+// defined in TestWorkflowScriptsNative.cpp, which is generated from NativeScript
+extern void RegisterTestWorkflowScriptsNative();
+extern void UnregisterTestWorkflowScriptsNative();
+
+namespace test_workflow_scripts
+{
+	// the same shape of code that GacUI generates for bindings and event handlers:
+	// properties with change events, attached lambdas, and conditions on property values
+	const wchar_t* BenchmarkScript = LR"Workflow(
+module bench;
+using system::*;
+
+class ViewModel
+{
+	var x : int = 0;
+	var y : int = 0;
+	var text : int = 0;
+
+	new(){}
+
+	func GetX() : int { return x; }
+	func SetX(value : int) : void { if (x != value) { x = value; ZChanged(); } }
+	func GetY() : int { return y; }
+	func SetY(value : int) : void { if (y != value) { y = value; ZChanged(); } }
+	func GetZ() : int { return x + y; }
+
+	event ZChanged();
+	prop X : int {GetX, SetX}
+	prop Y : int {GetY, SetY}
+	prop Z : int {GetZ : ZChanged}
+}
+
+func Run(count : int) : int
+{
+	var vm = new ViewModel^();
+	var handler = attach(vm.ZChanged, func() : void
+	{
+		if (vm.Z > 100)
+		{
+			vm.text = vm.text + vm.Z - 100;
+		}
+		else
+		{
+			vm.text = vm.text + vm.Z;
+		}
+	});
+	for (i in range [1, count])
+	{
+		vm.X = i % 7;
+		vm.Y = vm.X * 2 + i % 3;
+		if (vm.Z >= vm.Y and vm.X <= 5)
+		{
+			vm.text = vm.text + 1;
+		}
+	}
+	detach(handler);
+	return vm.text;
+}
+)Workflow";
+
+	vint RunInCpp(vint count)
+	{
+		vint x = 0, y = 0, text = 0;
+		auto changed = [&]()
+		{
+			vint z = x + y;
+			text += z > 100 ? z - 100 : z;
+		};
+		for (vint i = 1; i <= count; i++)
+		{
+			vint newX = i % 7;
+			if (x != newX) { x = newX; changed(); }
+			vint newY = x * 2 + i % 3;
+			if (y != newY) { y = newY; changed(); }
+			if (x + y >= y && x <= 5) text++;
+		}
+		return text;
+	}
+
+	Ptr<WfAssembly> CompileScript(const WString& code)
+	{
+		List<WString> codes;
+		codes.Add(code);
+		List<Ptr<ParsingError>> errors;
+		auto assembly = Compile(WfLoadTable(), codes, errors);
+		FOREACH(Ptr<ParsingError>, error, errors)
+		{
+			TEST_PRINT(error->errorMessage);
+		}
+		TEST_ASSERT(assembly);
+		return assembly;
+	}
+
+	Ptr<WfAssembly> CompileBenchmarkScript()
+	{
+		return CompileScript(BenchmarkScript);
+	}
+
+	// script functions calling each other, C++ static methods, methods and properties of C++ objects,
+	// and members that are registered with lambda expressions, which could only be called through reflection
+	const wchar_t* NativeScript = LR"Workflow(
+module native;
+using system::*;
+using parsing::*;
+
+func Fib(n : int) : int
+{
+	if (n < 2)
+	{
+		return n;
+	}
+	return Fib(n - 1) + Fib(n - 2);
+}
+
+func Collect(count : int) : int[]
+{
+	var items : int[] = {};
+	for (i in range [1, count])
+	{
+		items.Add(Math::CeilI(i % 5 * 0.5) * Fib(i % 10));
+	}
+	return items;
+}
+
+func Sum(count : int) : int
+{
+	var items = Collect(count);
+	var sum = 0;
+	for (i in range [0, items.Count - 1])
+	{
+		sum = sum + items[i];
+	}
+	return sum;
+}
+
+func Tokens(count : int) : string
+{
+	var tokens : ParsingTreeToken^[] = {};
+	for (i in range [1, count])
+	{
+		var token = new ParsingTreeToken^(Sys::Left("abcdefgh", i % 8), i);
+		token.TokenIndex = token.TokenIndex * 2;
+		token.Value = token.Value & "!";
+		tokens.Add(token);
+	}
+
+	var text = "";
+	for (i in range [0, tokens.Count - 1])
+	{
+		var token = tokens[i];
+		text = text & token.Value & token.TokenIndex & ";";
+	}
+
+	var xml = new XmlText^();
+	xml.content = text;
+	return xml.content & Sys::Len(text);
+}
+)Workflow";
+
+	// the same script with one more function, which has a different checksum
+	WString GetModifiedNativeScript()
+	{
+		return WString(NativeScript) + L"func Unused() : int { return 0; }";
+	}
+
+	WString RemoveCarriageReturns(const WString& text)
+	{
+		WString result;
+		vint start = 0;
+		for (vint i = 0; i <= text.Length(); i++)
+		{
+			if (i == text.Length() || text[i] == L'\r')
+			{
+				result += text.Sub(start, i - start);
+				start = i + 1;
+			}
+		}
+		return result;
+	}
+
+	WString GenerateNativeScript(Ptr<WfAssembly> assembly)
+	{
+		MemoryStream stream;
+		{
+			StreamWriter writer(stream);
+			GenerateCppFile(assembly, L"TestWorkflowScriptsNative", L"../../Import/VlppWorkflow.h", writer);
+		}
+		stream.SeekFromBegin(0);
+		StreamReader reader(stream);
+		return RemoveCarriageReturns(reader.ReadToEnd());
+	}
+
+	FilePath GetNativeScriptPath()
+	{
+		return FilePath(atow(__FILE__)).GetFolder() / L"TestWorkflowScriptsNative.cpp";
+	}
+
+	bool HasNativeFunction(Ptr<WfRuntimeGlobalContext> globalContext, const WString& name)
+	{
+		vint index = globalContext->assembly->functionByName[name][0];
+		return globalContext->nativeFunctions[index] != nullptr;
+	}
+
+	void RunNativeScript(Ptr<WfRuntimeGlobalContext> globalContext, List<WString>& results)
+	{
+		LoadFunction<void()>(globalContext, L"<initialize>")();
+		auto sum = LoadFunction<vint(vint)>(globalContext, L"Sum");
+		auto tokens = LoadFunction<WString(vint)>(globalContext, L"Tokens");
+		for (vint count = 0; count <= 20; count += 5)
+		{
+			results.Add(itow(sum(count)));
+			results.Add(tokens(count));
+		}
+	}
+
+	bool SameResults(List<WString>& expected, List<WString>& actual)
+	{
+		if (expected.Count() != actual.Count()) return false;
+		for (vint i = 0; i < expected.Count(); i++)
+		{
+			if (expected[i] != actual[i]) return false;
+		}
+		return true;
+	}
+}
+using namespace test_workflow_scripts;
+
+TEST_CASE(TestWorkflowScripts)
+{
+	auto globalContext = MakePtr<WfRuntimeGlobalContext>(CompileBenchmarkScript());
+	LoadFunction<void()>(globalContext, L"<initialize>")();
+	auto run = LoadFunction<vint(vint)>(globalContext, L"Run");
+	for (vint count = 0; count <= 100; count += 25)
+	{
+		TEST_ASSERT(run(count) == RunInCpp(count));
+	}
+}
+
+TEST_CASE(TestWorkflowScriptsNative)
+{
+	auto assembly = CompileScript(NativeScript);
+
+	// the checked in file is generated from the same script by the current compiler
+	WString code = GenerateNativeScript(assembly);
+	WString checkedIn;
+	TEST_ASSERT(File(GetNativeScriptPath()).ReadAllText(checkedIn));
+	TEST_ASSERT(RemoveCarriageReturns(checkedIn) == code);
+
+	// C++ members are called directly, members registered with lambda expressions are called through reflection
+	TEST_ASSERT(INVLOC.FindFirst(code, L"Math::CeilI(UnboxValue<", Locale::None).key != -1);
+	TEST_ASSERT(INVLOC.FindFirst(code, L"GetThis<vl::parsing::ParsingTreeToken>", Locale::None).key != -1);
+	TEST_ASSERT(INVLOC.FindFirst(code, L"GetThis<vl::reflection::description::IValueList>", Locale::None).key != -1);
+	TEST_ASSERT(INVLOC.FindFirst(code, L"WfRuntimeNativeHelper::InvokeMethod(", Locale::None).key != -1);
+
+	List<WString> interpreted, native;
+	{
+		auto globalContext = MakePtr<WfRuntimeGlobalContext>(assembly);
+		TEST_ASSERT(!HasNativeFunction(globalContext, L"Sum"));
+		RunNativeScript(globalContext, interpreted);
+	}
+	TEST_ASSERT(interpreted[0] == L"0");
+	TEST_ASSERT(interpreted[1] == L"0");
+
+	RegisterTestWorkflowScriptsNative();
+	{
+		auto globalContext = MakePtr<WfRuntimeGlobalContext>(assembly);
+		TEST_ASSERT(HasNativeFunction(globalContext, L"Fib"));
+		TEST_ASSERT(HasNativeFunction(globalContext, L"Sum"));
+		TEST_ASSERT(HasNativeFunction(globalContext, L"Tokens"));
+		RunNativeScript(globalContext, native);
+	}
+	TEST_ASSERT(SameResults(interpreted, native));
+
+	// the native module is not used when the checksum does not match
+	{
+		auto modified = CompileScript(GetModifiedNativeScript());
+		TEST_ASSERT(GetAssemblyChecksum(modified.Obj()) != GetAssemblyChecksum(assembly.Obj()));
+		auto globalContext = MakePtr<WfRuntimeGlobalContext>(modified);
+		TEST_ASSERT(!HasNativeFunction(globalContext, L"Fib"));
+		TEST_ASSERT(!HasNativeFunction(globalContext, L"Sum"));
+		TEST_ASSERT(!HasNativeFunction(globalContext, L"Tokens"));
+		List<WString> fallback;
+		RunNativeScript(globalContext, fallback);
+		TEST_ASSERT(SameResults(interpreted, fallback));
+	}
+	UnregisterTestWorkflowScriptsNative();
+}
+
+BENCHMARK_CASE(BenchmarkWorkflowScripts)
+{
+	const vint count = 10000;
+	Ptr<WfAssembly> assembly;
+	double compile = BenchmarkMilliseconds([&]()
+	{
+		assembly = CompileBenchmarkScript();
+	});
+
+	auto globalContext = MakePtr<WfRuntimeGlobalContext>(assembly);
+	LoadFunction<void()>(globalContext, L"<initialize>")();
+	auto run = LoadFunction<vint(vint)>(globalContext, L"Run");
+
+	vint result = 0;
+	double execute = BenchmarkMilliseconds([&]()
+	{
+		result = run(count);
+	});
+	TEST_ASSERT(result == RunInCpp(count));
+
+	TEST_PRINT(L"Workflow property bindings and event handlers:");
+	TEST_PRINT(L"    Compile: " + FormatBenchmarkNumber(compile) + L"ms");
+	TEST_PRINT(L"    Run " + itow(count) + L" iterations: " + FormatBenchmarkNumber(execute) + L"ms");
+}
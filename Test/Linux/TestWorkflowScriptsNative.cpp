@@ -0,0 +1,499 @@
+/***********************************************************************
+!!!!!! DO NOT MODIFY !!!!!!
+
+This file is generated by Workflow compiler
+Call RegisterTestWorkflowScriptsNative() to execute the assembly with native functions
+***********************************************************************/
+
+#include "../../Import/VlppWorkflow.h"
+#include <math.h>
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::workflow::runtime;
+
+namespace
+{
+	Value Function_0(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments);
+	Value Function_1(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments);
+	Value Function_2(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments);
+	Value Function_3(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments);
+	Value Function_4(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments);
+
+	// Fib
+	Value Function_0(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments)
+	{
+		auto& ins = globalContext->assembly->instructions;
+		Value v0 = arguments[0];
+		Value s0;
+		Value s1;
+		Value s2;
+		s0 = v0;
+		s1 = ins[3].valueParameter;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		s0 = BoxValue<bool>(UnboxValue<vint>(s0) < 0);
+		s0 = BoxValue<bool>((bool)(!UnboxValue<bool>(s0)));
+		if (UnboxValue<bool>(s0)) { s0 = Value(); goto L11; }
+		s0 = Value();
+		s0 = v0;
+		return s0;
+	L11:;
+		s0 = v0;
+		s1 = ins[12].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) - UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		{
+			Value values[] = { s0 };
+			s0 = Function_0(globalContext, nullptr, values);
+		}
+		s1 = v0;
+		s2 = ins[16].valueParameter;
+		s1 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s1) - UnboxValue<vint64_t>(s2)));
+		s2 = Value();
+		{
+			Value values[] = { s1 };
+			s1 = Function_0(globalContext, nullptr, values);
+		}
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) + UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		return s0;
+	}
+
+	// Collect
+	Value Function_1(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments)
+	{
+		auto& ins = globalContext->assembly->instructions;
+		Value v0 = arguments[0];
+		Value v1;
+		Value v2;
+		Value v3;
+		Value v4;
+		Value s0;
+		Value s1;
+		Value s2;
+		{
+			s0 = WfRuntimeNativeHelper::CreateArray(nullptr, 0);
+		}
+		v1 = s0;
+		s0 = Value();
+		s0 = ins[25].valueParameter;
+		v3 = s0;
+		s0 = Value();
+		s0 = v0;
+		v4 = s0;
+		s0 = Value();
+		s0 = v3;
+		v2 = s0;
+		s0 = Value();
+	L31:;
+		s0 = v2;
+		s1 = v4;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) > 0) { s0 = Value(); goto L62; }
+		s0 = Value();
+		s0 = v2;
+		s1 = ins[37].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) % UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		s0 = WfRuntimeNativeHelper::ConvertToType(s0, ins[39]);
+		s1 = ins[40].valueParameter;
+		s0 = BoxValue<double>((double)(UnboxValue<double>(s0) * UnboxValue<double>(s1)));
+		s1 = Value();
+		s1 = ins[42].valueParameter;
+		{
+			s0 = BoxValue<vl::vint64_t>(Math::CeilI(UnboxValue<double>(s0)));
+		}
+		s1 = Value();
+		s1 = v2;
+		s2 = ins[45].valueParameter;
+		s1 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s1) % UnboxValue<vint64_t>(s2)));
+		s2 = Value();
+		{
+			Value values[] = { s1 };
+			s1 = Function_0(globalContext, nullptr, values);
+		}
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) * UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		s1 = v1;
+		{
+			s0 = BoxValue<vl::vint64_t>(WfRuntimeNativeHelper::GetThis<vl::reflection::description::IValueList>(s1, ins[50].methodParameter)->Add(UnboxValue<vl::reflection::description::Value>(s0)));
+		}
+		s1 = Value();
+		s0 = Value();
+		s0 = v2;
+		s1 = v4;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) == 0) { s0 = Value(); goto L62; }
+		s0 = Value();
+		s0 = v2;
+		s1 = ins[58].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) + UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		v2 = s0;
+		s0 = Value();
+		goto L31;
+	L62:;
+		s0 = ins[62].valueParameter;
+		v2 = s0;
+		s0 = Value();
+		s0 = ins[64].valueParameter;
+		v3 = s0;
+		s0 = Value();
+		s0 = ins[66].valueParameter;
+		v4 = s0;
+		s0 = Value();
+		s0 = v1;
+		return s0;
+	}
+
+	// Sum
+	Value Function_2(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments)
+	{
+		auto& ins = globalContext->assembly->instructions;
+		Value v0 = arguments[0];
+		Value v1;
+		Value v2;
+		Value v3;
+		Value v4;
+		Value v5;
+		Value s0;
+		Value s1;
+		Value s2;
+		s0 = v0;
+		{
+			Value values[] = { s0 };
+			s0 = Function_1(globalContext, nullptr, values);
+		}
+		v1 = s0;
+		s0 = Value();
+		s0 = ins[75].valueParameter;
+		v2 = s0;
+		s0 = Value();
+		s0 = ins[77].valueParameter;
+		v4 = s0;
+		s0 = Value();
+		s0 = v1;
+		{
+			s0 = BoxValue<vl::vint64_t>(WfRuntimeNativeHelper::GetThis<vl::reflection::description::IValueReadonlyList>(s0, ins[80].methodParameter)->GetCount());
+		}
+		s1 = ins[81].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) - UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		v5 = s0;
+		s0 = Value();
+		s0 = v4;
+		v3 = s0;
+		s0 = Value();
+	L86:;
+		s0 = v3;
+		s1 = v5;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) > 0) { s0 = Value(); goto L109; }
+		s0 = Value();
+		s0 = v2;
+		s1 = v3;
+		s2 = v1;
+		{
+			s1 = BoxValue<vl::reflection::description::Value>(WfRuntimeNativeHelper::GetThis<vl::reflection::description::IValueReadonlyList>(s2, ins[94].methodParameter)->Get(UnboxValue<vl::vint64_t>(s1)));
+		}
+		s2 = Value();
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) + UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		s1 = s0;
+		v2 = s1;
+		s1 = Value();
+		s0 = Value();
+		s0 = v3;
+		s1 = v5;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) == 0) { s0 = Value(); goto L109; }
+		s0 = Value();
+		s0 = v3;
+		s1 = ins[105].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) + UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		v3 = s0;
+		s0 = Value();
+		goto L86;
+	L109:;
+		s0 = ins[109].valueParameter;
+		v3 = s0;
+		s0 = Value();
+		s0 = ins[111].valueParameter;
+		v4 = s0;
+		s0 = Value();
+		s0 = ins[113].valueParameter;
+		v5 = s0;
+		s0 = Value();
+		s0 = v2;
+		return s0;
+	}
+
+	// Tokens
+	Value Function_3(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments)
+	{
+		auto& ins = globalContext->assembly->instructions;
+		Value v0 = arguments[0];
+		Value v1;
+		Value v2;
+		Value v3;
+		Value v4;
+		Value v5;
+		Value v6;
+		Value v7;
+		Value v8;
+		Value v9;
+		Value v10;
+		Value v11;
+		Value s0;
+		Value s1;
+		Value s2;
+		{
+			s0 = WfRuntimeNativeHelper::CreateArray(nullptr, 0);
+		}
+		v1 = s0;
+		s0 = Value();
+		s0 = ins[121].valueParameter;
+		v3 = s0;
+		s0 = Value();
+		s0 = v0;
+		v4 = s0;
+		s0 = Value();
+		s0 = v3;
+		v2 = s0;
+		s0 = Value();
+	L127:;
+		s0 = v2;
+		s1 = v4;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) > 0) { s0 = Value(); goto L174; }
+		s0 = Value();
+		s0 = ins[132].valueParameter;
+		s1 = v2;
+		s2 = ins[134].valueParameter;
+		s1 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s1) % UnboxValue<vint64_t>(s2)));
+		s2 = Value();
+		s2 = ins[136].valueParameter;
+		{
+			s0 = BoxValue<vl::WString>(Sys::Left(UnboxValue<vl::WString>(s0), UnboxValue<vl::vint64_t>(s1)));
+		}
+		s1 = Value();
+		s2 = Value();
+		s1 = v2;
+		s2 = ins[139].valueParameter;
+		{
+			Value values[] = { s0, s1 };
+			s0 = WfRuntimeNativeHelper::InvokeMethod(globalContext, 140, s2, values, 2);
+		}
+		s1 = Value();
+		s2 = Value();
+		v5 = s0;
+		s0 = Value();
+		s0 = v5;
+		{
+			s0 = BoxValue<vl::vint64_t>(WfRuntimeNativeHelper::GetThis<vl::parsing::ParsingTreeToken>(s0, ins[143].methodParameter)->GetTokenIndex());
+		}
+		s1 = ins[144].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) * UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		s1 = s0;
+		s2 = v5;
+		{
+			WfRuntimeNativeHelper::GetThis<vl::parsing::ParsingTreeToken>(s2, ins[148].methodParameter)->SetTokenIndex(UnboxValue<vl::vint64_t>(s1));
+			s1 = Value();
+		}
+		s2 = Value();
+		s1 = Value();
+		s0 = Value();
+		s0 = v5;
+		{
+			s0 = BoxValue<vl::WString>(WfRuntimeNativeHelper::GetThis<vl::parsing::ParsingTreeToken>(s0, ins[152].methodParameter)->GetValue());
+		}
+		s1 = ins[153].valueParameter;
+		s0 = BoxValue<WString>(s0.GetText() + s1.GetText());
+		s1 = Value();
+		s1 = s0;
+		s2 = v5;
+		{
+			WfRuntimeNativeHelper::GetThis<vl::parsing::ParsingTreeToken>(s2, ins[157].methodParameter)->SetValue(UnboxValue<vl::WString>(s1));
+			s1 = Value();
+		}
+		s2 = Value();
+		s1 = Value();
+		s0 = Value();
+		s0 = v5;
+		s1 = v1;
+		{
+			s0 = BoxValue<vl::vint64_t>(WfRuntimeNativeHelper::GetThis<vl::reflection::description::IValueList>(s1, ins[162].methodParameter)->Add(UnboxValue<vl::reflection::description::Value>(s0)));
+		}
+		s1 = Value();
+		s0 = Value();
+		s0 = v2;
+		s1 = v4;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) == 0) { s0 = Value(); goto L174; }
+		s0 = Value();
+		s0 = v2;
+		s1 = ins[170].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) + UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		v2 = s0;
+		s0 = Value();
+		goto L127;
+	L174:;
+		s0 = ins[174].valueParameter;
+		v2 = s0;
+		s0 = Value();
+		s0 = ins[176].valueParameter;
+		v3 = s0;
+		s0 = Value();
+		s0 = ins[178].valueParameter;
+		v4 = s0;
+		s0 = Value();
+		s0 = ins[180].valueParameter;
+		v6 = s0;
+		s0 = Value();
+		s0 = ins[182].valueParameter;
+		v8 = s0;
+		s0 = Value();
+		s0 = v1;
+		{
+			s0 = BoxValue<vl::vint64_t>(WfRuntimeNativeHelper::GetThis<vl::reflection::description::IValueReadonlyList>(s0, ins[185].methodParameter)->GetCount());
+		}
+		s1 = ins[186].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) - UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		v9 = s0;
+		s0 = Value();
+		s0 = v8;
+		v7 = s0;
+		s0 = Value();
+	L191:;
+		s0 = v7;
+		s1 = v9;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) > 0) { s0 = Value(); goto L223; }
+		s0 = Value();
+		s0 = v7;
+		s1 = v1;
+		{
+			s0 = BoxValue<vl::reflection::description::Value>(WfRuntimeNativeHelper::GetThis<vl::reflection::description::IValueReadonlyList>(s1, ins[198].methodParameter)->Get(UnboxValue<vl::vint64_t>(s0)));
+		}
+		s1 = Value();
+		v10 = s0;
+		s0 = Value();
+		s0 = v6;
+		s1 = v10;
+		{
+			s1 = BoxValue<vl::WString>(WfRuntimeNativeHelper::GetThis<vl::parsing::ParsingTreeToken>(s1, ins[202].methodParameter)->GetValue());
+		}
+		s0 = BoxValue<WString>(s0.GetText() + s1.GetText());
+		s1 = Value();
+		s1 = v10;
+		{
+			s1 = BoxValue<vl::vint64_t>(WfRuntimeNativeHelper::GetThis<vl::parsing::ParsingTreeToken>(s1, ins[205].methodParameter)->GetTokenIndex());
+		}
+		s1 = WfRuntimeNativeHelper::ConvertToType(s1, ins[206]);
+		s0 = BoxValue<WString>(s0.GetText() + s1.GetText());
+		s1 = Value();
+		s1 = ins[208].valueParameter;
+		s0 = BoxValue<WString>(s0.GetText() + s1.GetText());
+		s1 = Value();
+		s1 = s0;
+		v6 = s1;
+		s1 = Value();
+		s0 = Value();
+		s0 = v7;
+		s1 = v9;
+		s0 = WfRuntimeNativeHelper::CompareLiteral<vint64_t>(s0, s1);
+		s1 = Value();
+		if (UnboxValue<vint>(s0) == 0) { s0 = Value(); goto L223; }
+		s0 = Value();
+		s0 = v7;
+		s1 = ins[219].valueParameter;
+		s0 = BoxValue<vint64_t>((vint64_t)(UnboxValue<vint64_t>(s0) + UnboxValue<vint64_t>(s1)));
+		s1 = Value();
+		v7 = s0;
+		s0 = Value();
+		goto L191;
+	L223:;
+		s0 = ins[223].valueParameter;
+		v7 = s0;
+		s0 = Value();
+		s0 = ins[225].valueParameter;
+		v8 = s0;
+		s0 = Value();
+		s0 = ins[227].valueParameter;
+		v9 = s0;
+		s0 = Value();
+		s0 = ins[229].valueParameter;
+		{
+			s0 = WfRuntimeNativeHelper::InvokeMethod(globalContext, 230, s0, nullptr, 0);
+		}
+		v11 = s0;
+		s0 = Value();
+		s0 = v6;
+		s1 = s0;
+		s2 = v11;
+		{
+			Value values[] = { s1 };
+			s1 = WfRuntimeNativeHelper::InvokeMethod(globalContext, 235, s2, values, 1);
+		}
+		s2 = Value();
+		s1 = Value();
+		s0 = Value();
+		s0 = v11;
+		{
+			s0 = WfRuntimeNativeHelper::InvokeMethod(globalContext, 239, s0, nullptr, 0);
+		}
+		s1 = v6;
+		s2 = ins[241].valueParameter;
+		{
+			s1 = BoxValue<vl::vint64_t>(Sys::Len(UnboxValue<vl::WString>(s1)));
+		}
+		s2 = Value();
+		s1 = WfRuntimeNativeHelper::ConvertToType(s1, ins[243]);
+		s0 = BoxValue<WString>(s0.GetText() + s1.GetText());
+		s1 = Value();
+		return s0;
+	}
+
+	// <initialize>
+	Value Function_4(WfRuntimeGlobalContext* globalContext, WfRuntimeVariableContext* capturedVariables, Value* arguments)
+	{
+		auto& ins = globalContext->assembly->instructions;
+		Value s0;
+		s0 = ins[0].valueParameter;
+		return s0;
+	}
+
+	WfRuntimeNativeFunction nativeFunctions[] =
+	{
+		Function_0,
+		Function_1,
+		Function_2,
+		Function_3,
+		Function_4,
+	};
+
+	WfRuntimeNativeModule nativeModule = { 2971020009571408397ULL, 5, nativeFunctions, nullptr };
+}
+
+void RegisterTestWorkflowScriptsNative()
+{
+	RegisterNativeModule(&nativeModule);
+}
+
+void UnregisterTestWorkflowScriptsNative()
+{
+	UnregisterNativeModule(&nativeModule);
+}